@@ -280,6 +280,24 @@ SEXP CatBoostPoolSlice_R(SEXP poolParam, SEXP sizeParam, SEXP offsetParam) {
     return result;
 }
 
+SEXP CatBoostPoolSubset_R(SEXP poolParam, SEXP indicesParam) {
+    SEXP result = NULL;
+    R_API_BEGIN();
+    TPoolHandle pool = reinterpret_cast<TPoolHandle>(R_ExternalPtrAddr(poolParam));
+    TVector<size_t> rowIndices = GetVectorFromSEXP<size_t>(indicesParam);
+    for (auto& rowIndex : rowIndices) {
+        CB_ENSURE(rowIndex > 0, "document indices must be positive (R indexing is 1-based)");
+        --rowIndex;
+    }
+    TPoolPtr subsetPool(SlicePool(*pool, rowIndices).Release());
+    result = PROTECT(R_MakeExternalPtr(subsetPool.get(), R_NilValue, R_NilValue));
+    R_RegisterCFinalizerEx(result, _Finalizer<TPoolHandle>, TRUE);
+    subsetPool.release();
+    R_API_END();
+    UNPROTECT(1);
+    return result;
+}
+
 SEXP CatBoostFit_R(SEXP learnPoolParam, SEXP testPoolParam, SEXP fitParamsAsJsonParam) {
     SEXP result = NULL;
     R_API_BEGIN();
@@ -108,6 +108,13 @@ inline static void BindPoolLoadParams(NLastGetopt::TOpts* parser, NCatboostOptio
     parser->AddLongOption("input-borders-file", "file with borders")
             .RequiredArgument("PATH")
             .StoreResult(&loadParamsPtr->BordersFile);
+
+    parser->AddLongOption("learn-shuffle-seed",
+                          "shuffle learn documents after load keeping query blocks intact, with reproducible order")
+        .RequiredArgument("seed")
+        .Handler1T<ui64>([loadParamsPtr](ui64 seed) {
+            loadParamsPtr->ShuffleSeed = seed;
+        });
 }
 
 void ParseCommandLine(int argc, const char* argv[],
@@ -204,6 +211,18 @@ void ParseCommandLine(int argc, const char* argv[],
             (*plainJsonPtr)["profile_log"] = name;
         });
 
+    parser.AddLongOption("telemetry-log", "binary columnar file to log per-iteration metrics, phase timings and rss")
+        .RequiredArgument("file")
+        .Handler1T<TString>([plainJsonPtr](const TString& name) {
+            (*plainJsonPtr)["telemetry_log"] = name;
+        });
+
+    parser.AddLongOption("trace-log", "chromium trace timeline of cpu phases and gpu stream labels, viewable in Perfetto")
+        .RequiredArgument("file")
+        .Handler1T<TString>([plainJsonPtr](const TString& name) {
+            (*plainJsonPtr)["trace_log"] = name;
+        });
+
     parser.AddLongOption("use-best-model", "If true - save all trees until best iteration on test.")
         .RequiredArgument("bool")
         .Handler1T<TString>([plainJsonPtr](const TString& useBestModel) {
@@ -234,6 +253,13 @@ void ParseCommandLine(int argc, const char* argv[],
         (*plainJsonPtr)["metric_period"] = FromString<int>(period);
     });
 
+    parser.AddLongOption("metric-confidence-intervals",
+                         "estimate 95% confidence intervals for the test metrics by block bootstrap in the same evaluation pass")
+        .NoArgument()
+        .Handler0([plainJsonPtr]() {
+            (*plainJsonPtr)["metric_confidence_intervals"] = true;
+        });
+
     parser.AddLongOption("snapshot-file", "use progress file for restoring progress after crashes")
         .RequiredArgument("PATH")
         .Handler1T<TString>([plainJsonPtr](const TString& path) {
@@ -287,6 +313,33 @@ void ParseCommandLine(int argc, const char* argv[],
         })
         .Help("Use full history to calculate approxes.");
 
+    parser.AddLongOption("async-metrics")
+        .NoArgument()
+        .Handler0([plainJsonPtr]() {
+            (*plainJsonPtr)["async_metrics"] = true;
+        })
+        .Help("Calculate metrics on approx snapshots in background while the next iteration trains. The overfitting detector sees results with one iteration lag.");
+
+    parser.AddLongOption("eval-time-fraction", "keep metric evaluation below this fraction of training wall time by widening the effective metric period online")
+        .RequiredArgument("float")
+        .Handler1T<TString>([plainJsonPtr](const TString& fraction) {
+            (*plainJsonPtr)["eval_time_fraction"] = FromString<float>(fraction);
+        });
+
+    parser.AddLongOption("lazy-test-approx")
+        .NoArgument()
+        .Handler0([plainJsonPtr]() {
+            (*plainJsonPtr)["lazy_test_approx"] = true;
+        })
+        .Help("Update test approxes only on metric calculation iterations to save the test share of per-document training structures. Useful with a large metric period.");
+
+    parser.AddLongOption("quantize-leaf-values")
+        .NoArgument()
+        .Handler0([plainJsonPtr]() {
+            (*plainJsonPtr)["quantize_leaf_values"] = true;
+        })
+        .Help("Round every tree's leaf values to an int8 grid with a per-tree scale during training; subsequent iterations absorb the rounding error, so the model can be stored quantized without post-training loss.");
+
     parser.AddLongOption("fold-permutation-block",
                          "Enables fold permutation by blocks of given length, preserving documents order inside each block.")
         .RequiredArgument("BLOCKSIZE")
@@ -359,6 +412,14 @@ void ParseCommandLine(int argc, const char* argv[],
             (*plainJsonPtr)["leaf_estimation_iterations"] = iterations;
         });
 
+    parser.AddLongOption("leaf-estimation-convergence-tolerance",
+                         "Stop gradient iterations early when the maximum leaf value change per step falls below this threshold."
+                         " 0 means always run leaf-estimation-iterations steps")
+        .RequiredArgument("float")
+        .Handler1T<float>([plainJsonPtr](float tolerance) {
+            (*plainJsonPtr)["leaf_estimation_convergence_tolerance"] = tolerance;
+        });
+
     parser.AddLongOption("leaf-estimation-backtracking", "Backtracking type (GPU only,  one of None, AnyImprovment, Armijo")
             .RequiredArgument("str")
             .Handler1T<TString>([plainJsonPtr](const TString& type) {
@@ -397,6 +458,51 @@ void ParseCommandLine(int argc, const char* argv[],
         })
         .Help("score stdandart deviation multiplier");
 
+    parser.AddLongOption("candidate-pruning-sample-rate",
+                         "Part of documents to use for preliminary candidate scoring on each tree level."
+                         " Candidates with poor subsample scores are skipped during full scoring."
+                         " Should be in [0, 1), 0 means exact search without pruning")
+        .RequiredArgument("float")
+        .Handler1T<float>([plainJsonPtr](float rate) {
+            (*plainJsonPtr)["candidate_pruning_sample_rate"] = rate;
+        });
+
+    parser.AddLongOption("cold-feature-demotion-iters",
+                         "Demote features that have not won a split for the given number of iterations"
+                         " to a reduced scoring schedule (see --cold-feature-score-period)."
+                         " 0 means every candidate is scored on every iteration")
+        .RequiredArgument("int")
+        .Handler1T<ui32>([plainJsonPtr](ui32 iters) {
+            (*plainJsonPtr)["cold_feature_demotion_iters"] = iters;
+        });
+
+    parser.AddLongOption("cold-feature-score-period",
+                         "Score demoted features only on every k-th iteration;"
+                         " a demoted feature whose score gets within the random-strength noise band"
+                         " of the winner is promoted back to the full schedule")
+        .RequiredArgument("int")
+        .Handler1T<ui32>([plainJsonPtr](ui32 period) {
+            (*plainJsonPtr)["cold_feature_score_period"] = period;
+        });
+
+    parser.AddLongOption("grow-depth-schedule",
+                         "Start trees at depth 2 and grow towards --depth one level at a time,"
+                         " whenever the per-tree split-gain improvements at the current depth flatten."
+                         " Early shallow trees cost a fraction of full-depth ones at equal final quality")
+        .NoArgument()
+        .Handler0([plainJsonPtr]() {
+            (*plainJsonPtr)["grow_depth_schedule"] = true;
+        });
+
+    parser.AddLongOption("single-precision-derivatives",
+                         "Store the derivative copies used for split scoring as float32 instead of float64,"
+                         " halving their memory and bandwidth footprint."
+                         " Bucket sums are still accumulated in float64. Not used for pairwise losses")
+        .NoArgument()
+        .Handler0([plainJsonPtr]() {
+            (*plainJsonPtr)["single_precision_derivatives"] = true;
+        });
+
     parser.AddLongOption("leaf-estimation-method", "One of {Newton, Gradient}")
         .RequiredArgument("method-name")
         .Handler1T<TString>([plainJsonPtr](const TString& method) {
@@ -444,6 +550,7 @@ void ParseCommandLine(int argc, const char* argv[],
               " Poisson,"
               " Bayesian,"
               " Bernoulli,"
+              " Goss,"
               " No. By default CatBoost uses bayesian bootstrap type")
         .Handler1T<TString>([plainJsonPtr](const TString& type) {
             (*plainJsonPtr)["bootstrap_type"] = type;
@@ -470,7 +577,16 @@ void ParseCommandLine(int argc, const char* argv[],
         .Handler1T<float>([plainJsonPtr](float rate) {
             (*plainJsonPtr)["subsample"] = rate;
         })
-        .Help("Controls sample rate for bagging. Could be used iff bootstrap-type is Poisson, Bernoulli. Possible values are from (0, 1]; 0.66 by default."
+        .Help("Controls sample rate for bagging. Could be used iff bootstrap-type is Poisson, Bernoulli, Goss. Possible values are from (0, 1]; 0.66 by default."
+        );
+
+    parser
+        .AddLongOption("top-fraction")
+        .RequiredArgument("Float")
+        .Handler1T<float>([plainJsonPtr](float fraction) {
+            (*plainJsonPtr)["top_fraction"] = fraction;
+        })
+        .Help("Fraction of documents with the largest gradients that GOSS always keeps; the rest are subsampled at the subsample rate. Could be used iff bootstrap-type is Goss. Possible values are from [0, 1); 0.2 by default."
         );
 
     parser
@@ -538,6 +654,13 @@ void ParseCommandLine(int argc, const char* argv[],
             (*plainJsonPtr).InsertValue("ctr_leaf_count_limit", maxLeafCount);
         });
 
+    parser.AddLongOption("ctr-table-memory-limit",
+                         "Memory budget for the cached online ctr tables of each training fold, e.g. 4GB. Least-recently-used ctr tables are evicted and recomputed on demand. CPU only")
+        .RequiredArgument("SIZE")
+        .Handler1T<TString>([plainJsonPtr](const TString& limit) {
+            (*plainJsonPtr).InsertValue("ctr_table_memory_limit", limit);
+        });
+
     parser.AddLongOption("store-all-simple-ctr",
                          "Do not limit simple ctr leaves count to topN, store all values from learn set")
         .NoArgument()
@@ -561,6 +684,13 @@ void ParseCommandLine(int argc, const char* argv[],
         })
         .Help("If parameter is specified than features with no more than specified value different values will be converted to float features using one-hot encoding. No ctrs will be calculated on this features.");
 
+    parser.AddLongOption("one-hot-min-count")
+        .RequiredArgument("size_t")
+        .Handler1T<size_t>([plainJsonPtr](const size_t oneHotMinCount) {
+            (*plainJsonPtr).InsertValue("one_hot_min_count", oneHotMinCount);
+        })
+        .Help("One-hot values seen fewer than this many times in the learn set are merged into a single aggregated bin that is never split on, reducing the split candidate count of high-cardinality one-hot features.");
+
     //data processing
     parser.AddLongOption('I', "ignore-features",
                          "don't use the specified features in the learn set (the features are separated by colon and can be specified as an inclusive interval, for example: -I 4:78-89:312)")
@@ -572,6 +702,13 @@ void ParseCommandLine(int argc, const char* argv[],
             }
         });
 
+    parser.AddLongOption("quantization-cache-path",
+                         "directory for cached learn quantization results, reused when the same pool and binarization settings are seen again")
+        .RequiredArgument("PATH")
+        .Handler1T<TString>([plainJsonPtr](const TString& path) {
+            (*plainJsonPtr)["quantization_cache_path"] = path;
+        });
+
     parser.AddLongOption("has-time", "Use dataset order as time")
         .NoArgument()
         .Handler0([plainJsonPtr]() {
@@ -615,6 +752,22 @@ void ParseCommandLine(int argc, const char* argv[],
             (*plainJsonPtr)["border_count"] = count;
         });
 
+    parser.AddLongOption("adaptive-border-count",
+                         "re-share the global bin budget (border-count per float feature) between features"
+                         " proportionally to their estimated splitting value;"
+                         " near-binary features release bins to rich continuous ones, total bin count is unchanged")
+        .NoArgument()
+        .Handler0([plainJsonPtr]() {
+            (*plainJsonPtr)["adaptive_border_count"] = true;
+        });
+
+    parser.AddLongOption("border-build-sample-count",
+                         "build float feature borders on a random sample of this many documents instead of the full pool (0 = use all documents)")
+        .RequiredArgument("int")
+        .Handler1T<int>([plainJsonPtr](int count) {
+            (*plainJsonPtr)["border_build_sample_count"] = count;
+        });
+
     parser.AddLongOption("feature-border-type",
                          "Should be one of: Median, GreedyLogSum, UniformAndQuantiles, MinEntropy, MaxLogSum")
         .RequiredArgument("border-type")
@@ -719,6 +872,46 @@ void ParseCommandLine(int argc, const char* argv[],
             (*plainJsonPtr)["file_with_hosts"] = nodeFile;
         });
 
+    parser
+        .AddLongOption("node-transport")
+        .RequiredArgument("String")
+        .Help("One of Neh, Netliba, AutoDetect; default is Neh. Netliba rides on the ibverbs RDMA path when an InfiniBand/RoCE port is present, which NEH's TCP transport cannot use")
+        .Handler1T<TString>([plainJsonPtr](const TString& transport) {
+            (*plainJsonPtr)["node_transport"] = transport;
+        });
+
+    parser
+        .AddLongOption("compressed-stats-transfer")
+        .NoArgument()
+        .Help("Send bucket statistics between hosts in reduced precision (scaled fp16 with a delta+zstd wire codec) during distributed training; cuts depth-synchronization traffic several-fold at the cost of a relative perturbation of split scores of about 1e-3 per worker")
+        .Handler0([plainJsonPtr]() {
+            (*plainJsonPtr)["compressed_stats_transfer"] = true;
+        });
+
+    parser
+        .AddLongOption("compensated-accumulation")
+        .NoArgument()
+        .Help("Use Kahan-compensated summation for the long accumulation chains (metric block merges, leaf derivative buckets); sums stay accurate over billions of documents for a few extra flops per add")
+        .Handler0([plainJsonPtr]() {
+            (*plainJsonPtr)["compensated_accumulation"] = true;
+        });
+
+    parser
+        .AddLongOption("huge-pages")
+        .NoArgument()
+        .Help("Back the large training arrays (bin columns, fold approxes) with transparent 2MB pages to cut TLB misses of the histogram gathers; best effort, requires transparent_hugepage=madvise or always on the box")
+        .Handler0([plainJsonPtr]() {
+            (*plainJsonPtr)["huge_pages"] = true;
+        });
+
+    parser
+        .AddLongOption("spin-dispatch")
+        .NoArgument()
+        .Help("Use spin-then-park task dispatch with core-pinned worker threads; removes thread wakeup latency from the many short parallel regions of an iteration at the cost of busy cpus for the whole run. Best for shallow trees on dedicated machines")
+        .Handler0([plainJsonPtr]() {
+            (*plainJsonPtr)["spin_dispatch"] = true;
+        });
+
     parser.AddLongOption('r', "seed")
         .AddLongName("random-seed")
         .RequiredArgument("count")
@@ -5,18 +5,24 @@
 
 #include <catboost/libs/data/load_data.h>
 #include <catboost/libs/algo/apply.h>
+#include <catboost/libs/distributed/master.h>
 #include <catboost/libs/eval_result/eval_helpers.h>
 #include <catboost/libs/labels/visible_label_helper.h>
 #include <catboost/libs/model/model.h>
+#include <catboost/libs/model/gpu_model_evaluator.h>
 
 #include <library/getopt/small/last_getopt.h>
 #include <library/threading/local_executor/local_executor.h>
 
+#include <util/generic/algorithm.h>
+#include <util/generic/utility.h>
 #include <util/stream/file.h>
 #include <util/system/fs.h>
+#include <util/system/hp_timer.h>
 #include <util/string/iterator.h>
 
 #include <algorithm>
+#include <numeric>
 
 static TEvalResult Apply(
     const TFullModel& model,
@@ -55,10 +61,141 @@ static TEvalResult Apply(
     return resultApprox;
 }
 
+static TEvalResult ApplyOnGpu(
+    IGpuModelEvaluator* evaluator,
+    const TFullModel& model,
+    const TPool& pool,
+    size_t docBegin, size_t docEnd,
+    size_t begin, size_t end,
+    size_t evalPeriod)
+{
+    TEvalResult resultApprox;
+    TVector<TVector<TVector<double>>>& rawValues = resultApprox.GetRawValuesRef();
+    rawValues.resize(1);
+    const size_t docCount = docEnd - docBegin;
+    if (pool.Docs.Baseline.ysize() > 0) {
+        rawValues[0].resize(pool.Docs.Baseline.size());
+        for (size_t dim = 0; dim < pool.Docs.Baseline.size(); ++dim) {
+            rawValues[0][dim].assign(pool.Docs.Baseline[dim].begin() + docBegin,
+                                     pool.Docs.Baseline[dim].begin() + docEnd);
+        }
+    } else {
+        rawValues[0].resize(model.ObliviousTrees.ApproxDimension, TVector<double>(docCount, 0.0));
+    }
+    TVector<TConstArrayRef<float>> floatFeatureColumns;
+    floatFeatureColumns.reserve(model.ObliviousTrees.FloatFeatures.size());
+    for (const auto& floatFeature : model.ObliviousTrees.FloatFeatures) {
+        floatFeatureColumns.push_back(pool.Docs.GetFactorRef(floatFeature.FlatFeatureIndex).Slice(docBegin, docCount));
+    }
+    TVector<double> approx(docCount);
+    for (; begin < end; begin += evalPeriod) {
+        evaluator->CalcFlat(model, floatFeatureColumns, begin, Min(begin + evalPeriod, end), approx);
+        for (size_t j = 0; j < docCount; ++j) {
+            rawValues.back()[0][j] += approx[j];
+        }
+        if (begin + evalPeriod < end) {
+            rawValues.push_back(rawValues.back());
+        }
+    }
+    return resultApprox;
+}
+
+/*
+ * Cooperative scorer: every block's documents are split into a head scored on the GPU
+ * and a tail scored on the CPU, both running concurrently. The split point follows the
+ * per-engine document throughput measured on previous blocks (exponential moving
+ * average), so the share converges to the actual speed ratio of the box without any
+ * configuration. Results of the two engines are merged back in document order, so the
+ * caller sees one TEvalResult indistinguishable from a single-engine run.
+ */
+class TCooperativeApplier {
+public:
+    TCooperativeApplier(IGpuModelEvaluator* gpuEvaluator, NPar::TLocalExecutor* executor)
+        : GpuEvaluator(gpuEvaluator)
+        , Executor(executor)
+    {
+    }
+
+    TEvalResult Apply(const TFullModel& model, const TPool& pool, size_t iterationsLimit, size_t evalPeriod) {
+        const size_t docCount = pool.Docs.GetDocCount();
+        size_t gpuDocCount = docCount;
+        if (docCount >= 2 * MinDocsPerEngine) {
+            gpuDocCount = ClampVal<size_t>(GpuShare * docCount, MinDocsPerEngine, docCount - MinDocsPerEngine);
+        }
+        const size_t cpuDocCount = docCount - gpuDocCount;
+
+        TEvalResult gpuResult;
+        double gpuSeconds = 0.0;
+        auto gpuFutures = Executor->ExecRangeWithFutures(
+            [&](int) {
+                THPTimer timer;
+                gpuResult = ApplyOnGpu(GpuEvaluator, model, pool, 0, gpuDocCount, 0, iterationsLimit, evalPeriod);
+                gpuSeconds = timer.Passed();
+            },
+            0,
+            1,
+            NPar::TLocalExecutor::HIGH_PRIORITY
+        );
+
+        TEvalResult cpuResult;
+        double cpuSeconds = 0.0;
+        if (cpuDocCount > 0) {
+            TVector<size_t> cpuRows;
+            cpuRows.yresize(cpuDocCount);
+            std::iota(cpuRows.begin(), cpuRows.end(), gpuDocCount);
+            const THolder<TPool> cpuPool = SlicePool(pool, cpuRows);
+            THPTimer timer;
+            cpuResult = ::Apply(model, *cpuPool, 0, iterationsLimit, evalPeriod, Executor);
+            cpuSeconds = timer.Passed();
+        }
+        gpuFutures[0].GetValueSync();
+
+        UpdateThroughput(gpuDocCount, gpuSeconds, &GpuDocsPerSec);
+        UpdateThroughput(cpuDocCount, cpuSeconds, &CpuDocsPerSec);
+        if (GpuDocsPerSec > 0.0 && CpuDocsPerSec > 0.0) {
+            GpuShare = ClampVal(GpuDocsPerSec / (GpuDocsPerSec + CpuDocsPerSec), 0.05, 0.95);
+        }
+
+        if (cpuDocCount == 0) {
+            return gpuResult;
+        }
+        // ordered merge: the GPU scored the head documents of the block, the CPU the tail
+        TVector<TVector<TVector<double>>>& merged = gpuResult.GetRawValuesRef();
+        const TVector<TVector<TVector<double>>>& cpuValues = cpuResult.GetRawValuesRef();
+        Y_ASSERT(merged.size() == cpuValues.size());
+        for (size_t step = 0; step < merged.size(); ++step) {
+            TVector<double>& mergedColumn = merged[step][0];
+            mergedColumn.resize(docCount);
+            const TVector<double>& cpuColumn = cpuValues[step][0];
+            std::copy(cpuColumn.begin(), cpuColumn.end(), mergedColumn.begin() + gpuDocCount);
+        }
+        return gpuResult;
+    }
+
+private:
+    static void UpdateThroughput(size_t docCount, double seconds, double* docsPerSec) {
+        if (docCount == 0 || seconds <= 0.0) {
+            return;
+        }
+        const double measured = docCount / seconds;
+        *docsPerSec = *docsPerSec == 0.0 ? measured : 0.7 * *docsPerSec + 0.3 * measured;
+    }
+
+    static constexpr size_t MinDocsPerEngine = 256; // below this splitting costs more than it saves
+
+    IGpuModelEvaluator* GpuEvaluator;
+    NPar::TLocalExecutor* Executor;
+    double GpuShare = 0.75; // head share of documents the GPU gets, adapted from measurements
+    double GpuDocsPerSec = 0.0; // exponential moving averages, 0 == not measured yet
+    double CpuDocsPerSec = 0.0;
+};
+
 int mode_calc(int argc, const char* argv[]) {
     TAnalyticalModeCommonParams params;
     size_t iterationsLimit = 0;
     size_t evalPeriod = 0;
+    ETaskType taskType = ETaskType::CPU;
+    EEvalOutputFormat outputFormat = EEvalOutputFormat::Dsv;
 
     auto parser = NLastGetopt::TOpts();
     parser.AddHelpOption();
@@ -86,11 +223,70 @@ int mode_calc(int argc, const char* argv[]) {
         });
     parser.AddLongOption("eval-period", "predictions are evaluated every <eval-period> trees")
         .StoreResult(&evalPeriod);
+    parser.AddLongOption("output-format",
+            "result format: Dsv (tab-separated text) or Binary (packed doubles with a <output-path>.schema sidecar; only prediction columns are written)")
+        .RequiredArgument("Format")
+        .Handler1T<TString>([&](const TString& outputFormatStr) {
+            outputFormat = FromString<EEvalOutputFormat>(outputFormatStr);
+        });
+    parser.AddLongOption("task-type", "evaluate on CPU or GPU")
+        .RequiredArgument("Type")
+        .Handler1T<TString>([&](const TString& taskTypeStr) {
+            taskType = FromString<ETaskType>(taskTypeStr);
+        });
+    bool cooperativeApply = false;
+    parser.AddLongOption("cooperative-apply",
+            "[with --task-type GPU] score every block on the CPU and the GPU together, "
+            "splitting documents between the engines by measured throughput")
+        .NoArgument()
+        .StoreValue(&cooperativeApply, true);
+    size_t topKPerQuery = 0;
+    parser.AddLongOption("output-top-k-per-query",
+            "[with query ids in the pool] write only the K best-scoring rows of every query, "
+            "in query order, instead of the full output (0 = write everything)")
+        .RequiredArgument("Int")
+        .StoreResult(&topKPerQuery);
+    TString fileWithHosts;
+    ui32 nodePort = NCatboostOptions::TSystemOptions::GetUnusedNodePort();
+    parser.AddLongOption("file-with-hosts",
+            "apply the model on a cluster of already running workers instead of locally: "
+            "every worker scores the shard at --input-path on its own disk and writes raw "
+            "predictions to --output-path there; only completion stats reach this host")
+        .RequiredArgument("File")
+        .StoreResult(&fileWithHosts);
+    parser.AddLongOption("node-port", "port to communicate with cluster workers")
+        .RequiredArgument("Int")
+        .StoreResult(&nodePort);
     parser.SetFreeArgsNum(0);
     NLastGetopt::TOptsParseResult parserResult{&parser, argc, argv};
 
     CB_ENSURE(NFs::Exists(params.ModelFileName), "Model file doesn't exist " << params.ModelFileName);
     TFullModel model = ReadModel(params.ModelFileName);
+
+    if (!fileWithHosts.empty()) {
+        CB_ENSURE(taskType == ETaskType::CPU, "distributed apply supports only CPU evaluation");
+        NCatboostDistributed::TApplyShardTask task;
+        task.SerializedModel = SerializeModel(model);
+        task.WorkerPoolPaths = {params.InputPath.Path};
+        task.WorkerOutputPaths = {params.OutputPath};
+        task.CdFilePath = params.DsvPoolFormatParams.CdFilePath.Path;
+        task.HasHeader = params.DsvPoolFormatParams.Format.HasHeader;
+        task.Delimiter = params.DsvPoolFormatParams.Format.Delimiter;
+        task.PredictionType = params.PredictionTypes.empty()
+            ? EPredictionType::RawFormulaVal
+            : params.PredictionTypes.front();
+        task.ThreadCount = params.ThreadCount;
+        const auto results = MapApplyModelToShards(task,
+            fileWithHosts,
+            nodePort,
+            params.ThreadCount,
+            ENodeTransport::NEH);
+        const bool anyWorkerFailed = AnyOf(results,
+            [](const NCatboostDistributed::TApplyShardResult& result) {
+                return !result.ErrorMessage.empty();
+            });
+        return anyWorkerFailed ? 1 : 0;
+    }
     if (model.HasCategoricalFeatures()) {
         CB_ENSURE(params.DsvPoolFormatParams.CdFilePath.Inited(),
                   "Model has categorical features. Specify column_description file with correct categorical features.");
@@ -99,6 +295,26 @@ int mode_calc(int argc, const char* argv[]) {
     }
     params.ClassNames = ReadClassNames(model.ModelInfo.at("params"));
 
+    THolder<IGpuModelEvaluator> gpuEvaluator;
+    if (taskType == ETaskType::GPU) {
+        CB_ENSURE(TGpuModelEvaluatorFactory::Has(ETaskType::GPU),
+                  "Can't load GPU evaluation library. Module was not compiled or CUDA version/driver is incompatible with package");
+        gpuEvaluator = TGpuModelEvaluatorFactory::Construct(ETaskType::GPU);
+    }
+    if (cooperativeApply) {
+        CB_ENSURE(gpuEvaluator, "cooperative apply needs a GPU evaluator, specify --task-type GPU");
+        CB_ENSURE(model.ObliviousTrees.ApproxDimension == 1,
+                  "cooperative apply supports only single-dimensional models");
+        CB_ENSURE(!model.HasCategoricalFeatures(),
+                  "cooperative apply supports only models without categorical features");
+    }
+
+    if (topKPerQuery > 0) {
+        CB_ENSURE(outputFormat == EEvalOutputFormat::Dsv, "top-K per query output supports only Dsv format");
+        CB_ENSURE(model.ObliviousTrees.ApproxDimension == 1,
+                  "top-K per query output supports only single-dimensional models");
+    }
+
     if (iterationsLimit == 0) {
         iterationsLimit = model.GetTreeCount();
     }
@@ -115,39 +331,74 @@ int mode_calc(int argc, const char* argv[]) {
     NPar::TLocalExecutor executor;
     executor.RunAdditionalThreads(params.ThreadCount - 1);
 
-    SetVerboseLogingMode();
-    bool IsFirstBlock = true;
-    ReadAndProceedPoolInBlocks(params, blockSize, [&](const TPool& poolPart) {
-        if (IsFirstBlock) {
-            ValidateColumnOutput(params.OutputColumnsIds, poolPart, true);
+    TVisibleLabelsHelper visibleLabelsHelper;
+    if (model.ObliviousTrees.ApproxDimension > 1) {  // is multiclass?
+        if(model.ModelInfo.has("multiclass_params")) {
+            visibleLabelsHelper.Initialize(model.ModelInfo.at("multiclass_params"));
+        } else {
+            visibleLabelsHelper.Initialize(model.ObliviousTrees.ApproxDimension);
         }
-        auto approx = Apply(model, poolPart, 0, iterationsLimit, evalPeriod, &executor);
-        TVisibleLabelsHelper visibleLabelsHelper;
-        if (model.ObliviousTrees.ApproxDimension > 1) {  // is multiclass?
-            if(model.ModelInfo.has("multiclass_params")) {
-                visibleLabelsHelper.Initialize(model.ModelInfo.at("multiclass_params"));
+    }
+
+    SetVerboseLogingMode();
+    // ring of per-block approxes shared between the apply and write pipeline stages
+    TEvalResult approxes[3];
+    TCooperativeApplier cooperativeApplier(gpuEvaluator.Get(), &executor);
+    THolder<TQueryTopKAccumulator> topKAccumulator;
+    if (topKPerQuery > 0) {
+        topKAccumulator = MakeHolder<TQueryTopKAccumulator>(topKPerQuery);
+    }
+    ReadAndProceedPoolInBlocksPipelined(
+        params,
+        blockSize,
+        /*applyConsumer*/ [&](const TPool& poolPart, size_t blockIdx) {
+            if (blockIdx == 0 && outputFormat == EEvalOutputFormat::Dsv) {
+                ValidateColumnOutput(params.OutputColumnsIds, poolPart, true);
+            }
+            if (cooperativeApply) {
+                approxes[blockIdx % 3] = cooperativeApplier.Apply(model, poolPart, iterationsLimit, evalPeriod);
             } else {
-                visibleLabelsHelper.Initialize(model.ObliviousTrees.ApproxDimension);
+                approxes[blockIdx % 3] = gpuEvaluator
+                    ? ApplyOnGpu(gpuEvaluator.Get(), model, poolPart, 0, poolPart.Docs.GetDocCount(), 0, iterationsLimit, evalPeriod)
+                    : Apply(model, poolPart, 0, iterationsLimit, evalPeriod, &executor);
             }
-        }
+            SetSilentLogingMode();
+        },
+        /*writeConsumer*/ [&](const TPool& poolPart, size_t blockIdx) {
+            TEvalResult& approx = approxes[blockIdx % 3];
+            if (outputFormat == EEvalOutputFormat::Binary) {
+                approx.OutputBinaryToFile(
+                        &executor,
+                        params.PredictionTypes,
+                        visibleLabelsHelper,
+                        &outputStream,
+                        /*schemaPath*/ blockIdx == 0 ? params.OutputPath + ".schema" : TString(),
+                        std::make_pair(evalPeriod, iterationsLimit)
+                );
+            } else {
+                approx.OutputToFile(
+                        &executor,
+                        params.OutputColumnsIds,
+                        visibleLabelsHelper,
+                        poolPart,
+                        true,
+                        &outputStream,
+                        // TODO: src file columns output is incompatible with block processing
+                        /*testSetPath*/NCB::TPathWithScheme(),
+                        /*testFileWhichOf*/ {0, 0},
+                        params.DsvPoolFormatParams.Format,
+                        /*writeHeader*/ blockIdx == 0,
+                        std::make_pair(evalPeriod, iterationsLimit),
+                        topKAccumulator.Get()
+                );
+            }
+        },
+        &executor);
 
-        SetSilentLogingMode();
-        approx.OutputToFile(
-                &executor,
-                params.OutputColumnsIds,
-                visibleLabelsHelper,
-                poolPart,
-                true,
-                &outputStream,
-                // TODO: src file columns output is incompatible with block processing
-                /*testSetPath*/NCB::TPathWithScheme(),
-                /*testFileWhichOf*/ {0, 0},
-                params.DsvPoolFormatParams.Format,
-                IsFirstBlock,
-                std::make_pair(evalPeriod, iterationsLimit)
-        );
-        IsFirstBlock = false;
-    }, &executor);
+    if (topKAccumulator) {
+        // queries may span block boundaries, so the filtered rows are only complete now
+        topKAccumulator->Output(&outputStream);
+    }
 
     return 0;
 }
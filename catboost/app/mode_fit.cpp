@@ -4,9 +4,9 @@
 #include <catboost/libs/options/plain_options_helper.h>
 #include <catboost/libs/train_lib/train_model.h>
 
-#if defined(USE_MPI)
+#if defined(USE_REMOTE_DEVICES)
 #include <catboost/cuda/cuda_lib/cuda_manager.h>
-#include <catboost/cuda/cuda_lib/mpi/mpi_manager.h>
+#include <catboost/cuda/cuda_lib/transport.h>
 #endif
 
 #include <util/system/fs.h>
@@ -17,9 +17,14 @@ int mode_fit(int argc, const char* argv[]) {
 
     #if defined(USE_MPI)
     char** args = const_cast<char**>(argv);
-    auto& mpiManager = NCudaLib::GetMpiManager();
-    mpiManager.Start(&argc, &args);
-    if (!mpiManager.IsMaster()) {
+    auto& transportManager = NCudaLib::GetTransportManager();
+    transportManager.Start(&argc, &args);
+    #elif defined(USE_PAR_NET)
+    auto& transportManager = NCudaLib::GetTransportManager();
+    transportManager.Start();
+    #endif
+    #if defined(USE_REMOTE_DEVICES)
+    if (!transportManager.IsMaster()) {
         RunSlave();
         return 0;
     }
@@ -61,9 +66,9 @@ int mode_fit(int argc, const char* argv[]) {
     }
     modelTrainerHolder->TrainModel(poolLoadOptions, outputOptions, catBoostJsonOptions);
 
-    #if defined(USE_MPI)
-    if (mpiManager.IsMaster()) {
-        mpiManager.Stop();
+    #if defined(USE_REMOTE_DEVICES)
+    if (transportManager.IsMaster()) {
+        transportManager.Stop();
     }
     #endif
     return 0;
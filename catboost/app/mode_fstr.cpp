@@ -92,13 +92,15 @@ int mode_fstr(int argc, const char* argv[]) {
             CalcAndOutputFstr(model,
                               model.ObliviousTrees.LeafWeights.empty() ? &(poolLoader()) : nullptr,
                               &params.OutputPath,
-                              nullptr);
+                              nullptr,
+                              params.ThreadCount);
             break;
         case EFstrType::InternalFeatureImportance:
             CalcAndOutputFstr(model,
                               model.ObliviousTrees.LeafWeights.empty() ? &(poolLoader()) : nullptr,
                               nullptr,
-                              &params.OutputPath);
+                              &params.OutputPath,
+                              params.ThreadCount);
             break;
         case EFstrType::Interaction:
             CalcAndOutputInteraction(model, &params.OutputPath, nullptr);
@@ -1,6 +1,7 @@
 #include "modes.h"
 #include "model_metainfo_helpers.h"
 
+#include <catboost/libs/model/approximate_scoring.h>
 #include <catboost/libs/model/model.h>
 
 #include <library/getopt/small/last_getopt.h>
@@ -110,11 +111,50 @@ int dump(int argc, const char* argv[]) {
     return 0;
 }
 
+int build_approximate(int argc, const char* argv[]) {
+    TCommonMetaInfoParams params;
+    TApproximateModelParams approximateParams;
+    TString outputModelPath;
+    auto parser = NLastGetopt::TOpts();
+    parser.AddHelpOption();
+    params.BindParser(parser);
+    parser.AddLongOption("cluster-count", "number of representative trees to keep")
+        .RequiredArgument("COUNT")
+        .DefaultValue("64")
+        .StoreResult(&approximateParams.ClusterCount);
+    parser.AddLongOption("kmeans-iterations", "tree clustering iteration count")
+        .RequiredArgument("COUNT")
+        .DefaultValue("10")
+        .StoreResult(&approximateParams.KMeansIterations);
+    parser.AddLongOption('r', "random-seed", "clustering random seed")
+        .RequiredArgument("SEED")
+        .DefaultValue("0")
+        .StoreResult(&approximateParams.Seed);
+    parser.AddLongOption('o', "output-model-path")
+        .OptionalArgument("PATH")
+        .StoreResult(&outputModelPath);
+    parser.SetFreeArgsMax(0);
+    NLastGetopt::TOptsParseResult parserResult{&parser, argc, argv};
+    params.LoadModel();
+    TFullModel approximateModel = BuildApproximateModel(params.Model, approximateParams);
+    AttachApproximateModel(approximateModel, &params.Model);
+    Cout << "Attached approximate model with " << approximateModel.GetTreeCount()
+         << " representative trees (source has " << params.Model.GetTreeCount() << ")" << Endl;
+    if (outputModelPath.Empty()) {
+        ExportModel(params.Model, params.ModelPath);
+    } else {
+        ExportModel(params.Model, outputModelPath);
+    }
+    return 0;
+}
+
 int mode_metadata(int argc, const char* argv[]) {
     TModChooser modChooser;
     modChooser.AddMode("set", set_key, "set model property by name/value");
     modChooser.AddMode("get", get_keys, "get model property/properties by name");
     modChooser.AddMode("dump", dump, "dump model info fields");
+    modChooser.AddMode("build-approximate", build_approximate,
+                       "cluster trees and attach a representative model for approximate scoring");
     modChooser.DisableSvnRevisionOption();
     modChooser.Run(argc, argv);
     return 0;
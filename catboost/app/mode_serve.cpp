@@ -0,0 +1,312 @@
+#include "modes.h"
+
+#include <catboost/libs/helpers/exception.h>
+#include <catboost/libs/logging/logging.h>
+#include <catboost/libs/model/formula_evaluator.h>
+#include <catboost/libs/model/model.h>
+
+#include <library/getopt/small/last_getopt.h>
+
+#include <util/datetime/base.h>
+#include <util/generic/ptr.h>
+#include <util/generic/vector.h>
+#include <util/network/sock.h>
+#include <util/network/socket.h>
+#include <util/system/fstat.h>
+#include <util/system/guard.h>
+#include <util/system/info.h>
+#include <util/system/spinlock.h>
+#include <util/system/thread.h>
+
+/*
+ * Binary scoring protocol (integers and floats are in host byte order, x86 little-endian):
+ *
+ * request:  ui16 modelId, ui16 flags (must be zero), ui32 docCount, ui32 floatFeatureCount,
+ *           then docCount * floatFeatureCount floats in row-major order;
+ *           floatFeatureCount is the flat feature vector size (categorical values are passed
+ *           as reinterpreted hashes, same as CalcFlat)
+ * response: ui32 docCount, ui32 approxDimension, then docCount * approxDimension doubles
+ *           with raw formula values in [docId][dimension] order
+ *
+ * Requests are served in order per connection; a malformed request closes the connection.
+ */
+
+namespace {
+    struct TScoreRequestHeader {
+        ui16 ModelId;
+        ui16 Flags;
+        ui32 DocCount;
+        ui32 FloatFeatureCount;
+    };
+
+    struct TScoreResponseHeader {
+        ui32 DocCount;
+        ui32 ApproxDimension;
+    };
+
+    const ui32 MaxDocsPerRequest = 1 << 20;
+    const ui64 MaxFloatsPerRequest = 1ULL << 28;
+    const int ListenBacklog = 512;
+
+    //served models with in-place reload: workers take a shared pointer per request, so a
+    //reload never invalidates an evaluation that is already running
+    class TModelRegistry {
+    public:
+        explicit TModelRegistry(const TVector<TString>& paths)
+            : Paths(paths)
+            , ModTimes(paths.size())
+            , Models(paths.size())
+        {
+            for (size_t i = 0; i < Paths.size(); ++i) {
+                Models[i] = new TFullModel(ReadModel(Paths[i]));
+                ModTimes[i] = TFileStat(Paths[i]).MTime;
+                MATRIXNET_INFO_LOG << "Loaded model #" << i << " from " << Paths[i]
+                                   << " (" << Models[i]->GetTreeCount() << " trees)" << Endl;
+            }
+        }
+
+        size_t GetModelCount() const {
+            return Models.size();
+        }
+
+        TAtomicSharedPtr<const TFullModel> Get(ui32 modelId) const {
+            CB_ENSURE(modelId < Models.size(), "Unknown model id #" << modelId);
+            TGuard<TAdaptiveLock> guard(Lock);
+            return Models[modelId];
+        }
+
+        //swaps in models whose files changed on disk; scoring keeps the old model on failure
+        void ReloadChanged() {
+            for (size_t i = 0; i < Paths.size(); ++i) {
+                const time_t modTime = TFileStat(Paths[i]).MTime;
+                if (modTime == ModTimes[i]) {
+                    continue;
+                }
+                try {
+                    TAtomicSharedPtr<const TFullModel> model = new TFullModel(ReadModel(Paths[i]));
+                    {
+                        TGuard<TAdaptiveLock> guard(Lock);
+                        Models[i] = model;
+                    }
+                    ModTimes[i] = modTime;
+                    MATRIXNET_INFO_LOG << "Reloaded model #" << i << " from " << Paths[i] << Endl;
+                } catch (...) {
+                    MATRIXNET_WARNING_LOG << "Can not reload model #" << i << " from " << Paths[i]
+                                          << ": " << CurrentExceptionMessage() << Endl;
+                }
+            }
+        }
+
+    private:
+        TVector<TString> Paths;
+        TVector<time_t> ModTimes;
+        TVector<TAtomicSharedPtr<const TFullModel>> Models;
+        TAdaptiveLock Lock;
+    };
+
+    class TModelReloadThread: public ISimpleThread {
+    public:
+        TModelReloadThread(TModelRegistry& models, ui32 intervalSec)
+            : Models(models)
+            , Interval(TDuration::Seconds(intervalSec))
+        {
+        }
+
+        void* ThreadProc() override {
+            for (;;) {
+                Sleep(Interval);
+                Models.ReloadChanged();
+            }
+        }
+
+    private:
+        TModelRegistry& Models;
+        TDuration Interval;
+    };
+
+    THolder<TInetStreamSocket> CreateListener(ui16 port, bool reusePort) {
+        THolder<TInetStreamSocket> listener = MakeHolder<TInetStreamSocket>();
+        listener->CheckSock();
+        CheckedSetSockOpt((SOCKET)(*listener), SOL_SOCKET, SO_REUSEADDR, 1, "reuse address");
+#if defined(SO_REUSEPORT)
+        if (reusePort) {
+            CheckedSetSockOpt((SOCKET)(*listener), SOL_SOCKET, SO_REUSEPORT, 1, "reuse port");
+        }
+#else
+        Y_UNUSED(reusePort);
+#endif
+        TSockAddrInet addr((TIpHost)INADDR_ANY, port);
+        const int bindResult = listener->Bind(&addr);
+        CB_ENSURE(bindResult == 0, "Can not bind port " << port << ": " << LastSystemErrorText(-bindResult));
+        const int listenResult = listener->Listen(ListenBacklog);
+        CB_ENSURE(listenResult == 0, "Can not listen on port " << port << ": " << LastSystemErrorText(-listenResult));
+        return listener;
+    }
+
+    //one shard: accepts connections and scores requests on a single core, reusing the
+    //evaluation scratch buffers between requests so the steady state does not allocate
+    class TScoringShard: public ISimpleThread {
+    public:
+        TScoringShard(const TModelRegistry& models, THolder<TInetStreamSocket> ownListener, TInetStreamSocket* sharedListener)
+            : Models(models)
+            , OwnListener(std::move(ownListener))
+            , SharedListener(sharedListener)
+        {
+        }
+
+        void* ThreadProc() override {
+            TInetStreamSocket* listener = OwnListener ? OwnListener.Get() : SharedListener;
+            for (;;) {
+                TInetStreamSocket client;
+                TSockAddrInet clientAddr;
+                const int acceptResult = listener->Accept(&client, &clientAddr);
+                if (acceptResult < 0) {
+                    if (acceptResult == -EINTR) {
+                        continue;
+                    }
+                    MATRIXNET_WARNING_LOG << "Accept failed: " << LastSystemErrorText(-acceptResult) << Endl;
+                    break;
+                }
+                try {
+                    SetNoDelay((SOCKET)client, true);
+                    ServeConnection(&client);
+                } catch (...) {
+                    MATRIXNET_DEBUG_LOG << "Drop connection from " << clientAddr.ToString()
+                                        << ": " << CurrentExceptionMessage() << Endl;
+                }
+            }
+            return nullptr;
+        }
+
+    private:
+        void ServeConnection(TStreamSocket* socket) {
+            TStreamSocketInput input(socket);
+            TStreamSocketOutput output(socket);
+
+            for (;;) {
+                TScoreRequestHeader header;
+                const size_t headBytes = input.Read(&header, sizeof(header));
+                if (headBytes == 0) {
+                    return; //clean close between requests
+                }
+                if (headBytes < sizeof(header)) {
+                    input.Load((char*)&header + headBytes, sizeof(header) - headBytes);
+                }
+
+                CB_ENSURE(header.Flags == 0, "Unsupported request flags #" << header.Flags);
+                CB_ENSURE(header.DocCount > 0 && header.DocCount <= MaxDocsPerRequest,
+                          "Bad document count #" << header.DocCount);
+
+                TAtomicSharedPtr<const TFullModel> model = Models.Get(header.ModelId);
+                CB_ENSURE(header.FloatFeatureCount >= model->ObliviousTrees.GetFlatFeatureVectorExpectedSize(),
+                          "Model #" << header.ModelId << " expects at least "
+                                    << model->ObliviousTrees.GetFlatFeatureVectorExpectedSize()
+                                    << " flat features, got " << header.FloatFeatureCount);
+
+                const ui64 featureCount = static_cast<ui64>(header.DocCount) * header.FloatFeatureCount;
+                CB_ENSURE(featureCount <= MaxFloatsPerRequest, "Too big request: #" << featureCount << " feature values");
+
+                //the payload is read once into a flat buffer that is exactly the evaluation
+                //block layout; per-document views reference it without copying
+                FeatureData.yresize(featureCount);
+                input.Load(FeatureData.data(), featureCount * sizeof(float));
+
+                Docs.yresize(header.DocCount);
+                for (ui32 doc = 0; doc < header.DocCount; ++doc) {
+                    Docs[doc] = TConstArrayRef<float>(FeatureData.data() + static_cast<ui64>(doc) * header.FloatFeatureCount,
+                                                      header.FloatFeatureCount);
+                }
+
+                const ui32 approxDimension = model->ObliviousTrees.ApproxDimension;
+                Results.yresize(static_cast<size_t>(header.DocCount) * approxDimension);
+                model->CalcFlat(Docs, 0, model->GetTreeCount(), Results, Context);
+
+                TScoreResponseHeader responseHeader;
+                responseHeader.DocCount = header.DocCount;
+                responseHeader.ApproxDimension = approxDimension;
+                output.Write(&responseHeader, sizeof(responseHeader));
+                output.Write(Results.data(), Results.size() * sizeof(double));
+            }
+        }
+
+    private:
+        const TModelRegistry& Models;
+        THolder<TInetStreamSocket> OwnListener;
+        TInetStreamSocket* SharedListener;
+
+        TVector<float> FeatureData;
+        TVector<TConstArrayRef<float>> Docs;
+        TVector<double> Results;
+        TEvaluationContext Context;
+    };
+}
+
+int mode_serve(int argc, const char* argv[]) {
+    TVector<TString> modelPaths;
+    ui16 port = 0;
+    ui32 threadCount = 0;
+    ui32 reloadIntervalSec = 0;
+
+    auto parser = NLastGetopt::TOpts();
+    parser.AddHelpOption();
+    parser.AddLongOption('m', "model-path", "model paths; the request's model id selects one by position")
+        .RequiredArgument("PATH")
+        .AppendTo(&modelPaths);
+    parser.AddLongOption("port", "TCP port to listen on")
+        .RequiredArgument("PORT")
+        .DefaultValue("9292")
+        .StoreResult(&port);
+    parser.AddLongOption('T', "threads", "scoring shard count")
+        .RequiredArgument("COUNT")
+        .StoreResult(&threadCount);
+    parser.AddLongOption("model-reload-interval", "seconds between model file checks, 0 disables hot reload")
+        .RequiredArgument("SECONDS")
+        .DefaultValue("0")
+        .StoreResult(&reloadIntervalSec);
+    parser.SetFreeArgsMax(0);
+    NLastGetopt::TOptsParseResult parserResult{&parser, argc, argv};
+
+    if (modelPaths.empty()) {
+        modelPaths.push_back("model.cbm");
+    }
+    if (threadCount == 0) {
+        threadCount = static_cast<ui32>(NSystemInfo::CachedNumberOfCpus());
+    }
+
+    TModelRegistry models(modelPaths);
+
+    THolder<TModelReloadThread> reloadThread;
+    if (reloadIntervalSec > 0) {
+        reloadThread = MakeHolder<TModelReloadThread>(models, reloadIntervalSec);
+        reloadThread->Start();
+    }
+
+    //with SO_REUSEPORT every shard owns its listener and the kernel spreads connections
+    //between them; otherwise the shards accept from one shared listener
+    const bool reusePort = IsReusePortAvailable();
+    THolder<TInetStreamSocket> sharedListener;
+    if (!reusePort) {
+        sharedListener = CreateListener(port, false);
+    }
+
+    TVector<THolder<TScoringShard>> shards;
+    for (ui32 i = 0; i < threadCount; ++i) {
+        THolder<TInetStreamSocket> ownListener;
+        if (reusePort) {
+            ownListener = CreateListener(port, true);
+        }
+        shards.push_back(MakeHolder<TScoringShard>(models, std::move(ownListener), sharedListener.Get()));
+    }
+
+    MATRIXNET_INFO_LOG << "Serving " << models.GetModelCount() << " model(s) on port " << port
+                       << " with " << threadCount << " shard(s)"
+                       << (reusePort ? ", per-shard listeners" : ", shared listener") << Endl;
+
+    for (auto& shard : shards) {
+        shard->Start();
+    }
+    for (auto& shard : shards) {
+        shard->Join();
+    }
+    return 0;
+}
@@ -6,3 +6,4 @@ int mode_ostr(int argc, const char* argv[]);
 int mode_calc(int argc, const char* argv[]);
 int mode_eval_metrics(int argc, const char* argv[]);
 int mode_metadata(int argc, const char* argv[]);
+int mode_serve(int argc, const char* argv[]);
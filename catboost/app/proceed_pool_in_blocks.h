@@ -34,3 +34,156 @@ inline void ReadAndProceedPoolInBlocks(const TAnalyticalModeCommonParams& params
         poolConsumer(pool);
     }
 }
+
+/*
+ * Double-buffered variant: the next block is read and parsed on the executor while
+ * poolConsumer works on the current one, so consumption runs at disk/parse speed with
+ * O(blockSize) memory. poolConsumer is always called from the caller thread in pool order.
+ */
+template <class TConsumer>
+inline void ReadAndProceedPoolInBlocksAsync(const TAnalyticalModeCommonParams& params,
+                                            ui32 blockSize,
+                                            TConsumer&& poolConsumer,
+                                            NPar::TLocalExecutor* localExecutor) {
+    if (localExecutor->GetThreadCount() == 0) {
+        ReadAndProceedPoolInBlocks(params, blockSize, std::forward<TConsumer>(poolConsumer), localExecutor);
+        return;
+    }
+
+    TPool pools[2];
+    THolder<NCB::IPoolBuilder> poolBuilders[2] = {
+        NCB::InitBuilder(*localExecutor, &pools[0]),
+        NCB::InitBuilder(*localExecutor, &pools[1])
+    };
+
+    auto docPoolDataProvider = NCB::GetProcessor<NCB::IDocPoolDataProvider>(
+        params.InputPath, // for choosing processor
+
+        // processor args
+        NCB::TDocPoolDataProviderArgs {
+            params.InputPath,
+            params.PairsFilePath,
+            params.DsvPoolFormatParams,
+            /*ignoredFeatures*/ {},
+            params.ClassNames,
+            blockSize,
+            localExecutor
+        }
+    );
+
+    size_t currentIdx = 0;
+    bool hasData = docPoolDataProvider->DoBlock(poolBuilders[currentIdx].Get());
+    while (hasData) {
+        const size_t nextIdx = currentIdx ^ 1;
+        bool hasNextBlock = false;
+        auto nextBlockFutures = localExecutor->ExecRangeWithFutures(
+            [&](int) {
+                hasNextBlock = docPoolDataProvider->DoBlock(poolBuilders[nextIdx].Get());
+            },
+            0,
+            1,
+            NPar::TLocalExecutor::HIGH_PRIORITY
+        );
+        poolConsumer(pools[currentIdx]);
+        nextBlockFutures[0].GetValueSync();
+        hasData = hasNextBlock;
+        currentIdx = nextIdx;
+    }
+}
+
+/*
+ * Fully pipelined variant: reading, applying and writing of consecutive blocks overlap.
+ * At any moment block i + 1 is read on a background task, block i is applied on the caller
+ * thread (applyConsumer may parallelize internally on the executor) and block i - 1 is
+ * written on another background task. Writes are issued strictly in block order, so an
+ * ordered stream consumer (file writer) needs no reordering of its own. Memory stays
+ * bounded by three blocks regardless of pool size.
+ *
+ * Both consumers get the block index alongside the pool; per-block state shared between
+ * apply and write (e.g. approxes) should be kept by the caller in a ring of three slots
+ * indexed by blockIdx % 3 - a slot is never touched by two blocks at once.
+ */
+template <class TApplyConsumer, class TWriteConsumer>
+inline void ReadAndProceedPoolInBlocksPipelined(const TAnalyticalModeCommonParams& params,
+                                                ui32 blockSize,
+                                                TApplyConsumer&& applyConsumer,
+                                                TWriteConsumer&& writeConsumer,
+                                                NPar::TLocalExecutor* localExecutor) {
+    if (localExecutor->GetThreadCount() < 2) {
+        // not enough threads to run all three stages concurrently
+        size_t sequentialBlockIdx = 0;
+        ReadAndProceedPoolInBlocksAsync(
+            params,
+            blockSize,
+            [&](const TPool& pool) {
+                applyConsumer(pool, sequentialBlockIdx);
+                writeConsumer(pool, sequentialBlockIdx);
+                ++sequentialBlockIdx;
+            },
+            localExecutor);
+        return;
+    }
+
+    constexpr size_t RingSize = 3; // block being written, block being applied, block being read
+    TPool pools[RingSize];
+    THolder<NCB::IPoolBuilder> poolBuilders[RingSize] = {
+        NCB::InitBuilder(*localExecutor, &pools[0]),
+        NCB::InitBuilder(*localExecutor, &pools[1]),
+        NCB::InitBuilder(*localExecutor, &pools[2])
+    };
+
+    auto docPoolDataProvider = NCB::GetProcessor<NCB::IDocPoolDataProvider>(
+        params.InputPath, // for choosing processor
+
+        // processor args
+        NCB::TDocPoolDataProviderArgs {
+            params.InputPath,
+            params.PairsFilePath,
+            params.DsvPoolFormatParams,
+            /*ignoredFeatures*/ {},
+            params.ClassNames,
+            blockSize,
+            localExecutor
+        }
+    );
+
+    size_t blockIdx = 0;
+    bool hasData = docPoolDataProvider->DoBlock(poolBuilders[0].Get());
+    TVector<NThreading::TFuture<void>> writeFutures;
+    while (hasData) {
+        const size_t slot = blockIdx % RingSize;
+        // the read target was written out two iterations ago, so its write has been awaited
+        const size_t readSlot = (blockIdx + 1) % RingSize;
+        bool hasNextBlock = false;
+        auto readFutures = localExecutor->ExecRangeWithFutures(
+            [&](int) {
+                hasNextBlock = docPoolDataProvider->DoBlock(poolBuilders[readSlot].Get());
+            },
+            0,
+            1,
+            NPar::TLocalExecutor::HIGH_PRIORITY
+        );
+
+        applyConsumer(pools[slot], blockIdx);
+
+        // keep writes ordered: the previous block must be flushed before this one starts
+        if (!writeFutures.empty()) {
+            writeFutures[0].GetValueSync();
+        }
+        writeFutures = localExecutor->ExecRangeWithFutures(
+            [&, slot, blockIdx](int) {
+                writeConsumer(pools[slot], blockIdx);
+            },
+            0,
+            1,
+            NPar::TLocalExecutor::HIGH_PRIORITY
+        );
+
+        readFutures[0].GetValueSync();
+        hasData = hasNextBlock;
+        ++blockIdx;
+    }
+    if (!writeFutures.empty()) {
+        writeFutures[0].GetValueSync();
+    }
+}
@@ -0,0 +1,230 @@
+#include <catboost/libs/algo/error_functions.h>
+#include <catboost/libs/algo/index_hash_calcer.h>
+#include <catboost/libs/algo/score_calcer.h>
+#include <catboost/libs/model/formula_evaluator.h>
+
+#include <library/getopt/small/last_getopt.h>
+
+#include <util/generic/algorithm.h>
+#include <util/generic/array_ref.h>
+#include <util/generic/vector.h>
+#include <util/generic/ymath.h>
+#include <util/random/fast.h>
+#include <util/string/cast.h>
+#include <util/system/hp_timer.h>
+
+/* Microbenchmarks for the CPU training hot kernels. Each benchmark runs the kernel
+ * `iterations` times over synthetic data generated from a fixed seed and reports a
+ * ns/doc baseline, so runs are directly comparable between revisions.
+ *
+ * Notes on coverage:
+ *  - the histogram benchmarks drive UpdateBucketStats, the kernel behind CalcStatsImpl;
+ *  - CalcIndexesSse is local to formula_evaluator.cpp, so document binarization is
+ *    covered through BinarizeFloats, which it feeds;
+ *  - ComputeOnlineCTRs needs a full learn context, so its hot stages are benchmarked
+ *    directly: CalcHashes, ComputeReindexHash and ReindexHashesBySort.
+ */
+
+struct TBenchmarkParams {
+    int DocCount = 100000;
+    int FeatureCount = 4;
+    int BorderCount = 32;
+    int BucketCount = 128;
+    int LeafCount = 8;
+    int Iterations = 100;
+};
+
+static void Report(const TString& name, double seconds, const TBenchmarkParams& params) {
+    const double nsPerDoc = seconds * 1e9 / ((double)params.DocCount * params.Iterations);
+    Cout << name << ": " << FloatToString(nsPerDoc, PREC_NDIGITS, 4) << " ns/doc" << Endl;
+}
+
+template<typename TDerType, typename THasSampleWeights>
+static void RunHistogramBenchmark(const TString& name, const THasSampleWeights& hasSampleWeights,
+                                  const TBenchmarkParams& params, TFastRng64* rng) {
+    const int statsSize = params.LeafCount * params.BucketCount;
+    TVector<ui32> singleIdx;
+    singleIdx.yresize(params.DocCount);
+    for (auto& idx : singleIdx) {
+        idx = rng->Uniform(statsSize);
+    }
+    TVector<TDerType> derivatives;
+    TVector<float> weights;
+    derivatives.yresize(params.DocCount);
+    weights.yresize(params.DocCount);
+    for (int doc = 0; doc < params.DocCount; ++doc) {
+        derivatives[doc] = (TDerType)(rng->GenRandReal1() - 0.5);
+        weights[doc] = 1.0f;
+    }
+    TVector<TBucketStats> stats;
+    stats.yresize(statsSize);
+
+    THPTimer timer;
+    double seconds = 0;
+    for (int iter = 0; iter < params.Iterations; ++iter) {
+        timer.Reset();
+        Fill(stats.begin(), stats.end(), TBucketStats{0, 0, 0, 0});
+        UpdateBucketStats(hasSampleWeights, singleIdx, derivatives.data(), derivatives.data(), weights.data(), weights.data(),
+            /*isPlainMode*/ true, params.DocCount, params.DocCount, statsSize, stats.data());
+        seconds += timer.Passed();
+    }
+    Report(name, seconds, params);
+}
+
+static void RunBinarizeFloatsBenchmark(const TBenchmarkParams& params, TFastRng64* rng) {
+    TVector<float> values;
+    values.yresize(params.DocCount);
+    for (auto& value : values) {
+        value = (float)rng->GenRandReal1();
+    }
+    TVector<float> borders;
+    borders.yresize(params.BorderCount);
+    for (int borderIdx = 0; borderIdx < params.BorderCount; ++borderIdx) {
+        borders[borderIdx] = (borderIdx + 1.0f) / (params.BorderCount + 1);
+    }
+    TVector<ui8> binarized;
+    binarized.yresize(params.DocCount);
+    const float* valuesData = values.data();
+
+    THPTimer timer;
+    double seconds = 0;
+    for (int iter = 0; iter < params.Iterations; ++iter) {
+        timer.Reset();
+        // BinarizeFloats accumulates into the result buffer, so it is re-zeroed each
+        // pass, same as the per-block buffers in the model evaluator.
+        Fill(binarized.begin(), binarized.end(), (ui8)0);
+        ui8* cursor = binarized.data();
+        BinarizeFloats<false>(params.DocCount, [valuesData](size_t idx) { return valuesData[idx]; },
+            MakeConstArrayRef(borders), /*start*/ 0, cursor);
+        seconds += timer.Passed();
+    }
+    Report("BinarizeFloats", seconds, params);
+}
+
+static void RunCtrHashBenchmarks(const TBenchmarkParams& params, TFastRng64* rng) {
+    const int catValueCount = 100;
+    TAllFeatures allFeatures;
+    allFeatures.CatFeaturesRemapped.resize(params.FeatureCount);
+    for (auto& featureValues : allFeatures.CatFeaturesRemapped) {
+        featureValues.yresize(params.DocCount);
+        for (auto& value : featureValues) {
+            value = rng->Uniform(catValueCount);
+        }
+    }
+    TProjection proj;
+    for (int featureIdx = 0; featureIdx < params.FeatureCount; ++featureIdx) {
+        proj.CatFeatures.push_back(featureIdx);
+    }
+    TVector<ui64> hashArr;
+    hashArr.yresize(params.DocCount);
+
+    THPTimer timer;
+    double seconds = 0;
+    for (int iter = 0; iter < params.Iterations; ++iter) {
+        timer.Reset();
+        Fill(hashArr.begin(), hashArr.end(), (ui64)0);
+        CalcHashes(proj, allFeatures, /*offset*/ 0, /*learnPermutation*/ nullptr,
+            /*calculateExactCatHashes*/ false, hashArr.begin(), hashArr.end());
+        seconds += timer.Passed();
+    }
+    Report("CalcHashes", seconds, params);
+
+    const TVector<ui64> hashArrTemplate = hashArr;
+    TVector<ui64> scratch;
+    scratch.yresize(params.DocCount);
+
+    seconds = 0;
+    for (int iter = 0; iter < params.Iterations; ++iter) {
+        Copy(hashArrTemplate.begin(), hashArrTemplate.end(), scratch.begin());
+        TDenseHash<ui64, ui32> reindexHash;
+        timer.Reset();
+        ComputeReindexHash(Max<ui64>(), &reindexHash, scratch.begin(), scratch.end());
+        seconds += timer.Passed();
+    }
+    Report("ComputeReindexHash", seconds, params);
+
+    seconds = 0;
+    for (int iter = 0; iter < params.Iterations; ++iter) {
+        Copy(hashArrTemplate.begin(), hashArrTemplate.end(), scratch.begin());
+        timer.Reset();
+        ReindexHashesBySort(scratch.begin(), scratch.end());
+        seconds += timer.Passed();
+    }
+    Report("ReindexHashesBySort", seconds, params);
+}
+
+template<typename TError>
+static void RunDersRangeBenchmark(const TString& name, const TError& error, bool storeExpApprox,
+                                  const TBenchmarkParams& params, TFastRng64* rng) {
+    TVector<double> approxes;
+    TVector<float> targets;
+    approxes.yresize(params.DocCount);
+    targets.yresize(params.DocCount);
+    for (int doc = 0; doc < params.DocCount; ++doc) {
+        const double approx = 2 * rng->GenRandReal1() - 1;
+        approxes[doc] = storeExpApprox ? exp(approx) : approx;
+        targets[doc] = (float)rng->Uniform(2);
+    }
+    TVector<TDers> ders;
+    ders.yresize(params.DocCount);
+
+    THPTimer timer;
+    double seconds = 0;
+    for (int iter = 0; iter < params.Iterations; ++iter) {
+        timer.Reset();
+        error.CalcDersRange(/*start*/ 0, params.DocCount, /*calcThirdDer*/ false,
+            approxes.data(), /*approxDeltas*/ nullptr, targets.data(), /*weights*/ nullptr, ders.data());
+        seconds += timer.Passed();
+    }
+    Report(name, seconds, params);
+}
+
+int main(int argc, const char* argv[]) {
+    TBenchmarkParams params;
+    auto parser = NLastGetopt::TOpts();
+    parser.AddLongOption("doc-count")
+        .RequiredArgument("INT")
+        .StoreResult(&params.DocCount)
+        .DefaultValue(ToString(params.DocCount))
+        .Help("Document count per kernel invocation.");
+    parser.AddLongOption("feature-count")
+        .RequiredArgument("INT")
+        .StoreResult(&params.FeatureCount)
+        .DefaultValue(ToString(params.FeatureCount))
+        .Help("Categorical feature count in the CTR hash projection.");
+    parser.AddLongOption("border-count")
+        .RequiredArgument("INT")
+        .StoreResult(&params.BorderCount)
+        .DefaultValue(ToString(params.BorderCount))
+        .Help("Border count for float binarization.");
+    parser.AddLongOption("bucket-count")
+        .RequiredArgument("INT")
+        .StoreResult(&params.BucketCount)
+        .DefaultValue(ToString(params.BucketCount))
+        .Help("Bucket count per leaf for the histogram fill.");
+    parser.AddLongOption("leaf-count")
+        .RequiredArgument("INT")
+        .StoreResult(&params.LeafCount)
+        .DefaultValue(ToString(params.LeafCount))
+        .Help("Leaf count for the histogram fill.");
+    parser.AddLongOption("iterations")
+        .RequiredArgument("INT")
+        .StoreResult(&params.Iterations)
+        .DefaultValue(ToString(params.Iterations))
+        .Help("Kernel invocations per benchmark; ns/doc is averaged over all of them.");
+    NLastGetopt::TOptsParseResult parseResult(&parser, argc, argv);
+    Y_UNUSED(parseResult);
+
+    TFastRng64 rng(20180101);
+    RunHistogramBenchmark<double>("UpdateBucketStats<double>", std::true_type(), params, &rng);
+    RunHistogramBenchmark<float>("UpdateBucketStats<float>", std::true_type(), params, &rng);
+    RunHistogramBenchmark<double>("UpdateBucketStats<double, unweighted>", std::false_type(), params, &rng);
+    RunHistogramBenchmark<float>("UpdateBucketStats<float, unweighted>", std::false_type(), params, &rng);
+    RunBinarizeFloatsBenchmark(params, &rng);
+    RunCtrHashBenchmarks(params, &rng);
+    RunDersRangeBenchmark("CalcDersRange<Logloss>", TCrossEntropyError(/*storeExpApprox*/ true),
+        /*storeExpApprox*/ true, params, &rng);
+    RunDersRangeBenchmark("CalcDersRange<RMSE>", TRMSEError(/*storeExpApprox*/ false),
+        /*storeExpApprox*/ false, params, &rng);
+    return 0;
+}
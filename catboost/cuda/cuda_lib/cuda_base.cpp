@@ -11,6 +11,16 @@ namespace NCudaLib {
         CUDA_SAFE_CALL(cudaFreeHost((void*)ptr));
     }
 
+    char* CudaManagedAllocate(ui64 size) {
+        void* ptr = nullptr;
+        CUDA_SAFE_CALL(cudaMallocManaged(&ptr, size, cudaMemAttachGlobal));
+        return static_cast<char*>(ptr);
+    }
+
+    void CudaManagedFree(char* ptr) {
+        CUDA_SAFE_CALL(cudaFree((void*)ptr));
+    }
+
     cudaStream_t TCudaStreamsProvider::NewStream() {
         cudaStream_t stream;
         CUDA_SAFE_CALL(cudaStreamCreateWithFlags(&stream, cudaStreamNonBlocking));
@@ -186,6 +186,10 @@ namespace NCudaLib {
     char* CudaHostAllocate(ui64 size);
     void CudaHostFree(char* ptr);
 
+    //unified memory: device-accessible, may be oversubscribed and paged by the driver
+    char* CudaManagedAllocate(ui64 size);
+    void CudaManagedFree(char* ptr);
+
     template <>
     class TCudaMemoryAllocation<EPtrType::CudaHost> {
     public:
@@ -31,7 +31,7 @@ namespace NCudaLib {
                 return 1;
             }
 
-#ifndef USE_MPI
+#ifndef USE_REMOTE_DEVICES
             if (TFromBuffer::PtrType() != EPtrType::CudaDevice) {
                 return 1;
             }
@@ -59,7 +59,7 @@ namespace NKernelHost {
 }
 
 namespace NCudaLib {
-#if defined(USE_MPI)
+#if defined(USE_REMOTE_DEVICES)
 
     template <class T>
     struct TReduceOperator {
@@ -89,7 +89,7 @@ namespace NCudaLib {
         TVector<bool> IsPeerLocalTask;
         bool AreLocalTaskSend = false;
 
-#if defined(USE_MPI)
+#if defined(USE_REMOTE_DEVICES)
         TVector<THolder<IStagedTask>> RunningStagedTasks;
 #endif
     };
@@ -109,7 +109,7 @@ namespace NCudaLib {
             Y_SAVELOAD_DEFINE(Source, Dest);
         };
 
-#if defined(USE_MPI)
+#if defined(USE_REMOTE_DEVICES)
         struct TRemoteHostReduce {
             NKernelHost::TCudaBufferPtr<T> Source;
             NKernelHost::TCudaBufferPtr<T> Dest;
@@ -149,7 +149,7 @@ namespace NCudaLib {
                 }
             }
 
-#if defined(USE_MPI)
+#if defined(USE_REMOTE_DEVICES)
 
             TReduceOperator<T> op;
             op.BlockSize = 4 * 1024 * 1024 / sizeof(T);
@@ -236,7 +236,7 @@ namespace NCudaLib {
                 context.AreLocalTaskSend = true;
             }
 
-#if defined(USE_MPI)
+#if defined(USE_REMOTE_DEVICES)
 
             if (context.RunningStagedTasks.size()) {
                 ExecStagedTasks(stream, &context.RunningStagedTasks);
@@ -247,7 +247,7 @@ namespace NCudaLib {
 #endif
         }
 
-#if defined(USE_MPI)
+#if defined(USE_REMOTE_DEVICES)
         Y_SAVELOAD_DEFINE(LocalReduces, RemoteReduces);
 #else
         Y_SAVELOAD_DEFINE(LocalReduces);
@@ -257,7 +257,7 @@ namespace NCudaLib {
         friend class TReducer;
 
         TVector<TLocalHostReduce> LocalReduces;
-#if defined(USE_MPI)
+#if defined(USE_REMOTE_DEVICES)
         TVector<TRemoteHostReduce> RemoteReduces;
 #endif
     };
@@ -434,7 +434,7 @@ namespace NCudaLib {
         TReducer& operator()(TBuffer& data,
                              const TStripeMapping& resultMapping,
                              const bool compressFlag = false) {
-#ifndef USE_MPI
+#ifndef USE_REMOTE_DEVICES
             Y_UNUSED(compressFlag);
 #endif
 
@@ -477,8 +477,8 @@ namespace NCudaLib {
 
                     const bool isInterHostReduce = manager.GetDeviceId(task.ReadDevice).HostId != manager.GetDeviceId(task.WriteDevice).HostId;
                     if (isInterHostReduce) {
-#if defined(USE_MPI)
-                        const int tag = GetMpiManager().NextCommunicationTag();
+#if defined(USE_REMOTE_DEVICES)
+                        const int tag = GetTransportManager().NextCommunicationTag();
                         typename TKernel::TRemoteHostReduce sendTask;
                         sendTask.Tag = tag;
                         sendTask.IsSendTask = true;
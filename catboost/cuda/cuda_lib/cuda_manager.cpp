@@ -3,7 +3,7 @@
 #include "mapping.h"
 #include "cuda_buffer.h"
 #include <catboost/cuda/cuda_lib/tasks_impl/memory_copy_tasks.h>
-#include <catboost/cuda/cuda_lib/tasks_queue/mpi_task_queue.h>
+#include <catboost/cuda/cuda_lib/tasks_queue/remote_task_queue.h>
 #include <catboost/cuda/cuda_lib/tasks_impl/enable_peers.h>
 #include <catboost/cuda/cuda_lib/cuda_buffer_helpers/buffer_resharding.h>
 
@@ -251,19 +251,19 @@ bool TCudaManager::HasRemoteDevices() const {
 }
 
 void RunSlave() {
-#if defined(USE_MPI)
-    THostDevices hostWorkers(GetMpiManager().GetHostId());
+#if defined(USE_REMOTE_DEVICES)
+    THostDevices hostWorkers(GetTransportManager().GetHostId());
     TVector<TSingleHostTaskQueue*> workerQueues;
     for (ui32 i = 0; i < hostWorkers.GetDeviceCount(); ++i) {
         workerQueues.push_back(&hostWorkers.GetWorkerQueue(i));
     }
-    TMpiTaskSlaveForwarder taskForwarder(std::move(workerQueues));
+    TRemoteTaskSlaveForwarder taskForwarder(std::move(workerQueues));
     auto areWorkersStopped = [&]() -> bool {
         return !hostWorkers.IsRunning();
     };
     taskForwarder.Run(areWorkersStopped);
     hostWorkers.Join();
-    GetMpiManager().Stop();
+    GetTransportManager().Stop();
 #endif
 }
 
@@ -282,8 +282,8 @@ TFinallyGuard<TStopCudaManagerCallback> StartCudaManager(const NCudaLib::TDevice
                                                          const ELoggingLevel loggingLevel) {
     SetLogingLevel(loggingLevel);
 
-#if defined(USE_MPI)
-    CB_ENSURE(GetMpiManager().IsMaster(), "Error: can't run cudaManager on slave");
+#if defined(USE_REMOTE_DEVICES)
+    CB_ENSURE(GetTransportManager().IsMaster(), "Error: can't run cudaManager on slave");
 #endif
 
     auto& manager = NCudaLib::GetCudaManager();
@@ -1,7 +1,9 @@
 #pragma once
 
 #include "cuda_manager.h"
+#include <library/chromium_trace/global.h>
 #include <cmath>
+#include <util/generic/strbuf.h>
 #include <util/generic/string.h>
 #include <util/generic/yexception.h>
 
@@ -73,6 +75,9 @@ namespace NCudaLib {
             if (ProfileMode == EProfileMode::ImplicitLabelSync) {
                 GetCudaManager().WaitComplete();
             }
+            //no-op unless a trace session is active; puts gpu labels on the same
+            //chromium trace timeline as the cpu-side scopes
+            NChromiumTrace::GetGlobalTracer()->AddDurationBeginNow(Label, AsStringBuf("gpu"));
             Time = std::chrono::high_resolution_clock::now();
         }
 
@@ -86,6 +91,7 @@ namespace NCudaLib {
             if (ProfileMode == EProfileMode::ImplicitLabelSync) {
                 GetCudaManager().WaitComplete();
             }
+            NChromiumTrace::GetGlobalTracer()->AddDurationEndNow();
 
             auto elapsed = std::chrono::high_resolution_clock::now() - Time;
             double val = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() * 1.0 / 1000 / 1000;
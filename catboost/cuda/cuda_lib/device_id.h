@@ -16,7 +16,7 @@ namespace NCudaLib {
             : HostId(hostId)
             , DeviceId(deviceId)
         {
-#ifndef USE_MPI
+#ifndef USE_REMOTE_DEVICES
             Y_VERIFY(hostId == 0, "Remote device support is not enabled");
 #endif
         }
@@ -8,7 +8,7 @@
 namespace NCudaLib {
     class TDevicesList {
     private:
-#ifdef USE_MPI
+#ifdef USE_REMOTE_DEVICES
         static const ui64 MaxDeviceCount = 256;
 #else
         static const ui64 MaxDeviceCount = 64;
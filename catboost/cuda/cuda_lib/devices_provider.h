@@ -121,7 +121,7 @@ namespace NCudaLib {
     class TDevicesProvider {
     private:
         THolder<THostDevices> MasterWorkers;
-#if defined(USE_MPI)
+#if defined(USE_REMOTE_DEVICES)
         TVector<THolder<TRemoteHostTasksForwarder>> SlaveForwarders;
 #endif
 
@@ -142,13 +142,13 @@ namespace NCudaLib {
             }
         }
 
-#if defined(USE_MPI)
+#if defined(USE_REMOTE_DEVICES)
         inline void InitSlaveForwarders() {
             CB_ENSURE(MasterWorkers, "Create local workers first");
             CB_ENSURE(SlaveForwarders.size() == 0, "Can't init more than once");
 
-            const auto& devices = GetMpiManager().GetDevices();
-            const auto& deviceProps = GetMpiManager().GetDeviceProperties();
+            const auto& devices = GetTransportManager().GetDevices();
+            const auto& deviceProps = GetTransportManager().GetDeviceProperties();
 
             const ui32 masterDevice = MasterWorkers->GetDeviceCount();
 
@@ -169,7 +169,7 @@ namespace NCudaLib {
             CB_ENSURE(GetHostId() == 0, "Error: could use devices provider only on master host");
 
             InitLocalDevices();
-#if defined(USE_MPI)
+#if defined(USE_REMOTE_DEVICES)
             InitSlaveForwarders();
 #endif
 
@@ -195,11 +195,14 @@ namespace NCudaLib {
             Devices.clear();
         }
 
-        friend class TMpiManager;
+#if defined(USE_REMOTE_DEVICES)
+        //transport owns devices shutdown on the master
+        friend TTransportManager;
+#endif
 
     public:
         ~TDevicesProvider() {
-#if defined(USE_MPI)
+#if defined(USE_REMOTE_DEVICES)
             Y_VERIFY(Devices.size() == 0);
 #else
             Devices.resize(0);
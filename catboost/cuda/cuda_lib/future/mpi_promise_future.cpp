@@ -1 +0,0 @@
-#include "mpi_promise_future.h"
@@ -1,6 +1,6 @@
 #pragma once
 
-#include "mpi_promise_future.h"
+#include "remote_promise_future.h"
 #include "local_promise_future.h"
 #include <catboost/cuda/cuda_lib/device_id.h>
 
@@ -8,17 +8,17 @@ namespace NCudaLib {
     template <bool IsRemote>
     class TPromiseFactory;
 
-#if defined(USE_MPI)
+#if defined(USE_REMOTE_DEVICES)
     template <>
     class TPromiseFactory<true> {
     public:
         template <class T>
-        using TPromise = TMpiPromise<T>;
+        using TPromise = TRemotePromise<T>;
 
         template <class T>
         static inline TPromise<T> CreateDevicePromise(const TDeviceId& deviceId) {
             CB_ENSURE(deviceId.HostId != 0, "Error: can't create remote promise on master host");
-            return TPromise<T>(deviceId.HostId, TMpiManager::GetMasterId());
+            return TPromise<T>(deviceId.HostId, TTransportManager::GetMasterId());
         }
     };
 #endif
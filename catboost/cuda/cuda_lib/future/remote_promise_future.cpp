@@ -0,0 +1 @@
+#include "remote_promise_future.h"
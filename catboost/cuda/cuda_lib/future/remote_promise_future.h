@@ -1,20 +1,20 @@
 #pragma once
 
 #include "future.h"
-#include <catboost/cuda/cuda_lib/mpi/mpi_manager.h>
+#include <catboost/cuda/cuda_lib/transport.h>
 #include <catboost/libs/helpers/exception.h>
 #include <util/generic/noncopyable.h>
 #include <util/stream/buffer.h>
 #include <util/ysaveload.h>
 
 namespace NCudaLib {
-#ifdef USE_MPI
+#ifdef USE_REMOTE_DEVICES
 
     //this primitives for small messages only.
     //Heavy memp-cpy tasks will be done separatly
     //could be used only on host
     template <class T>
-    class TMpiFuture: public IDeviceFuture<T>, public TMoveOnly {
+    class TRemoteFuture: public IDeviceFuture<T>, public TMoveOnly {
     public:
         bool Has() final {
             return Request->IsComplete();
@@ -38,15 +38,15 @@ namespace NCudaLib {
             return Result;
         }
 
-        TMpiFuture() {
+        TRemoteFuture() {
         }
 
-        TMpiFuture(TMpiFuture&& other) = default;
+        TRemoteFuture(TRemoteFuture&& other) = default;
 
     private:
-        TMpiFuture(int sourceRank,
+        TRemoteFuture(int sourceRank,
                    int tag) {
-            auto& manager = GetMpiManager();
+            auto& manager = GetTransportManager();
 
             if (std::is_pod<T>::value) {
                 Request = manager.ReceivePodAsync(sourceRank, tag, &Result);
@@ -59,50 +59,50 @@ namespace NCudaLib {
         }
 
         template <class TC>
-        friend class TMpiPromise;
+        friend class TRemotePromise;
 
     private:
-        TMpiManager::TMpiRequestPtr Request;
+        TTransportRequestPtr Request;
         TBuffer Data;
         bool NeedDeserialization = true;
         T Result;
     };
 
     template <class T>
-    class TMpiPromise {
+    class TRemotePromise {
     public:
-        using TFuturePtr = THolder<TMpiFuture<T>>;
+        using TFuturePtr = THolder<TRemoteFuture<T>>;
 
         template <class TC>
         void SetValue(TC&& value) {
             CB_ENSURE(DestRank != -1, "Error: Empty promise");
             CB_ENSURE(!IsSet, "Can't set future more, than once");
-            auto& manager = GetMpiManager();
+            auto& manager = GetTransportManager();
             CB_ENSURE(manager.GetHostId() == SourceRank);
             manager.Send(value, DestRank, Tag);
             IsSet = true;
         }
 
-        TMpiPromise() {
+        TRemotePromise() {
         }
 
-        TMpiPromise(TMpiPromise&& other) = default;
+        TRemotePromise(TRemotePromise&& other) = default;
 
         TFuturePtr GetFuture() {
             CB_ENSURE(!IsFutureCreated, "Can't create future more, than once");
-            auto& manager = GetMpiManager();
+            auto& manager = GetTransportManager();
             CB_ENSURE(manager.GetHostId() == DestRank, "Future could be created only on source rank");
             IsFutureCreated = true;
-            return new TMpiFuture<T>(SourceRank, Tag);
+            return new TRemoteFuture<T>(SourceRank, Tag);
         }
 
-        TMpiPromise(int sourceRank,
+        TRemotePromise(int sourceRank,
                     int destRank)
             : SourceRank(sourceRank)
             , DestRank(destRank)
         {
             CB_ENSURE(sourceRank != destRank, "Error: sourceRank and destRank should be different");
-            auto& manager = GetMpiManager();
+            auto& manager = GetTransportManager();
             CB_ENSURE(manager.IsMaster(), "Error: promise could be done only on master");
             Tag = manager.NextCommunicationTag();
         }
@@ -118,17 +118,17 @@ namespace NCudaLib {
     };
 
     template <class T>
-    inline TMpiPromise<T> CreateDevicePromise(int deviceId) {
-        return TMpiPromise<T>(deviceId, GetMpiManager().GetMasterId());
+    inline TRemotePromise<T> CreateDevicePromise(int deviceId) {
+        return TRemotePromise<T>(deviceId, GetTransportManager().GetMasterId());
     }
 
     class TRemoteDeviceRequest: public IDeviceRequest {
     public:
-        TRemoteDeviceRequest(TMpiRequestPtr&& request) {
+        TRemoteDeviceRequest(TTransportRequestPtr&& request) {
             Requests.push_back(std::move(request));
         }
 
-        TRemoteDeviceRequest(TVector<TMpiRequestPtr>&& requests)
+        TRemoteDeviceRequest(TVector<TTransportRequestPtr>&& requests)
             : Requests(std::move(requests))
         {
         }
@@ -138,7 +138,7 @@ namespace NCudaLib {
         }
 
     private:
-        TVector<TMpiRequestPtr> Requests;
+        TVector<TTransportRequestPtr> Requests;
     };
 
 #endif
@@ -77,11 +77,19 @@ namespace NCudaLib {
                         IGpuKernelTask* kernelTask = reinterpret_cast<IGpuKernelTask*>(task.Get());
                         const ui32 streamId = kernelTask->GetStreamId();
                         if (streamId == 0) {
-                            WaitAllTaskToSubmit();
-                            SyncActiveStreams(true);
-                            if (ObjectsToFree.size()) {
-                                DeleteObjects();
-                                SyncStream(0);
+                            /* Default-stream kernels synchronize with every other active stream.
+                             * When only the default stream is in use and nothing waits to be freed,
+                             * its own FIFO order already gives that guarantee, so skip the
+                             * submit barrier: it dominates launch overhead for the long
+                             * per-iteration sequences of small kernels.
+                             */
+                            if (HasActiveNonDefaultStreams() || ObjectsToFree.size()) {
+                                WaitAllTaskToSubmit();
+                                SyncActiveStreams(true);
+                                if (ObjectsToFree.size()) {
+                                    DeleteObjects();
+                                    SyncStream(0);
+                                }
                             }
                         }
                         auto& stream = *Streams[streamId];
@@ -182,6 +182,15 @@ namespace NCudaLib {
             }
         }
 
+        bool HasActiveNonDefaultStreams() const {
+            for (ui32 i = 1; i < Streams.size(); ++i) {
+                if (Streams[i]->IsActive()) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
         void SyncActiveStreams(bool skipDefault = false) {
             for (ui32 i = (ui64)skipDefault; i < Streams.size(); ++i) {
                 if (Streams[i]->IsActive()) {
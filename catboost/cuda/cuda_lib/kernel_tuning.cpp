@@ -0,0 +1,161 @@
+#include "kernel_tuning.h"
+
+#include <catboost/libs/logging/logging.h>
+
+#include <util/generic/bitops.h>
+#include <util/generic/utility.h>
+#include <util/stream/file.h>
+#include <util/string/builder.h>
+#include <util/string/cast.h>
+#include <util/system/env.h>
+#include <util/system/file.h>
+#include <util/system/fs.h>
+#include <util/system/guard.h>
+
+#include <limits>
+
+namespace NCudaLib {
+    //0 is the built-in heuristic, the rest are forced block-per-feature multipliers
+    static const ui32 TuningCandidates[] = {0, 1, 4, 16, 64};
+    static const ui32 CandidateCount = Y_ARRAY_SIZE(TuningCandidates);
+    //each candidate is timed twice, the best time wins: single runs are too noisy
+    static const ui32 RunsPerCandidate = 2;
+
+    bool TKernelTuningCache::IsEnabled() {
+        with_lock (Lock) {
+            EnsureLoaded();
+            return Enabled;
+        }
+    }
+
+    ui32 TKernelTuningCache::StartLaunch(const TString& key, bool* benchmark) {
+        with_lock (Lock) {
+            EnsureLoaded();
+
+            TTuningEntry& entry = Entries[key];
+            if (entry.Finished) {
+                *benchmark = false;
+                return entry.Winner;
+            }
+
+            if (entry.BestTimes.empty()) {
+                entry.BestTimes.resize(CandidateCount, std::numeric_limits<float>::max());
+                entry.RunCounts.resize(CandidateCount, 0);
+            }
+
+            const ui32 idx = entry.NextTrial % CandidateCount;
+            ++entry.NextTrial;
+            *benchmark = true;
+            return TuningCandidates[idx];
+        }
+    }
+
+    void TKernelTuningCache::ReportBenchmark(const TString& key, ui32 candidate, float timeMs) {
+        with_lock (Lock) {
+            TTuningEntry& entry = Entries[key];
+            if (entry.Finished || entry.BestTimes.empty()) {
+                return;
+            }
+
+            for (ui32 idx = 0; idx < CandidateCount; ++idx) {
+                if (TuningCandidates[idx] == candidate) {
+                    entry.BestTimes[idx] = Min(entry.BestTimes[idx], timeMs);
+                    ++entry.RunCounts[idx];
+                    break;
+                }
+            }
+
+            for (ui32 idx = 0; idx < CandidateCount; ++idx) {
+                if (entry.RunCounts[idx] < RunsPerCandidate) {
+                    return;
+                }
+            }
+
+            ui32 bestIdx = 0;
+            for (ui32 idx = 1; idx < CandidateCount; ++idx) {
+                if (entry.BestTimes[idx] < entry.BestTimes[bestIdx]) {
+                    bestIdx = idx;
+                }
+            }
+            entry.Winner = TuningCandidates[bestIdx];
+            entry.Finished = true;
+
+            MATRIXNET_DEBUG_LOG << "Tuned " << key << ": multiplier " << entry.Winner
+                                << " (" << entry.BestTimes[bestIdx] << "ms, heuristic "
+                                << entry.BestTimes[0] << "ms)" << Endl;
+
+            if (CacheFile) {
+                AppendToCacheFile(key, entry.Winner);
+            }
+        }
+    }
+
+    void TKernelTuningCache::EnsureLoaded() {
+        if (Loaded) {
+            return;
+        }
+
+        Enabled = FromString<bool>(GetEnv("CB_TUNE_HIST_KERNELS", "0"));
+        CacheFile = GetEnv("CB_KERNEL_TUNING_CACHE", "");
+
+        if (CacheFile && NFs::Exists(CacheFile)) {
+            TIFStream in(CacheFile);
+            TString line;
+            while (in.ReadLine(line)) {
+                TStringBuf key;
+                TStringBuf winner;
+                if (!TStringBuf(line).TryRSplit('\t', key, winner)) {
+                    continue;
+                }
+                ui32 value = 0;
+                if (TryFromString<ui32>(winner, value)) {
+                    TTuningEntry& entry = Entries[TString(key)];
+                    entry.Winner = value;
+                    entry.Finished = true;
+                }
+            }
+        }
+
+        Loaded = true;
+    }
+
+    void TKernelTuningCache::AppendToCacheFile(const TString& key, ui32 winner) {
+        TFile file(CacheFile, OpenAlways | WrOnly | ForAppend);
+        TUnbufferedFileOutput out(file);
+        out << key << '\t' << winner << '\n';
+    }
+
+    TString MakeKernelTuningKey(const char* kernel,
+                                int policy,
+                                ui32 partCount,
+                                ui32 foldCount,
+                                ui64 docCount) {
+        const ui32 sizeLog = docCount ? static_cast<ui32>(MostSignificantBit(docCount)) : 0;
+        TStringBuilder builder;
+        builder << kernel
+                << "/policy" << policy
+                << "/parts" << partCount
+                << "/folds" << foldCount
+                << "/log2size" << sizeLog
+                << "/" << NCudaHelpers::GetDeviceProps(GetDevice()).GetName();
+        return builder;
+    }
+
+    TKernelLaunchTimer::TKernelLaunchTimer(cudaStream_t stream)
+        : Stream(stream)
+    {
+        CUDA_SAFE_CALL(cudaEventCreate(&StartEvent));
+        CUDA_SAFE_CALL(cudaEventCreate(&StopEvent));
+        CUDA_SAFE_CALL(cudaEventRecord(StartEvent, Stream));
+    }
+
+    float TKernelLaunchTimer::Stop() {
+        CUDA_SAFE_CALL(cudaEventRecord(StopEvent, Stream));
+        CUDA_SAFE_CALL(cudaEventSynchronize(StopEvent));
+        float elapsedMs = 0;
+        CUDA_SAFE_CALL(cudaEventElapsedTime(&elapsedMs, StartEvent, StopEvent));
+        CUDA_SAFE_CALL(cudaEventDestroy(StartEvent));
+        CUDA_SAFE_CALL(cudaEventDestroy(StopEvent));
+        return elapsedMs;
+    }
+}
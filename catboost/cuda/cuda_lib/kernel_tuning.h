@@ -0,0 +1,79 @@
+#pragma once
+
+#include "cuda_base.h"
+
+#include <util/generic/hash.h>
+#include <util/generic/singleton.h>
+#include <util/generic/string.h>
+#include <util/generic/vector.h>
+#include <util/system/spinlock.h>
+
+namespace NCudaLib {
+    /*
+     * Host-side cache of tuned kernel launch configurations.
+     *
+     * Optimal histogram launch shapes depend on the feature grouping policy, the
+     * partition shape and the device, and the built-in heuristics are not optimal
+     * everywhere. When tuning is enabled (CB_TUNE_HIST_KERNELS=1), the first
+     * launches for an unseen (kernel, policy, shape, device) key benchmark several
+     * block-per-feature multipliers; the winner is remembered and, if
+     * CB_KERNEL_TUNING_CACHE points to a file, persisted and reused across runs.
+     */
+    class TKernelTuningCache {
+    public:
+        bool IsEnabled();
+
+        /* Configuration to use for this launch. While the key is still being
+         * explored it returns the next candidate and sets *benchmark: the caller
+         * has to time the launch and call ReportBenchmark with the result.
+         * Value 0 means "use the built-in heuristic".
+         */
+        ui32 StartLaunch(const TString& key, bool* benchmark);
+
+        void ReportBenchmark(const TString& key, ui32 candidate, float timeMs);
+
+    private:
+        struct TTuningEntry {
+            TVector<float> BestTimes;
+            TVector<ui32> RunCounts;
+            ui32 NextTrial = 0;
+            ui32 Winner = 0;
+            bool Finished = false;
+        };
+
+        void EnsureLoaded();
+        void AppendToCacheFile(const TString& key, ui32 winner);
+
+    private:
+        TAdaptiveLock Lock;
+        THashMap<TString, TTuningEntry> Entries;
+        bool Loaded = false;
+        bool Enabled = false;
+        TString CacheFile;
+    };
+
+    inline TKernelTuningCache& GetKernelTuningCache() {
+        return *Singleton<TKernelTuningCache>();
+    }
+
+    //key describing the launch shape on the current device
+    TString MakeKernelTuningKey(const char* kernel,
+                                int policy,
+                                ui32 partCount,
+                                ui32 foldCount,
+                                ui64 docCount);
+
+    //times one benchmarked launch with cuda events
+    class TKernelLaunchTimer {
+    public:
+        explicit TKernelLaunchTimer(cudaStream_t stream);
+
+        //waits for the launch and returns elapsed milliseconds
+        float Stop();
+
+    private:
+        cudaStream_t Stream;
+        cudaEvent_t StartEvent;
+        cudaEvent_t StopEvent;
+    };
+}
@@ -264,6 +264,35 @@ namespace NCudaLib {
             return TStripeMapping(std::move(slices), objectSize);
         }
 
+        //split objects proportionally to device weights (e.g. measured throughput),
+        //so faster devices get bigger shards
+        static TStripeMapping SplitBetweenDevices(ui64 objectCount,
+                                                  const TVector<double>& deviceWeights,
+                                                  ui64 objectSize = 1) {
+            const ui64 devCount = GetCudaManager().GetDeviceCount();
+            CB_ENSURE(deviceWeights.size() == devCount, "Error: weight for every device is expected");
+
+            double totalWeight = 0;
+            for (const double weight : deviceWeights) {
+                CB_ENSURE(weight > 0, "Error: device weights should be positive");
+                totalWeight += weight;
+            }
+
+            TVector<TSlice> slices(devCount);
+            ui64 offset = 0;
+            double cumulativeWeight = 0;
+            for (ui32 i = 0; i < devCount; ++i) {
+                cumulativeWeight += deviceWeights[i];
+                ui64 bound = (i + 1 == devCount)
+                                 ? objectCount
+                                 : static_cast<ui64>(objectCount * cumulativeWeight / totalWeight + 0.5);
+                bound = Min(Max(bound, offset), objectCount);
+                slices[i] = TSlice(offset, bound);
+                offset = bound;
+            }
+            return TStripeMapping(std::move(slices), objectSize);
+        }
+
         static TStripeMapping RepeatOnAllDevices(ui64 objectCount,
                                                  ui64 objectSize = 1) {
             const ui64 devCount = GetCudaManager().GetDeviceCount();
@@ -3,6 +3,8 @@
 #include <catboost/cuda/cuda_lib/cuda_base.h>
 #include <util/generic/vector.h>
 #include <util/string/builder.h>
+#include <util/string/cast.h>
+#include <util/system/env.h>
 #include <util/datetime/base.h>
 /*
  * For most GPU task we don't need sophisticated allocators.
@@ -25,6 +27,8 @@ namespace NCudaLib {
             char* Ptr;
             ui64 Size;
             bool IsFree;
+            //overflow blocks live in separately-allocated managed memory, not in the pool arena
+            bool IsManagedOverflow = false;
 
             //Most part of memory is static (module unknown dataset size). Heuristic for fast search of dynamic memory blocks start.
             TIntrusivePtr<TAllocatedBlock> Next = nullptr;
@@ -126,6 +130,9 @@ namespace NCudaLib {
         char* Memory = nullptr;
         ui64 TotalMemory;
         ui64 FreeMemory;
+        //memory allocated past the pool size in the managed overflow tier
+        ui64 OverflowMemory = 0;
+        bool ManagedOverflowEnabled = false;
         TIntrusivePtr<TAllocatedBlock> LastBlock;
 
         ui64 CalculateFragmentedMemorySize() const {
@@ -141,6 +148,28 @@ namespace NCudaLib {
             return fragmentedMemory;
         }
 
+        //move a block to a destination left of it. Overlapping regions are copied front to
+        //back in chunks of the gap size, which never overlap, so no temp buffer is needed.
+        //Chunks are issued on the default stream and execute in order; callers synchronize.
+        static void MoveBlockLeft(char* src, char* dst, ui64 size) {
+            Y_ASSERT(dst <= src);
+            const ui64 gap = src - dst;
+            if (gap == 0) {
+                return;
+            }
+            TCudaStream& stream = GetDefaultStream();
+            if (gap >= size) {
+                TMemoryCopier<PtrType, PtrType>::CopyMemoryAsync(src, dst, size, stream);
+                return;
+            }
+            ui64 movedSize = 0;
+            while (movedSize < size) {
+                const ui64 copySize = std::min(gap, size - movedSize);
+                TMemoryCopier<PtrType, PtrType>::CopyMemoryAsync(src + movedSize, dst + movedSize, copySize, stream);
+                movedSize += copySize;
+            }
+        }
+
         void MemoryDefragmentation() {
             GetDefaultStream().Synchronize();
             auto startTime = Now();
@@ -149,42 +178,13 @@ namespace NCudaLib {
             CB_ENSURE(cursor != nullptr);
             auto last = LastBlock;
 
-            char* const startPtr = cursor->Ptr;
-
-            ui64 writeOffset = 0;
-            ui64 newBlockOffset = 0;
-
-            char* const temp = last->Ptr;
-            const ui64 tempBufferSize = (last->Size / 4096) * 4096;
-            ui64 tempBufferUsed = 0;
+            char* writePtr = cursor->Ptr;
 
             while (cursor != last) {
                 if (!cursor->IsFree) {
-                    ui64 movedSize = 0;
-
-                    while (movedSize < cursor->Size) {
-                        const ui64 tempBufferFreeSpace = tempBufferSize - tempBufferUsed;
-                        ui64 copySize = std::min(tempBufferFreeSpace, cursor->Size - movedSize);
-                        Y_ASSERT((temp + tempBufferUsed - cursor->Ptr - movedSize - copySize) >= 0);
-                        Y_ASSERT((temp + tempBufferUsed + copySize) <= (temp + tempBufferSize));
-                        TMemoryCopier<PtrType, PtrType>::CopyMemorySync(cursor->Ptr + movedSize, temp + tempBufferUsed, copySize);
-
-                        movedSize += copySize;
-                        tempBufferUsed += copySize;
-                        Y_ASSERT(tempBufferUsed <= tempBufferSize);
-
-                        if (tempBufferUsed == tempBufferSize) {
-                            TMemoryCopier<PtrType, PtrType>::CopyMemorySync(temp, startPtr + writeOffset, tempBufferUsed);
-                            GetDefaultStream().Synchronize();
-                            CheckLastError();
-                            writeOffset += tempBufferUsed;
-                            tempBufferUsed = 0;
-                        }
-                    }
-                    Y_ASSERT(movedSize == cursor->Size);
-
-                    cursor->Ptr = startPtr + newBlockOffset;
-                    newBlockOffset += cursor->Size;
+                    MoveBlockLeft(cursor->Ptr, writePtr, cursor->Size);
+                    cursor->Ptr = writePtr;
+                    writePtr += cursor->Size;
                 } else {
                     cursor->Prev->Next = cursor->Next;
                     cursor->Prev->UpdateNeighboursLinks();
@@ -192,18 +192,13 @@ namespace NCudaLib {
                 cursor = cursor->Next;
             }
 
-            if (tempBufferUsed) {
-                TMemoryCopier<PtrType, PtrType>::CopyMemorySync(temp, startPtr + writeOffset, tempBufferUsed);
-                writeOffset += tempBufferUsed;
-                tempBufferUsed = 0;
-            }
-
-            const ui64 defragmentedMemory = (temp - (startPtr + writeOffset));
+            const ui64 defragmentedMemory = LastBlock->Ptr - writePtr;
             GetDefaultStream().Synchronize();
+            CheckLastError();
             MATRIXNET_DEBUG_LOG << "Defragment " << defragmentedMemory * 1.0 / 1024 / 1024 << " memory"
                                << " in " << (Now() - startTime).SecondsFloat() << " seconds " << Endl;
             LastBlock->Size += defragmentedMemory;
-            LastBlock->Ptr = startPtr + writeOffset;
+            LastBlock->Ptr = writePtr;
 
             CB_ENSURE(LastBlock == cursor);
             FirstFreeBlock = LastBlock;
@@ -233,9 +228,14 @@ namespace NCudaLib {
         public:
             ~TMemoryBlock() {
                 if (Block) {
-                    Block->IsFree = true;
-                    Owner.FreeMemory += Block->Size;
-                    Owner.MergeFreeBlocks(Block);
+                    if (Block->IsManagedOverflow) {
+                        CudaManagedFree(Block->Ptr);
+                        Owner.OverflowMemory -= Block->Size;
+                    } else {
+                        Block->IsFree = true;
+                        Owner.FreeMemory += Block->Size;
+                        Owner.MergeFreeBlocks(Block);
+                    }
                 }
             }
 
@@ -261,6 +261,7 @@ namespace NCudaLib {
             FirstFreeBlock = LastBlock;
             TotalMemory = memorySize;
             FreeMemory = TotalMemory;
+            ManagedOverflowEnabled = FromString<bool>(GetEnv("CB_MANAGED_MEMORY_OVERFLOW", "0"));
         }
 
         ~TStackLikeMemoryPool() noexcept(false) {
@@ -302,6 +303,18 @@ namespace NCudaLib {
                     TryDefragment();
                 }
                 if (LastBlock->Size < adjustedMemoryRequestSize) {
+                    if (ManagedOverflowEnabled && PtrType == EPtrType::CudaDevice) {
+                        //degrade to driver-paged unified memory instead of dying: slower, but
+                        //long trains survive peaks above the pool size
+                        MATRIXNET_WARNING_LOG << "GPU memory pool overflow: allocating " << requestedBlockSize / MB
+                                              << " MB in managed memory; performance may degrade" << Endl;
+                        TIntrusivePtr<TAllocatedBlock> overflowBlock = new TAllocatedBlock(CudaManagedAllocate(requestedBlockSize),
+                                                                                          requestedBlockSize,
+                                                                                          false);
+                        overflowBlock->IsManagedOverflow = true;
+                        OverflowMemory += requestedBlockSize;
+                        return new TMemoryBlock<T>(overflowBlock, *this);
+                    }
                     ythrow TOutOfMemoryError() << "Error: Out of memory. Requested " << requestedBlockSize / MB << "; Free "
                                                << (LastBlock->Size) / MB;
                 }
@@ -325,12 +338,9 @@ namespace NCudaLib {
             MATRIXNET_DEBUG_LOG << "Fragmented memory " << memoryToDefragment * 1.0 / 1024 / 1024 << Endl;
             MATRIXNET_DEBUG_LOG << "Free memory in last block " << LastBlock->Size * 1.0 / 1024 / 1024 << Endl;
 
-            if ((memoryToDefragment > LastBlock->Size) && (LastBlock->Size < MINIMUM_FREE_MEMORY_TO_DEFRAGMENTATION)) {
-                ythrow TOutOfMemoryError() << "Error: We don't have enough memory to defragmentation";
-            } else {
-                //this algorithm copies everything in last block and then copies back.
-                MemoryDefragmentation();
-            }
+            //in-place compaction: blocks slide left into the free gaps, so no temp buffer
+            //is needed and defragmentation works even when the pool is almost full
+            MemoryDefragmentation();
         }
 
         ui64 GetRequestedRamSize() const {
@@ -5,7 +5,7 @@
 #include <catboost/cuda/cuda_lib/devices_provider.h>
 #include <util/system/env.h>
 #include <util/string/cast.h>
-#include <catboost/cuda/cuda_lib/tasks_queue/mpi_task_queue.h>
+#include <catboost/cuda/cuda_lib/tasks_queue/remote_task_queue.h>
 #include <library/blockcodecs/codecs.h>
 
 namespace NCudaLib {
@@ -312,25 +312,3 @@ namespace NCudaLib {
 }
 
 #endif
-
-namespace NCudaLib {
-    inline int GetHostId() {
-#if defined(USE_MPI)
-        return GetMpiManager().GetHostId();
-#else
-        return 0;
-#endif
-    }
-
-#if defined(USE_MPI)
-    inline bool AreRequestsComplete(const TVector<TMpiRequestPtr>& MpiRequests) {
-        for (const auto& request : MpiRequests) {
-            if (!request->IsComplete()) {
-                return false;
-            }
-        }
-        return true;
-    }
-#endif
-
-}
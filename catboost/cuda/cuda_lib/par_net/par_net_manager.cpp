@@ -0,0 +1,321 @@
+#include "par_net_manager.h"
+
+#if defined(USE_PAR_NET)
+#include <catboost/cuda/cuda_lib/devices_provider.h>
+#include <util/generic/yexception.h>
+#include <util/stream/file.h>
+#include <util/string/cast.h>
+#include <util/string/split.h>
+#include <util/system/env.h>
+#include <util/system/hostname.h>
+
+namespace NCudaLib {
+    namespace {
+        const char* CudaMsgUrl = "cuda_msg";
+        const char* CudaInitUrl = "cuda_init";
+
+        struct TWireMsgHeader {
+            int SourceRank = -1;
+            int Tag = -1;
+            ui64 Seq = 0;
+        };
+    }
+
+    void TParNetManager::Start() {
+        CB_ENSURE(!IsStarted, "Error: can't start par net manager more than once");
+
+        //env config, same knobs as the mpi backend
+        TString codecName = GetEnv("CB_COMPRESS_CODEC", "lz4fast");
+        CompressCodec = NBlockCodecs::Codec(codecName);
+        MinCompressSize = FromString<ui64>(GetEnv("CB_MIN_COMPRESS_SIZE", "10000"));
+
+        const TString workerPort = GetEnv("CB_WORKER_PORT", "");
+        if (workerPort) {
+            InitWorker(FromString<int>(workerPort));
+        } else {
+            InitMaster(GetEnv("CB_HOSTS_FILE", ""));
+        }
+        IsStarted = true;
+    }
+
+    void TParNetManager::InitWorker(int listenPort) {
+        Requester = NPar::CreateRequester(listenPort);
+        Requester->SetQueryCallback([this](TAutoPtr<NPar::TNetworkRequest>& request) {
+            this->OnQuery(request);
+        });
+        Requester->SetReplyCallback([this](TAutoPtr<NPar::TNetworkResponse> response) {
+            this->OnReply(response);
+        });
+        MATRIXNET_DEBUG_LOG << "Waiting for master on port " << Requester->GetListenPort() << Endl;
+        WorkerInitEvent.WaitI();
+        CB_ENSURE(HostId > 0, "Error: worker got no rank from master");
+    }
+
+    void TParNetManager::InitMaster(const TString& hostsFile) {
+        Requester = NPar::CreateRequester(0);
+        Requester->SetQueryCallback([this](TAutoPtr<NPar::TNetworkRequest>& request) {
+            this->OnQuery(request);
+        });
+        Requester->SetReplyCallback([this](TAutoPtr<NPar::TNetworkResponse> response) {
+            this->OnReply(response);
+        });
+
+        TVector<TString> hostStrings;
+        hostStrings.push_back(TString::Join(HostName(), ":", ToString(Requester->GetListenPort())));
+        if (hostsFile) {
+            TIFStream in(hostsFile);
+            TString line;
+            while (in.ReadLine(line)) {
+                if (line) {
+                    hostStrings.push_back(line);
+                }
+            }
+        }
+
+        HostAddresses.clear();
+        for (const auto& hostString : hostStrings) {
+            TStringBuf host;
+            TStringBuf port;
+            TStringBuf(hostString).RSplit(':', host, port);
+            CB_ENSURE(host && port, "Error: expected host:port line in hosts file, got " << hostString);
+            HostAddresses.push_back(NPar::TNetworkAddress(TString(host), FromString<ui16>(port)));
+        }
+        HostCount = static_cast<int>(HostAddresses.size());
+        HostId = 0;
+
+        //local devices go first, so single-host configs look exactly like the non-distributed setup
+        int deviceCount = NCudaHelpers::GetDeviceCount();
+        TVector<TCudaDeviceProperties> localProps = NCudaHelpers::GetDevicesProps();
+        for (int dev = 0; dev < deviceCount; ++dev) {
+            Devices.push_back(TDeviceId(0, dev));
+            DeviceProps.push_back(localProps[dev]);
+        }
+
+        for (int rank = 1; rank < HostCount; ++rank) {
+            TVector<char> initData;
+            {
+                TVector<char> buffer;
+                buffer.resize(sizeof(int) + sizeof(int));
+                int* dst = reinterpret_cast<int*>(buffer.data());
+                dst[0] = rank;
+                dst[1] = HostCount;
+                for (const auto& hostString : hostStrings) {
+                    const int len = static_cast<int>(hostString.size());
+                    const char* lenBytes = reinterpret_cast<const char*>(&len);
+                    buffer.insert(buffer.end(), lenBytes, lenBytes + sizeof(int));
+                    buffer.insert(buffer.end(), hostString.begin(), hostString.end());
+                }
+                initData.swap(buffer);
+            }
+
+            TAutoPtr<NPar::TNetworkResponse> response = Requester->Request(GetRankAddress(rank), CudaInitUrl, &initData);
+            CB_ENSURE(response && response->Status == NPar::TNetworkResponse::EStatus::Ok,
+                      "Error: can't reach worker #" << rank << " at " << hostStrings[rank]);
+
+            const char* cursor = response->Data.data();
+            int workerDeviceCount = 0;
+            memcpy(&workerDeviceCount, cursor, sizeof(int));
+            cursor += sizeof(int);
+            CB_ENSURE(response->Data.size() == sizeof(int) + sizeof(TCudaDeviceProperties) * workerDeviceCount,
+                      "Error: malformed device list from worker #" << rank);
+
+            for (int dev = 0; dev < workerDeviceCount; ++dev) {
+                TCudaDeviceProperties props;
+                memcpy(&props, cursor, sizeof(props));
+                cursor += sizeof(props);
+                Devices.push_back(TDeviceId(rank, dev));
+                DeviceProps.push_back(props);
+            }
+        }
+    }
+
+    void TParNetManager::Stop() {
+        if (IsMaster()) {
+            NCudaLib::GetDevicesProvider().FreeDevices();
+        }
+        with_lock (Lock) {
+            for (auto& entry : PendingReads) {
+                for (auto& read : entry.second) {
+                    read.Request->SetState(TNetRequest::EState::Canceled);
+                    read.Request->WaitEvent.Signal();
+                }
+            }
+            PendingReads.clear();
+            Inbox.clear();
+            RunningWrites.clear();
+        }
+        Requester = nullptr;
+        IsStarted = false;
+    }
+
+    void TParNetManager::CompleteRead(TPendingRead& read, const char* payload, ui64 payloadSize) {
+        CB_ENSURE(payloadSize <= static_cast<ui64>(read.DataSize),
+                  "Error: message is too big for receive buffer: " << payloadSize << " > " << read.DataSize);
+        memcpy(read.Data, payload, payloadSize);
+        AtomicSet(read.Request->ReceivedBytesCount, payloadSize);
+        read.Request->SetState(TNetRequest::EState::Completed);
+        read.Request->WaitEvent.Signal();
+    }
+
+    void TParNetManager::OnQuery(TAutoPtr<NPar::TNetworkRequest>& request) {
+        if (request->Url == CudaInitUrl) {
+            {
+                const char* cursor = request->Data.data();
+                int rank = 0;
+                int hostCount = 0;
+                memcpy(&rank, cursor, sizeof(int));
+                cursor += sizeof(int);
+                memcpy(&hostCount, cursor, sizeof(int));
+                cursor += sizeof(int);
+
+                TVector<NPar::TNetworkAddress> addresses;
+                for (int i = 0; i < hostCount; ++i) {
+                    int len = 0;
+                    memcpy(&len, cursor, sizeof(int));
+                    cursor += sizeof(int);
+                    TString hostString(cursor, len);
+                    cursor += len;
+                    TStringBuf host;
+                    TStringBuf port;
+                    TStringBuf(hostString).RSplit(':', host, port);
+                    addresses.push_back(NPar::TNetworkAddress(TString(host), FromString<ui16>(port)));
+                }
+
+                HostId = rank;
+                HostCount = hostCount;
+                HostAddresses = std::move(addresses);
+            }
+
+            TVector<char> deviceData;
+            {
+                const int deviceCount = NCudaHelpers::GetDeviceCount();
+                TVector<TCudaDeviceProperties> props = NCudaHelpers::GetDevicesProps();
+                deviceData.resize(sizeof(int) + sizeof(TCudaDeviceProperties) * deviceCount);
+                char* cursor = deviceData.data();
+                memcpy(cursor, &deviceCount, sizeof(int));
+                cursor += sizeof(int);
+                for (int dev = 0; dev < deviceCount; ++dev) {
+                    memcpy(cursor, &props[dev], sizeof(TCudaDeviceProperties));
+                    cursor += sizeof(TCudaDeviceProperties);
+                }
+            }
+            Requester->SendResponse(request->ReqId, &deviceData);
+            WorkerInitEvent.Signal();
+            return;
+        }
+
+        Y_VERIFY(request->Url == CudaMsgUrl, "Error: unexpected request url %s", request->Url.data());
+        CB_ENSURE(request->Data.size() >= sizeof(TWireMsgHeader), "Error: malformed message");
+
+        TWireMsgHeader header;
+        memcpy(&header, request->Data.data(), sizeof(header));
+        const char* payload = request->Data.data() + sizeof(header);
+        const ui64 payloadSize = request->Data.size() - sizeof(header);
+
+        with_lock (Lock) {
+            const TMsgKey key(header.SourceRank, header.Tag);
+            TVector<char> data(payload, payload + payloadSize);
+            Inbox[key][header.Seq] = std::move(data);
+            MatchReads(key);
+        }
+        Requester->SendResponse(request->ReqId, nullptr);
+    }
+
+    void TParNetManager::OnReply(TAutoPtr<NPar::TNetworkResponse> response) {
+        TNetRequestPtr request;
+        with_lock (Lock) {
+            auto it = RunningWrites.find(response->ReqId);
+            if (it == RunningWrites.end()) {
+                //init handshake replies are handled synchronously
+                return;
+            }
+            request = it->second;
+            RunningWrites.erase(it);
+        }
+
+        if (response->Status == NPar::TNetworkResponse::EStatus::Ok) {
+            request->SetState(TNetRequest::EState::Completed);
+        } else if (response->Status == NPar::TNetworkResponse::EStatus::Canceled) {
+            request->SetState(TNetRequest::EState::Canceled);
+        } else {
+            MATRIXNET_ERROR_LOG << "Network write failed, remote host is unreachable" << Endl;
+            Y_VERIFY(false, "Error: network write failed");
+        }
+        request->WaitEvent.Signal();
+    }
+
+    void TParNetManager::MatchReads(const TMsgKey& key) {
+        auto readsIt = PendingReads.find(key);
+        auto inboxIt = Inbox.find(key);
+        while (readsIt != PendingReads.end() && !readsIt->second.empty() &&
+               inboxIt != Inbox.end()) {
+            auto msgIt = inboxIt->second.find(readsIt->second.front().Seq);
+            if (msgIt == inboxIt->second.end()) {
+                break;
+            }
+            CompleteRead(readsIt->second.front(), msgIt->second.data(), msgIt->second.size());
+            readsIt->second.pop_front();
+            inboxIt->second.erase(msgIt);
+        }
+        if (readsIt != PendingReads.end() && readsIt->second.empty()) {
+            PendingReads.erase(readsIt);
+        }
+        if (inboxIt != Inbox.end() && inboxIt->second.empty()) {
+            Inbox.erase(inboxIt);
+        }
+    }
+
+    TParNetManager::TNetRequestPtr TParNetManager::ReadAsync(char* data, int dataSize, int sourceRank, int tag) {
+        TNetRequestPtr request = new TNetRequest();
+        request->SetState(TNetRequest::EState::Running);
+
+        with_lock (Lock) {
+            const TMsgKey key(sourceRank, tag);
+
+            TPendingRead read;
+            read.Request = request;
+            read.Data = data;
+            read.DataSize = dataSize;
+            read.Seq = ReadSeq[key]++;
+            PendingReads[key].push_back(std::move(read));
+            MatchReads(key);
+        }
+        return request;
+    }
+
+    TParNetManager::TNetRequestPtr TParNetManager::WriteAsync(const char* data, int dataSize, int destRank, int tag) {
+        Y_ASSERT(destRank != HostId);
+        TNetRequestPtr request = new TNetRequest();
+        request->SetState(TNetRequest::EState::Running);
+        AtomicSet(request->ReceivedBytesCount, dataSize);
+
+        TVector<char> message;
+        TGUID reqId;
+        CreateGuid(&reqId);
+
+        with_lock (Lock) {
+            TWireMsgHeader header;
+            header.SourceRank = HostId;
+            header.Tag = tag;
+            header.Seq = WriteSeq[TMsgKey(destRank, tag)]++;
+
+            message.resize(sizeof(header) + dataSize);
+            memcpy(message.data(), &header, sizeof(header));
+            memcpy(message.data() + sizeof(header), data, dataSize);
+
+            RunningWrites[reqId] = request;
+        }
+        Requester->SendRequest(reqId, GetRankAddress(destRank), CudaMsgUrl, &message);
+        return request;
+    }
+
+    void TParNetManager::SendTask(const TDeviceId& deviceId,
+                                  TSerializedTask&& task) {
+        Y_ASSERT(IsMaster());
+        Y_ASSERT(task.Size());
+        //the message is copied into the request, so the task may die right away
+        WriteAsync(task.Data(), static_cast<int>(task.Size()), deviceId.HostId, GetTaskTag(deviceId));
+    }
+}
+
+#endif
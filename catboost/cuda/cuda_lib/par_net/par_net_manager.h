@@ -0,0 +1,311 @@
+#pragma once
+
+#if defined(USE_PAR_NET)
+
+#include <catboost/cuda/cuda_lib/cuda_base.h>
+#include <catboost/cuda/cuda_lib/device_id.h>
+#include <catboost/cuda/cuda_lib/serialization/task_factory.h>
+#include <library/blockcodecs/codecs.h>
+#include <library/par/par_network.h>
+#include <util/generic/deque.h>
+#include <util/generic/guid.h>
+#include <util/generic/hash.h>
+#include <util/generic/map.h>
+#include <util/stream/buffer.h>
+#include <util/system/atomic.h>
+#include <util/system/event.h>
+#include <util/system/guard.h>
+#include <util/system/spinlock.h>
+#include <util/system/types.h>
+#include <util/ysaveload.h>
+
+namespace NCudaLib {
+    /*
+     * Multi-node transport on top of library/par's requesters (NEH TCP or netliba),
+     * the same network layer CPU distributed training rides on. It implements the
+     * message-passing surface cuda_lib needs (tagged async reads/writes + task
+     * forwarding), so remote GPU hosts work without an MPI runtime: start plain
+     * worker binaries and give the master a host list, like CPU distributed mode.
+     *
+     * Bootstrap is env-driven (see Start): CB_WORKER_PORT turns the process into a
+     * worker, CB_HOSTS_FILE points the master at a file with worker host:port lines.
+     *
+     * Like TMpiManager, this is not a general-use class: it is designed for the
+     * computation model of cuda_lib routines only.
+     */
+    class TParNetManager {
+    public:
+        class TNetRequest: public TNonCopyable, public TThrRefBase {
+        public:
+            bool IsComplete() const {
+                return GetState() == EState::Completed;
+            }
+
+            void WaitComplete() const {
+                Wait(TDuration::Max());
+            }
+
+            ui64 ReceivedBytes() const {
+                CB_ENSURE(IsComplete(), "Request is not completed");
+                return static_cast<ui64>(AtomicGet(ReceivedBytesCount));
+            }
+
+            void Wait(const TDuration& interval) const {
+                if (!IsComplete()) {
+                    WaitEvent.WaitT(interval);
+                }
+                Y_VERIFY(IsComplete() || GetState() == EState::Canceled, "Error: event is not complete");
+            }
+
+            void Abort() {
+                AtomicSet(CancelFlag, 1);
+            }
+
+        private:
+            enum class EState {
+                Created,
+                Running,
+                Completed,
+                Canceled
+            };
+
+            EState GetState() const {
+                int state = AtomicGet(State);
+                if (state == 0) {
+                    return EState::Created;
+                } else if (state == 1) {
+                    return EState::Running;
+                } else if (state == 2) {
+                    return EState::Completed;
+                } else {
+                    Y_VERIFY(state == 3);
+                    return EState::Canceled;
+                }
+            }
+
+            void SetState(EState state) {
+                if (state == EState::Created) {
+                    AtomicSet(State, 0);
+                } else if (state == EState::Running) {
+                    AtomicSet(State, 1);
+                } else if (state == EState::Completed) {
+                    AtomicSet(State, 2);
+                } else {
+                    Y_VERIFY(state == EState::Canceled);
+                    AtomicSet(State, 3);
+                }
+            }
+
+        private:
+            TNetRequest() {
+            }
+
+            friend class TParNetManager;
+
+        private:
+            mutable TManualEvent WaitEvent;
+            mutable TAtomic CancelFlag = 0;
+            mutable TAtomic State = 0;
+            mutable TAtomic ReceivedBytesCount = 0;
+        };
+
+        using TNetRequestPtr = TIntrusivePtr<TNetRequest>;
+
+        //role is detected from the environment: worker if CB_WORKER_PORT is set,
+        //master otherwise (with remote hosts from CB_HOSTS_FILE, if any)
+        void Start();
+
+        void Stop();
+
+        bool IsMaster() const {
+            return HostId == 0;
+        }
+
+        TNetRequestPtr ReadAsync(char* data, int dataSize, int sourceRank, int tag);
+
+        void ReadAsync(char* data, ui64 dataSize,
+                       int sourceRank, int tag,
+                       TVector<TNetRequestPtr>* requests) {
+            Y_ASSERT(dataSize);
+            const ui64 blockSize = Min<ui64>(dataSize, 1 << 30);
+            ReadAsync(data, dataSize, blockSize, sourceRank, tag, requests);
+        }
+
+        //could read 2GB+ data
+        void ReadAsync(char* data, ui64 dataSize, ui64 blockSize,
+                       int sourceRank, int tag,
+                       TVector<TNetRequestPtr>* requests) {
+            Y_ASSERT(dataSize);
+            for (ui64 offset = 0; offset < dataSize; offset += blockSize) {
+                const auto size = static_cast<const int>(Min<ui64>(blockSize, dataSize - offset));
+                requests->push_back(ReadAsync(data + offset, size, sourceRank, tag));
+            }
+        }
+
+        void WriteAsync(const char* data, ui64 dataSize, int destRank, int tag, TVector<TNetRequestPtr>* requests) {
+            Y_ASSERT(dataSize);
+            const ui64 blockSize = Min<ui64>(dataSize, 1 << 30);
+            WriteAsync(data, dataSize, blockSize, destRank, tag, requests);
+        }
+
+        //could write 2GB+ data
+        void WriteAsync(const char* data, ui64 dataSize, ui64 blockSize,
+                        int destRank, int tag, TVector<TNetRequestPtr>* requests) {
+            Y_ASSERT(dataSize);
+            for (ui64 offset = 0; offset < dataSize; offset += blockSize) {
+                const auto size = static_cast<const int>(Min<ui64>(blockSize, dataSize - offset));
+                requests->push_back(WriteAsync(data + offset, size, destRank, tag));
+            }
+        }
+
+        int GetTaskTag(const TDeviceId& deviceId) {
+            Y_ASSERT(deviceId.DeviceId >= 0);
+            return deviceId.DeviceId + 1;
+        }
+
+        void SendTask(const TDeviceId& deviceId,
+                      TSerializedTask&& task);
+
+        template <class T>
+        TNetRequestPtr ReceivePodAsync(int rank, int tag, T* dst) {
+            CB_ENSURE(std::is_pod<T>::value, "Not a pod type");
+            return ReadAsync(reinterpret_cast<char*>(dst), sizeof(T), rank, tag);
+        }
+
+        TNetRequestPtr ReceiveBufferAsync(int rank, int tag, TBuffer* dst) {
+            return ReadAsync(dst->Data(), static_cast<int>(dst->Size()), rank, tag);
+        }
+
+        void Read(char* data, int dataSize, int sourceRank, int tag) {
+            ReadAsync(data, dataSize, sourceRank, tag)->WaitComplete();
+        }
+
+        TNetRequestPtr WriteAsync(const char* data, int dataSize, int destRank, int tag);
+
+        void Write(const char* data, int dataSize, int destRank, int tag) {
+            WriteAsync(data, dataSize, destRank, tag)->WaitComplete();
+        }
+
+        template <class T>
+        void Send(const T& value, int rank, int tag) {
+            if (std::is_pod<T>::value) {
+                return SendPod(value, rank, tag);
+            } else {
+                TBuffer buffer;
+                {
+                    TBufferOutput out(buffer);
+                    ::Save(&out, value);
+                }
+                Write(buffer.Data(), static_cast<int>(buffer.Size()), rank, tag);
+            }
+        }
+
+        template <class T>
+        void SendPod(const T& value, int rank, int tag) {
+            CB_ENSURE(std::is_pod<T>::value, "Not a pod type");
+            Write(reinterpret_cast<const char*>(&value), sizeof(value), rank, tag);
+        }
+
+        int GetHostId() const {
+            return HostId;
+        }
+
+        static constexpr int GetMasterId() {
+            return 0;
+        }
+
+        int NextCommunicationTag() {
+            Y_ASSERT(IsMaster());
+            const int cycleLen = (1 << 16) - 1;
+            int tag = static_cast<int>(AtomicIncrement(Counter));
+            tag = tag < 0 ? -tag : tag;
+            tag %= cycleLen;
+            tag = (tag << 10) | 1023;
+            //tags should be positive
+            return tag;
+        }
+
+        const TVector<TDeviceId>& GetDevices() const {
+            Y_ASSERT(IsMaster());
+            return Devices;
+        }
+
+        const TVector<NCudaLib::TCudaDeviceProperties>& GetDeviceProperties() const {
+            Y_ASSERT(IsMaster());
+            return DeviceProps;
+        }
+
+        ui64 GetMinCompressSize() const {
+            return MinCompressSize;
+        }
+
+        const NBlockCodecs::ICodec* GetCodec() const {
+            return CompressCodec;
+        }
+
+    private:
+        //every logical message is one request: header + payload; receiver acks with
+        //an empty response, so write completion means the remote side has the data
+        struct TMsgHeader {
+            int SourceRank = -1;
+            int Tag = -1;
+        };
+
+        using TMsgKey = std::pair<int, int>; //(sourceRank, tag)
+
+        struct TPendingRead {
+            TNetRequestPtr Request;
+            char* Data = nullptr;
+            int DataSize = 0;
+            ui64 Seq = 0;
+        };
+
+        void OnQuery(TAutoPtr<NPar::TNetworkRequest>& request);
+        void OnReply(TAutoPtr<NPar::TNetworkResponse> response);
+        void CompleteRead(TPendingRead& read, const char* payload, ui64 payloadSize);
+        void MatchReads(const TMsgKey& key);
+
+        void InitWorker(int listenPort);
+        void InitMaster(const TString& hostsFile);
+
+        const NPar::TNetworkAddress& GetRankAddress(int rank) const {
+            CB_ENSURE(rank >= 0 && rank < static_cast<int>(HostAddresses.size()), "Error: unknown rank " << rank);
+            return HostAddresses[rank];
+        }
+
+    private:
+        TIntrusivePtr<NPar::IRequester> Requester;
+        int HostCount = 1;
+        int HostId = 0;
+
+        //rank -> address, shipped to every worker during bootstrap
+        TVector<NPar::TNetworkAddress> HostAddresses;
+
+        TVector<NCudaLib::TDeviceId> Devices;
+        TVector<NCudaLib::TCudaDeviceProperties> DeviceProps;
+
+        TAtomic Counter = 0;
+
+        const NBlockCodecs::ICodec* CompressCodec = nullptr;
+        ui64 MinCompressSize = 10000;
+
+        TAdaptiveLock Lock;
+        TMap<TMsgKey, TDeque<TPendingRead>> PendingReads;
+        TMap<TMsgKey, THashMap<ui64, TVector<char>>> Inbox;
+        THashMap<TGUID, TNetRequestPtr> RunningWrites;
+        //per-channel sequence numbers: the network layer does not order independent
+        //requests, so reads and messages are matched by (sourceRank, tag, seq)
+        TMap<TMsgKey, ui64> ReadSeq;
+        TMap<TMsgKey, ui64> WriteSeq;
+
+        TManualEvent WorkerInitEvent;
+        bool IsStarted = false;
+    };
+
+    static inline TParNetManager& GetParNetManager() {
+        auto& manager = *Singleton<TParNetManager>();
+        return manager;
+    }
+}
+
+#endif
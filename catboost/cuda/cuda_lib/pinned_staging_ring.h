@@ -0,0 +1,84 @@
+#pragma once
+
+#include "cuda_base.h"
+#include "cuda_events_provider.h"
+
+#include <util/generic/utility.h>
+#include <util/generic/vector.h>
+
+namespace NCudaLib {
+    /* Fixed-size pinned staging ring for uploads of pageable master memory to the devices.
+     * cudaMemcpyAsync from pageable memory is synchronous with respect to the host, so big
+     * dataset writes used to serialize behind every copy. The ring double-buffers instead:
+     * while one chunk is DMA-ed on a dedicated copy stream, the CPU fills the next one, and
+     * the caller's stream only waits for the upload via a stream-ordered event.
+     * One ring per worker thread (and hence per device).
+     */
+    class TPinnedStagingRing: private TNonCopyable {
+    public:
+        static constexpr ui64 STAGING_CHUNK_SIZE = 4 * 1024 * 1024;
+        static constexpr ui32 STAGING_CHUNK_COUNT = 2;
+        //below this size staging would only add latency
+        static constexpr ui64 MIN_SIZE_TO_STAGE = 1024 * 1024;
+
+        TPinnedStagingRing()
+            : CopyStream(NewCopyStream(), nullptr)
+        {
+            for (ui32 i = 0; i < STAGING_CHUNK_COUNT; ++i) {
+                Chunks.push_back(CudaHostAllocate(STAGING_CHUNK_SIZE));
+                Events.push_back(CreateCudaEvent());
+                InFlight.push_back(false);
+            }
+        }
+
+        ~TPinnedStagingRing() {
+            CopyStream.Synchronize();
+            CUDA_SAFE_CALL(cudaStreamDestroy(CopyStream.GetStream()));
+            for (char* chunk : Chunks) {
+                CudaHostFree(chunk);
+            }
+        }
+
+        void CopyToDeviceAsync(const char* src, char* dst, ui64 size, const TCudaStream& stream) {
+            ui64 offset = 0;
+            ui32 lastChunk = 0;
+
+            while (offset < size) {
+                const ui32 chunkIdx = Cursor++ % STAGING_CHUNK_COUNT;
+                const ui64 copySize = Min(STAGING_CHUNK_SIZE, size - offset);
+
+                if (InFlight[chunkIdx]) {
+                    Events[chunkIdx]->WaitComplete();
+                }
+                memcpy(Chunks[chunkIdx], src + offset, copySize);
+                CopyMemoryAsync(Chunks[chunkIdx], dst + offset, copySize, CopyStream);
+                Events[chunkIdx]->Record(CopyStream);
+                InFlight[chunkIdx] = true;
+
+                lastChunk = chunkIdx;
+                offset += copySize;
+            }
+
+            //work submitted to the caller's stream starts only after the upload lands
+            Events[lastChunk]->StreamWait(stream);
+        }
+
+    private:
+        static cudaStream_t NewCopyStream() {
+            cudaStream_t stream;
+            CUDA_SAFE_CALL(cudaStreamCreateWithFlags(&stream, cudaStreamNonBlocking));
+            return stream;
+        }
+
+    private:
+        TCudaStream CopyStream;
+        TVector<char*> Chunks;
+        TVector<TCudaEventPtr> Events;
+        TVector<bool> InFlight;
+        ui32 Cursor = 0;
+    };
+
+    inline TPinnedStagingRing& GetPinnedStagingRing() {
+        return *FastTlsSingleton<TPinnedStagingRing>();
+    }
+}
@@ -24,7 +24,7 @@ namespace NCudaLib {
             if (IsLocalDevice()) {
                 streamFuture = RequestStreamImpl<false>();
             } else {
-#if defined(USE_MPI)
+#if defined(USE_REMOTE_DEVICES)
                 streamFuture = RequestStreamImpl<true>();
 #else
                 CB_ENSURE(false, "Remote device support is not enabled");
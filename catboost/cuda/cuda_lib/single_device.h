@@ -10,7 +10,7 @@
 #include <catboost/cuda/cuda_lib/tasks_impl/memory_allocation.h>
 #include <catboost/cuda/cuda_lib/future/future.h>
 #include <catboost/cuda/cuda_lib/tasks_impl/cpu_func.h>
-#include <catboost/cuda/cuda_lib/tasks_queue/mpi_task_queue.h>
+#include <catboost/cuda/cuda_lib/tasks_queue/remote_task_queue.h>
 
 namespace NCudaLib {
     class TCudaSingleDevice {
@@ -23,7 +23,7 @@ namespace NCudaLib {
         template <class TFunc>
         using TLocalFunc = TCpuFunc<TFunc, false>;
 
-#if defined(USE_MPI)
+#if defined(USE_REMOTE_DEVICES)
         using TRemoteQueue = TRemoteHostTasksForwarder;
         ;
         template <class TFunc>
@@ -173,7 +173,7 @@ namespace NCudaLib {
             if (IsLocalDevice()) {
                 reinterpret_cast<TLocalQueue*>(TaskQueue)->AddTask(std::move(cmd));
             } else {
-#if defined(USE_MPI)
+#if defined(USE_REMOTE_DEVICES)
                 reinterpret_cast<TRemoteQueue*>(TaskQueue)->AddTask(std::move(cmd));
 #else
                 CB_ENSURE(false, "Remote device support is not enabled");
@@ -190,7 +190,7 @@ namespace NCudaLib {
             if (isLocalDevice) {
                 reinterpret_cast<TLocalQueue*>(TaskQueue)->EmplaceTask<TTask>(std::forward<Args>(args)...);
             } else {
-#if defined(USE_MPI)
+#if defined(USE_REMOTE_DEVICES)
                 reinterpret_cast<TRemoteQueue*>(TaskQueue)->EmplaceTask<TTask>(std::forward<Args>(args)...);
 #else
                 CB_ENSURE(false, "Remote device support is not enabled");
@@ -314,7 +314,7 @@ namespace NCudaLib {
                 AddTask(std::move(task));
                 return std::move(futureResult);
             } else {
-#if defined(USE_MPI)
+#if defined(USE_REMOTE_DEVICES)
                 using TTask = TRemoteFunc<TFunc>;
                 auto task = MakeHolder<TTask>(TPromiseFactory<true>::template CreateDevicePromise<TOutput>(DeviceId),
                                               std::forward<TFunc>(func));
@@ -11,7 +11,7 @@ namespace NCudaLib {
     THolder<ICommand> TSerializedCommand::Deserialize() {
         return TTaskSerializer::LoadCommand(Data);
     }
-#if defined(USE_MPI)
+#if defined(USE_REMOTE_DEVICES)
     REGISTER_TASK(0x000007, TResetCommand);
     REGISTER_TASK(0x000008, TStopWorkerCommand);
 #endif
@@ -4,7 +4,7 @@
 #include <catboost/cuda/cuda_lib/serialization/task_factory.h>
 
 #include <catboost/cuda/cuda_lib/future/local_promise_future.h>
-#include <catboost/cuda/cuda_lib/future/mpi_promise_future.h>
+#include <catboost/cuda/cuda_lib/future/remote_promise_future.h>
 #include <catboost/cuda/cuda_lib/future/promise_factory.h>
 
 namespace NCudaLib {
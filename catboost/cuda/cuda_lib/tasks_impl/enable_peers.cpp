@@ -2,7 +2,7 @@
 #include "kernel_task.h"
 
 namespace NCudaLib {
-#if defined(USE_MPI)
+#if defined(USE_REMOTE_DEVICES)
     REGISTER_KERNEL(0x000004, NKernelHost::TEnablePeersKernel);
     REGISTER_KERNEL(0x000005, NKernelHost::TDisablePeersKernel);
 #endif
@@ -1,7 +1,7 @@
 #pragma once
 
 #include <catboost/cuda/cuda_lib/cuda_base.h>
-#include <catboost/cuda/cuda_lib/mpi/mpi_manager.h>
+#include <catboost/cuda/cuda_lib/transport.h>
 #include <catboost/cuda/cuda_lib/task.h>
 #include <catboost/cuda/cuda_lib/device_id.h>
 #include <catboost/cuda/cuda_lib/peer_devices.h>
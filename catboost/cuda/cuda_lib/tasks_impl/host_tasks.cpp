@@ -3,7 +3,7 @@
 #include <catboost/cuda/cuda_lib/serialization/task_factory.h>
 
 namespace NCudaLib {
-#if defined(USE_MPI)
+#if defined(USE_REMOTE_DEVICES)
     REGISTER_TASK(0x000000, TWaitSubmitCommand);
     REGISTER_CPU_FUNC(0x000001, TBlockingSyncDevice);
     REGISTER_CPU_FUNC(0x000002, TRequestHandlesTask);
@@ -1,7 +1,7 @@
 #include "kernel_task.h"
 
 namespace NCudaLib {
-#if defined(USE_MPI)
+#if defined(USE_REMOTE_DEVICES)
     REGISTER_KERNEL(0x000009, TSyncStreamKernel);
 #endif
 }
@@ -2,7 +2,7 @@
 #include <catboost/cuda/cuda_lib/serialization/task_factory.h>
 
 namespace NCudaLib {
-#if defined(USE_MPI)
+#if defined(USE_REMOTE_DEVICES)
     REGISTER_TASK_TEMPLATE(0x000011, TCudaMallocTask, EPtrType::CudaHost);
     REGISTER_TASK_TEMPLATE(0x000012, TCudaMallocTask, EPtrType::CudaDevice);
     REGISTER_TASK_TEMPLATE(0x000013, TCudaMallocTask, EPtrType::Host);
@@ -1,12 +1,12 @@
 #pragma once
 
 #include <util/system/types.h>
-#include <catboost/cuda/cuda_lib/mpi/mpi_manager.h>
+#include <catboost/cuda/cuda_lib/transport.h>
 #include <catboost/cuda/cuda_lib/remote_objects.h>
 #include <catboost/cuda/cuda_lib/cuda_events_provider.h>
 
 namespace NCudaLib {
-#if defined(USE_MPI)
+#if defined(USE_REMOTE_DEVICES)
 
     class IStagedTask {
     public:
@@ -38,10 +38,10 @@ namespace NCudaLib {
             NCudaLib::THandleBasedMemoryPointer<T, EPtrType::CudaHost> OperatorBuffer;
             NCudaLib::THandleBasedMemoryPointer<T, EPtrType::CudaHost> DecompressBuffer;
 
-            NCudaLib::TMpiManager* Manager = nullptr;
+            NCudaLib::TTransportManager* Manager = nullptr;
 
             NCudaLib::TCudaEventPtr OperatorDoneEvent;
-            NCudaLib::TMpiRequestPtr ReadDoneEvent;
+            NCudaLib::TTransportRequestPtr ReadDoneEvent;
 
             bool IsRemoteCopyComplete = true;
             bool IsOperatorComplete = true;
@@ -70,7 +70,7 @@ namespace NCudaLib {
             , UseCompression(useCompression)
         {
             State.OperatorDoneEvent = NCudaLib::CudaEventProvider().Create();
-            State.Manager = &GetMpiManager();
+            State.Manager = &GetTransportManager();
             const ui64 blockSize = op.GetBlockSize(size);
             Y_ASSERT(blockSize);
             State.BlockSize = blockSize;
@@ -176,11 +176,11 @@ namespace NCudaLib {
             NCudaLib::THandleBasedMemoryPointer<T, EPtrType::CudaHost> OperatorBuffer;
             NCudaLib::THandleBasedMemoryPointer<T, EPtrType::CudaHost> CompressBuffer;
 
-            NCudaLib::TMpiManager* Manager = nullptr;
+            NCudaLib::TTransportManager* Manager = nullptr;
 
             NCudaLib::TCudaEventPtr OperatorDoneEvent;
             ui64 OperatorWorkingBufferSize = 0;
-            NCudaLib::TMpiRequestPtr WriteDoneEvent;
+            NCudaLib::TTransportRequestPtr WriteDoneEvent;
 
             bool IsRemoteCopyComplete = true;
             bool IsOperatorComplete = true;
@@ -204,7 +204,7 @@ namespace NCudaLib {
             , UseCompression(useCompression)
         {
             State.OperatorDoneEvent = NCudaLib::CudaEventProvider().Create();
-            State.Manager = &GetMpiManager();
+            State.Manager = &GetTransportManager();
 
             const ui64 blockSize = op.GetBlockSize(size);
             State.BlockSize = blockSize;
@@ -304,7 +304,7 @@ namespace NCudaLib {
 
     //if we have cuda-aware support, than we will delegate everything
     template <class T, bool IsRecv>
-    class TMpiDelegatingStageTask: public IStagedTask {
+    class TTransportDelegatingStageTask: public IStagedTask {
     private:
         using TOp = TMemcpyOperator<T>;
         T* Buffer = nullptr;
@@ -313,13 +313,13 @@ namespace NCudaLib {
         int Tag = -1;
 
         struct {
-            TVector<TMpiRequestPtr> Requests;
+            TVector<TTransportRequestPtr> Requests;
             ui64 BlockSize = 0;
             bool AreRequestsCreated = false;
         } State;
 
     public:
-        TMpiDelegatingStageTask(T* data, ui64 size,
+        TTransportDelegatingStageTask(T* data, ui64 size,
                                 TMemcpyOperator<std::remove_const_t<T>> op,
                                 int remoteHost, int tag,
                                 NKernelHost::IMemoryManager&)
@@ -334,13 +334,13 @@ namespace NCudaLib {
         //assumes stream already synchronized
         bool Exec(const TCudaStream&) final {
             if (!State.AreRequestsCreated) {
-                auto& manager = GetMpiManager();
+                auto& manager = GetTransportManager();
                 const auto maxBlockSize = ((ui64)1) << 31;
                 CB_ENSURE(State.BlockSize < maxBlockSize);
 
                 for (ui64 offset = 0; offset < Size; offset += State.BlockSize) {
                     const ui64 size = Min<ui64>(Size - offset, State.BlockSize);
-#if defined(WITHOUT_CUDA_AWARE_MPI)
+#if defined(WITHOUT_CUDA_AWARE_MPI) || defined(USE_PAR_NET)
                     CB_ENSURE(NCudaLib::GetPointerType(Buffer) == EPtrType::CudaHost);
 #endif
 
@@ -358,8 +358,8 @@ namespace NCudaLib {
     };
 
     template <class T>
-    inline bool DelegatePtrToMpi(const T* ptr) {
-#if defined(WITHOUT_CUDA_AWARE_MPI)
+    inline bool DelegatePtrToTransport(const T* ptr) {
+#if defined(WITHOUT_CUDA_AWARE_MPI) || defined(USE_PAR_NET)
         return IsHostPtr(NCudaLib::GetPointerType(ptr));
 #else
         Y_UNUSED(ptr);
@@ -374,8 +374,8 @@ namespace NCudaLib {
         TMemcpyOperator<T> op;
         op.BlockSize = blockSize;
 
-        if (DelegatePtrToMpi(source) && !compress) {
-            using TTask = TMpiDelegatingStageTask<const T, false>;
+        if (DelegatePtrToTransport(source) && !compress) {
+            using TTask = TTransportDelegatingStageTask<const T, false>;
             return MakeHolder<TTask>(source, size, op, host, tag, memoryManager);
         } else {
             using TTask = TThroughHostStagedSendTask<T, TMemcpyOperator<T>>;
@@ -390,8 +390,8 @@ namespace NCudaLib {
         TMemcpyOperator<T> op;
         op.BlockSize = blockSize;
 
-        if (DelegatePtrToMpi(dest) && !compress) {
-            using TTask = TMpiDelegatingStageTask<T, true>;
+        if (DelegatePtrToTransport(dest) && !compress) {
+            using TTask = TTransportDelegatingStageTask<T, true>;
             return MakeHolder<TTask>(dest, size, op, host, tag, memoryManager);
         } else {
             using TTask = TThroughHostStagedRecvTask<T, TMemcpyOperator<T>>;
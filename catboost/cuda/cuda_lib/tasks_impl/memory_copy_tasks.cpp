@@ -1,7 +1,7 @@
 #include "memory_copy_tasks.h"
 
 namespace NCudaLib {
-#if defined(USE_MPI)
+#if defined(USE_REMOTE_DEVICES)
     REGISTER_TASK(0x000100, TMasterInterHostMemcpy);
     REGISTER_STREAM_SECTION_TASK(0x000101, TMemoryCopyTasks);
 #endif
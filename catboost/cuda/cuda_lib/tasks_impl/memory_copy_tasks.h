@@ -3,7 +3,8 @@
 #include "kernel_task.h"
 #include "memory_copy_staged_operation.h"
 #include <catboost/cuda/cuda_lib/cuda_base.h>
-#include <catboost/cuda/cuda_lib/mpi/mpi_manager.h>
+#include <catboost/cuda/cuda_lib/transport.h>
+#include <catboost/cuda/cuda_lib/pinned_staging_ring.h>
 #include <catboost/cuda/cuda_lib/stream_section_tasks_launcher.h>
 #include <catboost/cuda/cuda_lib/single_device.h>
 
@@ -61,7 +62,13 @@ namespace NCudaLib {
             const bool readFromHost = MemcpyType == EMemcpyTaskType::Write;
             char* src = (readFromHost ? HostPtr : DevicePtr.GetRawPtr());
             char* dst = (readFromHost ? DevicePtr.GetRawPtr() : HostPtr);
-            CopyMemoryAsync(src, dst, Size, stream);
+            if (readFromHost && Size >= TPinnedStagingRing::MIN_SIZE_TO_STAGE) {
+                //master memory is pageable: double-buffer the upload through the pinned
+                //staging ring so it overlaps compute on this stream
+                GetPinnedStagingRing().CopyToDeviceAsync(src, dst, Size, stream);
+            } else {
+                CopyMemoryAsync(src, dst, Size, stream);
+            }
             eventPtr->Record(stream);
             DoneEventPromise.SetValue(std::move(eventPtr));
         }
@@ -71,7 +78,7 @@ namespace NCudaLib {
         }
     };
 
-#if defined(USE_MPI)
+#if defined(USE_REMOTE_DEVICES)
 
     struct TInterHostCopyTask {
         NCudaLib::TDeviceId RemoteDevice;
@@ -84,7 +91,7 @@ namespace NCudaLib {
     };
 
     inline constexpr ui64 GetDeviceToDeviceBlockSize() {
-#if defined(WITHOUT_CUDA_AWARE_MPI)
+#if defined(WITHOUT_CUDA_AWARE_MPI) || defined(USE_PAR_NET)
         //512KB
         return 512 * 1024;
 #else
@@ -96,7 +103,7 @@ namespace NCudaLib {
         if (deviceType == EPtrType::CudaHost) {
             return 64 * 1024 * 1024;
         } else {
-#if defined(WITHOUT_CUDA_AWARE_MPI)
+#if defined(WITHOUT_CUDA_AWARE_MPI) || defined(USE_PAR_NET)
             //512KB
             return 512 * 1024;
 #else
@@ -116,7 +123,7 @@ namespace NCudaLib {
         struct TContext: public NKernel::IKernelContext {
             TCudaEventPtr DeviceReadyEvent;
             THolder<IStagedTask> Task;
-            TMpiManager* Manager;
+            TTransportManager* Manager;
             EStage Stage;
         };
 
@@ -139,7 +146,7 @@ namespace NCudaLib {
 
         THolder<NKernel::IKernelContext> PrepareExec(NKernelHost::IMemoryManager& memoryManager) const final {
             auto ctx = MakeHolder<TContext>();
-            ctx->Manager = &GetMpiManager();
+            ctx->Manager = &GetTransportManager();
             ctx->DeviceReadyEvent = CreateCudaEvent();
             bool readFromHost = MemcpyType == EMemcpyTaskType::Write;
             const ui64 blockSize = GetMasterToDeviceBlockSize(DevicePtr.Type);
@@ -202,14 +209,14 @@ namespace NCudaLib {
 
     struct TMemoryCopyContext {
         bool AreSubmitted = false;
-#if defined(USE_MPI)
+#if defined(USE_REMOTE_DEVICES)
         TVector<IStagedTaskPtr> Tasks;
 #endif
     };
 
     class TMemoryCopyTasks: public NKernelHost::TKernelWithContext<TMemoryCopyContext> {
     private:
-#if defined(USE_MPI)
+#if defined(USE_REMOTE_DEVICES)
         TVector<TInterHostCopyTask> InterHostTasks; //mpi
         bool Compress = false;
 #endif
@@ -236,10 +243,10 @@ namespace NCudaLib {
         THolder<TMemoryCopyContext> PrepareContext(NKernelHost::IMemoryManager& memoryManager) const {
             Y_UNUSED(memoryManager);
             auto ctx = MakeHolder<TMemoryCopyContext>();
-#if defined(USE_MPI)
+#if defined(USE_REMOTE_DEVICES)
             //inter-host task
             for (auto& task : InterHostTasks) {
-                Y_ASSERT(GetMpiManager().GetHostId() != task.RemoteDevice.HostId);
+                Y_ASSERT(GetTransportManager().GetHostId() != task.RemoteDevice.HostId);
                 const ui64 blockSize = GetDeviceToDeviceBlockSize();
                 if (task.Type == EMemcpyTaskType::Read) {
                     char* dst = task.DataPtr.GetRawPtr();
@@ -261,7 +268,7 @@ namespace NCudaLib {
                 context->AreSubmitted = true;
             }
 
-#if defined(USE_MPI)
+#if defined(USE_REMOTE_DEVICES)
             ExecStagedTasks(stream, &context->Tasks);
             return context->Tasks.size() == 0;
 #else
@@ -269,7 +276,7 @@ namespace NCudaLib {
 #endif
         }
 
-#if defined(USE_MPI)
+#if defined(USE_REMOTE_DEVICES)
         Y_SAVELOAD_DEFINE(InterHostTasks, IntraHostTasks, Compress); //mpi
 #else
         Y_SAVELOAD_DEFINE(IntraHostTasks);
@@ -279,7 +286,7 @@ namespace NCudaLib {
     class TDataCopier {
     private:
         ui32 StreamId = 0;
-#if defined(USE_MPI)
+#if defined(USE_REMOTE_DEVICES)
         bool CompressFlag = false;
 #endif
         bool Submitted = false;
@@ -316,11 +323,11 @@ namespace NCudaLib {
         }
 
         static THolder<IDeviceRequest> AsyncReadRemote(TCudaSingleDevice* device, THandleRawPtr ptr, ui64 readSize, char* dst, ui32 stream) {
-#if defined(USE_MPI)
-            auto& manager = GetMpiManager();
+#if defined(USE_REMOTE_DEVICES)
+            auto& manager = GetTransportManager();
             int tag = manager.NextCommunicationTag();
             auto task = MakeHolder<TMasterInterHostMemcpy>(ptr, readSize, tag, EMemcpyTaskType::Read, stream);
-            TVector<TMpiRequestPtr> requests;
+            TVector<TTransportRequestPtr> requests;
             manager.ReadAsync(dst, readSize, GetMasterToDeviceBlockSize(ptr.Type), device->GetHostId(), tag, &requests);
             device->AddTask(std::move(task));
             return MakeHolder<TRemoteDeviceRequest>(std::move(requests));
@@ -336,11 +343,11 @@ namespace NCudaLib {
         }
 
         static THolder<IDeviceRequest> AsyncWriteRemote(TCudaSingleDevice* device, const char* src, THandleRawPtr ptr, ui64 writeSize, ui32 stream) {
-#if defined(USE_MPI)
-            auto& manager = GetMpiManager();
+#if defined(USE_REMOTE_DEVICES)
+            auto& manager = GetTransportManager();
             int tag = manager.NextCommunicationTag();
             auto task = MakeHolder<TMasterInterHostMemcpy>(ptr, writeSize, tag, EMemcpyTaskType::Write, stream);
-            TVector<TMpiRequestPtr> requests;
+            TVector<TTransportRequestPtr> requests;
             manager.WriteAsync(src, writeSize, GetMasterToDeviceBlockSize(ptr.Type), device->GetHostId(), tag, &requests);
             device->AddTask(std::move(task));
             return MakeHolder<TRemoteDeviceRequest>(std::move(requests));
@@ -367,8 +374,8 @@ namespace NCudaLib {
 
                 destDeviceTasks.IntraHostTasks.push_back(std::move(copyTask));
             } else {
-#if defined(USE_MPI)
-                const int tag = GetMpiManager().NextCommunicationTag();
+#if defined(USE_REMOTE_DEVICES)
+                const int tag = GetTransportManager().NextCommunicationTag();
                 {
                     TInterHostCopyTask copyTask;
                     copyTask.Size = task.Size;
@@ -445,7 +452,7 @@ namespace NCudaLib {
         }
 
         TDataCopier& SetCompressFlag(bool flag) {
-#if defined(USE_MPI)
+#if defined(USE_REMOTE_DEVICES)
             CompressFlag = flag;
 #else
             Y_UNUSED(flag);
@@ -484,7 +491,7 @@ namespace NCudaLib {
         void SubmitCopy() {
             if (Tasks.size()) {
                 SectionTaskLauncher.LaunchTaskByDevicePtr([&](TCudaSingleDevice* device) {
-#if defined(USE_MPI)
+#if defined(USE_REMOTE_DEVICES)
                     Tasks[device].Compress = CompressFlag;
 #endif
                     return std::move(Tasks[device]);
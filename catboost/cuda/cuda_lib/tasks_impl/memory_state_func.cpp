@@ -1,7 +1,7 @@
 #include "memory_state_func.h"
 
 namespace NCudaLib {
-#if defined(USE_MPI)
+#if defined(USE_REMOTE_DEVICES)
     REGISTER_CPU_FUNC(0x000006, TMemoryStateFunc);
 #endif
 }
@@ -1 +0,0 @@
-#include "mpi_task_queue.h"
@@ -0,0 +1 @@
+#include "remote_task_queue.h"
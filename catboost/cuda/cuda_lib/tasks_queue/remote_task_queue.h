@@ -1,7 +1,7 @@
 #pragma once
 
 #include "single_host_task_queue.h"
-#include <catboost/cuda/cuda_lib/mpi/mpi_manager.h>
+#include <catboost/cuda/cuda_lib/transport.h>
 #include <catboost/cuda/cuda_lib/device_id.h>
 #include <catboost/cuda/cuda_lib/task.h>
 #include <catboost/cuda/cuda_lib/serialization/task_factory.h>
@@ -11,14 +11,14 @@
 #include <util/digest/city.h>
 
 namespace NCudaLib {
-#if defined(USE_MPI)
+#if defined(USE_REMOTE_DEVICES)
 
-    class TMpiTaskSlaveForwarder {
+    class TRemoteTaskSlaveForwarder {
     public:
         using TGpuTaskPtr = THolder<ICommand>;
 
-        explicit TMpiTaskSlaveForwarder(TVector<TSingleHostTaskQueue*>&& taskQueues)
-            : Manager(GetMpiManager())
+        explicit TRemoteTaskSlaveForwarder(TVector<TSingleHostTaskQueue*>&& taskQueues)
+            : Manager(GetTransportManager())
             , TaskQueues(std::move(taskQueues))
         {
             const ui64 maxTaskSize = 1024 * 1024;
@@ -67,7 +67,7 @@ namespace NCudaLib {
                 }
             }
 
-            for (TMpiRequestPtr& request : Requests) {
+            for (TTransportRequestPtr& request : Requests) {
                 if (request) {
                     Y_VERIFY(!request->IsComplete());
                     request->Abort();
@@ -86,10 +86,10 @@ namespace NCudaLib {
         }
 
     private:
-        TMpiManager& Manager;
+        TTransportManager& Manager;
         TVector<TSerializedTask> TaskBuffer;
         TVector<TSingleHostTaskQueue*> TaskQueues;
-        TVector<TMpiRequestPtr> Requests;
+        TVector<TTransportRequestPtr> Requests;
         TVector<TDeviceId> DeviceIds;
         TVector<ui64> TaskCount;
     };
@@ -97,7 +97,7 @@ namespace NCudaLib {
     class TRemoteHostTasksForwarder {
     public:
         TRemoteHostTasksForwarder(TDeviceId deviceId)
-            : Manager(GetMpiManager())
+            : Manager(GetTransportManager())
             , DeviceId(deviceId)
         {
         }
@@ -115,7 +115,7 @@ namespace NCudaLib {
         }
 
     private:
-        TMpiManager& Manager;
+        TTransportManager& Manager;
         TDeviceId DeviceId;
 
     private:
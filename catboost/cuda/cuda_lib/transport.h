@@ -0,0 +1,61 @@
+#pragma once
+
+#include <catboost/cuda/cuda_lib/mpi/mpi_manager.h>
+#include <catboost/cuda/cuda_lib/par_net/par_net_manager.h>
+
+#include <util/generic/vector.h>
+
+/*
+ * Transport selection for remote devices.
+ *
+ * Everything outside this header and the backend directories (mpi/, par_net/) is
+ * transport-agnostic: code is gated on USE_REMOTE_DEVICES and talks to the backend
+ * through TTransportManager/TTransportRequestPtr only. The build defines
+ * USE_REMOTE_DEVICES together with exactly one of USE_MPI or USE_PAR_NET.
+ */
+
+#if defined(USE_MPI) && defined(USE_PAR_NET)
+#error "Only one remote device transport could be enabled at once"
+#endif
+
+#if defined(USE_REMOTE_DEVICES) && !defined(USE_MPI) && !defined(USE_PAR_NET)
+#error "Remote devices need a transport: enable USE_MPI or USE_PAR_NET"
+#endif
+
+namespace NCudaLib {
+#if defined(USE_MPI)
+    using TTransportManager = TMpiManager;
+    using TTransportRequestPtr = TMpiRequestPtr;
+
+    inline TTransportManager& GetTransportManager() {
+        return GetMpiManager();
+    }
+#elif defined(USE_PAR_NET)
+    using TTransportManager = TParNetManager;
+    using TTransportRequestPtr = TParNetManager::TNetRequestPtr;
+
+    inline TTransportManager& GetTransportManager() {
+        return GetParNetManager();
+    }
+#endif
+
+    inline int GetHostId() {
+#if defined(USE_REMOTE_DEVICES)
+        return GetTransportManager().GetHostId();
+#else
+        return 0;
+#endif
+    }
+
+#if defined(USE_REMOTE_DEVICES)
+    inline bool AreRequestsComplete(const TVector<TTransportRequestPtr>& requests) {
+        for (const auto& request : requests) {
+            if (!request->IsComplete()) {
+                return false;
+            }
+        }
+        return true;
+    }
+#endif
+
+}
@@ -267,7 +267,7 @@ Y_UNIT_TEST_SUITE(TPerformanceTests) {
                     }
                 }
 
-#if defined(USE_MPI)
+#if defined(USE_REMOTE_DEVICES)
                 for (ui32 iter = 0; iter < tries; ++iter) {
                     auto guard = profiler.Profile("Broadcast compressed " + ToString(1.0 * sizeof(float) * (1 << i) / 1024 / 1024) + "MBx" + ToString(innerTries));
                     for (ui32 innerIter = 0; innerIter < innerTries; ++innerIter) {
@@ -122,7 +122,7 @@ Y_UNIT_TEST_SUITE(TAllReduceTest) {
         }
     }
 
-#if defined(USE_MPI)
+#if defined(USE_REMOTE_DEVICES)
     Y_UNIT_TEST(TestAllReduce256Compressed) {
         auto stopCudaManagerGuard = StartCudaManager();
         {
@@ -453,7 +453,7 @@ Y_UNIT_TEST_SUITE(TCudaBufferTest) {
         RunReshardTest(manager);
     }
 
-#if defined(USE_MPI)
+#if defined(USE_REMOTE_DEVICES)
     Y_UNIT_TEST(CompressReshardingTest) {
         auto& manager = NCudaLib::GetCudaManager();
         auto stopCudaManagerGuard = StartCudaManager();
@@ -86,7 +86,7 @@ Y_UNIT_TEST_SUITE(TRingStripeReduceTest) {
             TestReduce(4, 4, performanceOnly);
         }
     }
-#if defined(USE_MPI)
+#if defined(USE_REMOTE_DEVICES)
     Y_UNIT_TEST(TestReduceOnAll4x4Compressed) {
         auto stopCudaManagerGuard = StartCudaManager();
         {
@@ -106,7 +106,7 @@ Y_UNIT_TEST_SUITE(TRingStripeReduceTest) {
         }
     }
 
-#if defined(USE_MPI)
+#if defined(USE_REMOTE_DEVICES)
     Y_UNIT_TEST(TestReduceOnAll4x20000Compressed) {
         {
             auto stopCudaManagerGuard = StartCudaManager();
@@ -174,7 +174,7 @@ Y_UNIT_TEST_SUITE(TRingStripeReduceTest) {
         }
     }
 
-#if defined(USE_MPI)
+#if defined(USE_REMOTE_DEVICES)
     Y_UNIT_TEST(TestReduceOnAll8Compressed) {
         auto stopCudaManagerGuard = StartCudaManager();
         {
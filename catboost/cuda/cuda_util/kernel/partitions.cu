@@ -178,4 +178,29 @@ namespace NKernel {
     }
 
 
+    __global__ void RebasePartitionsToRangeImpl(const TDataPartition* parts, ui32 partCount,
+                                                ui32 rangeBegin, ui32 rangeEnd,
+                                                TDataPartition* rebasedParts) {
+        const ui32 i = blockIdx.x * blockDim.x + threadIdx.x;
+        if (i < partCount) {
+            const ui32 offset = parts[i].Offset;
+            const ui32 size = parts[i].Size;
+            const ui32 begin = max(min(offset, rangeEnd), rangeBegin);
+            const ui32 end = max(min(offset + size, rangeEnd), rangeBegin);
+            rebasedParts[i].Offset = begin - rangeBegin;
+            rebasedParts[i].Size = end - begin;
+        }
+    }
+
+    void RebasePartitionsToRange(const TDataPartition* parts, ui32 partCount,
+                                 ui32 rangeBegin, ui32 rangeEnd,
+                                 TDataPartition* rebasedParts, TCudaStream stream) {
+        if (partCount) {
+            const ui32 blockSize = 256;
+            const ui32 numBlocks = (partCount + blockSize - 1) / blockSize;
+            RebasePartitionsToRangeImpl << < numBlocks, blockSize, 0, stream >> > (parts, partCount, rangeBegin, rangeEnd, rebasedParts);
+        }
+    }
+
+
 }
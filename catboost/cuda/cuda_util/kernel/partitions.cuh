@@ -16,4 +16,8 @@ namespace NKernel {
     void ComputeSegmentSizes(const ui32* offsets, ui32 size,
                              float* dst, TCudaStream stream);
 
+    void RebasePartitionsToRange(const TDataPartition* parts, ui32 partCount,
+                                 ui32 rangeBegin, ui32 rangeEnd,
+                                 TDataPartition* rebasedParts, TCudaStream stream);
+
 }
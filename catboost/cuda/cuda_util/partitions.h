@@ -60,6 +60,36 @@ namespace NKernelHost {
         }
     };
 
+    class TRebasePartitionsKernel: public TStatelessKernel {
+    private:
+        TCudaBufferPtr<const TDataPartition> Parts;
+        ui32 RangeBegin;
+        ui32 RangeEnd;
+        TCudaBufferPtr<TDataPartition> RebasedParts;
+
+    public:
+        TRebasePartitionsKernel() = default;
+
+        TRebasePartitionsKernel(TCudaBufferPtr<const TDataPartition> parts,
+                                ui32 rangeBegin,
+                                ui32 rangeEnd,
+                                TCudaBufferPtr<TDataPartition> rebasedParts)
+            : Parts(parts)
+            , RangeBegin(rangeBegin)
+            , RangeEnd(rangeEnd)
+            , RebasedParts(rebasedParts)
+        {
+        }
+
+        Y_SAVELOAD_DEFINE(Parts, RangeBegin, RangeEnd, RebasedParts);
+
+        void Run(const TCudaStream& stream) const {
+            const ui32 partCount = static_cast<ui32>(Min(Parts.Size(), RebasedParts.Size()));
+            NKernel::RebasePartitionsToRange(Parts.Get(), partCount, RangeBegin, RangeEnd,
+                                             RebasedParts.Get(), stream.GetStream());
+        }
+    };
+
     template <NCudaLib::EPtrType PtrType>
     class TComputeSegmentSizesKernel: public TStatelessKernel {
     private:
@@ -103,6 +133,22 @@ inline void UpdatePartitionOffsets(const TCudaBuffer<ui32, TMapping>& sortedBins
     LaunchKernels<TKernel>(sortedBins.NonEmptyDevices(), stream, sortedBins, offsets);
 }
 
+/*
+ * Clamp every partition's element range to [rangeBegin, rangeEnd) and rebase the offsets to
+ * the range start. Lets a kernel that walks partitions process a block of the underlying
+ * array at a time (e.g. pairwise histograms accumulated over pair blocks): the rebased
+ * partitions describe exactly the block's share of every partition.
+ */
+template <class TMapping>
+inline void RebasePartitionsToRange(const TCudaBuffer<TDataPartition, TMapping>& parts,
+                                    ui32 rangeBegin,
+                                    ui32 rangeEnd,
+                                    TCudaBuffer<TDataPartition, TMapping>* rebasedParts,
+                                    ui32 stream = 0) {
+    using TKernel = NKernelHost::TRebasePartitionsKernel;
+    LaunchKernels<TKernel>(parts.NonEmptyDevices(), stream, parts, rangeBegin, rangeEnd, *rebasedParts);
+}
+
 template <class TMapping, class TUi32, NCudaLib::EPtrType DstPtr>
 inline void ComputeSegmentSizes(const TCudaBuffer<TUi32, TMapping>& offsets,
                                 TCudaBuffer<float, TMapping, DstPtr>& dst,
@@ -136,6 +136,14 @@ namespace NCatboostCuda {
             DataProvider.ApplyOrderToMetaColumns();
         }
 
+        bool orderIsTrivial = true;
+        for (ui32 i = 0; i < DataProvider.Order.size(); ++i) {
+            if (DataProvider.Order[i] != i) {
+                orderIsTrivial = false;
+                break;
+            }
+        }
+
         TVector<TString> featureNames;
         featureNames.resize(FeatureBlobs.size());
 
@@ -192,11 +200,19 @@ namespace NCatboostCuda {
                     return;
                 }
 
-                TVector<ui8> binarizedData = MakeOrderedLine<ui8>(FeatureBlobs[featureId],
-                                                                  DataProvider.Order);
-
                 const int binCount = static_cast<const int>(borders.size() + 1 + (ENanMode::Forbidden != nanMode));
-                auto compressedLine = CompressVector<ui64>(binarizedData, IntLog2(binCount));
+                TVector<ui64> compressedLine;
+                if (orderIsTrivial) {
+                    // Pre-binarized columns arrive as chunk-sized blocks; without a
+                    // reordering there is nothing to gather, so compress the blob in place.
+                    compressedLine = CompressVector<ui64>(FeatureBlobs[featureId].data(),
+                                                          DataProvider.Order.size(),
+                                                          IntLog2(binCount));
+                } else {
+                    TVector<ui8> binarizedData = MakeOrderedLine<ui8>(FeatureBlobs[featureId],
+                                                                      DataProvider.Order);
+                    compressedLine = CompressVector<ui64>(binarizedData, IntLog2(binCount));
+                }
 
                 featureColumns[featureId] = MakeHolder<TBinarizedFloatValuesHolder>(featureId,
                                                                                     DataProvider.Order.size(),
@@ -314,6 +330,15 @@ namespace NCatboostCuda {
         featureColumn[GetLineIdx(localIdx)] = feature;
     }
 
+    void TDataProviderBuilder::WriteBinarizedFeatureBlockToBlobImpl(ui32 localIdx, ui32 featureId, TConstArrayRef<ui8> features) {
+        Y_ASSERT(IgnoreFeatures.count(featureId) == 0);
+        Y_ASSERT(FeatureTypes[featureId] == EFeatureValuesType::BinarizedFloat);
+        CB_ENSURE(GetLineIdx(localIdx) + features.size() <= FeatureBlobs[featureId].size(),
+                  "Error: binarized feature block is out of bounds for feature #" << featureId);
+        ui8* featureColumn = FeatureBlobs[featureId].data();
+        memcpy(featureColumn + GetLineIdx(localIdx), features.data(), features.size());
+    }
+
     void TDataProviderBuilder::WriteFloatOrCatFeatureToBlobImpl(ui32 localIdx, ui32 featureId, float feature) {
         Y_ASSERT(IgnoreFeatures.count(featureId) == 0);
         Y_ASSERT(FeatureTypes[featureId] == EFeatureValuesType::Float || FeatureTypes[featureId] == EFeatureValuesType::Categorical);
@@ -111,6 +111,13 @@ namespace NCatboostCuda {
             }
         }
 
+        void AddBinarizedFloatFeatureBlock(ui32 localIdx, ui32 featureId, TConstArrayRef<ui8> binarizedFeatures) override {
+            if (IgnoreFeatures.count(featureId) == 0) {
+                CB_ENSURE(FeatureTypes[featureId] == EFeatureValuesType::BinarizedFloat, "FeatureValueType doesn't match: expect BinarizedFloat, got " << FeatureTypes[featureId]);
+                WriteBinarizedFeatureBlockToBlobImpl(localIdx, featureId, binarizedFeatures);
+            }
+        }
+
         void AddAllFloatFeatures(ui32 localIdx, TConstArrayRef<float> features) override {
             CB_ENSURE(features.size() == FeatureBlobs.size(),
                       "Error: number of features should be equal to factor count");
@@ -196,6 +203,7 @@ namespace NCatboostCuda {
         }
 
         void WriteBinarizedFeatureToBlobImpl(ui32 localIdx, ui32 featureId, ui8 feature);
+        void WriteBinarizedFeatureBlockToBlobImpl(ui32 localIdx, ui32 featureId, TConstArrayRef<ui8> features);
         void WriteFloatOrCatFeatureToBlobImpl(ui32 localIdx, ui32 featureId, float feautre);
 
     private:
@@ -131,6 +131,7 @@ namespace NCatboostCuda {
                                                              featureIds,
                                                              &CompressedIndex);
             GatherIndex.push_back(gatherIndices);
+            ScatterIndexOnDevice.emplace_back();
             SeenFeatures.push_back(TSet<ui32>());
             return blockId;
         }
@@ -164,24 +165,21 @@ namespace NCatboostCuda {
             }
             CB_ENSURE(!SeenFeatures[dataSetId].has(featureId), "Error: can't write feature twice");
 
+            //bins stay in the original (unpermuted) document order: the layout helpers
+            //apply the permutation device-side where the layout allows it, so the host
+            //only narrows the bins and DMAs them sequentially
             TVector<ui8> writeBins(bins.size());
-
-            if (GatherIndex[dataSetId]) {
-                NPar::ParallelFor(0, bins.size(), [&](ui32 i) {
-                    writeBins[i] = bins[(*GatherIndex[dataSetId])[i]];
-                    Y_ASSERT(writeBins[i] <= binCount);
-                });
-            } else {
-                for (ui32 i = 0; i < bins.size(); ++i) {
-                    writeBins[i] = bins[i];
-                    Y_ASSERT(writeBins[i] <= binCount);
-                }
+            for (ui32 i = 0; i < bins.size(); ++i) {
+                writeBins[i] = bins[i];
+                Y_ASSERT(writeBins[i] <= binCount);
             }
             //TODO(noxoomo): we could optimize this (for feature-parallel datasets)
             // by async write (common machines have 2 pci root complex, so it could be almost 2 times faster)
             // + some speedup on multi-host mode
             TCudaFeaturesLayoutHelper<TLayoutPolicy>::WriteToCompressedIndex(feature,
                                                                              writeBins,
+                                                                             GatherIndex[dataSetId].Get(),
+                                                                             &ScatterIndexOnDevice[dataSetId],
                                                                              dataSet.GetSamplesMapping(),
                                                                              &CompressedIndex.FlatStorage);
 
@@ -215,6 +213,7 @@ namespace NCatboostCuda {
         TIndex& CompressedIndex;
         TVector<TSet<ui32>> SeenFeatures;
         TVector<TAtomicSharedPtr<TVector<ui32>>> GatherIndex;
+        TVector<typename TCudaFeaturesLayoutHelper<TLayoutPolicy>::TScatterIndicesCache> ScatterIndexOnDevice;
     };
 
     extern template class TSharedCompressedIndexBuilder<TFeatureParallelLayout>;
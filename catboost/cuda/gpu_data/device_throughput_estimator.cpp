@@ -0,0 +1,95 @@
+#include "device_throughput_estimator.h"
+
+#include <catboost/cuda/cuda_lib/cuda_buffer.h>
+#include <catboost/cuda/cuda_lib/cuda_manager.h>
+#include <catboost/cuda/cuda_util/fill.h>
+#include <catboost/cuda/cuda_util/transform.h>
+#include <catboost/cuda/utils/cpu_random.h>
+#include <catboost/libs/logging/logging.h>
+
+#include <util/generic/singleton.h>
+#include <util/system/hp_timer.h>
+
+namespace NCatboostCuda {
+    namespace {
+        class TDeviceThroughputEstimator {
+        public:
+            const TVector<double>& GetWeights() {
+                if (Weights.empty()) {
+                    Weights = Measure();
+                }
+                return Weights;
+            }
+
+        private:
+            static constexpr ui32 BenchmarkSize = 1 << 22;
+            static constexpr ui32 BenchmarkIterations = 8;
+
+            static TVector<double> Measure() {
+                auto& manager = NCudaLib::GetCudaManager();
+                const ui64 devCount = manager.GetDeviceCount();
+                TVector<double> throughput(devCount);
+                if (devCount < 2) {
+                    Fill(throughput.begin(), throughput.end(), 1.0);
+                    return throughput;
+                }
+
+                TRandom rand(0);
+                TVector<ui32> gatherMap(BenchmarkSize);
+                for (auto& idx : gatherMap) {
+                    idx = rand.Uniform(BenchmarkSize);
+                }
+
+                for (ui32 dev = 0; dev < devCount; ++dev) {
+                    NCudaLib::TSingleMapping mapping(dev, BenchmarkSize);
+                    auto src = TSingleBuffer<ui32>::Create(mapping);
+                    auto dst = TSingleBuffer<ui32>::Create(mapping);
+                    auto map = TSingleBuffer<ui32>::Create(mapping);
+                    MakeSequence(src);
+                    map.Write(gatherMap);
+
+                    //warmup pass, also flushes the writes above
+                    Gather(dst, src, map);
+                    manager.WaitComplete();
+
+                    THPTimer timer;
+                    for (ui32 iter = 0; iter < BenchmarkIterations; ++iter) {
+                        Gather(dst, src, map);
+                    }
+                    manager.WaitComplete();
+                    throughput[dev] = BenchmarkIterations / Max(timer.Passed(), 1e-9);
+                }
+
+                double totalThroughput = 0;
+                for (const double deviceThroughput : throughput) {
+                    totalThroughput += deviceThroughput;
+                }
+                for (ui32 dev = 0; dev < devCount; ++dev) {
+                    throughput[dev] = throughput[dev] * devCount / totalThroughput;
+                    MATRIXNET_DEBUG_LOG << "Device #" << dev << " relative throughput: " << throughput[dev] << Endl;
+                }
+                return throughput;
+            }
+
+        private:
+            TVector<double> Weights;
+        };
+    }
+
+    TVector<double> GetDeviceThroughputWeights() {
+        return Singleton<TDeviceThroughputEstimator>()->GetWeights();
+    }
+
+    bool IsHeterogeneousFleet(const TVector<double>& deviceWeights) {
+        if (deviceWeights.size() < 2) {
+            return false;
+        }
+        double minWeight = deviceWeights[0];
+        double maxWeight = deviceWeights[0];
+        for (const double weight : deviceWeights) {
+            minWeight = Min(minWeight, weight);
+            maxWeight = Max(maxWeight, weight);
+        }
+        return maxWeight > 1.05 * minWeight;
+    }
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <util/generic/vector.h>
+
+namespace NCatboostCuda {
+    /* Relative per-device throughput weights, normalized to sum up to the device count.
+     * Measured once per process with a gather benchmark that mimics the random-access
+     * pattern of histogram computation, so on heterogeneous boxes (e.g. V100 + P40)
+     * documents can be sharded proportionally to the real device speed instead of evenly.
+     */
+    TVector<double> GetDeviceThroughputWeights();
+
+    /* True if the measured weights differ enough to justify an uneven document split.
+     * Homogeneous fleets stay on the even split, so benchmark noise cannot skew shards.
+     */
+    bool IsHeterogeneousFleet(const TVector<double>& deviceWeights);
+}
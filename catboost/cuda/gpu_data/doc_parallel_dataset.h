@@ -1,6 +1,7 @@
 #pragma once
 
 #include "cat_features_dataset.h"
+#include "device_throughput_estimator.h"
 #include "samples_grouping.h"
 #include "compressed_index.h"
 #include "dataset_base.h"
@@ -9,6 +10,7 @@
 #include <catboost/cuda/cuda_lib/cache.h>
 #include <catboost/cuda/data/data_provider.h>
 #include <catboost/cuda/data/permutation.h>
+#include <catboost/libs/logging/logging.h>
 #include <util/system/env.h>
 
 namespace NCatboostCuda {
@@ -35,7 +37,19 @@ namespace NCatboostCuda {
                 SamplesGrouping.Reset(new TWithoutQueriesGrouping(dataProvider.GetSampleCount()));
             }
 
-            auto queriesSplit = NCudaLib::TStripeMapping::SplitBetweenDevices((ui64)SamplesGrouping->GetQueryCount());
+            const ui64 queryCount = SamplesGrouping->GetQueryCount();
+            auto queriesSplit = NCudaLib::TStripeMapping::SplitBetweenDevices(queryCount);
+
+            //on mixed fleets an even split runs at slowest-device speed: shard
+            //proportionally to warmup-measured throughput instead
+            const bool useCapabilitySplit = FromString<bool>(GetEnv("CB_CAPABILITY_SPLIT", "1"));
+            if (useCapabilitySplit) {
+                const TVector<double> deviceWeights = GetDeviceThroughputWeights();
+                if (IsHeterogeneousFleet(deviceWeights)) {
+                    MATRIXNET_INFO_LOG << "Heterogeneous devices detected, using capability-weighted document split" << Endl;
+                    queriesSplit = NCudaLib::TStripeMapping::SplitBetweenDevices(queryCount, deviceWeights);
+                }
+            }
             Mapping = queriesSplit.Transform([&](const TSlice queriesSlice) {
                 return SamplesGrouping->GetQueryOffset(queriesSlice.Right) - SamplesGrouping->GetQueryOffset(queriesSlice.Left);
             });
@@ -11,7 +11,22 @@
 #include <catboost/cuda/data/binarizations_manager.h>
 #include <catboost/cuda/data/data_provider.h>
 
+#include <library/threading/local_executor/local_executor.h>
+
 namespace NCatboostCuda {
+    //gatherIndex is a permutation (position i reads document gatherIndex[i]), so the
+    //scatter form (document i is written to position scatterIndex[i]) is just the inverse.
+    //device-side compressed index writes use the scatter form: bins then stream sequentially
+    //over PCIe and only the device-memory writes are redirected
+    inline TVector<ui32> InvertGatherIndex(const TVector<ui32>& gatherIndex) {
+        TVector<ui32> scatterIndex;
+        scatterIndex.yresize(gatherIndex.size());
+        NPar::ParallelFor(0, gatherIndex.size(), [&](ui32 i) {
+            scatterIndex[gatherIndex[i]] = i;
+        });
+        return scatterIndex;
+    }
+
     //damn proxy for learn set one-hots
     class TBinarizationInfoProvider {
     public:
@@ -92,12 +92,29 @@ namespace NCatboostCuda {
             return resultHolder;
         }
 
+        //each device holds only its slice of documents, so the permutation can't be
+        //applied device-side without broadcasting whole columns; the cache stays unused
+        //and the gather happens on host
+        using TScatterIndicesCache = THolder<TStripeBuffer<ui32>>;
+
         static void WriteToCompressedIndex(const NCudaLib::TDistributedObject<TCFeature>& feature,
                                            const TVector<ui8>& bins,
+                                           const TVector<ui32>* gatherIndex,
+                                           TScatterIndicesCache* scatterCache,
                                            const NCudaLib::TStripeMapping& docsMapping,
                                            TStripeBuffer<ui32>* compressedIndex) {
+            Y_UNUSED(scatterCache);
             TStripeBuffer<ui8> tmp = TStripeBuffer<ui8>::Create(docsMapping);
-            tmp.Write(bins);
+            if (gatherIndex) {
+                TVector<ui8> gatheredBins;
+                gatheredBins.yresize(bins.size());
+                NPar::ParallelFor(0, bins.size(), [&](ui32 i) {
+                    gatheredBins[i] = bins[(*gatherIndex)[i]];
+                });
+                tmp.Write(gatheredBins);
+            } else {
+                tmp.Write(bins);
+            }
             WriteCompressedFeature(feature, tmp, *compressedIndex);
         }
     };
@@ -93,9 +93,15 @@ namespace NCatboostCuda {
             return resultHolder;
         }
 
+        //features live on different devices, so the scatter indices are mirrored once
+        //per dataset and every device composes its features itself
+        using TScatterIndicesCache = THolder<TMirrorBuffer<ui32>>;
+
         static void WriteToCompressedIndex(const NCudaLib::TDistributedObject<TCFeature>& feature,
                                            const TVector<ui8>& bins,
-                                           const NCudaLib::TMirrorMapping&,
+                                           const TVector<ui32>* gatherIndex,
+                                           TScatterIndicesCache* scatterCache,
+                                           const NCudaLib::TMirrorMapping& docsMapping,
                                            TStripeBuffer<ui32>* compressedIndex) {
             ui32 writeDev = -1;
             for (ui32 dev = 0; dev < feature.DeviceCount(); ++dev) {
@@ -106,11 +112,16 @@ namespace NCatboostCuda {
             }
             CB_ENSURE(writeDev != static_cast<ui32>(-1));
 
+            if (gatherIndex && !scatterCache->Get()) {
+                *scatterCache = MakeHolder<TMirrorBuffer<ui32>>(TMirrorBuffer<ui32>::Create(docsMapping));
+                (*scatterCache)->Write(InvertGatherIndex(*gatherIndex));
+            }
+
             using TBuffer = TCudaBuffer<ui8, NCudaLib::TSingleMapping, NCudaLib::EPtrType::CudaHost>;
             TBuffer tmp = TBuffer::Create(NCudaLib::TSingleMapping(writeDev,
                                                                    bins.size()));
             tmp.Write(bins);
-            WriteCompressedFeature(feature, tmp, *compressedIndex);
+            WriteCompressedFeature(feature, tmp, scatterCache->Get(), *compressedIndex);
         }
     };
 
@@ -87,13 +87,21 @@ namespace NCatboostCuda {
             return resultHolder;
         }
 
+        using TScatterIndicesCache = THolder<TSingleBuffer<ui32>>;
+
         static void WriteToCompressedIndex(const NCudaLib::TDistributedObject<TCFeature>& feature,
                                            const TVector<ui8>& bins,
+                                           const TVector<ui32>* gatherIndex,
+                                           TScatterIndicesCache* scatterCache,
                                            const NCudaLib::TSingleMapping& docsMapping,
                                            TStripeBuffer<ui32>* compressedIndex) {
+            if (gatherIndex && !scatterCache->Get()) {
+                *scatterCache = MakeHolder<TSingleBuffer<ui32>>(TSingleBuffer<ui32>::Create(docsMapping));
+                (*scatterCache)->Write(InvertGatherIndex(*gatherIndex));
+            }
             TSingleBuffer<ui8> tmp = TSingleBuffer<ui8>::Create(docsMapping);
             tmp.Write(bins);
-            WriteCompressedFeature(feature, tmp, *compressedIndex);
+            WriteCompressedFeature(feature, tmp, scatterCache->Get(), *compressedIndex);
         }
     };
 
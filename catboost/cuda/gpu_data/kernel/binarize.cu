@@ -6,26 +6,30 @@
 #include <contrib/libs/cub/cub/block/block_radix_sort.cuh>
 namespace NKernel {
 
-    __global__ void WriteCompressedIndexImpl(TCFeature feature, const ui8* bins, ui32 docCount, ui32* cindex) {
+    //bins are read sequentially (they may live in host-mapped memory and come over PCIe),
+    //the optional scatter index redirects the device-memory writes instead
+    __global__ void WriteCompressedIndexImpl(TCFeature feature, const ui8* bins, ui32 docCount, const ui32* scatterIndex, ui32* cindex) {
 
         cindex += feature.Offset;
         ui32 i = blockIdx.x * blockDim.x + threadIdx.x;
         while (i  < docCount) {
             const ui32 bin = (((ui32)bins[i]) & feature.Mask) << feature.Shift;
-            cindex[i] = cindex[i] | bin;
+            const ui32 writeIndex = scatterIndex ? scatterIndex[i] : i;
+            cindex[writeIndex] = cindex[writeIndex] | bin;
             i += blockDim.x * gridDim.x;
         }
     }
 
     void WriteCompressedIndex(TCFeature feature,
                               const ui8* bins, ui32 docCount,
+                              const ui32* scatterIndex,
                               ui32* cindex,
                               TCudaStream stream) {
 
         const ui32 blockSize = 256;
         const ui32 numBlocks = (docCount + blockSize - 1) / blockSize;
 
-        WriteCompressedIndexImpl<< < numBlocks, blockSize, 0, stream >> > (feature, bins, docCount, cindex);
+        WriteCompressedIndexImpl<< < numBlocks, blockSize, 0, stream >> > (feature, bins, docCount, scatterIndex, cindex);
     }
 
 
@@ -16,6 +16,7 @@ namespace NKernel {
 
     void WriteCompressedIndex(TCFeature feature,
                               const ui8* bins, ui32 docCount,
+                              const ui32* scatterIndex,
                               ui32* cindex,
                               TCudaStream stream);
 
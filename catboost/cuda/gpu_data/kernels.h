@@ -88,6 +88,7 @@ namespace NKernelHost {
     private:
         TDeviceBuffer<const ui8, Type> Bins;
         TCFeature Feature;
+        TCudaBufferPtr<const ui32> ScatterIndex;
         TCudaBufferPtr<ui32> Dst;
 
     public:
@@ -95,14 +96,16 @@ namespace NKernelHost {
 
         TWriteCompressedIndexKernel(TDeviceBuffer<const ui8, Type> bins,
                                     TCFeature feature,
+                                    TCudaBufferPtr<const ui32> scatterIndex,
                                     TCudaBufferPtr<ui32> cindex)
             : Bins(bins)
             , Feature(feature)
+            , ScatterIndex(scatterIndex)
             , Dst(cindex)
         {
         }
 
-        Y_SAVELOAD_DEFINE(Bins, Feature, Dst);
+        Y_SAVELOAD_DEFINE(Bins, Feature, ScatterIndex, Dst);
 
         void Run(const TCudaStream& stream) const {
             CB_ENSURE(Feature.Mask != 0);
@@ -110,6 +113,7 @@ namespace NKernelHost {
             NKernel::WriteCompressedIndex(Feature,
                                           Bins.Get(),
                                           Bins.Size(),
+                                          ScatterIndex.Get(),
                                           Dst.Get(),
                                           stream.GetStream());
         }
@@ -284,13 +288,26 @@ inline void BinarizeOnDevice(const TCudaBuffer<TValuesFloatType, TMapping>& feat
 
 template <class TUi32,
           class TBinsBuffer,
+          class TScatterBuffer,
           class TMapping>
 inline void WriteCompressedFeature(const NCudaLib::TDistributedObject<TCFeature>& feature,
                                    const TBinsBuffer& bins,
+                                   const TScatterBuffer* scatterIndices,
                                    TCudaBuffer<TUi32, TMapping>& cindex,
                                    ui32 stream = 0) {
     using TKernel = NKernelHost::TWriteCompressedIndexKernel<TBinsBuffer::PtrType()>;
-    LaunchKernels<TKernel>(bins.NonEmptyDevices(), stream, bins, feature, cindex);
+    LaunchKernels<TKernel>(bins.NonEmptyDevices(), stream, bins, feature, scatterIndices, cindex);
+};
+
+template <class TUi32,
+          class TBinsBuffer,
+          class TMapping>
+inline void WriteCompressedFeature(const NCudaLib::TDistributedObject<TCFeature>& feature,
+                                   const TBinsBuffer& bins,
+                                   TCudaBuffer<TUi32, TMapping>& cindex,
+                                   ui32 stream = 0) {
+    const TMirrorBuffer<ui32>* scatterIndices = nullptr;
+    WriteCompressedFeature(feature, bins, scatterIndices, cindex, stream);
 };
 
 template <class TUi32, class TMapping, class TQueryOffsetsBias>
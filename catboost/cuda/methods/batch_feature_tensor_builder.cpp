@@ -7,18 +7,30 @@
 #include <catboost/cuda/cuda_lib/device_subtasks_helper.h>
 
 namespace NCatboostCuda {
+    void TBatchFeatureTensorBuilder::PrepareCurrentBins(const TSingleBuffer<const ui32>& baseTensorIndices,
+                                                        ui32 featuresToBuild) {
+        CB_ENSURE(!CurrentBinsArePrepared, "Error: base tensor bins are already prepared");
+        {
+            TSingleBuffer<ui32> tmp;
+            TBinBuilder::ComputeCurrentBins(baseTensorIndices, tmp, CurrentBins, 0);
+        }
+        RequestStream(featuresToBuild);
+        CurrentBinsArePrepared = true;
+    }
+
     void TBatchFeatureTensorBuilder::VisitCtrBinBuilders(const TSingleBuffer<const ui32>& baseTensorIndices,
                                                          const TFeatureTensor& baseTensor,
                                                          const TVector<ui32>& catFeatureIds,
                                                          TBatchFeatureTensorBuilder::TFeatureTensorVisitor& featureTensorVisitor) {
-        TSingleBuffer<ui32> currentBins;
-        {
-            TSingleBuffer<ui32> tmp;
-            TBinBuilder::ComputeCurrentBins(baseTensorIndices, tmp, currentBins, 0);
+        const bool externallySynchronized = CurrentBinsArePrepared;
+        if (!CurrentBinsArePrepared) {
+            PrepareCurrentBins(baseTensorIndices, static_cast<ui32>(catFeatureIds.size()));
         }
 
         const ui32 buildStreams = RequestStream(static_cast<ui32>(catFeatureIds.size()));
-        NCudaLib::GetCudaManager().WaitComplete(); //ensure all prev command results will be visibile
+        if (!externallySynchronized) {
+            NCudaLib::GetCudaManager().WaitComplete(); //ensure all prev command results will be visibile
+        }
 
         for (ui32 i = 0; i < catFeatureIds.size(); i += buildStreams) {
             //submit build tensors
@@ -33,14 +45,14 @@ namespace NCatboostCuda {
                         if (CatFeatures.GetStorageType() == EGpuCatFeaturesStorage::GpuRam) {
                             CtrBinBuilders[j]
                                 .SetIndices(baseTensorIndices)
-                                .AddCompressedBinsWithCurrentBinsCache(currentBins,
+                                .AddCompressedBinsWithCurrentBinsCache(CurrentBins,
                                                                        CatFeatures.GetFeatureGpu(catFeatureId),
                                                                        FeaturesManager.GetBinCount(
                                                                            catFeatureId));
                         } else {
                             CtrBinBuilders[j]
                                 .SetIndices(baseTensorIndices)
-                                .AddCompressedBinsWithCurrentBinsCache(currentBins,
+                                .AddCompressedBinsWithCurrentBinsCache(CurrentBins,
                                                                        CatFeatures.GetFeatureCpu(catFeatureId),
                                                                        FeaturesManager.GetBinCount(
                                                                            catFeatureId));
@@ -19,6 +19,12 @@ namespace NCatboostCuda {
         {
         }
 
+        //computes base tensor bins and requests builder streams without syncing the device.
+        //lets the caller prepare several independent builders and issue one barrier for all
+        //of them before the stream-parallel visits
+        void PrepareCurrentBins(const TSingleBuffer<const ui32>& baseTensorIndices,
+                                ui32 featuresToBuild);
+
         void VisitCtrBinBuilders(const TSingleBuffer<const ui32>& baseTensorIndices,
                                  const TFeatureTensor& baseTensor,
                                  const TVector<ui32>& catFeatureIds,
@@ -34,5 +40,8 @@ namespace NCatboostCuda {
 
         TVector<TComputationStream> BuilderStreams;
         TVector<TBinBuilder> CtrBinBuilders;
+
+        TSingleBuffer<ui32> CurrentBins;
+        bool CurrentBinsArePrepared = false;
     };
 }
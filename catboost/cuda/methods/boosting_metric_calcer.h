@@ -9,7 +9,12 @@ namespace NCatboostCuda {
         virtual ~IMetricCalcer() {
         }
 
-        virtual TMetricHolder Compute(const IGpuMetric* metric) = 0;
+        //kernels are enqueued immediately, the readback is delayed until Get()
+        virtual THolder<IDeferredMetricValue> ComputeDeferred(const IGpuMetric* metric) = 0;
+
+        TMetricHolder Compute(const IGpuMetric* metric) {
+            return ComputeDeferred(metric)->Get();
+        }
     };
 
     template <class TTarget>
@@ -28,7 +33,7 @@ namespace NCatboostCuda {
             PointOnCpuCached = false;
         }
 
-        TMetricHolder Compute(const IGpuMetric* metric) final {
+        THolder<IDeferredMetricValue> ComputeDeferred(const IGpuMetric* metric) final {
             CB_ENSURE(Point.GetObjectsSlice().Size(), "Set point first");
             auto targets = Target.GetTarget().GetTargets().ConstCopyView();
             auto weights = Target.GetTarget().GetWeights().ConstCopyView();
@@ -45,8 +50,8 @@ namespace NCatboostCuda {
                                                                               Point);
 
             } else if (dynamic_cast<const TTargetFallbackMetric*>(metric)) {
-                return dynamic_cast<const TTargetFallbackMetric*>(metric)->Eval(Target,
-                                                                                Point);
+                return MakeHolder<TReadyMetricValue>(dynamic_cast<const TTargetFallbackMetric*>(metric)->Eval(Target,
+                                                                                                              Point));
 
             } else if (dynamic_cast<const TCpuFallbackMetric*>(metric)) {
                 CachePointOnCpu();
@@ -54,10 +59,10 @@ namespace NCatboostCuda {
                 if (metric->GetCpuMetric().GetErrorType() != EErrorType::PerObjectError) {
                     CacheQueryInfo(Target.GetSamplesGrouping());
                 }
-                return dynamic_cast<const TCpuFallbackMetric*>(metric)->Eval(PointOnCpu,
-                                                                             CpuTarget,
-                                                                             CpuWeights,
-                                                                             QueryInfo);
+                return MakeHolder<TReadyMetricValue>(dynamic_cast<const TCpuFallbackMetric*>(metric)->Eval(PointOnCpu,
+                                                                                                           CpuTarget,
+                                                                                                           CpuWeights,
+                                                                                                           QueryInfo));
             } else {
                 CB_ENSURE(false, "Can't compute metric " << metric->GetCpuMetric().GetDescription() << " during GPU learning");
             }
@@ -33,6 +33,7 @@ namespace NCatboostCuda {
         , ProfileInfo(catBoostOptions.BoostingOptions->IterationCount)
         , MetricDescriptions(GetMetricsDescription(GetCpuMetrics(Metrics)))
         , IsSkipOnTrainFlags(GetSkipMetricOnTrain(GetCpuMetrics(Metrics)))
+        , DeferMetrics(catBoostOptions.BoostingOptions->AsyncMetrics.Get())
     {
         if (OutputOptions.AllowWriteFiles()) {
             CreateMetaFile(OutputFiles,
@@ -78,19 +79,34 @@ namespace NCatboostCuda {
         History.TimeHistory.push_back({ProfileInfo.GetProfileResults().PassedTime,
                                        ProfileInfo.GetProfileResults().RemainingTime});
 
-        Log(MetricDescriptions,
-            IsSkipOnTrainFlags,
-            History.LearnMetricsHistory,
-            History.TestMetricsHistory,
-            ErrorTracker.GetBestError(),
-            ErrorTracker.GetBestIteration(),
-            ProfileInfo.GetProfileResults(),
-            LearnToken,
-            TestTokens,
-            skipMetrics,
-            &Logger);
+        if (!DeferMetrics) {
+            Log(MetricDescriptions,
+                IsSkipOnTrainFlags,
+                History.LearnMetricsHistory,
+                History.TestMetricsHistory,
+                ErrorTracker.GetBestError(),
+                ErrorTracker.GetBestIteration(),
+                ProfileInfo.GetProfileResults(),
+                LearnToken,
+                TestTokens,
+                skipMetrics,
+                &Logger);
+        } else {
+            //log the previous iteration, its readbacks have completed by now
+            FlushDeferredMetrics();
+
+            auto& entry = CurrentDeferredMetrics();
+            entry.ProfileResults = ProfileInfo.GetProfileResults();
+            entry.OutputMetrics = skipMetrics;
+            PendingIterationMetrics = std::move(CurrentIterationMetrics);
+        }
 
         ++Iteration;
+
+        if (DeferMetrics && ShouldStop()) {
+            //don't leave the last iteration unlogged
+            FlushDeferredMetrics();
+        }
     }
 
     void TBoostingProgressTracker::TrackLearnErrors(IMetricCalcer& metricCalcer) {
@@ -101,8 +117,12 @@ namespace NCatboostCuda {
 
         for (size_t i = 0; i < Metrics.size(); ++i) {
             if (!IsSkipOnTrainFlags[i]) {
-                auto metricValue = Metrics[i]->GetCpuMetric().GetFinalError(metricCalcer.Compute(Metrics[i].Get()));
-                History.LearnMetricsHistory.back().push_back(metricValue);
+                if (DeferMetrics) {
+                    CurrentDeferredMetrics().LearnValues.push_back(metricCalcer.ComputeDeferred(Metrics[i].Get()));
+                } else {
+                    auto metricValue = Metrics[i]->GetCpuMetric().GetFinalError(metricCalcer.Compute(Metrics[i].Get()));
+                    History.LearnMetricsHistory.back().push_back(metricValue);
+                }
             }
         }
     }
@@ -115,6 +135,10 @@ namespace NCatboostCuda {
         }
 
         for (size_t i = 0; i < Metrics.size(); ++i) {
+            if (DeferMetrics) {
+                CurrentDeferredMetrics().TestValues.push_back(metricCalcer.ComputeDeferred(Metrics[i].Get()));
+                continue;
+            }
             auto metricValue = Metrics[i]->GetCpuMetric().GetFinalError(metricCalcer.Compute(Metrics[i].Get()));
             History.TestMetricsHistory.back()[0].push_back(metricValue);
 
@@ -124,6 +148,66 @@ namespace NCatboostCuda {
         }
     }
 
+    TBoostingProgressTracker::TDeferredIterationMetrics& TBoostingProgressTracker::CurrentDeferredMetrics() {
+        if (!CurrentIterationMetrics) {
+            CurrentIterationMetrics = MakeHolder<TDeferredIterationMetrics>();
+            CurrentIterationMetrics->Iteration = Iteration;
+        }
+        return *CurrentIterationMetrics;
+    }
+
+    void TBoostingProgressTracker::ResolveDeferredValues(TDeferredIterationMetrics* entry) {
+        if (entry->ValuesResolved) {
+            return;
+        }
+
+        {
+            auto& learnErrors = History.LearnMetricsHistory.at(entry->Iteration);
+            size_t valueIdx = 0;
+            for (size_t i = 0; i < Metrics.size() && valueIdx < entry->LearnValues.size(); ++i) {
+                if (!IsSkipOnTrainFlags[i]) {
+                    learnErrors.push_back(Metrics[i]->GetCpuMetric().GetFinalError(entry->LearnValues[valueIdx++]->Get()));
+                }
+            }
+        }
+
+        if (entry->TestValues.size()) {
+            auto& testErrors = History.TestMetricsHistory.at(entry->Iteration)[0];
+            for (size_t i = 0; i < entry->TestValues.size(); ++i) {
+                auto metricValue = Metrics[i]->GetCpuMetric().GetFinalError(entry->TestValues[i]->Get());
+                testErrors.push_back(metricValue);
+
+                if (i == 0) {
+                    ErrorTracker.AddError(metricValue, static_cast<int>(entry->Iteration));
+                }
+            }
+        }
+
+        entry->ValuesResolved = true;
+    }
+
+    void TBoostingProgressTracker::FlushDeferredMetrics() {
+        if (!PendingIterationMetrics) {
+            return;
+        }
+
+        ResolveDeferredValues(PendingIterationMetrics.Get());
+
+        Log(MetricDescriptions,
+            IsSkipOnTrainFlags,
+            History.LearnMetricsHistory,
+            History.TestMetricsHistory,
+            ErrorTracker.GetBestError(),
+            ErrorTracker.GetBestIteration(),
+            PendingIterationMetrics->ProfileResults,
+            LearnToken,
+            TestTokens,
+            PendingIterationMetrics->OutputMetrics,
+            &Logger);
+
+        PendingIterationMetrics.Destroy();
+    }
+
     void TBoostingProgressTracker::MaybeRestoreFromSnapshot(std::function<void(IInputStream*)> loader) {
         if (!HasSnapshot()) {
             return;
@@ -166,6 +250,13 @@ namespace NCatboostCuda {
 
     void TBoostingProgressTracker::MaybeSaveSnapshot(std::function<void(IOutputStream*)> saver) {
         if (IsTimeToSaveSnapshot()) {
+            //in-flight metric values have to land in History before it is serialized
+            if (PendingIterationMetrics) {
+                ResolveDeferredValues(PendingIterationMetrics.Get());
+            }
+            if (CurrentIterationMetrics) {
+                ResolveDeferredValues(CurrentIterationMetrics.Get());
+            }
             TProgressHelper(GpuProgressLabel()).Write(OutputFiles.SnapshotFile, [&](IOutputStream* out) {
                 ::Save(out, CatBoostOptionsStr);
                 ::Save(out, History);
@@ -77,6 +77,30 @@ namespace NCatboostCuda {
 
         void TrackTestErrors(IMetricCalcer& metricCalcer);
 
+        /*
+         * With async metrics the readback of iteration results is delayed by one
+         * iteration: Track* only enqueue the stat kernels, the values are read and
+         * fed to the logger and the overfitting detector on the next FinishIteration,
+         * when the device has long finished them. Overfitting is detected one
+         * iteration late in exchange for removing the per-iteration sync point.
+         */
+        struct TDeferredIterationMetrics {
+            TVector<THolder<IDeferredMetricValue>> LearnValues;
+            TVector<THolder<IDeferredMetricValue>> TestValues;
+            TProfileResults ProfileResults = TProfileResults(0, 0);
+            size_t Iteration = 0;
+            bool OutputMetrics = false;
+            bool ValuesResolved = false;
+        };
+
+        TDeferredIterationMetrics& CurrentDeferredMetrics();
+
+        //feeds history and the overfitting detector; idempotent
+        void ResolveDeferredValues(TDeferredIterationMetrics* entry);
+
+        //resolves and logs the pending iteration, if any
+        void FlushDeferredMetrics();
+
         bool ShouldCalcMetricOnIteration() const {
             const auto currentIteration = GetCurrentIteration();
             return currentIteration % OutputOptions.GetMetricPeriod() == 0 || currentIteration == CatboostOptions.BoostingOptions->IterationCount - 1;
@@ -106,6 +130,10 @@ namespace NCatboostCuda {
         TVector<bool> IsSkipOnTrainFlags;
         TVector<float> BestTestCursor;
 
+        bool DeferMetrics = false;
+        THolder<TDeferredIterationMetrics> CurrentIterationMetrics;
+        THolder<TDeferredIterationMetrics> PendingIterationMetrics;
+
         size_t Iteration = 0;
         TInstant LastSnapshotTime = Now();
         bool FirstCall = true;
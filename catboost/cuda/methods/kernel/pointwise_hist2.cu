@@ -12,6 +12,17 @@ using namespace cooperative_groups;
 namespace NKernel
 {
 
+    //launches run synchronously on the per-device worker thread, so a
+    //thread-local override reaches exactly one launch
+    static thread_local ui32 BlockPerFeatureMultiplierOverride = 0;
+
+    ui32 GetBlockPerFeatureMultiplierOverride() {
+        return BlockPerFeatureMultiplierOverride;
+    }
+
+    void SetBlockPerFeatureMultiplierOverride(ui32 multiplier) {
+        BlockPerFeatureMultiplierOverride = multiplier;
+    }
 
     __global__ void UpdateBinsImpl(ui32* dstBins, const ui32* bins, const ui32* docIndices, ui32 size,
                                    ui32 loadBit, ui32 foldBits) {
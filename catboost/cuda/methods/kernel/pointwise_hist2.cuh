@@ -8,6 +8,10 @@
 //hist2 is sums for 2 elements.
 namespace NKernel {
 
+    //host-visible hooks for the launch-configuration autotuner, see split_properties_helpers.cuh
+    ui32 GetBlockPerFeatureMultiplierOverride();
+    void SetBlockPerFeatureMultiplierOverride(ui32 multiplier);
+
     bool UpdatePointwiseHistograms(float* histograms,
                                    int firstBinFeature, int binFeatureCount,
                                    int partCount,
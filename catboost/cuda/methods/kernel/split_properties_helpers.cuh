@@ -12,7 +12,15 @@
 
 namespace NKernel {
 
+    //set by the host-side autotuner for the duration of one launch, 0 means "use the heuristic"
+    ui32 GetBlockPerFeatureMultiplierOverride();
+    void SetBlockPerFeatureMultiplierOverride(ui32 multiplier);
+
     inline ui32 EstimateBlockPerFeatureMultiplier(dim3 numBlocks, ui32 dsSize, int limit = 64) {
+        const ui32 forced = GetBlockPerFeatureMultiplierOverride();
+        if (forced) {
+            return min(forced, (ui32)limit);
+        }
         int blocksPerSm = TArchProps::GetMajorVersion() < 5 ? 1 : 2;
         ui32 multiplier = 1;
         while ((numBlocks.x * numBlocks.y * min(numBlocks.z, 8) * multiplier < TArchProps::SMCount() * blocksPerSm * 1.25) &&
@@ -111,13 +111,20 @@ void TComputePairwiseHistogramKernel::Run(const TCudaStream& stream) const  {
     const auto leavesCount = static_cast<ui32>(1u << Depth);
     const ui32 partCount = leavesCount * leavesCount;
 
+    //when pairs are processed in blocks the partitions passed here are already rebased
+    //to the block (see RebasePartitionsToRange), so the kernels see a consistent
+    //pairs-and-partitions view and the partial histograms just sum up over the blocks
+    const ui32 pairBlockBegin = static_cast<ui32>(Min<ui64>(PairBlockBegin, Pairs.Size()));
+    const ui32 pairBlockEnd = static_cast<ui32>(Min<ui64>(PairBlockEnd, Pairs.Size()));
+
 #define DISPATCH(KernelName, FromBit, ToBit)                           \
     NKernel::KernelName(Features.Get(), FeaturesCpu.Get(),             \
                         static_cast<int>(Features.Size()),             \
                         FoldsHist.FeatureCountForBits(FromBit, ToBit), \
                         CompressedIndex.Get(),                         \
-                        Pairs.Get(), Pairs.Size(),                     \
-                        Weight.Get(),                                  \
+                        Pairs.Get() + pairBlockBegin,                  \
+                        pairBlockEnd - pairBlockBegin,                 \
+                        Weight.Get() + pairBlockBegin,                 \
                         Partition.Get(),                               \
                         partCount,                                     \
                         HistLineSize,                                  \
@@ -126,7 +133,7 @@ void TComputePairwiseHistogramKernel::Run(const TCudaStream& stream) const  {
                         ParallelStreamsCount,                          \
                         stream.GetStream());
 
-    if (Pairs.Size()) {
+    if (pairBlockEnd > pairBlockBegin) {
         //binary and halfByte are grouped by host
         //5-8 bits are not splitted in separate gropups and groups are skiped during kernel runtime
         switch (Policy) {
@@ -151,31 +158,35 @@ void TComputePairwiseHistogramKernel::Run(const TCudaStream& stream) const  {
         }
 #undef DISPATCH
     }
-    if (Policy != NCatboostCuda::EFeaturesGroupingPolicy::BinaryFeatures) {
-        NKernel::ScanPairwiseHistograms(Features.Get(),
-                                        Features.Size(),
-                                        partCount,
-                                        HistLineSize,
-                                        FullPass,
-                                        Histogram.Get(),
-                                        stream.GetStream());
-
-        NKernel::BuildBinaryFeatureHistograms(Features.Get(),
-                                              Features.Size(),
-                                              Partition.Get(),
-                                              PartitionStats.Get(),
-                                              partCount,
+
+    //runs once after the last pair block, with the original (not rebased) partitions
+    if (FinalBlock) {
+        if (Policy != NCatboostCuda::EFeaturesGroupingPolicy::BinaryFeatures) {
+            NKernel::ScanPairwiseHistograms(Features.Get(),
+                                            Features.Size(),
+                                            partCount,
+                                            HistLineSize,
+                                            FullPass,
+                                            Histogram.Get(),
+                                            stream.GetStream());
+
+            NKernel::BuildBinaryFeatureHistograms(Features.Get(),
+                                                  Features.Size(),
+                                                  Partition.Get(),
+                                                  PartitionStats.Get(),
+                                                  partCount,
+                                                  HistLineSize,
+                                                  FullPass,
+                                                  Histogram.Get(),
+                                                  stream.GetStream());
+        }
+
+        if (!FullPass) {
+            NKernel::UpdatePairwiseHistograms(BinFeaturesSlice.Left, BinFeaturesSlice.Size(),
+                                              Partition.Get(), partCount,
                                               HistLineSize,
-                                              FullPass,
                                               Histogram.Get(),
                                               stream.GetStream());
-    }
-
-    if (!FullPass) {
-        NKernel::UpdatePairwiseHistograms(BinFeaturesSlice.Left, BinFeaturesSlice.Size(),
-                                          Partition.Get(), partCount,
-                                          HistLineSize,
-                                          Histogram.Get(),
-                                          stream.GetStream());
+        }
     }
 }
@@ -300,6 +300,12 @@ namespace NKernelHost {
         ui32 Depth;
         ui32 HistLineSize;
         bool FullPass;
+        //local per-device pair range to accumulate (clamped to the pair count); lets huge
+        //pair sets be processed in blocks with partial histograms summed on the device
+        ui32 PairBlockBegin;
+        ui32 PairBlockEnd;
+        //scan/derive/update the histograms; set on the last pair block only
+        bool FinalBlock;
         TCudaBufferPtr<float> Histogram;
         int ParallelStreamsCount;
     public:
@@ -318,6 +324,9 @@ namespace NKernelHost {
                                         ui32 depth,
                                         ui32 histLineSize,
                                         bool fullPass,
+                                        ui32 pairBlockBegin,
+                                        ui32 pairBlockEnd,
+                                        bool finalBlock,
                                         TCudaBufferPtr<float> histogram,
                                         int parallelStreams
         )
@@ -334,6 +343,9 @@ namespace NKernelHost {
             , Depth(depth)
             , HistLineSize(histLineSize)
             , FullPass(fullPass)
+            , PairBlockBegin(pairBlockBegin)
+            , PairBlockEnd(pairBlockEnd)
+            , FinalBlock(finalBlock)
             , Histogram(histogram)
             , ParallelStreamsCount(parallelStreams)
         {
@@ -352,6 +364,9 @@ namespace NKernelHost {
                           Depth,
                           HistLineSize,
                           FullPass,
+                          PairBlockBegin,
+                          PairBlockEnd,
+                          FinalBlock,
                           Histogram,
                           ParallelStreamsCount
         );
@@ -556,6 +571,9 @@ inline void ComputeBlockPairwiseHist2(NCatboostCuda::EFeaturesGroupingPolicy pol
                                       ui32 depth,
                                       ui32 histogramLineSize,
                                       bool fullPass,
+                                      ui32 pairBlockBegin,
+                                      ui32 pairBlockEnd,
+                                      bool finalBlock,
                                       TCudaBuffer<float, NCudaLib::TStripeMapping>& histograms,
                                       int parallelStreamsCount,
                                       ui32 stream) {
@@ -576,6 +594,9 @@ inline void ComputeBlockPairwiseHist2(NCatboostCuda::EFeaturesGroupingPolicy pol
                            depth,
                            histogramLineSize,
                            fullPass,
+                           pairBlockBegin,
+                           pairBlockEnd,
+                           finalBlock,
                            histograms,
                            parallelStreamsCount
     );
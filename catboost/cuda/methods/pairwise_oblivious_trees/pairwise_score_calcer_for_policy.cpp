@@ -76,10 +76,26 @@ NCatboostCuda::TComputePairwiseScoresHelper& NCatboostCuda::TComputePairwiseScor
     //linear systems are in ABCD ABCD ABCD ABCD layout
     //sqrt matrices are reduce-scattered data: A B C D
     //tempData will live while scoresCache is not destroyed
+    //pairs are processed in blocks if some device holds too many of them: every block
+    //accumulates its share of the pairwise histograms, so only the finalization has to
+    //see the whole pass (see ComputeBlockPairwiseHist2 calls below)
+    ui64 maxDevicePairCount = 0;
+    {
+        const auto& pairsMapping = Subsets.GetPairwiseTarget().Pairs.GetMapping();
+        for (ui32 dev = 0; dev < manager.GetDeviceCount(); ++dev) {
+            maxDevicePairCount = Max<ui64>(maxDevicePairCount, pairsMapping.DeviceSlice(dev).Size());
+        }
+    }
+    const ui32 pairBlockCount = static_cast<ui32>((maxDevicePairCount + MaxPairsPerBlock - 1) / MaxPairsPerBlock);
+
     auto& tempData = scoresCacheHolder.Cache(*this, 0, [&]() -> TTempData {
         TTempData data;
         data.LinearSystems.resize(workingBlockCount);
         data.SqrtMatrices.resize(workingBlockCount);
+        data.RebasedPairParts.resize(workingBlockCount);
+        for (ui32 workingBlock = 0; workingBlock < workingBlockCount; ++workingBlock) {
+            data.RebasedPairParts[workingBlock].Reset(Subsets.GetPairPartitions().GetMapping());
+        }
         {
             using TMappingBuilder = NCudaLib::TMappingBuilder<NCudaLib::TStripeMapping>;
 
@@ -211,22 +227,84 @@ NCatboostCuda::TComputePairwiseScoresHelper& NCatboostCuda::TComputePairwiseScor
                                                                    << " features, depth " << CurrentBit);
 
 
-            ComputeBlockPairwiseHist2(Policy,
-                                      blockGrid,
-                                      blockGridCpu,
-                                      blockFoldsHist,
-                                      blockBinFeaturesSlice,
-                                      DataSet.GetCompressedIndex(),
-                                      gatheredByLeavesTarget.PairDer2OrWeights,
-                                      gatheredByLeavesTarget.Pairs,
-                                      Subsets.GetPairPartitions(),
-                                      Subsets.GetPairPartStats(),
-                                      CurrentBit,
-                                      HistogramLineSize /* = total number of bin features */,
-                                      BuildFromScratch,
-                                      PairwiseHistograms,
-                                      workingStreams,
-                                      streamId);
+            if (pairBlockCount <= 1) {
+                ComputeBlockPairwiseHist2(Policy,
+                                          blockGrid,
+                                          blockGridCpu,
+                                          blockFoldsHist,
+                                          blockBinFeaturesSlice,
+                                          DataSet.GetCompressedIndex(),
+                                          gatheredByLeavesTarget.PairDer2OrWeights,
+                                          gatheredByLeavesTarget.Pairs,
+                                          Subsets.GetPairPartitions(),
+                                          Subsets.GetPairPartStats(),
+                                          CurrentBit,
+                                          HistogramLineSize /* = total number of bin features */,
+                                          BuildFromScratch,
+                                          0,
+                                          Max<ui32>(),
+                                          true /* final block */,
+                                          PairwiseHistograms,
+                                          workingStreams,
+                                          streamId);
+            } else {
+                //accumulate partial histograms block by block; the partitions are rebased to
+                //every block so the kernels see a consistent pairs-and-partitions view
+                auto& rebasedParts = tempData.RebasedPairParts[groupId];
+                for (ui32 pairBlock = 0; pairBlock < pairBlockCount; ++pairBlock) {
+                    const ui64 blockBegin = static_cast<ui64>(pairBlock) * MaxPairsPerBlock;
+                    const ui32 pairBlockBegin = static_cast<ui32>(blockBegin);
+                    const ui32 pairBlockEnd = static_cast<ui32>(Min<ui64>(blockBegin + MaxPairsPerBlock, Max<ui32>()));
+
+                    RebasePartitionsToRange(Subsets.GetPairPartitions(),
+                                            pairBlockBegin,
+                                            pairBlockEnd,
+                                            &rebasedParts,
+                                            streamId);
+
+                    ComputeBlockPairwiseHist2(Policy,
+                                              blockGrid,
+                                              blockGridCpu,
+                                              blockFoldsHist,
+                                              blockBinFeaturesSlice,
+                                              DataSet.GetCompressedIndex(),
+                                              gatheredByLeavesTarget.PairDer2OrWeights,
+                                              gatheredByLeavesTarget.Pairs,
+                                              rebasedParts,
+                                              Subsets.GetPairPartStats(),
+                                              CurrentBit,
+                                              HistogramLineSize /* = total number of bin features */,
+                                              BuildFromScratch,
+                                              pairBlockBegin,
+                                              pairBlockEnd,
+                                              false /* final block */,
+                                              PairwiseHistograms,
+                                              workingStreams,
+                                              streamId);
+                }
+
+                //empty pair range: the accumulation is skipped and only the finalization runs,
+                //with the original (not rebased) partitions
+                ComputeBlockPairwiseHist2(Policy,
+                                          blockGrid,
+                                          blockGridCpu,
+                                          blockFoldsHist,
+                                          blockBinFeaturesSlice,
+                                          DataSet.GetCompressedIndex(),
+                                          gatheredByLeavesTarget.PairDer2OrWeights,
+                                          gatheredByLeavesTarget.Pairs,
+                                          Subsets.GetPairPartitions(),
+                                          Subsets.GetPairPartStats(),
+                                          CurrentBit,
+                                          HistogramLineSize /* = total number of bin features */,
+                                          BuildFromScratch,
+                                          0,
+                                          0,
+                                          true /* final block */,
+                                          PairwiseHistograms,
+                                          workingStreams,
+                                          streamId);
+            }
         }
 
         //histograms are flat
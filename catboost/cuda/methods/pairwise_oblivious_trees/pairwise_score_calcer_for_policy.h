@@ -52,6 +52,8 @@ namespace NCatboostCuda {
         struct TTempData {
             TVector<TStripeBuffer<float>> LinearSystems;
             TVector<TStripeBuffer<float>> SqrtMatrices;
+            //pair partitions rebased to the current pair block (used when pairs are processed in blocks)
+            TVector<TStripeBuffer<TDataPartition>> RebasedPairParts;
         };
 
         using TGpuDataSet = typename TSharedCompressedIndex<TDocParallelLayout>::TCompressedDataSet;
@@ -117,6 +119,10 @@ namespace NCatboostCuda {
         TMaybe<TVector<TCBinFeature>> BinFeaturesCpu;
 
         const ui32 MaxStreamCount = 8;
+        //if a device holds more pairs, the histogram pass processes them in blocks of this size
+        //with partial histograms accumulated on device; bounds the per-launch working set for
+        //huge pair sets instead of requiring one monolithic pass over all pairs
+        const ui32 MaxPairsPerBlock = 32u << 20;
 
         mutable TScopedCacheHolder CacheHolder;
 
@@ -1,4 +1,5 @@
 #include "pointwise_kernels.h"
+#include <catboost/cuda/cuda_lib/kernel_tuning.h>
 #include <catboost/cuda/gpu_data/grid_policy.h>
 
 using namespace NKernelHost;
@@ -14,6 +15,43 @@ namespace NCudaLib {
 
 }
 
+namespace {
+    //runs the histogram computation with the autotuned block-per-feature
+    //multiplier; first launches for an unseen shape are benchmarked
+    template <class TComputeHist>
+    inline void RunTuned(const char* kernel,
+                         TComputeHist&& computeHist,
+                         NCatboostCuda::EFeaturesGroupingPolicy policy,
+                         ui32 partCount,
+                         ui32 foldCount,
+                         ui64 docCount,
+                         const TCudaStream& stream) {
+        auto& tuning = NCudaLib::GetKernelTuningCache();
+        if (!tuning.IsEnabled()) {
+            computeHist();
+            return;
+        }
+
+        const TString key = NCudaLib::MakeKernelTuningKey(kernel,
+                                                          static_cast<int>(policy),
+                                                          partCount,
+                                                          foldCount,
+                                                          docCount);
+        bool benchmark = false;
+        const ui32 multiplier = tuning.StartLaunch(key, &benchmark);
+
+        NKernel::SetBlockPerFeatureMultiplierOverride(multiplier);
+        if (benchmark) {
+            NCudaLib::TKernelLaunchTimer timer(stream.GetStream());
+            computeHist();
+            tuning.ReportBenchmark(key, multiplier, timer.Stop());
+        } else {
+            computeHist();
+        }
+        NKernel::SetBlockPerFeatureMultiplierOverride(0);
+    }
+}
+
 void TComputeHist2Kernel::Run(const TCudaStream& stream) const {
 #define DISPATCH(KernelName)                               \
     NKernel::KernelName(Features.Get(),                    \
@@ -44,26 +82,30 @@ void TComputeHist2Kernel::Run(const TCudaStream& stream) const {
                                FoldsHist.FeatureCountForBits(FromBit, ToBit), \
                                stream.GetStream());
 
-    switch (Policy) {
-        case NCatboostCuda::EFeaturesGroupingPolicy::BinaryFeatures: {
-            DISPATCH(ComputeHist2Binary)
-            break;
-        }
-        case NCatboostCuda::EFeaturesGroupingPolicy::HalfByteFeatures: {
-            DISPATCH(ComputeHist2HalfByte)
-            break;
-        }
-        case NCatboostCuda::EFeaturesGroupingPolicy::OneByteFeatures: {
-            DISPATCH_ONE_BYTE(ComputeHist2NonBinary, 4, 5)
-            DISPATCH_ONE_BYTE(ComputeHist2NonBinary, 6, 6)
-            DISPATCH_ONE_BYTE(ComputeHist2NonBinary, 7, 7)
-            DISPATCH_ONE_BYTE(ComputeHist2NonBinary, 8, 8)
-            break;
+    auto computeHist = [&]() {
+        switch (Policy) {
+            case NCatboostCuda::EFeaturesGroupingPolicy::BinaryFeatures: {
+                DISPATCH(ComputeHist2Binary)
+                break;
+            }
+            case NCatboostCuda::EFeaturesGroupingPolicy::HalfByteFeatures: {
+                DISPATCH(ComputeHist2HalfByte)
+                break;
+            }
+            case NCatboostCuda::EFeaturesGroupingPolicy::OneByteFeatures: {
+                DISPATCH_ONE_BYTE(ComputeHist2NonBinary, 4, 5)
+                DISPATCH_ONE_BYTE(ComputeHist2NonBinary, 6, 6)
+                DISPATCH_ONE_BYTE(ComputeHist2NonBinary, 7, 7)
+                DISPATCH_ONE_BYTE(ComputeHist2NonBinary, 8, 8)
+                break;
+            }
+            default: {
+                Y_ENSURE(false);
+            }
         }
-        default: {
-            Y_ENSURE(false);
-        }
-    }
+    };
+
+    RunTuned("hist2", computeHist, Policy, PartCount, FoldCount, Indices.Size(), stream);
 #undef DISPATCH
 #undef DISPATCH_ONE_BYTE
 
@@ -107,23 +149,27 @@ void TComputeHist1Kernel::Run(const TCudaStream& stream) const {
                         BinSums.Get(),                     \
                         stream.GetStream());
 
-    switch (Policy) {
-        case NCatboostCuda::EFeaturesGroupingPolicy::BinaryFeatures: {
-            DISPATCH(ComputeHist1Binary)
-            break;
-        }
-        case NCatboostCuda::EFeaturesGroupingPolicy::HalfByteFeatures: {
-            DISPATCH(ComputeHist1HalfByte)
-            break;
+    auto computeHist = [&]() {
+        switch (Policy) {
+            case NCatboostCuda::EFeaturesGroupingPolicy::BinaryFeatures: {
+                DISPATCH(ComputeHist1Binary)
+                break;
+            }
+            case NCatboostCuda::EFeaturesGroupingPolicy::HalfByteFeatures: {
+                DISPATCH(ComputeHist1HalfByte)
+                break;
+            }
+            case NCatboostCuda::EFeaturesGroupingPolicy::OneByteFeatures: {
+                DISPATCH(ComputeHist1NonBinary)
+                break;
+            }
+            default: {
+                Y_ENSURE(false);
+            }
         }
-        case NCatboostCuda::EFeaturesGroupingPolicy::OneByteFeatures: {
-            DISPATCH(ComputeHist1NonBinary)
-            break;
-        }
-        default: {
-            Y_ENSURE(false);
-        }
-    }
+    };
+
+    RunTuned("hist1", computeHist, Policy, PartCount, FoldCount, Indices.Size(), stream);
 #undef DISPATCH
 
     if (Policy != NCatboostCuda::EFeaturesGroupingPolicy::BinaryFeatures) {
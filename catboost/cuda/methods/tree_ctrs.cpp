@@ -406,15 +406,52 @@ void NCatboostCuda::TTreeCtrDataSetsHelper::VisitPermutationDataSets(ui32 permut
 void NCatboostCuda::TTreeCtrDataSetsHelper::ProceedDataSets(const ui32 dataSetPermutationId,
                                                             const TVector<NCatboostCuda::TTreeCtrDataSet*>& dataSets,
                                                             NCatboostCuda::TTreeCtrDataSetsHelper::TDataSetVisitor& visitor) {
+    TVector<TTreeCtrDataSet*> dataSetsToBuild;
     for (auto dataSetPtr : dataSets) {
-        auto& dataSet = *dataSetPtr;
         if (dataSetPtr->GetCompressedIndexPermutationKey() != dataSetPermutationId) {
             continue;
         }
-        if (PackSizeEstimators[dataSet.GetDeviceId()]->NotEnoughMemoryForDataSet(dataSet, CurrentDepth)) {
-            FreeMemoryForDataSet(dataSet);
+        if (dataSetPtr->HasCompressedIndex()) {
+            ProceedDataSet(dataSetPermutationId, *dataSetPtr, visitor);
+        } else {
+            dataSetsToBuild.push_back(dataSetPtr);
         }
-        ProceedDataSet(dataSetPermutationId, dataSet, visitor);
+    }
+
+    /* independent dataSets are built on disjoint stream packs, so small ctr kernels from
+     * different builds overlap on device instead of leaving SMs idle between them.
+     * admission into a pack is memory-based: we never take more builds in flight than fit
+     * into free memory, so concurrency can't trigger cache drops or defragmentation
+     */
+    ui32 firstId = 0;
+    while (firstId < dataSetsToBuild.size()) {
+        auto& firstDataSet = *dataSetsToBuild[firstId];
+        const ui32 deviceId = firstDataSet.GetDeviceId();
+        if (PackSizeEstimators[deviceId]->NotEnoughMemoryForDataSet(firstDataSet, CurrentDepth)) {
+            FreeMemoryForDataSet(firstDataSet);
+        }
+        const ui32 maxParallelBuilds = PackSizeEstimators[deviceId]->GetStreamCountForCtrCalculation() > 1 ? MaxParallelBuilds : 1;
+        double packMemory = PackSizeEstimators[deviceId]->MemoryForDataSet(firstDataSet);
+        const double freeMemory = GetFreeMemory(deviceId);
+
+        ui32 lastId = firstId + 1;
+        while (lastId < dataSetsToBuild.size() && (lastId - firstId) < maxParallelBuilds &&
+               dataSetsToBuild[lastId]->GetDeviceId() == deviceId) {
+            packMemory += PackSizeEstimators[deviceId]->MemoryForDataSet(*dataSetsToBuild[lastId]);
+            if (packMemory > freeMemory) {
+                break;
+            }
+            ++lastId;
+        }
+
+        if (lastId - firstId == 1) {
+            ProceedDataSet(dataSetPermutationId, firstDataSet, visitor);
+        } else {
+            TVector<TTreeCtrDataSet*> pack(dataSetsToBuild.begin() + firstId,
+                                           dataSetsToBuild.begin() + lastId);
+            BuildAndVisitDataSets(dataSetPermutationId, pack, visitor);
+        }
+        firstId = lastId;
     }
 }
 
@@ -491,6 +528,63 @@ void NCatboostCuda::TTreeCtrDataSetsHelper::ProceedDataSet(ui32 dataSetPermutati
     }
 }
 
+void NCatboostCuda::TTreeCtrDataSetsHelper::BuildAndVisitDataSets(ui32 dataSetPermutationKey,
+                                                                  const TVector<NCatboostCuda::TTreeCtrDataSet*>& dataSets,
+                                                                  NCatboostCuda::TTreeCtrDataSetsHelper::TDataSetVisitor& visitor) {
+    const ui32 deviceId = dataSets[0]->GetDeviceId();
+    auto ctrTargets = DeviceView(DataSet.GetCtrTargets(), deviceId);
+    const ui32 tensorBuilderStreams = PackSizeEstimators[deviceId]->GetStreamCountForCtrCalculation();
+
+    NCudaLib::GetCudaManager().WaitComplete();
+
+    auto guard = NCudaLib::GetCudaManager().GetProfiler().Profile(
+        TStringBuilder() << "Build " << dataSets.size() << " ctrs datasets concurrently");
+
+    TVector<THolder<TTreeCtrDataSetBuilder>> builders;
+    TVector<THolder<TBatchFeatureTensorBuilder>> tensorBuilders;
+
+    //default-stream prep for the whole pack: cindex allocation, storage reset, base tensor bins
+    for (auto dataSetPtr : dataSets) {
+        auto& dataSet = *dataSetPtr;
+        builders.push_back(MakeHolder<TTreeCtrDataSetBuilder>(DepthPermutations[dataSetPermutationKey].DeviceView(deviceId),
+                                                              dataSet,
+                                                              tensorBuilderStreams > 1,
+                                                              !LevelBasedCompressedIndex));
+        tensorBuilders.push_back(MakeHolder<TBatchFeatureTensorBuilder>(FeaturesManager,
+                                                                        DataSet.GetCatFeatures(),
+                                                                        tensorBuilderStreams));
+        tensorBuilders.back()->PrepareCurrentBins(dataSet.GetBaseTensorIndices(),
+                                                  static_cast<ui32>(dataSet.GetCatFeatures().size()));
+    }
+    //single barrier for the whole pack instead of per-dataSet syncs; after it every build
+    //submits to its own streams only, so the builds proceed concurrently on device
+    NCudaLib::GetCudaManager().WaitComplete();
+
+    for (ui32 i = 0; i < dataSets.size(); ++i) {
+        auto& dataSet = *dataSets[i];
+        TVector<ui32> catFeatureIds(dataSet.GetCatFeatures().begin(),
+                                    dataSet.GetCatFeatures().end());
+        TCtrFromTensorCalcer ctrFromTensorCalcer(*builders[i],
+                                                 dataSet.GetCtrConfigs(),
+                                                 ctrTargets);
+        TBatchFeatureTensorBuilder::TFeatureTensorVisitor ctrFromTensorCalcerFunc = [&](const TFeatureTensor& tensor, TCtrBinBuilder<NCudaLib::TSingleMapping>& builder) {
+            ctrFromTensorCalcer(tensor, builder);
+        };
+        tensorBuilders[i]->VisitCtrBinBuilders(dataSet.GetBaseTensorIndices(),
+                                               dataSet.GetBaseTensor(),
+                                               catFeatureIds,
+                                               ctrFromTensorCalcerFunc);
+    }
+    NCudaLib::GetCudaManager().WaitComplete();
+
+    for (auto dataSetPtr : dataSets) {
+        visitor(*dataSetPtr);
+        if (NeedToDropDataSetAfterVisit(deviceId)) {
+            TTreeCtrDataSetBuilder::DropCache(*dataSetPtr);
+        }
+    }
+}
+
 bool NCatboostCuda::TTreeCtrDataSetsHelper::NeedToDropDataSetAfterVisit(ui32 deviceId) const {
     if (IsLastLevel()) {
         return true;
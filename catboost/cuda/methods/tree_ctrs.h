@@ -134,6 +134,10 @@ namespace NCatboostCuda {
                             TTreeCtrDataSet& dataSet,
                             TDataSetVisitor& visitor);
 
+        void BuildAndVisitDataSets(ui32 dataSetPermutationKey,
+                                   const TVector<TTreeCtrDataSet*>& dataSets,
+                                   TDataSetVisitor& visitor);
+
         void CachePermutation(const TMirrorBuffer<ui32>& currentBins,
                               ui32 depth);
 
@@ -190,6 +194,8 @@ namespace NCatboostCuda {
         TFeatureTensor CurrentTensor;
 
         double MinFreeMemory = 8;
+        //upper bound on ctr dataSet builds in flight; admission is memory-based on top of it
+        ui32 MaxParallelBuilds = 4;
         const ui32 MaxDepth;
         const ui32 FoldCount;
         ui32 CurrentDepth = 0;
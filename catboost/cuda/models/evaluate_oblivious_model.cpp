@@ -0,0 +1,7 @@
+#include "evaluate_oblivious_model.h"
+
+using namespace NKernelHost;
+
+namespace NCudaLib {
+    REGISTER_KERNEL(0x101303, TEvaluateObliviousModelKernel);
+}
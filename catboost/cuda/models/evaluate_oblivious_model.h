@@ -0,0 +1,82 @@
+#pragma once
+
+#include <catboost/cuda/cuda_lib/cuda_kernel_buffer.h>
+#include <catboost/cuda/cuda_lib/cuda_buffer.h>
+#include <catboost/cuda/cuda_lib/kernel.h>
+#include <catboost/cuda/models/kernel/evaluate_model.cuh>
+
+namespace NKernelHost {
+    class TEvaluateObliviousModelKernel: public TStatelessKernel {
+    private:
+        TCudaBufferPtr<const float> Features;
+        TCudaBufferPtr<const ui32> SplitFeatures;
+        TCudaBufferPtr<const float> SplitBorders;
+        TCudaBufferPtr<const ui32> TreeOffsets;
+        TCudaBufferPtr<const ui32> TreeSizes;
+        TCudaBufferPtr<const ui32> TreeLeafOffsets;
+        TCudaBufferPtr<const float> LeafValues;
+        ui32 TreeBegin = 0;
+        ui32 TreeEnd = 0;
+        TCudaBufferPtr<float> Result;
+
+    public:
+        TEvaluateObliviousModelKernel() = default;
+
+        TEvaluateObliviousModelKernel(TCudaBufferPtr<const float> features,
+                                      TCudaBufferPtr<const ui32> splitFeatures,
+                                      TCudaBufferPtr<const float> splitBorders,
+                                      TCudaBufferPtr<const ui32> treeOffsets,
+                                      TCudaBufferPtr<const ui32> treeSizes,
+                                      TCudaBufferPtr<const ui32> treeLeafOffsets,
+                                      TCudaBufferPtr<const float> leafValues,
+                                      ui32 treeBegin,
+                                      ui32 treeEnd,
+                                      TCudaBufferPtr<float> result)
+            : Features(features)
+            , SplitFeatures(splitFeatures)
+            , SplitBorders(splitBorders)
+            , TreeOffsets(treeOffsets)
+            , TreeSizes(treeSizes)
+            , TreeLeafOffsets(treeLeafOffsets)
+            , LeafValues(leafValues)
+            , TreeBegin(treeBegin)
+            , TreeEnd(treeEnd)
+            , Result(result)
+        {
+        }
+
+        Y_SAVELOAD_DEFINE(Features, SplitFeatures, SplitBorders, TreeOffsets, TreeSizes, TreeLeafOffsets, LeafValues, TreeBegin, TreeEnd, Result);
+
+        void Run(const TCudaStream& stream) const {
+            CB_ENSURE(Result.Size() < (1ULL << 32));
+            CB_ENSURE(SplitFeatures.Size() == SplitBorders.Size());
+            CB_ENSURE(TreeEnd <= TreeSizes.Size());
+
+            const ui32 docCount = (ui32)Result.Size();
+            NKernel::EvaluateObliviousModel(Features.Get(), docCount,
+                                            SplitFeatures.Get(), SplitBorders.Get(),
+                                            TreeOffsets.Get(), TreeSizes.Get(),
+                                            TreeLeafOffsets.Get(),
+                                            TreeBegin, TreeEnd,
+                                            LeafValues.Get(),
+                                            Result.Get(),
+                                            stream.GetStream());
+        }
+    };
+}
+
+inline void EvaluateObliviousModel(const TCudaBuffer<float, NCudaLib::TStripeMapping>& features,
+                                   const TCudaBuffer<ui32, NCudaLib::TMirrorMapping>& splitFeatures,
+                                   const TCudaBuffer<float, NCudaLib::TMirrorMapping>& splitBorders,
+                                   const TCudaBuffer<ui32, NCudaLib::TMirrorMapping>& treeOffsets,
+                                   const TCudaBuffer<ui32, NCudaLib::TMirrorMapping>& treeSizes,
+                                   const TCudaBuffer<ui32, NCudaLib::TMirrorMapping>& treeLeafOffsets,
+                                   const TCudaBuffer<float, NCudaLib::TMirrorMapping>& leafValues,
+                                   ui32 treeBegin,
+                                   ui32 treeEnd,
+                                   TCudaBuffer<float, NCudaLib::TStripeMapping>& result,
+                                   ui32 stream = 0) {
+    using TKernel = NKernelHost::TEvaluateObliviousModelKernel;
+    LaunchKernels<TKernel>(result.NonEmptyDevices(), stream, features, splitFeatures, splitBorders,
+                           treeOffsets, treeSizes, treeLeafOffsets, leafValues, treeBegin, treeEnd, result);
+}
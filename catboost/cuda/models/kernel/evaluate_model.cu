@@ -0,0 +1,60 @@
+#include "evaluate_model.cuh"
+
+#include <catboost/cuda/cuda_util/kernel/kernel_helpers.cuh>
+
+namespace NKernel {
+
+    //thread per document; features are stored feature-major ([feature][doc]) so that
+    //a warp reading one split touches consecutive documents and loads stay coalesced.
+    //tree metadata is read uniformly by the whole block and lives in L1/const cache.
+    template <int BLOCK_SIZE>
+    __launch_bounds__(BLOCK_SIZE, 2048 / BLOCK_SIZE)
+    __global__ void EvaluateObliviousModelImpl(const float* features, ui32 docCount,
+                                               const ui32* splitFeatures, const float* splitBorders,
+                                               const ui32* treeOffsets, const ui32* treeSizes,
+                                               const ui32* treeLeafOffsets,
+                                               ui32 treeBegin, ui32 treeEnd,
+                                               const float* leafValues,
+                                               float* result) {
+        const ui32 doc = blockIdx.x * BLOCK_SIZE + threadIdx.x;
+        if (doc >= docCount) {
+            return;
+        }
+
+        float sum = 0;
+        for (ui32 tree = treeBegin; tree < treeEnd; ++tree) {
+            const ui32 offset = LdgWithFallback(treeOffsets, tree);
+            const ui32 depth = LdgWithFallback(treeSizes, tree);
+            ui32 bin = 0;
+            for (ui32 level = 0; level < depth; ++level) {
+                const ui32 feature = LdgWithFallback(splitFeatures, offset + level);
+                const float border = LdgWithFallback(splitBorders, offset + level);
+                const float value = LdgWithFallback(features, (ui64)feature * docCount + doc);
+                bin |= (value > border ? 1 : 0) << level;
+            }
+            sum += LdgWithFallback(leafValues, LdgWithFallback(treeLeafOffsets, tree) + bin);
+        }
+        result[doc] = sum;
+    }
+
+    void EvaluateObliviousModel(const float* features, ui32 docCount,
+                                const ui32* splitFeatures, const float* splitBorders,
+                                const ui32* treeOffsets, const ui32* treeSizes,
+                                const ui32* treeLeafOffsets,
+                                ui32 treeBegin, ui32 treeEnd,
+                                const float* leafValues,
+                                float* result,
+                                TCudaStream stream) {
+        const ui32 blockSize = 256;
+        const ui32 numBlocks = CeilDivide<ui32>(docCount, blockSize);
+        if (numBlocks) {
+            EvaluateObliviousModelImpl<blockSize> << <numBlocks, blockSize, 0, stream>>>(features, docCount,
+                                                                                         splitFeatures, splitBorders,
+                                                                                         treeOffsets, treeSizes,
+                                                                                         treeLeafOffsets,
+                                                                                         treeBegin, treeEnd,
+                                                                                         leafValues, result);
+        }
+    }
+
+}
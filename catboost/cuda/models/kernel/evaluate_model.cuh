@@ -0,0 +1,16 @@
+#pragma once
+
+#include <catboost/cuda/cuda_lib/kernel/kernel.cuh>
+
+namespace NKernel {
+
+    void EvaluateObliviousModel(const float* features, ui32 docCount,
+                                const ui32* splitFeatures, const float* splitBorders,
+                                const ui32* treeOffsets, const ui32* treeSizes,
+                                const ui32* treeLeafOffsets,
+                                ui32 treeBegin, ui32 treeEnd,
+                                const float* leafValues,
+                                float* result,
+                                TCudaStream stream);
+
+}
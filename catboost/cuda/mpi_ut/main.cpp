@@ -1,5 +1,5 @@
 #include <library/unittest/utmain.h>
-#include <catboost/cuda/cuda_lib/mpi/mpi_manager.h>
+#include <catboost/cuda/cuda_lib/transport.h>
 #include <catboost/cuda/cuda_lib/cuda_manager.h>
 
 int main(int argc, char** argv) {
@@ -7,9 +7,14 @@ int main(int argc, char** argv) {
 
 #if defined(USE_MPI)
     CB_ENSURE(argc);
-    auto& mpiManager = NCudaLib::GetMpiManager();
-    mpiManager.Start(&argc, &argv);
-    if (!mpiManager.IsMaster()) {
+    auto& transportManager = NCudaLib::GetTransportManager();
+    transportManager.Start(&argc, &argv);
+#elif defined(USE_PAR_NET)
+    auto& transportManager = NCudaLib::GetTransportManager();
+    transportManager.Start();
+#endif
+#if defined(USE_REMOTE_DEVICES)
+    if (!transportManager.IsMaster()) {
         isSlave = true;
         RunSlave();
     }
@@ -22,13 +27,13 @@ int main(int argc, char** argv) {
         exitCode = NUnitTest::RunMain(argc, argv);
     }
 
-#if defined(USE_MPI)
+#if defined(USE_REMOTE_DEVICES)
     //ensure cudaManager was started at least once
     if (!isSlave) {
         auto stopGuard = StartCudaManager();
     }
-    if (mpiManager.IsMaster()) {
-        mpiManager.Stop();
+    if (transportManager.IsMaster()) {
+        transportManager.Stop();
     }
 #endif
     return exitCode;
@@ -24,14 +24,80 @@ namespace NCatboostCuda {
         return stat;
     }
 
+    /*
+     * Scalar reduced over devices. The kernels computing it are already enqueued
+     * when the value is constructed, reading the per-device partials in Get() is
+     * the only synchronization point.
+     */
+    template <class TMapping>
+    struct TDeferredScalar {
+        using TVec = TCudaBuffer<float, TMapping>;
+        using THostVec = TCudaBuffer<float, TMapping, NCudaLib::EPtrType::CudaHost>;
+
+        //per-device partials: on gpu for Approximate* stats, in pinned memory for dot-products
+        TVec DeviceStats;
+        THostVec HostStats;
+        //owned kernel input that has to outlive the enqueued computation
+        TVec TmpInput;
+
+        double Get() const {
+            if (HostStats.GetObjectsSlice().Size()) {
+                TVector<float> result;
+                NCudaLib::TCudaBufferReader<THostVec>(HostStats)
+                    .SetFactorSlice(TSlice(0, 1))
+                    .SetReadSlice(TSlice(0, 1))
+                    .ReadReduce(result);
+                return result[0];
+            }
+            return ReadReduce(DeviceStats)[0];
+        }
+    };
+
+    //dot-product without the blocking read of cuda_util DotProduct
+    template <class TMapping, class T1, class T2, class T3>
+    static inline void RunDotProduct(const TCudaBuffer<T1, TMapping>& x,
+                                     const TCudaBuffer<T2, TMapping>& y,
+                                     const TCudaBuffer<T3, TMapping>* weights,
+                                     TDeferredScalar<TMapping>* result) {
+        using TKernel = NKernelHost::TDotProductKernel<float>;
+        using THostVec = typename TDeferredScalar<TMapping>::THostVec;
+        result->HostStats = THostVec::Create(x.GetMapping().RepeatOnAllDevices(1));
+        if (weights == nullptr) {
+            LaunchKernels<TKernel>(x.NonEmptyDevices(), 0, x, y, result->HostStats);
+        } else {
+            LaunchKernels<TKernel>(x.NonEmptyDevices(), 0, x, y, *weights, result->HostStats);
+        }
+    }
+
     template <class T, class TMapping>
-    static inline double SumVector(const TCudaBuffer<T, TMapping>& vec) {
-        using TVec = TCudaBuffer<std::remove_const_t<T>, TMapping>;
-        auto tmp = TVec::CopyMapping(vec);
-        FillBuffer(tmp, 1.0f);
-        return DotProduct(tmp, vec);
+    static inline void RunSumVector(const TCudaBuffer<T, TMapping>& vec,
+                                    TDeferredScalar<TMapping>* result) {
+        using TVec = TCudaBuffer<float, TMapping>;
+        result->TmpInput = TVec::CopyMapping(vec);
+        FillBuffer(result->TmpInput, 1.0f);
+        RunDotProduct(result->TmpInput, vec, (const TVec*)nullptr, result);
     }
 
+    template <class TMapping>
+    class TDeferredAdditiveStats: public IDeferredMetricValue {
+    public:
+        TMetricHolder Get() final {
+            if (!IsReady) {
+                Value = MakeSimpleAdditiveStatistic(SumMultiplier * Sum.Get(), Weight.Get());
+                IsReady = true;
+            }
+            return Value;
+        }
+
+        TDeferredScalar<TMapping> Sum;
+        TDeferredScalar<TMapping> Weight;
+        double SumMultiplier = 1.0;
+
+    private:
+        TMetricHolder Value;
+        bool IsReady = false;
+    };
+
     class TGpuPointwiseMetric: public IGpuPointwiseMetric {
     public:
         explicit TGpuPointwiseMetric(const NCatboostOptions::TLossDescription& config)
@@ -39,26 +105,28 @@ namespace NCatboostCuda {
         {
         }
 
-        virtual TMetricHolder Eval(const TStripeBuffer<const float>& target,
-                                   const TStripeBuffer<const float>& weights,
-                                   const TStripeBuffer<const float>& cursor) const final {
+        virtual THolder<IDeferredMetricValue> Eval(const TStripeBuffer<const float>& target,
+                                                   const TStripeBuffer<const float>& weights,
+                                                   const TStripeBuffer<const float>& cursor) const final {
             return EvalOnGpu<NCudaLib::TStripeMapping>(target, weights, cursor);
         }
 
-        virtual TMetricHolder Eval(const TMirrorBuffer<const float>& target,
-                                   const TMirrorBuffer<const float>& weights,
-                                   const TMirrorBuffer<const float>& cursor) const final {
+        virtual THolder<IDeferredMetricValue> Eval(const TMirrorBuffer<const float>& target,
+                                                   const TMirrorBuffer<const float>& weights,
+                                                   const TMirrorBuffer<const float>& cursor) const final {
             return EvalOnGpu<NCudaLib::TMirrorMapping>(target, weights, cursor);
         }
 
     private:
         template <class TMapping>
-        TMetricHolder EvalOnGpu(const TCudaBuffer<const float, TMapping>& target,
-                                const TCudaBuffer<const float, TMapping>& weights,
-                                const TCudaBuffer<const float, TMapping>& cursor) const {
+        THolder<IDeferredMetricValue> EvalOnGpu(const TCudaBuffer<const float, TMapping>& target,
+                                                const TCudaBuffer<const float, TMapping>& weights,
+                                                const TCudaBuffer<const float, TMapping>& cursor) const {
             using TVec = TCudaBuffer<float, TMapping>;
 
-            double totalWeight = SumVector(weights);
+            auto result = MakeHolder<TDeferredAdditiveStats<TMapping>>();
+            RunSumVector(weights, &result->Weight);
+
             auto metricType = GetMetricDescription().GetLossFunction();
             const auto& params = GetMetricDescription().GetLossParams();
             switch (metricType) {
@@ -83,15 +151,17 @@ namespace NCatboostCuda {
                                             useBorder,
                                             border);
 
-                    const double sum = ReadReduce(tmp)[0];
-                    return MakeSimpleAdditiveStatistic(-sum, totalWeight);
+                    result->Sum.DeviceStats = std::move(tmp);
+                    result->SumMultiplier = -1.0;
+                    return std::move(result);
                 }
                 case ELossFunction::RMSE: {
                     auto tmp = TVec::CopyMapping(cursor);
                     tmp.Copy(cursor);
                     SubtractVector(tmp, target);
-                    const double sum2 = DotProduct(tmp, tmp, &weights);
-                    return MakeSimpleAdditiveStatistic(sum2, totalWeight);
+                    RunDotProduct(tmp, tmp, &weights, &result->Sum);
+                    result->Sum.TmpInput = std::move(tmp);
+                    return std::move(result);
                 }
                 case ELossFunction::Quantile:
                 case ELossFunction::MAE:
@@ -113,9 +183,9 @@ namespace NCatboostCuda {
                                          (TVec*)nullptr,
                                          (TVec*)nullptr);
 
-                    auto result = ReadReduce(tmp);
-                    const double multiplier = (metricType == ELossFunction::MAE ? 2.0 : 1.0);
-                    return MakeSimpleAdditiveStatistic(-result[0] * multiplier, totalWeight);
+                    result->Sum.DeviceStats = std::move(tmp);
+                    result->SumMultiplier = -(metricType == ELossFunction::MAE ? 2.0 : 1.0);
+                    return std::move(result);
                 }
                 default: {
                     CB_ENSURE(false, "Unsupported on GPU pointwise metric " << metricType);
@@ -131,17 +201,17 @@ namespace NCatboostCuda {
         {
         }
 
-        virtual TMetricHolder Eval(const TStripeBuffer<const float>& target,
-                                   const TStripeBuffer<const float>& weights,
-                                   const TGpuSamplesGrouping<NCudaLib::TStripeMapping>& samplesGrouping,
-                                   const TStripeBuffer<const float>& cursor) const {
+        virtual THolder<IDeferredMetricValue> Eval(const TStripeBuffer<const float>& target,
+                                                   const TStripeBuffer<const float>& weights,
+                                                   const TGpuSamplesGrouping<NCudaLib::TStripeMapping>& samplesGrouping,
+                                                   const TStripeBuffer<const float>& cursor) const {
             return EvalOnGpu<NCudaLib::TStripeMapping>(target, weights, samplesGrouping, cursor);
         }
 
-        virtual TMetricHolder Eval(const TMirrorBuffer<const float>& target,
-                                   const TMirrorBuffer<const float>& weights,
-                                   const TGpuSamplesGrouping<NCudaLib::TMirrorMapping>& samplesGrouping,
-                                   const TMirrorBuffer<const float>& cursor) const {
+        virtual THolder<IDeferredMetricValue> Eval(const TMirrorBuffer<const float>& target,
+                                                   const TMirrorBuffer<const float>& weights,
+                                                   const TGpuSamplesGrouping<NCudaLib::TMirrorMapping>& samplesGrouping,
+                                                   const TMirrorBuffer<const float>& cursor) const {
             return EvalOnGpu<NCudaLib::TMirrorMapping>(target,
                                                        weights,
                                                        samplesGrouping,
@@ -150,17 +220,20 @@ namespace NCatboostCuda {
 
     private:
         template <class TMapping>
-        TMetricHolder EvalOnGpu(const TCudaBuffer<const float, TMapping>& target,
-                                const TCudaBuffer<const float, TMapping>& weights,
-                                const TGpuSamplesGrouping<TMapping>& samplesGrouping,
-                                const TCudaBuffer<const float, TMapping>& cursor) const {
+        THolder<IDeferredMetricValue> EvalOnGpu(const TCudaBuffer<const float, TMapping>& target,
+                                                const TCudaBuffer<const float, TMapping>& weights,
+                                                const TGpuSamplesGrouping<TMapping>& samplesGrouping,
+                                                const TCudaBuffer<const float, TMapping>& cursor) const {
             using TVec = TCudaBuffer<float, TMapping>;
             auto value = TVec::Create(cursor.GetMapping().RepeatOnAllDevices(1));
 
+            auto result = MakeHolder<TDeferredAdditiveStats<TMapping>>();
+            result->SumMultiplier = -1.0;
+
             auto metricType = GetMetricDescription().GetLossFunction();
             switch (metricType) {
                 case ELossFunction::QueryRMSE: {
-                    double totalWeight = SumVector(weights);
+                    RunSumVector(weights, &result->Weight);
                     ApproximateQueryRmse(samplesGrouping.GetSizes(),
                                          samplesGrouping.GetBiasedOffsets(),
                                          samplesGrouping.GetOffsetsBias(),
@@ -171,12 +244,11 @@ namespace NCatboostCuda {
                                          &value,
                                          (TVec*)nullptr,
                                          (TVec*)nullptr);
-                    double sum = ReadReduce(value)[0];
-                    return MakeSimpleAdditiveStatistic(-sum, totalWeight);
+                    result->Sum.DeviceStats = std::move(value);
+                    return std::move(result);
                 }
                 case ELossFunction::QuerySoftMax: {
-                    double totalWeightedTarget = DotProduct(target,
-                                                            weights);
+                    RunDotProduct(target, weights, (const TVec*)nullptr, &result->Weight);
                     ApproximateQuerySoftMax(samplesGrouping.GetSizes(),
                                             samplesGrouping.GetBiasedOffsets(),
                                             samplesGrouping.GetOffsetsBias(),
@@ -188,12 +260,12 @@ namespace NCatboostCuda {
                                             &value,
                                             (TVec*)nullptr,
                                             (TVec*)nullptr);
-                    double sum = ReadReduce(value)[0];
-                    return MakeSimpleAdditiveStatistic(-sum, totalWeightedTarget);
+                    result->Sum.DeviceStats = std::move(value);
+                    return std::move(result);
                 }
                 case ELossFunction::PairLogitPairwise:
                 case ELossFunction::PairLogit: {
-                    double totalPairsWeight = SumVector(samplesGrouping.GetPairsWeights());
+                    RunSumVector(samplesGrouping.GetPairsWeights(), &result->Weight);
                     ApproximatePairLogit(samplesGrouping.GetPairs(),
                                          samplesGrouping.GetPairsWeights(),
                                          samplesGrouping.GetOffsetsBias(),
@@ -202,8 +274,8 @@ namespace NCatboostCuda {
                                          &value,
                                          (TVec*)nullptr,
                                          (TVec*)nullptr);
-                    double sum = ReadReduce(value)[0];
-                    return MakeSimpleAdditiveStatistic(-sum, totalPairsWeight);
+                    result->Sum.DeviceStats = std::move(value);
+                    return std::move(result);
                 }
                 default: {
                     CB_ENSURE(false, "Unsupported on GPU pointwise metric " << metricType);
@@ -33,6 +33,36 @@ namespace NCatboostCuda {
         NCatboostOptions::TLossDescription MetricDescription;
     };
 
+    /*
+     * Additive metric value whose device->host readback may still be in flight:
+     * the stat kernels are enqueued at Eval time, Get() waits for the tiny
+     * per-device partials on the first call. This allows the boosting loop to
+     * delay the synchronization point instead of stalling every iteration.
+     */
+    class IDeferredMetricValue {
+    public:
+        virtual ~IDeferredMetricValue() {
+        }
+
+        virtual TMetricHolder Get() = 0;
+    };
+
+    //for metrics computed synchronously (cpu and target fallbacks)
+    class TReadyMetricValue: public IDeferredMetricValue {
+    public:
+        explicit TReadyMetricValue(TMetricHolder&& value)
+            : Value(std::move(value))
+        {
+        }
+
+        TMetricHolder Get() final {
+            return Value;
+        }
+
+    private:
+        TMetricHolder Value;
+    };
+
     class IGpuPointwiseMetric: public IGpuMetric {
     public:
         explicit IGpuPointwiseMetric(const NCatboostOptions::TLossDescription& config)
@@ -40,13 +70,13 @@ namespace NCatboostCuda {
         {
         }
 
-        virtual TMetricHolder Eval(const TStripeBuffer<const float>& target,
-                                   const TStripeBuffer<const float>& weights,
-                                   const TStripeBuffer<const float>& cursor) const = 0;
+        virtual THolder<IDeferredMetricValue> Eval(const TStripeBuffer<const float>& target,
+                                                   const TStripeBuffer<const float>& weights,
+                                                   const TStripeBuffer<const float>& cursor) const = 0;
 
-        virtual TMetricHolder Eval(const TMirrorBuffer<const float>& target,
-                                   const TMirrorBuffer<const float>& weights,
-                                   const TMirrorBuffer<const float>& cursor) const = 0;
+        virtual THolder<IDeferredMetricValue> Eval(const TMirrorBuffer<const float>& target,
+                                                   const TMirrorBuffer<const float>& weights,
+                                                   const TMirrorBuffer<const float>& cursor) const = 0;
     };
 
     class IGpuQuerywiseMetric: public IGpuMetric {
@@ -56,15 +86,15 @@ namespace NCatboostCuda {
         {
         }
 
-        virtual TMetricHolder Eval(const TStripeBuffer<const float>& target,
-                                   const TStripeBuffer<const float>& weights,
-                                   const TGpuSamplesGrouping<NCudaLib::TStripeMapping>& samplesGrouping,
-                                   const TStripeBuffer<const float>& cursor) const = 0;
+        virtual THolder<IDeferredMetricValue> Eval(const TStripeBuffer<const float>& target,
+                                                   const TStripeBuffer<const float>& weights,
+                                                   const TGpuSamplesGrouping<NCudaLib::TStripeMapping>& samplesGrouping,
+                                                   const TStripeBuffer<const float>& cursor) const = 0;
 
-        virtual TMetricHolder Eval(const TMirrorBuffer<const float>& target,
-                                   const TMirrorBuffer<const float>& weights,
-                                   const TGpuSamplesGrouping<NCudaLib::TMirrorMapping>& samplesGrouping,
-                                   const TMirrorBuffer<const float>& cursor) const = 0;
+        virtual THolder<IDeferredMetricValue> Eval(const TMirrorBuffer<const float>& target,
+                                                   const TMirrorBuffer<const float>& weights,
+                                                   const TGpuSamplesGrouping<NCudaLib::TMirrorMapping>& samplesGrouping,
+                                                   const TMirrorBuffer<const float>& cursor) const = 0;
     };
 
     class TTargetFallbackMetric: public IGpuMetric {
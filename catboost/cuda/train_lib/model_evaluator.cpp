@@ -0,0 +1,125 @@
+#include <catboost/cuda/cuda_lib/cuda_buffer.h>
+#include <catboost/cuda/cuda_lib/cuda_manager.h>
+#include <catboost/cuda/models/evaluate_oblivious_model.h>
+#include <catboost/libs/model/gpu_model_evaluator.h>
+
+#include <util/generic/ptr.h>
+
+namespace NCatboostCuda {
+    /* GPU applier for float-only oblivious models: the model is flattened into plain
+     * split/leaf arrays mirrored on every device, documents are striped between devices,
+     * and binarization against the split borders happens in-kernel. Models with one-hot
+     * or ctr conditions still go through the CPU evaluator.
+     */
+    class TGpuModelEvaluator: public IGpuModelEvaluator {
+    public:
+        TGpuModelEvaluator()
+            : StopCudaManagerGuard(MakeHolder<TStopGuard>(StartCudaManager(ELoggingLevel::Silent)))
+        {
+        }
+
+        void CalcFlat(const TFullModel& model,
+                      const TVector<TConstArrayRef<float>>& floatFeatureColumns,
+                      size_t treeBegin,
+                      size_t treeEnd,
+                      TArrayRef<double> result) override {
+            const auto& trees = model.ObliviousTrees;
+            CB_ENSURE(trees.ApproxDimension == 1, "Error: GPU evaluator supports single-dimension models only");
+            CB_ENSURE(trees.OneHotFeatures.empty() && trees.CtrFeatures.empty(),
+                      "Error: GPU evaluator supports models with float features only");
+            CB_ENSURE(trees.NonSymmetricStepNodes.empty(), "Error: GPU evaluator supports oblivious trees only");
+            CB_ENSURE(treeBegin <= treeEnd && treeEnd <= trees.GetTreeCount());
+            CB_ENSURE(floatFeatureColumns.size() == trees.FloatFeatures.size(),
+                      "Error: expected one column per model float feature");
+
+            const ui64 docCount = result.size();
+            for (const auto& column : floatFeatureColumns) {
+                CB_ENSURE(column.size() == docCount, "Error: feature column size doesn't match document count");
+            }
+            if (docCount == 0) {
+                return;
+            }
+
+            const auto& binFeatures = trees.GetBinFeatures();
+            TVector<ui32> splitFeatures;
+            TVector<float> splitBorders;
+            splitFeatures.reserve(trees.TreeSplits.size());
+            splitBorders.reserve(trees.TreeSplits.size());
+            for (int splitIdx : trees.TreeSplits) {
+                const TModelSplit& split = binFeatures[splitIdx];
+                CB_ENSURE(split.Type == ESplitType::FloatFeature,
+                          "Error: GPU evaluator supports models with float features only");
+                splitFeatures.push_back((ui32)split.FloatFeature.FloatFeature);
+                splitBorders.push_back(split.FloatFeature.Split);
+            }
+            TVector<ui32> treeOffsets(trees.TreeStartOffsets.begin(), trees.TreeStartOffsets.end());
+            TVector<ui32> treeSizes(trees.TreeSizes.begin(), trees.TreeSizes.end());
+            const auto firstLeafOffsets = trees.GetFirstLeafOffsets();
+            TVector<ui32> treeLeafOffsets(firstLeafOffsets.begin(), firstLeafOffsets.end());
+            //leaves are applied in single precision on device, like during GPU training
+            TVector<float> leaves;
+            if (trees.HasFloat32Leaves()) {
+                leaves = trees.LeafValuesFloat;
+            } else {
+                const auto leafValues = trees.GetLeafValuesRef();
+                leaves.assign(leafValues.begin(), leafValues.end());
+            }
+
+            auto docMapping = NCudaLib::TStripeMapping::SplitBetweenDevices(docCount);
+            const ui64 featureCount = trees.FloatFeatures.size();
+            auto featuresMapping = docMapping.Transform([&](const TSlice& slice) -> ui64 {
+                return slice.Size() * featureCount;
+            });
+
+            //feature-major layout per device, so that the kernel reads are coalesced
+            TVector<float> featuresFlat;
+            featuresFlat.yresize(docCount * featureCount);
+            const ui64 devCount = NCudaLib::GetCudaManager().GetDeviceCount();
+            ui64 cursor = 0;
+            for (ui64 dev = 0; dev < devCount; ++dev) {
+                const TSlice docSlice = docMapping.DeviceSlice(dev);
+                for (ui64 f = 0; f < featureCount; ++f) {
+                    for (ui64 doc = docSlice.Left; doc < docSlice.Right; ++doc) {
+                        featuresFlat[cursor++] = floatFeatureColumns[f][doc];
+                    }
+                }
+            }
+
+            auto features = TStripeBuffer<float>::Create(featuresMapping);
+            features.Write(featuresFlat);
+
+            auto splitFeaturesGpu = TMirrorBuffer<ui32>::Create(NCudaLib::TMirrorMapping(splitFeatures.size()));
+            auto splitBordersGpu = TMirrorBuffer<float>::Create(NCudaLib::TMirrorMapping(splitBorders.size()));
+            auto treeOffsetsGpu = TMirrorBuffer<ui32>::Create(NCudaLib::TMirrorMapping(treeOffsets.size()));
+            auto treeSizesGpu = TMirrorBuffer<ui32>::Create(NCudaLib::TMirrorMapping(treeSizes.size()));
+            auto treeLeafOffsetsGpu = TMirrorBuffer<ui32>::Create(NCudaLib::TMirrorMapping(treeLeafOffsets.size()));
+            auto leavesGpu = TMirrorBuffer<float>::Create(NCudaLib::TMirrorMapping(leaves.size()));
+            splitFeaturesGpu.Write(splitFeatures);
+            splitBordersGpu.Write(splitBorders);
+            treeOffsetsGpu.Write(treeOffsets);
+            treeSizesGpu.Write(treeSizes);
+            treeLeafOffsetsGpu.Write(treeLeafOffsets);
+            leavesGpu.Write(leaves);
+
+            auto resultGpu = TStripeBuffer<float>::Create(docMapping);
+            EvaluateObliviousModel(features, splitFeaturesGpu, splitBordersGpu,
+                                   treeOffsetsGpu, treeSizesGpu, treeLeafOffsetsGpu,
+                                   leavesGpu, (ui32)treeBegin, (ui32)treeEnd, resultGpu);
+
+            TVector<float> resultHost;
+            resultGpu.Read(resultHost);
+            for (ui64 doc = 0; doc < docCount; ++doc) {
+                result[doc] = resultHost[doc];
+            }
+        }
+
+    private:
+        using TStopGuard = TFinallyGuard<TStopCudaManagerCallback>;
+
+        //device workers live for the whole evaluator lifetime, so repeated CalcFlat
+        //calls (block-wise pool processing) don't pay manager start/stop each time
+        THolder<TStopGuard> StopCudaManagerGuard;
+    };
+}
+
+TGpuModelEvaluatorFactory::TRegistrator<NCatboostCuda::TGpuModelEvaluator> GpuModelEvaluatorRegistrator(ETaskType::GPU);
@@ -7,6 +7,8 @@
 #include <catboost/libs/helpers/permutation.h>
 #include <catboost/libs/helpers/progress_helper.h>
 #include <catboost/libs/helpers/vector_helpers.h>
+#include <catboost/libs/logging/trace_profiler.h>
+#include <catboost/libs/options/enum_helpers.h>
 #include <catboost/cuda/ctrs/prior_estimator.h>
 #include <catboost/cuda/models/additive_model.h>
 #include <catboost/cuda/models/oblivious_model.h>
@@ -79,6 +81,10 @@ namespace NCatboostCuda {
         }
     }
 
+    // Past this width the replicated per-device feature metadata and histograms of the
+    // doc-parallel layout dominate GPU memory, so sharding by feature pays off.
+    const ui32 FeatureParallelWidthThreshold = 10000;
+
     inline void UpdateDataPartitionType(const TBinarizedFeaturesManager& featuresManager,
                                         NCatboostOptions::TCatBoostOptions& catBoostOptions) {
         if (catBoostOptions.CatFeatureParams->MaxTensorComplexity > 1 && featuresManager.GetCatFeatureIds().size()) {
@@ -86,7 +92,25 @@ namespace NCatboostCuda {
         } else {
             if (catBoostOptions.BoostingOptions->BoostingType == EBoostingType::Plain) {
                 if (catBoostOptions.BoostingOptions->DataPartitionType.NotSet()) {
-                    catBoostOptions.BoostingOptions->DataPartitionType = EDataPartitionType::DocParallel;
+                    /* Doc-parallel layout shards documents but keeps every feature (and its
+                     * histograms) on every device, so an ultra-wide pool can exceed a single
+                     * GPU even quantized. When several devices are available and the loss has
+                     * a feature-parallel trainer, shard such pools by feature instead. */
+                    const auto lossFunction = catBoostOptions.LossFunctionDescription->GetLossFunction();
+                    const ui32 devCount = NCudaLib::GetEnabledDevices(catBoostOptions.SystemOptions->Devices,
+                                                                      NCudaLib::GetDevicesProvider().GetDeviceCount())
+                                              .size();
+                    if (devCount > 1 &&
+                        featuresManager.GetFeatureCount() >= FeatureParallelWidthThreshold &&
+                        !IsGpuDocParallelOnlyMode(lossFunction))
+                    {
+                        MATRIXNET_INFO_LOG << "Pool has " << featuresManager.GetFeatureCount()
+                            << " features; using feature-parallel data partition to shard them across "
+                            << devCount << " devices" << Endl;
+                        catBoostOptions.BoostingOptions->DataPartitionType = EDataPartitionType::FeatureParallel;
+                    } else {
+                        catBoostOptions.BoostingOptions->DataPartitionType = EDataPartitionType::DocParallel;
+                    }
                 }
             }
         }
@@ -270,6 +294,11 @@ namespace NCatboostCuda {
         } else {
             profiler.SetDefaultProfileMode(NCudaLib::EProfileMode::NoProfile);
         }
+
+        THolder<TTraceProfilerSession> traceProfilerSession;
+        if (outputOptions.AllowWriteFiles() && !outputOptions.GetTraceLogFilename().empty()) {
+            traceProfilerSession = MakeHolder<TTraceProfilerSession>(outputOptions.CreateTraceLogFullPath());
+        }
         TGpuAwareRandom random(trainCatBoostOptions.RandomSeed);
 
         THolder<TAdditiveModel<TObliviousTreeModel>> model;
@@ -6,14 +6,18 @@
 #include <catboost/libs/model/model_pool_compatibility.h>
 
 
-TVector<TVector<double>> ApplyModelMulti(const TFullModel& model,
-                                         const TPool& pool,
-                                         const EPredictionType predictionType,
-                                         int begin, /*= 0*/
-                                         int end,   /*= 0*/
-                                         NPar::TLocalExecutor& executor) {
+TVector<TVector<double>> ApplyModelMultiForDocRange(const TFullModel& model,
+                                                    const TPool& pool,
+                                                    const EPredictionType predictionType,
+                                                    int begin, /*= 0*/
+                                                    int end,   /*= 0*/
+                                                    size_t docBegin,
+                                                    size_t docEnd,
+                                                    NPar::TLocalExecutor& executor) {
     CheckModelAndPoolCompatibility(model, pool);
-    const int docCount = (int)pool.Docs.GetDocCount();
+    CB_ENSURE(docBegin <= docEnd && docEnd <= pool.Docs.GetDocCount(),
+              "invalid document range [" << docBegin << ", " << docEnd << ")");
+    const int docCount = (int)(docEnd - docBegin);
     auto approxDimension = model.ObliviousTrees.ApproxDimension;
     TVector<double> approxFlat(static_cast<unsigned long>(docCount * approxDimension));
 
@@ -36,7 +40,10 @@ TVector<TVector<double>> ApplyModelMulti(const TFullModel& model,
             const int blockFirstId = blockParams.FirstId + blockId * blockParams.GetBlockSize();
             const int blockLastId = Min(blockParams.LastId, blockFirstId + blockParams.GetBlockSize());
             for (int i = 0; i < pool.Docs.GetEffectiveFactorCount(); ++i) {
-                repackedFeatures.emplace_back(MakeArrayRef(pool.Docs.Factors[i].data() + blockFirstId, blockLastId - blockFirstId));
+                // ignored or freed factors have no values; the model does not read them either
+                const TConstArrayRef<float> factorRef = pool.Docs.GetFactorRef(i);
+                repackedFeatures.emplace_back(
+                    factorRef.empty() ? factorRef : factorRef.Slice(docBegin + blockFirstId, blockLastId - blockFirstId));
             }
             TArrayRef<double> resultRef(approxFlat.data() + blockFirstId * approxDimension, (blockLastId - blockFirstId) * approxDimension);
             model.CalcFlatTransposed(repackedFeatures, begin, end, resultRef);
@@ -63,6 +70,37 @@ TVector<TVector<double>> ApplyModelMulti(const TFullModel& model,
 }
 
 
+TVector<TVector<double>> ApplyModelMulti(const TFullModel& model,
+                                         const TPool& pool,
+                                         const EPredictionType predictionType,
+                                         int begin, /*= 0*/
+                                         int end,   /*= 0*/
+                                         NPar::TLocalExecutor& executor) {
+    return ApplyModelMultiForDocRange(model, pool, predictionType, begin, end, 0, pool.Docs.GetDocCount(), executor);
+}
+
+TVector<TVector<double>> ApplyModelMultiForDocRange(const TFullModel& model,
+                                                    const TPool& pool,
+                                                    bool verbose,
+                                                    const EPredictionType predictionType,
+                                                    int begin,
+                                                    int end,
+                                                    size_t docBegin,
+                                                    size_t docEnd,
+                                                    int threadCount) {
+    if (verbose) {
+        SetVerboseLogingMode();
+    } else {
+        SetSilentLogingMode();
+    }
+
+    NPar::TLocalExecutor executor;
+    executor.RunAdditionalThreads(threadCount - 1);
+    TVector<TVector<double>> result = ApplyModelMultiForDocRange(model, pool, predictionType, begin, end, docBegin, docEnd, executor);
+    SetSilentLogingMode();
+    return result;
+}
+
 TVector<TVector<double>> ApplyModelMulti(const TFullModel& model,
                                          const TPool& pool,
                                          bool verbose,
@@ -33,6 +33,29 @@ TVector<double> ApplyModel(const TFullModel& model,
                            int end = 0,
                            int threadCount = 1);
 
+/*
+ * Apply the model to the document range [docBegin, docEnd) of the pool only. Lets callers
+ * evaluate a huge pool chunk by chunk with peak result memory proportional to one chunk.
+ */
+TVector<TVector<double>> ApplyModelMultiForDocRange(const TFullModel& model,
+                                                    const TPool& pool,
+                                                    const EPredictionType predictionType,
+                                                    int begin,
+                                                    int end,
+                                                    size_t docBegin,
+                                                    size_t docEnd,
+                                                    NPar::TLocalExecutor& executor);
+
+TVector<TVector<double>> ApplyModelMultiForDocRange(const TFullModel& model,
+                                                    const TPool& pool,
+                                                    bool verbose,
+                                                    const EPredictionType predictionType,
+                                                    int begin,
+                                                    int end,
+                                                    size_t docBegin,
+                                                    size_t docEnd,
+                                                    int threadCount);
+
 
 /*
  * Tradeoff memory for speed
@@ -58,7 +81,10 @@ public:
             const int blockFirstId = BlockParams.FirstId + blockId * BlockParams.GetBlockSize();
             const int blockLastId = Min(BlockParams.LastId, blockFirstId + BlockParams.GetBlockSize());
             for (int i = 0; i < pool.Docs.GetEffectiveFactorCount(); ++i) {
-                repackedFeatures.emplace_back(MakeArrayRef(pool.Docs.Factors[i].data() + blockFirstId, blockLastId - blockFirstId));
+                // ignored or freed factors have no values; the model does not read them either
+                const TConstArrayRef<float> factorRef = pool.Docs.GetFactorRef(i);
+                repackedFeatures.emplace_back(
+                    factorRef.empty() ? factorRef : factorRef.Slice(blockFirstId, blockLastId - blockFirstId));
             }
             auto floatAccessor = [&repackedFeatures](const TFloatFeature& floatFeature, size_t index) -> float {
                 return repackedFeatures[floatFeature.FlatFeatureIndex][index];
@@ -67,7 +93,7 @@ public:
             auto catAccessor = [&repackedFeatures](const TCatFeature& catFeature, size_t index) -> int {
                 return ConvertFloatCatFeatureToIntHash(repackedFeatures[catFeature.FlatFeatureIndex][index]);
             };
-            ui64 docCount = repackedFeatures[0].Size();
+            ui64 docCount = blockLastId - blockFirstId;
             ThreadCalcers[blockId] = MakeHolder<TFeatureCachedTreeEvaluator>(Model, floatAccessor, catAccessor, docCount);
         }, 0, BlockParams.GetBlockCount(), NPar::TLocalExecutor::WAIT_COMPLETE);
 
@@ -8,13 +8,18 @@
 #include "index_calcer.h"
 #include "learn_context.h"
 #include "error_functions.h"
+#include "pairlogit_helpers.h"
 #include "yetirank_helpers.h"
+
+#include <catboost/libs/logging/trace_profiler.h>
 #include "pairwise_leaves_calculation.h"
 
 #include <catboost/libs/logging/logging.h>
 #include <catboost/libs/logging/profile_info.h>
 #include <catboost/libs/options/enum_helpers.h>
 
+#include <util/string/builder.h>
+
 template <bool StoreExpApprox, int VectorWidth>
 inline void UpdateApproxKernel(const double* leafValues, const TIndexType* indices, double* resArr) {
     Y_ASSERT(VectorWidth == 4);
@@ -253,11 +258,15 @@ void UpdateBucketsSimple(
         TVector<TQueryInfo> recalculatedQueriesInfo;
         TVector<float> recalculatedPairwiseWeights;
         const bool shouldGenerateYetiRankPairs = ShouldGenerateYetiRankPairs(params.LossFunctionDescription->GetLossFunction());
+        const bool shouldResamplePairs = ShouldResamplePairLogitPairs(params.LossFunctionDescription);
         if (shouldGenerateYetiRankPairs) {
             YetiRankRecalculation(ff, bt, params, randomSeed, localExecutor, &recalculatedQueriesInfo, &recalculatedPairwiseWeights);
+        } else if (shouldResamplePairs) {
+            PairLogitPairsRecalculation(ff, bt, params, randomSeed, localExecutor, &recalculatedQueriesInfo, &recalculatedPairwiseWeights);
         }
-        const TVector<TQueryInfo>& queriesInfo = shouldGenerateYetiRankPairs ? recalculatedQueriesInfo : ff.LearnQueriesInfo;
-        const TVector<float>& weights = bt.PairwiseWeights.empty() ? ff.GetLearnWeights() : shouldGenerateYetiRankPairs ? recalculatedPairwiseWeights : bt.PairwiseWeights;
+        const bool useRecalculatedQueriesInfo = shouldGenerateYetiRankPairs || shouldResamplePairs;
+        const TVector<TQueryInfo>& queriesInfo = useRecalculatedQueriesInfo ? recalculatedQueriesInfo : ff.LearnQueriesInfo;
+        const TVector<float>& weights = bt.PairwiseWeights.empty() ? ff.GetLearnWeights() : useRecalculatedQueriesInfo ? recalculatedPairwiseWeights : bt.PairwiseWeights;
 
         CalculateDersForQueries(
             approxes,
@@ -268,6 +277,7 @@ void UpdateBucketsSimple(
             error,
             /*queryStartIndex=*/0,
             queryCount,
+            localExecutor,
             scratchDers
         );
         UpdateBucketsForQueries(
@@ -279,6 +289,7 @@ void UpdateBucketsSimple(
             queryCount,
             estimationMethod,
             iteration,
+            localExecutor,
             buckets
         );
         if (IsPairwiseScoring(params.LossFunctionDescription->GetLossFunction())) {
@@ -295,6 +306,7 @@ inline void CalcMixedModelSimple(
     const NCatboostOptions::TCatBoostOptions& params,
     double sumAllWeights,
     int allDocCount,
+    NPar::TLocalExecutor* localExecutor,
     TVector<double>* leafValues
 ) {
     const int leafCount = buckets.ysize();
@@ -305,7 +317,7 @@ inline void CalcMixedModelSimple(
         for (int leaf = 0; leaf < leafCount; ++leaf) {
             derSums[leaf] = buckets[leaf].SumDerHistory[iteration];
         }
-        *leafValues = CalculatePairwiseLeafValues(pairwiseWeightSums, derSums, l2Regularizer, pairwiseNonDiagReg);
+        *leafValues = CalculatePairwiseLeafValues(pairwiseWeightSums, derSums, l2Regularizer, pairwiseNonDiagReg, localExecutor);
         return;
     }
 
@@ -342,17 +354,21 @@ void CalcTailModelSimple(
     TVector<TQueryInfo> recalculatedQueriesInfo;
     TVector<float> recalculatedPairwiseWeights;
     const bool shouldGenerateYetiRankPairs = ShouldGenerateYetiRankPairs(params.LossFunctionDescription->GetLossFunction());
+    const bool shouldResamplePairs = ShouldResamplePairLogitPairs(params.LossFunctionDescription);
     if (shouldGenerateYetiRankPairs) {
         YetiRankRecalculation(ff, bt, params, randomSeed, localExecutor, &recalculatedQueriesInfo, &recalculatedPairwiseWeights);
+    } else if (shouldResamplePairs) {
+        PairLogitPairsRecalculation(ff, bt, params, randomSeed, localExecutor, &recalculatedQueriesInfo, &recalculatedPairwiseWeights);
     }
-    const TVector<TQueryInfo>& queriesInfo = shouldGenerateYetiRankPairs ? recalculatedQueriesInfo : ff.LearnQueriesInfo;
-    const TVector<float>& weights = bt.PairwiseWeights.empty() ? ff.GetLearnWeights() : shouldGenerateYetiRankPairs ? recalculatedPairwiseWeights : bt.PairwiseWeights;
+    const bool useRecalculatedQueriesInfo = shouldGenerateYetiRankPairs || shouldResamplePairs;
+    const TVector<TQueryInfo>& queriesInfo = useRecalculatedQueriesInfo ? recalculatedQueriesInfo : ff.LearnQueriesInfo;
+    const TVector<float>& weights = bt.PairwiseWeights.empty() ? ff.GetLearnWeights() : useRecalculatedQueriesInfo ? recalculatedPairwiseWeights : bt.PairwiseWeights;
 
     if (error.GetErrorType() == EErrorType::PerObjectError) {
         CalcShiftedApproxDers(bt.Approx[0], *approxDeltas, ff.LearnTarget, weights, error, bt.BodyFinish, bt.TailFinish, weightedDers, ctx);
     } else {
         Y_ASSERT(error.GetErrorType() == EErrorType::QuerywiseError || error.GetErrorType() == EErrorType::PairwiseError);
-        CalculateDersForQueries(bt.Approx[0], *approxDeltas, ff.LearnTarget, weights, queriesInfo, error, bt.BodyQueryFinish, bt.TailQueryFinish, weightedDers);
+        CalculateDersForQueries(bt.Approx[0], *approxDeltas, ff.LearnTarget, weights, queriesInfo, error, bt.BodyQueryFinish, bt.TailQueryFinish, localExecutor, weightedDers);
     }
     TSum* bucketsData = buckets->data();
     const TIndexType* indicesData = indices.data();
@@ -388,6 +404,14 @@ void CalcTailModelSimple(
     }
 }
 
+inline double CalcMaxLeafDelta(const TVector<double>& leafDeltas) {
+    double maxDelta = 0;
+    for (double delta : leafDeltas) {
+        maxDelta = Max(maxDelta, Abs(delta));
+    }
+    return maxDelta;
+}
+
 template <typename TError>
 void CalcApproxDeltaSimple(
     const TFold& ff,
@@ -400,6 +424,7 @@ void CalcApproxDeltaSimple(
 ) {
     const auto treeLearnerOptions = ctx->Params.ObliviousTreeOptions.Get();
     const int gradientIterations = static_cast<int>(treeLearnerOptions.LeavesEstimationIterations);
+    const float convergenceTolerance = treeLearnerOptions.LeavesEstimationConvergenceTolerance;
     const auto estimationMethod = treeLearnerOptions.LeavesEstimationMethod;
     const float l2Regularizer = treeLearnerOptions.L2Reg;
     const TVector<ui64> randomSeeds = GenRandUI64Vector(ff.BodyTailArr.ysize(), randomSeed);
@@ -431,7 +456,9 @@ void CalcApproxDeltaSimple(
 
         for (int it = 0; it < gradientIterations; ++it) {
             UpdateBucketsSimple(indices, ff, bt, bt.Approx[0], resArr[0], error, bt.BodyFinish, bodyQueryFinish, it, estimationMethod, ctx->Params, randomSeeds[bodyTailId], &localExecutor, &buckets, &pairwiseBuckets, &weightedDers);
-            CalcMixedModelSimple(buckets, pairwiseBuckets, it, ctx->Params, bt.BodySumWeight, bt.BodyFinish, &curLeafValues);
+            CalcMixedModelSimple(buckets, pairwiseBuckets, it, ctx->Params, bt.BodySumWeight, bt.BodyFinish, &localExecutor, &curLeafValues);
+            // Check before the deltas are applied: UpdateApproxDeltas exponentiates curLeafValues in place for exp-approx losses.
+            const bool isConverged = convergenceTolerance > 0 && CalcMaxLeafDelta(curLeafValues) < convergenceTolerance;
 
             if (!ctx->Params.BoostingOptions->ApproxOnFullHistory) {
                 UpdateApproxDeltas<TError::StoreExpApprox>(indices, bt.TailFinish, &localExecutor, &curLeafValues, &resArr[0]);
@@ -440,6 +467,9 @@ void CalcApproxDeltaSimple(
                 UpdateApproxDeltas<TError::StoreExpApprox>(indices, bt.BodyFinish, &localExecutor, &curLeafValues, &resArr[0]);
                 CalcTailModelSimple(indices, ff, bt, error, it, l2Regularizer, ctx->Params, randomSeeds[bodyTailId], &localExecutor, ctx, &buckets, &resArr[0], &weightedDers);
             }
+            if (isConverged) {
+                break;
+            }
         }
     }, 0, ff.BodyTailArr.ysize(), NPar::TLocalExecutor::WAIT_COMPLETE);
 }
@@ -461,6 +491,7 @@ void CalcLeafValuesSimple(
     const int queryCount = ff.LearnQueriesInfo.ysize();
     const auto& learnerOptions = ctx->Params.ObliviousTreeOptions.Get();
     const int gradientIterations = learnerOptions.LeavesEstimationIterations;
+    const float convergenceTolerance = learnerOptions.LeavesEstimationConvergenceTolerance;
     const auto estimationMethod = learnerOptions.LeavesEstimationMethod;
     auto& localExecutor = ctx->LocalExecutor;
     const TFold::TBodyTail& bt = ff.BodyTailArr[0];
@@ -471,14 +502,23 @@ void CalcLeafValuesSimple(
     TVector<double> curLeafValues; // iteration scratch space
 
     leafValues->assign(1, TVector<double>(leafCount));
+    int iterationsUsed = gradientIterations;
     for (int it = 0; it < gradientIterations; ++it) {
         UpdateBucketsSimple(indices, ff, bt, approxes, /*approxDeltas*/ {}, error, ff.GetLearnSampleCount(), queryCount, it, estimationMethod, ctx->Params, ctx->Rand.GenRand(), &localExecutor, &buckets, &pairwiseBuckets, &weightedDers);
-        CalcMixedModelSimple(buckets, pairwiseBuckets, it, ctx->Params, ff.GetSumWeight(), ff.GetLearnSampleCount(), &curLeafValues);
+        CalcMixedModelSimple(buckets, pairwiseBuckets, it, ctx->Params, ff.GetSumWeight(), ff.GetLearnSampleCount(), &localExecutor, &curLeafValues);
         for (int leaf = 0; leaf < leafCount; ++leaf) {
             (*leafValues)[0][leaf] += curLeafValues[leaf];
         }
+        if (convergenceTolerance > 0 && CalcMaxLeafDelta(curLeafValues) < convergenceTolerance) {
+            // The converged step is already added to leafValues; the approxes scratch is only read by the next step.
+            iterationsUsed = it + 1;
+            break;
+        }
         UpdateApproxDeltas<TError::StoreExpApprox>(indices, ff.GetLearnSampleCount(), &ctx->LocalExecutor, &curLeafValues, &approxes);
     }
+    if (convergenceTolerance > 0) {
+        ctx->Profile.AddOperation(TStringBuilder() << "Leaf estimation (" << iterationsUsed << " of " << gradientIterations << " iterations)");
+    }
 }
 
 template <typename TError>
@@ -492,6 +532,7 @@ void CalcLeafValues(
     TVector<TVector<double>>* leafValues,
     TVector<TIndexType>* indices
 ) {
+    TTraceProfilerScope traceScope(AsStringBuf("CalcLeafValues"));
     *indices = BuildIndices(fold, tree, learnData, testDataPtrs, &ctx->LocalExecutor);
     const int approxDimension = ctx->LearnProgress.AveragingFold.GetApproxDimension();
     Y_VERIFY(fold.GetLearnSampleCount() == (int)learnData.GetSampleCount());
@@ -515,6 +556,7 @@ void CalcApproxForLeafStruct(
     TLearnContext* ctx,
     TVector<TVector<TVector<double>>>* approxesDelta // [bodyTailId][approxDim][docIdxInPermuted]
 ) {
+    TTraceProfilerScope traceScope(AsStringBuf("CalcApproxForLeafStruct"));
     const TVector<TIndexType> indices = BuildIndices(fold, tree, learnData, testDataPtrs, &ctx->LocalExecutor);
     const int approxDimension = fold.GetApproxDimension();
     const int leafCount = tree.GetLeafCount();
@@ -4,6 +4,8 @@
 #include "online_predictor.h"
 #include "approx_util.h"
 
+#include <util/generic/utility.h>
+
 template <bool StoreExpApprox>
 inline void UpdateApproxDeltasMulti(
     const TVector<TIndexType>& indices,
@@ -51,6 +53,11 @@ void AddSampleToBucketGradientMulti(
     bucket->AddDerWeight(*curDer, weight, iteration);
 }
 
+// Documents per transposition block: the transposed approx tile stays cache-resident even at
+// several hundred classes, and the gather touches one class array at a time instead of keeping
+// ApproxDimension concurrent strided streams alive.
+const int MultiApproxBlockSize = 64;
+
 template <typename TError, typename TAddSampleToBucket>
 void UpdateBucketsMulti(
     TAddSampleToBucket AddSampleToBucket,
@@ -66,16 +73,25 @@ void UpdateBucketsMulti(
 ) {
     const int approxDimension = resArr.ysize();
     Y_ASSERT(approxDimension > 0);
-    TVector<double> curApprox(approxDimension);
+    TVector<TVector<double>> blockApprox(Min(MultiApproxBlockSize, sampleCount), TVector<double>(approxDimension));
     TVector<double> bufferDer(approxDimension);
     TArray2D<double> bufferDer2(approxDimension, approxDimension);
-    for (int z = 0; z < sampleCount; ++z) {
+    for (int blockStart = 0; blockStart < sampleCount; blockStart += MultiApproxBlockSize) {
+        const int blockEnd = Min(blockStart + MultiApproxBlockSize, sampleCount);
         for (int dim = 0; dim < approxDimension; ++dim) {
-            curApprox[dim] = approx.empty() ? resArr[dim][z] : UpdateApprox<TError::StoreExpApprox>(approx[dim][z], resArr[dim][z]);
+            const double* const approxData = approx.empty() ? nullptr : approx[dim].data();
+            const double* const resData = resArr[dim].data();
+            for (int z = blockStart; z < blockEnd; ++z) {
+                blockApprox[z - blockStart][dim] = approxData == nullptr
+                    ? resData[z]
+                    : UpdateApprox<TError::StoreExpApprox>(approxData[z], resData[z]);
+            }
+        }
+        for (int z = blockStart; z < blockEnd; ++z) {
+            TSumMulti& bucket = (*buckets)[indices[z]];
+            AddSampleToBucket(error, blockApprox[z - blockStart], target[z], weight.empty() ? 1 : weight[z], iteration,
+                              &bufferDer, &bufferDer2, &bucket);
         }
-        TSumMulti& bucket = (*buckets)[indices[z]];
-        AddSampleToBucket(error, curApprox, target[z], weight.empty() ? 1 : weight[z], iteration,
-                          &bufferDer, &bufferDer2, &bucket);
     }
 }
 
@@ -121,23 +137,33 @@ void CalcApproxDeltaIterationMulti(
     UpdateApproxDeltasMulti<TError::StoreExpApprox>(indices, bt.BodyFinish, &curLeafValues, resArr);
 
     // compute tail
-    TVector<double> curApprox(approxDimension);
+    TVector<TVector<double>> blockApprox(
+        Min(MultiApproxBlockSize, Max(bt.TailFinish - bt.BodyFinish, 1)),
+        TVector<double>(approxDimension));
     TVector<double> avrg(approxDimension);
     TVector<double> bufferDer(approxDimension);
     TArray2D<double> bufferDer2(approxDimension, approxDimension);
-    for (int z = bt.BodyFinish; z < bt.TailFinish; ++z) {
+    for (int blockStart = bt.BodyFinish; blockStart < bt.TailFinish; blockStart += MultiApproxBlockSize) {
+        const int blockEnd = Min(blockStart + MultiApproxBlockSize, bt.TailFinish);
+        // The gather may run ahead of the per-document updates below: document z only writes
+        // its own resArr column, which was already consumed into blockApprox by then.
         for (int dim = 0; dim < approxDimension; ++dim) {
-            curApprox[dim] = UpdateApprox<TError::StoreExpApprox>(bt.Approx[dim][z], (*resArr)[dim][z]);
+            const double* const approxData = bt.Approx[dim].data();
+            const double* const resData = (*resArr)[dim].data();
+            for (int z = blockStart; z < blockEnd; ++z) {
+                blockApprox[z - blockStart][dim] = UpdateApprox<TError::StoreExpApprox>(approxData[z], resData[z]);
+            }
         }
+        for (int z = blockStart; z < blockEnd; ++z) {
+            TSumMulti& bucket = (*buckets)[indices[z]];
+            AddSampleToBucket(error, blockApprox[z - blockStart], target[z], weight.empty() ? 1 : weight[z], iteration,
+                              &bufferDer, &bufferDer2, &bucket);
 
-        TSumMulti& bucket = (*buckets)[indices[z]];
-        AddSampleToBucket(error, curApprox, target[z], weight.empty() ? 1 : weight[z], iteration,
-                          &bufferDer, &bufferDer2, &bucket);
-
-        CalcModel(bucket, iteration, l2Regularizer, &avrg);
-        ExpApproxIf(TError::StoreExpApprox, &avrg);
-        for (int dim = 0; dim < approxDimension; ++dim) {
-            (*resArr)[dim][z] = UpdateApprox<TError::StoreExpApprox>((*resArr)[dim][z], avrg[dim]);
+            CalcModel(bucket, iteration, l2Regularizer, &avrg);
+            ExpApproxIf(TError::StoreExpApprox, &avrg);
+            for (int dim = 0; dim < approxDimension; ++dim) {
+                (*resArr)[dim][z] = UpdateApprox<TError::StoreExpApprox>((*resArr)[dim][z], avrg[dim]);
+            }
         }
     }
 }
@@ -21,7 +21,7 @@ static void UpdateBucketsForLeaves(
 }
 
 void UpdateBucketsForQueries(
-    TVector<TDers> weightedDers,
+    const TVector<TDers>& weightedDers,
     const TVector<TIndexType>& indices,
     const TVector<float>& weights,
     const TVector<TQueryInfo>& queriesInfo,
@@ -29,19 +29,39 @@ void UpdateBucketsForQueries(
     int queryEndIndex,
     ELeavesEstimation estimationMethod,
     int iteration,
+    NPar::TLocalExecutor* localExecutor,
     TVector<TSum>* buckets
 ) {
     const int leafCount = buckets->ysize();
+
+    NPar::TLocalExecutor::TExecRangeParams blockParams(queryStartIndex, queryEndIndex);
+    blockParams.SetBlockCount(CB_THREAD_LIMIT);
+    const int blockCount = blockParams.GetBlockCount();
+    TVector<TVector<TDers>> blockBucketDers(blockCount, TVector<TDers>(leafCount, TDers{/*Der1*/0.0, /*Der2*/0.0, /*Der3*/0.0}));
+    TVector<TVector<double>> blockBucketWeights(blockCount, TVector<double>(leafCount, 0));
+    localExecutor->ExecRange([&](int blockId) {
+        const int blockQueryStart = queryStartIndex + blockId * blockParams.GetBlockSize();
+        const int blockQueryEnd = Min(blockQueryStart + blockParams.GetBlockSize(), queryEndIndex);
+        TDers* bucketDers = blockBucketDers[blockId].data();
+        double* bucketWeights = blockBucketWeights[blockId].data();
+        const int begin = queriesInfo[blockQueryStart].Begin;
+        const int end = queriesInfo[blockQueryEnd - 1].End;
+        for (int docId = begin; docId < end; ++docId) {
+            TDers& currentDers = bucketDers[indices[docId]];
+            currentDers.Der1 += weightedDers[docId].Der1;
+            currentDers.Der2 += weightedDers[docId].Der2;
+            bucketWeights[indices[docId]] += weights.empty() ? 1.0f : weights[docId];
+        }
+    }, 0, blockCount, NPar::TLocalExecutor::WAIT_COMPLETE);
+
     TVector<TDers> bucketDers(leafCount, TDers{/*Der1*/0.0, /*Der2*/0.0, /*Der3*/0.0});
     TVector<double> bucketWeights(leafCount, 0);
-
-    const int begin = queriesInfo[queryStartIndex].Begin;
-    const int end = queriesInfo[queryEndIndex - 1].End;
-    for (int docId = begin; docId < end; ++docId) {
-        TDers& currentDers = bucketDers[indices[docId]];
-        currentDers.Der1 += weightedDers[docId].Der1;
-        currentDers.Der2 += weightedDers[docId].Der2;
-        bucketWeights[indices[docId]] += weights.empty() ? 1.0f : weights[docId];
+    for (int blockId = 0; blockId < blockCount; ++blockId) {
+        for (int leafId = 0; leafId < leafCount; ++leafId) {
+            bucketDers[leafId].Der1 += blockBucketDers[blockId][leafId].Der1;
+            bucketDers[leafId].Der2 += blockBucketDers[blockId][leafId].Der2;
+            bucketWeights[leafId] += blockBucketWeights[blockId][leafId];
+        }
     }
 
     if (estimationMethod == ELeavesEstimation::Newton) {
@@ -63,4 +83,3 @@ void UpdateBucketsForQueries(
         );
     }
 }
-
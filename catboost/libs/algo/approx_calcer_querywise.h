@@ -4,6 +4,11 @@
 #include "approx_util.h"
 
 #include <catboost/libs/data_types/query.h>
+#include <catboost/libs/options/restrictions.h>
+
+#include <library/threading/local_executor/local_executor.h>
+
+#include <util/generic/algorithm.h>
 
 template <typename TError>
 void CalculateDersForQueries(
@@ -15,6 +20,7 @@ void CalculateDersForQueries(
     const TError& error,
     int queryStartIndex,
     int queryEndIndex,
+    NPar::TLocalExecutor* localExecutor,
     TVector<TDers>* weightedDers
 ) {
     TVector<double> fullApproxes(approxes);
@@ -24,11 +30,24 @@ void CalculateDersForQueries(
         }
     }
 
-    error.CalcDersForQueries(queryStartIndex, queryEndIndex, fullApproxes, targets, weights, queriesInfo, weightedDers);
+    NPar::TLocalExecutor::TExecRangeParams blockParams(queryStartIndex, queryEndIndex);
+    blockParams.SetBlockCount(CB_THREAD_LIMIT);
+    const int firstDocId = queriesInfo[queryStartIndex].Begin;
+    localExecutor->ExecRange([&](int blockId) {
+        const int blockQueryStart = queryStartIndex + blockId * blockParams.GetBlockSize();
+        const int blockQueryEnd = Min(blockQueryStart + blockParams.GetBlockSize(), queryEndIndex);
+        const int blockDocStart = queriesInfo[blockQueryStart].Begin;
+        const int blockDocEnd = queriesInfo[blockQueryEnd - 1].End;
+        // CalcDersForQueries writes ders relative to the first document of its query range,
+        // so each block computes into a local buffer and then copies it into place.
+        TVector<TDers> blockDers(blockDocEnd - blockDocStart);
+        error.CalcDersForQueries(blockQueryStart, blockQueryEnd, fullApproxes, targets, weights, queriesInfo, &blockDers);
+        Copy(blockDers.begin(), blockDers.end(), weightedDers->begin() + (blockDocStart - firstDocId));
+    }, 0, blockParams.GetBlockCount(), NPar::TLocalExecutor::WAIT_COMPLETE);
 }
 
 void UpdateBucketsForQueries(
-    TVector<TDers> weightedDers,
+    const TVector<TDers>& weightedDers,
     const TVector<TIndexType>& indices,
     const TVector<float>& weights,
     const TVector<TQueryInfo>& queriesInfo,
@@ -36,5 +55,6 @@ void UpdateBucketsForQueries(
     int queryEndIndex,
     ELeavesEstimation estimationMethod,
     int iteration,
+    NPar::TLocalExecutor* localExecutor,
     TVector<TSum>* buckets
 );
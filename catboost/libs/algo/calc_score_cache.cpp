@@ -29,6 +29,21 @@ void TBucketStatsCache::GarbageCollect() {
     }
 }
 
+void TBucketStatsCache::Reset() {
+    with_lock(Lock) {
+        Stats.clear();
+        if (MemoryPool) {
+            MemoryPool->Clear();
+        }
+    }
+}
+
+size_t TBucketStatsCache::GetBytesUsed() {
+    with_lock(Lock) {
+        return MemoryPool ? MemoryPool->MemoryAllocated() : 0;
+    }
+}
+
 
 void TCalcScoreFold::TVectorSlicing::Create(const NPar::TLocalExecutor::TExecRangeParams& blockParams) {
     Total = blockParams.LastId;
@@ -76,8 +91,11 @@ static int GetMaxTailFinish(const TVector<TFold>& folds, int bodyTailIdx) {
     return maxTailFinish;
 }
 
-void TCalcScoreFold::Create(const TVector<TFold>& folds, bool isPairwiseScoring, float sampleRate) {
+void TCalcScoreFold::Create(const TVector<TFold>& folds, bool isPairwiseScoring, float sampleRate, bool singlePrecisionDerivatives) {
     BernoulliSampleRate = sampleRate;
+    // Pairwise scoring reads the derivatives through TConstArrayRef<double>, so it keeps the
+    // double storage regardless of the requested mode.
+    SinglePrecisionDerivatives = singlePrecisionDerivatives && !isPairwiseScoring;
     Y_ASSERT(BernoulliSampleRate > 0.0f && BernoulliSampleRate <= 1.0f);
     DocCount = folds[0].LearnPermutation.ysize();
     Y_ASSERT(DocCount > 0);
@@ -87,6 +105,7 @@ void TCalcScoreFold::Create(const TVector<TFold>& folds, bool isPairwiseScoring,
     LearnWeights.yresize(DocCount);
     SampleWeights.yresize(DocCount);
     Control.yresize(DocCount);
+    HasZeroWeightDocs = false;
     BodyTailCount = GetMaxBodyTailCount(folds);
     HasPairwiseWeights = !folds[0].BodyTailArr[0].PairwiseWeights.empty();
     IsPairwiseScoring = isPairwiseScoring;
@@ -95,8 +114,6 @@ void TCalcScoreFold::Create(const TVector<TFold>& folds, bool isPairwiseScoring,
     ApproxDimension = folds[0].GetApproxDimension();
     Y_ASSERT(ApproxDimension > 0);
     for (int bodyTailIdx = 0; bodyTailIdx < BodyTailCount; ++bodyTailIdx) {
-        BodyTailArr[bodyTailIdx].WeightedDerivatives.yresize(ApproxDimension);
-        BodyTailArr[bodyTailIdx].SampleWeightedDerivatives.yresize(ApproxDimension);
         const int bodyFinish = GetMaxBodyFinish(folds, bodyTailIdx);
         Y_ASSERT(bodyFinish > 0);
         const int tailFinish = GetMaxTailFinish(folds, bodyTailIdx);
@@ -105,9 +122,20 @@ void TCalcScoreFold::Create(const TVector<TFold>& folds, bool isPairwiseScoring,
             BodyTailArr[bodyTailIdx].PairwiseWeights.yresize(tailFinish);
             BodyTailArr[bodyTailIdx].SamplePairwiseWeights.yresize(tailFinish);
         }
-        for (int dimIdx = 0; dimIdx < ApproxDimension; ++dimIdx) {
-            BodyTailArr[bodyTailIdx].WeightedDerivatives[dimIdx].yresize(bodyFinish);
-            BodyTailArr[bodyTailIdx].SampleWeightedDerivatives[dimIdx].yresize(tailFinish);
+        if (SinglePrecisionDerivatives) {
+            BodyTailArr[bodyTailIdx].WeightedDerivativesFloat.yresize(ApproxDimension);
+            BodyTailArr[bodyTailIdx].SampleWeightedDerivativesFloat.yresize(ApproxDimension);
+            for (int dimIdx = 0; dimIdx < ApproxDimension; ++dimIdx) {
+                BodyTailArr[bodyTailIdx].WeightedDerivativesFloat[dimIdx].yresize(bodyFinish);
+                BodyTailArr[bodyTailIdx].SampleWeightedDerivativesFloat[dimIdx].yresize(tailFinish);
+            }
+        } else {
+            BodyTailArr[bodyTailIdx].WeightedDerivatives.yresize(ApproxDimension);
+            BodyTailArr[bodyTailIdx].SampleWeightedDerivatives.yresize(ApproxDimension);
+            for (int dimIdx = 0; dimIdx < ApproxDimension; ++dimIdx) {
+                BodyTailArr[bodyTailIdx].WeightedDerivatives[dimIdx].yresize(bodyFinish);
+                BodyTailArr[bodyTailIdx].SampleWeightedDerivatives[dimIdx].yresize(tailFinish);
+            }
         }
     }
 }
@@ -138,6 +166,59 @@ static inline TData GetElement(const TData* source, size_t j) {
     return source[j];
 }
 
+static inline float NarrowToFloat(const double* source, size_t j) {
+    return static_cast<float>(source[j]);
+}
+
+// Overloads for the two gather sources: the master fold always stores double derivatives and
+// narrows them on the fly in single precision mode; a score fold source already matches the
+// destination storage.
+static inline void SelectDerivativesBlock(
+    const TFold::TBodyTail& srcBodyTail,
+    TArrayRef<const bool> srcControlRef,
+    const TCalcScoreFold::TVectorSlicing::TSlice& srcBodyBlock,
+    const TCalcScoreFold::TVectorSlicing::TSlice& srcTailBlock,
+    const TCalcScoreFold::TVectorSlicing::TSlice& dstBlock,
+    bool singlePrecision,
+    int approxDimension,
+    TCalcScoreFold::TBodyTail* dstBodyTail,
+    int* bodyCount,
+    int* tailCount
+) {
+    for (int dim = 0; dim < approxDimension; ++dim) {
+        if (singlePrecision) {
+            SetElements(srcControlRef, srcBodyBlock.GetConstRef(srcBodyTail.WeightedDerivatives[dim]), NarrowToFloat, dstBlock.GetRef(dstBodyTail->WeightedDerivativesFloat[dim]), bodyCount);
+            SetElements(srcControlRef, srcTailBlock.GetConstRef(srcBodyTail.SampleWeightedDerivatives[dim]), NarrowToFloat, dstBlock.GetRef(dstBodyTail->SampleWeightedDerivativesFloat[dim]), tailCount);
+        } else {
+            SetElements(srcControlRef, srcBodyBlock.GetConstRef(srcBodyTail.WeightedDerivatives[dim]), GetElement<double>, dstBlock.GetRef(dstBodyTail->WeightedDerivatives[dim]), bodyCount);
+            SetElements(srcControlRef, srcTailBlock.GetConstRef(srcBodyTail.SampleWeightedDerivatives[dim]), GetElement<double>, dstBlock.GetRef(dstBodyTail->SampleWeightedDerivatives[dim]), tailCount);
+        }
+    }
+}
+
+static inline void SelectDerivativesBlock(
+    const TCalcScoreFold::TBodyTail& srcBodyTail,
+    TArrayRef<const bool> srcControlRef,
+    const TCalcScoreFold::TVectorSlicing::TSlice& srcBodyBlock,
+    const TCalcScoreFold::TVectorSlicing::TSlice& srcTailBlock,
+    const TCalcScoreFold::TVectorSlicing::TSlice& dstBlock,
+    bool singlePrecision,
+    int approxDimension,
+    TCalcScoreFold::TBodyTail* dstBodyTail,
+    int* bodyCount,
+    int* tailCount
+) {
+    for (int dim = 0; dim < approxDimension; ++dim) {
+        if (singlePrecision) {
+            SetElements(srcControlRef, srcBodyBlock.GetConstRef(srcBodyTail.WeightedDerivativesFloat[dim]), GetElement<float>, dstBlock.GetRef(dstBodyTail->WeightedDerivativesFloat[dim]), bodyCount);
+            SetElements(srcControlRef, srcTailBlock.GetConstRef(srcBodyTail.SampleWeightedDerivativesFloat[dim]), GetElement<float>, dstBlock.GetRef(dstBodyTail->SampleWeightedDerivativesFloat[dim]), tailCount);
+        } else {
+            SetElements(srcControlRef, srcBodyBlock.GetConstRef(srcBodyTail.WeightedDerivatives[dim]), GetElement<double>, dstBlock.GetRef(dstBodyTail->WeightedDerivatives[dim]), bodyCount);
+            SetElements(srcControlRef, srcTailBlock.GetConstRef(srcBodyTail.SampleWeightedDerivatives[dim]), GetElement<double>, dstBlock.GetRef(dstBodyTail->SampleWeightedDerivatives[dim]), tailCount);
+        }
+    }
+}
+
 template<typename TFoldType>
 void TCalcScoreFold::SelectBlockFromFold(const TFoldType& fold, TSlice srcBlock, TSlice dstBlock) {
     int ignored;
@@ -156,16 +237,15 @@ void TCalcScoreFold::SelectBlockFromFold(const TFoldType& fold, TSlice srcBlock,
             SetElements(srcControlRef, srcTailBlock.GetConstRef(srcBodyTail.PairwiseWeights), GetElement<float>, dstBlock.GetRef(dstBodyTail.PairwiseWeights), &tailCount);
             SetElements(srcControlRef, srcTailBlock.GetConstRef(srcBodyTail.SamplePairwiseWeights), GetElement<float>, dstBlock.GetRef(dstBodyTail.SamplePairwiseWeights), &tailCount);
         }
-        for (int dim = 0; dim < ApproxDimension; ++dim) {
-            SetElements(srcControlRef, srcBodyBlock.GetConstRef(srcBodyTail.WeightedDerivatives[dim]), GetElement<double>, dstBlock.GetRef(dstBodyTail.WeightedDerivatives[dim]), &bodyCount);
-            SetElements(srcControlRef, srcTailBlock.GetConstRef(srcBodyTail.SampleWeightedDerivatives[dim]), GetElement<double>, dstBlock.GetRef(dstBodyTail.SampleWeightedDerivatives[dim]), &tailCount);
-        }
+        SelectDerivativesBlock(srcBodyTail, srcControlRef, srcBodyBlock, srcTailBlock, dstBlock, SinglePrecisionDerivatives, ApproxDimension, &dstBodyTail, &bodyCount, &tailCount);
         AtomicAdd(dstBodyTail.BodyFinish, bodyCount); // these atomics may take up to 2-3% of iteration time
         AtomicAdd(dstBodyTail.TailFinish, tailCount);
     }
 }
 
 void TCalcScoreFold::SelectSmallestSplitSide(int curDepth, const TCalcScoreFold& fold, NPar::TLocalExecutor* localExecutor) {
+    Y_ASSERT(fold.SinglePrecisionDerivatives == SinglePrecisionDerivatives);
+    TrivialSampleWeights = fold.TrivialSampleWeights;
     NPar::TLocalExecutor::TExecRangeParams blockParams(0, fold.DocCount);
     blockParams.SetBlockSize(2000);
     const int blockCount = blockParams.GetBlockCount();
@@ -202,13 +282,32 @@ void TCalcScoreFold::Sample(const TFold& fold, const TVector<TIndexType>& indice
     srcBlocks.Create(blockParams);
 
     TVectorSlicing dstBlocks;
-    SetSampledControl(indices.ysize(), rand);
+    TrivialSampleWeights = fold.SampleWeightsAreTrivial;
+    SetSampledControl(indices.ysize(), fold.SampleWeights, rand);
     dstBlocks.CreateByControl(blockParams, Control, localExecutor);
 
     DocCount = dstBlocks.Total;
     ClearBodyTail();
     BodyTailCount = fold.BodyTailArr.ysize();
-    LearnQueriesInfo = &fold.LearnQueriesInfo;
+    if (IsPairwiseScoring && HasZeroWeightDocs) {
+        // The querywise bootstrap drops whole queries, so the gathered documents are still a
+        // concatenation of complete queries; renumber the query bounds to the compacted
+        // positions (competitor ids are query-local and stay valid).
+        SampledQueriesInfo.clear();
+        int offset = 0;
+        for (const auto& queryInfo : fold.LearnQueriesInfo) {
+            if (!Control[queryInfo.Begin]) {
+                continue;
+            }
+            SampledQueriesInfo.push_back(queryInfo);
+            SampledQueriesInfo.back().Begin = offset;
+            offset += queryInfo.End - queryInfo.Begin;
+            SampledQueriesInfo.back().End = offset;
+        }
+        LearnQueriesInfo = &SampledQueriesInfo;
+    } else {
+        LearnQueriesInfo = &fold.LearnQueriesInfo;
+    }
     localExecutor->ExecRange([&](int blockIdx) {
         const auto srcBlock = srcBlocks.Slices[blockIdx];
         const auto srcControlRef = srcBlock.GetConstRef(Control);
@@ -218,7 +317,7 @@ void TCalcScoreFold::Sample(const TFold& fold, const TVector<TIndexType>& indice
         SetElements(srcControlRef, srcBlock.GetConstRef(TVector<size_t>()), [=](const size_t*, size_t j) { return srcBlock.Offset + j; }, dstBlock.GetRef(IndexInFold), &ignored);
         SelectBlockFromFold(fold, srcBlock, dstBlock);
     }, 0, blockCount, NPar::TLocalExecutor::WAIT_COMPLETE);
-    PermutationBlockSize = (BernoulliSampleRate == 1.0f || IsPairwiseScoring) ? fold.PermutationBlockSize : FoldPermutationBlockSizeNotSet;
+    PermutationBlockSize = ((BernoulliSampleRate == 1.0f || IsPairwiseScoring) && !HasZeroWeightDocs) ? fold.PermutationBlockSize : FoldPermutationBlockSizeNotSet;
 }
 
 void TCalcScoreFold::UpdateIndices(const TVector<TIndexType>& indices, NPar::TLocalExecutor* localExecutor) {
@@ -229,7 +328,7 @@ void TCalcScoreFold::UpdateIndices(const TVector<TIndexType>& indices, NPar::TLo
     srcBlocks.Create(blockParams);
 
     TVectorSlicing dstBlocks;
-    if (BernoulliSampleRate < 1.0f && !IsPairwiseScoring) {
+    if ((BernoulliSampleRate < 1.0f && !IsPairwiseScoring) || HasZeroWeightDocs) {
         dstBlocks.CreateByControl(blockParams, Control, localExecutor);
     } else {
         dstBlocks = srcBlocks;
@@ -293,12 +392,29 @@ void TCalcScoreFold::SetSmallestSideControl(int curDepth, int docCount, const TU
     }
 }
 
-void TCalcScoreFold::SetSampledControl(int docCount, TRestorableFastRng64* rand) {
+void TCalcScoreFold::SetSampledControl(int docCount, const TVector<float>& sampleWeights, TRestorableFastRng64* rand) {
+    HasZeroWeightDocs = false;
     if (BernoulliSampleRate == 1.0f || IsPairwiseScoring) {
+        // For pairwise scoring the per-document Bernoulli draw is skipped: the querywise
+        // bootstrap makes the keep-or-drop decision per query and encodes it in the sample
+        // weights, which the zero-weight pass below turns into the control mask.
         Fill(Control.begin(), Control.end(), true);
+    } else {
+        for (int docIdx = 0; docIdx < docCount; ++docIdx) {
+            Control[docIdx] = rand->GenRandReal1() < BernoulliSampleRate;
+        }
+    }
+    if (sampleWeights.empty()) {
         return;
     }
+    // A zero-weight document contributes zero to every weighted bucket statistic, so it can be
+    // dropped from the gathered fold and the hot loops skip it entirely. Sample weights already
+    // combine the bootstrap weights with the learn weights, so this also drops the documents
+    // discarded by the bootstrap (e.g. the small-gradient part left out by GOSS).
     for (int docIdx = 0; docIdx < docCount; ++docIdx) {
-        Control[docIdx] = rand->GenRandReal1() < BernoulliSampleRate;
+        if (Control[docIdx] && sampleWeights[docIdx] == 0.0f) {
+            Control[docIdx] = false;
+            HasZeroWeightDocs = true;
+        }
     }
 }
@@ -57,7 +57,9 @@ struct TBucketStats {
         SumWeight -= other.SumWeight;
         Count -= other.Count;
     }
-    SAVELOAD(SumWeightedDelta, SumWeight, SumDelta, Count);
+    // No custom binsaver serializer on purpose: the struct is trivially copyable, so
+    // TVector<TBucketStats> (the distributed score payload) is sent as one raw chunk
+    // instead of element by element; the wire bytes are identical either way.
 };
 
 static_assert(std::is_pod<TBucketStats>::value, "TBucketStats must be pod to avoid memory initialization in yresize");
@@ -84,6 +86,10 @@ struct TBucketStatsCache {
     }
     TVector<TBucketStats, TPoolAllocator>& GetStats(const TSplitCandidate& split, int statsCount, bool* areStatsDirty);
     void GarbageCollect();
+    // Drop all cached stats and release the pool memory; stats are recomputed
+    // on demand. Used for eviction under memory pressure.
+    void Reset();
+    size_t GetBytesUsed();
 private:
     THolder<TMemoryPool> MemoryPool;
     TAdaptiveLock Lock;
@@ -100,6 +106,12 @@ struct TCalcScoreFold {
     struct TBodyTail {
         TUnsizedVector<TUnsizedVector<double>> WeightedDerivatives;
         TUnsizedVector<TUnsizedVector<double>> SampleWeightedDerivatives;
+        // Filled instead of the double vectors when the fold was created in single precision
+        // mode: the gathered derivative copies are streamed by the score kernels, so storing
+        // them as float halves the memory and bandwidth of the split search. The bucket
+        // statistics still accumulate in double.
+        TUnsizedVector<TUnsizedVector<float>> WeightedDerivativesFloat;
+        TUnsizedVector<TUnsizedVector<float>> SampleWeightedDerivativesFloat;
         TUnsizedVector<float> PairwiseWeights;
         TUnsizedVector<float> SamplePairwiseWeights;
 
@@ -144,7 +156,7 @@ struct TCalcScoreFold {
     bool SmallestSplitSideValue;
     int PermutationBlockSize = FoldPermutationBlockSizeNotSet;
 
-    void Create(const TVector<TFold>& folds, bool isPairwiseScoring, float sampleRate = 1.0f);
+    void Create(const TVector<TFold>& folds, bool isPairwiseScoring, float sampleRate = 1.0f, bool singlePrecisionDerivatives = false);
     void SelectSmallestSplitSide(int curDepth, const TCalcScoreFold& fold, NPar::TLocalExecutor* localExecutor);
     void Sample(const TFold& fold, const TVector<TIndexType>& indices, TRestorableFastRng64* rand, NPar::TLocalExecutor* localExecutor);
     void UpdateIndices(const TVector<TIndexType>& indices, NPar::TLocalExecutor* localExecutor);
@@ -152,6 +164,8 @@ struct TCalcScoreFold {
     int GetBodyTailCount() const;
     int GetApproxDimension() const;
     const TVector<float>& GetLearnWeights() const { return LearnWeights; }
+    bool HasSinglePrecisionDerivatives() const { return SinglePrecisionDerivatives; }
+    bool HasTrivialSampleWeights() const { return TrivialSampleWeights; }
 
 private:
     inline void ClearBodyTail() {
@@ -163,8 +177,16 @@ private:
     template<typename TFoldType>
     void SelectBlockFromFold(const TFoldType& fold, TSlice srcBlock, TSlice dstBlock);
     void SetSmallestSideControl(int curDepth, int docCount, const TUnsizedVector<TIndexType>& indices, NPar::TLocalExecutor* localExecutor);
-    void SetSampledControl(int docCount, TRestorableFastRng64* rand);
+    void SetSampledControl(int docCount, const TVector<float>& sampleWeights, TRestorableFastRng64* rand);
+    // Query bounds renumbered to the compacted document positions when the querywise
+    // bootstrap dropped whole queries; LearnQueriesInfo points here in that case.
+    TVector<TQueryInfo> SampledQueriesInfo;
     TUnsizedVector<bool> Control;
+    bool SinglePrecisionDerivatives = false;
+    // True when the gathered SampleWeights are known to be all ones (see
+    // TFold::SampleWeightsAreTrivial); selects the unweighted histogram kernels.
+    bool TrivialSampleWeights = false;
+    bool HasZeroWeightDocs;
     int DocCount;
     int BodyTailCount;
     int ApproxDimension;
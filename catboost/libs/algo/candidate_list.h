@@ -0,0 +1,32 @@
+#pragma once
+
+#include "split.h"
+#include "rand_score.h"
+
+#include <util/generic/vector.h>
+
+#include <library/binsaver/bin_saver.h>
+
+struct TCandidateInfo {
+    TSplitCandidate SplitCandidate;
+    TRandomScore BestScore;
+    int BestBinBorderId = -1;
+    bool ShouldDropAfterScoreCalc = false;
+    SAVELOAD(SplitCandidate, BestScore, BestBinBorderId, ShouldDropAfterScoreCalc);
+};
+
+struct TCandidatesInfoList {
+    TCandidatesInfoList() = default;
+    explicit TCandidatesInfoList(const TCandidateInfo& oneCandidate) {
+        Candidates.emplace_back(oneCandidate);
+    }
+    // All candidates here are either float or one-hot, or have the same
+    // projection.
+    // TODO(annaveronika): put projection out, because currently it's not clear.
+    TVector<TCandidateInfo> Candidates;
+    bool ShouldDropCtrAfterCalc = false;
+
+    SAVELOAD(Candidates, ShouldDropCtrAfterCalc);
+};
+
+using TCandidateList = TVector<TCandidatesInfoList>;
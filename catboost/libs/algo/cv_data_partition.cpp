@@ -25,14 +25,11 @@ void BuildCvPools(
     CB_ENSURE(foldIdx >= 0 && foldIdx < foldCount);
     CB_ENSURE(learnPool->Docs.GetDocCount() > 1, "Not enough documents for cross validataion");
 
-    TRestorableFastRng64 rand(seed);
-    TVector<ui64> permutation;
-    permutation.yresize(learnPool->Docs.GetDocCount());
-    std::iota(permutation.begin(), permutation.end(), /*starting value*/ 0);
-    Shuffle(learnPool->Docs.QueryId, rand, &permutation);
     NPar::TLocalExecutor localExecutor;
     localExecutor.RunAdditionalThreads(threadCount - 1);
-    ApplyPermutation(InvertPermutation(permutation), learnPool, &localExecutor);
+    //same group-preserving shuffle as the load-time one (--learn-shuffle-seed), so fold
+    //assignment stays unbiased for query-sorted inputs with or without a shuffle on load
+    ShufflePool(seed, learnPool, &localExecutor);
     testPool->CatFeatures = learnPool->CatFeatures;
 
     foldIdx = foldIdx % foldCount;
@@ -69,6 +66,15 @@ void BuildCvPools(
     bool hasSubgroupId = !allDocs.SubgroupId.empty();
     learnPool->Docs.Resize(learnCount, allDocs.GetEffectiveFactorCount(), allDocs.GetBaselineDimension(), hasQueryId, hasSubgroupId);
     testPool->Docs.Resize(testCount, allDocs.GetEffectiveFactorCount(), allDocs.GetBaselineDimension(), hasQueryId, hasSubgroupId);
+    // keep factors that were ignored on load empty in the fold pools as well
+    for (int factorIdx = 0; factorIdx < allDocs.Factors.ysize(); ++factorIdx) {
+        if (allDocs.Factors[factorIdx].empty()) {
+            learnPool->Docs.Factors[factorIdx].clear();
+            learnPool->Docs.Factors[factorIdx].shrink_to_fit();
+            testPool->Docs.Factors[factorIdx].clear();
+            testPool->Docs.Factors[factorIdx].shrink_to_fit();
+        }
+    }
 
     size_t learnIdx = 0;
     size_t testIdx = 0;
@@ -93,8 +99,35 @@ void BuildCvPools(
     ApplyPermutationToPairs(InvertPermutation(learnPermutation), &learnPool->Pairs);
     ApplyPermutationToPairs(InvertPermutation(testPermutation), &testPool->Pairs);
 
+    if (learnPool->IsQuantized()) {
+        // quantized bin columns are split between the fold pools like raw factor columns
+        TVector<TVector<ui8>> allBins;
+        allBins.swap(learnPool->QuantizedFeatures);
+        learnPool->QuantizedFeatures.resize(allBins.size());
+        testPool->QuantizedFeatures.resize(allBins.size());
+        for (size_t featureIdx = 0; featureIdx < allBins.size(); ++featureIdx) {
+            const TVector<ui8>& bins = allBins[featureIdx];
+            if (bins.empty()) {
+                continue;
+            }
+            TVector<ui8>& learnBins = learnPool->QuantizedFeatures[featureIdx];
+            TVector<ui8>& testBins = testPool->QuantizedFeatures[featureIdx];
+            learnBins.yresize(learnIdx);
+            for (size_t i = 0; i < learnIdx; ++i) {
+                learnBins[i] = bins[learnPermutation[i]];
+            }
+            testBins.yresize(testIdx);
+            for (size_t i = 0; i < testIdx; ++i) {
+                testBins[i] = bins[testPermutation[i]];
+            }
+        }
+        testPool->QuantizationBorders = learnPool->QuantizationBorders;
+        testPool->QuantizationNanModes = learnPool->QuantizationNanModes;
+    }
+
     if (reverseCv) {
         learnPool->Docs.Swap(testPool->Docs);
+        learnPool->QuantizedFeatures.swap(testPool->QuantizedFeatures);
     }
     MATRIXNET_INFO_LOG << "Learn docs: " << learnPool->Docs.GetDocCount()
         << ", test docs: " << testPool->Docs.GetDocCount() << Endl;
@@ -92,6 +92,144 @@ void TCrossEntropyError::CalcDersRange(
     }
 }
 
+void TRMSEError::CalcFirstDerRange(
+     int start,
+     int count,
+     const double* __restrict approxes,
+     const double* __restrict approxDeltas,
+     const float* __restrict targets,
+     const float* __restrict weights,
+     double* __restrict ders
+) const {
+    if (approxDeltas != nullptr) {
+#pragma clang loop vectorize_width(4) interleave_count(2)
+        for (int i = start; i < start + count; ++i) {
+            ders[i] = targets[i] - (approxes[i] + approxDeltas[i]);
+        }
+    } else {
+#pragma clang loop vectorize_width(4) interleave_count(2)
+        for (int i = start; i < start + count; ++i) {
+            ders[i] = targets[i] - approxes[i];
+        }
+    }
+    if (weights != nullptr) {
+#pragma clang loop vectorize_width(4) interleave_count(2)
+        for (int i = start; i < start + count; ++i) {
+            ders[i] *= weights[i];
+        }
+    }
+}
+
+void TRMSEError::CalcDersRange(
+    int start,
+    int count,
+    bool calcThirdDer,
+    const double* __restrict approxes,
+    const double* __restrict approxDeltas,
+    const float* __restrict targets,
+    const float* __restrict weights,
+    TDers* __restrict ders
+) const {
+    if (approxDeltas != nullptr) {
+#pragma clang loop vectorize_width(4) interleave_count(2)
+        for (int i = start; i < start + count; ++i) {
+            ders[i].Der1 = targets[i] - (approxes[i] + approxDeltas[i]);
+            ders[i].Der2 = RMSE_DER2;
+        }
+    } else {
+#pragma clang loop vectorize_width(4) interleave_count(2)
+        for (int i = start; i < start + count; ++i) {
+            ders[i].Der1 = targets[i] - approxes[i];
+            ders[i].Der2 = RMSE_DER2;
+        }
+    }
+    if (calcThirdDer) {
+        for (int i = start; i < start + count; ++i) {
+            ders[i].Der3 = RMSE_DER3;
+        }
+    }
+    if (weights != nullptr) {
+#pragma clang loop vectorize_width(8) interleave_count(2)
+        for (int i = start; i < start + count; ++i) {
+            ders[i].Der1 *= weights[i];
+            ders[i].Der2 *= weights[i];
+            if (calcThirdDer) {
+                ders[i].Der3 *= weights[i];
+            }
+        }
+    }
+}
+
+void TQuantileError::CalcFirstDerRange(
+     int start,
+     int count,
+     const double* __restrict approxes,
+     const double* __restrict approxDeltas,
+     const float* __restrict targets,
+     const float* __restrict weights,
+     double* __restrict ders
+) const {
+    const double alpha = Alpha;
+    if (approxDeltas != nullptr) {
+#pragma clang loop vectorize_width(4) interleave_count(2)
+        for (int i = start; i < start + count; ++i) {
+            ders[i] = (targets[i] - (approxes[i] + approxDeltas[i]) > 0) ? alpha : alpha - 1;
+        }
+    } else {
+#pragma clang loop vectorize_width(4) interleave_count(2)
+        for (int i = start; i < start + count; ++i) {
+            ders[i] = (targets[i] - approxes[i] > 0) ? alpha : alpha - 1;
+        }
+    }
+    if (weights != nullptr) {
+#pragma clang loop vectorize_width(4) interleave_count(2)
+        for (int i = start; i < start + count; ++i) {
+            ders[i] *= weights[i];
+        }
+    }
+}
+
+void TQuantileError::CalcDersRange(
+    int start,
+    int count,
+    bool calcThirdDer,
+    const double* __restrict approxes,
+    const double* __restrict approxDeltas,
+    const float* __restrict targets,
+    const float* __restrict weights,
+    TDers* __restrict ders
+) const {
+    const double alpha = Alpha;
+    if (approxDeltas != nullptr) {
+#pragma clang loop vectorize_width(4) interleave_count(2)
+        for (int i = start; i < start + count; ++i) {
+            ders[i].Der1 = (targets[i] - (approxes[i] + approxDeltas[i]) > 0) ? alpha : alpha - 1;
+            ders[i].Der2 = QUANTILE_DER2_AND_DER3;
+        }
+    } else {
+#pragma clang loop vectorize_width(4) interleave_count(2)
+        for (int i = start; i < start + count; ++i) {
+            ders[i].Der1 = (targets[i] - approxes[i] > 0) ? alpha : alpha - 1;
+            ders[i].Der2 = QUANTILE_DER2_AND_DER3;
+        }
+    }
+    if (calcThirdDer) {
+        for (int i = start; i < start + count; ++i) {
+            ders[i].Der3 = QUANTILE_DER2_AND_DER3;
+        }
+    }
+    if (weights != nullptr) {
+#pragma clang loop vectorize_width(8) interleave_count(2)
+        for (int i = start; i < start + count; ++i) {
+            ders[i].Der1 *= weights[i];
+            ders[i].Der2 *= weights[i];
+            if (calcThirdDer) {
+                ders[i].Der3 *= weights[i];
+            }
+        }
+    }
+}
+
 void CheckDerivativeOrderForTrain(ui32 derivativeOrder, ELeavesEstimation estimationMethod) {
     if (estimationMethod == ELeavesEstimation::Newton) {
         CB_ENSURE(derivativeOrder >= 2, "Current error function doesn't support Newton leaves estimation method");
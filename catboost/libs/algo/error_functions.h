@@ -222,6 +222,27 @@ public:
     double CalcDer3(double /*approx*/, float /*target*/) const {
         return RMSE_DER3;
     }
+
+    void CalcFirstDerRange(
+        int start,
+        int count,
+        const double* approxes,
+        const double* approxDeltas,
+        const float* targets,
+        const float* weights,
+        double* ders
+    ) const;
+
+    void CalcDersRange(
+        int start,
+        int count,
+        bool calcThirdDer,
+        const double* approxes,
+        const double* approxDeltas,
+        const float* targets,
+        const float* weights,
+        TDers* ders
+    ) const;
 };
 
 class TQuantileError : public IDerCalcer<TQuantileError, /*StoreExpApproxParam*/ false> {
@@ -255,6 +276,27 @@ public:
     double CalcDer3(double /*approx*/, float /*target*/) const {
         return QUANTILE_DER2_AND_DER3;
     }
+
+    void CalcFirstDerRange(
+        int start,
+        int count,
+        const double* approxes,
+        const double* approxDeltas,
+        const float* targets,
+        const float* weights,
+        double* ders
+    ) const;
+
+    void CalcDersRange(
+        int start,
+        int count,
+        bool calcThirdDer,
+        const double* approxes,
+        const double* approxDeltas,
+        const float* targets,
+        const float* weights,
+        TDers* ders
+    ) const;
 };
 
 class TLogLinQuantileError : public IDerCalcer<TLogLinQuantileError, /*StoreExpApproxParam*/ true> {
@@ -434,10 +476,10 @@ public:
     ) const {
         int approxDimension = approx.ysize();
 
-        TVector<double> prob(approxDimension);
+        TVector<double> prob(approx);
+        FastExpInplace(prob.data(), prob.ysize());
         for (int dim = 0; dim < approxDimension; ++dim) {
-            double expApprox = exp(approx[dim]);
-            prob[dim] = expApprox / (1 + expApprox);
+            prob[dim] = prob[dim] / (1 + prob[dim]);
             (*der)[dim] = -prob[dim];
         }
         int targetClass = static_cast<int>(target);
@@ -566,12 +608,21 @@ public:
             const int querySize = end - begin;
 
             const double queryAvrg = CalcQueryAvrg(begin, querySize, approxes, targets, weights);
-            for (int docId = begin; docId < end; ++docId) {
-                (*ders)[docId - start].Der1 = targets[docId] - approxes[docId] - queryAvrg;
-                (*ders)[docId - start].Der2 = -1;
-                if (!weights.empty()) {
-                    (*ders)[docId - start].Der1 *= weights[docId];
-                    (*ders)[docId - start].Der2 *= weights[docId];
+            const double* approxesData = approxes.data();
+            const float* targetsData = targets.data();
+            TDers* dersData = ders->data() - start;
+            if (weights.empty()) {
+#pragma clang loop vectorize_width(4) interleave_count(2)
+                for (int docId = begin; docId < end; ++docId) {
+                    dersData[docId].Der1 = targetsData[docId] - approxesData[docId] - queryAvrg;
+                    dersData[docId].Der2 = -1;
+                }
+            } else {
+                const float* weightsData = weights.data();
+#pragma clang loop vectorize_width(4) interleave_count(2)
+                for (int docId = begin; docId < end; ++docId) {
+                    dersData[docId].Der1 = (targetsData[docId] - approxesData[docId] - queryAvrg) * weightsData[docId];
+                    dersData[docId].Der2 = -1.0 * weightsData[docId];
                 }
             }
         }
@@ -0,0 +1,178 @@
+#include "feature_bundling.h"
+
+#include <catboost/libs/logging/logging.h>
+
+#include <util/generic/algorithm.h>
+#include <util/generic/utility.h>
+#include <util/generic/xrange.h>
+
+// A feature is a bundling candidate only when its default bin covers most documents.
+static const double MinDefaultBinFraction = 0.9;
+// How many existing bundles a feature may probe before opening a new one.
+static const int MaxBundleProbeCount = 10;
+
+namespace {
+    struct TFeatureBinStats {
+        int DefaultBin = 0;
+        int BinCount = 0; // max used bin + 1
+        size_t NonDefaultCount = 0;
+    };
+
+    /// Bundle under construction; Bins already holds the encoded member bins.
+    struct TBundleBuilder {
+        TVector<ui8> Bins;
+        TVector<int> Features;
+        TVector<TFeatureBundleRef> Refs; // [idx in Features]
+        int UsedBinCount = 1; // bin 0 is reserved for "all members are default"
+    };
+}
+
+static TFeatureBinStats CalcFeatureBinStats(const TVector<ui8>& hist) {
+    size_t binCounts[256] = {};
+    for (ui8 bin : hist) {
+        ++binCounts[bin];
+    }
+    TFeatureBinStats stats;
+    for (int bin = 0; bin < 256; ++bin) {
+        if (binCounts[bin] > 0) {
+            stats.BinCount = bin + 1;
+        }
+        if (binCounts[bin] > binCounts[stats.DefaultBin]) {
+            stats.DefaultBin = bin;
+        }
+    }
+    stats.NonDefaultCount = hist.size() - binCounts[stats.DefaultBin];
+    return stats;
+}
+
+static bool HasConflicts(const TVector<ui8>& hist,
+                         ui8 defaultBin,
+                         const TVector<ui8>& bundleBins,
+                         NPar::TLocalExecutor& localExecutor) {
+    NPar::TLocalExecutor::TExecRangeParams blockParams(0, hist.ysize());
+    blockParams.SetBlockSize(10000);
+    TVector<ui8> blockHasConflict(blockParams.GetBlockCount(), 0);
+    localExecutor.ExecRange([&](int blockIdx) {
+        const int blockStart = blockIdx * blockParams.GetBlockSize();
+        const int nextBlockStart = Min<int>(blockStart + blockParams.GetBlockSize(), blockParams.LastId);
+        for (int doc = blockStart; doc < nextBlockStart; ++doc) {
+            if (bundleBins[doc] != 0 && hist[doc] != defaultBin) {
+                blockHasConflict[blockIdx] = 1;
+                return;
+            }
+        }
+    }, 0, blockParams.GetBlockCount(), NPar::TLocalExecutor::WAIT_COMPLETE);
+    return Find(blockHasConflict.begin(), blockHasConflict.end(), 1) != blockHasConflict.end();
+}
+
+static void AddFeatureToBundle(const TVector<ui8>& hist,
+                               const TFeatureBinStats& stats,
+                               int featureIdx,
+                               NPar::TLocalExecutor& localExecutor,
+                               TBundleBuilder* bundle) {
+    TFeatureBundleRef ref;
+    ref.BinOffset = bundle->UsedBinCount - 1;
+    ref.BinCount = stats.BinCount;
+    ref.DefaultBin = stats.DefaultBin;
+
+    const ui8 defaultBin = stats.DefaultBin;
+    ui8* bundleBins = bundle->Bins.data();
+    const ui8* histData = hist.data();
+    localExecutor.ExecRange([=](int doc) {
+        const ui8 bin = histData[doc];
+        if (bin != defaultBin) {
+            const int nonDefaultIdx = bin < defaultBin ? bin : bin - 1;
+            bundleBins[doc] = static_cast<ui8>(ref.BinOffset + 1 + nonDefaultIdx);
+        }
+    }
+    , NPar::TLocalExecutor::TExecRangeParams(0, hist.ysize()).SetBlockSize(10000)
+    , NPar::TLocalExecutor::WAIT_COMPLETE);
+
+    bundle->Features.push_back(featureIdx);
+    bundle->Refs.push_back(ref);
+    bundle->UsedBinCount += stats.BinCount - 1;
+}
+
+void BuildExclusiveFeatureBundles(NPar::TLocalExecutor& localExecutor, TAllFeatures* features) {
+    const int floatFeatureCount = features->FloatHistograms.ysize();
+    const size_t docCount = features->GetDocCount();
+    if (floatFeatureCount == 0 || docCount == 0) {
+        return;
+    }
+
+    TVector<TFeatureBinStats> binStats(floatFeatureCount);
+    localExecutor.ExecRange([&](int featureIdx) {
+        if (!features->FloatHistograms[featureIdx].empty()) {
+            binStats[featureIdx] = CalcFeatureBinStats(features->FloatHistograms[featureIdx]);
+        }
+    }, 0, floatFeatureCount, NPar::TLocalExecutor::WAIT_COMPLETE);
+
+    TVector<int> candidates;
+    for (int featureIdx : xrange(floatFeatureCount)) {
+        const auto& stats = binStats[featureIdx];
+        if (features->FloatHistograms[featureIdx].empty() || stats.BinCount < 2) {
+            continue;
+        }
+        if (docCount - stats.NonDefaultCount >= MinDefaultBinFraction * docCount) {
+            candidates.push_back(featureIdx);
+        }
+    }
+    if (candidates.ysize() < 2) {
+        return;
+    }
+    // Place the densest candidates first so they do not end up in single-feature bundles.
+    StableSort(candidates.begin(), candidates.end(), [&](int left, int right) {
+        return binStats[left].NonDefaultCount > binStats[right].NonDefaultCount;
+    });
+
+    TVector<TBundleBuilder> bundles;
+    for (int featureIdx : candidates) {
+        const auto& hist = features->FloatHistograms[featureIdx];
+        const auto& stats = binStats[featureIdx];
+        TBundleBuilder* target = nullptr;
+        int probeCount = 0;
+        for (auto& bundle : bundles) {
+            if (probeCount >= MaxBundleProbeCount) {
+                break;
+            }
+            if (bundle.UsedBinCount + stats.BinCount - 1 > 256) {
+                continue;
+            }
+            ++probeCount;
+            if (!HasConflicts(hist, stats.DefaultBin, bundle.Bins, localExecutor)) {
+                target = &bundle;
+                break;
+            }
+        }
+        if (target == nullptr) {
+            bundles.emplace_back();
+            target = &bundles.back();
+            target->Bins.resize(docCount, 0);
+        }
+        AddFeatureToBundle(hist, stats, featureIdx, localExecutor, target);
+    }
+
+    int bundledFeatureCount = 0;
+    for (auto& bundle : bundles) {
+        if (bundle.Features.ysize() < 2) {
+            continue; // a single-feature bundle is pure overhead, keep the plain column
+        }
+        const int bundleIdx = features->FeatureBundles.ysize();
+        features->FloatFeatureBundleRefs.resize(floatFeatureCount);
+        for (int memberIdx : xrange(bundle.Features.ysize())) {
+            const int featureIdx = bundle.Features[memberIdx];
+            bundle.Refs[memberIdx].BundleIdx = bundleIdx;
+            features->FloatFeatureBundleRefs[featureIdx] = bundle.Refs[memberIdx];
+            TVector<ui8>().swap(features->FloatHistograms[featureIdx]);
+            ++bundledFeatureCount;
+        }
+        TExclusiveFeatureBundle packedBundle;
+        packedBundle.Bins = std::move(bundle.Bins);
+        packedBundle.FloatFeatures = std::move(bundle.Features);
+        features->FeatureBundles.push_back(std::move(packedBundle));
+    }
+    if (bundledFeatureCount > 0) {
+        MATRIXNET_INFO_LOG << "Packed " << bundledFeatureCount << " mutually exclusive float features into "
+            << features->FeatureBundles.size() << " feature bundles" << Endl;
+    }
+}
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <catboost/libs/data/quantized_features.h>
+
+#include <library/threading/local_executor/local_executor.h>
+
+/*
+ * Pack mutually exclusive binarized float features into shared bundle columns.
+ * A feature joins a bundle only when its non-default bins never collide with the
+ * other members, so unbundled bins are restored exactly and results do not change.
+ * Columns of bundled features are freed; readers go through GetBundledBin.
+ */
+void BuildExclusiveFeatureBundles(NPar::TLocalExecutor& localExecutor, TAllFeatures* features);
@@ -0,0 +1,99 @@
+#include "feature_packing.h"
+
+#include <catboost/libs/logging/logging.h>
+
+#include <util/generic/xrange.h>
+
+static int CalcRequiredBitWidth(const TVector<ui8>& hist) {
+    ui8 maxBin = 0;
+    for (ui8 bin : hist) {
+        maxBin = Max(maxBin, bin);
+    }
+    if (maxBin <= 1) {
+        return 1;
+    }
+    if (maxBin <= 3) {
+        return 2;
+    }
+    if (maxBin <= 15) {
+        return 4;
+    }
+    return 0; // needs the full byte, not a packing candidate
+}
+
+static TPackedFeatureGroup PackGroup(const TAllFeatures& features,
+                                     const TVector<int>& groupFeatures,
+                                     int bitWidth,
+                                     size_t docCount,
+                                     NPar::TLocalExecutor& localExecutor) {
+    TPackedFeatureGroup group;
+    group.FloatFeatures = groupFeatures;
+    group.Bins.resize(docCount, 0);
+
+    ui8* groupBins = group.Bins.data();
+    const int memberCount = groupFeatures.ysize();
+    const ui8* memberHists[8];
+    for (int memberIdx : xrange(memberCount)) {
+        memberHists[memberIdx] = features.FloatHistograms[groupFeatures[memberIdx]].data();
+    }
+    localExecutor.ExecRange([=](int doc) {
+        ui8 packedBins = 0;
+        for (int memberIdx = 0; memberIdx < memberCount; ++memberIdx) {
+            packedBins |= memberHists[memberIdx][doc] << (memberIdx * bitWidth);
+        }
+        groupBins[doc] = packedBins;
+    }
+    , NPar::TLocalExecutor::TExecRangeParams(0, group.Bins.ysize()).SetBlockSize(10000)
+    , NPar::TLocalExecutor::WAIT_COMPLETE);
+
+    return group;
+}
+
+void PackLowCardinalityFeatures(NPar::TLocalExecutor& localExecutor, TAllFeatures* features) {
+    const int floatFeatureCount = features->FloatHistograms.ysize();
+    const size_t docCount = features->GetDocCount();
+    if (floatFeatureCount == 0 || docCount == 0) {
+        return;
+    }
+
+    TVector<int> bitWidths(floatFeatureCount, 0);
+    localExecutor.ExecRange([&](int featureIdx) {
+        if (!features->FloatHistograms[featureIdx].empty()) {
+            bitWidths[featureIdx] = CalcRequiredBitWidth(features->FloatHistograms[featureIdx]);
+        }
+    }, 0, floatFeatureCount, NPar::TLocalExecutor::WAIT_COMPLETE);
+
+    int packedFeatureCount = 0;
+    for (int bitWidth : {1, 2, 4}) {
+        TVector<int> candidates;
+        for (int featureIdx : xrange(floatFeatureCount)) {
+            if (bitWidths[featureIdx] == bitWidth) {
+                candidates.push_back(featureIdx);
+            }
+        }
+        const int groupCapacity = 8 / bitWidth;
+        for (int groupStart = 0; groupStart < candidates.ysize(); groupStart += groupCapacity) {
+            const int groupSize = Min(groupCapacity, candidates.ysize() - groupStart);
+            if (groupSize < 2) {
+                break; // a lone feature occupies a full byte either way, keep the plain column
+            }
+            const TVector<int> groupFeatures(candidates.begin() + groupStart, candidates.begin() + groupStart + groupSize);
+            const int packIdx = features->FeaturePacks.ysize();
+            features->FeaturePacks.push_back(PackGroup(*features, groupFeatures, bitWidth, docCount, localExecutor));
+            features->FloatFeaturePackRefs.resize(floatFeatureCount);
+            for (int memberIdx : xrange(groupSize)) {
+                const int featureIdx = groupFeatures[memberIdx];
+                TFeaturePackRef& ref = features->FloatFeaturePackRefs[featureIdx];
+                ref.PackIdx = packIdx;
+                ref.BitOffset = memberIdx * bitWidth;
+                ref.BitWidth = bitWidth;
+                TVector<ui8>().swap(features->FloatHistograms[featureIdx]);
+                ++packedFeatureCount;
+            }
+        }
+    }
+    if (packedFeatureCount > 0) {
+        MATRIXNET_INFO_LOG << "Packed " << packedFeatureCount << " low-cardinality float features into "
+            << features->FeaturePacks.size() << " bit-packed columns" << Endl;
+    }
+}
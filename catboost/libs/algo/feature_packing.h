@@ -0,0 +1,12 @@
+#pragma once
+
+#include <catboost/libs/data/quantized_features.h>
+
+#include <library/threading/local_executor/local_executor.h>
+
+/*
+ * Pack low-cardinality binarized float features into shared bit-packed columns.
+ * Features needing 1, 2 or 4 bits (at most 2, 4 or 16 bins) are grouped by bit width,
+ * so a single byte per document holds 8, 4 or 2 of them. Readers go through GetPackedBin.
+ */
+void PackLowCardinalityFeatures(NPar::TLocalExecutor& localExecutor, TAllFeatures* features);
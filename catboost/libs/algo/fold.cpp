@@ -4,8 +4,12 @@
 #include <catboost/libs/data/dataset.h>
 #include <catboost/libs/data_types/groupid.h>
 #include <catboost/libs/helpers/permutation.h>
+#include <catboost/libs/helpers/pod_serialization.h>
 #include <catboost/libs/helpers/query_info_helper.h>
 #include <catboost/libs/helpers/restorable_rng.h>
+#include <catboost/libs/logging/logging.h>
+
+#include <util/generic/algorithm.h>
 
 static int UpdateSize(int size, const TVector<TQueryInfo>& queryInfo, const TVector<int>& queryIndices, int learnSampleCount) {
     size = Min(size, learnSampleCount);
@@ -145,8 +149,11 @@ TFold TFold::BuildDynamicFold(
         bt.WeightedDerivatives.resize(approxDimension, TVector<double>(bt.TailFinish));
         bt.SampleWeightedDerivatives.resize(approxDimension, TVector<double>(bt.TailFinish));
         if (hasPairwiseWeights) {
-            bt.PairwiseWeights.resize(bt.TailFinish);
-            bt.PairwiseWeights.insert(bt.PairwiseWeights.begin(), pairwiseWeights.begin(), pairwiseWeights.begin() + bt.TailFinish);
+            // Pairwise weights are permutation-level, so every body tail needs just the
+            // prefix of the shared fold-level array (resize + insert used to leave the
+            // old zero-filled elements behind the copied prefix, doubling the allocation).
+            bt.PairwiseWeights.yresize(bt.TailFinish);
+            Copy(pairwiseWeights.begin(), pairwiseWeights.begin() + bt.TailFinish, bt.PairwiseWeights.begin());
             bt.SamplePairwiseWeights.resize(bt.TailFinish);
         }
         ff.BodyTailArr.emplace_back(std::move(bt));
@@ -243,6 +250,83 @@ void TFold::DropEmptyCTRs() {
     }
 }
 
+size_t TFold::EstimateBytesUsed() const {
+    size_t bytes = LearnQueriesInfo.capacity() * sizeof(TQueryInfo)
+        + LearnPermutation.capacity() * sizeof(size_t)
+        + (LearnTarget.capacity() + SampleWeights.capacity() + LearnWeights.capacity()) * sizeof(float)
+        + TargetClassesCount.capacity() * sizeof(int);
+    for (const auto& targetClass : LearnTargetClass) {
+        bytes += targetClass.capacity() * sizeof(int);
+    }
+    for (const auto& bt : BodyTailArr) {
+        for (const auto& arr : {&bt.Approx, &bt.WeightedDerivatives, &bt.SampleWeightedDerivatives}) {
+            for (const auto& dim : *arr) {
+                bytes += dim.capacity() * sizeof(double);
+            }
+        }
+        bytes += (bt.PairwiseWeights.capacity() + bt.SamplePairwiseWeights.capacity()) * sizeof(float);
+    }
+    return bytes;
+}
+
+static size_t EstimateCtrBytes(const TOnlineCTR& ctr) {
+    size_t bytes = 0;
+    for (const auto& feature : ctr.Feature) {
+        for (size_t y = 0; y < feature.GetYSize(); ++y) {
+            for (size_t x = 0; x < feature.GetXSize(); ++x) {
+                bytes += feature[y][x].capacity() * sizeof(ui8);
+            }
+        }
+    }
+    return bytes;
+}
+
+static size_t EstimateCtrHashBytesUsed(const TOnlineCTRHash& ctrs) {
+    size_t bytes = 0;
+    for (const auto& projCtr : ctrs) {
+        bytes += EstimateCtrBytes(projCtr.second);
+    }
+    return bytes;
+}
+
+size_t TFold::EstimateCtrBytesUsed() const {
+    return EstimateCtrHashBytesUsed(OnlineSingleCtrs) + EstimateCtrHashBytesUsed(OnlineCTR);
+}
+
+void TFold::EnforceCtrMemoryLimit(ui64 maxBytes) {
+    struct TCtrCacheEntry {
+        TOnlineCTRHash* Hash;
+        TProjection Proj;
+        ui64 LastUsedTick;
+        size_t Bytes;
+    };
+    TVector<TCtrCacheEntry> entries;
+    size_t totalBytes = 0;
+    for (TOnlineCTRHash* hash : {&OnlineSingleCtrs, &OnlineCTR}) {
+        for (const auto& projCtr : *hash) {
+            const size_t bytes = EstimateCtrBytes(projCtr.second);
+            totalBytes += bytes;
+            entries.push_back({hash, projCtr.first, static_cast<ui64>(AtomicGet(projCtr.second.LastUsedTick)), bytes});
+        }
+    }
+    if (totalBytes <= maxBytes) {
+        return;
+    }
+    Sort(entries.begin(), entries.end(), [](const TCtrCacheEntry& lhs, const TCtrCacheEntry& rhs) {
+        return lhs.LastUsedTick < rhs.LastUsedTick;
+    });
+    size_t evictedCount = 0;
+    for (const auto& entry : entries) {
+        if (totalBytes <= maxBytes) {
+            break;
+        }
+        entry.Hash->erase(entry.Proj);
+        totalBytes -= entry.Bytes;
+        ++evictedCount;
+    }
+    MATRIXNET_DEBUG_LOG << "Evicted " << evictedCount << " online CTR tables to fit the CTR memory limit" << Endl;
+}
+
 void TFold::AssignTarget(const TVector<float>& target, const TVector<TTargetClassifier>& targetClassifiers) {
     AssignPermuted(target, &LearnTarget);
     int learnSampleCount = LearnPermutation.ysize();
@@ -262,7 +346,7 @@ void TFold::SaveApproxes(IOutputStream* s) const {
     const ui64 bodyTailCount = BodyTailArr.size();
     ::Save(s, bodyTailCount);
     for (ui64 i = 0; i < bodyTailCount; ++i) {
-        ::Save(s, BodyTailArr[i].Approx);
+        SavePodMatrix(s, BodyTailArr[i].Approx);
     }
 }
 
@@ -271,6 +355,66 @@ void TFold::LoadApproxes(IInputStream* s) {
     ::Load(s, bodyTailCount);
     CB_ENSURE(bodyTailCount == BodyTailArr.size());
     for (ui64 i = 0; i < bodyTailCount; ++i) {
-        ::Load(s, BodyTailArr[i].Approx);
+        LoadPodMatrix(s, &BodyTailArr[i].Approx);
+    }
+}
+
+static void SaveOnlineCTR(IOutputStream* s, const TOnlineCTR& ctr) {
+    const ui64 ctrCount = ctr.Feature.size();
+    ::Save(s, ctrCount);
+    for (const auto& feature : ctr.Feature) {
+        const ui64 classCount = feature.GetYSize();
+        const ui64 priorCount = feature.GetXSize();
+        ::Save(s, classCount);
+        ::Save(s, priorCount);
+        for (ui64 classIdx = 0; classIdx < classCount; ++classIdx) {
+            for (ui64 priorIdx = 0; priorIdx < priorCount; ++priorIdx) {
+                SavePodVector(s, feature[classIdx][priorIdx]);
+            }
+        }
+    }
+    ::Save(s, static_cast<ui64>(ctr.FeatureValueCount));
+}
+
+static void LoadOnlineCTR(IInputStream* s, TOnlineCTR* ctr) {
+    ui64 ctrCount;
+    ::Load(s, ctrCount);
+    ctr->Feature.resize(ctrCount);
+    for (auto& feature : ctr->Feature) {
+        ui64 classCount;
+        ui64 priorCount;
+        ::Load(s, classCount);
+        ::Load(s, priorCount);
+        feature.SetSizes(priorCount, classCount);
+        for (ui64 classIdx = 0; classIdx < classCount; ++classIdx) {
+            for (ui64 priorIdx = 0; priorIdx < priorCount; ++priorIdx) {
+                LoadPodVector(s, &feature[classIdx][priorIdx]);
+            }
+        }
+    }
+    ui64 featureValueCount;
+    ::Load(s, featureValueCount);
+    ctr->FeatureValueCount = featureValueCount;
+}
+
+void TFold::SaveOnlineCTRs(IOutputStream* s) const {
+    // Only simple ctrs are saved: they are computed once per training run and reused
+    // by every tree, while complex projection ctrs are transient tree search caches.
+    const ui64 projCount = OnlineSingleCtrs.size();
+    ::Save(s, projCount);
+    for (const auto& projCtr : OnlineSingleCtrs) {
+        ::Save(s, projCtr.first);
+        SaveOnlineCTR(s, projCtr.second);
+    }
+}
+
+void TFold::LoadOnlineCTRs(IInputStream* s) {
+    ui64 projCount;
+    ::Load(s, projCount);
+    OnlineSingleCtrs.clear();
+    for (ui64 i = 0; i < projCount; ++i) {
+        TProjection proj;
+        ::Load(s, proj);
+        LoadOnlineCTR(s, &OnlineSingleCtrs[proj]);
     }
 }
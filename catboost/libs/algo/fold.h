@@ -55,6 +55,9 @@ struct TFold {
     TVector<TBodyTail> BodyTailArr;
     TVector<float> LearnTarget;
     TVector<float> SampleWeights; // Resulting bootstrapped weights of documents.
+    // Set by Bootstrap when SampleWeights is known to be all ones (no document weights and a
+    // weight-preserving bootstrap); lets the histogram kernels skip the per-document weight loads.
+    bool SampleWeightsAreTrivial = false;
     TVector<TVector<int>> LearnTargetClass;
     TVector<int> TargetClassesCount;
     int PermutationBlockSize = FoldPermutationBlockSizeNotSet;
@@ -68,15 +71,35 @@ struct TFold {
     }
 
     TOnlineCTR& GetCtrRef(const TProjection& proj) {
-        return GetCtrs(proj)[proj];
+        TOnlineCTR& ctr = GetCtrs(proj)[proj];
+        AtomicSet(ctr.LastUsedTick, AtomicIncrement(CtrUseTick));
+        return ctr;
     }
 
     const TOnlineCTR& GetCtr(const TProjection& proj) const {
-        return GetCtrs(proj).at(proj);
+        const TOnlineCTR& ctr = GetCtrs(proj).at(proj);
+        AtomicSet(ctr.LastUsedTick, AtomicIncrement(CtrUseTick));
+        return ctr;
     }
 
     void DropEmptyCTRs();
 
+    // Free all cached online CTR tables; they are recomputed on demand during
+    // the next score calculation. Used for eviction under memory pressure.
+    void DropAllOnlineCtrs() {
+        OnlineSingleCtrs.clear();
+        OnlineCTR.clear();
+    }
+
+    // Approximate footprint of the per-document fold arrays, excluding CTR tables.
+    size_t EstimateBytesUsed() const;
+    // Approximate footprint of the cached online CTR tables.
+    size_t EstimateCtrBytesUsed() const;
+
+    // Evict least-recently-used CTR tables until the cached CTR footprint fits
+    // into maxBytes; evicted projections are recomputed on the next lookup.
+    void EnforceCtrMemoryLimit(ui64 maxBytes);
+
     const std::tuple<const TOnlineCTRHash&, const TOnlineCTRHash&> GetAllCtrs() const {
         return std::tie(OnlineSingleCtrs, OnlineCTR);
     }
@@ -106,6 +129,8 @@ struct TFold {
 
     void SaveApproxes(IOutputStream* s) const;
     void LoadApproxes(IInputStream* s);
+    void SaveOnlineCTRs(IOutputStream* s) const;
+    void LoadOnlineCTRs(IInputStream* s);
 
     static TFold BuildDynamicFold(
         const TDataset& learnData,
@@ -139,6 +164,7 @@ private:
 
     TOnlineCTRHash OnlineSingleCtrs;
     TOnlineCTRHash OnlineCTR;
+    mutable TAtomic CtrUseTick = 0; // logical clock behind the per-CTR recency marks
 
 
     void AssignTarget(const TVector<float>& target,
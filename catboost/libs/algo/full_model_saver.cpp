@@ -203,6 +203,8 @@ namespace NCB {
                     &coreModel.ObliviousTrees.OneHotFeatures,
                     ignoredFeatures,
                     OneHotMaxSize,
+                    /*oneHotMinCount=*/0, // one-hot values are preset from the model
+                    /*quantizationCachePath=*/TString(),
                     localExecutor,
                     &LearnDataset,
                     &TestDatasets
@@ -7,14 +7,26 @@
 
 #include <catboost/libs/distributed/master.h>
 #include <catboost/libs/logging/profile_info.h>
+#include <catboost/libs/logging/trace_profiler.h>
+#include <catboost/libs/helpers/alloc_profiler.h>
 #include <catboost/libs/helpers/interrupt.h>
 
 #include <library/fast_log/fast_log.h>
+#include <library/threading/future/future.h>
 
+#include <util/generic/algorithm.h>
 #include <util/string/builder.h>
 #include <util/system/mem_info.h>
 
 constexpr size_t MAX_ONLINE_CTR_FEATURES = 50;
+constexpr int MIN_CANDIDATE_COUNT_FOR_PRUNING = 16;
+constexpr double CANDIDATE_PRUNING_KEEP_FRACTION = 0.25;
+
+constexpr ui32 DEPTH_SCHEDULE_START_DEPTH = 2;
+constexpr ui32 DEPTH_SCHEDULE_MIN_TREES_PER_DEPTH = 10;
+constexpr double DEPTH_SCHEDULE_FLATTEN_RATIO = 0.98;
+constexpr double DEPTH_SCHEDULE_FAST_EMA_ALPHA = 0.3;
+constexpr double DEPTH_SCHEDULE_SLOW_EMA_ALPHA = 0.05;
 
 void TrimOnlineCTRcache(const TVector<TFold*>& folds) {
     for (auto& fold : folds) {
@@ -22,29 +34,35 @@ void TrimOnlineCTRcache(const TVector<TFold*>& folds) {
     }
 }
 
+// Monotone direction for a split candidate: the monotone_constraints option is indexed by
+// flat feature index, only float splits can be constrained (bucket order == value order).
+static int GetMonotoneDirection(const TSplitCandidate& split, const TLearnContext& ctx) {
+    const TVector<int>& monotoneConstraints = ctx.Params.ObliviousTreeOptions->MonotoneConstraints.Get();
+    if (monotoneConstraints.empty() || split.Type != ESplitType::FloatFeature) {
+        return 0;
+    }
+    const int flatFeatureIdx = ctx.LearnProgress.FloatFeatures[split.FeatureIdx].FlatFeatureIndex;
+    return flatFeatureIdx < monotoneConstraints.ysize() ? monotoneConstraints[flatFeatureIdx] : 0;
+}
+
 static void AddFloatFeatures(const TDataset& learnData,
-                             TLearnContext* ctx,
-                             TBucketStatsCache* statsFromPrevTree,
                              TCandidateList* candList) {
     for (int f = 0; f < learnData.AllFeatures.FloatHistograms.ysize(); ++f) {
-        if (learnData.AllFeatures.FloatHistograms[f].empty()) {
+        if (learnData.AllFeatures.FloatHistograms[f].empty() &&
+            !learnData.AllFeatures.IsBundledFloatFeature(f) &&
+            !learnData.AllFeatures.IsPackedFloatFeature(f))
+        {
             continue;
         }
         TCandidateInfo split;
         split.SplitCandidate.FeatureIdx = f;
         split.SplitCandidate.Type = ESplitType::FloatFeature;
 
-        if (ctx->Rand.GenRandReal1() > ctx->Params.ObliviousTreeOptions->Rsm) {
-            statsFromPrevTree->Stats.erase(split.SplitCandidate);
-            continue;
-        }
         candList->emplace_back(TCandidatesInfoList(split));
     }
 }
 
 static void AddOneHotFeatures(const TDataset& learnData,
-                              TLearnContext* ctx,
-                              TBucketStatsCache* statsFromPrevTree,
                               TCandidateList* candList) {
     for (int cf = 0; cf < learnData.AllFeatures.CatFeaturesRemapped.ysize(); ++cf) {
         if (learnData.AllFeatures.CatFeaturesRemapped[cf].empty() ||
@@ -55,10 +73,6 @@ static void AddOneHotFeatures(const TDataset& learnData,
         TCandidateInfo split;
         split.SplitCandidate.FeatureIdx = cf;
         split.SplitCandidate.Type = ESplitType::OneHotFeature;
-        if (ctx->Rand.GenRandReal1() > ctx->Params.ObliviousTreeOptions->Rsm) {
-            statsFromPrevTree->Stats.erase(split.SplitCandidate);
-            continue;
-        }
 
         candList->emplace_back(TCandidatesInfoList(split));
     }
@@ -90,6 +104,63 @@ static void AddCtrsToCandList(const TFold& fold,
 
     candList->push_back(ctrSplits);
 }
+// Appends the flat indices of every pool feature the candidate reads.
+static void GetCandidateFlatFeatureIds(const TSplitCandidate& split,
+                                       const TLearnContext& ctx,
+                                       TVector<int>* featureIds) {
+    featureIds->clear();
+    if (split.Type == ESplitType::FloatFeature) {
+        featureIds->push_back(ctx.Layout.GetExternalFeatureIdx(split.FeatureIdx, EFeatureType::Float));
+    } else if (split.Type == ESplitType::OneHotFeature) {
+        featureIds->push_back(ctx.Layout.GetExternalFeatureIdx(split.FeatureIdx, EFeatureType::Categorical));
+    } else {
+        Y_ASSERT(split.Type == ESplitType::OnlineCtr);
+        const TProjection& proj = split.Ctr.Projection;
+        for (int catFeature : proj.CatFeatures) {
+            featureIds->push_back(ctx.Layout.GetExternalFeatureIdx(catFeature, EFeatureType::Categorical));
+        }
+        for (const auto& binFeature : proj.BinFeatures) {
+            featureIds->push_back(ctx.Layout.GetExternalFeatureIdx(binFeature.FloatFeature, EFeatureType::Float));
+        }
+        for (const auto& oneHotFeature : proj.OneHotFeatures) {
+            featureIds->push_back(ctx.Layout.GetExternalFeatureIdx(oneHotFeature.CatFeatureIdx, EFeatureType::Categorical));
+        }
+    }
+}
+
+/* Split-selection telemetry and the cold-feature demotion schedule. Candidate counters are
+ * always accumulated; when demoteColdCandidates is set, candidates all of whose features
+ * have gone demotionIters iterations without winning a split are removed from the list
+ * before scoring. Demoted candidates get scored again on every score-period-th iteration
+ * (the caller clears the flag there), which is also when promotion can happen.
+ */
+static void CountCandidatesAndDemoteCold(bool demoteColdCandidates,
+                                         ui32 demotionIters,
+                                         ui32 iteration,
+                                         TLearnContext* ctx,
+                                         TCandidateList* candidateList) {
+    TVector<int> featureIds;
+    TCandidateList survivors;
+    survivors.reserve(candidateList->size());
+    for (auto& subList : *candidateList) {
+        GetCandidateFlatFeatureIds(subList.Candidates[0].SplitCandidate, *ctx, &featureIds);
+        bool cold = demoteColdCandidates && !featureIds.empty();
+        for (int featureIdx : featureIds) {
+            if (iteration - ctx->LearnProgress.FeatureLastChosenIteration[featureIdx] < demotionIters) {
+                cold = false;
+            }
+        }
+        if (cold) {
+            continue;
+        }
+        for (int featureIdx : featureIds) {
+            ctx->LearnProgress.FeatureCandidateCount[featureIdx] += subList.Candidates.ysize();
+        }
+        survivors.push_back(std::move(subList));
+    }
+    candidateList->swap(survivors);
+}
+
 static void DropStatsForProjection(const TFold& fold,
                                    const TLearnContext& ctx,
                                    const TProjection& proj,
@@ -113,9 +184,8 @@ static void DropStatsForProjection(const TFold& fold,
     }
 }
 static void AddSimpleCtrs(const TDataset& learnData,
-                          TFold* fold,
-                          TLearnContext* ctx,
-                          TBucketStatsCache* statsFromPrevTree,
+                          const TFold& fold,
+                          const TLearnContext& ctx,
                           TCandidateList* candList) {
     for (int cf = 0; cf < learnData.AllFeatures.CatFeaturesRemapped.ysize(); ++cf) {
         if (learnData.AllFeatures.CatFeaturesRemapped[cf].empty() ||
@@ -126,12 +196,44 @@ static void AddSimpleCtrs(const TDataset& learnData,
         TProjection proj;
         proj.AddCatFeature(cf);
 
+        AddCtrsToCandList(fold, ctx, proj, candList);
+    }
+}
+
+/*
+ * The float, one-hot and simple ctr candidates never change across boosting iterations:
+ * they are fully determined by the quantized feature set and the ctr descriptions (the
+ * target class counts the ctr sublists depend on are the same for every permutation
+ * fold). Build them once into ctx->CandidateSkeleton and on every iteration only replay
+ * the skeleton: draw the rsm subset, copy the surviving sublists and apply the per-fold
+ * side effects, instead of regenerating every sublist from scratch.
+ */
+static void AddStaticCandidates(const TDataset& learnData,
+                                TFold* fold,
+                                TLearnContext* ctx,
+                                TBucketStatsCache* statsFromPrevTree,
+                                TCandidateList* candList) {
+    if (!ctx->CandidateSkeletonBuilt) {
+        AddFloatFeatures(learnData, &ctx->CandidateSkeleton);
+        AddOneHotFeatures(learnData, &ctx->CandidateSkeleton);
+        AddSimpleCtrs(learnData, *fold, *ctx, &ctx->CandidateSkeleton);
+        ctx->CandidateSkeletonBuilt = true;
+    }
+    candList->reserve(candList->size() + ctx->CandidateSkeleton.size());
+    for (const auto& subList : ctx->CandidateSkeleton) {
+        const auto& split = subList.Candidates[0].SplitCandidate;
         if (ctx->Rand.GenRandReal1() > ctx->Params.ObliviousTreeOptions->Rsm) {
-            DropStatsForProjection(*fold, *ctx, proj, statsFromPrevTree);
+            if (split.Type == ESplitType::OnlineCtr) {
+                DropStatsForProjection(*fold, *ctx, split.Ctr.Projection, statsFromPrevTree);
+            } else {
+                statsFromPrevTree->Stats.erase(split);
+            }
             continue;
         }
-        AddCtrsToCandList(*fold, *ctx, proj, candList);
-        fold->GetCtrRef(proj);
+        candList->push_back(subList);
+        if (split.Type == ESplitType::OnlineCtr) {
+            fold->GetCtrRef(split.Ctr.Projection);
+        }
     }
 }
 
@@ -249,17 +351,29 @@ static void CalcBestScore(const TDataset& learnData,
     CB_ENSURE(static_cast<ui32>(ctx->LocalExecutor.GetThreadCount()) == ctx->Params.SystemOptions->NumThreads - 1);
 
     TCandidateList& candList = *candidateList;
+    int subcandidateCount = 0;
+    for (const auto& subList : candList) {
+        subcandidateCount += subList.Candidates.ysize();
+    }
+    // With fewer candidates than threads the per-candidate parallelism below cannot fill
+    // the pool, so let each histogram build split its document range instead.
+    NPar::TLocalExecutor* statsExecutor =
+        subcandidateCount < ctx->LocalExecutor.GetThreadCount() + 1 ? &ctx->LocalExecutor : nullptr;
     ctx->LocalExecutor.ExecRange([&](int id) {
         auto& candidate = candList[id];
         if (candidate.Candidates[0].SplitCandidate.Type == ESplitType::OnlineCtr) {
             const auto& proj = candidate.Candidates[0].SplitCandidate.Ctr.Projection;
             if (fold->GetCtrRef(proj).Feature.empty()) {
+                AtomicIncrement(ctx->CtrCacheMisses);
                 ComputeOnlineCTRs(learnData,
                                   testDataPtrs,
                                   *fold,
                                   proj,
                                   ctx,
-                                  &fold->GetCtrRef(proj));
+                                  &fold->GetCtrRef(proj),
+                                  /*computeTestTails*/ false);
+            } else {
+                AtomicIncrement(ctx->CtrCacheHits);
             }
         }
         TVector<TVector<double>> allScores(candidate.Candidates.size());
@@ -277,7 +391,9 @@ static void CalcBestScore(const TDataset& learnData,
                                         ctx->Params,
                                         candidate.Candidates[oneCandidate].SplitCandidate,
                                         currentDepth,
-                                        &ctx->PrevTreeLevelStats));
+                                        GetMonotoneDirection(candidate.Candidates[oneCandidate].SplitCandidate, *ctx),
+                                        &ctx->PrevTreeLevelStats,
+                                        statsExecutor));
         }, NPar::TLocalExecutor::TExecRangeParams(0, candidate.Candidates.ysize())
          , NPar::TLocalExecutor::WAIT_COMPLETE);
         if (candidate.Candidates[0].SplitCandidate.Type == ESplitType::OnlineCtr && candidate.ShouldDropCtrAfterCalc) {
@@ -287,17 +403,177 @@ static void CalcBestScore(const TDataset& learnData,
     }, 0, candList.ysize(), NPar::TLocalExecutor::WAIT_COMPLETE);
 }
 
+/// Successive-halving style pruning: score every candidate on the small PruningSampledDocs
+/// subsample without touching the level stats cache, then keep only the top
+/// CANDIDATE_PRUNING_KEEP_FRACTION of sublists (ties included) for full scoring.
+static void PruneCandidates(const TDataset& learnData,
+        const TDatasetPtrs& testDataPtrs,
+        const TVector<int>& splitCounts,
+        int currentDepth,
+        TCandidateList* candidateList,
+        TFold* fold,
+        TLearnContext* ctx) {
+    TCandidateList& candList = *candidateList;
+    TVector<double> sampledScores(candList.ysize());
+    ctx->LocalExecutor.ExecRange([&](int id) {
+        auto& candidate = candList[id];
+        if (candidate.Candidates[0].SplitCandidate.Type == ESplitType::OnlineCtr) {
+            const auto& proj = candidate.Candidates[0].SplitCandidate.Ctr.Projection;
+            if (fold->GetCtrRef(proj).Feature.empty()) {
+                AtomicIncrement(ctx->CtrCacheMisses);
+                ComputeOnlineCTRs(learnData,
+                                  testDataPtrs,
+                                  *fold,
+                                  proj,
+                                  ctx,
+                                  &fold->GetCtrRef(proj),
+                                  /*computeTestTails*/ false);
+            } else {
+                AtomicIncrement(ctx->CtrCacheHits);
+            }
+        }
+        double bestScore = -std::numeric_limits<double>::max();
+        for (const auto& candidateInfo : candidate.Candidates) {
+            const TVector<double> scores = GetScores(CalcScore(learnData.AllFeatures,
+                                        splitCounts,
+                                        fold->GetAllCtrs(),
+                                        ctx->PruningSampledDocs,
+                                        ctx->PruningSampledDocs,
+                                        *fold,
+                                        ctx->Params,
+                                        candidateInfo.SplitCandidate,
+                                        currentDepth,
+                                        GetMonotoneDirection(candidateInfo.SplitCandidate, *ctx),
+                                        /*statsFromPrevTree*/ nullptr));
+            for (double score : scores) {
+                bestScore = Max(bestScore, score);
+            }
+        }
+        sampledScores[id] = bestScore;
+    }, 0, candList.ysize(), NPar::TLocalExecutor::WAIT_COMPLETE);
+
+    const int keepCount = Max<int>(1, static_cast<int>(candList.ysize() * CANDIDATE_PRUNING_KEEP_FRACTION));
+    TVector<double> sortedScores = sampledScores;
+    NthElement(sortedScores.begin(), sortedScores.end() - keepCount, sortedScores.end());
+    const double scoreThreshold = *(sortedScores.end() - keepCount);
+
+    TCandidateList survivors;
+    survivors.reserve(keepCount);
+    for (int id = 0; id < candList.ysize(); ++id) {
+        auto& candidate = candList[id];
+        if (sampledScores[id] >= scoreThreshold) {
+            survivors.push_back(std::move(candidate));
+            continue;
+        }
+        // A skipped candidate leaves the level stats cache stale, force a full
+        // rebuild the next time it is scored (same as the Rsm skip above).
+        for (const auto& candidateInfo : candidate.Candidates) {
+            ctx->PrevTreeLevelStats.Stats.erase(candidateInfo.SplitCandidate);
+        }
+        if (candidate.Candidates[0].SplitCandidate.Type == ESplitType::OnlineCtr && candidate.ShouldDropCtrAfterCalc) {
+            fold->GetCtrRef(candidate.Candidates[0].SplitCandidate.Ctr.Projection).Feature.clear();
+        }
+    }
+    candList.swap(survivors);
+}
+
+/// Queues ComputeOnlineCTRs of proj for every lookahead fold that does not have it cached yet.
+/// The tasks run on low priority, so they only take executor threads left idle by the scoring
+/// of the following depths; the caller waits on the returned futures before the caches are read.
+static void SpawnCtrLookahead(const TDataset& learnData,
+                              const TDatasetPtrs& testDataPtrs,
+                              const TProjection& proj,
+                              const TVector<TFold*>& lookaheadFolds,
+                              TLearnContext* ctx,
+                              TVector<NThreading::TFuture<void>>* lookaheadFutures) {
+    TVector<TOnlineCTR*> jobCtrs;
+    TVector<const TFold*> jobFolds;
+    for (TFold* foldPtr : lookaheadFolds) {
+        if (!foldPtr->GetCtrs(proj).has(proj) || foldPtr->GetCtr(proj).Feature.empty()) {
+            // Insert the cache entry here: the worker only fills the slot,
+            // it never modifies the hash itself.
+            jobCtrs.push_back(&foldPtr->GetCtrRef(proj));
+            jobFolds.push_back(foldPtr);
+        }
+    }
+    if (jobCtrs.empty()) {
+        return;
+    }
+    const TDataset* learnDataPtr = &learnData;
+    const TDatasetPtrs* testDataPtrsPtr = &testDataPtrs;
+    const TLearnContext* ctxPtr = ctx;
+    auto futures = ctx->LocalExecutor.ExecRangeWithFutures([jobCtrs, jobFolds, proj, learnDataPtr, testDataPtrsPtr, ctxPtr](int jobId) {
+        const bool computeTestTails = jobFolds[jobId] == &ctxPtr->LearnProgress.AveragingFold;
+        ComputeOnlineCTRs(*learnDataPtr, *testDataPtrsPtr, *jobFolds[jobId], proj, ctxPtr, jobCtrs[jobId], computeTestTails);
+    }, 0, jobCtrs.ysize(), NPar::TLocalExecutor::LOW_PRIORITY);
+    for (auto& future : futures) {
+        lookaheadFutures->push_back(future);
+    }
+}
+
+/* Shallow-to-deep depth schedule (grow_depth_schedule): trees start at depth 2 and the
+ * schedule grows them towards the configured depth, one level at a time, whenever the
+ * per-tree split-gain sums at the current depth flatten out. Early trees model coarse
+ * structure that shallow trees capture at a fraction of the per-tree cost; the full
+ * capacity is only paid for once the shallow gains are exhausted. The detector compares
+ * a fast and a slow EMA of the gain sum: a freshly unlocked depth produces steeply
+ * decaying gains (fast EMA well below slow), and their convergence marks the plateau.
+ * All state lives in TLearnProgress, so snapshot resume and overfitting detection see
+ * exactly the trees that were built.
+ */
+static ui32 GetScheduledMaxDepth(TLearnContext* ctx) {
+    const ui32 maxDepth = ctx->Params.ObliviousTreeOptions->MaxDepth;
+    if (!ctx->Params.ObliviousTreeOptions->GrowDepthSchedule) {
+        return maxDepth;
+    }
+    TLearnProgress& progress = ctx->LearnProgress;
+    if (progress.ScheduledDepth == 0) {
+        progress.ScheduledDepth = Min(DEPTH_SCHEDULE_START_DEPTH, maxDepth);
+    }
+    return Min(progress.ScheduledDepth, maxDepth);
+}
+
+static void UpdateDepthSchedule(double treeGainSum, TLearnContext* ctx) {
+    TLearnProgress& progress = ctx->LearnProgress;
+    if (progress.ScheduledDepth >= ctx->Params.ObliviousTreeOptions->MaxDepth) {
+        return; // target depth reached, nothing left to grow
+    }
+    if (progress.TreesAtScheduledDepth == 0) {
+        progress.TreeGainFastEma = treeGainSum;
+        progress.TreeGainSlowEma = treeGainSum;
+    } else {
+        progress.TreeGainFastEma += DEPTH_SCHEDULE_FAST_EMA_ALPHA * (treeGainSum - progress.TreeGainFastEma);
+        progress.TreeGainSlowEma += DEPTH_SCHEDULE_SLOW_EMA_ALPHA * (treeGainSum - progress.TreeGainSlowEma);
+    }
+    ++progress.TreesAtScheduledDepth;
+    if (progress.TreesAtScheduledDepth >= DEPTH_SCHEDULE_MIN_TREES_PER_DEPTH &&
+        progress.TreeGainFastEma >= DEPTH_SCHEDULE_FLATTEN_RATIO * progress.TreeGainSlowEma)
+    {
+        ++progress.ScheduledDepth;
+        progress.TreesAtScheduledDepth = 0;
+        progress.TreeGainFastEma = 0.0;
+        progress.TreeGainSlowEma = 0.0;
+        MATRIXNET_INFO_LOG << "Depth schedule: gains flattened, growing trees to depth "
+            << progress.ScheduledDepth << "\n";
+    }
+}
+
 void GreedyTensorSearch(const TDataset& learnData,
                         const TDatasetPtrs& testDataPtrs,
                         const TVector<int>& splitCounts,
                         double modelLength,
                         TProfileInfo& profile,
                         TFold* fold,
+                        const TVector<TFold*>& lookaheadFolds,
                         TLearnContext* ctx,
                         TSplitTree* resSplitTree) {
+    TTraceProfilerScope traceScope(AsStringBuf("GreedyTensorSearch"));
     TSplitTree currentSplitTree;
     TrimOnlineCTRcache({fold});
 
+    TVector<NThreading::TFuture<void>> lookaheadFutures;
+    THashSet<TProjection> lookaheadProjections;
+
     int learnSampleCount = learnData.GetSampleCount();
     int testSampleCount = GetSampleCount(testDataPtrs);
     TVector<TIndexType> indices(learnSampleCount); // always for all documents
@@ -317,16 +593,37 @@ void GreedyTensorSearch(const TDataset& learnData,
         ctx->PrevTreeLevelStats.GarbageCollect();
     }
 
-    for (ui32 curDepth = 0; curDepth < ctx->Params.ObliviousTreeOptions->MaxDepth; ++curDepth) {
-        TCandidateList candList;
-        AddFloatFeatures(learnData, ctx, &ctx->PrevTreeLevelStats, &candList);
-        AddOneHotFeatures(learnData, ctx, &ctx->PrevTreeLevelStats, &candList);
-        AddSimpleCtrs(learnData, fold, ctx, &ctx->PrevTreeLevelStats, &candList);
-        AddTreeCtrs(learnData, currentSplitTree, fold, ctx, &ctx->PrevTreeLevelStats, &candList);
+    const auto buildCandidateList = [&](const TSplitTree& splitTree, TCandidateList* candListPtr) {
+        TAllocTag allocTag(EAllocTag::CandidateList);
+        candListPtr->clear();
+        AddStaticCandidates(learnData, fold, ctx, &ctx->PrevTreeLevelStats, candListPtr);
+        AddTreeCtrs(learnData, splitTree, fold, ctx, &ctx->PrevTreeLevelStats, candListPtr);
 
         auto IsInCache = [&fold](const TProjection& proj) -> bool {return fold->GetCtrRef(proj).Feature.empty();};
         auto cpuUsedRamLimit = ParseMemorySizeDescription(ctx->Params.SystemOptions->CpuUsedRamLimit);
-        SelectCtrsToDropAfterCalc(cpuUsedRamLimit, learnSampleCount + testSampleCount, ctx->Params.SystemOptions->NumThreads, IsInCache, &candList);
+        SelectCtrsToDropAfterCalc(cpuUsedRamLimit, learnSampleCount + testSampleCount, ctx->Params.SystemOptions->NumThreads, IsInCache, candListPtr);
+    };
+
+    const ui32 currentIteration = ctx->LearnProgress.TreeStruct.size();
+    const ui32 demotionIters = ctx->Params.ObliviousTreeOptions->ColdFeatureDemotionIters;
+    const ui32 coldScorePeriod = Max<ui32>(ctx->Params.ObliviousTreeOptions->ColdFeatureScorePeriod, 1);
+    const bool demoteColdCandidates = demotionIters > 0
+        && ctx->Params.SystemOptions->IsSingleHost()
+        && currentIteration >= demotionIters
+        && currentIteration % coldScorePeriod != 0;
+
+    const ui32 maxDepth = GetScheduledMaxDepth(ctx);
+    double treeGainSum = 0.0; // sum of chosen split scores, feeds the depth schedule
+    TCandidateList candList; // reused across depths to keep its allocation
+    bool candListPrebuilt = false; // the distributed path builds the next depth's list speculatively
+    for (ui32 curDepth = 0; curDepth < maxDepth; ++curDepth) {
+        TTraceProfilerScope depthScope(AsStringBuf("TensorSearchDepth"));
+        if (candListPrebuilt) {
+            candListPrebuilt = false;
+        } else {
+            buildCandidateList(currentSplitTree, &candList);
+        }
+        CountCandidatesAndDemoteCold(demoteColdCandidates, demotionIters, currentIteration, ctx, &candList);
 
         CheckInterrupted(); // check after long-lasting operation
         if (!isSamplingPerTree) {
@@ -338,7 +635,19 @@ void GreedyTensorSearch(const TDataset& learnData,
         }
         profile.AddOperation(TStringBuilder() << "Bootstrap, depth " << curDepth);
 
-        const double scoreStDev = ctx->Params.ObliviousTreeOptions->RandomStrength * CalcScoreStDev(*fold) * CalcScoreStDevMult(learnSampleCount, modelLength);
+        const float candidatePruningSampleRate = ctx->Params.ObliviousTreeOptions->CandidatePruningSampleRate;
+        if (candidatePruningSampleRate > 0
+            && ctx->Params.SystemOptions->IsSingleHost()
+            && !IsPairwiseScoring(ctx->Params.LossFunctionDescription->GetLossFunction())
+            && candList.ysize() >= MIN_CANDIDATE_COUNT_FOR_PRUNING)
+        {
+            ctx->PruningSampledDocs.Sample(*fold, indices, &ctx->Rand, &ctx->LocalExecutor);
+            PruneCandidates(learnData, testDataPtrs, splitCounts, currentSplitTree.GetDepth(), &candList, fold, ctx);
+            CheckInterrupted(); // check after long-lasting operation
+            profile.AddOperation(TStringBuilder() << "Prune candidates, depth " << curDepth);
+        }
+
+        const double scoreStDev =ctx->Params.ObliviousTreeOptions->RandomStrength * CalcScoreStDev(*fold) * CalcScoreStDevMult(learnSampleCount, modelLength);
         if (!ctx->Params.SystemOptions->IsSingleHost()) {
             MapRemoteCalcScore(scoreStDev, currentSplitTree.GetDepth(), &candList, ctx);
         } else {
@@ -359,6 +668,8 @@ void GreedyTensorSearch(const TDataset& learnData,
         CheckInterrupted(); // check after long-lasting operation
         profile.AddOperation(TStringBuilder() << "Calc scores " << curDepth);
 
+        const bool collectSampledScores = demotionIters > 0 && ctx->Params.SystemOptions->IsSingleHost();
+        TVector<std::pair<double, const TCandidateInfo*>> sampledScores; // for cold-feature promotion
         const TCandidateInfo* bestSplitCandidate = nullptr;
         double bestScore = MINIMAL_SCORE;
         for (const auto& subList : candList) {
@@ -375,6 +686,9 @@ void GreedyTensorSearch(const TDataset& learnData,
                     score *= pow(1 + fold->GetCtrRef(projection).FeatureValueCount / static_cast<double>(maxFeatureValueCount),
                                  -ctx->Params.ObliviousTreeOptions->ModelSizeReg.Get());
                 }
+                if (collectSampledScores) {
+                    sampledScores.emplace_back(score, &candidate);
+                }
                 if (score > bestScore) {
                     bestScore = score;
                     bestSplitCandidate = &candidate;
@@ -385,6 +699,26 @@ void GreedyTensorSearch(const TDataset& learnData,
         if (bestScore == MINIMAL_SCORE) {
             break;
         }
+        {
+            TVector<int> featureIds;
+            GetCandidateFlatFeatureIds(bestSplitCandidate->SplitCandidate, *ctx, &featureIds);
+            for (int featureIdx : featureIds) {
+                ++ctx->LearnProgress.FeatureChosenCount[featureIdx];
+                ctx->LearnProgress.FeatureLastChosenIteration[featureIdx] = currentIteration;
+            }
+            // Candidates whose sampled score reached the winner's noise band keep (or regain)
+            // the full scoring schedule, so a demoted feature that spikes is promoted back.
+            for (const auto& scoreWithCandidate : sampledScores) {
+                if (scoreWithCandidate.first >= bestScore - scoreStDev &&
+                    scoreWithCandidate.second != bestSplitCandidate)
+                {
+                    GetCandidateFlatFeatureIds(scoreWithCandidate.second->SplitCandidate, *ctx, &featureIds);
+                    for (int featureIdx : featureIds) {
+                        ctx->LearnProgress.FeatureLastChosenIteration[featureIdx] = currentIteration;
+                    }
+                }
+            }
+        }
         if (bestSplitCandidate->SplitCandidate.Type == ESplitType::OnlineCtr) {
             TProjection projection = bestSplitCandidate->SplitCandidate.Ctr.Projection;
             ECtrType ctrType = ctx->CtrsHelper.GetCtrInfo(projection)[bestSplitCandidate->SplitCandidate.Ctr.CtrIdx].Type;
@@ -400,11 +734,22 @@ void GreedyTensorSearch(const TDataset& learnData,
                                   *fold,
                                   proj,
                                   ctx,
-                                  &fold->GetCtrRef(proj));
+                                  &fold->GetCtrRef(proj),
+                                  /*computeTestTails*/ false);
                 DropStatsForProjection(*fold, *ctx, proj, &ctx->PrevTreeLevelStats);
             }
         }
+        if (bestSplit.Type == ESplitType::OnlineCtr &&
+            ctx->LocalExecutor.GetThreadCount() > 0 &&
+            !lookaheadProjections.has(bestSplit.Ctr.Projection))
+        {
+            // The chosen projection will be needed on every other fold right after tree search,
+            // start computing it now so that it overlaps with the scoring of the deeper levels.
+            lookaheadProjections.insert(bestSplit.Ctr.Projection);
+            SpawnCtrLookahead(learnData, testDataPtrs, bestSplit.Ctr.Projection, lookaheadFolds, ctx, &lookaheadFutures);
+        }
 
+        THolder<NPar::TJobExecutor> setIndicesExecutor;
         if (ctx->Params.SystemOptions->IsSingleHost()) {
             SetPermutedIndices(bestSplit, learnData.AllFeatures, curDepth + 1, *fold, &indices, &ctx->LocalExecutor);
             if (isSamplingPerTree) {
@@ -416,9 +761,12 @@ void GreedyTensorSearch(const TDataset& learnData,
             }
         } else {
             Y_ASSERT(bestSplit.Type != ESplitType::OnlineCtr);
-            MapSetIndices(*bestSplitCandidate, ctx);
+            // The workers apply the split while the master does the bookkeeping below; the
+            // result is collected in MapGetRedundantSplitIdx.
+            setIndicesExecutor = MapSetIndices(*bestSplitCandidate, ctx);
         }
         currentSplitTree.AddSplit(bestSplit);
+        treeGainSum += bestScore;
         MATRIXNET_INFO_LOG << BuildDescription(ctx->Layout, bestSplit);
         MATRIXNET_INFO_LOG << " score " << bestScore << "\n";
 
@@ -428,8 +776,24 @@ void GreedyTensorSearch(const TDataset& learnData,
         int redundantIdx = -1;
         if (ctx->Params.SystemOptions->IsSingleHost()) {
             redundantIdx = GetRedundantSplitIdx(GetIsLeafEmpty(curDepth + 1, indices));
+        } else if (curDepth + 1 < maxDepth) {
+            /* Speculate that the applied split is not redundant (the overwhelmingly common
+             * case): build the next depth's candidate list while the workers' verdict is
+             * still in flight, so the apply-split round trip is hidden behind master-side
+             * work instead of adding a full barrier per depth. The build's only effect
+             * outside the list is the rsm RNG draws, so on the rare redundant verdict the
+             * RNG is rolled back and the speculative list is discarded with the tree search.
+             */
+            const TRestorableFastRng64 randSnapshot = ctx->Rand;
+            buildCandidateList(currentSplitTree, &candList);
+            redundantIdx = MapGetRedundantSplitIdx(std::move(setIndicesExecutor), ctx);
+            if (redundantIdx == -1) {
+                candListPrebuilt = true;
+            } else {
+                ctx->Rand = randSnapshot;
+            }
         } else {
-            redundantIdx = MapGetRedundantSplitIdx(ctx);
+            redundantIdx = MapGetRedundantSplitIdx(std::move(setIndicesExecutor), ctx);
         }
         if (redundantIdx != -1) {
             currentSplitTree.DeleteSplit(redundantIdx);
@@ -437,5 +801,14 @@ void GreedyTensorSearch(const TDataset& learnData,
             break;
         }
     }
+    if (ctx->Params.ObliviousTreeOptions->GrowDepthSchedule) {
+        UpdateDepthSchedule(treeGainSum, ctx);
+    }
+    for (auto& future : lookaheadFutures) {
+        future.GetValueSync();
+    }
+    if (!lookaheadFutures.empty()) {
+        profile.AddOperation("Wait for lookahead CTRs");
+    }
     *resSplitTree = std::move(currentSplitTree);
 }
@@ -9,11 +9,16 @@
 
 void TrimOnlineCTRcache(const TVector<TFold*>& folds);
 
+/// lookaheadFolds are the folds that are not used by tree search itself but will need the CTRs
+/// of the chosen projections afterwards (the remaining learn folds and the averaging fold).
+/// Their CTRs are precomputed on low priority executor tasks while deeper levels are being
+/// scored; all such tasks are finished before the function returns. Must not contain fold.
 void GreedyTensorSearch(const TDataset& learnData,
                         const TDatasetPtrs& testDataPtrs,
                         const TVector<int>& splitCounts,
                         double modelLength,
                         TProfileInfo& profile,
                         TFold* fold,
+                        const TVector<TFold*>& lookaheadFolds,
                         TLearnContext* ctx,
                         TSplitTree* resSplitTree);
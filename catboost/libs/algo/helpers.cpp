@@ -1,14 +1,118 @@
 #include "helpers.h"
 
+#include <catboost/libs/helpers/alloc_profiler.h>
 #include <catboost/libs/helpers/exception.h>
 #include <catboost/libs/logging/logging.h>
 
 #include <library/malloc/api/malloc.h>
 
 #include <util/generic/algorithm.h>
+#include <util/generic/maybe.h>
 #include <util/generic/utility.h>
+#include <util/generic/ymath.h>
 #include <util/system/mem_info.h>
 
+/* Per-feature border budgeting for adaptive_border_count. Every non-constant feature gets
+ * a share of the global bin budget (border_count per feature) proportional to a cheap
+ * estimate of its splitting value: the log of its distinct-value count (capacity for
+ * distinct splits) times its squared target correlation plus a floor, so weakly
+ * correlated features keep a usable grid - correlation is a first-order proxy and can
+ * miss non-monotonic dependencies. A feature can never receive more borders than it has
+ * distinct values to separate; bins clipped off near-binary features flow to rich
+ * continuous ones, keeping the total at the uniform budget.
+ */
+static void CalcAdaptiveBorderCounts(const TDocumentStorage& docStorage,
+                                     const TVector<TFloatFeature>& floatFeatures,
+                                     const THashSet<int>& ignoredFeatureIndexes,
+                                     const TVector<size_t>& randomShuffle, // empty == take leading documents
+                                     size_t samplesToBuildBorders,
+                                     int globalBorderCount,
+                                     NPar::TLocalExecutor* localExecutor,
+                                     TVector<int>* featureBorderCounts) {
+    const int featureCount = floatFeatures.ysize();
+    const int maxBordersPerFeature = 255;
+    const int distinctValueCap = maxBordersPerFeature + 1;
+    const auto& target = docStorage.Target;
+    TVector<double> scores(featureCount, 0.0);
+    TVector<int> maxBorders(featureCount, 0);
+    localExecutor->ExecRange([&](int idx) {
+        const int flatIdx = floatFeatures[idx].FlatFeatureIndex;
+        if (ignoredFeatureIndexes.has(flatIdx)) {
+            return;
+        }
+        const auto& factors = docStorage.GetFactorRef(flatIdx);
+        double count = 0, sumX = 0, sumXX = 0, sumY = 0, sumYY = 0, sumXY = 0;
+        THashSet<float> distinctValues;
+        for (size_t i = 0; i < samplesToBuildBorders; ++i) {
+            const size_t docIdx = randomShuffle.empty() ? i : randomShuffle[i];
+            const float factor = factors[docIdx];
+            if (IsNan(factor)) {
+                continue;
+            }
+            const double x = factor;
+            const double y = target[docIdx];
+            count += 1;
+            sumX += x;
+            sumXX += x * x;
+            sumY += y;
+            sumYY += y * y;
+            sumXY += x * y;
+            if (distinctValues.ysize() < distinctValueCap) {
+                distinctValues.insert(factor);
+            }
+        }
+        const int distinctCount = distinctValues.ysize();
+        maxBorders[idx] = Min(distinctCount - 1, maxBordersPerFeature);
+        if (maxBorders[idx] <= 0) {
+            return; // constant feature, any border count yields an empty grid
+        }
+        const double varX = sumXX - sumX * sumX / count;
+        const double varY = sumYY - sumY * sumY / count;
+        const double covXY = sumXY - sumX * sumY / count;
+        const double corrSqr = (varX > 0 && varY > 0) ? Sqr(covXY) / (varX * varY) : 0.0;
+        scores[idx] = (corrSqr + 0.01) * Log2(static_cast<double>(distinctCount));
+    }, 0, featureCount, NPar::TLocalExecutor::WAIT_COMPLETE);
+
+    double totalScore = 0;
+    int scoredCount = 0;
+    for (int idx = 0; idx < featureCount; ++idx) {
+        if (scores[idx] > 0) {
+            totalScore += scores[idx];
+            ++scoredCount;
+        }
+    }
+    if (totalScore <= 0) {
+        return; // nothing to budget, keep the uniform counts
+    }
+    const double budget = static_cast<double>(globalBorderCount) * scoredCount;
+    // Features whose fair share exceeds their distinct-value cap take the cap and return
+    // the surplus; the second pass re-shares it among the remaining features.
+    double remainingBudget = budget;
+    double remainingScore = totalScore;
+    TVector<bool> clipped(featureCount, false);
+    for (int idx = 0; idx < featureCount; ++idx) {
+        if (scores[idx] > 0 && budget * scores[idx] / totalScore >= maxBorders[idx]) {
+            (*featureBorderCounts)[idx] = maxBorders[idx];
+            remainingBudget -= maxBorders[idx];
+            remainingScore -= scores[idx];
+            clipped[idx] = true;
+        }
+    }
+    i64 totalAllocated = 0;
+    for (int idx = 0; idx < featureCount; ++idx) {
+        if (scores[idx] <= 0) {
+            continue;
+        }
+        if (!clipped[idx] && remainingScore > 0) {
+            const int allocated = static_cast<int>(remainingBudget * scores[idx] / remainingScore + 0.5);
+            (*featureBorderCounts)[idx] = ClampVal(allocated, 1, maxBorders[idx]);
+        }
+        totalAllocated += (*featureBorderCounts)[idx];
+    }
+    MATRIXNET_INFO_LOG << "Adaptive border budgeting: " << totalAllocated << " borders across "
+        << scoredCount << " features (uniform budget " << static_cast<i64>(budget) << ")" << Endl;
+}
+
 void GenerateBorders(const TPool& pool, TLearnContext* ctx, TVector<TFloatFeature>* floatFeatures) {
     auto& docStorage = pool.Docs;
     const THashSet<int>& categFeatures = ctx->CatFeatures;
@@ -37,6 +141,24 @@ void GenerateBorders(const TPool& pool, TLearnContext* ctx, TVector<TFloatFeatur
             ++floatFeatureId;
         }
     }
+    if (pool.IsQuantized()) {
+        /* The pool carries bins computed against its own border grid; reuse that grid
+         * verbatim instead of building a new one - the raw values needed for border
+         * selection were never materialized. Features ignored or borderless on load have
+         * empty border lists and are skipped by binarization like constant features.
+         */
+        for (auto& floatFeature : *floatFeatures) {
+            const int flatIdx = floatFeature.FlatFeatureIndex;
+            floatFeature.Borders = pool.QuantizationBorders[flatIdx];
+            const ENanMode poolNanMode = pool.QuantizationNanModes[flatIdx];
+            floatFeature.HasNans = poolNanMode != ENanMode::Forbidden;
+            floatFeature.NanValueTreatment = poolNanMode == ENanMode::Max
+                ? NCatBoostFbs::ENanValueTreatment_AsTrue
+                : NCatBoostFbs::ENanValueTreatment_AsFalse;
+        }
+        MATRIXNET_INFO_LOG << "Borders for float features taken from the quantized pool" << Endl;
+        return;
+    }
     size_t samplesToBuildBorders = docStorage.GetDocCount();
     bool isSubsampled = false;
     const constexpr size_t SlowSubsampleSize = 200 * 1000;
@@ -46,6 +168,12 @@ void GenerateBorders(const TPool& pool, TLearnContext* ctx, TVector<TFloatFeatur
         samplesToBuildBorders = SlowSubsampleSize;
         isSubsampled = true;
     }
+    // Explicitly requested sampling: build a bounded-error grid on a document sample
+    const ui32 borderBuildSampleCount = floatFeatureBorderOptions.BorderBuildSampleCount;
+    if (borderBuildSampleCount > 0 && samplesToBuildBorders > borderBuildSampleCount) {
+        samplesToBuildBorders = borderBuildSampleCount;
+        isSubsampled = true;
+    }
     TVector<size_t> randomShuffle;
     const bool isShuffleNeeded = isSubsampled && ctx->Params.DataProcessingOptions->HasTimeFlag;
     if (isShuffleNeeded) {
@@ -53,10 +181,23 @@ void GenerateBorders(const TPool& pool, TLearnContext* ctx, TVector<TFloatFeatur
         std::iota(randomShuffle.begin(), randomShuffle.end(), 0);
         Shuffle(randomShuffle.begin(), randomShuffle.end(), ctx->Rand);
     }
+    THashSet<int> ignoredFeatureIndexes(ctx->Params.DataProcessingOptions->IgnoredFeatures->begin(), ctx->Params.DataProcessingOptions->IgnoredFeatures->end());
+    TVector<int> featureBorderCounts(reasonCount, borderCount);
+    if (floatFeatureBorderOptions.AdaptiveBorderCount && !docStorage.Target.empty()) {
+        CalcAdaptiveBorderCounts(docStorage,
+                                 *floatFeatures,
+                                 ignoredFeatureIndexes,
+                                 randomShuffle, // empty unless the shuffle was built above
+                                 samplesToBuildBorders,
+                                 borderCount,
+                                 &ctx->LocalExecutor,
+                                 &featureBorderCounts);
+    }
+    const int maxBorderCount = *MaxElement(featureBorderCounts.begin(), featureBorderCounts.end());
     // Estimate how many threads can generate borders
     const size_t bytes1M = 1024 * 1024, bytesThreadStack = 2 * bytes1M;
     const size_t bytesUsed = NMemInfo::GetMemInfo().RSS;
-    const size_t bytesBestSplit = CalcMemoryForFindBestSplit(borderCount, samplesToBuildBorders, borderType);
+    const size_t bytesBestSplit = CalcMemoryForFindBestSplit(maxBorderCount, samplesToBuildBorders, borderType);
     const size_t bytesGenerateBorders = sizeof(float) * samplesToBuildBorders;
     const size_t bytesRequiredPerThread = bytesThreadStack + bytesGenerateBorders + bytesBestSplit;
     const size_t usedRamLimit = ParseMemorySizeDescription(ctx->Params.SystemOptions->CpuUsedRamLimit);
@@ -66,7 +207,6 @@ void GenerateBorders(const TPool& pool, TLearnContext* ctx, TVector<TFloatFeatur
         MATRIXNET_WARNING_LOG << "CatBoost needs " << (bytesUsed + bytesRequiredPerThread) / bytes1M + 1 << " Mb of memory to generate borders" << Endl;
     }
     TAtomic taskFailedBecauseOfNans = 0;
-    THashSet<int> ignoredFeatureIndexes(ctx->Params.DataProcessingOptions->IgnoredFeatures->begin(), ctx->Params.DataProcessingOptions->IgnoredFeatures->end());
     auto calcOneFeatureBorder = [&](int idx) {
         auto& floatFeature = floatFeatures->at(idx);
         const auto floatFeatureIdx = floatFeature.FlatFeatureIndex;
@@ -78,13 +218,13 @@ void GenerateBorders(const TPool& pool, TLearnContext* ctx, TVector<TFloatFeatur
         vals.reserve(samplesToBuildBorders);
         for (size_t i = 0; i < samplesToBuildBorders; ++i) {
             const size_t randomDocIdx = isShuffleNeeded ? randomShuffle[i] : i;
-            const float factor = docStorage.Factors[floatFeatureIdx][randomDocIdx];
+            const float factor = docStorage.GetFactorRef(floatFeatureIdx)[randomDocIdx];
             if (!IsNan(factor)) {
                 vals.push_back(factor);
             }
         }
 
-        THashSet<float> borderSet = BestSplit(vals, borderCount, borderType);
+        THashSet<float> borderSet = BestSplit(vals, featureBorderCounts[idx], borderType);
         if (borderSet.has(-0.0f)) { // BestSplit might add negative zeros
             borderSet.erase(-0.0f);
             borderSet.insert(0.0f);
@@ -92,7 +232,7 @@ void GenerateBorders(const TPool& pool, TLearnContext* ctx, TVector<TFloatFeatur
         TVector<float> bordersBlock(borderSet.begin(), borderSet.end());
         Sort(bordersBlock.begin(), bordersBlock.end());
 
-        floatFeature.HasNans = AnyOf(docStorage.Factors[floatFeatureIdx], IsNan);
+        floatFeature.HasNans = AnyOf(docStorage.GetFactorRef(floatFeatureIdx), IsNan);
         if (floatFeature.HasNans) {
             if (nanMode == ENanMode::Min) {
                 floatFeature.NanValueTreatment = NCatBoostFbs::ENanValueTreatment_AsFalse;
@@ -131,6 +271,64 @@ void ConfigureMalloc() {
 #endif
 }
 
+// Bootstrap replicate count for metric confidence intervals; 32 resampled aggregates are
+// enough for stable 2.5%/97.5% quantiles while keeping the per-block overhead trivial.
+static const int METRIC_BOOTSTRAP_REPLICATES = 32;
+
+// Evaluates the requested metrics, routing additive per-object ones through the fused
+// single-sweep kernel and the rest through their own Eval. The returned vector is indexed
+// like errors; entries whose flag is not set are left zero. When confidenceIntervals is
+// non-null, block-bootstrap intervals are computed in the same pass for the fused metrics
+// (the only ones whose partial sums are cheap to resample); entries for the other metrics
+// stay undefined.
+static TVector<double> EvalRequestedErrors(
+    const TVector<TVector<double>>& approx,
+    const TVector<float>& target,
+    const TVector<float>& weight,
+    const TVector<TQueryInfo>& queryInfo,
+    const TVector<THolder<IMetric>>& errors,
+    const TVector<bool>& shouldCalcError,
+    TVector<TMaybe<TMetricConfidenceInterval>>* confidenceIntervals,
+    TLearnContext* ctx
+) {
+    TVector<double> errorValues(errors.ysize());
+    TVector<int> fusedIndices;
+    TVector<const IMetric*> fusedMetrics;
+    for (int i = 0; i < errors.ysize(); ++i) {
+        if (!shouldCalcError[i]) {
+            continue;
+        }
+        if (errors[i]->IsAdditiveMetric() && errors[i]->GetErrorType() == EErrorType::PerObjectError) {
+            fusedIndices.push_back(i);
+            fusedMetrics.push_back(errors[i].Get());
+        } else {
+            errorValues[i] = EvalErrors(approx, target, weight, queryInfo, errors[i], &ctx->LocalExecutor);
+        }
+    }
+    TVector<TMetricConfidenceInterval> fusedIntervals;
+    const TVector<double> fusedValues = EvalErrorsFusedWithBootstrap(
+        fusedMetrics,
+        approx,
+        target,
+        weight,
+        queryInfo,
+        confidenceIntervals != nullptr ? METRIC_BOOTSTRAP_REPLICATES : 0,
+        ctx->Params.RandomSeed,
+        confidenceIntervals != nullptr ? &fusedIntervals : nullptr,
+        &ctx->LocalExecutor
+    );
+    if (confidenceIntervals != nullptr) {
+        confidenceIntervals->assign(errors.ysize(), Nothing());
+    }
+    for (int fusedIdx = 0; fusedIdx < fusedIndices.ysize(); ++fusedIdx) {
+        errorValues[fusedIndices[fusedIdx]] = fusedValues[fusedIdx];
+        if (confidenceIntervals != nullptr) {
+            (*confidenceIntervals)[fusedIndices[fusedIdx]] = fusedIntervals[fusedIdx];
+        }
+    }
+    return errorValues;
+}
+
 void CalcErrors(
     const TDataset& learnData,
     const TDatasetPtrs& testDataPtrs,
@@ -139,21 +337,50 @@ void CalcErrors(
     int overfittingDetectorMetricIdx,
     TLearnContext* ctx
 ) {
+    CalcErrors(
+        learnData,
+        testDataPtrs,
+        ctx->LearnProgress.AvrgApprox,
+        ctx->LearnProgress.TestApprox,
+        errors,
+        calcMetrics,
+        overfittingDetectorMetricIdx,
+        ctx
+    );
+}
+
+void CalcErrors(
+    const TDataset& learnData,
+    const TDatasetPtrs& testDataPtrs,
+    const TVector<TVector<double>>& avrgApprox,
+    const TVector<TVector<TVector<double>>>& testApprox,
+    const TVector<THolder<IMetric>>& errors,
+    bool calcMetrics,
+    int overfittingDetectorMetricIdx,
+    TLearnContext* ctx
+) {
+    TAllocTag allocTag(EAllocTag::MetricCompute);
     if (learnData.GetSampleCount() > 0) {
         TVector<bool> skipMetricOnTrain = GetSkipMetricOnTrain(errors);
         const auto& data = learnData;
         ctx->LearnProgress.MetricsAndTimeHistory.LearnMetricsHistory.emplace_back();
+        TVector<bool> shouldCalcError(errors.ysize(), false);
+        for (int i = 0; i < errors.ysize(); ++i) {
+            shouldCalcError[i] = calcMetrics && !skipMetricOnTrain[i];
+        }
+        const TVector<double> errorValues = EvalRequestedErrors(
+            avrgApprox,
+            data.Target,
+            data.Weights,
+            data.QueryInfo,
+            errors,
+            shouldCalcError,
+            /*confidenceIntervals*/ nullptr,
+            ctx
+        );
         for (int i = 0; i < errors.ysize(); ++i) {
-            const TMap<TString, TString> hints = errors[i]->GetHints();
-            if (calcMetrics && !skipMetricOnTrain[i]) {
-                ctx->LearnProgress.MetricsAndTimeHistory.LearnMetricsHistory.back().push_back(EvalErrors(
-                    ctx->LearnProgress.AvrgApprox,
-                    data.Target,
-                    data.Weights,
-                    data.QueryInfo,
-                    errors[i],
-                    &ctx->LocalExecutor
-                ));
+            if (shouldCalcError[i]) {
+                ctx->LearnProgress.MetricsAndTimeHistory.LearnMetricsHistory.back().push_back(errorValues[i]);
             }
         }
     }
@@ -166,18 +393,31 @@ void CalcErrors(
             if (testDataPtrs[testIdx] == nullptr || testDataPtrs[testIdx]->GetSampleCount() == 0) {
                 continue;
             }
-            const auto& testApprox = ctx->LearnProgress.TestApprox[testIdx];
             const auto& data = *testDataPtrs[testIdx];
+            TVector<bool> shouldCalcError(errors.ysize(), false);
             for (int i = 0; i < errors.ysize(); ++i) {
-                if (i == overfittingDetectorMetricIdx || calcMetrics) {
-                    testMetricErrors.back().push_back(EvalErrors(
-                        testApprox,
-                        data.Target,
-                        data.Weights,
-                        data.QueryInfo,
-                        errors[i],
-                        &ctx->LocalExecutor
-                    ));
+                shouldCalcError[i] = i == overfittingDetectorMetricIdx || calcMetrics;
+            }
+            const bool calcConfidenceIntervals = calcMetrics && ctx->OutputOptions.CalcMetricConfidenceIntervals();
+            TVector<TMaybe<TMetricConfidenceInterval>> confidenceIntervals;
+            const TVector<double> errorValues = EvalRequestedErrors(
+                testApprox[testIdx],
+                data.Target,
+                data.Weights,
+                data.QueryInfo,
+                errors,
+                shouldCalcError,
+                calcConfidenceIntervals ? &confidenceIntervals : nullptr,
+                ctx
+            );
+            for (int i = 0; i < errors.ysize(); ++i) {
+                if (shouldCalcError[i]) {
+                    testMetricErrors.back().push_back(errorValues[i]);
+                }
+                if (calcConfidenceIntervals && confidenceIntervals[i].Defined()) {
+                    MATRIXNET_INFO_LOG << "test " << testIdx << "\t" << errors[i]->GetDescription()
+                        << " 95% CI: [" << confidenceIntervals[i]->Lower << ", "
+                        << confidenceIntervals[i]->Upper << "]" << Endl;
                 }
             }
         }
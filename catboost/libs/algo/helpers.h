@@ -21,3 +21,16 @@ void CalcErrors(
     int overfittingDetectorMetricIdx,
     TLearnContext* ctx
 );
+
+// Evaluates metrics on explicitly passed approxes instead of the ones in ctx->LearnProgress,
+// so the caller may snapshot them and evaluate in background while training mutates the originals.
+void CalcErrors(
+    const TDataset& learnData,
+    const TDatasetPtrs& testDataPtrs,
+    const TVector<TVector<double>>& avrgApprox,
+    const TVector<TVector<TVector<double>>>& testApprox,
+    const TVector<THolder<IMetric>>& errors,
+    bool calcMetrics, // bool value for each error
+    int overfittingDetectorMetricIdx,
+    TLearnContext* ctx
+);
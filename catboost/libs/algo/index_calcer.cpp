@@ -31,6 +31,101 @@ static inline const TVector<int>& GetRemappedCatFeatures(const TSplit& split, co
     return features.CatFeaturesRemapped[split.FeatureIdx];
 }
 
+/*
+ * Branch-free float split update for 16 documents: one packed unsigned compare of the
+ * histogram bytes against the border (formula_evaluator-style), the 0/1 byte mask widened
+ * to ui32 lanes and shifted into the leaf indices.
+ */
+static Y_FORCE_INLINE void UpdateIndicesForFloatSplit(const ui8* histogramValues, ui8 value, int levelShift, TIndexType* indices) {
+    const __m128i signFlip = _mm_set1_epi8('\x80');
+    const __m128i histVec = _mm_xor_si128(_mm_loadu_si128((const __m128i*)histogramValues), signFlip);
+    const __m128i borderVec = _mm_xor_si128(_mm_set1_epi8((char)value), signFlip);
+    const __m128i isTrue = _mm_and_si128(_mm_cmpgt_epi8(histVec, borderVec), _mm_set1_epi8(1));
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i lowWords = _mm_unpacklo_epi8(isTrue, zero);
+    const __m128i highWords = _mm_unpackhi_epi8(isTrue, zero);
+    const __m128i updates[4] = {
+        _mm_unpacklo_epi16(lowWords, zero),
+        _mm_unpackhi_epi16(lowWords, zero),
+        _mm_unpacklo_epi16(highWords, zero),
+        _mm_unpackhi_epi16(highWords, zero)
+    };
+    for (int part = 0; part < 4; ++part) {
+        __m128i* dst = (__m128i*)(indices + part * 4);
+        _mm_storeu_si128(dst, _mm_add_epi32(_mm_loadu_si128(dst), _mm_slli_epi32(updates[part], levelShift)));
+    }
+}
+
+// Float split update over a block with permuted histogram access: gather the bytes, then packed compare.
+static void OfflineFloatSplitBlock(int blockStart,
+                                   int nextBlockStart,
+                                   const TFold& fold,
+                                   const ui8* histogram,
+                                   ui8 value,
+                                   int levelShift,
+                                   TIndexType* indices) {
+    const size_t* permutation = fold.LearnPermutation.data();
+    constexpr int vectorWidth = 16;
+    alignas(16) ui8 gathered[vectorWidth];
+    int doc;
+    for (doc = blockStart; doc + vectorWidth <= nextBlockStart; doc += vectorWidth) {
+        for (int k = 0; k < vectorWidth; ++k) {
+            gathered[k] = histogram[permutation[doc + k]];
+        }
+        UpdateIndicesForFloatSplit(gathered, value, levelShift, indices + doc);
+    }
+    for (; doc < nextBlockStart; ++doc) {
+        indices[doc] += IsTrueHistogram(histogram[permutation[doc]], value) << levelShift;
+    }
+}
+
+// Float split update for a feature living in an exclusive feature bundle: decode the bin on the fly.
+static void OfflineBundledFloatSplitBlock(int blockStart,
+                                          int nextBlockStart,
+                                          const TFold& fold,
+                                          const ui8* bundleBins,
+                                          const TFeatureBundleRef& ref,
+                                          ui8 value,
+                                          int levelShift,
+                                          TIndexType* indices) {
+    const size_t* permutation = fold.LearnPermutation.data();
+    for (int doc = blockStart; doc < nextBlockStart; ++doc) {
+        indices[doc] += IsTrueHistogram(GetBundledBin(bundleBins[permutation[doc]], ref), value) << levelShift;
+    }
+}
+
+// Float split update for a bit-packed feature: extract the member bin on the fly.
+static void OfflinePackedFloatSplitBlock(int blockStart,
+                                         int nextBlockStart,
+                                         const TFold& fold,
+                                         const ui8* packedBins,
+                                         const TFeaturePackRef& ref,
+                                         ui8 value,
+                                         int levelShift,
+                                         TIndexType* indices) {
+    const size_t* permutation = fold.LearnPermutation.data();
+    for (int doc = blockStart; doc < nextBlockStart; ++doc) {
+        indices[doc] += IsTrueHistogram(GetPackedBin(packedBins[permutation[doc]], ref), value) << levelShift;
+    }
+}
+
+// Same as OfflineFloatSplitBlock for sequential histogram access (test tails are not permuted).
+static void SequentialFloatSplitBlock(int blockStart,
+                                      int nextBlockStart,
+                                      const ui8* histogram,
+                                      ui8 value,
+                                      int levelShift,
+                                      TIndexType* indices) {
+    constexpr int vectorWidth = 16;
+    int doc;
+    for (doc = blockStart; doc + vectorWidth <= nextBlockStart; doc += vectorWidth) {
+        UpdateIndicesForFloatSplit(histogram + doc, value, levelShift, indices + doc);
+    }
+    for (; doc < nextBlockStart; ++doc) {
+        indices[doc] += IsTrueHistogram(histogram[doc], value) << levelShift;
+    }
+}
+
 template <typename TCount, bool (*CmpOp)(TCount, TCount), int vectorWidth>
 void BuildIndicesKernel(const size_t* permutation, const TCount* histogram, TCount value, int level, TIndexType* indices) {
     Y_ASSERT(vectorWidth == 4);
@@ -53,16 +148,14 @@ void BuildIndicesKernel(const size_t* permutation, const TCount* histogram, TCou
 }
 
 template <typename TCount, bool (*CmpOp)(TCount, TCount)>
-void OfflineCtrBlock(const NPar::TLocalExecutor::TExecRangeParams& params,
-                     int blockIdx,
+void OfflineCtrBlock(int blockStart,
+                     int nextBlockStart,
                      const TFold& fold,
                      const TCount* histogram,
                      TCount value,
                      int level,
                      TIndexType* indices) {
     const size_t* permutation = fold.LearnPermutation.data();
-    const int blockStart = blockIdx * params.GetBlockSize();
-    const int nextBlockStart = Min<ui64>(blockStart + params.GetBlockSize(), params.LastId);
     constexpr int vectorWidth = 4;
     int doc;
     for (doc = blockStart; doc + vectorWidth <= nextBlockStart; doc += vectorWidth) {
@@ -82,28 +175,45 @@ void SetPermutedIndices(const TSplit& split,
                         NPar::TLocalExecutor* localExecutor) {
     CB_ENSURE(curDepth > 0);
 
-    const int blockSize = 1000;
-    NPar::TLocalExecutor::TExecRangeParams blockParams(0, indices->ysize());
-    blockParams.SetBlockSize(blockSize);
+    const int minBlockSize = 1000;
+    const int docCount = indices->ysize();
 
     const int splitWeight = 1 << (curDepth - 1);
     TIndexType* indicesData = indices->data();
     if (split.Type == ESplitType::FloatFeature) {
-        localExecutor->ExecRange([&](int blockIdx) {
-            OfflineCtrBlock<ui8, IsTrueHistogram>(blockParams, blockIdx, fold, GetFloatHistogram(split, features).data(),
-                                                  GetFeatureSplitIdx(split), splitWeight, indicesData);
-        }, 0, blockParams.GetBlockCount(), NPar::TLocalExecutor::WAIT_COMPLETE);
+        if (features.IsBundledFloatFeature(split.FeatureIdx)) {
+            const TFeatureBundleRef& ref = features.FloatFeatureBundleRefs[split.FeatureIdx];
+            const ui8* bundleBins = features.FeatureBundles[ref.BundleIdx].Bins.data();
+            NPar::GuidedBlockedParallelFor(*localExecutor, 0, docCount, minBlockSize, [&](int blockStart, int blockEnd) {
+                OfflineBundledFloatSplitBlock(blockStart, blockEnd, fold, bundleBins, ref,
+                                              GetFeatureSplitIdx(split), curDepth - 1, indicesData);
+            });
+        } else if (features.IsPackedFloatFeature(split.FeatureIdx)) {
+            const TFeaturePackRef& ref = features.FloatFeaturePackRefs[split.FeatureIdx];
+            const ui8* packedBins = features.FeaturePacks[ref.PackIdx].Bins.data();
+            NPar::GuidedBlockedParallelFor(*localExecutor, 0, docCount, minBlockSize, [&](int blockStart, int blockEnd) {
+                OfflinePackedFloatSplitBlock(blockStart, blockEnd, fold, packedBins, ref,
+                                             GetFeatureSplitIdx(split), curDepth - 1, indicesData);
+            });
+        } else {
+            NPar::GuidedBlockedParallelFor(*localExecutor, 0, docCount, minBlockSize, [&](int blockStart, int blockEnd) {
+                OfflineFloatSplitBlock(blockStart, blockEnd, fold, GetFloatHistogram(split, features).data(),
+                                       GetFeatureSplitIdx(split), curDepth - 1, indicesData);
+            });
+        }
     } else if (split.Type == ESplitType::OnlineCtr) {
         auto& ctr = fold.GetCtr(split.Ctr.Projection);
-        localExecutor->ExecRange([&] (int i) {
-            indicesData[i] += GetCtrSplit(split, i, ctr) * splitWeight;
-        }, blockParams, NPar::TLocalExecutor::WAIT_COMPLETE);
+        NPar::GuidedBlockedParallelFor(*localExecutor, 0, docCount, minBlockSize, [&](int blockStart, int blockEnd) {
+            for (int i = blockStart; i < blockEnd; ++i) {
+                indicesData[i] += GetCtrSplit(split, i, ctr) * splitWeight;
+            }
+        });
     } else {
         Y_ASSERT(split.Type == ESplitType::OneHotFeature);
-        localExecutor->ExecRange([&] (int blockIdx) {
-            OfflineCtrBlock<int, IsTrueOneHotFeature>(blockParams, blockIdx, fold, GetRemappedCatFeatures(split, features).data(),
+        NPar::GuidedBlockedParallelFor(*localExecutor, 0, docCount, minBlockSize, [&](int blockStart, int blockEnd) {
+            OfflineCtrBlock<int, IsTrueOneHotFeature>(blockStart, blockEnd, fold, GetRemappedCatFeatures(split, features).data(),
                                                       split.BinBorder, splitWeight, indicesData);
-        }, 0, blockParams.GetBlockCount(), NPar::TLocalExecutor::WAIT_COMPLETE);
+        });
     }
 }
 
@@ -155,33 +265,43 @@ static void BuildIndicesForLearn(const TSplitTree& tree,
                                  const TFold& fold,
                                  NPar::TLocalExecutor* localExecutor,
                                  TIndexType* indices) {
-    const int blockSize = 1000;
-    NPar::TLocalExecutor::TExecRangeParams learnBlockParams(0, learnSampleCount);
-    learnBlockParams.SetBlockSize(blockSize);
+    const int minBlockSize = 1000;
 
-    auto updateLearnIndex = [&](int blockIdx) {
+    auto updateLearnIndex = [&](int blockStart, int blockEnd) {
         for (int splitIdx = 0; splitIdx < tree.GetDepth(); ++splitIdx) {
             const auto& split = tree.Splits[splitIdx];
             const int splitWeight = 1 << splitIdx;
             if (split.Type == ESplitType::FloatFeature) {
-                OfflineCtrBlock<ui8, IsTrueHistogram>(learnBlockParams, blockIdx, fold,
-                    GetFloatHistogram(split, learnData.AllFeatures).data(),
-                    GetFeatureSplitIdx(split), splitWeight, indices);
+                if (learnData.AllFeatures.IsBundledFloatFeature(split.FeatureIdx)) {
+                    const TFeatureBundleRef& ref = learnData.AllFeatures.FloatFeatureBundleRefs[split.FeatureIdx];
+                    OfflineBundledFloatSplitBlock(blockStart, blockEnd, fold,
+                        learnData.AllFeatures.FeatureBundles[ref.BundleIdx].Bins.data(),
+                        ref, GetFeatureSplitIdx(split), splitIdx, indices);
+                } else if (learnData.AllFeatures.IsPackedFloatFeature(split.FeatureIdx)) {
+                    const TFeaturePackRef& ref = learnData.AllFeatures.FloatFeaturePackRefs[split.FeatureIdx];
+                    OfflinePackedFloatSplitBlock(blockStart, blockEnd, fold,
+                        learnData.AllFeatures.FeaturePacks[ref.PackIdx].Bins.data(),
+                        ref, GetFeatureSplitIdx(split), splitIdx, indices);
+                } else {
+                    OfflineFloatSplitBlock(blockStart, blockEnd, fold,
+                        GetFloatHistogram(split, learnData.AllFeatures).data(),
+                        GetFeatureSplitIdx(split), splitIdx, indices);
+                }
             } else if (split.Type == ESplitType::OnlineCtr) {
                 const TOnlineCTR& splitOnlineCtr = *onlineCtrs[splitIdx];
-                NPar::TLocalExecutor::BlockedLoopBody(learnBlockParams, [&](int doc) {
+                for (int doc = blockStart; doc < blockEnd; ++doc) {
                     indices[doc] += GetCtrSplit(split, doc, splitOnlineCtr) * splitWeight;
-                })(blockIdx);
+                }
             } else {
                 Y_ASSERT(split.Type == ESplitType::OneHotFeature);
-                OfflineCtrBlock<int, IsTrueOneHotFeature>(learnBlockParams, blockIdx, fold,
+                OfflineCtrBlock<int, IsTrueOneHotFeature>(blockStart, blockEnd, fold,
                     GetRemappedCatFeatures(split, learnData.AllFeatures).data(),
                     split.BinBorder, splitWeight, indices);
             }
         }
     };
 
-    localExecutor->ExecRange(updateLearnIndex, 0, learnBlockParams.GetBlockCount(), NPar::TLocalExecutor::WAIT_COMPLETE);
+    NPar::GuidedBlockedParallelFor(*localExecutor, 0, learnSampleCount, minBlockSize, updateLearnIndex);
 }
 
 static void BuildIndicesForTest(const TSplitTree& tree,
@@ -191,38 +311,34 @@ static void BuildIndicesForTest(const TSplitTree& tree,
                                 int docOffset,
                                 NPar::TLocalExecutor* localExecutor,
                                 TIndexType* indices) {
-    const int blockSize = 1000;
-    NPar::TLocalExecutor::TExecRangeParams tailBlockParams(0, tailSampleCount);
-    tailBlockParams.SetBlockSize(blockSize);
+    const int minBlockSize = 1000;
 
-    auto updateTailIndex = [&](int blockIdx) {
+    auto updateTailIndex = [&](int blockStart, int blockEnd) {
         TIndexType* tailIndices = indices;
         for (int splitIdx = 0; splitIdx < tree.GetDepth(); ++splitIdx) {
             const auto& split = tree.Splits[splitIdx];
             const int splitWeight = 1 << splitIdx;
             if (split.Type == ESplitType::FloatFeature) {
-                const ui8 featureSplitIdx = GetFeatureSplitIdx(split);
-                const ui8* floatHistogramData = GetFloatHistogram(split, testData.AllFeatures).data();
-                NPar::TLocalExecutor::BlockedLoopBody(tailBlockParams, [&](int doc) {
-                    tailIndices[doc] += IsTrueHistogram(floatHistogramData[doc], featureSplitIdx) * splitWeight;
-                })(blockIdx);
+                SequentialFloatSplitBlock(blockStart, blockEnd,
+                    GetFloatHistogram(split, testData.AllFeatures).data(),
+                    GetFeatureSplitIdx(split), splitIdx, tailIndices);
             } else if (split.Type == ESplitType::OnlineCtr) {
                 const TOnlineCTR& splitOnlineCtr = *onlineCtrs[splitIdx];
-                NPar::TLocalExecutor::BlockedLoopBody(tailBlockParams, [&](int doc) {
+                for (int doc = blockStart; doc < blockEnd; ++doc) {
                     tailIndices[doc] += GetCtrSplit(split, doc + docOffset, splitOnlineCtr) * splitWeight;
-                })(blockIdx);
+                }
             } else {
                 Y_ASSERT(split.Type == ESplitType::OneHotFeature);
                 const int featureSplitValue = split.BinBorder;
                 const int* featureValueData = GetRemappedCatFeatures(split, testData.AllFeatures).data();
-                NPar::TLocalExecutor::BlockedLoopBody(tailBlockParams, [&](int doc) {
+                for (int doc = blockStart; doc < blockEnd; ++doc) {
                     tailIndices[doc] += IsTrueOneHotFeature(featureValueData[doc], featureSplitValue) * splitWeight;
-                })(blockIdx);
+                }
             }
         }
     };
 
-    localExecutor->ExecRange(updateTailIndex, 0, tailBlockParams.GetBlockCount(), NPar::TLocalExecutor::WAIT_COMPLETE);
+    NPar::GuidedBlockedParallelFor(*localExecutor, 0, tailSampleCount, minBlockSize, updateTailIndex);
 }
 
 TVector<TIndexType> BuildIndices(const TFold& fold,
@@ -255,10 +371,10 @@ TVector<ui8> BinarizeFeatures(const TFullModel& model, const TPool& pool, size_t
     TVector<float> ctrs(model.ObliviousTrees.GetUsedModelCtrs().size() * docCount);
     BinarizeFeatures(model,
         [&pool](const TFloatFeature& floatFeature, size_t index) -> float {
-            return pool.Docs.Factors[floatFeature.FlatFeatureIndex][index];
+            return pool.Docs.GetFactorRef(floatFeature.FlatFeatureIndex)[index];
         },
         [&pool](const TCatFeature& catFeature, size_t index) -> int {
-            return ConvertFloatCatFeatureToIntHash(pool.Docs.Factors[catFeature.FlatFeatureIndex][index]);
+            return ConvertFloatCatFeatureToIntHash(pool.Docs.GetFactorRef(catFeature.FlatFeatureIndex)[index]);
         },
         start,
         end,
@@ -1,5 +1,9 @@
 #include "index_hash_calcer.h"
 
+#include <util/generic/utility.h>
+#include <util/system/tls.h>
+#include <util/thread/singleton.h>
+
 /// Compute reindexHash and reindex hash values in range [begin,end).
 size_t ComputeReindexHash(ui64 topSize,
                           TDenseHash<ui64, ui32>* reindexHashPtr,
@@ -60,6 +64,68 @@ size_t ComputeReindexHash(ui64 topSize,
     return reindexHash.Size();
 }
 
+namespace {
+    struct THashDocPair {
+        ui64 Hash;
+        ui32 Doc;
+    };
+}
+
+/// Sort-based grouping of hash values, see the header for semantics.
+size_t ReindexHashesBySort(ui64* begin, ui64* end) {
+    const size_t sampleCount = end - begin;
+    if (sampleCount == 0) {
+        return 0;
+    }
+
+    using TPairsArr = TVector<THashDocPair>;
+    Y_STATIC_THREAD(TPairsArr) tlsPairs;
+    Y_STATIC_THREAD(TPairsArr) tlsPairsBuf;
+    TPairsArr& pairs = tlsPairs.Get();
+    TPairsArr& pairsBuf = tlsPairsBuf.Get();
+    pairs.yresize(sampleCount);
+    pairsBuf.yresize(sampleCount);
+    for (size_t i = 0; i < sampleCount; ++i) {
+        pairs[i].Hash = begin[i];
+        pairs[i].Doc = static_cast<ui32>(i);
+    }
+
+    constexpr int digitBits = 8;
+    constexpr size_t digitCount = size_t(1) << digitBits;
+    THashDocPair* src = pairs.data();
+    THashDocPair* dst = pairsBuf.data();
+    for (int pass = 0; pass < 8; ++pass) {
+        const int shift = pass * digitBits;
+        size_t counts[digitCount] = {};
+        for (size_t i = 0; i < sampleCount; ++i) {
+            ++counts[(src[i].Hash >> shift) & (digitCount - 1)];
+        }
+        if (counts[(src[0].Hash >> shift) & (digitCount - 1)] == sampleCount) {
+            continue; // every key shares this digit, nothing to reorder
+        }
+        size_t offsets[digitCount];
+        size_t offset = 0;
+        for (size_t digit = 0; digit < digitCount; ++digit) {
+            offsets[digit] = offset;
+            offset += counts[digit];
+        }
+        for (size_t i = 0; i < sampleCount; ++i) {
+            dst[offsets[(src[i].Hash >> shift) & (digitCount - 1)]++] = src[i];
+        }
+        DoSwap(src, dst);
+    }
+
+    ui32 denseId = 0;
+    begin[src[0].Doc] = 0;
+    for (size_t i = 1; i < sampleCount; ++i) {
+        if (src[i].Hash != src[i - 1].Hash) {
+            ++denseId;
+        }
+        begin[src[i].Doc] = denseId;
+    }
+    return denseId + 1;
+}
+
 /// Update reindexHash and reindex hash values in range [begin,end).
 size_t UpdateReindexHash(TDenseHash<ui64, ui32>* reindexHashPtr, ui64* begin, ui64* end) {
     auto& reindexHash = *reindexHashPtr;
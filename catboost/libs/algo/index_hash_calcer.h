@@ -69,6 +69,40 @@ inline void CalcHashes(const TProjection& proj,
     }
 
     for (const TBinFeature& feature : proj.BinFeatures) {
+        if (allFeatures.IsBundledFloatFeature(feature.FloatFeature)) {
+            const TFeatureBundleRef& ref = allFeatures.FloatFeatureBundleRefs[feature.FloatFeature];
+            const ui8* bundleBins = offset + allFeatures.FeatureBundles[ref.BundleIdx].Bins.data();
+            if (learnPermutation != nullptr) {
+                const auto& perm = *learnPermutation;
+                for (size_t i = 0; i < sampleCount; ++i) {
+                    const bool isTrueFeature = IsTrueHistogram(GetBundledBin(bundleBins[perm[i]], ref), feature.SplitIdx);
+                    hashArr[i] = CalcHash(hashArr[i], (ui64)isTrueFeature);
+                }
+            } else {
+                for (size_t i = 0; i < sampleCount; ++i) {
+                    const bool isTrueFeature = IsTrueHistogram(GetBundledBin(bundleBins[i], ref), feature.SplitIdx);
+                    hashArr[i] = CalcHash(hashArr[i], (ui64)isTrueFeature);
+                }
+            }
+            continue;
+        }
+        if (allFeatures.IsPackedFloatFeature(feature.FloatFeature)) {
+            const TFeaturePackRef& ref = allFeatures.FloatFeaturePackRefs[feature.FloatFeature];
+            const ui8* packedBins = offset + allFeatures.FeaturePacks[ref.PackIdx].Bins.data();
+            if (learnPermutation != nullptr) {
+                const auto& perm = *learnPermutation;
+                for (size_t i = 0; i < sampleCount; ++i) {
+                    const bool isTrueFeature = IsTrueHistogram(GetPackedBin(packedBins[perm[i]], ref), feature.SplitIdx);
+                    hashArr[i] = CalcHash(hashArr[i], (ui64)isTrueFeature);
+                }
+            } else {
+                for (size_t i = 0; i < sampleCount; ++i) {
+                    const bool isTrueFeature = IsTrueHistogram(GetPackedBin(packedBins[i], ref), feature.SplitIdx);
+                    hashArr[i] = CalcHash(hashArr[i], (ui64)isTrueFeature);
+                }
+            }
+            continue;
+        }
         const ui8* featureValues = offset + allFeatures.FloatHistograms[feature.FloatFeature].data();
         if (learnPermutation != nullptr) {
             const auto& perm = *learnPermutation;
@@ -112,3 +146,10 @@ size_t ComputeReindexHash(ui64 topSize, TDenseHash<ui64, ui32>* reindexHashPtr,
 /// If a hash value is not present in reindexHash, then update reindexHash for that value.
 /// @return the size of updated reindexHash.
 size_t UpdateReindexHash(TDenseHash<ui64, ui32>* reindexHashPtr, ui64* begin, ui64* end);
+
+/// Sort-based replacement for ComputeReindexHash + UpdateReindexHash usable when no
+/// leaf count trimming can happen: radix sort (hash, doc) pairs and assign dense ids
+/// to contiguous equal-hash groups, touching memory sequentially instead of probing
+/// a hash table. Ids are assigned in hash order, which is an equally valid labeling.
+/// @return the number of distinct hash values.
+size_t ReindexHashesBySort(ui64* begin, ui64* end);
@@ -2,6 +2,7 @@
 #include "error_functions.h"
 
 #include <catboost/libs/distributed/master.h>
+#include <catboost/libs/helpers/pod_serialization.h>
 #include <catboost/libs/helpers/progress_helper.h>
 #include <catboost/libs/options/defaults_helper.h>
 
@@ -11,6 +12,7 @@
 #include <util/generic/guid.h>
 #include <util/folder/path.h>
 #include <util/system/fs.h>
+#include <util/stream/buffer.h>
 #include <util/stream/file.h>
 
 
@@ -54,6 +56,12 @@ static ui32 CalcMatrixCheckSum(ui32 init, const TVector<TVector<T>>& matrix) {
 static ui32 CalcFeaturesCheckSum(const TAllFeatures& allFeatures) {
     ui32 checkSum = 0;
     checkSum = CalcMatrixCheckSum(checkSum, allFeatures.FloatHistograms);
+    for (const auto& bundle : allFeatures.FeatureBundles) {
+        checkSum = Crc32cExtend(checkSum, bundle.Bins.data(), bundle.Bins.size());
+    }
+    for (const auto& pack : allFeatures.FeaturePacks) {
+        checkSum = Crc32cExtend(checkSum, pack.Bins.data(), pack.Bins.size());
+    }
     checkSum = CalcMatrixCheckSum(checkSum, allFeatures.CatFeaturesRemapped);
     checkSum = CalcMatrixCheckSum(checkSum, allFeatures.OneHotValues);
     return checkSum;
@@ -65,11 +73,22 @@ void TLearnContext::InitContext(const TDataset& learnData, const TDatasetPtrs& t
         LearnProgress.PoolCheckSum += CalcFeaturesCheckSum(testData->AllFeatures);
     }
 
+    const int externalFeatureCount = Layout.GetExternalFeatureCount();
+    LearnProgress.FeatureCandidateCount.resize(externalFeatureCount, 0);
+    LearnProgress.FeatureChosenCount.resize(externalFeatureCount, 0);
+    LearnProgress.FeatureLastChosenIteration.resize(externalFeatureCount, 0);
+
     auto lossFunction = Params.LossFunctionDescription->GetLossFunction();
     int foldCount = Max<ui32>(Params.BoostingOptions->PermutationCount - 1, 1);
     const bool noCtrs = IsCategoricalFeaturesEmpty(learnData.AllFeatures);
     if (Params.BoostingOptions->BoostingType == EBoostingType::Plain && noCtrs) {
         foldCount = 1;
+    } else if (noCtrs && foldCount > 1 && Params.BoostingOptions->PermutationCount.NotSet()) {
+        // Without online ctrs the estimation folds differ only by document permutation,
+        // while each of them keeps its own approx and derivative arrays. By default keep
+        // a single estimation fold; an explicit permutation_count overrides this.
+        foldCount = 1;
+        MATRIXNET_INFO_LOG << "No online ctr features, using single estimation fold (set permutation_count to override)" << Endl;
     }
     LearnProgress.Folds.reserve(foldCount);
     UpdateCtrsTargetBordersOption(lossFunction, LearnProgress.ApproxDimension, &Params.CatFeatureParams.Get());
@@ -161,8 +180,19 @@ void TLearnContext::SaveProgress() {
     if (!OutputOptions.SaveSnapshot()) {
         return;
     }
-    TProgressHelper(ToString(ETaskType::CPU)).Write(Files.SnapshotFile, [&](IOutputStream* out) {
-        ::SaveMany(out, Rand, LearnProgress, Profile.DumpProfileInfo());
+    // At most one snapshot write is in flight; waiting also makes the buffer safe to reuse.
+    if (SnapshotWriteFuture) {
+        SnapshotWriteFuture->Get();
+    }
+    SnapshotBuffer.Clear();
+    {
+        TBufferOutput out(SnapshotBuffer);
+        ::SaveMany(&out, Rand, LearnProgress, Profile.DumpProfileInfo());
+    }
+    SnapshotWriteFuture = MakeHolder<NThreading::TLegacyFuture<void, false>>([this]() {
+        TProgressHelper(ToString(ETaskType::CPU)).Write(Files.SnapshotFile, [this](IOutputStream* out) {
+            out->Write(SnapshotBuffer.Data(), SnapshotBuffer.Size());
+        });
     });
 }
 
@@ -224,17 +254,36 @@ void TLearnProgress::Save(IOutputStream* s) const {
         Folds[i].SaveApproxes(s);
     }
     AveragingFold.SaveApproxes(s);
+    for (ui64 i = 0; i < foldCount; ++i) {
+        Folds[i].SaveOnlineCTRs(s);
+    }
+    AveragingFold.SaveOnlineCTRs(s);
+    // The big per-document approx arrays go through the bulk POD path; the remaining
+    // fields keep the generic serializer.
+    SavePodMatrix(s, AvrgApprox);
+    const ui64 testCount = TestApprox.size();
+    ::Save(s, testCount);
+    for (const auto& testApprox : TestApprox) {
+        SavePodMatrix(s, testApprox);
+    }
+    SavePodMatrix(s, BestTestApprox);
     ::SaveMany(s,
-               AvrgApprox,
-               TestApprox,
-               BestTestApprox,
                CatFeatures,
                FloatFeatures,
                ApproxDimension,
                TreeStruct,
                TreeStats,
+               TestApproxTreeCount,
+               BestModelTreeCount,
                LeafValues,
                MetricsAndTimeHistory,
+               FeatureCandidateCount,
+               FeatureChosenCount,
+               FeatureLastChosenIteration,
+               ScheduledDepth,
+               TreesAtScheduledDepth,
+               TreeGainFastEma,
+               TreeGainSlowEma,
                UsedCtrSplits,
                PoolCheckSum);
 }
@@ -248,16 +297,35 @@ void TLearnProgress::Load(IInputStream* s) {
         Folds[i].LoadApproxes(s);
     }
     AveragingFold.LoadApproxes(s);
-    ::LoadMany(s, AvrgApprox,
-               TestApprox,
-               BestTestApprox,
+    for (ui64 i = 0; i < foldCount; ++i) {
+        Folds[i].LoadOnlineCTRs(s);
+    }
+    AveragingFold.LoadOnlineCTRs(s);
+    LoadPodMatrix(s, &AvrgApprox);
+    ui64 testCount = 0;
+    ::Load(s, testCount);
+    TestApprox.resize(testCount);
+    for (auto& testApprox : TestApprox) {
+        LoadPodMatrix(s, &testApprox);
+    }
+    LoadPodMatrix(s, &BestTestApprox);
+    ::LoadMany(s,
                CatFeatures,
                FloatFeatures,
                ApproxDimension,
                TreeStruct,
                TreeStats,
+               TestApproxTreeCount,
+               BestModelTreeCount,
                LeafValues,
                MetricsAndTimeHistory,
+               FeatureCandidateCount,
+               FeatureChosenCount,
+               FeatureLastChosenIteration,
+               ScheduledDepth,
+               TreesAtScheduledDepth,
+               TreeGainFastEma,
+               TreeGainSlowEma,
                UsedCtrSplits,
                PoolCheckSum);
 }
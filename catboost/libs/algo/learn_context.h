@@ -1,6 +1,7 @@
 #pragma once
 
 #include "online_ctr.h"
+#include "candidate_list.h"
 #include "features_layout.h"
 #include "fold.h"
 #include "ctr_helper.h"
@@ -15,10 +16,12 @@
 #include <catboost/libs/helpers/restorable_rng.h>
 
 #include <library/json/json_reader.h>
+#include <library/threading/future/legacy_future.h>
 #include <library/threading/local_executor/local_executor.h>
 
 #include <library/par/par.h>
 
+#include <util/generic/buffer.h>
 #include <util/generic/noncopyable.h>
 #include <util/generic/hash_set.h>
 #include <catboost/libs/loggers/logger.h>
@@ -42,10 +45,34 @@ struct TLearnProgress {
 
     TVector<TSplitTree> TreeStruct;
     TVector<TTreeStats> TreeStats;
+    // Number of leading trees already applied to TestApprox; lags behind TreeStruct.size()
+    // between metric calculations when lazy_test_approx is enabled.
+    ui64 TestApproxTreeCount = 0;
+    // Tree count of the best-metric prefix seen so far. Trees are append-only, so this
+    // single number is a complete rolling snapshot of the best model: use_best_model
+    // truncates to it at the end of training without replaying the metric history.
+    ui64 BestModelTreeCount = 0;
     TVector<TVector<TVector<double>>> LeafValues; // [numTree][dim][bucketId]
 
     TMetricsAndTimeLeftHistory MetricsAndTimeHistory;
 
+    // Split-selection telemetry indexed by flat feature index: how many times a feature
+    // entered candidate scoring, how many splits it won, and the last iteration on which
+    // it won (or was promoted back from the cold schedule). Drives the optional
+    // cold-feature demotion policy and the end-of-training usage summary.
+    TVector<ui64> FeatureCandidateCount;
+    TVector<ui64> FeatureChosenCount;
+    TVector<ui32> FeatureLastChosenIteration;
+
+    // Depth-schedule state (see greedy_tensor_search.cpp): the depth trees are currently
+    // grown to, how many trees were built at that depth, and fast/slow EMAs of the
+    // per-tree split-gain sum used to detect flattening. Serialized so a resumed
+    // snapshot continues the schedule instead of restarting shallow.
+    ui32 ScheduledDepth = 0; // 0 means the schedule has not started yet
+    ui32 TreesAtScheduledDepth = 0;
+    double TreeGainFastEma = 0.0;
+    double TreeGainSlowEma = 0.0;
+
     THashSet<std::pair<ECtrType, TProjection>> UsedCtrSplits;
 
     ui32 PoolCheckSum = 0;
@@ -67,6 +94,13 @@ public:
         , EvalMetricDescriptor(evalMetricDescriptor)
         , Layout(featureCount, catFeatures, featureId)
         , CatFeatures(catFeatures.begin(), catFeatures.end()) {
+        if (Params.SystemOptions->SpinDispatch) {
+            // a per-depth task is typically well under 100us; spin through roughly that
+            // long a gap before parking so consecutive fork-join regions find the
+            // workers still running
+            LocalExecutor.SetWorkerSpinIterations(100000);
+            LocalExecutor.PinWorkerThreadsToCpus(true);
+        }
         LocalExecutor.RunAdditionalThreads(Params.SystemOptions->NumThreads - 1);
         CB_ENSURE(static_cast<ui32>(LocalExecutor.GetThreadCount()) == Params.SystemOptions->NumThreads - 1);
     }
@@ -108,6 +142,10 @@ public:
         LearnProgress.SerializedTrainParams = ToString(Params);
         ETaskType taskType = Params.GetTaskType();
         CB_ENSURE(taskType == ETaskType::CPU, "Error: except learn on CPU task type, got " << taskType);
+        if (Params.IsProfile) {
+            // best effort: stays disabled when perf_event is unavailable
+            Profile.EnableHardwareCounters();
+        }
     }
     ~TLearnContext();
 
@@ -124,9 +162,30 @@ public:
 
     TCalcScoreFold SmallestSplitSideDocs;
     TCalcScoreFold SampledDocs;
+    TCalcScoreFold PruningSampledDocs;
     TBucketStatsCache PrevTreeLevelStats;
+    /* The iteration-invariant part of the split candidate list: float, one-hot and
+     * simple ctr candidates do not depend on the tree being built, so the sublists are
+     * generated once on the first GreedyTensorSearch call and replayed every iteration
+     * (the per-iteration rsm subset and the tree ctrs are applied on top of the copy).
+     */
+    TCandidateList CandidateSkeleton;
+    bool CandidateSkeletonBuilt = false;
+    // Online CTR cache counters: a hit reuses a cached table during candidate
+    // scoring, a miss recomputes one (initially or after eviction).
+    TAtomic CtrCacheHits = 0;
+    TAtomic CtrCacheMisses = 0;
     TObj<NPar::IRootEnvironment> RootEnvironment;
     TObj<NPar::IEnvironment> SharedTrainData;
     TProfileInfo Profile;
+
+private:
+    /* Snapshots are double-buffered: the training thread serializes the progress into
+     * SnapshotBuffer and the temp-file write with rename commit runs on a background thread,
+     * so the iteration loop does not stall on disk. SnapshotWriteFuture is declared after
+     * the buffer and the file names so its destructor joins the write before they go away.
+     */
+    TBuffer SnapshotBuffer;
+    THolder<NThreading::TLegacyFuture<void, false>> SnapshotWriteFuture;
 };
 
@@ -0,0 +1,83 @@
+#include "objective_plugin.h"
+
+#include <catboost/libs/helpers/exception.h>
+#include <catboost/libs/logging/logging.h>
+
+#include <util/generic/hash.h>
+#include <util/generic/ptr.h>
+#include <util/generic/singleton.h>
+#include <util/string/builder.h>
+#include <util/system/dynlib.h>
+#include <util/system/guard.h>
+#include <util/system/spinlock.h>
+
+namespace NCB {
+    namespace {
+        using TCalcDersRangeFunc = void (*)(int, const double*, const float*, const float*, TDers*, void*);
+        using TCalcDersMultiFunc = void (*)(const TVector<double>&, float, float, TVector<double>*, TArray2D<double>*, void*);
+        using TObjectiveInitFunc = void* (*)(const char*);
+
+        struct TLoadedPlugin {
+            THolder<TDynamicLibrary> Library;
+            TCustomObjectiveDescriptor Descriptor;
+        };
+
+        // Plug-in libraries are loaded once per path and never unloaded: the descriptor's raw
+        // function pointers outlive any single training run (snapshots, repeated fits in one
+        // process), so dlclosing on destruction would leave dangling code pointers behind.
+        class TObjectivePluginRegistry {
+        public:
+            const TCustomObjectiveDescriptor& Get(const TString& path, const TString& initParams) {
+                with_lock (Lock) {
+                    auto it = Plugins.find(path);
+                    if (it != Plugins.end()) {
+                        return it->second.Descriptor;
+                    }
+                    TLoadedPlugin plugin;
+                    plugin.Library.Reset(new TDynamicLibrary(path));
+                    plugin.Library->SetUnloadable(false);
+                    plugin.Descriptor.CalcDersRange =
+                        reinterpret_cast<TCalcDersRangeFunc>(plugin.Library->Sym("CatBoostCalcDersRange"));
+                    plugin.Descriptor.CalcDersMulti =
+                        reinterpret_cast<TCalcDersMultiFunc>(plugin.Library->SymOptional("CatBoostCalcDersMulti"));
+                    const auto initFunc =
+                        reinterpret_cast<TObjectiveInitFunc>(plugin.Library->SymOptional("CatBoostObjectiveInit"));
+                    if (initFunc != nullptr) {
+                        plugin.Descriptor.CustomData = initFunc(initParams.c_str());
+                    } else {
+                        plugin.Descriptor.CustomData = nullptr;
+                    }
+                    MATRIXNET_INFO_LOG << "Loaded custom objective plugin " << path << Endl;
+                    return Plugins.emplace(path, std::move(plugin)).first->second.Descriptor;
+                }
+            }
+
+        private:
+            TAdaptiveLock Lock;
+            THashMap<TString, TLoadedPlugin> Plugins;
+        };
+    }
+
+    TMaybe<TCustomObjectiveDescriptor> LoadObjectivePlugin(const NCatboostOptions::TLossDescription& lossDescription) {
+        if (lossDescription.GetLossFunction() != ELossFunction::Custom) {
+            return Nothing();
+        }
+        const auto& lossParams = lossDescription.GetLossParams();
+        if (!lossParams.has("plugin")) {
+            return Nothing();
+        }
+        const TString& path = lossParams.at("plugin");
+        CB_ENSURE(!path.empty(), "custom objective plugin path is empty");
+        TStringBuilder initParams;
+        for (const auto& param : lossParams) {
+            if (param.first == "plugin") {
+                continue;
+            }
+            if (!initParams.empty()) {
+                initParams << ";";
+            }
+            initParams << param.first << "=" << param.second;
+        }
+        return Singleton<TObjectivePluginRegistry>()->Get(path, initParams);
+    }
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <catboost/libs/metrics/metric.h>
+#include <catboost/libs/options/loss_description.h>
+
+#include <util/generic/maybe.h>
+
+namespace NCB {
+
+    /*
+     * Native custom-objective plug-ins: "Custom:plugin=/path/to/libloss.so" loads the shared
+     * object and drives training through the regular TCustomError machinery, so a custom loss
+     * runs at the speed of a builtin one instead of calling back into an interpreter per
+     * document. The library must export
+     *
+     *     void CatBoostCalcDersRange(int count, const double* approxes, const float* targets,
+     *                                const float* weights, TDers* ders, void* customData);
+     *
+     * with the same batched TDers layout as error_functions.h; it may additionally export
+     * CatBoostCalcDersMulti with the TCustomObjectiveDescriptor::CalcDersMulti signature for
+     * multi-dimensional losses and
+     *
+     *     void* CatBoostObjectiveInit(const char* params);
+     *
+     * which receives the remaining loss parameters as "key=value;..." once at load time and
+     * returns the opaque state passed back on every call. The library stays loaded for the
+     * lifetime of the process.
+     *
+     * @return the descriptor for the plug-in, or Nothing() when the loss description does not
+     *         name one.
+     */
+    TMaybe<TCustomObjectiveDescriptor> LoadObjectivePlugin(const NCatboostOptions::TLossDescription& lossDescription);
+}
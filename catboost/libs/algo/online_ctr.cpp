@@ -5,6 +5,7 @@
 #include "score_calcer.h"
 #include "tree_print.h"
 
+#include <catboost/libs/helpers/alloc_profiler.h>
 #include <catboost/libs/model/model.h>
 #include <util/generic/utility.h>
 #include <util/thread/singleton.h>
@@ -315,7 +316,9 @@ void ComputeOnlineCTRs(const TDataset& learnData,
                        const TFold& fold,
                        const TProjection& proj,
                        const TLearnContext* ctx,
-                       TOnlineCTR* dst) {
+                       TOnlineCTR* dst,
+                       bool computeTestTails) {
+    TAllocTag allocTag(EAllocTag::OnlineCtr);
     const TCtrHelper& ctrHelper = ctx->CtrsHelper;
     const auto& ctrInfo = ctrHelper.GetCtrInfo(proj);
     dst->Feature.resize(ctrInfo.size());
@@ -323,6 +326,30 @@ void ComputeOnlineCTRs(const TDataset& learnData,
     const TVector<size_t>& testOffsets = CalcTestOffsets(learnSampleCount, testDataPtrs);
     size_t totalSampleCount = learnSampleCount + GetSampleCount(testDataPtrs);
 
+    /* Test hashes always take part in the reindex below so that leafCount (and with it the
+     * model size regularization) does not depend on the flag, but the CTR value arrays are
+     * only extended over the test documents when somebody will actually read them. */
+    const TVector<size_t> learnOnlyOffsets(1, learnSampleCount);
+    const TVector<size_t>& ctrOffsets = computeTestTails ? testOffsets : learnOnlyOffsets;
+    const size_t ctrSampleCount = computeTestTails ? totalSampleCount : learnSampleCount;
+
+    ui64 topSize = ctx->Params.CatFeatureParams->CtrLeafCountLimit;
+    if (proj.IsSingleCatFeature() && ctx->Params.CatFeatureParams->StoreAllSimpleCtrs) {
+        topSize = Max<ui64>();
+    }
+    // Without a leaf count limit dense ids can be assigned by sorting; sequential
+    // scans over sorted groups beat the pointer-chasing hash probes.
+    const bool useSortedReindex = topSize == Max<ui64>();
+    /* Simple projections can use the quantization-time remapped ids directly: they are
+     * already dense and ordered like the sorted reindex would leave them, so the whole
+     * reindex pass is redundant, and the per-value count tables precomputed at dataset
+     * build replace the counter scan as well.
+     */
+    const bool useDirectCatIds = useSortedReindex && proj.IsSingleCatFeature() &&
+        !learnData.AllFeatures.CatFeaturesValueCount.empty() &&
+        AllOf(testDataPtrs, [](const TDataset* testDataPtr) {
+            return testDataPtr->GetSampleCount() == 0 || !testDataPtr->AllFeatures.CatFeaturesValueCount.empty();
+        });
 
     using THashArr = TVector<ui64>;
     using TRehashHash = TDenseHash<ui64, ui32>;
@@ -332,22 +359,25 @@ void ComputeOnlineCTRs(const TDataset& learnData,
     if (proj.IsSingleCatFeature()) {
         // Shortcut for simple ctrs
         Clear(&hashArr, totalSampleCount);
+        const ui64 idOffset = useDirectCatIds ? 0 : 1;
         if (learnSampleCount > 0) {
             const int* featureValues = learnData.AllFeatures.CatFeaturesRemapped[proj.CatFeatures[0]].data();
             const auto* permutation = fold.LearnPermutation.data();
             for (size_t i = 0; i < learnSampleCount; ++i) {
-                hashArr[i] = ((ui64)featureValues[permutation[i]]) + 1;
+                hashArr[i] = ((ui64)featureValues[permutation[i]]) + idOffset;
             }
         }
         for (size_t docOffset = learnSampleCount, testIdx = 0; docOffset < totalSampleCount && testIdx < testDataPtrs.size(); ++testIdx) {
             const size_t testSampleCount = testDataPtrs[testIdx]->GetSampleCount();
             const int* featureValues = testDataPtrs[testIdx]->AllFeatures.CatFeaturesRemapped[proj.CatFeatures[0]].data();
             for (size_t i = 0; i < testSampleCount; ++i) {
-                hashArr[docOffset + i] = ((ui64)featureValues[i]) + 1;
+                hashArr[docOffset + i] = ((ui64)featureValues[i]) + idOffset;
             }
             docOffset += testSampleCount;
         }
-        rehashHashTlsVal.Get().MakeEmpty(learnData.AllFeatures.OneHotValues[proj.CatFeatures[0]].size());
+        if (!useSortedReindex) {
+            rehashHashTlsVal.Get().MakeEmpty(learnData.AllFeatures.OneHotValues[proj.CatFeatures[0]].size());
+        }
     } else {
         Clear(&hashArr, totalSampleCount);
         CalcHashes(proj, learnData.AllFeatures, 0, &fold.LearnPermutation, false, hashArr.begin(), hashArr.begin() + learnSampleCount);
@@ -356,24 +386,35 @@ void ComputeOnlineCTRs(const TDataset& learnData,
             CalcHashes(proj, testDataPtrs[testIdx]->AllFeatures, 0, nullptr, false, hashArr.begin() + docOffset, hashArr.begin() + docOffset + testSampleCount);
             docOffset += testSampleCount;
         }
-        size_t approxBucketsCount = 1;
-        for (auto cf : proj.CatFeatures) {
-            approxBucketsCount *= learnData.AllFeatures.OneHotValues[cf].size();
-            if (approxBucketsCount > learnSampleCount) {
-                break;
+        if (!useSortedReindex) {
+            size_t approxBucketsCount = 1;
+            for (auto cf : proj.CatFeatures) {
+                approxBucketsCount *= learnData.AllFeatures.OneHotValues[cf].size();
+                if (approxBucketsCount > learnSampleCount) {
+                    break;
+                }
             }
+            rehashHashTlsVal.Get().MakeEmpty(Min(learnSampleCount, approxBucketsCount));
         }
-        rehashHashTlsVal.Get().MakeEmpty(Min(learnSampleCount, approxBucketsCount));
-    }
-    ui64 topSize = ctx->Params.CatFeatureParams->CtrLeafCountLimit;
-    if (proj.IsSingleCatFeature() && ctx->Params.CatFeatureParams->StoreAllSimpleCtrs) {
-        topSize = Max<ui64>();
     }
-    auto leafCount = ComputeReindexHash(topSize, rehashHashTlsVal.GetPtr(), hashArr.begin(), hashArr.begin() + learnSampleCount);
-    for (size_t docOffset = learnSampleCount, testIdx = 0; docOffset < totalSampleCount && testIdx < testDataPtrs.size(); ++testIdx) {
-        const size_t testSampleCount = testDataPtrs[testIdx]->GetSampleCount();
-        leafCount = UpdateReindexHash(rehashHashTlsVal.GetPtr(), hashArr.begin() + docOffset, hashArr.begin() + docOffset + testSampleCount);
-        docOffset += testSampleCount;
+    size_t leafCount;
+    if (useDirectCatIds) {
+        int valueCount = learnData.AllFeatures.CatFeaturesValueCount[proj.CatFeatures[0]];
+        for (const auto testDataPtr : testDataPtrs) {
+            if (testDataPtr->GetSampleCount() > 0) {
+                valueCount = Max(valueCount, testDataPtr->AllFeatures.CatFeaturesValueCount[proj.CatFeatures[0]]);
+            }
+        }
+        leafCount = valueCount;
+    } else if (useSortedReindex) {
+        leafCount = ReindexHashesBySort(hashArr.begin(), hashArr.begin() + totalSampleCount);
+    } else {
+        leafCount = ComputeReindexHash(topSize, rehashHashTlsVal.GetPtr(), hashArr.begin(), hashArr.begin() + learnSampleCount);
+        for (size_t docOffset = learnSampleCount, testIdx = 0; docOffset < totalSampleCount && testIdx < testDataPtrs.size(); ++testIdx) {
+            const size_t testSampleCount = testDataPtrs[testIdx]->GetSampleCount();
+            leafCount = UpdateReindexHash(rehashHashTlsVal.GetPtr(), hashArr.begin() + docOffset, hashArr.begin() + docOffset + testSampleCount);
+            docOffset += testSampleCount;
+        }
     }
     dst->FeatureValueCount = leafCount;
 
@@ -381,8 +422,29 @@ void ComputeOnlineCTRs(const TDataset& learnData,
     int counterCTRDenominator = 0;
     if (AnyOf(ctrInfo.begin(), ctrInfo.begin() + dst->Feature.ysize(), [] (const auto& info) { return info.Type == ECtrType::Counter; })) {
         counterCTRTotal.resize(leafCount);
-        const int sampleCount = ctx->Params.CatFeatureParams->CounterCalcMethod == ECounterCalc::Full ? hashArr.ysize() : learnSampleCount;
-        CountOnlineCTRTotal(hashArr, sampleCount, &counterCTRTotal);
+        const bool fullCount = ctx->Params.CatFeatureParams->CounterCalcMethod == ECounterCalc::Full;
+        if (useDirectCatIds) {
+            // the ids are the remapped values themselves, so the precomputed tables apply directly
+            const int catFeatureIdx = proj.CatFeatures[0];
+            const TVector<int>& learnCounts = learnData.AllFeatures.CatFeaturesPerValueCount[catFeatureIdx];
+            for (int valueId = 0; valueId < learnCounts.ysize(); ++valueId) {
+                counterCTRTotal[valueId] = learnCounts[valueId];
+            }
+            if (fullCount) {
+                for (const auto testDataPtr : testDataPtrs) {
+                    if (testDataPtr->GetSampleCount() == 0) {
+                        continue;
+                    }
+                    const TVector<int>& testCounts = testDataPtr->AllFeatures.CatFeaturesPerValueCount[catFeatureIdx];
+                    for (int valueId = 0; valueId < testCounts.ysize(); ++valueId) {
+                        counterCTRTotal[valueId] += testCounts[valueId];
+                    }
+                }
+            }
+        } else {
+            const int sampleCount = fullCount ? hashArr.ysize() : learnSampleCount;
+            CountOnlineCTRTotal(hashArr, sampleCount, &counterCTRTotal);
+        }
         counterCTRDenominator = *MaxElement(counterCTRTotal.begin(), counterCTRTotal.end());
     }
 
@@ -398,13 +460,13 @@ void ComputeOnlineCTRs(const TDataset& learnData,
 
         for (ui32 border = 0; border < targetBorderCount; ++border) {
             for (int prior = 0; prior < priors.ysize(); ++prior) {
-                Clear(&dst->Feature[ctrIdx][border][prior], totalSampleCount);
+                Clear(&dst->Feature[ctrIdx][border][prior], ctrSampleCount);
             }
         }
 
         if (ctrType == ECtrType::Borders && targetClassesCount == SIMPLE_CLASSES_COUNT) {
             CalcOnlineCTRSimple(
-                testOffsets,
+                ctrOffsets,
                 hashArr,
                 leafCount,
                 fold.LearnTargetClass[classifierId],
@@ -414,7 +476,7 @@ void ComputeOnlineCTRs(const TDataset& learnData,
 
         } else if (ctrType == ECtrType::BinarizedTargetMeanValue) {
             CalcOnlineCTRMean(
-                testOffsets,
+                ctrOffsets,
                 hashArr,
                 leafCount,
                 fold.LearnTargetClass[classifierId],
@@ -426,7 +488,7 @@ void ComputeOnlineCTRs(const TDataset& learnData,
         } else if (ctrType == ECtrType::Buckets ||
                    (ctrType == ECtrType::Borders && targetClassesCount > SIMPLE_CLASSES_COUNT)) {
             CalcOnlineCTRClasses(
-                testOffsets,
+                ctrOffsets,
                 hashArr,
                 leafCount,
                 fold.LearnTargetClass[classifierId],
@@ -439,7 +501,7 @@ void ComputeOnlineCTRs(const TDataset& learnData,
         } else {
             Y_ASSERT(ctrType == ECtrType::Counter);
             CalcOnlineCTRCounter(
-                testOffsets,
+                ctrOffsets,
                 counterCTRTotal,
                 hashArr,
                 counterCTRDenominator,
@@ -13,6 +13,7 @@
 #include <library/threading/local_executor/local_executor.h>
 
 #include <util/generic/maybe.h>
+#include <util/system/atomic.h>
 
 #include <functional>
 
@@ -24,6 +25,9 @@ const int SIMPLE_CLASSES_COUNT = 2;
 struct TOnlineCTR {
     TVector<TArray2D<TVector<ui8>>> Feature; // Feature[ctrIdx][classIdx][priorIdx][docIdx]
     size_t FeatureValueCount = 0;
+    // Recency mark for LRU eviction, updated on every lookup through TFold.
+    // Mutable because reads through the const accessor also count as use.
+    mutable TAtomic LastUsedTick = 0;
 };
 
 using TOnlineCTRHash = THashMap<TProjection, TOnlineCTR>;
@@ -38,12 +42,20 @@ void CalcNormalization(const TVector<float>& priors, TVector<float>* shift, TVec
 class TLearnContext;
 class TDataset;
 
+/*
+ * computeTestTails controls whether CTR values are materialized for the test documents.
+ * Only the averaging fold's test tails are ever read (test indices and approxes are built
+ * from it alone), so the per-permutation learning folds pass false and skip that work; the
+ * test hashes still participate in the reindex either way, so FeatureValueCount and the
+ * resulting model do not depend on the flag.
+ */
 void ComputeOnlineCTRs(const TDataset& learnData,
                        const TDatasetPtrs& testDataPtrs,
                        const TFold& fold,
                        const TProjection& proj,
                        const TLearnContext* ctx,
-                       TOnlineCTR* dst);
+                       TOnlineCTR* dst,
+                       bool computeTestTails);
 
 class TCtrValueTable;
 
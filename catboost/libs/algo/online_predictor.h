@@ -1,5 +1,7 @@
 #pragma once
 
+#include <catboost/libs/helpers/compensated_sum.h>
+
 #include <library/containers/2d_array/2d_array.h>
 
 #include <util/generic/vector.h>
@@ -11,12 +13,23 @@ struct TSum {
     TVector<double> SumDerHistory;
     TVector<double> SumDer2History;
     double SumWeights = 0.0;
+    /* Kahan compensation lanes, allocated only when compensated_accumulation is enabled
+     * (empty == plain accumulation). The running sums above always carry the correction,
+     * so the leaf value formulas read them unchanged.
+     */
+    TVector<double> SumDerCompensation;
+    TVector<double> SumDer2Compensation;
+    double SumWeightsCompensation = 0.0;
 
     TSum() = default;
     explicit TSum(int iterationCount, int approxDimension = 1)
         : SumDerHistory(iterationCount)
         , SumDer2History(iterationCount) {
         Y_ASSERT(approxDimension == 1);
+        if (UseCompensatedAccumulation()) {
+            SumDerCompensation.resize(iterationCount);
+            SumDer2Compensation.resize(iterationCount);
+        }
     }
 
     bool operator==(const TSum& other) const {
@@ -26,17 +39,29 @@ struct TSum {
     }
 
     inline void AddDerWeight(double delta, double weight, int gradientIteration) {
-        SumDerHistory[gradientIteration] += delta;
-        if (gradientIteration == 0) {
-            SumWeights += weight;
+        if (SumDerCompensation.empty()) {
+            SumDerHistory[gradientIteration] += delta;
+            if (gradientIteration == 0) {
+                SumWeights += weight;
+            }
+        } else {
+            AddCompensated(delta, &SumDerHistory[gradientIteration], &SumDerCompensation[gradientIteration]);
+            if (gradientIteration == 0) {
+                AddCompensated(weight, &SumWeights, &SumWeightsCompensation);
+            }
         }
     }
 
     inline void AddDerDer2(double delta, double der2, int gradientIteration) {
-        SumDerHistory[gradientIteration] += delta;
-        SumDer2History[gradientIteration] += der2;
+        if (SumDerCompensation.empty()) {
+            SumDerHistory[gradientIteration] += delta;
+            SumDer2History[gradientIteration] += der2;
+        } else {
+            AddCompensated(delta, &SumDerHistory[gradientIteration], &SumDerCompensation[gradientIteration]);
+            AddCompensated(der2, &SumDer2History[gradientIteration], &SumDer2Compensation[gradientIteration]);
+        }
     }
-    SAVELOAD(SumDerHistory, SumDer2History, SumWeights);
+    SAVELOAD(SumDerHistory, SumDer2History, SumWeights, SumDerCompensation, SumDer2Compensation, SumWeightsCompensation);
 };
 
 struct TSumMulti {
@@ -0,0 +1,60 @@
+#include "pairlogit_helpers.h"
+
+#include "approx_util.h"
+
+#include <catboost/libs/helpers/pairs_util.h>
+#include <catboost/libs/helpers/restorable_rng.h>
+#include <catboost/libs/options/enum_helpers.h>
+#include <catboost/libs/options/loss_description.h>
+
+#include <util/generic/vector.h>
+
+static void ResamplePairsForQuery(
+    const TVector<float>& relevances,
+    int maxPairCount,
+    ui64 randomSeed,
+    TQueryInfo* queryInfo
+) {
+    TRestorableFastRng64 rand(randomSeed);
+    TVector<TPair> pairs;
+    GeneratePairLogitPairsForQuery(queryInfo->Begin, queryInfo->End, relevances, maxPairCount, &rand, &pairs);
+
+    TVector<TVector<TCompetitor>>& competitors = queryInfo->Competitors;
+    competitors.clear();
+    competitors.resize(queryInfo->End - queryInfo->Begin);
+    for (const auto& pair : pairs) {
+        competitors[pair.WinnerId - queryInfo->Begin].emplace_back(pair.LoserId - queryInfo->Begin, pair.Weight);
+    }
+}
+
+bool ShouldResamplePairLogitPairs(const NCatboostOptions::TLossDescription& lossDescription) {
+    return IsPairLogit(lossDescription.GetLossFunction()) &&
+           NCatboostOptions::IsPairResamplingEnabled(lossDescription);
+}
+
+void PairLogitPairsRecalculation(
+    const TFold& ff,
+    const TFold::TBodyTail& bt,
+    const NCatboostOptions::TCatBoostOptions& params,
+    ui64 randomSeed,
+    NPar::TLocalExecutor* localExecutor,
+    TVector<TQueryInfo>* recalculatedQueriesInfo,
+    TVector<float>* recalculatedPairwiseWeights
+) {
+    *recalculatedQueriesInfo = ff.LearnQueriesInfo;
+    const int maxPairCount = NCatboostOptions::GetMaxPairCount(params.LossFunctionDescription);
+
+    // One seed per query: generated pairs must not depend on how queries are blocked over threads.
+    const TVector<ui64> randomSeeds = GenRandUI64Vector(bt.TailQueryFinish, randomSeed);
+    NPar::ParallelFor(*localExecutor, 0, bt.TailQueryFinish, [&](int queryIndex) {
+        ResamplePairsForQuery(
+            ff.LearnTarget,
+            maxPairCount,
+            randomSeeds[queryIndex],
+            &(*recalculatedQueriesInfo)[queryIndex]
+        );
+    });
+
+    recalculatedPairwiseWeights->resize(bt.PairwiseWeights.ysize());
+    CalcPairwiseWeights(*recalculatedQueriesInfo, bt.TailQueryFinish, recalculatedPairwiseWeights);
+}
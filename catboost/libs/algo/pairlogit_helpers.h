@@ -0,0 +1,24 @@
+#pragma once
+
+#include "learn_context.h"
+
+/*
+ * Per-iteration resampling of autogenerated PairLogit pairs
+ * (loss parameter resample_pairs=true).
+ *
+ * Instead of materializing all pairs of a large pool up front, every iteration
+ * draws a fresh max_pairs-bounded sample per query, so pair memory stays bounded
+ * while the full pair space is covered over the course of training.
+ */
+
+bool ShouldResamplePairLogitPairs(const NCatboostOptions::TLossDescription& lossDescription);
+
+void PairLogitPairsRecalculation(
+    const TFold& ff,
+    const TFold::TBodyTail& bt,
+    const NCatboostOptions::TCatBoostOptions& params,
+    ui64 randomSeed,
+    NPar::TLocalExecutor* localExecutor,
+    TVector<TQueryInfo>* recalculatedQueriesInfo,
+    TVector<float>* recalculatedPairwiseWeights
+);
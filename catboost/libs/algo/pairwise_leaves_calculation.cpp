@@ -2,11 +2,134 @@
 
 #include <catboost/libs/helpers/matrix.h>
 
+#include <util/generic/ymath.h>
+
+// The dense Cholesky factorization costs leaves^3 while the pair graph connects only
+// leaves that actually share a pair, so above this many leaves (depth > 8) conjugate
+// gradient on the sparse system is used instead.
+static const int SparsePairwiseSolverLeafCountThreshold = 256;
+
+namespace {
+    /* Compressed rows of the reduced pairwise system: `pairwiseWeightSums` without its
+     * last row and column, keeping only the off-diagonal nonzeros. The uniform prior
+     * that the dense path adds to every off-diagonal cell is rank-one and is applied
+     * analytically in the matrix-vector product as NonDiagReg * (sum(vec) - vec[row]).
+     */
+    struct TSparsePairwiseSystem {
+        TVector<double> Diag; // [row], with the diagonal regularization applied
+        TVector<ui32> RowStarts; // [row + 1]
+        TVector<ui32> ColumnIndices;
+        TVector<double> Values;
+        double NonDiagReg = 0.0;
+    };
+}
+
+static TSparsePairwiseSystem BuildSparsePairwiseSystem(
+    const TArray2D<double>& pairwiseWeightSums,
+    double diagReg,
+    double nonDiagReg,
+    int reducedSize
+) {
+    TSparsePairwiseSystem system;
+    system.NonDiagReg = nonDiagReg;
+    system.Diag.yresize(reducedSize);
+    system.RowStarts.yresize(reducedSize + 1);
+    system.RowStarts[0] = 0;
+    for (int y = 0; y < reducedSize; ++y) {
+        system.Diag[y] = pairwiseWeightSums[y][y] + diagReg;
+        for (int x = 0; x < reducedSize; ++x) {
+            if (x != y && pairwiseWeightSums[y][x] != 0.0) {
+                system.ColumnIndices.push_back(x);
+                system.Values.push_back(pairwiseWeightSums[y][x]);
+            }
+        }
+        system.RowStarts[y + 1] = system.ColumnIndices.size();
+    }
+    return system;
+}
+
+static void MultiplySparsePairwiseSystem(
+    const TSparsePairwiseSystem& system,
+    const TVector<double>& vec,
+    NPar::TLocalExecutor* localExecutor,
+    TVector<double>* result
+) {
+    const int reducedSize = system.Diag.ysize();
+    double vecSum = 0.0;
+    for (double value : vec) {
+        vecSum += value;
+    }
+    const auto multiplyRows = [&](int rowBegin, int rowEnd) {
+        for (int y = rowBegin; y < rowEnd; ++y) {
+            double rowSum = system.Diag[y] * vec[y] + system.NonDiagReg * (vecSum - vec[y]);
+            for (ui32 idx = system.RowStarts[y]; idx < system.RowStarts[y + 1]; ++idx) {
+                rowSum += system.Values[idx] * vec[system.ColumnIndices[idx]];
+            }
+            (*result)[y] = rowSum;
+        }
+    };
+    if (localExecutor == nullptr) {
+        multiplyRows(0, reducedSize);
+        return;
+    }
+    NPar::TLocalExecutor::TExecRangeParams blockParams(0, reducedSize);
+    blockParams.SetBlockCount(localExecutor->GetThreadCount() + 1);
+    localExecutor->ExecRange([&](int blockId) {
+        const int rowBegin = blockId * blockParams.GetBlockSize();
+        multiplyRows(rowBegin, Min(rowBegin + blockParams.GetBlockSize(), reducedSize));
+    }, 0, blockParams.GetBlockCount(), NPar::TLocalExecutor::WAIT_COMPLETE);
+}
+
+/* Conjugate gradient for the reduced pairwise system. The system is symmetric positive
+ * definite (a Laplacian principal submatrix plus the positive diagonal regularization),
+ * so the iteration converges in at most reducedSize steps; in practice the residual
+ * tolerance stops it after a few dozen.
+ */
+static void SolvePairwiseSystemConjugateGradient(
+    const TSparsePairwiseSystem& system,
+    NPar::TLocalExecutor* localExecutor,
+    TVector<double>* target
+) {
+    const int reducedSize = system.Diag.ysize();
+    TVector<double> solution(reducedSize, 0.0);
+    TVector<double> residual(*target); // residual of the zero initial solution
+    TVector<double> direction(residual);
+    TVector<double> matrixDirection(reducedSize);
+
+    double residualNorm2 = 0.0;
+    for (double value : residual) {
+        residualNorm2 += value * value;
+    }
+    const double toleranceNorm2 = Sqr(1e-10) * residualNorm2;
+
+    for (int iteration = 0; iteration < reducedSize && residualNorm2 > toleranceNorm2; ++iteration) {
+        MultiplySparsePairwiseSystem(system, direction, localExecutor, &matrixDirection);
+        double directionProduct = 0.0;
+        for (int y = 0; y < reducedSize; ++y) {
+            directionProduct += direction[y] * matrixDirection[y];
+        }
+        const double stepSize = residualNorm2 / directionProduct;
+        double nextResidualNorm2 = 0.0;
+        for (int y = 0; y < reducedSize; ++y) {
+            solution[y] += stepSize * direction[y];
+            residual[y] -= stepSize * matrixDirection[y];
+            nextResidualNorm2 += residual[y] * residual[y];
+        }
+        const double directionFactor = nextResidualNorm2 / residualNorm2;
+        for (int y = 0; y < reducedSize; ++y) {
+            direction[y] = residual[y] + directionFactor * direction[y];
+        }
+        residualNorm2 = nextResidualNorm2;
+    }
+    *target = std::move(solution);
+}
+
 TVector<double> CalculatePairwiseLeafValues(
     const TArray2D<double>& pairwiseWeightSums,
     const TVector<double>& derSums,
     float l2DiagReg,
-    float pairwiseBucketWeightPriorReg
+    float pairwiseBucketWeightPriorReg,
+    NPar::TLocalExecutor* localExecutor
 ) {
     Y_ASSERT(pairwiseWeightSums.GetXSize() > 1);
     Y_ASSERT(pairwiseWeightSums.GetXSize() == pairwiseWeightSums.GetYSize());
@@ -29,6 +152,16 @@ TVector<double> CalculatePairwiseLeafValues(
         return res;
     }
 
+    if (systemSize > SparsePairwiseSolverLeafCountThreshold) {
+        const TSparsePairwiseSystem system = BuildSparsePairwiseSystem(pairwiseWeightSums, diagReg, nonDiagReg, systemSize - 1);
+        res = derSums;
+        res.pop_back();
+        SolvePairwiseSystemConjugateGradient(system, localExecutor, &res);
+        res.push_back(0.0);
+        MakeZeroAverage(&res);
+        return res;
+    }
+
     TVector<double> systemMatrix((systemSize - 1) * (systemSize - 1));
     // Copy only upper triangular of the matrix as it is symmetric and another half is not referenced in potrf.
     for (int y = 0; y < systemSize - 1; ++y) {
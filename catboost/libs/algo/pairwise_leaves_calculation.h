@@ -4,14 +4,20 @@
 #include <catboost/libs/options/restrictions.h>
 
 #include <library/containers/2d_array/2d_array.h>
+#include <library/threading/local_executor/local_executor.h>
 
 #include <util/generic/fwd.h>
 
+/// Solve the pairwise leaf system for leaf deltas. Small systems are solved with a dense
+/// Cholesky factorization; above a leaf-count threshold the solver switches to conjugate
+/// gradient on the sparsity pattern of `pairwiseWeightSums`, with the matrix-vector
+/// products parallelized over rows by `localExecutor` (nullptr == single thread).
 TVector<double> CalculatePairwiseLeafValues(
     const TArray2D<double>& pairwiseWeightSums,
     const TVector<double>& derSums,
     float l2DiagReg,
-    float pairwiseBucketWeightPriorReg
+    float pairwiseBucketWeightPriorReg,
+    NPar::TLocalExecutor* localExecutor = nullptr
 );
 
 TArray2D<double> ComputePairwiseWeightSums(
@@ -20,4 +26,3 @@ TArray2D<double> ComputePairwiseWeightSums(
     int querycount,
     const TVector<TIndexType>& indices
 );
-
@@ -1,48 +1,47 @@
 #include "pairwise_scoring.h"
 #include "pairwise_leaves_calculation.h"
 
-TVector<TVector<double>> ComputeDerSums(
+TVector<double> ComputeDerSums(
     TConstArrayRef<double> weightedDerivativesData,
     int leafCount,
     int bucketCount,
     const TVector<ui32>& leafIndices,
     const TVector<ui32>& bucketIndices
 ) {
-    TVector<TVector<double>> derSums(leafCount, TVector<double>(bucketCount));
+    TVector<double> derSums((size_t)leafCount * bucketCount);
     for (size_t docId = 0; docId < weightedDerivativesData.size(); ++docId) {
-        derSums[leafIndices[docId]][bucketIndices[docId]] += weightedDerivativesData[docId];
+        derSums[leafIndices[docId] * (size_t)bucketCount + bucketIndices[docId]] += weightedDerivativesData[docId];
     }
     return derSums;
 }
 
-TArray2D<TVector<TBucketPairWeightStatistics>> ComputePairWeightStatistics(
+TPairWeightStatsMatrix ComputePairWeightStatistics(
     const TVector<TQueryInfo>& queriesInfo,
     int leafCount,
     int bucketCount,
     const TVector<ui32>& leafIndices,
     const TVector<ui32>& bucketIndices
 ) {
-    TArray2D<TVector<TBucketPairWeightStatistics>> pairWeightStatistics(leafCount, leafCount);
-    pairWeightStatistics.FillEvery(TVector<TBucketPairWeightStatistics>(bucketCount));
+    TPairWeightStatsMatrix pairWeightStatistics(leafCount, bucketCount);
     for (int queryId = 0; queryId < queriesInfo.ysize(); ++queryId) {
         const TQueryInfo& queryInfo = queriesInfo[queryId];
         const int begin = queryInfo.Begin;
         const int end = queryInfo.End;
         for (int docId = begin; docId < end; ++docId) {
+            const int winnerBucketId = bucketIndices[docId];
+            const int winnerLeafId = leafIndices[docId];
             for (const auto& pair : queryInfo.Competitors[docId - begin]) {
-                const int winnerBucketId = bucketIndices[docId];
                 const int loserBucketId = bucketIndices[begin + pair.Id];
-                const int winnerLeafId = leafIndices[docId];
                 const int loserLeafId = leafIndices[begin + pair.Id];
                 if (winnerBucketId == loserBucketId && winnerLeafId == loserLeafId) {
                     continue;
                 }
-                auto& bucketStatisticDirect = pairWeightStatistics[winnerLeafId][loserLeafId];
-                auto& bucketStatisticReverse = pairWeightStatistics[loserLeafId][winnerLeafId];
                 if (winnerBucketId > loserBucketId) {
+                    auto* bucketStatisticReverse = pairWeightStatistics.GetRow(loserLeafId, winnerLeafId);
                     bucketStatisticReverse[loserBucketId].SmallerBorderWeightSum -= pair.SampleWeight;
                     bucketStatisticReverse[winnerBucketId].GreaterBorderRightWeightSum -= pair.SampleWeight;
                 } else {
+                    auto* bucketStatisticDirect = pairWeightStatistics.GetRow(winnerLeafId, loserLeafId);
                     bucketStatisticDirect[loserBucketId].GreaterBorderRightWeightSum -= pair.SampleWeight;
                     bucketStatisticDirect[winnerBucketId].SmallerBorderWeightSum -= pair.SampleWeight;
                 }
@@ -64,15 +63,15 @@ static double CalculateScore(const TVector<double>& avrg, const TVector<double>&
 }
 
 void EvaluateBucketScores(
-    const TVector<TVector<double>>& derSums,
-    const TArray2D<TVector<TBucketPairWeightStatistics>>& pairWeightStatistics,
+    const TVector<double>& derSums,
+    const TPairWeightStatsMatrix& pairWeightStatistics,
+    int leafCount,
     int bucketCount,
     ESplitType splitType,
     float l2DiagReg,
     float pairwiseBucketWeightPriorReg,
     TVector<TScoreBin>* scoreBins
 ) {
-    const int leafCount = derSums.ysize();
     TVector<double> derSum(2 * leafCount, 0.0);
     TArray2D<double> weightSum(2 * leafCount, 2 * leafCount);
     weightSum.FillZero();
@@ -80,14 +79,14 @@ void EvaluateBucketScores(
 
     for (int leafId = 0; leafId < leafCount; ++leafId) {
         for (int bucketId = 0; bucketId < bucketCount; ++bucketId) {
-            derSum[2 * leafId + 1] += derSums[leafId][bucketId];
+            derSum[2 * leafId + 1] += derSums[leafId * (size_t)bucketCount + bucketId];
         }
     }
 
     for (int y = 0; y < leafCount; ++y) {
         for (int x = y + 1; x < leafCount; ++x) {
-            const TVector<TBucketPairWeightStatistics>& xy = pairWeightStatistics[x][y];
-            const TVector<TBucketPairWeightStatistics>& yx = pairWeightStatistics[y][x];
+            const TBucketPairWeightStatistics* xy = pairWeightStatistics.GetRow(x, y);
+            const TBucketPairWeightStatistics* yx = pairWeightStatistics.GetRow(y, x);
             for (int bucketId = 0; bucketId < bucketCount; ++bucketId) {
                 const double add = yx[bucketId].SmallerBorderWeightSum + xy[bucketId].SmallerBorderWeightSum;
                 weightSum[2 * y + 1][2 * x + 1] += add;
@@ -100,19 +99,19 @@ void EvaluateBucketScores(
 
     for (int splitId = 0; splitId < bucketCount - 1; ++splitId) {
         for (int y = 0; y < leafCount; ++y) {
-            const double derDelta = derSums[y][splitId];
+            const double derDelta = derSums[y * (size_t)bucketCount + splitId];
             derSum[2 * y] += derDelta;
             derSum[2 * y + 1] -= derDelta;
 
-            const double weightDelta = (pairWeightStatistics[y][y][splitId].SmallerBorderWeightSum -
-                pairWeightStatistics[y][y][splitId].GreaterBorderRightWeightSum);
+            const TBucketPairWeightStatistics& yyStats = pairWeightStatistics.GetRow(y, y)[splitId];
+            const double weightDelta = yyStats.SmallerBorderWeightSum - yyStats.GreaterBorderRightWeightSum;
             weightSum[2 * y][2 * y + 1] += weightDelta;
             weightSum[2 * y + 1][2 * y] += weightDelta;
             weightSum[2 * y][2 * y] -= weightDelta;
             weightSum[2 * y + 1][2 * y + 1] -= weightDelta;
             for (int x = y + 1; x < leafCount; ++x) {
-                const TBucketPairWeightStatistics& xy = pairWeightStatistics[x][y][splitId];
-                const TBucketPairWeightStatistics& yx = pairWeightStatistics[y][x][splitId];
+                const TBucketPairWeightStatistics& xy = pairWeightStatistics.GetRow(x, y)[splitId];
+                const TBucketPairWeightStatistics& yx = pairWeightStatistics.GetRow(y, x)[splitId];
 
                 const double w00Delta = xy.GreaterBorderRightWeightSum + yx.GreaterBorderRightWeightSum;
                 const double w01Delta = xy.SmallerBorderWeightSum - xy.GreaterBorderRightWeightSum;
@@ -140,4 +139,3 @@ void EvaluateBucketScores(
         (*scoreBins)[splitId].DP = CalculateScore(leafValues, derSum, weightSum);
     }
 }
-
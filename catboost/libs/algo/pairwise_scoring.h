@@ -10,7 +10,32 @@ struct TBucketPairWeightStatistics {
     double GreaterBorderRightWeightSum = 0.0; // The weight sum of pair elements with greater border.
 };
 
-TVector<TVector<double>> ComputeDerSums(
+// Pair weight statistics for every (winnerLeafId, loserLeafId, bucketId) triple stored in
+// a single allocation. Scoring runs one candidate per thread, so keeping the whole matrix
+// in one contiguous block avoids leafCount^2 small allocations per scored candidate
+// (allocator contention at high thread counts) and keeps bucket rows cache-friendly.
+struct TPairWeightStatsMatrix {
+    int LeafCount = 0;
+    int BucketCount = 0;
+    TVector<TBucketPairWeightStatistics> Data; // [winnerLeafId][loserLeafId][bucketId]
+
+    TPairWeightStatsMatrix(int leafCount, int bucketCount)
+        : LeafCount(leafCount)
+        , BucketCount(bucketCount)
+        , Data((size_t)leafCount * leafCount * bucketCount)
+    {
+    }
+
+    TBucketPairWeightStatistics* GetRow(int winnerLeafId, int loserLeafId) {
+        return Data.data() + ((size_t)winnerLeafId * LeafCount + loserLeafId) * BucketCount;
+    }
+    const TBucketPairWeightStatistics* GetRow(int winnerLeafId, int loserLeafId) const {
+        return Data.data() + ((size_t)winnerLeafId * LeafCount + loserLeafId) * BucketCount;
+    }
+};
+
+/// @return derivative sums in [leafId * bucketCount + bucketId] layout.
+TVector<double> ComputeDerSums(
     TConstArrayRef<double> weightedDerivativesData,
     int leafCount,
     int bucketCount,
@@ -18,7 +43,7 @@ TVector<TVector<double>> ComputeDerSums(
     const TVector<ui32>& bucketIndices
 );
 
-TArray2D<TVector<TBucketPairWeightStatistics>> ComputePairWeightStatistics(
+TPairWeightStatsMatrix ComputePairWeightStatistics(
     const TVector<TQueryInfo>& queriesInfo,
     int leafCount,
     int bucketCount,
@@ -27,8 +52,9 @@ TArray2D<TVector<TBucketPairWeightStatistics>> ComputePairWeightStatistics(
 );
 
 void EvaluateBucketScores(
-    const TVector<TVector<double>>& derSums,
-    const TArray2D<TVector<TBucketPairWeightStatistics>>& pairWeightStatistics,
+    const TVector<double>& derSums,
+    const TPairWeightStatsMatrix& pairWeightStatistics,
+    int leafCount,
     int bucketCount,
     ESplitType splitType,
     float l2DiagReg,
@@ -55,7 +81,7 @@ inline void CalculatePairwiseScore(
         bucketIndices[docId] = singleIdx[docId] % bucketCount;
     }
 
-    const TVector<TVector<double>> derSums = ComputeDerSums(weightedDerivativesData, leafCount, bucketCount, leafIndices, bucketIndices);
-    const TArray2D<TVector<TBucketPairWeightStatistics>> pairWeightStatistics = ComputePairWeightStatistics(queriesInfo, leafCount, bucketCount, leafIndices, bucketIndices);
-    EvaluateBucketScores(derSums, pairWeightStatistics, bucketCount, splitType, l2DiagReg, pairwiseBucketWeightPriorReg, scoreBins);
+    const TVector<double> derSums = ComputeDerSums(weightedDerivativesData, leafCount, bucketCount, leafIndices, bucketIndices);
+    const TPairWeightStatsMatrix pairWeightStatistics = ComputePairWeightStatistics(queriesInfo, leafCount, bucketCount, leafIndices, bucketIndices);
+    EvaluateBucketScores(derSums, pairWeightStatistics, leafCount, bucketCount, splitType, l2DiagReg, pairwiseBucketWeightPriorReg, scoreBins);
 }
@@ -5,6 +5,9 @@
 #include <catboost/libs/options/loss_description.h>
 #include <catboost/libs/model/model_pool_compatibility.h>
 
+#include <library/blockcodecs/codecs.h>
+#include <library/blockcodecs/stream.h>
+#include <library/threading/future/async.h>
 #include <library/threading/local_executor/local_executor.h>
 
 TMetricsPlotCalcer::TMetricsPlotCalcer(
@@ -166,13 +169,32 @@ TMetricsPlotCalcer& TMetricsPlotCalcer::FinishProceedDataSetForNonAdditiveMetric
     return *this;
 }
 
+// Approx snapshots are close to incompressible noise in the low mantissa bits but the
+// exponents and signs repeat heavily, so lz4 still shrinks them severalfold at a speed
+// far above the disk; block size bounds the codec's working buffer.
+static const size_t ApproxSnapshotBlockSize = 1 << 20;
+
+static const NBlockCodecs::ICodec* ApproxSnapshotCodec() {
+    return NBlockCodecs::Codec("lz4");
+}
+
 static void Load(ui32 docCount, IInputStream* input, TVector<TVector<double>>* output) {
-    TVector<double> line;
-    for (ui32 i = 0; i < docCount; ++i) {
-        ::Load(input, line);
+    TVector<double> dimBuffer;
+    ui32 loadedDocCount = 0;
+    while (loadedDocCount < docCount) {
+        /* Each appended frame is a self-contained coded stream; draining the decoder past
+         * its end-of-stream marker leaves the file positioned at the next frame.
+         */
+        NBlockCodecs::TDecodedInput frameInput(input);
+        ui32 frameDocCount = 0;
         for (ui32 dim = 0; dim < output->size(); ++dim) {
-            (*output)[dim][i] = line[dim];
+            ::Load(&frameInput, dimBuffer);
+            frameDocCount = dimBuffer.size();
+            CB_ENSURE(loadedDocCount + frameDocCount <= docCount, "Corrupted approx snapshot file");
+            std::copy(dimBuffer.begin(), dimBuffer.end(), (*output)[dim].begin() + loadedDocCount);
         }
+        CB_ENSURE(frameInput.Skip(1) == 0, "Corrupted approx snapshot file");
+        loadedDocCount += frameDocCount;
     }
 }
 
@@ -237,14 +259,30 @@ TMetricsPlotCalcer& TMetricsPlotCalcer::ProceedDataSet(
 void TMetricsPlotCalcer::ComputeNonAdditiveMetrics(ui32 begin, ui32 end) {
     const auto& target = NonAdditiveMetricsData.Target;
     const auto& weights = NonAdditiveMetricsData.Weights;
+    if (begin >= end) {
+        return;
+    }
+
+    // Loading a step's approx snapshot is pure IO, so the next step's snapshot is read in
+    // background while the metrics of the current step are computed.
+    TMtpQueue loaderQueue;
+    loaderQueue.Start(1);
+
+    auto approx = LoadApprox(begin);
     for (ui32 idx = begin; idx < end; ++idx) {
-        auto approx = LoadApprox(idx);
+        NThreading::TFuture<TVector<TVector<double>>> nextApprox;
+        if (idx + 1 < end) {
+            nextApprox = NThreading::Async([this, idx]() { return LoadApprox(idx + 1); }, loaderQueue);
+        }
         for (ui32 metricId = 0; metricId < NonAdditiveMetrics.size(); ++metricId) {
             NonAdditiveMetricPlots[metricId][idx] = NonAdditiveMetrics[metricId]->Eval(approx, target, weights, {}, 0, target.size(), Executor);
         }
         if (idx != 0) {
             DeleteApprox(idx - 1);
         }
+        if (idx + 1 < end) {
+            approx = nextApprox.ExtractValueSync();
+        }
     }
 }
 
@@ -341,17 +379,19 @@ TString TMetricsPlotCalcer::GetApproxFileName(ui32 plotLineIndex) {
 void TMetricsPlotCalcer::SaveApproxToFile(ui32 plotLineIndex,
                                           const TVector<TVector<double>>& approx) {
     auto fileName = GetApproxFileName(plotLineIndex);
-    ui32 docCount = approx[0].size();
     TFile file(fileName, EOpenModeFlag::ForAppend | EOpenModeFlag::OpenAlways);
     TOFStream out(file);
-    TVector<double> line(approx.size());
 
-    for (ui32 i = 0; i < docCount; ++i) {
-        for (ui32 dim = 0; dim < approx.size(); ++dim) {
-            line[dim] = approx[dim][i];
-        }
-        ::Save(&out, line);
+    /* One contiguous frame per dimension instead of a length-prefixed line per document:
+     * sequential writes, no per-document metadata, and loading copies whole dimensions.
+     * The frame is lz4-compressed on the way out so spilling one snapshot per plot line
+     * does not need docCount * dims * sizeof(double) of disk per line.
+     */
+    NBlockCodecs::TCodedOutput codedOut(&out, ApproxSnapshotCodec(), ApproxSnapshotBlockSize);
+    for (const auto& dimApprox : approx) {
+        ::Save(&codedOut, dimApprox);
     }
+    codedOut.Finish();
 }
 
 TVector<TVector<double>> TMetricsPlotCalcer::LoadApprox(ui32 plotLineIndex) {
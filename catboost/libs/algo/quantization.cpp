@@ -1,10 +1,14 @@
 #include "quantization.h"
+#include "feature_bundling.h"
+#include "feature_packing.h"
+#include "quantization_cache.h"
 #include "split.h"
 
 #include <catboost/libs/helpers/mem_usage.h>
 #include <catboost/libs/data/load_data.h>
 
 #include <library/threading/local_executor/local_executor.h>
+#include <util/digest/city.h>
 #include <util/generic/set.h>
 #include <util/generic/xrange.h>
 #include <util/generic/algorithm.h>
@@ -23,7 +27,7 @@ static inline bool IsConstCatValue(int featureIdx, const TDocumentStorage& docSt
     if (docCount == 0) {
         return true;
     }
-    const TVector<float>& src = docStorage.Factors[featureIdx];
+    const TConstArrayRef<float> src = docStorage.GetFactorRef(featureIdx);
     int src0 = ConvertFloatCatFeatureToIntHash(src[docSelector(0)]);
     for (size_t i = 1; i < docCount; ++i) {
         if (ConvertFloatCatFeatureToIntHash(src[docSelector(i)]) != src0) {
@@ -41,7 +45,7 @@ static inline void BinarizeCatFeature(int featureIdx,
                                       int catFeatureIdx,
                                       TAllFeatures* features) {
     size_t docCount = docSelector.GetDocCount();
-    const TVector<float>& src = docStorage.Factors[featureIdx];
+    const TConstArrayRef<float> src = docStorage.GetFactorRef(featureIdx);
     TVector<int>& dstRemapped = features->CatFeaturesRemapped[catFeatureIdx];
     TVector<int>& dstValues = features->OneHotValues[catFeatureIdx];
     bool dstIsOneHot = features->IsOneHot[catFeatureIdx];
@@ -110,7 +114,7 @@ static inline void BinarizeFloatFeature(const TFloatFeature& floatFeature,
                                         TAllFeatures* features,
                                         bool* seenNans) {
     size_t docCount = docSelector.GetDocCount();
-    const TVector<float>& src = docStorage.Factors[floatFeature.FlatFeatureIndex];
+    const TConstArrayRef<float> src = docStorage.GetFactorRef(floatFeature.FlatFeatureIndex);
     TVector<ui8>& hist = features->FloatHistograms[floatFeature.FeatureIndex];
 
     hist.resize(docCount);
@@ -176,6 +180,190 @@ static void CleanupOneHotFeatures(size_t oneHotMaxSize, TAllFeatures* features)
     }
 }
 
+/*
+ * Frequency-based pruning of one-hot split candidates: values seen fewer than
+ * `oneHotMinCount` times in the learn set are merged into the implicit "other" bin that
+ * test-time binarization already uses for unseen values. UpdateScoreBin never scores the
+ * last bucket of a one-hot feature as a split, so the merged values stop producing split
+ * candidates and histogram buckets while still contributing to the complement statistics
+ * of every scored split.
+ */
+static void PruneRareOneHotValues(size_t oneHotMinCount, TAllFeatures* features) {
+    if (oneHotMinCount < 2) {
+        return;
+    }
+    for (int catFeatureIdx = 0; catFeatureIdx < features->OneHotValues.ysize(); ++catFeatureIdx) {
+        if (!features->IsOneHot[catFeatureIdx] || features->CatFeaturesRemapped[catFeatureIdx].empty()) {
+            continue;
+        }
+        TVector<int>& remapped = features->CatFeaturesRemapped[catFeatureIdx];
+        TVector<int>& values = features->OneHotValues[catFeatureIdx];
+        TVector<size_t> valueCounts(values.size(), 0);
+        for (int bin : remapped) {
+            ++valueCounts[bin];
+        }
+        TVector<int> newBins(values.size());
+        TVector<int> keptValues;
+        for (size_t bin = 0; bin < values.size(); ++bin) {
+            if (valueCounts[bin] >= oneHotMinCount) {
+                newBins[bin] = keptValues.ysize();
+                keptValues.push_back(values[bin]);
+            } else {
+                newBins[bin] = -1;
+            }
+        }
+        if (keptValues.empty() || keptValues.size() == values.size()) {
+            // nothing frequent to keep or nothing rare to merge, leave the feature as is
+            continue;
+        }
+        const int otherBin = keptValues.ysize();
+        for (int& bin : remapped) {
+            bin = newBins[bin] >= 0 ? newBins[bin] : otherBin;
+        }
+        MATRIXNET_INFO_LOG << "one-hot cat feature " << catFeatureIdx << ": merged "
+            << values.size() - keptValues.size() << " of " << values.size()
+            << " values into the aggregated bin" << Endl;
+        values = std::move(keptValues);
+    }
+}
+
+/*
+ * Collapse exactly duplicated quantized columns. Feature factories routinely emit the same
+ * signal under several names; after binarization such columns have identical bin vectors,
+ * so keeping more than one only multiplies histogram cost. A duplicate's bins are freed,
+ * which makes downstream passes and test binarization skip it the same way they skip
+ * constant features with no borders. `duplicateAliases` records per flat feature index
+ * which kept feature the collapsed column mirrored (-1 for features left in place) and
+ * stays empty when there are no duplicates.
+ */
+/*
+ * Eagerly builds the per-(cat feature, value id) document count tables and the per-feature
+ * value id counts, one feature per task. Doing this once at dataset build keeps the first
+ * training iterations from paying for it inside online ctr calculation.
+ */
+static void ComputeCatFeatureValueStats(NPar::TLocalExecutor& localExecutor, TAllFeatures* features) {
+    const int catFeatureCount = features->CatFeaturesRemapped.ysize();
+    features->CatFeaturesValueCount.assign(catFeatureCount, 0);
+    features->CatFeaturesPerValueCount.assign(catFeatureCount, TVector<int>());
+    if (catFeatureCount == 0) {
+        return;
+    }
+    localExecutor.ExecRange([&](int catFeatureIdx) {
+        const TVector<int>& remapped = features->CatFeaturesRemapped[catFeatureIdx];
+        if (remapped.empty()) { // ignored or redundant features have no values
+            return;
+        }
+        int valueCount = 0;
+        for (int value : remapped) {
+            valueCount = Max(valueCount, value + 1);
+        }
+        TVector<int>& perValueCount = features->CatFeaturesPerValueCount[catFeatureIdx];
+        perValueCount.assign(valueCount, 0);
+        for (int value : remapped) {
+            ++perValueCount[value];
+        }
+        features->CatFeaturesValueCount[catFeatureIdx] = valueCount;
+    }, 0, catFeatureCount, NPar::TLocalExecutor::WAIT_COMPLETE);
+}
+
+static void CollapseDuplicateFeatures(const THashSet<int>& categFeatures,
+                                      int featureCount,
+                                      NPar::TLocalExecutor& localExecutor,
+                                      TAllFeatures* features,
+                                      TVector<int>* duplicateAliases) {
+    TVector<size_t> typedFeatureIdx(featureCount);
+    {
+        size_t catFeatureCount = 0;
+        size_t floatFeatureCount = 0;
+        for (int featureIdx = 0; featureIdx < featureCount; ++featureIdx) {
+            typedFeatureIdx[featureIdx] = categFeatures.has(featureIdx) ? catFeatureCount++ : floatFeatureCount++;
+        }
+    }
+
+    // hash the bin vectors first and compare exact content only within equal-hash buckets
+    TVector<ui64> contentHashes(featureCount, 0);
+    localExecutor.ExecRange([&](int featureIdx) {
+        const size_t typedIdx = typedFeatureIdx[featureIdx];
+        if (categFeatures.has(featureIdx)) {
+            const TVector<int>& remapped = features->CatFeaturesRemapped[typedIdx];
+            if (remapped.empty()) {
+                return;
+            }
+            const ui64 remapHash = CityHash64WithSeed(reinterpret_cast<const char*>(remapped.data()),
+                                                      remapped.size() * sizeof(int), /*seed=*/1);
+            const TVector<int>& values = features->OneHotValues[typedIdx];
+            contentHashes[featureIdx] = CityHash64WithSeed(reinterpret_cast<const char*>(values.data()),
+                                                           values.size() * sizeof(int), remapHash);
+        } else {
+            const TVector<ui8>& hist = features->FloatHistograms[typedIdx];
+            if (hist.empty()) {
+                return;
+            }
+            contentHashes[featureIdx] = CityHash64WithSeed(reinterpret_cast<const char*>(hist.data()),
+                                                           hist.size(), /*seed=*/2);
+        }
+    }, NPar::TLocalExecutor::TExecRangeParams(0, featureCount), NPar::TLocalExecutor::WAIT_COMPLETE);
+
+    THashMap<ui64, TVector<int>> hashBuckets;
+    for (int featureIdx = 0; featureIdx < featureCount; ++featureIdx) {
+        if (contentHashes[featureIdx] != 0) {
+            hashBuckets[contentHashes[featureIdx]].push_back(featureIdx);
+        }
+    }
+
+    TVector<int> aliasOf(featureCount, -1);
+    int collapsedCount = 0;
+    for (const auto& bucket : hashBuckets) {
+        const TVector<int>& candidates = bucket.second;
+        for (size_t i = 1; i < candidates.size(); ++i) {
+            const int featureIdx = candidates[i];
+            const size_t typedIdx = typedFeatureIdx[featureIdx];
+            for (size_t j = 0; j < i; ++j) {
+                const int keptIdx = candidates[j];
+                if (aliasOf[keptIdx] != -1) { // already collapsed into an earlier feature
+                    continue;
+                }
+                if (categFeatures.has(featureIdx) != categFeatures.has(keptIdx)) {
+                    continue;
+                }
+                const size_t keptTypedIdx = typedFeatureIdx[keptIdx];
+                bool equal;
+                if (categFeatures.has(featureIdx)) {
+                    equal = features->CatFeaturesRemapped[typedIdx] == features->CatFeaturesRemapped[keptTypedIdx]
+                        && features->OneHotValues[typedIdx] == features->OneHotValues[keptTypedIdx]
+                        && features->IsOneHot[typedIdx] == features->IsOneHot[keptTypedIdx];
+                } else {
+                    equal = features->FloatHistograms[typedIdx] == features->FloatHistograms[keptTypedIdx];
+                }
+                if (!equal) {
+                    continue;
+                }
+                if (categFeatures.has(featureIdx)) {
+                    ClearVector(&features->CatFeaturesRemapped[typedIdx]);
+                    ClearVector(&features->OneHotValues[typedIdx]);
+                    if (!features->CatFeaturesPerValueCount.empty()) {
+                        ClearVector(&features->CatFeaturesPerValueCount[typedIdx]);
+                        features->CatFeaturesValueCount[typedIdx] = 0;
+                    }
+                } else {
+                    ClearVector(&features->FloatHistograms[typedIdx]);
+                }
+                aliasOf[featureIdx] = keptIdx;
+                ++collapsedCount;
+                MATRIXNET_INFO_LOG << "feature " << featureIdx << " duplicates feature " << keptIdx
+                    << ", dropping its quantized column" << Endl;
+                break;
+            }
+        }
+    }
+    if (collapsedCount > 0) {
+        MATRIXNET_INFO_LOG << "collapsed " << collapsedCount << " duplicated feature columns" << Endl;
+        if (duplicateAliases) {
+            *duplicateAliases = std::move(aliasOf);
+        }
+    }
+}
+
 namespace {
     /// Select all documents in range [0, docCount).
     class TSelectAll {
@@ -261,7 +449,10 @@ namespace {
                     }
                 } else {
                     auto floatFeatureIdx = TypedFeatureIdx[featureIdx];
-                    if (learnFeatures.FloatHistograms[floatFeatureIdx].empty()) {
+                    if (learnFeatures.FloatHistograms[floatFeatureIdx].empty() &&
+                        !learnFeatures.IsBundledFloatFeature(floatFeatureIdx) &&
+                        !learnFeatures.IsPackedFloatFeature(floatFeatureIdx))
+                    {
                         IgnoredFeatures.insert(featureIdx);
                     }
                 }
@@ -269,12 +460,18 @@ namespace {
         }
 
         /// Perform binarization of `docStorage` into `features`.
+        /// If `fullFloatHistograms` is provided, float bins are gathered from it by
+        /// `selectedDocIndices` instead of being recomputed from the raw values.
         void Binarize(bool allowNans,
                       TDocumentStorage* docStorage,
                       const TVector<size_t>& selectedDocIndices,
+                      const TVector<TVector<ui8>>* fullFloatHistograms,
                       bool clearPool,
                       TAllFeatures* features) const {
 
+            // borrowed factor columns are caller-owned, there is nothing to free
+            clearPool = clearPool && !docStorage->HasExternalFactors();
+
             auto binarizeBlockOfFeatures = [&](int blockId) {
                 int lastFeatureIdx = Min((blockId + 1) * BlockSize, FeatureCount);
                 for (int featureIdx = blockId * BlockSize; featureIdx  < lastFeatureIdx; ++featureIdx) {
@@ -315,6 +512,23 @@ namespace {
                             }
                             continue;
                         }
+                        if (fullFloatHistograms) {
+                            //nan consistency was already checked when the full histograms were built
+                            const TVector<ui8>& fullHist = (*fullFloatHistograms)[floatFeatureIdx];
+                            TVector<ui8>& hist = features->FloatHistograms[floatFeatureIdx];
+                            if (selectedDocIndices.empty()) {
+                                hist = fullHist;
+                            } else {
+                                hist.yresize(selectedDocIndices.size());
+                                for (size_t i = 0; i < selectedDocIndices.size(); ++i) {
+                                    hist[i] = fullHist[selectedDocIndices[i]];
+                                }
+                            }
+                            if (clearPool) {
+                                ClearVector(&docStorage->Factors[featureIdx]);
+                            }
+                            continue;
+                        }
                         bool seenNans = false;
                         if (selectedDocIndices.empty()) {
                             BinarizeFloatFeature(
@@ -372,9 +586,11 @@ void PrepareAllFeaturesLearn(const THashSet<int>& categFeatures,
                              const TVector<int>& ignoredFeatures,
                              bool ignoreRedundantCatFeatures,
                              size_t oneHotMaxSize,
+                             size_t oneHotMinCount,
                              bool clearPool,
                              NPar::TLocalExecutor& localExecutor,
                              const TVector<size_t>& selectedDocIndices,
+                             const TVector<TVector<ui8>>* fullFloatHistograms,
                              TDocumentStorage* learnDocStorage,
                              TAllFeatures* learnFeatures) {
     if (learnDocStorage->GetDocCount() == 0) {
@@ -384,9 +600,14 @@ void PrepareAllFeaturesLearn(const THashSet<int>& categFeatures,
     TBinarizer binarizer(learnDocStorage->GetEffectiveFactorCount(), categFeatures, floatFeatures, localExecutor);
     binarizer.SetupToIgnoreFeatures(ignoredFeatures, ignoreRedundantCatFeatures);
     PrepareSlots(binarizer.GetCatFeatureCount(), binarizer.GetFloatFeatureCount(), oneHotFeatures, learnFeatures);
-    binarizer.Binarize(/*allowNans=*/true, learnDocStorage, selectedDocIndices, clearPool, learnFeatures);
+    binarizer.Binarize(/*allowNans=*/true, learnDocStorage, selectedDocIndices, fullFloatHistograms, clearPool, learnFeatures);
     CleanupOneHotFeatures(oneHotMaxSize, learnFeatures);
+    if (!oneHotFeatures.Defined()) {
+        // with preset one-hot values the remap must stay aligned to an existing model
+        PruneRareOneHotValues(oneHotMinCount, learnFeatures);
+    }
     CB_ENSURE(learnFeatures->GetDocCount() > 0, "Train dataset is empty after binarization");
+    ComputeCatFeatureValueStats(localExecutor, learnFeatures);
     DumpMemUsage("Extract bools done");
 }
 
@@ -397,6 +618,7 @@ void PrepareAllFeaturesTest(const THashSet<int>& categFeatures,
                             bool clearPool,
                             NPar::TLocalExecutor& localExecutor,
                             const TVector<size_t>& selectedDocIndices,
+                            const TVector<TVector<ui8>>* fullFloatHistograms,
                             TDocumentStorage* testDocStorage,
                             TAllFeatures* testFeatures) {
     if (testDocStorage->GetDocCount() == 0) {
@@ -406,49 +628,168 @@ void PrepareAllFeaturesTest(const THashSet<int>& categFeatures,
     TBinarizer binarizer(testDocStorage->GetEffectiveFactorCount(), categFeatures, floatFeatures, localExecutor);
     binarizer.SetupToIgnoreFeaturesAfter(learnFeatures);
     PrepareSlotsAfter(learnFeatures, testFeatures);
-    binarizer.Binarize(allowNansOnlyInTest, testDocStorage, selectedDocIndices, clearPool, testFeatures);
+    binarizer.Binarize(allowNansOnlyInTest, testDocStorage, selectedDocIndices, fullFloatHistograms, clearPool, testFeatures);
+    ComputeCatFeatureValueStats(localExecutor, testFeatures);
     DumpMemUsage("Extract bools done");
 }
 
+void PrepareFullFloatHistograms(const THashSet<int>& categFeatures,
+                                const TVector<TFloatFeature>& floatFeatures,
+                                NPar::TLocalExecutor& localExecutor,
+                                TDocumentStorage* docStorage,
+                                TVector<TVector<ui8>>* fullFloatHistograms) {
+    TBinarizer binarizer(docStorage->GetEffectiveFactorCount(), categFeatures, floatFeatures, localExecutor);
+    //only float bins are shareable between folds, cat remaps are built per fold
+    TVector<int> catFeatureIndices(categFeatures.begin(), categFeatures.end());
+    binarizer.SetupToIgnoreFeatures(catFeatureIndices, /*ignoreRedundantCatFeatures=*/false);
+
+    TAllFeatures allDocsFeatures;
+    PrepareSlots(binarizer.GetCatFeatureCount(), binarizer.GetFloatFeatureCount(), Nothing(), &allDocsFeatures);
+    binarizer.Binarize(/*allowNans=*/true,
+                       docStorage,
+                       /*selectedDocIndices=*/{},
+                       /*fullFloatHistograms=*/nullptr,
+                       /*clearPool=*/false,
+                       &allDocsFeatures);
+    *fullFloatHistograms = std::move(allDocsFeatures.FloatHistograms);
+}
+
+/*
+ * Move the bins of a pool quantized ahead of time into `features`, skipping binarization
+ * entirely - with `clearPool` the dominant per-document byte columns change owner instead
+ * of being copied. The pool's border grid must be the one recorded in `floatFeatures`
+ * (for the learn pool that holds by construction, for test pools it enforces that they
+ * were quantized with the learn grid). Features ignored on load or lacking borders have
+ * empty bin columns and keep empty histograms, like constant features do.
+ */
+static void AdoptQuantizedPoolBins(const TVector<TFloatFeature>& floatFeatures,
+                                   const THashSet<int>& ignoredFeatures,
+                                   bool clearPool,
+                                   const TPool& pool,
+                                   TAllFeatures* features) {
+    CB_ENSURE(pool.CatFeatures.empty(), "Categorical features are not supported in quantized pools");
+    for (const auto& floatFeature : floatFeatures) {
+        const int flatIdx = floatFeature.FlatFeatureIndex;
+        TVector<ui8>& bins = pool.QuantizedFeatures[flatIdx];
+        if (bins.empty() || floatFeature.Borders.empty() || ignoredFeatures.has(flatIdx)) {
+            continue;
+        }
+        CB_ENSURE(pool.QuantizationBorders[flatIdx] == floatFeature.Borders,
+                  "Borders of quantized pool feature " << flatIdx << " do not match the training borders");
+        TVector<ui8>& hist = features->FloatHistograms[floatFeature.FeatureIndex];
+        if (clearPool) {
+            hist = std::move(bins);
+        } else {
+            hist = bins;
+        }
+    }
+}
+
 void QuantizeTrainPools(
     const TClearablePoolPtrs& pools,
     const TVector<TFloatFeature>& floatFeatures,
     TMaybe<const TVector<TOneHotFeature>*> oneHotFeatures,
     const TVector<int>& ignoredFeatures,
     size_t oneHotMaxSize,
+    size_t oneHotMinCount,
+    const TString& quantizationCachePath,
     NPar::TLocalExecutor& localExecutor,
     TDataset* learnData,
-    TVector<TDataset>* testDatasets
+    TVector<TDataset>* testDatasets,
+    TVector<int>* duplicateFeatureAliases
 ) {
     THashSet<int> catFeatures(pools.Learn->CatFeatures.begin(), pools.Learn->CatFeatures.end());
 
-    PrepareAllFeaturesLearn(
-        catFeatures,
-        floatFeatures,
-        oneHotFeatures,
-        ignoredFeatures,
-        /*ignoreRedundantCatFeatures=*/true,
-        oneHotMaxSize,
-        /*clearPoolAfterBinarization=*/pools.AllowClearLearn,
-        localExecutor,
-        /*select=*/{},
-        &pools.Learn->Docs,
-        &(learnData->AllFeatures)
-    );
+    TVector<int> collapsedAliases;
+    bool learnLoadedFromCache = false;
+    ui64 quantizationKey = 0;
+    /* the cache key covers raw factor values, which a pre-quantized pool does not have;
+     * its bins are adopted directly anyway, so the cache would only add a disk roundtrip */
+    const bool useQuantizationCache = !quantizationCachePath.empty() && !pools.Learn->IsQuantized();
+    if (useQuantizationCache) {
+        quantizationKey = NCB::CalcQuantizationKey(*pools.Learn, floatFeatures, ignoredFeatures, oneHotMaxSize, oneHotMinCount);
+        learnLoadedFromCache = NCB::TryLoadQuantizedFeatures(
+            quantizationCachePath,
+            quantizationKey,
+            &(learnData->AllFeatures),
+            &collapsedAliases);
+    }
+    if (!learnLoadedFromCache) {
+        if (pools.Learn->IsQuantized()) {
+            PrepareSlots(catFeatures.size(), floatFeatures.size(), oneHotFeatures, &(learnData->AllFeatures));
+            AdoptQuantizedPoolBins(
+                floatFeatures,
+                THashSet<int>(ignoredFeatures.begin(), ignoredFeatures.end()),
+                pools.AllowClearLearn,
+                *pools.Learn,
+                &(learnData->AllFeatures)
+            );
+            CB_ENSURE(learnData->AllFeatures.GetDocCount() > 0, "Train dataset is empty after binarization");
+            ComputeCatFeatureValueStats(localExecutor, &(learnData->AllFeatures));
+        } else {
+            PrepareAllFeaturesLearn(
+                catFeatures,
+                floatFeatures,
+                oneHotFeatures,
+                ignoredFeatures,
+                /*ignoreRedundantCatFeatures=*/true,
+                oneHotMaxSize,
+                oneHotMinCount,
+                /*clearPoolAfterBinarization=*/pools.AllowClearLearn,
+                localExecutor,
+                /*select=*/{},
+                /*fullFloatHistograms=*/nullptr,
+                &pools.Learn->Docs,
+                &(learnData->AllFeatures)
+            );
+        }
+        if (!oneHotFeatures.Defined()) {
+            // with preset one-hot values quantization must mirror an existing model exactly
+            CollapseDuplicateFeatures(
+                catFeatures,
+                pools.Learn->Docs.GetEffectiveFactorCount(),
+                localExecutor,
+                &(learnData->AllFeatures),
+                &collapsedAliases);
+        }
+        BuildExclusiveFeatureBundles(localExecutor, &(learnData->AllFeatures));
+        PackLowCardinalityFeatures(localExecutor, &(learnData->AllFeatures));
+        if (useQuantizationCache) {
+            NCB::SaveQuantizedFeatures(quantizationCachePath, quantizationKey, learnData->AllFeatures, collapsedAliases);
+        }
+    }
+    if (duplicateFeatureAliases) {
+        *duplicateFeatureAliases = std::move(collapsedAliases);
+    }
 
     testDatasets->resize(pools.Test.size());
 
     for (auto testDataIdx : xrange(pools.Test.size())) {
-        PrepareAllFeaturesTest(
-            catFeatures,
-            floatFeatures,
-            learnData->AllFeatures,
-            /*allowNansOnlyInTest=*/false,
-            /*clearPoolAfterBinarization=*/pools.AllowClearTest,
-            localExecutor,
-            /*select=*/{},
-            &(pools.Test[testDataIdx]->Docs),
-            &((*testDatasets)[testDataIdx].AllFeatures)
-        );
+        const TPool& testPool = *pools.Test[testDataIdx];
+        TAllFeatures* testFeatures = &((*testDatasets)[testDataIdx].AllFeatures);
+        if (testPool.IsQuantized()) {
+            PrepareSlotsAfter(learnData->AllFeatures, testFeatures);
+            AdoptQuantizedPoolBins(
+                floatFeatures,
+                THashSet<int>(ignoredFeatures.begin(), ignoredFeatures.end()),
+                pools.AllowClearTest,
+                testPool,
+                testFeatures
+            );
+            ComputeCatFeatureValueStats(localExecutor, testFeatures);
+        } else {
+            PrepareAllFeaturesTest(
+                catFeatures,
+                floatFeatures,
+                learnData->AllFeatures,
+                /*allowNansOnlyInTest=*/false,
+                /*clearPoolAfterBinarization=*/pools.AllowClearTest,
+                localExecutor,
+                /*select=*/{},
+                /*fullFloatHistograms=*/nullptr,
+                &(pools.Test[testDataIdx]->Docs),
+                testFeatures
+            );
+        }
     }
 }
@@ -0,0 +1,136 @@
+#include "quantization_cache.h"
+
+#include <catboost/libs/helpers/exception.h>
+#include <catboost/libs/logging/logging.h>
+
+#include <library/binsaver/util_stream_io.h>
+
+#include <util/digest/city.h>
+#include <util/digest/numeric.h>
+#include <util/folder/path.h>
+#include <util/generic/yexception.h>
+#include <util/stream/file.h>
+#include <util/stream/format.h>
+#include <util/string/builder.h>
+#include <util/system/fs.h>
+#include <util/system/getpid.h>
+
+namespace NCB {
+
+    namespace {
+        // bump on any change of the entry layout or the key computation
+        const ui64 CacheFormatSeed = 5; // bumped when the entry layout changes
+
+        template <typename T>
+        ui64 HashPodVector(const TVector<T>& values, ui64 seed) {
+            static_assert(std::is_pod<T>::value, "expected a pod element type");
+            return CityHash64WithSeed(
+                reinterpret_cast<const char*>(values.data()),
+                values.size() * sizeof(T),
+                seed);
+        }
+
+        TString GetEntryPath(const TString& cacheDir, ui64 key) {
+            return (TFsPath(cacheDir) / (TStringBuilder() << Hex(key, HF_FULL) << ".quantized")).GetPath();
+        }
+
+        // holds the features by pointer to avoid copying gigabytes of quantized data
+        // into a temporary on save
+        struct TQuantizationCacheEntry {
+            ui64 Key = 0;
+            TAllFeatures* Features = nullptr;
+            TVector<int>* DuplicateAliases = nullptr;
+
+            int operator&(IBinSaver& saver) {
+                saver.Add(2, &Key);
+                saver.Add(3, Features);
+                saver.Add(4, DuplicateAliases);
+                return 0;
+            }
+        };
+    }
+
+    ui64 CalcQuantizationKey(const TPool& pool,
+                             const TVector<TFloatFeature>& floatFeatures,
+                             const TVector<int>& ignoredFeatures,
+                             size_t oneHotMaxSize,
+                             size_t oneHotMinCount) {
+        ui64 key = CacheFormatSeed;
+        key = CombineHashes(key, static_cast<ui64>(pool.Docs.GetDocCount()));
+        key = CombineHashes(key, static_cast<ui64>(pool.Docs.GetEffectiveFactorCount()));
+        for (int factorIdx = 0; factorIdx < pool.Docs.GetEffectiveFactorCount(); ++factorIdx) {
+            const TConstArrayRef<float> factor = pool.Docs.GetFactorRef(factorIdx);
+            key = CityHash64WithSeed(
+                reinterpret_cast<const char*>(factor.data()),
+                factor.size() * sizeof(float),
+                key);
+        }
+        key = HashPodVector(pool.CatFeatures, key);
+        for (const auto& floatFeature : floatFeatures) {
+            key = CombineHashes(key, static_cast<ui64>(floatFeature.HasNans));
+            key = CombineHashes(key, static_cast<ui64>(floatFeature.FlatFeatureIndex));
+            key = CombineHashes(key, static_cast<ui64>(floatFeature.NanValueTreatment));
+            key = HashPodVector(floatFeature.Borders, key);
+        }
+        key = HashPodVector(ignoredFeatures, key);
+        key = CombineHashes(key, static_cast<ui64>(oneHotMaxSize));
+        key = CombineHashes(key, static_cast<ui64>(oneHotMinCount));
+        return key;
+    }
+
+    bool TryLoadQuantizedFeatures(const TString& cacheDir, ui64 key, TAllFeatures* features,
+                                  TVector<int>* duplicateAliases) {
+        const TString entryPath = GetEntryPath(cacheDir, key);
+        if (!NFs::Exists(entryPath)) {
+            return false;
+        }
+        try {
+            TAllFeatures loadedFeatures;
+            TVector<int> loadedAliases;
+            TQuantizationCacheEntry entry;
+            entry.Features = &loadedFeatures;
+            entry.DuplicateAliases = &loadedAliases;
+            TIFStream input(entryPath);
+            SerializeFromStream(input, entry);
+            if (entry.Key != key) {
+                MATRIXNET_WARNING_LOG << "Quantization cache entry " << entryPath
+                    << " has mismatched key, ignoring it" << Endl;
+                return false;
+            }
+            *features = std::move(loadedFeatures);
+            if (duplicateAliases) {
+                *duplicateAliases = std::move(loadedAliases);
+            }
+        } catch (const yexception& e) {
+            MATRIXNET_WARNING_LOG << "Failed to read quantization cache entry " << entryPath
+                << ": " << e.what() << Endl;
+            return false;
+        }
+        MATRIXNET_INFO_LOG << "Reusing quantized features from " << entryPath << Endl;
+        return true;
+    }
+
+    void SaveQuantizedFeatures(const TString& cacheDir, ui64 key, const TAllFeatures& features,
+                               const TVector<int>& duplicateAliases) {
+        NFs::MakeDirectoryRecursive(cacheDir);
+        const TString entryPath = GetEntryPath(cacheDir, key);
+        const TString tmpPath = TStringBuilder() << entryPath << ".tmp." << GetPID();
+        try {
+            {
+                TQuantizationCacheEntry entry;
+                entry.Key = key;
+                entry.Features = const_cast<TAllFeatures*>(&features);
+                entry.DuplicateAliases = const_cast<TVector<int>*>(&duplicateAliases);
+                TOFStream output(tmpPath);
+                SerializeToStream(output, entry);
+                output.Finish();
+            }
+            CB_ENSURE(NFs::Rename(tmpPath, entryPath), "failed to rename " << tmpPath);
+        } catch (const yexception& e) {
+            // the cache is an optimization, a failure to populate it must not fail training
+            MATRIXNET_WARNING_LOG << "Failed to write quantization cache entry " << entryPath
+                << ": " << e.what() << Endl;
+            NFs::Remove(tmpPath);
+        }
+    }
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <catboost/libs/data/pool.h>
+#include <catboost/libs/data/quantized_features.h>
+#include <catboost/libs/model/features.h>
+
+#include <util/generic/string.h>
+#include <util/generic/vector.h>
+#include <util/system/types.h>
+
+namespace NCB {
+
+    /*
+     * Content-addressed on-disk cache for learn pool quantization results.
+     * The key covers everything binarization depends on: raw factor values, the cat feature
+     * set, float feature borders/nan modes, ignored features and one-hot limits, so a
+     * stale entry can never be returned for changed data or settings.
+     */
+    ui64 CalcQuantizationKey(const TPool& pool,
+                             const TVector<TFloatFeature>& floatFeatures,
+                             const TVector<int>& ignoredFeatures,
+                             size_t oneHotMaxSize,
+                             size_t oneHotMinCount);
+
+    /// @return true iff a valid cache entry was found and loaded into `features`
+    /// (and the stored duplicate feature aliases into `duplicateAliases`, if not null).
+    bool TryLoadQuantizedFeatures(const TString& cacheDir, ui64 key, TAllFeatures* features,
+                                  TVector<int>* duplicateAliases = nullptr);
+
+    /*
+     * Writes the entry under a temporary name first and renames it into place, so a killed
+     * run never leaves a half-written cache entry behind.
+     */
+    void SaveQuantizedFeatures(const TString& cacheDir, ui64 key, const TAllFeatures& features,
+                               const TVector<int>& duplicateAliases = TVector<int>());
+}
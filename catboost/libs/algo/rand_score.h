@@ -2,6 +2,8 @@
 
 #include <util/random/normal.h>
 #include <util/random/fast.h>
+#include <util/generic/vector.h>
+#include <util/generic/ymath.h>
 
 #include <library/binsaver/bin_saver.h>
 
@@ -26,3 +28,24 @@ struct TRandomScore {
     }
     SAVELOAD(Val, StDev);
 };
+
+/* Fills noise (at its current size) with N(0, stDev) draws in one burst. The trigonometric
+ * form of Box-Muller consumes exactly two uniforms per pair of normals - no rejection loop -
+ * so the RNG stays out of the per-score comparison loop and the number of draws does not
+ * depend on the data. With stDev == 0 every element is exactly zero.
+ */
+template <typename TRng>
+inline void FillNormalNoise(double stDev, TRng& rand, TVector<double>* noise) {
+    const size_t count = noise->size();
+    for (size_t i = 0; i + 2 <= count; i += 2) {
+        const double radius = sqrt(-2.0 * log(rand.GenRandReal3())) * stDev;
+        const double angle = 2.0 * PI * rand.GenRandReal2();
+        (*noise)[i] = radius * cos(angle);
+        (*noise)[i + 1] = radius * sin(angle);
+    }
+    if (count & 1) {
+        const double radius = sqrt(-2.0 * log(rand.GenRandReal3())) * stDev;
+        const double angle = 2.0 * PI * rand.GenRandReal2();
+        noise->back() = radius * cos(angle);
+    }
+}
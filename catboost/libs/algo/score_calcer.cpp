@@ -21,7 +21,7 @@ int GetSplitCount(const TVector<int>& splitsCount,
     }
 }
 
-template<typename TFullIndexType, typename TIsCaching>
+template<typename TStatsIndexerType, typename TFullIndexType, typename TIsCaching>
 static TVector<TScoreBin> CalcScoreImpl(const TIsCaching& isCaching,
         const TVector<TFullIndexType>& singleIdx,
         const TCalcScoreFold& fold,
@@ -31,9 +31,11 @@ static TVector<TScoreBin> CalcScoreImpl(const TIsCaching& isCaching,
         float l2Regularizer,
         float pairwiseBucketWeightPriorReg,
         ESplitType splitType,
-        const TStatsIndexer& indexer,
+        const TStatsIndexerType& indexer,
         int depth,
+        int monotoneDirection,
         int splitStatsCount,
+        NPar::TLocalExecutor* localExecutor,
         TBucketStats* splitStats) {
     Y_ASSERT(!isCaching || depth > 0);
     const int approxDimension = fold.GetApproxDimension();
@@ -59,11 +61,21 @@ static TVector<TScoreBin> CalcScoreImpl(const TIsCaching& isCaching,
                 );
             } else {
                 TBucketStats* stats = splitStats + (bodyTailIdx * approxDimension + dim) * splitStatsCount;
-                CalcStatsKernel(isCaching, singleIdx, fold, isPlainMode, indexer, depth, bt, dim, stats);
+                int partialCount = 1;
+                if (!isCaching && localExecutor != nullptr) {
+                    // the caching kernel accumulates only the smallest split side, too little
+                    // work to be worth splitting
+                    partialCount = SelectBucketStatsPartialCount(bt.TailFinish, indexer.CalcSize(depth), localExecutor->GetThreadCount() + 1);
+                }
+                if (partialCount > 1) {
+                    CalcStatsKernelParallel(singleIdx, fold, isPlainMode, indexer, depth, bt, dim, partialCount, localExecutor, stats);
+                } else {
+                    CalcStatsKernel(isCaching, singleIdx, fold, isPlainMode, indexer, depth, bt, dim, stats);
+                }
                 if (isPlainMode) {
-                    UpdateScoreBin(stats, leafCount, indexer, splitType, l2Regularizer, /*isPlainMode=*/std::true_type(), sumAllWeights, docCount, &scoreBins);
+                    UpdateScoreBin(stats, leafCount, indexer, splitType, l2Regularizer, /*isPlainMode=*/std::true_type(), sumAllWeights, docCount, monotoneDirection, &scoreBins);
                 } else {
-                    UpdateScoreBin(stats, leafCount, indexer, splitType, l2Regularizer, /*isPlainMode=*/std::false_type(), sumAllWeights, docCount, &scoreBins);
+                    UpdateScoreBin(stats, leafCount, indexer, splitType, l2Regularizer, /*isPlainMode=*/std::false_type(), sumAllWeights, docCount, monotoneDirection, &scoreBins);
                 }
             }
         }
@@ -80,50 +92,56 @@ TVector<TScoreBin> CalcScore(const TAllFeatures& af,
                           const NCatboostOptions::TCatBoostOptions& fitParams,
                           const TSplitCandidate& split,
                           int depth,
-                          TBucketStatsCache* statsFromPrevTree) {
+                          int monotoneDirection,
+                          TBucketStatsCache* statsFromPrevTree,
+                          NPar::TLocalExecutor* localExecutor) {
+    // bucket order matches value order only for float splits, so only they can be constrained
+    Y_ASSERT(monotoneDirection == 0 || split.Type == ESplitType::FloatFeature);
     const int bucketCount = GetSplitCount(splitsCount, af.OneHotValues, split) + 1;
-    const TStatsIndexer indexer(bucketCount);
     const int bucketIndexBits = GetValueBitCount(bucketCount) + depth + 1;
     const bool isPairwiseScoring = IsPairwiseScoring(fitParams.LossFunctionDescription->GetLossFunction());
 
-    decltype(auto) SelectCalcScoreImpl = [&] (auto isCaching, const TCalcScoreFold& fold, int splitStatsCount, auto* splitStats) {
-        const bool isPlainMode = IsPlainMode(fitParams.BoostingOptions->BoostingType);
-        const float l2Regularizer = static_cast<const float>(fitParams.ObliviousTreeOptions->L2Reg);
-        const float pairwiseBucketWeightPriorReg = static_cast<const float>(fitParams.ObliviousTreeOptions->PairwiseNonDiagReg);
-        if (bucketIndexBits <= 8) {
-            TVector<ui8> singleIdx;
-            BuildSingleIndex(fold, af, allCtrs, split, indexer, &singleIdx);
-            return CalcScoreImpl(isCaching, singleIdx, fold, initialFold, isPlainMode, isPairwiseScoring, l2Regularizer, pairwiseBucketWeightPriorReg, split.Type, indexer, depth, splitStatsCount, GetDataPtr(*splitStats));
-        } else if (bucketIndexBits <= 16) {
-            TVector<ui16> singleIdx;
-            BuildSingleIndex(fold, af, allCtrs, split, indexer, &singleIdx);
-            return CalcScoreImpl(isCaching, singleIdx, fold, initialFold, isPlainMode, isPairwiseScoring, l2Regularizer, pairwiseBucketWeightPriorReg, split.Type, indexer, depth, splitStatsCount, GetDataPtr(*splitStats));
-        } else if (bucketIndexBits <= 32) {
-            TVector<ui32> singleIdx;
-            BuildSingleIndex(fold, af, allCtrs, split, indexer, &singleIdx);
-            return CalcScoreImpl(isCaching, singleIdx, fold, initialFold, isPlainMode, isPairwiseScoring, l2Regularizer, pairwiseBucketWeightPriorReg, split.Type, indexer, depth, splitStatsCount, GetDataPtr(*splitStats));
-        }
-        CB_ENSURE(false, "too deep or too much splitsCount for score calculation");
-    };
-    const auto& treeOptions = fitParams.ObliviousTreeOptions.Get();
+    // The whole kernel is instantiated per indexer type, so common bucket counts get
+    // fully specialized histogram and score loops (see DispatchByBucketCount).
+    return DispatchByBucketCount(bucketCount, [&] (const auto& indexer) -> TVector<TScoreBin> {
+        decltype(auto) SelectCalcScoreImpl = [&] (auto isCaching, const TCalcScoreFold& fold, int splitStatsCount, auto* splitStats) {
+            const bool isPlainMode = IsPlainMode(fitParams.BoostingOptions->BoostingType);
+            const float l2Regularizer = static_cast<const float>(fitParams.ObliviousTreeOptions->L2Reg);
+            const float pairwiseBucketWeightPriorReg = static_cast<const float>(fitParams.ObliviousTreeOptions->PairwiseNonDiagReg);
+            if (bucketIndexBits <= 8) {
+                TVector<ui8> singleIdx;
+                BuildSingleIndex(fold, af, allCtrs, split, indexer, &singleIdx);
+                return CalcScoreImpl(isCaching, singleIdx, fold, initialFold, isPlainMode, isPairwiseScoring, l2Regularizer, pairwiseBucketWeightPriorReg, split.Type, indexer, depth, monotoneDirection, splitStatsCount, localExecutor, GetDataPtr(*splitStats));
+            } else if (bucketIndexBits <= 16) {
+                TVector<ui16> singleIdx;
+                BuildSingleIndex(fold, af, allCtrs, split, indexer, &singleIdx);
+                return CalcScoreImpl(isCaching, singleIdx, fold, initialFold, isPlainMode, isPairwiseScoring, l2Regularizer, pairwiseBucketWeightPriorReg, split.Type, indexer, depth, monotoneDirection, splitStatsCount, localExecutor, GetDataPtr(*splitStats));
+            } else if (bucketIndexBits <= 32) {
+                TVector<ui32> singleIdx;
+                BuildSingleIndex(fold, af, allCtrs, split, indexer, &singleIdx);
+                return CalcScoreImpl(isCaching, singleIdx, fold, initialFold, isPlainMode, isPairwiseScoring, l2Regularizer, pairwiseBucketWeightPriorReg, split.Type, indexer, depth, monotoneDirection, splitStatsCount, localExecutor, GetDataPtr(*splitStats));
+            }
+            CB_ENSURE(false, "too deep or too much splitsCount for score calculation");
+        };
+        const auto& treeOptions = fitParams.ObliviousTreeOptions.Get();
 
-    // Pairwise scoring doesn't use statistics from previous tree level
-    if (!IsSamplingPerTree(treeOptions) || isPairwiseScoring) {
-        TVector<TBucketStats> scratchSplitStats;
-        const int splitStatsCount = indexer.CalcSize(depth);
-        const int statsCount = splitStatsCount;
-        scratchSplitStats.yresize(statsCount);
-        return SelectCalcScoreImpl(/*isCaching*/ std::false_type(), fold, /*splitStatsCount*/ 0, &scratchSplitStats);
-    } else {
-        const int splitStatsCount = indexer.CalcSize(treeOptions.MaxDepth);
-        const int statsCount = fold.GetBodyTailCount() * fold.GetApproxDimension() * splitStatsCount;
-        bool areStatsDirty;
-        TVector<TBucketStats, TPoolAllocator>& splitStats = statsFromPrevTree->GetStats(split, statsCount, &areStatsDirty); // thread-safe access
-        if (depth == 0 || areStatsDirty) {
-            return SelectCalcScoreImpl(/*isCaching*/ std::false_type(), fold, splitStatsCount, &splitStats);
+        // Pairwise scoring doesn't use statistics from previous tree level
+        if (!IsSamplingPerTree(treeOptions) || isPairwiseScoring || statsFromPrevTree == nullptr) {
+            TVector<TBucketStats> scratchSplitStats;
+            const int splitStatsCount = indexer.CalcSize(depth);
+            const int statsCount = splitStatsCount;
+            scratchSplitStats.yresize(statsCount);
+            return SelectCalcScoreImpl(/*isCaching*/ std::false_type(), fold, /*splitStatsCount*/ 0, &scratchSplitStats);
         } else {
-            return SelectCalcScoreImpl(/*isCaching*/ std::true_type(), prevLevelData, splitStatsCount, &splitStats);
+            const int splitStatsCount = indexer.CalcSize(treeOptions.MaxDepth);
+            const int statsCount = fold.GetBodyTailCount() * fold.GetApproxDimension() * splitStatsCount;
+            bool areStatsDirty;
+            TVector<TBucketStats, TPoolAllocator>& splitStats = statsFromPrevTree->GetStats(split, statsCount, &areStatsDirty); // thread-safe access
+            if (depth == 0 || areStatsDirty) {
+                return SelectCalcScoreImpl(/*isCaching*/ std::false_type(), fold, splitStatsCount, &splitStats);
+            } else {
+                return SelectCalcScoreImpl(/*isCaching*/ std::true_type(), prevLevelData, splitStatsCount, &splitStats);
+            }
         }
-    }
-    CB_ENSURE(false, "too deep or too much splitsCount for score calculation");
+    });
 }
@@ -12,6 +12,10 @@
 
 #include <util/generic/vector.h>
 
+#include <emmintrin.h>
+
+#include <type_traits>
+
 // TODO(annaveronika): Currently this file has a bunch of structures and helper functions that are used for score calculation
 // in local and distributed modes. This file needs to be refactored.
 
@@ -51,6 +55,12 @@ inline TVector<double> GetScores(const TVector<TScoreBin>& scoreBin) {
 
 // Function that calculates score statistics for each split of a split candidate (candidate is a feature == all splits of this feature).
 // This function does all the work - it calculates sums in buckets, gets real sums for splits and builds TScoreBin-s from that.
+// Pass statsFromPrevTree == nullptr to score into scratch memory without touching the cache of the previous tree level.
+// monotoneDirection (from the monotone_constraints option, 0 == unconstrained) disqualifies
+// splits whose leaf estimates violate the constraint, at no extra scan over the candidates.
+// A non-null localExecutor lets the histogram build split its document range into per-task
+// partials (see CalcStatsKernelParallel); pass it only when the candidate-level parallelism
+// of the caller cannot occupy the thread pool on its own.
 TVector<TScoreBin> CalcScore(
     const TAllFeatures& af,
     const TVector<int>& splitsCount,
@@ -62,7 +72,9 @@ TVector<TScoreBin> CalcScore(
     const NCatboostOptions::TCatBoostOptions& fitParams,
     const TSplitCandidate& split,
     int depth,
-    TBucketStatsCache* statsFromPrevTree);
+    int monotoneDirection,
+    TBucketStatsCache* statsFromPrevTree,
+    NPar::TLocalExecutor* localExecutor = nullptr);
 
 // Statistics (sums for score calculation) are stored in an array. This class helps navigating in this array.
 struct TStatsIndexer {
@@ -78,6 +90,44 @@ struct TStatsIndexer {
     }
 };
 
+// Compile-time counterpart of TStatsIndexer. With the bucket count known at compile time the
+// per-bucket loops of UpdateScoreBin can be fully unrolled and the leaf/bucket index combine
+// loses its per-document runtime multiply; see DispatchByBucketCount below.
+template<int BucketCountValue>
+struct TFixedStatsIndexer {
+    static constexpr int BucketCount = BucketCountValue;
+    int CalcSize(int depth) const {
+        return (1U << depth) * BucketCount;
+    }
+    int GetIndex(int leafIndex, int bucketIndex) const {
+        return BucketCount * leafIndex + bucketIndex;
+    }
+};
+
+/*
+ * Run `func` with a histogram indexer specialized for the bucket count at compile time.
+ * The listed counts are the ones the usual quantization settings produce (border_count
+ * 32/64/128/255 plus one border for binary ctr and one-hot splits); anything else falls
+ * back to the generic runtime-sized indexer, so callers see identical results either way.
+ */
+template<typename TFunc>
+inline auto DispatchByBucketCount(int bucketCount, const TFunc& func) {
+    switch (bucketCount) {
+        case 2:
+            return func(TFixedStatsIndexer<2>());
+        case 33:
+            return func(TFixedStatsIndexer<33>());
+        case 65:
+            return func(TFixedStatsIndexer<65>());
+        case 129:
+            return func(TFixedStatsIndexer<129>());
+        case 256:
+            return func(TFixedStatsIndexer<256>());
+        default:
+            return func(TStatsIndexer(bucketCount));
+    }
+}
+
 // A helper function that returns calculated ctr values for this projection (== feature or feature combination) from cache.
 inline const TOnlineCTR& GetCtr(const std::tuple<const TOnlineCTRHash&, const TOnlineCTRHash&>& allCtrs, const TProjection& proj) {
     static const constexpr size_t OnlineSingleCtrsIndex = 0;
@@ -86,13 +136,13 @@ inline const TOnlineCTR& GetCtr(const std::tuple<const TOnlineCTRHash&, const TO
 }
 
 // Helper function for calculating index of leaf for each document given a new split.
-// Calculates indices when a permutation is given.
-template<typename TBucketIndexType, typename TFullIndexType>
-inline void SetSingleIndex(const TCalcScoreFold& fold,
-                           const TStatsIndexer& indexer,
-                           const TVector<TBucketIndexType>& bucketIndex,
-                           const size_t* docPermutation,
-                           TVector<TFullIndexType>* singleIdx) {
+// Calculates indices when a permutation is given; bucket values come from `getBucketIndex(doc)`.
+template<typename TStatsIndexerType, typename TGetBucketIndex, typename TFullIndexType>
+inline void SetSingleIndexImpl(const TCalcScoreFold& fold,
+                               const TStatsIndexerType& indexer,
+                               const TGetBucketIndex& getBucketIndex,
+                               const size_t* docPermutation,
+                               TVector<TFullIndexType>* singleIdx) {
     const size_t docCount = fold.GetDocCount();
     const size_t permBlockSize = fold.PermutationBlockSize;
     const TIndexType* indices = GetDataPtr(fold.Indices);
@@ -100,7 +150,7 @@ inline void SetSingleIndex(const TCalcScoreFold& fold,
     singleIdx->yresize(docCount);
     if (docPermutation == nullptr || permBlockSize == docCount) {
         for (size_t doc = 0; doc < docCount; ++doc) {
-            (*singleIdx)[doc] = indexer.GetIndex(indices[doc], bucketIndex[doc]);
+            (*singleIdx)[doc] = indexer.GetIndex(indices[doc], getBucketIndex(doc));
         }
     } else if (permBlockSize > 1) {
         const size_t blockCount = (docCount + permBlockSize - 1) / permBlockSize;
@@ -112,25 +162,34 @@ inline void SetSingleIndex(const TCalcScoreFold& fold,
             const size_t originalBlockIdx = docPermutation[blockStart];
             for (size_t doc = blockStart; doc < nextBlockStart; ++doc) {
                 const size_t originalDocIdx = originalBlockIdx + doc - blockStart;
-                (*singleIdx)[doc] = indexer.GetIndex(indices[doc], bucketIndex[originalDocIdx]);
+                (*singleIdx)[doc] = indexer.GetIndex(indices[doc], getBucketIndex(originalDocIdx));
             }
             blockStart = nextBlockStart;
         }
     } else {
         for (size_t doc = 0; doc < docCount; ++doc) {
             const size_t originalDocIdx = docPermutation[doc];
-            (*singleIdx)[doc] = indexer.GetIndex(indices[doc], bucketIndex[originalDocIdx]);
+            (*singleIdx)[doc] = indexer.GetIndex(indices[doc], getBucketIndex(originalDocIdx));
         }
     }
 }
 
+template<typename TStatsIndexerType, typename TBucketIndexType, typename TFullIndexType>
+inline void SetSingleIndex(const TCalcScoreFold& fold,
+                           const TStatsIndexerType& indexer,
+                           const TVector<TBucketIndexType>& bucketIndex,
+                           const size_t* docPermutation,
+                           TVector<TFullIndexType>* singleIdx) {
+    SetSingleIndexImpl(fold, indexer, [&](size_t doc) { return bucketIndex[doc]; }, docPermutation, singleIdx);
+}
+
 // Calculate index of leaf for each document given a new split.
-template<typename TFullIndexType>
+template<typename TStatsIndexerType, typename TFullIndexType>
 inline void BuildSingleIndex(const TCalcScoreFold& fold,
                              const TAllFeatures& af,
                              const std::tuple<const TOnlineCTRHash&, const TOnlineCTRHash&>& allCtrs,
                              const TSplitCandidate& split,
-                             const TStatsIndexer& indexer,
+                             const TStatsIndexerType& indexer,
                              TVector<TFullIndexType>* singleIdx) {
     if (split.Type == ESplitType::OnlineCtr) {
         const TCtr& ctr = split.Ctr;
@@ -138,7 +197,17 @@ inline void BuildSingleIndex(const TCalcScoreFold& fold,
         SetSingleIndex(fold, indexer, GetCtr(allCtrs, ctr.Projection).Feature[ctr.CtrIdx][ctr.TargetBorderIdx][ctr.PriorIdx], docSubset, singleIdx);
     } else if (split.Type == ESplitType::FloatFeature) {
         const size_t* learnPermutation = GetDataPtr(fold.LearnPermutation);
-        SetSingleIndex(fold, indexer, af.FloatHistograms[split.FeatureIdx], learnPermutation, singleIdx);
+        if (af.IsBundledFloatFeature(split.FeatureIdx)) {
+            const TFeatureBundleRef ref = af.FloatFeatureBundleRefs[split.FeatureIdx];
+            const ui8* bundleBins = af.FeatureBundles[ref.BundleIdx].Bins.data();
+            SetSingleIndexImpl(fold, indexer, [=](size_t doc) { return GetBundledBin(bundleBins[doc], ref); }, learnPermutation, singleIdx);
+        } else if (af.IsPackedFloatFeature(split.FeatureIdx)) {
+            const TFeaturePackRef ref = af.FloatFeaturePackRefs[split.FeatureIdx];
+            const ui8* packedBins = af.FeaturePacks[ref.PackIdx].Bins.data();
+            SetSingleIndexImpl(fold, indexer, [=](size_t doc) { return GetPackedBin(packedBins[doc], ref); }, learnPermutation, singleIdx);
+        } else {
+            SetSingleIndex(fold, indexer, af.FloatHistograms[split.FeatureIdx], learnPermutation, singleIdx);
+        }
     } else {
         Y_ASSERT(split.Type == ESplitType::OneHotFeature);
         const size_t* learnPermutation = GetDataPtr(fold.LearnPermutation);
@@ -146,27 +215,61 @@ inline void BuildSingleIndex(const TCalcScoreFold& fold,
     }
 }
 
-// Update bootstraped sums on [docBegin, docEnd) in a bucket
-template<typename TFullIndexType>
-inline void UpdateWeighted(const TVector<TFullIndexType>& singleIdx, const double* weightedDer, const float* sampleWeights, int docBegin, int docEnd, TBucketStats* stats) {
+/*
+ * Number of interleaved private histograms used in the accumulation loops. The bucket index
+ * is data-dependent, so consecutive documents hitting the same bucket form a serial chain of
+ * read-modify-writes; spreading documents over independent histograms breaks the chain and
+ * lets them retire in parallel. The extra histograms are merged back once at the end.
+ */
+constexpr int BucketStatsLaneCount = 4;
+
+// Lane privatization pays off only when the document pass dwarfs zeroing and merging the extra lanes.
+inline bool ShouldUseLanes(int docCount, int statsSize) {
+    return docCount >= 2 * BucketStatsLaneCount * statsSize;
+}
+
+// Update bootstraped sums on [docBegin, docEnd) in a bucket.
+// hasSampleWeights is std::true_type/std::false_type (see TCalcScoreFold trivial sample
+// weights); the false flavor replaces the per-document weight load with a compile-time one.
+template<typename THasSampleWeights, typename TFullIndexType, typename TDerType>
+inline void UpdateWeighted(const THasSampleWeights& hasSampleWeights, const TVector<TFullIndexType>& singleIdx, const TDerType* weightedDer, const float* sampleWeights, int docBegin, int docEnd, TBucketStats* stats) {
     for (int doc = docBegin; doc < docEnd; ++doc) {
         TBucketStats& leafStats = stats[singleIdx[doc]];
         leafStats.SumWeightedDelta += weightedDer[doc];
-        leafStats.SumWeight += sampleWeights[doc];
+        leafStats.SumWeight += hasSampleWeights ? sampleWeights[doc] : 1.0f;
     }
 }
 
+// Lane-privatized version of UpdateWeighted; laneStats points at BucketStatsLaneCount - 1 zeroed histograms.
+template<typename THasSampleWeights, typename TFullIndexType, typename TDerType>
+inline void UpdateWeightedLanes(const THasSampleWeights& hasSampleWeights, const TVector<TFullIndexType>& singleIdx, const TDerType* weightedDer, const float* sampleWeights, int docBegin, int docEnd, int statsSize, TBucketStats* stats, TBucketStats* laneStats) {
+    TBucketStats* lanes[BucketStatsLaneCount];
+    lanes[0] = stats;
+    for (int lane = 1; lane < BucketStatsLaneCount; ++lane) {
+        lanes[lane] = laneStats + (lane - 1) * statsSize;
+    }
+    int doc = docBegin;
+    for (; doc + BucketStatsLaneCount <= docEnd; doc += BucketStatsLaneCount) {
+        for (int lane = 0; lane < BucketStatsLaneCount; ++lane) {
+            TBucketStats& leafStats = lanes[lane][singleIdx[doc + lane]];
+            leafStats.SumWeightedDelta += weightedDer[doc + lane];
+            leafStats.SumWeight += hasSampleWeights ? sampleWeights[doc + lane] : 1.0f;
+        }
+    }
+    UpdateWeighted(hasSampleWeights, singleIdx, weightedDer, sampleWeights, doc, docEnd, stats);
+}
+
 // Update not bootstraped sums on [docBegin, docEnd) in a bucket
-template<typename TFullIndexType>
-inline void UpdateDeltaCount(const TVector<TFullIndexType>& singleIdx, const double* derivatives, const float* learnWeights, int docCount, TBucketStats* stats) {
+template<typename TFullIndexType, typename TDerType>
+inline void UpdateDeltaCount(const TVector<TFullIndexType>& singleIdx, const TDerType* derivatives, const float* learnWeights, int docBegin, int docEnd, TBucketStats* stats) {
     if (learnWeights == nullptr) {
-        for (int doc = 0; doc < docCount; ++doc) {
+        for (int doc = docBegin; doc < docEnd; ++doc) {
             TBucketStats& leafStats = stats[singleIdx[doc]];
             leafStats.SumDelta += derivatives[doc];
             leafStats.Count += 1;
         }
     } else {
-        for (int doc = 0; doc < docCount; ++doc) {
+        for (int doc = docBegin; doc < docEnd; ++doc) {
             TBucketStats& leafStats = stats[singleIdx[doc]];
             leafStats.SumDelta += derivatives[doc];
             leafStats.Count += learnWeights[doc];
@@ -174,6 +277,96 @@ inline void UpdateDeltaCount(const TVector<TFullIndexType>& singleIdx, const dou
     }
 }
 
+// Lane-privatized version of UpdateDeltaCount; laneStats points at BucketStatsLaneCount - 1 zeroed histograms.
+template<typename TFullIndexType, typename TDerType>
+inline void UpdateDeltaCountLanes(const TVector<TFullIndexType>& singleIdx, const TDerType* derivatives, const float* learnWeights, int docCount, int statsSize, TBucketStats* stats, TBucketStats* laneStats) {
+    TBucketStats* lanes[BucketStatsLaneCount];
+    lanes[0] = stats;
+    for (int lane = 1; lane < BucketStatsLaneCount; ++lane) {
+        lanes[lane] = laneStats + (lane - 1) * statsSize;
+    }
+    int doc = 0;
+    if (learnWeights == nullptr) {
+        for (; doc + BucketStatsLaneCount <= docCount; doc += BucketStatsLaneCount) {
+            for (int lane = 0; lane < BucketStatsLaneCount; ++lane) {
+                TBucketStats& leafStats = lanes[lane][singleIdx[doc + lane]];
+                leafStats.SumDelta += derivatives[doc + lane];
+                leafStats.Count += 1;
+            }
+        }
+        for (; doc < docCount; ++doc) {
+            TBucketStats& leafStats = stats[singleIdx[doc]];
+            leafStats.SumDelta += derivatives[doc];
+            leafStats.Count += 1;
+        }
+    } else {
+        for (; doc + BucketStatsLaneCount <= docCount; doc += BucketStatsLaneCount) {
+            for (int lane = 0; lane < BucketStatsLaneCount; ++lane) {
+                TBucketStats& leafStats = lanes[lane][singleIdx[doc + lane]];
+                leafStats.SumDelta += derivatives[doc + lane];
+                leafStats.Count += learnWeights[doc + lane];
+            }
+        }
+        for (; doc < docCount; ++doc) {
+            TBucketStats& leafStats = stats[singleIdx[doc]];
+            leafStats.SumDelta += derivatives[doc];
+            leafStats.Count += learnWeights[doc];
+        }
+    }
+}
+
+// Fold the private lane histograms back into the main one.
+inline void MergeBucketStatsLanes(int statsSize, TBucketStats* stats, const TBucketStats* laneStats) {
+    for (int lane = 1; lane < BucketStatsLaneCount; ++lane) {
+        const TBucketStats* laneData = laneStats + (lane - 1) * statsSize;
+        for (int statIdx = 0; statIdx < statsSize; ++statIdx) {
+            stats[statIdx].Add(laneData[statIdx]);
+        }
+    }
+}
+
+// Accumulate one body-tail dimension into the bucket histograms; the derivative arrays may be
+// stored as float or double (see TCalcScoreFold single precision mode), the sums are double
+// either way.
+template<typename THasSampleWeights, typename TFullIndexType, typename TDerType>
+inline void UpdateBucketStats(const THasSampleWeights& hasSampleWeights,
+                              const TVector<TFullIndexType>& singleIdx,
+                              const TDerType* derivativesData,
+                              const TDerType* sampleDerivativesData,
+                              const float* weightsData,
+                              const float* sampleWeightsData,
+                              bool isPlainMode,
+                              int bodyFinish,
+                              int tailFinish,
+                              int statsSize,
+                              TBucketStats* stats) {
+    if (ShouldUseLanes(tailFinish, statsSize)) {
+        TVector<TBucketStats> laneScratch;
+        laneScratch.resize((BucketStatsLaneCount - 1) * statsSize, TBucketStats{0, 0, 0, 0});
+        TBucketStats* laneStats = laneScratch.data();
+        if (isPlainMode) {
+            UpdateWeightedLanes(hasSampleWeights, singleIdx, sampleDerivativesData, sampleWeightsData, 0, tailFinish, statsSize, stats, laneStats);
+        } else {
+            UpdateDeltaCountLanes(singleIdx, derivativesData, weightsData, bodyFinish, statsSize, stats, laneStats);
+            UpdateWeightedLanes(hasSampleWeights, singleIdx, sampleDerivativesData, sampleWeightsData, bodyFinish, tailFinish, statsSize, stats, laneStats);
+        }
+        MergeBucketStatsLanes(statsSize, stats, laneStats);
+    } else if (isPlainMode) {
+        UpdateWeighted(hasSampleWeights, singleIdx, sampleDerivativesData, sampleWeightsData, 0, tailFinish, stats);
+    } else {
+        UpdateDeltaCount(singleIdx, derivativesData, weightsData, 0, bodyFinish, stats);
+        UpdateWeighted(hasSampleWeights, singleIdx, sampleDerivativesData, sampleWeightsData, bodyFinish, tailFinish, stats);
+    }
+}
+
+/*
+ * Score sink for splits whose leaf estimates violate a monotone constraint. Applied as a
+ * branchless subtraction inside the split-evaluation pass, on the leaf averages it already
+ * computes, so constrained features score at the same cost as unconstrained ones; the
+ * resulting score is so negative that the split can never win candidate selection.
+ */
+constexpr double MonotonicityViolationPenalty = 1e38;
+
 // Calculate score numerator summand
 inline double CountDp(double avrg, const TBucketStats& leafStats) {
     return avrg * leafStats.SumWeightedDelta;
@@ -185,16 +378,19 @@ inline double CountD2(double avrg, const TBucketStats& leafStats) {
 }
 
 // This function calculates resulting sums for each split given statistics that are calculated for each bucket of the histogram.
-template<typename TIsPlainMode>
+// monotoneDirection constrains the ordering of the per-leaf estimates of float splits
+// (see MonotonicityViolationPenalty); pass 0 for unconstrained candidates.
+template<typename TStatsIndexerType, typename TIsPlainMode>
 inline void UpdateScoreBin(
     const TBucketStats* stats,
     int leafCount,
-    const TStatsIndexer& indexer,
+    const TStatsIndexerType& indexer,
     ESplitType splitType,
     float l2Regularizer,
     TIsPlainMode isPlainMode,
     double sumAllWeights,
     int allDocCount,
+    int monotoneDirection,
     TVector<TScoreBin>* scoreBin) {
 
     for (int leaf = 0; leaf < leafCount; ++leaf) {
@@ -218,6 +414,12 @@ inline void UpdateScoreBin(
                     trueAvrg = CalcAverage(trueStats.SumDelta, trueStats.Count, l2Regularizer, sumAllWeights, allDocCount);
                     falseAvrg = CalcAverage(falseStats.SumDelta, falseStats.Count, l2Regularizer, sumAllWeights, allDocCount);
                 }
+                if (monotoneDirection != 0) {
+                    // reuse the averages already computed for scoring; the branchless sink
+                    // keeps the loop free of a violating-split re-scan
+                    const double violation = (trueAvrg - falseAvrg) * monotoneDirection < 0 ? 1.0 : 0.0;
+                    (*scoreBin)[splitIdx].DP -= violation * MonotonicityViolationPenalty;
+                }
                 (*scoreBin)[splitIdx].DP += CountDp(trueAvrg, trueStats) + CountDp(falseAvrg, falseStats);
                 (*scoreBin)[splitIdx].D2 += CountD2(trueAvrg, trueStats) + CountD2(falseAvrg, falseStats);
             }
@@ -250,26 +452,39 @@ int GetSplitCount(const TVector<int>& splitsCount,
                   const TVector<TVector<int>>& oneHotValues,
                   const TSplitCandidate& split);
 
-inline void FixUpStats(int depth, const TStatsIndexer& indexer, bool selectedSplitValue, TBucketStats* stats) {
+/*
+ * Derive the sibling histograms from the cached parent level by subtraction: only the
+ * smallest split side was accumulated (upper half of `stats`), the complement is
+ * parent minus child. This halves per-depth histogram work for the cached candidates.
+ */
+template<typename TStatsIndexerType>
+inline void FixUpStats(int depth, const TStatsIndexerType& indexer, bool selectedSplitValue, TBucketStats* stats) {
     const int halfOfStats = indexer.CalcSize(depth - 1);
+    static_assert(sizeof(TBucketStats) == 4 * sizeof(double), "expected TBucketStats to be 4 contiguous doubles");
+    // subtract the whole half as two-wide double vectors instead of per-field scalar ops
+    double* parent = reinterpret_cast<double*>(stats);
+    double* child = reinterpret_cast<double*>(stats + halfOfStats);
+    const int doubleCount = halfOfStats * 4;
     if (selectedSplitValue == true) {
-        for (int statIdx = 0; statIdx < halfOfStats; ++statIdx) {
-            stats[statIdx].Remove(stats[statIdx + halfOfStats]);
+        for (int i = 0; i < doubleCount; i += 2) {
+            _mm_storeu_pd(parent + i, _mm_sub_pd(_mm_loadu_pd(parent + i), _mm_loadu_pd(child + i)));
         }
     } else {
-        for (int statIdx = 0; statIdx < halfOfStats; ++statIdx) {
-            stats[statIdx].Remove(stats[statIdx + halfOfStats]);
-            DoSwap(stats[statIdx], stats[statIdx + halfOfStats]);
+        for (int i = 0; i < doubleCount; i += 2) {
+            const __m128d childVal = _mm_loadu_pd(child + i);
+            const __m128d complement = _mm_sub_pd(_mm_loadu_pd(parent + i), childVal);
+            _mm_storeu_pd(parent + i, childVal);
+            _mm_storeu_pd(child + i, complement);
         }
     }
 }
 
-template<typename TFullIndexType, typename TIsCaching>
+template<typename TStatsIndexerType, typename TFullIndexType, typename TIsCaching>
 inline void CalcStatsKernel(const TIsCaching& isCaching,
                             const TVector<TFullIndexType>& singleIdx,
                             const TCalcScoreFold& fold,
                             bool isPlainMode,
-                            const TStatsIndexer& indexer,
+                            const TStatsIndexerType& indexer,
                             int depth,
                             const TCalcScoreFold::TBodyTail& bt,
                             int dim,
@@ -284,13 +499,101 @@ inline void CalcStatsKernel(const TIsCaching& isCaching,
     const bool hasPairwiseWeights = !bt.PairwiseWeights.empty();
     const float* weightsData = hasPairwiseWeights ? GetDataPtr(bt.PairwiseWeights) : GetDataPtr(fold.LearnWeights);
     const float* sampleWeightsData = hasPairwiseWeights ? GetDataPtr(bt.SamplePairwiseWeights) : GetDataPtr(fold.SampleWeights);
-    if (isPlainMode) {
-        UpdateWeighted(singleIdx, GetDataPtr(bt.SampleWeightedDerivatives[dim]), sampleWeightsData, 0, bt.TailFinish, stats);
+    const int statsSize = indexer.CalcSize(depth);
+    auto updateBucketStats = [&](auto hasSampleWeights) {
+        if (fold.HasSinglePrecisionDerivatives()) {
+            UpdateBucketStats(hasSampleWeights, singleIdx, GetDataPtr(bt.WeightedDerivativesFloat[dim]), GetDataPtr(bt.SampleWeightedDerivativesFloat[dim]), weightsData, sampleWeightsData, isPlainMode, bt.BodyFinish, bt.TailFinish, statsSize, stats);
+        } else {
+            UpdateBucketStats(hasSampleWeights, singleIdx, GetDataPtr(bt.WeightedDerivatives[dim]), GetDataPtr(bt.SampleWeightedDerivatives[dim]), weightsData, sampleWeightsData, isPlainMode, bt.BodyFinish, bt.TailFinish, statsSize, stats);
+        }
+    };
+    // pairwise weights come from the bootstrap and are never trivial
+    if (!hasPairwiseWeights && fold.HasTrivialSampleWeights()) {
+        updateBucketStats(/*hasSampleWeights*/ std::false_type());
     } else {
-        UpdateDeltaCount(singleIdx, GetDataPtr(bt.WeightedDerivatives[dim]), weightsData, bt.BodyFinish, stats);
-        UpdateWeighted(singleIdx, GetDataPtr(bt.SampleWeightedDerivatives[dim]), sampleWeightsData, bt.BodyFinish, bt.TailFinish, stats);
+        updateBucketStats(/*hasSampleWeights*/ std::true_type());
     }
     if (isCaching) {
         FixUpStats(depth, indexer, fold.SmallestSplitSideValue, stats);
     }
 }
+
+/*
+ * Two-level histogram build. The per-candidate kernel above is single threaded over the
+ * documents; when there are fewer candidates than threads that leaves most of the pool
+ * idle, so the document range is split into per-task partial histograms instead and the
+ * partials are folded back in parallel over the stats dimension. Every partial must
+ * amortize zeroing and merging its own statsSize-sized histogram, so wide histograms or
+ * small folds fall back to the single-level kernel.
+ */
+inline int SelectBucketStatsPartialCount(int docCount, int statsSize, int threadCount) {
+    return Min(threadCount, docCount / (2 * statsSize + 1));
+}
+
+template<typename TStatsIndexerType, typename TFullIndexType>
+inline void CalcStatsKernelParallel(const TVector<TFullIndexType>& singleIdx,
+                                    const TCalcScoreFold& fold,
+                                    bool isPlainMode,
+                                    const TStatsIndexerType& indexer,
+                                    int depth,
+                                    const TCalcScoreFold::TBodyTail& bt,
+                                    int dim,
+                                    int partialCount,
+                                    NPar::TLocalExecutor* localExecutor,
+                                    TBucketStats* stats) {
+    Y_ASSERT(partialCount > 1);
+    const int statsSize = indexer.CalcSize(depth);
+    const int bodyFinish = bt.BodyFinish;
+    const int tailFinish = bt.TailFinish;
+
+    const bool hasPairwiseWeights = !bt.PairwiseWeights.empty();
+    const float* weightsData = hasPairwiseWeights ? GetDataPtr(bt.PairwiseWeights) : GetDataPtr(fold.LearnWeights);
+    const float* sampleWeightsData = hasPairwiseWeights ? GetDataPtr(bt.SamplePairwiseWeights) : GetDataPtr(fold.SampleWeights);
+
+    TVector<TBucketStats> partialScratch;
+    partialScratch.yresize((partialCount - 1) * statsSize);
+
+    const int docsPerPartial = (tailFinish + partialCount - 1) / partialCount;
+    // pairwise weights come from the bootstrap and are never trivial
+    const bool trivialSampleWeights = !hasPairwiseWeights && fold.HasTrivialSampleWeights();
+    auto accumulatePartial = [&](auto hasSampleWeights, const auto* derivativesData, const auto* sampleDerivativesData, int partialIdx) {
+        TBucketStats* partialStats = partialIdx == 0 ? stats : partialScratch.data() + (partialIdx - 1) * statsSize;
+        Fill(partialStats, partialStats + statsSize, TBucketStats{0, 0, 0, 0});
+        const int docBegin = partialIdx * docsPerPartial;
+        const int docEnd = Min(docBegin + docsPerPartial, tailFinish);
+        if (isPlainMode) {
+            UpdateWeighted(hasSampleWeights, singleIdx, sampleDerivativesData, sampleWeightsData, docBegin, docEnd, partialStats);
+        } else {
+            // the body prefix of the range gets the raw sums, the rest the bootstrapped ones
+            UpdateDeltaCount(singleIdx, derivativesData, weightsData, docBegin, Min(docEnd, bodyFinish), partialStats);
+            UpdateWeighted(hasSampleWeights, singleIdx, sampleDerivativesData, sampleWeightsData, Max(docBegin, bodyFinish), docEnd, partialStats);
+        }
+    };
+    if (fold.HasSinglePrecisionDerivatives()) {
+        localExecutor->ExecRange([&](int partialIdx) {
+            if (trivialSampleWeights) {
+                accumulatePartial(std::false_type(), GetDataPtr(bt.WeightedDerivativesFloat[dim]), GetDataPtr(bt.SampleWeightedDerivativesFloat[dim]), partialIdx);
+            } else {
+                accumulatePartial(std::true_type(), GetDataPtr(bt.WeightedDerivativesFloat[dim]), GetDataPtr(bt.SampleWeightedDerivativesFloat[dim]), partialIdx);
+            }
+        }, 0, partialCount, NPar::TLocalExecutor::WAIT_COMPLETE);
+    } else {
+        localExecutor->ExecRange([&](int partialIdx) {
+            if (trivialSampleWeights) {
+                accumulatePartial(std::false_type(), GetDataPtr(bt.WeightedDerivatives[dim]), GetDataPtr(bt.SampleWeightedDerivatives[dim]), partialIdx);
+            } else {
+                accumulatePartial(std::true_type(), GetDataPtr(bt.WeightedDerivatives[dim]), GetDataPtr(bt.SampleWeightedDerivatives[dim]), partialIdx);
+            }
+        }, 0, partialCount, NPar::TLocalExecutor::WAIT_COMPLETE);
+    }
+
+    NPar::TLocalExecutor::TExecRangeParams mergeParams(0, statsSize);
+    mergeParams.SetBlockSize(2000);
+    localExecutor->ExecRange([&](int blockIdx) {
+        NPar::TLocalExecutor::BlockedLoopBody(mergeParams, [&](int statIdx) {
+            for (int partialIdx = 1; partialIdx < partialCount; ++partialIdx) {
+                stats[statIdx].Add(partialScratch[(partialIdx - 1) * statsSize + statIdx]);
+            }
+        })(blockIdx);
+    }, 0, mergeParams.GetBlockCount(), NPar::TLocalExecutor::WAIT_COMPLETE);
+}
@@ -0,0 +1,166 @@
+#include "streaming_borders.h"
+
+#include <catboost/libs/logging/logging.h>
+
+#include <library/grid_creator/binarization.h>
+
+#include <util/generic/algorithm.h>
+#include <util/generic/ymath.h>
+#include <util/system/atomic.h>
+
+#include <cmath>
+
+void TFeatureBorderReservoir::Add(float value, float weight) {
+    if (IsNan(value) || !(weight > 0)) {
+        return;
+    }
+    // A-Res key: uniform(0,1] ^ (1/weight); the heavier the document, the closer to 1
+    const double key = pow(Rand.GenRandReal1(), 1.0 / weight);
+    if (Entries.size() < Capacity) {
+        Entries.push_back({key, value});
+        std::push_heap(Entries.begin(), Entries.end());
+        return;
+    }
+    if (key <= Entries.front().Key) {
+        return;
+    }
+    std::pop_heap(Entries.begin(), Entries.end());
+    Entries.back() = {key, value};
+    std::push_heap(Entries.begin(), Entries.end());
+}
+
+TVector<float> TFeatureBorderReservoir::GetValues() const {
+    TVector<float> values;
+    values.reserve(Entries.size());
+    for (const auto& entry : Entries) {
+        values.push_back(entry.Value);
+    }
+    return values;
+}
+
+// Bin index as BinarizeFloatFeature assigns it: the number of borders below the value.
+static inline int GetBin(float value, const TVector<float>& borders) {
+    return static_cast<int>(LowerBound(borders.begin(), borders.end(), value) - borders.begin());
+}
+
+/*
+ * Map every old bin to the new bin its representative value falls into. Bin i covers
+ * (oldBorders[i-1], oldBorders[i]], so its inclusive upper border represents it; the
+ * open-ended last bin is represented by "just above" the last border.
+ */
+static TVector<ui8> BuildBinRemap(const TVector<float>& oldBorders, const TVector<float>& newBorders) {
+    TVector<ui8> remap(oldBorders.size() + 1);
+    for (size_t bin = 0; bin < oldBorders.size(); ++bin) {
+        remap[bin] = static_cast<ui8>(GetBin(oldBorders[bin], newBorders));
+    }
+    remap[oldBorders.size()] = static_cast<ui8>(
+        UpperBound(newBorders.begin(), newBorders.end(), oldBorders.back()) - newBorders.begin());
+    return remap;
+}
+
+void TStreamingBorderTracker::AddChunk(const TDocumentStorage& docs) {
+    if (Reservoirs.empty()) {
+        Reservoirs.reserve(docs.GetEffectiveFactorCount());
+        for (int factorIdx = 0; factorIdx < docs.GetEffectiveFactorCount(); ++factorIdx) {
+            Reservoirs.emplace_back(ReservoirCapacity, Seed + factorIdx);
+        }
+    }
+    const bool trivialWeights = docs.IsTrivialWeights();
+    for (int factorIdx = 0; factorIdx < docs.GetEffectiveFactorCount(); ++factorIdx) {
+        if (CatFeatures.has(factorIdx)) {
+            continue;
+        }
+        const TConstArrayRef<float> factor = docs.GetFactorRef(factorIdx);
+        auto& reservoir = Reservoirs[factorIdx];
+        for (size_t docIdx = 0; docIdx < factor.size(); ++docIdx) {
+            reservoir.Add(factor[docIdx], trivialWeights ? 1.0f : docs.Weight[docIdx]);
+        }
+    }
+}
+
+TVector<float> TStreamingBorderTracker::RederiveBorders(const TFloatFeature& floatFeature) const {
+    TVector<float> vals = Reservoirs[floatFeature.FlatFeatureIndex].GetValues();
+    THashSet<float> borderSet = BestSplit(vals, BinarizationOptions.BorderCount, BinarizationOptions.BorderSelectionType);
+    if (borderSet.has(-0.0f)) { // BestSplit might add negative zeros
+        borderSet.erase(-0.0f);
+        borderSet.insert(0.0f);
+    }
+    TVector<float> borders(borderSet.begin(), borderSet.end());
+    Sort(borders.begin(), borders.end());
+    // keep the nan sentinel border the feature was quantized with
+    if (floatFeature.HasNans) {
+        if (floatFeature.NanValueTreatment == NCatBoostFbs::ENanValueTreatment_AsFalse) {
+            borders.insert(borders.begin(), std::numeric_limits<float>::lowest());
+        } else if (floatFeature.NanValueTreatment == NCatBoostFbs::ENanValueTreatment_AsTrue) {
+            borders.push_back(std::numeric_limits<float>::max());
+        }
+    }
+    return borders;
+}
+
+static double CalcBinDisagreement(const TVector<float>& values,
+                                  const TVector<float>& oldBorders,
+                                  const TVector<float>& newBorders) {
+    if (values.empty()) {
+        return 0;
+    }
+    size_t changedCount = 0;
+    for (float value : values) {
+        if (GetBin(value, oldBorders) != GetBin(value, newBorders)) {
+            ++changedCount;
+        }
+    }
+    return static_cast<double>(changedCount) / values.size();
+}
+
+double TStreamingBorderTracker::CalcDrift(const TFloatFeature& floatFeature) const {
+    if (Reservoirs.empty() || Reservoirs[floatFeature.FlatFeatureIndex].GetSampleCount() < 2) {
+        return 0;
+    }
+    return CalcBinDisagreement(Reservoirs[floatFeature.FlatFeatureIndex].GetValues(),
+                               floatFeature.Borders,
+                               RederiveBorders(floatFeature));
+}
+
+int TStreamingBorderTracker::UpdateDriftedBorders(double driftThreshold,
+                                                  TVector<TFloatFeature>* floatFeatures,
+                                                  const TVector<TAllFeatures*>& allFeatures,
+                                                  NPar::TLocalExecutor* localExecutor) {
+    if (Reservoirs.empty()) {
+        return 0;
+    }
+    TAtomic updatedCount = 0;
+    localExecutor->ExecRange([&](int idx) {
+        auto& floatFeature = (*floatFeatures)[idx];
+        if (floatFeature.Borders.empty() ||
+            Reservoirs[floatFeature.FlatFeatureIndex].GetSampleCount() < 2) {
+            return;
+        }
+        const TVector<float> values = Reservoirs[floatFeature.FlatFeatureIndex].GetValues();
+        TVector<float> newBorders = RederiveBorders(floatFeature);
+        const double drift = CalcBinDisagreement(values, floatFeature.Borders, newBorders);
+        if (drift <= driftThreshold || newBorders == floatFeature.Borders) {
+            return;
+        }
+        const TVector<ui8> remap = BuildBinRemap(floatFeature.Borders, newBorders);
+        for (TAllFeatures* features : allFeatures) {
+            if (floatFeature.FeatureIndex >= features->FloatHistograms.ysize()) {
+                continue;
+            }
+            TVector<ui8>& hist = features->FloatHistograms[floatFeature.FeatureIndex];
+            if (hist.empty()) {
+                // constant, bundled or bit-packed column: its bins are not stored here
+                continue;
+            }
+            for (ui8& bin : hist) {
+                bin = remap[bin];
+            }
+        }
+        MATRIXNET_DEBUG_LOG << "Feature " << floatFeature.FlatFeatureIndex << " drifted by "
+            << drift << ", borders re-derived (" << floatFeature.Borders.ysize()
+            << " -> " << newBorders.ysize() << ")" << Endl;
+        floatFeature.Borders.swap(newBorders);
+        AtomicIncrement(updatedCount);
+    }, 0, floatFeatures->ysize(), NPar::TLocalExecutor::WAIT_COMPLETE);
+    return static_cast<int>(AtomicGet(updatedCount));
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <catboost/libs/data/pool.h>
+#include <catboost/libs/data/quantized_features.h>
+#include <catboost/libs/model/features.h>
+#include <catboost/libs/options/binarization_options.h>
+
+#include <library/threading/local_executor/local_executor.h>
+
+#include <util/generic/hash_set.h>
+#include <util/generic/vector.h>
+#include <util/random/fast.h>
+
+/*
+ * Fixed-capacity weighted reservoir of one feature's values (algorithm A-Res: keep the
+ * samples with the largest u^(1/w) keys). Gives an unbiased weighted sample of everything
+ * fed so far, so borders derived from it track the whole stream, not the last chunk.
+ */
+class TFeatureBorderReservoir {
+public:
+    TFeatureBorderReservoir(size_t capacity, ui64 seed)
+        : Capacity(capacity)
+        , Rand(seed)
+    {
+    }
+
+    void Add(float value, float weight);
+
+    TVector<float> GetValues() const;
+
+    size_t GetSampleCount() const {
+        return Entries.size();
+    }
+
+private:
+    struct TEntry {
+        double Key = 0;
+        float Value = 0;
+        bool operator<(const TEntry& other) const {
+            return Key > other.Key; // std heap with the smallest key on top
+        }
+    };
+
+    TVector<TEntry> Entries;
+    size_t Capacity;
+    TFastRng64 Rand;
+};
+
+/*
+ * Streaming float feature border maintenance for continual retrains. Every non-cat factor
+ * column of each arriving pool chunk is fed into a per-feature weighted reservoir; borders
+ * are re-derived from a reservoir only when the share of its documents that would change
+ * bin exceeds a drift threshold, and the already quantized columns are then remapped
+ * bin-to-bin in place instead of rebuilding TAllFeatures from the raw values.
+ */
+class TStreamingBorderTracker {
+public:
+    TStreamingBorderTracker(const NCatboostOptions::TBinarizationOptions& binarizationOptions,
+                            const THashSet<int>& catFeatures,
+                            size_t reservoirCapacity,
+                            ui64 seed)
+        : BinarizationOptions(binarizationOptions)
+        , CatFeatures(catFeatures)
+        , ReservoirCapacity(reservoirCapacity)
+        , Seed(seed)
+    {
+    }
+
+    // Feed every float factor column of the chunk; document weights are respected.
+    void AddChunk(const TDocumentStorage& docs);
+
+    // Share of the feature's reservoir documents that would land in a different bin if its
+    // borders were re-derived right now; 0 while the reservoir is (almost) empty.
+    double CalcDrift(const TFloatFeature& floatFeature) const;
+
+    /*
+     * Re-derive borders for every feature whose drift exceeds `driftThreshold`, update
+     * `floatFeatures` in place and remap the feature's quantized column in every dataset of
+     * `allFeatures` bin-to-bin. Bundled, bit-packed and empty columns are left alone: their
+     * bins do not live in FloatHistograms. Returns the number of features that changed.
+     */
+    int UpdateDriftedBorders(double driftThreshold,
+                             TVector<TFloatFeature>* floatFeatures,
+                             const TVector<TAllFeatures*>& allFeatures,
+                             NPar::TLocalExecutor* localExecutor);
+
+private:
+    TVector<float> RederiveBorders(const TFloatFeature& floatFeature) const;
+
+    NCatboostOptions::TBinarizationOptions BinarizationOptions;
+    THashSet<int> CatFeatures;
+    size_t ReservoirCapacity;
+    ui64 Seed;
+    TVector<TFeatureBorderReservoir> Reservoirs; // [flatFeatureIdx], unused slots for cat features
+};
@@ -2,15 +2,82 @@
 
 #include <catboost/libs/helpers/restorable_rng.h>
 
+#include <util/generic/algorithm.h>
+
+/* Fused continuation of the bootstrap pass over one block of documents: while the block's
+ * freshly generated sample weights are still in cache, produce the sample-weighted
+ * derivative (and pairwise weight) copies and fold the document weights in, instead of
+ * re-streaming the full arrays in a separate sweep afterwards. The derivative products use
+ * the weights before the document-weight multiplication, exactly like the unfused order did.
+ */
+static void CalcWeightedDataInBlock(
+    int blockBegin,
+    int blockEnd,
+    EBoostingType boostingType,
+    TFold* fold
+) {
+    TFold& ff = *fold;
+    const int approxDimension = ff.GetApproxDimension();
+    const float* sampleWeightsData = ff.SampleWeights.data();
+    for (TFold::TBodyTail& bt : ff.BodyTailArr) {
+        const int begin = Max(blockBegin, IsPlainMode(boostingType) ? 0 : bt.BodyFinish);
+        const int end = Min(blockEnd, bt.TailFinish);
+        if (begin >= end) {
+            continue;
+        }
+        if (!bt.PairwiseWeights.empty()) {
+            const float* pairwiseWeightsData = bt.PairwiseWeights.data();
+            float* samplePairwiseWeightsData = bt.SamplePairwiseWeights.data();
+            for (int z = begin; z < end; ++z) {
+                samplePairwiseWeightsData[z] = pairwiseWeightsData[z] * sampleWeightsData[z];
+            }
+        }
+        for (int dim = 0; dim < approxDimension; ++dim) {
+            const double* weightedDerivativesData = bt.WeightedDerivatives[dim].data();
+            double* sampleWeightedDerivativesData = bt.SampleWeightedDerivatives[dim].data();
+            for (int z = begin; z < end; ++z) {
+                sampleWeightedDerivativesData[z] = weightedDerivativesData[z] * sampleWeightsData[z];
+            }
+        }
+    }
+    const auto& learnWeights = ff.GetLearnWeights();
+    if (!learnWeights.empty()) {
+        float* mutableSampleWeightsData = ff.SampleWeights.data();
+        for (int z = blockBegin; z < blockEnd; ++z) {
+            mutableSampleWeightsData[z] *= learnWeights[z];
+        }
+    }
+}
+
+static void FillOnesAndCalcWeightedData(
+    int learnSampleCount,
+    EBoostingType boostingType,
+    NPar::TLocalExecutor* localExecutor,
+    TFold* fold
+) {
+    NPar::TLocalExecutor::TExecRangeParams blockParams(0, learnSampleCount);
+    blockParams.SetBlockSize(1000);
+    localExecutor->ExecRange([&](int blockIdx) {
+        const int blockBegin = blockIdx * blockParams.GetBlockSize();
+        const int blockEnd = Min<int>(blockBegin + blockParams.GetBlockSize(), learnSampleCount);
+        float* sampleWeightsData = fold->SampleWeights.data();
+        for (int i = blockBegin; i < blockEnd; ++i) {
+            sampleWeightsData[i] = 1.0f;
+        }
+        CalcWeightedDataInBlock(blockBegin, blockEnd, boostingType, fold);
+    }, 0, blockParams.GetBlockCount(), NPar::TLocalExecutor::WAIT_COMPLETE);
+}
+
 static void GenerateRandomWeights(
     int learnSampleCount,
     float baggingTemperature,
+    EBoostingType boostingType,
     NPar::TLocalExecutor* localExecutor,
     TRestorableFastRng64* rand,
     TFold* fold
 ) {
     if (baggingTemperature == 0) {
-        Fill(fold->SampleWeights.begin(), fold->SampleWeights.end(), 1);
+        FillOnesAndCalcWeightedData(learnSampleCount, boostingType, localExecutor, fold);
         return;
     }
 
@@ -20,11 +87,14 @@ static void GenerateRandomWeights(
     localExecutor->ExecRange([&](int blockIdx) {
         TRestorableFastRng64 rand(randSeed + blockIdx);
         rand.Advance(10); // reduce correlation between RNGs in different threads
+        const int blockBegin = blockIdx * blockParams.GetBlockSize();
+        const int blockEnd = Min<int>(blockBegin + blockParams.GetBlockSize(), learnSampleCount);
         float* sampleWeightsData = fold->SampleWeights.data();
-        NPar::TLocalExecutor::BlockedLoopBody(blockParams, [=,&rand](int i) {
+        for (int i = blockBegin; i < blockEnd; ++i) {
             const float w = -FastLogf(rand.GenRandReal1() + 1e-100);
             sampleWeightsData[i] = powf(w, baggingTemperature);
-        })(blockIdx);
+        }
+        CalcWeightedDataInBlock(blockBegin, blockEnd, boostingType, fold);
     }, 0, blockParams.GetBlockCount(), NPar::TLocalExecutor::WAIT_COMPLETE);
 }
 
@@ -54,12 +124,20 @@ static void GenerateBayesianWeightsForPairs(
     }, 0, blockParams.GetBlockCount(), NPar::TLocalExecutor::WAIT_COMPLETE);
 }
 
-static void GenerateBernoulliWeightsForPairs(
+// Bernoulli sampling at query granularity: a query is taken whole or dropped whole, so the
+// sampled documents remain a concatenation of complete queries and TCalcScoreFold::Sample can
+// exclude the dropped documents from the gathered fold instead of scoring the full pool with
+// zeroed pair weights. The drop decision is encoded as zero sample weights for every document
+// of a dropped query. Pair weights inside a taken query are left unscaled: the pairwise score
+// is solved from pair weight and derivative sums over the same taken queries, so a uniform
+// 1/takenFraction compensation factor would cancel out.
+static void GenerateQuerywiseBernoulliWeights(
     float takenFraction,
     NPar::TLocalExecutor* localExecutor,
     TRestorableFastRng64* rand,
     TFold* fold
 ) {
+    Fill(fold->SampleWeights.begin(), fold->SampleWeights.end(), 1);
     if (takenFraction == 1.0f) {
         return;
     }
@@ -69,59 +147,81 @@ static void GenerateBernoulliWeightsForPairs(
     localExecutor->ExecRange([&](int blockIdx) {
         TRestorableFastRng64 rand(randSeed + blockIdx);
         rand.Advance(10); // reduce correlation between RNGs in different threads
-        NPar::TLocalExecutor::BlockedLoopBody(blockParams, [&](int i) {
-            for (auto& competitors : fold->LearnQueriesInfo[i].Competitors) {
-                for (auto& competitor : competitors) {
-                    if (rand.GenRandReal1() < takenFraction) {
+        float* sampleWeightsData = fold->SampleWeights.data();
+        NPar::TLocalExecutor::BlockedLoopBody(blockParams, [=,&rand](int i) {
+            TQueryInfo& queryInfo = fold->LearnQueriesInfo[i];
+            if (rand.GenRandReal1() < takenFraction) {
+                for (auto& competitors : queryInfo.Competitors) {
+                    for (auto& competitor : competitors) {
                         competitor.SampleWeight = competitor.Weight;
-                    } else {
-                        competitor.SampleWeight = 0.0f;
                     }
                 }
+            } else {
+                for (int docIdx = queryInfo.Begin; docIdx < queryInfo.End; ++docIdx) {
+                    sampleWeightsData[docIdx] = 0.0f;
+                }
             }
         })(blockIdx);
     }, 0, blockParams.GetBlockCount(), NPar::TLocalExecutor::WAIT_COMPLETE);
 }
 
-static void CalcWeightedData(
+// Gradient-based one-side sampling: keep every document whose gradient magnitude is in the
+// top topFraction, subsample the rest so that takenFraction of all documents survive, and
+// compensate the survivors' weights to keep the bucket statistics unbiased. The threshold is
+// recomputed from the current derivatives on every call, so the kept set follows the fit.
+static void GenerateGossWeights(
     int learnSampleCount,
+    float topFraction,
+    float takenFraction,
     EBoostingType boostingType,
     NPar::TLocalExecutor* localExecutor,
+    TRestorableFastRng64* rand,
     TFold* fold
 ) {
-    TFold& ff = *fold;
-
-    const int approxDimension = ff.GetApproxDimension();
-    for (TFold::TBodyTail& bt : ff.BodyTailArr) {
-        int begin = 0;
-        if (!IsPlainMode(boostingType)) {
-            begin = bt.BodyFinish;
-        }
-        const float* sampleWeightsData = ff.SampleWeights.data();
-        if (!bt.PairwiseWeights.empty()) {
-            const float* pairwiseWeightsData = bt.PairwiseWeights.data();
-            float* samplePairwiseWeightsData = bt.SamplePairwiseWeights.data();
-            localExecutor->ExecRange([=](int z) {
-                samplePairwiseWeightsData[z] = pairwiseWeightsData[z] * sampleWeightsData[z];
-            }, NPar::TLocalExecutor::TExecRangeParams(begin, bt.TailFinish).SetBlockSize(4000)
-             , NPar::TLocalExecutor::WAIT_COMPLETE);
-        }
+    const TFold::TBodyTail& bt = fold->BodyTailArr[0];
+    const int approxDimension = fold->GetApproxDimension();
+    TVector<float> derAbs;
+    derAbs.yresize(learnSampleCount);
+    float* derAbsData = derAbs.data();
+    localExecutor->ExecRange([=,&bt](int z) {
+        double sumDerAbs = 0;
         for (int dim = 0; dim < approxDimension; ++dim) {
-            const double* weightedDerivativesData = bt.WeightedDerivatives[dim].data();
-            double* sampleWeightedDerivativesData = bt.SampleWeightedDerivatives[dim].data();
-            localExecutor->ExecRange([=](int z) {
-                sampleWeightedDerivativesData[z] = weightedDerivativesData[z] * sampleWeightsData[z];
-            }, NPar::TLocalExecutor::TExecRangeParams(begin, bt.TailFinish).SetBlockSize(4000)
-             , NPar::TLocalExecutor::WAIT_COMPLETE);
+            sumDerAbs += Abs(bt.WeightedDerivatives[dim][z]);
         }
+        derAbsData[z] = sumDerAbs;
+    }, NPar::TLocalExecutor::TExecRangeParams(0, learnSampleCount).SetBlockSize(4000)
+     , NPar::TLocalExecutor::WAIT_COMPLETE);
+
+    const int topCount = static_cast<int>(topFraction * learnSampleCount);
+    float threshold = std::numeric_limits<float>::max();
+    if (topCount > 0) {
+        TVector<float> sortedDerAbs(derAbs);
+        NthElement(sortedDerAbs.begin(), sortedDerAbs.begin() + topCount - 1, sortedDerAbs.end(), [](float left, float right) { return left > right; });
+        threshold = sortedDerAbs[topCount - 1]; // ties at the threshold are all kept
     }
+    const float restKeepProbability = takenFraction / (1.0f - topFraction);
+    const float restWeight = 1.0f / restKeepProbability;
 
-    const auto& learnWeights = ff.GetLearnWeights();
-    if (!learnWeights.empty()) {
-        for (int i = 0; i < learnSampleCount; ++i) {
-            ff.SampleWeights[i] *= learnWeights[i];
+    const ui64 randSeed = rand->GenRand();
+    NPar::TLocalExecutor::TExecRangeParams blockParams(0, learnSampleCount);
+    blockParams.SetBlockSize(1000);
+    localExecutor->ExecRange([&](int blockIdx) {
+        TRestorableFastRng64 rand(randSeed + blockIdx);
+        rand.Advance(10); // reduce correlation between RNGs in different threads
+        const int blockBegin = blockIdx * blockParams.GetBlockSize();
+        const int blockEnd = Min<int>(blockBegin + blockParams.GetBlockSize(), learnSampleCount);
+        float* sampleWeightsData = fold->SampleWeights.data();
+        for (int i = blockBegin; i < blockEnd; ++i) {
+            if (derAbsData[i] >= threshold) {
+                sampleWeightsData[i] = 1.0f;
+            } else if (rand.GenRandReal1() < restKeepProbability) {
+                sampleWeightsData[i] = restWeight;
+            } else {
+                sampleWeightsData[i] = 0.0f;
+            }
         }
-    }
+        CalcWeightedDataInBlock(blockBegin, blockEnd, boostingType, fold);
+    }, 0, blockParams.GetBlockCount(), NPar::TLocalExecutor::WAIT_COMPLETE);
 }
 
 void Bootstrap(
@@ -137,33 +237,52 @@ void Bootstrap(
     const float baggingTemperature = params.ObliviousTreeOptions->BootstrapConfig->GetBaggingTemperature();
     const float takenFraction = params.ObliviousTreeOptions->BootstrapConfig->GetTakenFraction();
     const bool isPairwiseScoring = IsPairwiseScoring(params.LossFunctionDescription->GetLossFunction());
+    const EBoostingType boostingType = params.BoostingOptions->BoostingType;
+    // The non-pairwise generators below also produce the sample-weighted derivative copies
+    // block by block while the weights are in cache; see CalcWeightedDataInBlock.
     switch (bootstrapType) {
         case EBootstrapType::Bernoulli:
             if (isPairwiseScoring) {
-                // TODO(nikitxskv): Need to add groupwise sampling (take the whole group or not)
-                GenerateBernoulliWeightsForPairs(takenFraction, localExecutor, rand, fold);
+                GenerateQuerywiseBernoulliWeights(takenFraction, localExecutor, rand, fold);
             } else {
-                Fill(fold->SampleWeights.begin(), fold->SampleWeights.end(), 1);
+                FillOnesAndCalcWeightedData(learnSampleCount, boostingType, localExecutor, fold);
             }
             break;
         case EBootstrapType::Bayesian:
             if (isPairwiseScoring) {
                 GenerateBayesianWeightsForPairs(baggingTemperature, localExecutor, rand, fold);
             } else {
-                GenerateRandomWeights(learnSampleCount, baggingTemperature, localExecutor, rand, fold);
+                GenerateRandomWeights(learnSampleCount, baggingTemperature, boostingType, localExecutor, rand, fold);
             }
             break;
+        case EBootstrapType::Goss:
+            CB_ENSURE(!isPairwiseScoring, "GOSS bootstrap is not supported for pairwise scoring");
+            CB_ENSURE(IsPlainMode(boostingType), "GOSS bootstrap is supported in Plain boosting mode only");
+            GenerateGossWeights(
+                learnSampleCount,
+                params.ObliviousTreeOptions->BootstrapConfig->GetTopFraction(),
+                takenFraction,
+                boostingType,
+                localExecutor,
+                rand,
+                fold);
+            break;
         case EBootstrapType::No:
             if (!isPairwiseScoring) {
-                Fill(fold->SampleWeights.begin(), fold->SampleWeights.end(), 1);
+                FillOnesAndCalcWeightedData(learnSampleCount, boostingType, localExecutor, fold);
             }
             break;
         default:
             CB_ENSURE(false, "Not supported bootstrap type on CPU: " << bootstrapType);
     }
-    if (!isPairwiseScoring) {
-        CalcWeightedData(learnSampleCount, params.BoostingOptions->BoostingType.Get(), localExecutor, fold);
-    }
+    // Record whether the weights above are all exactly one: no document weights mixed in
+    // (CalcWeightedDataInBlock multiplies them into SampleWeights otherwise) and a generator
+    // that only fills ones. The histogram kernels pick an unweighted flavor off this flag.
+    fold->SampleWeightsAreTrivial = !isPairwiseScoring
+        && fold->GetLearnWeights().empty()
+        && (bootstrapType == EBootstrapType::No
+            || bootstrapType == EBootstrapType::Bernoulli
+            || (bootstrapType == EBootstrapType::Bayesian && baggingTemperature == 0.0f));
     sampledDocs->Sample(*fold, indices, rand, localExecutor);
 }
 
@@ -175,13 +294,16 @@ void SetBestScore(
 ) {
     TRestorableFastRng64 rand(randSeed);
     rand.Advance(10); // reduce correlation between RNGs in different threads
+    TVector<double> scoreNoise;
     for (size_t subcandidateIdx = 0; subcandidateIdx < allScores.size(); ++subcandidateIdx) {
         double bestScoreInstance = MINIMAL_SCORE;
         auto& splitInfo = (*subcandidates)[subcandidateIdx];
         const auto& scores = allScores[subcandidateIdx];
+        scoreNoise.yresize(scores.size());
+        FillNormalNoise(scoreStDev, rand, &scoreNoise);
         for (int binFeatureIdx = 0; binFeatureIdx < scores.ysize(); ++binFeatureIdx) {
             const double score = scores[binFeatureIdx];
-            const double scoreInstance = TRandomScore(score, scoreStDev).GetInstance(rand);
+            const double scoreInstance = score + scoreNoise[binFeatureIdx];
             if (scoreInstance > bestScoreInstance) {
                 bestScoreInstance = scoreInstance;
                 splitInfo.BestScore = TRandomScore(score, scoreStDev);
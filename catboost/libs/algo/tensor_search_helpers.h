@@ -2,9 +2,11 @@
 
 #include "split.h"
 #include "rand_score.h"
+#include "candidate_list.h"
 #include "fold.h"
 #include "calc_score_cache.h"
 #include "error_functions.h"
+#include "pairlogit_helpers.h"
 #include "yetirank_helpers.h"
 #include "approx_calcer.h"
 
@@ -33,30 +35,6 @@ inline double CalcScoreStDevMult(int learnSampleCount, double modelLength) {
     return modelLeft / (1 + modelLeft);
 }
 
-struct TCandidateInfo {
-    TSplitCandidate SplitCandidate;
-    TRandomScore BestScore;
-    int BestBinBorderId = -1;
-    bool ShouldDropAfterScoreCalc = false;
-    SAVELOAD(SplitCandidate, BestScore, BestBinBorderId, ShouldDropAfterScoreCalc);
-};
-
-struct TCandidatesInfoList {
-    TCandidatesInfoList() = default;
-    explicit TCandidatesInfoList(const TCandidateInfo& oneCandidate) {
-        Candidates.emplace_back(oneCandidate);
-    }
-    // All candidates here are either float or one-hot, or have the same
-    // projection.
-    // TODO(annaveronika): put projection out, because currently it's not clear.
-    TVector<TCandidateInfo> Candidates;
-    bool ShouldDropCtrAfterCalc = false;
-
-    SAVELOAD(Candidates, ShouldDropCtrAfterCalc);
-};
-
-using TCandidateList = TVector<TCandidatesInfoList>;
-
 void Bootstrap(const NCatboostOptions::TCatBoostOptions& params,
                const TVector<TIndexType>& indices,
                TFold* fold,
@@ -99,10 +77,14 @@ inline void CalcWeightedDerivatives(
     if (error.GetErrorType() == EErrorType::QuerywiseError || error.GetErrorType() == EErrorType::PairwiseError) {
         TVector<TQueryInfo> recalculatedQueriesInfo;
         const bool shouldGenerateYetiRankPairs = ShouldGenerateYetiRankPairs(params.LossFunctionDescription->GetLossFunction());
+        const bool shouldResamplePairs = ShouldResamplePairLogitPairs(params.LossFunctionDescription);
         if (shouldGenerateYetiRankPairs) {
             YetiRankRecalculation(*takenFold, bt, params, randomSeed, localExecutor, &recalculatedQueriesInfo, &bt.PairwiseWeights);
+        } else if (shouldResamplePairs) {
+            PairLogitPairsRecalculation(*takenFold, bt, params, randomSeed, localExecutor, &recalculatedQueriesInfo, &bt.PairwiseWeights);
         }
-        const TVector<TQueryInfo>& queriesInfo = shouldGenerateYetiRankPairs ? recalculatedQueriesInfo : takenFold->LearnQueriesInfo;
+        const bool useRecalculatedQueriesInfo = shouldGenerateYetiRankPairs || shouldResamplePairs;
+        const TVector<TQueryInfo>& queriesInfo = useRecalculatedQueriesInfo ? recalculatedQueriesInfo : takenFold->LearnQueriesInfo;
 
         const int tailQueryFinish = bt.TailQueryFinish;
         TVector<TDers> ders((*weightedDerivatives)[0].ysize());
@@ -110,8 +92,10 @@ inline void CalcWeightedDerivatives(
         for (int docId = 0; docId < ders.ysize(); ++docId) {
             (*weightedDerivatives)[0][docId] = ders[docId].Der1;
         }
-        if (params.LossFunctionDescription->GetLossFunction() == ELossFunction::YetiRankPairwise) {
-            // In case of YetiRankPairwise loss function we need to store generated pairs for tree structure building.
+        const ELossFunction lossFunction = params.LossFunctionDescription->GetLossFunction();
+        if (lossFunction == ELossFunction::YetiRankPairwise ||
+            (lossFunction == ELossFunction::PairLogitPairwise && shouldResamplePairs)) {
+            // In case of pairwise loss functions with regenerated pairs we need to store them for tree structure building.
             Y_ASSERT(takenFold->BodyTailArr.size() == 1);
             takenFold->LearnQueriesInfo.swap(recalculatedQueriesInfo);
         }
@@ -134,17 +118,32 @@ inline void CalcWeightedDerivatives(
             }, 0, blockParams.GetBlockCount(), NPar::TLocalExecutor::WAIT_COMPLETE);
         } else {
             localExecutor->ExecRange([&](int blockId) {
-                TVector<double> curApprox(approxDimension);
-                TVector<double> curDelta(approxDimension);
-                NPar::TLocalExecutor::BlockedLoopBody(blockParams, [&](int z) {
+                // Gather and scatter the per-document class vectors through transposed tiles,
+                // so every class array is streamed sequentially instead of keeping
+                // approxDimension strided access streams alive at once.
+                TVector<TVector<double>> blockApprox(MultiApproxBlockSize, TVector<double>(approxDimension));
+                TVector<TVector<double>> blockDelta(MultiApproxBlockSize, TVector<double>(approxDimension));
+                const int blockOffset = blockId * blockParams.GetBlockSize();
+                const int blockFinish = Min(blockOffset + blockParams.GetBlockSize(), tailFinish);
+                for (int tileStart = blockOffset; tileStart < blockFinish; tileStart += MultiApproxBlockSize) {
+                    const int tileEnd = Min(tileStart + MultiApproxBlockSize, blockFinish);
                     for (int dim = 0; dim < approxDimension; ++dim) {
-                        curApprox[dim] = approx[dim][z];
+                        const double* const approxData = approx[dim].data();
+                        for (int z = tileStart; z < tileEnd; ++z) {
+                            blockApprox[z - tileStart][dim] = approxData[z];
+                        }
+                    }
+                    for (int z = tileStart; z < tileEnd; ++z) {
+                        error.CalcDersMulti(blockApprox[z - tileStart], target[z], weight.empty() ? 1 : weight[z],
+                                            &blockDelta[z - tileStart], nullptr);
                     }
-                    error.CalcDersMulti(curApprox, target[z], weight.empty() ? 1 : weight[z], &curDelta, nullptr);
                     for (int dim = 0; dim < approxDimension; ++dim) {
-                        (*weightedDerivatives)[dim][z] = curDelta[dim];
+                        double* const derData = (*weightedDerivatives)[dim].data();
+                        for (int z = tileStart; z < tileEnd; ++z) {
+                            derData[z] = blockDelta[z - tileStart][dim];
+                        }
                     }
-                })(blockId);
+                }
             }, 0, blockParams.GetBlockCount(), NPar::TLocalExecutor::WAIT_COMPLETE);
         }
     }
@@ -11,6 +11,8 @@
 #include <catboost/libs/helpers/interrupt.h>
 #include <catboost/libs/logging/profile_info.h>
 
+#include <util/string/builder.h>
+
 struct TCompetitor;
 
 static void NormalizeLeafValues(const TVector<TIndexType>& indices, int learnSampleCount, TVector<TVector<double>>* treeValues) {
@@ -35,10 +37,33 @@ static void NormalizeLeafValues(const TVector<TIndexType>& indices, int learnSam
     }
 }
 
+/*
+ * Round the tree's leaf values to a signed 8-bit grid with a per-tree scale. The rounded
+ * values are the ones applied to every approx, so later iterations see the rounding error
+ * in the residuals and absorb it; the finished model's leaves already lie on the int8
+ * grid and can be stored quantized without post-training loss.
+ */
+static void QuantizeTreeLeafValues(TVector<TVector<double>>* treeValues) {
+    double maxAbsLeafValue = 0;
+    for (const auto& dimValues : *treeValues) {
+        for (double leafValue : dimValues) {
+            maxAbsLeafValue = Max(maxAbsLeafValue, Abs(leafValue));
+        }
+    }
+    if (maxAbsLeafValue == 0) {
+        return;
+    }
+    const double scale = maxAbsLeafValue / 127;
+    for (auto& dimValues : *treeValues) {
+        for (double& leafValue : dimValues) {
+            leafValue = round(leafValue / scale) * scale;
+        }
+    }
+}
+
 template <typename TError>
 void UpdateLearningFold(
     const TDataset& learnData,
-    const TDatasetPtrs& testDataPtrs,
     const TError& error,
     const TSplitTree& bestSplitTree,
     ui64 randomSeed,
@@ -47,9 +72,12 @@ void UpdateLearningFold(
 ) {
     TVector<TVector<TVector<double>>> approxDelta;
 
+    /* Test indices are never consumed when updating a learning fold (the approx deltas are
+     * only read up to TailFinish, which lies inside the learn part), and learning folds do
+     * not materialize CTR values over the test documents anymore, so do not build them. */
     CalcApproxForLeafStruct(
         learnData,
-        testDataPtrs,
+        TDatasetPtrs(),
         error,
         *fold,
         bestSplitTree,
@@ -86,7 +114,8 @@ void UpdateAveragingFold(
     auto& currentTreeStats = ctx->LearnProgress.TreeStats.emplace_back();
     currentTreeStats.LeafWeightsSum.resize((*treeValues)[0].size());
     for (size_t docId = 0; docId < learnData.GetSampleCount(); ++docId) {
-        currentTreeStats.LeafWeightsSum[indices[ctx->LearnProgress.AveragingFold.LearnPermutation[docId]]] += learnData.Weights[docId];
+        const float docWeight = learnData.Weights.empty() ? 1.0f : learnData.Weights[docId];
+        currentTreeStats.LeafWeightsSum[indices[ctx->LearnProgress.AveragingFold.LearnPermutation[docId]]] += docWeight;
     }
     // TODO(nikitxskv): if this will be a bottleneck, we can use precalculated counts.
     if (IsPairwiseError(ctx->Params.LossFunctionDescription->GetLossFunction())) {
@@ -96,12 +125,18 @@ void UpdateAveragingFold(
     const int approxDimension = ctx->LearnProgress.AvrgApprox.ysize();
     const double learningRate = ctx->Params.BoostingOptions->LearningRate;
 
-    TVector<TVector<double>> expTreeValues;
-    expTreeValues.yresize(approxDimension);
     for (int dim = 0; dim < approxDimension; ++dim) {
         for (auto& leafVal : (*treeValues)[dim]) {
             leafVal *= learningRate;
         }
+    }
+    if (ctx->Params.BoostingOptions->QuantizeLeafValues) {
+        QuantizeTreeLeafValues(treeValues);
+    }
+
+    TVector<TVector<double>> expTreeValues;
+    expTreeValues.yresize(approxDimension);
+    for (int dim = 0; dim < approxDimension; ++dim) {
         expTreeValues[dim] = (*treeValues)[dim];
         ExpApproxIf(TError::StoreExpApprox, &expTreeValues[dim]);
     }
@@ -172,6 +207,13 @@ void TrainOneIter(const TDataset& learnData, const TDatasetPtrs& testDataPtrs, T
     TSplitTree bestSplitTree;
     {
         TFold* takenFold = &ctx->LearnProgress.Folds[ctx->Rand.GenRand() % foldCount];
+        TVector<TFold*> lookaheadFolds;
+        for (int foldId = 0; foldId < foldCount; ++foldId) {
+            if (&ctx->LearnProgress.Folds[foldId] != takenFold) {
+                lookaheadFolds.push_back(&ctx->LearnProgress.Folds[foldId]);
+            }
+        }
+        lookaheadFolds.push_back(&ctx->LearnProgress.AveragingFold);
         const TVector<ui64> randomSeeds = GenRandUI64Vector(takenFold->BodyTailArr.ysize(), ctx->Rand.GenRand());
         if (ctx->Params.SystemOptions->IsSingleHost()) {
             ctx->LocalExecutor.ExecRange([&](int bodyTailId) {
@@ -190,6 +232,7 @@ void TrainOneIter(const TDataset& learnData, const TDatasetPtrs& testDataPtrs, T
             modelLength,
             profile,
             takenFold,
+            lookaheadFolds,
             ctx,
             &bestSplitTree
         );
@@ -213,8 +256,9 @@ void TrainOneIter(const TDataset& learnData, const TDatasetPtrs& testDataPtrs, T
                 TProjection Projection;
                 TFold* Fold;
                 TOnlineCTR* Ctr;
+                bool ComputeTestTails;
                 void DoTask(TLearnContext* ctx) {
-                    ComputeOnlineCTRs(*LearnData, TestDatas, *Fold, Projection, ctx, Ctr);
+                    ComputeOnlineCTRs(*LearnData, TestDatas, *Fold, Projection, ctx, Ctr, ComputeTestTails);
                 }
             };
 
@@ -231,7 +275,8 @@ void TrainOneIter(const TDataset& learnData, const TDatasetPtrs& testDataPtrs, T
                 }
                 for (auto* foldPtr : allFolds) {
                     if (!foldPtr->GetCtrs(proj).has(proj) || foldPtr->GetCtr(proj).Feature.empty()) {
-                        parallelJobsData.emplace_back(TLocalJobData{ &learnData, testDataPtrs, proj, foldPtr, &foldPtr->GetCtrRef(proj) });
+                        const bool computeTestTails = foldPtr == &ctx->LearnProgress.AveragingFold;
+                        parallelJobsData.emplace_back(TLocalJobData{ &learnData, testDataPtrs, proj, foldPtr, &foldPtr->GetCtrRef(proj), computeTestTails });
                     }
                 }
                 seenProjections.insert(proj);
@@ -247,9 +292,17 @@ void TrainOneIter(const TDataset& learnData, const TDatasetPtrs& testDataPtrs, T
 
         if (ctx->Params.SystemOptions->IsSingleHost()) {
             const TVector<ui64> randomSeeds = GenRandUI64Vector(foldCount, ctx->Rand.GenRand());
+            TVector<double> foldTimes(foldCount);
             ctx->LocalExecutor.ExecRange([&](int foldId) {
-                UpdateLearningFold(learnData, testDataPtrs, error, bestSplitTree, randomSeeds[foldId], trainFolds[foldId], ctx);
+                THPTimer timer;
+                UpdateLearningFold(learnData, error, bestSplitTree, randomSeeds[foldId], trainFolds[foldId], ctx);
+                foldTimes[foldId] = timer.Passed();
             }, 0, foldCount, NPar::TLocalExecutor::WAIT_COMPLETE);
+            // per-permutation overhead report; the folds run in parallel, so these
+            // times overlap each other and the enclosing phase instead of summing up
+            for (int foldId = 0; foldId < foldCount; ++foldId) {
+                profile.AddMeasuredOperation(TStringBuilder() << "Update estimation fold #" << foldId, foldTimes[foldId]);
+            }
         } else {
             if (ctx->LearnProgress.AveragingFold.GetApproxDimension() == 1) {
                 MapSetApproxesSimple<TError>(bestSplitTree, ctx);
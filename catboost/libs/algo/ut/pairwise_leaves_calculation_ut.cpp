@@ -1,5 +1,8 @@
 #include <library/unittest/registar.h>
 #include <catboost/libs/algo/pairwise_leaves_calculation.h>
+#include <catboost/libs/helpers/matrix.h>
+
+#include <util/random/fast.h>
 
 static TArray2D<double> Convert(const TVector<TVector<double>>& matrix) {
     if (matrix.empty()) {
@@ -45,4 +48,51 @@ Y_UNIT_TEST_SUITE(PairwiseLeafCalculationTest) {
         UNIT_ASSERT_DOUBLES_EQUAL(leafValues[2], 5.448432894, 1e-6);
         UNIT_ASSERT_DOUBLES_EQUAL(leafValues[3], 1.093156891, 1e-6);
     }
+
+    Y_UNIT_TEST(PairwiseLeafCalculationTestSparseSolver) {
+        // Above 256 leaves the conjugate gradient path is taken; check it against the
+        // dense Cholesky solution on a sparse random pair graph.
+        const int leafCount = 300;
+        TReallyFastRng32 rng(20181017);
+        TArray2D<double> pairwiseWeightSums(leafCount, leafCount);
+        pairwiseWeightSums.FillZero();
+        TVector<double> derSums(leafCount);
+        for (int leaf = 0; leaf + 1 < leafCount; ++leaf) {
+            const int neighborCount = 1 + rng.Uniform(3);
+            for (int neighbor = 0; neighbor < neighborCount; ++neighbor) {
+                const int otherLeaf = leaf + 1 + rng.Uniform(leafCount - leaf - 1);
+                const double pairWeight = 1.0 + rng.GenRandReal1();
+                pairwiseWeightSums[leaf][otherLeaf] -= pairWeight;
+                pairwiseWeightSums[otherLeaf][leaf] -= pairWeight;
+                pairwiseWeightSums[leaf][leaf] += pairWeight;
+                pairwiseWeightSums[otherLeaf][otherLeaf] += pairWeight;
+            }
+            derSums[leaf] = rng.GenRandReal1() - 0.5;
+            derSums[leafCount - 1] -= derSums[leaf];
+        }
+        const float l2DiagReg = 0.3;
+        const float pairwiseNonDiagReg = 0.1;
+
+        const TVector<double> leafValues = CalculatePairwiseLeafValues(pairwiseWeightSums, derSums, l2DiagReg, pairwiseNonDiagReg);
+
+        const double cellPrior = 1.0 / leafCount;
+        const double nonDiagReg = -pairwiseNonDiagReg * cellPrior;
+        const double diagReg = pairwiseNonDiagReg * (1 - cellPrior) + l2DiagReg;
+        TVector<double> systemMatrix((leafCount - 1) * (leafCount - 1));
+        for (int y = 0; y < leafCount - 1; ++y) {
+            for (int x = 0; x < y; ++x) {
+                systemMatrix[y * (leafCount - 1) + x] = pairwiseWeightSums[y][x] + nonDiagReg;
+            }
+            systemMatrix[y * (leafCount - 1) + y] = pairwiseWeightSums[y][y] + diagReg;
+        }
+        TVector<double> expectedValues = derSums;
+        expectedValues.pop_back();
+        SolveLinearSystemCholesky(&systemMatrix, &expectedValues);
+        expectedValues.push_back(0.0);
+        MakeZeroAverage(&expectedValues);
+
+        for (int leaf = 0; leaf < leafCount; ++leaf) {
+            UNIT_ASSERT_DOUBLES_EQUAL(leafValues[leaf], expectedValues[leaf], 1e-6);
+        }
+    }
 }
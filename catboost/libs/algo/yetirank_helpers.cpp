@@ -73,28 +73,20 @@ static void UpdatePairsForYetiRank(
     const int permutationCount = NCatboostOptions::GetYetiRankPermutations(params.LossFunctionDescription);
     const double decaySpeed = NCatboostOptions::GetYetiRankDecay(params.LossFunctionDescription);
 
-    NPar::TLocalExecutor::TExecRangeParams blockParams(0, queryInfoSize);
-    blockParams.SetBlockCount(localExecutor->GetThreadCount() + 1);
-    const int blockSize = blockParams.GetBlockSize();
-    const ui32 blockCount = blockParams.GetBlockCount();
-    const TVector<ui64> randomSeeds = GenRandUI64Vector(blockCount, randomSeed);
-    NPar::ParallelFor(*localExecutor, 0, blockCount, [&](int blockId) {
-        TFastRng64 rand(randomSeeds[blockId]);
-        const int from = blockId * blockSize;
-        const int to = Min<int>((blockId + 1) * blockSize, queryInfoSize);
-        for (int queryIndex = from; queryIndex < to; ++queryIndex) {
-            TQueryInfo& queryInfoRef = (*queriesInfo)[queryIndex];
-            GenerateYetiRankPairsForQuery(
-                relevances.data() + queryInfoRef.Begin,
-                approxes.data() + queryInfoRef.Begin,
-                queryInfoRef.Weight,
-                queryInfoRef.End - queryInfoRef.Begin,
-                permutationCount,
-                decaySpeed,
-                rand.GenRand(),
-                &queryInfoRef.Competitors
-            );
-        }
+    // One seed per query: generated pairs must not depend on how queries are blocked over threads.
+    const TVector<ui64> randomSeeds = GenRandUI64Vector(queryInfoSize, randomSeed);
+    NPar::ParallelFor(*localExecutor, 0, queryInfoSize, [&](int queryIndex) {
+        TQueryInfo& queryInfoRef = (*queriesInfo)[queryIndex];
+        GenerateYetiRankPairsForQuery(
+            relevances.data() + queryInfoRef.Begin,
+            approxes.data() + queryInfoRef.Begin,
+            queryInfoRef.Weight,
+            queryInfoRef.End - queryInfoRef.Begin,
+            permutationCount,
+            decaySpeed,
+            randomSeeds[queryIndex],
+            &queryInfoRef.Competitors
+        );
     });
 }
 
@@ -1,8 +1,17 @@
 #include "cat_feature.h"
 
 #include <util/digest/city.h>
+#include <util/generic/array_ref.h>
 #include <util/generic/strbuf.h>
+#include <util/system/yassert.h>
 
 int CalcCatFeatureHash(const TStringBuf feature) noexcept {
     return CityHash64(feature) & 0xffffffff;
 }
+
+void CalcCatFeatureHashes(const TConstArrayRef<TStringBuf> features, TArrayRef<int> hashes) noexcept {
+    Y_ASSERT(features.size() == hashes.size());
+    for (size_t i = 0; i < features.size(); ++i) {
+        hashes[i] = CityHash64(features[i].data(), features[i].size()) & 0xffffffff;
+    }
+}
@@ -4,6 +4,12 @@
 
 int CalcCatFeatureHash(TStringBuf feature) noexcept;
 
+/* Hash a batch of categorical values in one pass. Equivalent to calling
+ * CalcCatFeatureHash per element but keeps the hash loop hot, which matters
+ * when ingesting whole columns of short strings.
+ */
+void CalcCatFeatureHashes(TConstArrayRef<TStringBuf> features, TArrayRef<int> hashes) noexcept;
+
 inline float ConvertCatFeatureHashToFloat(int hashVal) {
     return *reinterpret_cast<const float*>(&hashVal);
 }
@@ -0,0 +1,42 @@
+#include <catboost/libs/data/float_parsing.h>
+
+#include <library/testing/benchmark/bench.h>
+
+#include <util/generic/vector.h>
+#include <util/generic/xrange.h>
+#include <util/random/fast.h>
+#include <util/string/cast.h>
+
+static TVector<TString> MakeFactorTokens() {
+    TReallyFastRng32 rng(20181);
+    TVector<TString> tokens;
+    tokens.reserve(10000);
+    for (size_t i = 0; i < 10000; ++i) {
+        tokens.push_back(ToString(rng.GenRandReal2()));
+    }
+    return tokens;
+}
+
+Y_CPU_BENCHMARK(ParseFloatFast, iface) {
+    const TVector<TString> tokens = MakeFactorTokens();
+    float value = 0;
+    for (const auto i : xrange(iface.Iterations())) {
+        Y_UNUSED(i);
+        for (const auto& token : tokens) {
+            NCB::TryParseFloatFast(token, &value);
+            Y_DO_NOT_OPTIMIZE_AWAY(value);
+        }
+    }
+}
+
+Y_CPU_BENCHMARK(ParseFloatFromString, iface) {
+    const TVector<TString> tokens = MakeFactorTokens();
+    float value = 0;
+    for (const auto i : xrange(iface.Iterations())) {
+        Y_UNUSED(i);
+        for (const auto& token : tokens) {
+            TryFromString<float>(token, value);
+            Y_DO_NOT_OPTIMIZE_AWAY(value);
+        }
+    }
+}
@@ -3,7 +3,14 @@
 TDataset BuildDataset(const TPool& pool) {
     TDataset data;
     data.Target = pool.Docs.Target;
-    data.Weights = pool.Docs.Weight;
+    /* Trivial weights are stored as an empty vector: the derivative and metric
+     * loops take their no-weight fast paths and the constant column is not
+     * copied at all. Group weights are kept materialized because query info
+     * construction reads them per document.
+     */
+    if (!pool.Docs.IsTrivialWeights() || pool.MetaInfo.HasGroupWeight) {
+        data.Weights = pool.Docs.Weight;
+    }
     data.QueryId = pool.Docs.QueryId;
     data.SubgroupId = pool.Docs.SubgroupId;
     data.Baseline = pool.Docs.Baseline;
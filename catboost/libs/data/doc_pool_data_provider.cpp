@@ -1,6 +1,7 @@
 
 #include "doc_pool_data_provider.h"
 
+#include "float_parsing.h"
 #include "load_data.h"
 #include "load_helpers.h"
 
@@ -143,6 +144,7 @@ namespace NCB {
                                           int docCount, int offset,
                                           IPoolBuilder* poolBuilder)
     {
+        poolBuilder->SetIgnoredFeatures(FeatureIgnored);
         poolBuilder->Start(PoolMetaInfo, docCount, CatFeatures);
         if (!FeatureIds.empty()) {
             poolBuilder->SetFeatureIds(FeatureIds);
@@ -163,18 +165,21 @@ namespace NCB {
             ui32 baselineIdx = 0;
             TVector<float> features;
             features.yresize(PoolMetaInfo.FeatureCount);
+            // categorical cells are collected during the split pass and hashed
+            // in one batch below; tokens are views into `line`, alive till then
+            TVector<TStringBuf> catTokens;
+            TVector<ui32> catFeatureIdxs;
 
             int tokenCount = 0;
-            TVector<TStringBuf> tokens = StringSplitter(line).Split(FieldDelimiter).ToList<TStringBuf>();
-            for (const auto& token : tokens) {
+            // iterate the splitter directly - materializing a token vector per line costs an
+            // allocation on the hot parsing path
+            for (const auto& part : StringSplitter(line).Split(FieldDelimiter)) {
+                const TStringBuf token = part.Token();
                 switch (columnsDescription[tokenCount].Type) {
                     case EColumn::Categ: {
                         if (!FeatureIgnored[featureId]) {
-                            if (IsNanValue(token)) {
-                                features[featureId] = poolBuilder->GetCatFeatureValue("nan");
-                            } else {
-                                features[featureId] = poolBuilder->GetCatFeatureValue(token);
-                            }
+                            catTokens.push_back(IsNanValue(token) ? TStringBuf("nan") : token);
+                            catFeatureIdxs.push_back(featureId);
                         }
                         ++featureId;
                         break;
@@ -182,7 +187,9 @@ namespace NCB {
                     case EColumn::Num: {
                         if (!FeatureIgnored[featureId]) {
                             float val;
-                            if (!TryFromString<float>(token, val)) {
+                            // plain decimal values (the common case) take the fast path,
+                            // exponent/inf/nan notation goes through the general parser
+                            if (!TryParseFloatFast(token, &val) && !TryFromString<float>(token, val)) {
                                 if (IsNanValue(token)) {
                                     val = std::numeric_limits<float>::quiet_NaN();
                                 } else if (token.length() == 0) {
@@ -249,6 +256,14 @@ namespace NCB {
                 }
                 ++tokenCount;
             }
+            if (!catFeatureIdxs.empty()) {
+                TVector<float> catValues;
+                catValues.yresize(catTokens.size());
+                poolBuilder->GetCatFeatureValues(catTokens, catValues);
+                for (size_t i = 0; i < catFeatureIdxs.size(); ++i) {
+                    features[catFeatureIdxs[i]] = catValues[i];
+                }
+            }
             poolBuilder->AddAllFloatFeatures(lineIdx, features);
             CB_ENSURE(tokenCount == columnsDescription.ysize(), "wrong columns number in pool line " <<
                       AsyncRowProcessor.GetLinesProcessed() + lineIdx + 1 << ": expected " << columnsDescription.ysize() << ", found " << tokenCount);
@@ -257,10 +272,126 @@ namespace NCB {
         AsyncRowProcessor.ProcessBlock(parseBlock);
     }
 
+    TCBLibSvmDataProvider::TCBLibSvmDataProvider(TDocPoolDataProviderArgs&& args)
+        : TAsyncProcDataProviderBase<TString>(std::move(args))
+        , ConvertTarget(Args.ClassNames)
+        , LineDataReader(GetLineDataReader(Args.PoolPath))
+    {
+        CB_ENSURE(!Args.PairsFilePath.Inited() || CheckExists(Args.PairsFilePath),
+                  "TCBLibSvmDataProvider:PairsFilePath does not exist");
+
+        // libsvm has no header, so the feature count is only known after a full pass:
+        // scan feature indices with a separate reader and leave LineDataReader untouched
+        ui32 featureCount = 0;
+        {
+            THolder<ILineDataReader> scanReader = GetLineDataReader(Args.PoolPath);
+            TString line;
+            ui64 lineCount = 0;
+            while (scanReader->ReadLine(&line)) {
+                ++lineCount;
+                bool isLabel = true;
+                for (const auto& part : StringSplitter(line).SplitBySet(" \t").SkipEmpty()) {
+                    const TStringBuf token = part.Token();
+                    if (isLabel) {
+                        isLabel = false;
+                        continue;
+                    }
+                    TStringBuf indexToken;
+                    TStringBuf valueToken;
+                    CB_ENSURE(token.TrySplit(':', indexToken, valueToken),
+                              "libsvm feature token '" << token << "' in line " << lineCount
+                              << " is not <index>:<value>");
+                    if (indexToken == "qid") {
+                        HasQueryIds = true;
+                        continue;
+                    }
+                    ui32 index = 0;
+                    CB_ENSURE(TryFromString<ui32>(indexToken, index) && index > 0,
+                              "libsvm feature index '" << indexToken << "' in line " << lineCount
+                              << " is not a positive integer");
+                    featureCount = Max(featureCount, index);
+                }
+            }
+            CB_ENSURE(lineCount > 0, "TCBLibSvmDataProvider: no data rows in pool");
+            CB_ENSURE(featureCount > 0, "TCBLibSvmDataProvider: no features in pool");
+        }
+
+        TVector<TColumn> columnsDescription;
+        columnsDescription.push_back(TColumn{EColumn::Label, TString()});
+        if (HasQueryIds) {
+            columnsDescription.push_back(TColumn{EColumn::GroupId, TString()});
+        }
+        columnsDescription.resize(columnsDescription.size() + featureCount,
+                                  TColumn{EColumn::Num, TString()});
+        PoolMetaInfo = TPoolMetaInfo(std::move(columnsDescription));
+
+        int ignoredFeatureCount = 0;
+        FeatureIgnored.resize(featureCount, false);
+        for (int featureId : Args.IgnoredFeatures) {
+            CB_ENSURE(0 <= featureId && featureId < (int)featureCount,
+                      "Invalid ignored feature id: " << featureId);
+            ignoredFeatureCount += FeatureIgnored[featureId] == false;
+            FeatureIgnored[featureId] = true;
+        }
+        CB_ENSURE((int)featureCount - ignoredFeatureCount > 0, "All features are requested to be ignored");
+
+        AsyncRowProcessor.ReadBlockAsync(GetReadFunc());
+    }
+
+    void TCBLibSvmDataProvider::StartBuilder(bool /*inBlock*/,
+                                             int docCount, int offset,
+                                             IPoolBuilder* poolBuilder)
+    {
+        poolBuilder->SetIgnoredFeatures(FeatureIgnored);
+        poolBuilder->Start(PoolMetaInfo, docCount, TVector<int>());
+        poolBuilder->GenerateDocIds(offset);
+    }
+
+    void TCBLibSvmDataProvider::ProcessBlock(IPoolBuilder* poolBuilder) {
+        poolBuilder->StartNextBlock(AsyncRowProcessor.GetParseBufferSize());
+
+        auto parseBlock = [&](TString& line, int lineIdx) {
+            // absent features are implicit zeroes in libsvm
+            TVector<float> features(PoolMetaInfo.FeatureCount, 0.0f);
+
+            bool isLabel = true;
+            for (const auto& part : StringSplitter(line).SplitBySet(" \t").SkipEmpty()) {
+                const TStringBuf token = part.Token();
+                if (isLabel) {
+                    isLabel = false;
+                    poolBuilder->AddTarget(lineIdx, ConvertTarget(FromString<TString>(token)));
+                    continue;
+                }
+                TStringBuf indexToken;
+                TStringBuf valueToken;
+                token.TrySplit(':', indexToken, valueToken);
+                if (indexToken == "qid") {
+                    poolBuilder->AddQueryId(lineIdx, CalcGroupIdFor(valueToken));
+                    continue;
+                }
+                const ui32 featureId = FromString<ui32>(indexToken) - 1;
+                if (FeatureIgnored[featureId]) {
+                    continue;
+                }
+                float val;
+                if (!TryParseFloatFast(valueToken, &val) && !TryFromString<float>(valueToken, val)) {
+                    CB_ENSURE(false, "Feature " << featureId << " has value '" << valueToken
+                              << "' in row " << AsyncRowProcessor.GetLinesProcessed() + lineIdx + 1
+                              << " that cannot be parsed as float");
+                }
+                features[featureId] = val == 0.0f ? 0.0f : val; // remove negative zeros
+            }
+            poolBuilder->AddAllFloatFeatures(lineIdx, features);
+        };
+
+        AsyncRowProcessor.ProcessBlock(parseBlock);
+    }
+
     namespace {
 
     TDocDataProviderObjectFactory::TRegistrator<TCBDsvDataProvider> DefDataProviderReg("");
     TDocDataProviderObjectFactory::TRegistrator<TCBDsvDataProvider> CBDsvDataProviderReg("dsv");
+    TDocDataProviderObjectFactory::TRegistrator<TCBLibSvmDataProvider> LibSvmDataProviderReg("libsvm");
 
     }
 }
@@ -202,5 +202,55 @@ namespace NCB {
     };
 
 
+    /*
+     * Reader for pools in libsvm format: "<label> [qid:<id>] <index>:<value> ...".
+     * Feature indices are 1-based and sparse - absent features are zeroes, so
+     * text-derived pools with mostly-zero factors don't have to be materialized
+     * as dsv. Registered under the "libsvm" scheme.
+     */
+    class TCBLibSvmDataProvider : public IDocPoolDataProvider
+                                , protected TAsyncProcDataProviderBase<TString>
+    {
+    public:
+        using TBase = TAsyncProcDataProviderBase<TString>;
+
+    protected:
+        decltype(auto) GetReadFunc() {
+            return [this](TString* line) -> bool {
+                return LineDataReader->ReadLine(line);
+            };
+        }
+
+    public:
+        explicit TCBLibSvmDataProvider(TDocPoolDataProviderArgs&& args);
+
+        ~TCBLibSvmDataProvider() {
+            AsyncRowProcessor.FinishAsyncProcessing();
+        }
+
+        void Do(IPoolBuilder* poolBuilder) override {
+            TBase::Do(GetReadFunc(), poolBuilder);
+        }
+
+        bool DoBlock(IPoolBuilder* poolBuilder) override {
+            return TBase::DoBlock(GetReadFunc(), poolBuilder);
+        }
+
+        int GetDocCount() override {
+            return (int)LineDataReader->GetDataLineCount();
+        }
+
+        void StartBuilder(bool inBlock, int docCount, int offset, IPoolBuilder* poolBuilder) override;
+
+        void ProcessBlock(IPoolBuilder* poolBuilder) override;
+
+    protected:
+        TVector<bool> FeatureIgnored; // init in process
+        TTargetConverter ConvertTarget;
+        THolder<NCB::ILineDataReader> LineDataReader;
+        bool HasQueryIds = false;
+    };
+
+
     bool IsNanValue(const TStringBuf& s);
 }
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <util/generic/strbuf.h>
+#include <util/system/types.h>
+
+namespace NCB {
+
+    /*
+     * Fast path for parsing factor values in plain decimal notation ([+-]digits[.digits]),
+     * which is what almost every value in a dsv pool looks like. Returns false without touching
+     * *value for everything else (exponents, inf/nan strings, stray characters, more digits than
+     * the integer accumulator holds) — callers must fall back to the general parser then.
+     */
+    inline bool TryParseFloatFast(TStringBuf token, float* value) {
+        static const double powersOfTen[] = {
+            1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9,
+            1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18
+        };
+
+        const char* p = token.data();
+        const char* const end = p + token.size();
+        if (p == end) {
+            return false;
+        }
+        bool negative = false;
+        if (*p == '-' || *p == '+') {
+            negative = *p == '-';
+            ++p;
+        }
+
+        ui64 mantissa = 0;
+        int digitCount = 0;
+        int fracDigitCount = -1; // no dot seen yet
+        for (; p != end; ++p) {
+            const char c = *p;
+            if (c >= '0' && c <= '9') {
+                mantissa = mantissa * 10 + (c - '0');
+                ++digitCount;
+                if (fracDigitCount >= 0) {
+                    ++fracDigitCount;
+                }
+            } else if (c == '.' && fracDigitCount < 0) {
+                fracDigitCount = 0;
+            } else {
+                return false;
+            }
+        }
+        if (digitCount == 0 || digitCount > 18) { // 19+ digits may overflow the ui64 accumulator
+            return false;
+        }
+
+        double result = static_cast<double>(mantissa);
+        if (fracDigitCount > 0) {
+            result /= powersOfTen[fracDigitCount];
+        }
+        *value = static_cast<float>(negative ? -result : result);
+        return true;
+    }
+}
@@ -1,12 +1,15 @@
 #include "load_data.h"
 #include "doc_pool_data_provider.h"
+#include "pool_cache.h"
 
 #include <catboost/libs/column_description/column.h>
 #include <catboost/libs/helpers/exception.h>
 #include <catboost/libs/options/restrictions.h>
+#include <catboost/libs/pool_builder/cat_feature_dictionary.h>
 
 #include <library/threading/local_executor/local_executor.h>
 
+#include <util/generic/maybe.h>
 #include <util/generic/string.h>
 #include <util/generic/vector.h>
 
@@ -22,6 +25,14 @@ namespace NCB {
         {
         }
 
+        void SetIgnoredFeatures(const TVector<bool>& ignoredFeatures) override {
+            FeatureIgnored = ignoredFeatures;
+        }
+
+        void SetPoolQuantizationSchema(const TPoolQuantizationSchema& schema) override {
+            QuantizationSchema = schema;
+        }
+
         void Start(const TPoolMetaInfo& poolMetaInfo,
                    int docCount,
                    const TVector<int>& catFeatureIds) override {
@@ -29,11 +40,47 @@ namespace NCB {
             NextCursor = 0;
             FeatureCount = poolMetaInfo.FeatureCount;
             BaselineCount = poolMetaInfo.BaselineCount;
+            CB_ENSURE(FeatureIgnored.empty() || FeatureIgnored.size() == FeatureCount,
+                      "Error: ignored feature mask size should be equal to factor count");
+            StoredFeatureIds.clear();
+            for (ui32 featureId = 0; featureId < FeatureCount; ++featureId) {
+                if (FeatureIgnored.empty() || !FeatureIgnored[featureId]) {
+                    StoredFeatureIds.push_back(featureId);
+                }
+            }
+            // ignored factor columns are never allocated - a pool with a wide
+            // cd file but few used features only costs memory for the used part
+            const TVector<bool>* factorColumnsToSkip = FeatureIgnored.empty() ? nullptr : &FeatureIgnored;
+            TVector<bool> allFactorColumns;
+            if (QuantizationSchema.Defined()) {
+                // pre-quantized pools store bins instead, raw factor columns are never materialized
+                allFactorColumns.assign(FeatureCount, true);
+                factorColumnsToSkip = &allFactorColumns;
+            }
             Pool->Docs.Resize(docCount,
                               FeatureCount,
                               BaselineCount,
                               poolMetaInfo.HasGroupId,
-                              poolMetaInfo.HasSubgroupIds);
+                              poolMetaInfo.HasSubgroupIds,
+                              factorColumnsToSkip);
+            if (QuantizationSchema.Defined()) {
+                Pool->QuantizedFeatures.resize(FeatureCount);
+                Pool->QuantizationBorders.resize(FeatureCount);
+                Pool->QuantizationNanModes.assign(FeatureCount, ENanMode::Forbidden);
+                for (size_t i = 0; i < QuantizationSchema->FeatureIndices.size(); ++i) {
+                    const size_t featureId = QuantizationSchema->FeatureIndices[i];
+                    CB_ENSURE(featureId < FeatureCount,
+                              "Error: quantization schema feature " << featureId << " is out of range");
+                    if (!FeatureIgnored.empty() && FeatureIgnored[featureId]) {
+                        continue;
+                    }
+                    Pool->QuantizationBorders[featureId] = QuantizationSchema->Borders[i];
+                    Pool->QuantizationNanModes[featureId] = QuantizationSchema->NanModes[i];
+                    if (!Pool->QuantizationBorders[featureId].empty()) {
+                        Pool->QuantizedFeatures[featureId].resize(docCount);
+                    }
+                }
+            }
             Pool->CatFeatures = catFeatureIds;
             Pool->FeatureId.assign(FeatureCount, TString());
             Pool->MetaInfo = poolMetaInfo;
@@ -45,14 +92,15 @@ namespace NCB {
         }
 
         float GetCatFeatureValue(const TStringBuf& feature) override {
-            int hashVal = CalcCatFeatureHash(feature);
             int hashPartIdx = LocalExecutor.GetWorkerThreadId();
             CB_ENSURE(hashPartIdx < CB_THREAD_LIMIT, "Internal error: thread ID exceeds CB_THREAD_LIMIT");
-            auto& curPart = HashMapParts[hashPartIdx];
-            if (!curPart.CatFeatureHashes.has(hashVal)) {
-                curPart.CatFeatureHashes[hashVal] = feature;
-            }
-            return ConvertCatFeatureHashToFloat(hashVal);
+            return HashMapParts[hashPartIdx].Dictionary.GetOrAddValue(feature);
+        }
+
+        void GetCatFeatureValues(TConstArrayRef<TStringBuf> features, TArrayRef<float> values) override {
+            int hashPartIdx = LocalExecutor.GetWorkerThreadId();
+            CB_ENSURE(hashPartIdx < CB_THREAD_LIMIT, "Internal error: thread ID exceeds CB_THREAD_LIMIT");
+            HashMapParts[hashPartIdx].Dictionary.GetOrAddValues(features, values);
         }
 
         void AddCatFeature(ui32 localIdx, ui32 featureId, const TStringBuf& feature) override {
@@ -64,16 +112,27 @@ namespace NCB {
         }
 
         void AddBinarizedFloatFeature(ui32 localIdx, ui32 featureId, ui8 binarizedFeature) override {
-            Y_UNUSED(localIdx);
-            Y_UNUSED(featureId);
-            Y_UNUSED(binarizedFeature);
-            CB_ENSURE(false, "Not supported for regular pools");
+            CB_ENSURE(QuantizationSchema.Defined(), "Not supported for regular pools");
+            TVector<ui8>& bins = Pool->QuantizedFeatures[featureId];
+            if (bins.empty()) { // ignored or borderless features keep no bins
+                return;
+            }
+            bins[Cursor + localIdx] = binarizedFeature;
+        }
+
+        void AddBinarizedFloatFeatureBlock(ui32 localIdx, ui32 featureId, TConstArrayRef<ui8> binarizedFeatures) override {
+            CB_ENSURE(QuantizationSchema.Defined(), "Not supported for regular pools");
+            TVector<ui8>& bins = Pool->QuantizedFeatures[featureId];
+            if (bins.empty()) { // ignored or borderless features keep no bins
+                return;
+            }
+            memcpy(bins.data() + Cursor + localIdx, binarizedFeatures.data(), binarizedFeatures.size());
         }
 
         void AddAllFloatFeatures(ui32 localIdx, TConstArrayRef<float> features) override {
             CB_ENSURE(features.size() == FeatureCount, "Error: number of features should be equal to factor count");
             TVector<float>* factors = Pool->Docs.Factors.data();
-            for (ui32 featureId = 0; featureId < FeatureCount; ++featureId) {
+            for (ui32 featureId : StoredFeatureIds) {
                 factors[featureId][Cursor + localIdx] = features[featureId];
             }
         }
@@ -132,7 +191,8 @@ namespace NCB {
         void Finish() override {
             if (Pool->Docs.GetDocCount() != 0) {
                 for (const auto& part : HashMapParts) {
-                    Pool->CatFeaturesHashToString.insert(part.CatFeatureHashes.begin(), part.CatFeatureHashes.end());
+                    const auto& hashToString = part.Dictionary.GetHashToString();
+                    Pool->CatFeaturesHashToString.insert(hashToString.begin(), hashToString.end());
                 }
                 MATRIXNET_INFO_LOG << "Doc info sizes: " << Pool->Docs.GetDocCount() << " " << FeatureCount << Endl;
             } else {
@@ -142,7 +202,7 @@ namespace NCB {
 
     private:
         struct THashPart {
-            THashMap<int, TString> CatFeatureHashes;
+            TCatFeatureDictionary Dictionary; // interns distinct values seen by this worker
         };
         TPool* Pool;
         static constexpr const int NotSet = -1;
@@ -150,6 +210,9 @@ namespace NCB {
         ui32 NextCursor = 0;
         ui32 FeatureCount = 0;
         ui32 BaselineCount = 0;
+        TVector<bool> FeatureIgnored;
+        TVector<ui32> StoredFeatureIds; // feature ids with materialized factor columns
+        TMaybe<TPoolQuantizationSchema> QuantizationSchema; // defined iff the pool arrives pre-quantized
         std::array<THashPart, CB_THREAD_LIMIT> HashMapParts;
         const NPar::TLocalExecutor& LocalExecutor;
     };
@@ -170,6 +233,18 @@ namespace NCB {
         const TVector<TString>& classNames,
         TPool* pool
     ) {
+        /* the snapshot stores the pool as parsed with default settings, so it cannot be
+         * used when load options change its content
+         */
+        const bool useBinaryCache = IsBinaryPoolCacheEnabled()
+            && (poolPath.Scheme == "" || poolPath.Scheme == "dsv")
+            && ignoredFeatures.empty()
+            && classNames.empty();
+        const TString cachePath = useBinaryCache ? GetBinaryPoolCachePath(poolPath.Path) : TString();
+        if (useBinaryCache && TryLoadPoolFromBinaryCache(cachePath, poolPath.Path, pool)) {
+            return;
+        }
+
         NPar::TLocalExecutor localExecutor;
         localExecutor.RunAdditionalThreads(threadCount - 1);
         TPoolBuilder builder(localExecutor, pool);
@@ -183,6 +258,113 @@ namespace NCB {
             &localExecutor,
             &builder
         );
+
+        if (useBinaryCache) {
+            SavePoolToBinaryCache(*pool, cachePath);
+        }
+    }
+
+    void ReadPool(
+        const TVector<TPathWithScheme>& partPaths,
+        const TPathWithScheme& pairsFilePath,
+        const NCatboostOptions::TDsvPoolFormatParams& dsvPoolFormatParams,
+        const TVector<int>& ignoredFeatures,
+        int threadCount,
+        bool verbose,
+        const TVector<TString>& classNames,
+        TPool* pool
+    ) {
+        CB_ENSURE(!partPaths.empty(), "Error: got empty pool part path list");
+        if (partPaths.size() == 1) {
+            ReadPool(
+                partPaths[0],
+                pairsFilePath,
+                dsvPoolFormatParams,
+                ignoredFeatures,
+                threadCount,
+                verbose,
+                classNames,
+                pool
+            );
+            return;
+        }
+
+        if (verbose) {
+            SetVerboseLogingMode();
+        } else {
+            SetSilentLogingMode();
+        }
+
+        NPar::TLocalExecutor localExecutor;
+        localExecutor.RunAdditionalThreads(threadCount - 1);
+
+        TVector<TPool> parts(partPaths.size());
+
+        /* One task per part file; ids are taken from the executor's shared counter, so threads
+         * that finish small parts immediately steal the next one and differently sized parts
+         * balance out. Nested per-line parallelism inside each part works on the same executor.
+         */
+        localExecutor.ExecRangeWithThrow(
+            [&](int partIdx) {
+                TPoolBuilder builder(localExecutor, &parts[partIdx]);
+                auto docPoolDataProvider = GetProcessor<IDocPoolDataProvider>(
+                    partPaths[partIdx], // for choosing processor
+
+                    // processor args
+                    TDocPoolDataProviderArgs {
+                        partPaths[partIdx],
+                        /*pairsFilePath*/ TPathWithScheme(),
+                        dsvPoolFormatParams,
+                        ignoredFeatures,
+                        classNames,
+                        10000, // TODO: make it a named constant
+                        &localExecutor
+                    }
+                );
+                docPoolDataProvider->Do(&builder);
+            },
+            0,
+            parts.ysize(),
+            NPar::TLocalExecutor::WAIT_COMPLETE
+        );
+
+        pool->Swap(parts[0]);
+        CB_ENSURE(!pool->IsQuantized(), "Error: quantized pool parts cannot be concatenated");
+        for (size_t partIdx = 1; partIdx < parts.size(); ++partIdx) {
+            TPool& part = parts[partIdx];
+            CB_ENSURE(!part.IsQuantized(), "Error: quantized pool parts cannot be concatenated");
+            CB_ENSURE(part.MetaInfo.FeatureCount == pool->MetaInfo.FeatureCount,
+                      "Error: pool parts have different feature counts");
+            CB_ENSURE(part.MetaInfo.HasGroupId == pool->MetaInfo.HasGroupId
+                      && part.MetaInfo.HasSubgroupIds == pool->MetaInfo.HasSubgroupIds,
+                      "Error: pool parts have different group columns");
+            CB_ENSURE(part.CatFeatures == pool->CatFeatures,
+                      "Error: pool parts have different categorical feature sets");
+            CB_ENSURE(part.FeatureId == pool->FeatureId,
+                      "Error: pool parts have different feature ids");
+            pool->Docs.Append(part.Docs);
+            pool->CatFeaturesHashToString.insert(
+                part.CatFeaturesHashToString.begin(),
+                part.CatFeaturesHashToString.end());
+            part.Docs.Clear();
+        }
+        if (!pool->MetaInfo.HasDocIds) {
+            // per-part generated ids collide after concatenation, renumber over the whole pool
+            for (int ind = 0; ind < pool->Docs.Id.ysize(); ++ind) {
+                pool->Docs.Id[ind] = ToString(ind);
+            }
+        }
+
+        if (pairsFilePath.Inited()) {
+            pool->Pairs = ReadPairs(pairsFilePath, pool->Docs.GetDocCount());
+            if (pool->MetaInfo.HasGroupWeight) {
+                WeightPairs(MakeArrayRef(pool->Docs.Weight.data(), pool->Docs.Weight.size()), &pool->Pairs);
+            }
+        }
+        MATRIXNET_INFO_LOG << "Doc info sizes: " << pool->Docs.GetDocCount() << " "
+            << pool->MetaInfo.FeatureCount << Endl;
+
+        SetVerboseLogingMode();
     }
 
     void ReadPool(
@@ -257,6 +439,13 @@ namespace NCB {
                 classNames,
                 &(trainPools->Learn)
             );
+            if (loadOptions.ShuffleSeed.Defined()) {
+                NPar::TLocalExecutor localExecutor;
+                localExecutor.RunAdditionalThreads(threadCount - 1);
+                ShufflePool(*loadOptions.ShuffleSeed, &(trainPools->Learn), &localExecutor);
+                MATRIXNET_INFO_LOG << "Shuffled learn pool (query blocks kept intact), seed "
+                                   << *loadOptions.ShuffleSeed << Endl;
+            }
             if (profile) {
                 (*profile)->AddOperation("Build learn pool");
             }
@@ -27,6 +27,22 @@ namespace NCB {
                   const TVector<TString>& classNames,
                   TPool* pool);
 
+    /*
+     * Read a pool split into several part files with identical column description.
+     * Part files are loaded in parallel (one task per part, scheduled on the executor's
+     * work-stealing queue) and concatenated in `partPaths` order, so large multi-part pools
+     * load at the speed of all disks/cores instead of a single reader.
+     * pairsFilePath (can be uninited) refers to document indices in the concatenated pool.
+     */
+    void ReadPool(const TVector<TPathWithScheme>& partPaths,
+                  const TPathWithScheme& pairsFilePath, // can be uninited
+                  const NCatboostOptions::TDsvPoolFormatParams& dsvPoolFormatParams,
+                  const TVector<int>& ignoredFeatures,
+                  int threadCount,
+                  bool verbose,
+                  const TVector<TString>& classNames,
+                  TPool* pool);
+
     void ReadPool(const TPathWithScheme& poolPath,
                   const TPathWithScheme& pairsFilePath, // can be uninited
                   const NCatboostOptions::TDsvPoolFormatParams& dsvPoolFormatParams,
@@ -1,6 +1,7 @@
 #include "pool.h"
 
 #include <catboost/libs/helpers/exception.h>
+#include <catboost/libs/helpers/permutation.h>
 
 static TDocumentStorage SliceDocumentStorage(
     const TDocumentStorage& docs,
@@ -12,6 +13,13 @@ static TDocumentStorage SliceDocumentStorage(
 
     TDocumentStorage slicedDocs;
     slicedDocs.Resize(rowIndices.size(), docs.GetEffectiveFactorCount());
+    // keep factors that were ignored on load (or already freed) empty in the slice as well
+    for (int factorIdx = 0; factorIdx < docs.Factors.ysize(); ++factorIdx) {
+        if (docs.Factors[factorIdx].empty()) {
+            slicedDocs.Factors[factorIdx].clear();
+            slicedDocs.Factors[factorIdx].shrink_to_fit();
+        }
+    }
 
     for (size_t newDocIdx = 0; newDocIdx < rowIndices.size(); ++newDocIdx) {
         size_t oldDocIdx = rowIndices[newDocIdx];
@@ -48,6 +56,22 @@ THolder<TPool> SlicePool(const TPool& pool, const TVector<size_t>& rowIndices) {
     slicedPool->Docs = SliceDocumentStorage(pool.Docs, rowIndices);
     slicedPool->Pairs = SlicePairs(pool, rowIndices);
 
+    // quantized bin columns are sliced the same way raw factor columns are
+    slicedPool->QuantizedFeatures.resize(pool.QuantizedFeatures.size());
+    for (size_t featureIdx = 0; featureIdx < pool.QuantizedFeatures.size(); ++featureIdx) {
+        const TVector<ui8>& bins = pool.QuantizedFeatures[featureIdx];
+        if (bins.empty()) {
+            continue;
+        }
+        TVector<ui8>& slicedBins = slicedPool->QuantizedFeatures[featureIdx];
+        slicedBins.yresize(rowIndices.size());
+        for (size_t newDocIdx = 0; newDocIdx < rowIndices.size(); ++newDocIdx) {
+            slicedBins[newDocIdx] = bins[rowIndices[newDocIdx]];
+        }
+    }
+    slicedPool->QuantizationBorders = pool.QuantizationBorders;
+    slicedPool->QuantizationNanModes = pool.QuantizationNanModes;
+
     slicedPool->CatFeatures = pool.CatFeatures;
     slicedPool->FeatureId = pool.FeatureId;
     slicedPool->CatFeaturesHashToString = pool.CatFeaturesHashToString;
@@ -81,6 +105,8 @@ void ApplyPermutationToPairs(const TVector<ui64>& permutation, TVector<TPair>* p
 
 void ApplyPermutation(const TVector<ui64>& permutation, TPool* pool, NPar::TLocalExecutor* localExecutor) {
     Y_VERIFY(pool->Docs.GetDocCount() == 0 || permutation.size() == pool->Docs.GetDocCount());
+    // borrowed columns cannot be permuted in the caller's buffers; copy them once and permute the copy
+    pool->Docs.MaterializeExternalFactors();
 
     if (pool->Docs.GetDocCount() > 0) {
         NPar::TLocalExecutor::TExecRangeParams blockParams(0, pool->Docs.Factors.ysize());
@@ -88,6 +114,11 @@ void ApplyPermutation(const TVector<ui64>& permutation, TPool* pool, NPar::TLoca
             ApplyPermutation(permutation, &pool->Docs.Factors[factorIdx]);
         }, blockParams, NPar::TLocalExecutor::WAIT_COMPLETE);
 
+        NPar::TLocalExecutor::TExecRangeParams quantizedBlockParams(0, pool->QuantizedFeatures.ysize());
+        localExecutor->ExecRange([&] (int featureIdx) {
+            ApplyPermutation(permutation, &pool->QuantizedFeatures[featureIdx]);
+        }, quantizedBlockParams, NPar::TLocalExecutor::WAIT_COMPLETE);
+
         for (int dim = 0; dim < pool->Docs.GetBaselineDimension(); ++dim) {
             ApplyPermutation(permutation, &pool->Docs.Baseline[dim]);
         }
@@ -100,3 +131,16 @@ void ApplyPermutation(const TVector<ui64>& permutation, TPool* pool, NPar::TLoca
 
     ApplyPermutationToPairs(permutation, &pool->Pairs);
 }
+
+void ShufflePool(ui64 seed, TPool* pool, NPar::TLocalExecutor* localExecutor) {
+    const size_t docCount = pool->Docs.GetDocCount();
+    if (docCount == 0) {
+        return;
+    }
+    TRestorableFastRng64 rand(seed);
+    TVector<ui64> permutation;
+    permutation.yresize(docCount);
+    std::iota(permutation.begin(), permutation.end(), /*starting value*/ 0);
+    ShuffleGroups(pool->Docs.QueryId, rand, &permutation);
+    ApplyPermutation(InvertPermutation(permutation), pool, localExecutor);
+}
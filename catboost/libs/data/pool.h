@@ -6,11 +6,14 @@
 #include <catboost/libs/data_types/groupid.h>
 #include <catboost/libs/data_types/pair.h>
 #include <catboost/libs/cat_feature/cat_feature.h>
+#include <catboost/libs/options/enums.h>
 #include <catboost/libs/pool_builder/pool_builder.h>
 
 #include <library/threading/local_executor/local_executor.h>
 
 #include <util/string/cast.h>
+#include <util/generic/algorithm.h>
+#include <util/generic/array_ref.h>
 #include <util/random/fast.h>
 #include <util/generic/is_in.h>
 #include <util/generic/maybe.h>
@@ -38,6 +41,13 @@ struct TDocInfo {
 
 struct TDocumentStorage {
     TVector<TVector<float>> Factors; // [factorIdx][docIdx]
+    /*
+     * Borrowed factor columns (see SetExternalFactors); when non-empty, `Factors` is unused and
+     * factor values must be read through `GetFactorRef`. The caller-owned buffers must stay
+     * alive and unchanged for as long as this storage is used, and documents cannot be
+     * permuted, swapped or appended to in place.
+     */
+    TVector<TConstArrayRef<float>> ExternalFactors; // [factorIdx][docIdx]
     TVector<TVector<double>> Baseline; // [dim][docIdx]
     TVector<float> Target; // [docIdx]
     TVector<float> Weight; // [docIdx]
@@ -52,13 +62,38 @@ struct TDocumentStorage {
 
     /// @return the number of non-constant factors (`Factors` stores only non-constant factors).
     inline int GetEffectiveFactorCount() const {
-        return Factors.ysize();
+        return HasExternalFactors() ? ExternalFactors.ysize() : Factors.ysize();
+    }
+
+    inline bool HasExternalFactors() const {
+        return !ExternalFactors.empty();
+    }
+
+    inline TConstArrayRef<float> GetFactorRef(int factorIdx) const {
+        if (HasExternalFactors()) {
+            return ExternalFactors[factorIdx];
+        }
+        return MakeArrayRef(Factors[factorIdx].data(), Factors[factorIdx].size());
+    }
+
+    inline float GetFeatureValue(int docIdx, int featureIdx) const {
+        return GetFactorRef(featureIdx)[docIdx];
     }
 
     inline size_t GetDocCount() const {
         return Target.size();
     }
 
+    /*
+     * true when every document weighs 1 (no weight column or an all-ones one).
+     * Downstream code may then drop the weight vector entirely: an empty weight
+     * vector is the established all-ones representation, and the derivative and
+     * metric loops skip weight multiplication for it.
+     */
+    inline bool IsTrivialWeights() const {
+        return Weight.empty() || AllOf(Weight, [](float weight) { return weight == 1.0f; });
+    }
+
     bool operator==(const TDocumentStorage& other) const {
         if (Factors.ysize() != other.Factors.ysize()) {
             return false;
@@ -84,6 +119,7 @@ struct TDocumentStorage {
 
     inline void Swap(TDocumentStorage& other) {
         Factors.swap(other.Factors);
+        ExternalFactors.swap(other.ExternalFactors);
         Baseline.swap(other.Baseline);
         Target.swap(other.Target);
         Weight.swap(other.Weight);
@@ -94,7 +130,11 @@ struct TDocumentStorage {
     }
 
     inline void SwapDoc(size_t doc1Idx, size_t doc2Idx) {
+        Y_ASSERT(!HasExternalFactors());
         for (int factorIdx = 0; factorIdx < GetEffectiveFactorCount(); ++factorIdx) {
+            if (Factors[factorIdx].empty()) { // ignored or freed factors have no values
+                continue;
+            }
             DoSwap(Factors[factorIdx][doc1Idx], Factors[factorIdx][doc2Idx]);
         }
         for (int dim = 0; dim < GetBaselineDimension(); ++dim) {
@@ -113,10 +153,15 @@ struct TDocumentStorage {
     }
 
     inline void AssignDoc(int destinationIdx, const TDocumentStorage& sourceDocs, int sourceIdx) {
+        Y_ASSERT(!HasExternalFactors());
         Y_ASSERT(GetEffectiveFactorCount() == sourceDocs.GetEffectiveFactorCount());
         Y_ASSERT(GetBaselineDimension() == sourceDocs.GetBaselineDimension());
         for (int factorIdx = 0; factorIdx < GetEffectiveFactorCount(); ++factorIdx) {
-            Factors[factorIdx][destinationIdx] = sourceDocs.Factors[factorIdx][sourceIdx];
+            const TConstArrayRef<float> sourceFactor = sourceDocs.GetFactorRef(factorIdx);
+            if (sourceFactor.empty()) { // ignored or freed factors have no values
+                continue;
+            }
+            Factors[factorIdx][destinationIdx] = sourceFactor[sourceIdx];
         }
         for (int dim = 0; dim < GetBaselineDimension(); ++dim) {
             Baseline[dim][destinationIdx] = sourceDocs.Baseline[dim][sourceIdx];
@@ -133,10 +178,72 @@ struct TDocumentStorage {
         Timestamp[destinationIdx] = sourceDocs.Timestamp[sourceIdx];
     }
 
-    inline void Resize(int docCount, int featureCount, int approxDim = 0, bool hasQueryId = false, bool hasSubgroupId = false) {
+    inline void Append(const TDocumentStorage& documents) {
+        Y_ASSERT(!HasExternalFactors() && !documents.HasExternalFactors());
+        Y_ASSERT(GetEffectiveFactorCount() == documents.GetEffectiveFactorCount());
+        Y_ASSERT(GetBaselineDimension() == documents.GetBaselineDimension());
+        for (int factorIdx = 0; factorIdx < GetEffectiveFactorCount(); ++factorIdx) {
+            Factors[factorIdx].insert(Factors[factorIdx].end(), documents.Factors[factorIdx].begin(), documents.Factors[factorIdx].end());
+        }
+        for (int dim = 0; dim < GetBaselineDimension(); ++dim) {
+            Baseline[dim].insert(Baseline[dim].end(), documents.Baseline[dim].begin(), documents.Baseline[dim].end());
+        }
+        Target.insert(Target.end(), documents.Target.begin(), documents.Target.end());
+        Weight.insert(Weight.end(), documents.Weight.begin(), documents.Weight.end());
+        Id.insert(Id.end(), documents.Id.begin(), documents.Id.end());
+        QueryId.insert(QueryId.end(), documents.QueryId.begin(), documents.QueryId.end());
+        SubgroupId.insert(SubgroupId.end(), documents.SubgroupId.begin(), documents.SubgroupId.end());
+        Timestamp.insert(Timestamp.end(), documents.Timestamp.begin(), documents.Timestamp.end());
+    }
+
+    /*
+     * Adopt caller-owned columnar factor data without copying. All columns must have equal
+     * length; per-document fields (Target, Weight, Id, Timestamp) are resized to match.
+     */
+    inline void SetExternalFactors(const TVector<TConstArrayRef<float>>& factorColumns) {
+        const size_t docCount = factorColumns.empty() ? 0 : factorColumns[0].size();
+        for (const auto& column : factorColumns) {
+            Y_ENSURE(column.size() == docCount, "all borrowed factor columns must have equal length");
+        }
+        ExternalFactors = factorColumns;
+        Factors.clear();
+        Target.resize(docCount);
+        Weight.resize(docCount, 1.0f);
+        Id.resize(docCount);
+        for (size_t ind = 0; ind < docCount; ++ind) {
+            Id[ind] = ToString(ind);
+        }
+        Timestamp.resize(docCount);
+    }
+
+    /*
+     * Copy borrowed factor columns into owned storage and drop the borrow, detaching from
+     * the caller's buffers. Needed before any in-place mutation of documents (e.g. the
+     * learn pool permutation that precedes training).
+     */
+    inline void MaterializeExternalFactors() {
+        if (!HasExternalFactors()) {
+            return;
+        }
+        Factors.resize(ExternalFactors.size());
+        for (size_t factorIdx = 0; factorIdx < ExternalFactors.size(); ++factorIdx) {
+            Factors[factorIdx].assign(ExternalFactors[factorIdx].begin(), ExternalFactors[factorIdx].end());
+        }
+        ExternalFactors.clear();
+    }
+
+    inline void Resize(int docCount, int featureCount, int approxDim = 0, bool hasQueryId = false, bool hasSubgroupId = false,
+                       const TVector<bool>* ignoredFeatures = nullptr) {
+        ExternalFactors.clear();
         Factors.resize(featureCount);
-        for (auto& factor : Factors) {
-            factor.resize(docCount);
+        for (int factorIdx = 0; factorIdx < featureCount; ++factorIdx) {
+            if (ignoredFeatures && (*ignoredFeatures)[factorIdx]) {
+                // same empty-column representation that binarization leaves after freeing a factor
+                Factors[factorIdx].clear();
+                Factors[factorIdx].shrink_to_fit();
+            } else {
+                Factors[factorIdx].resize(docCount);
+            }
         }
         Baseline.resize(approxDim);
         for (auto& dim : Baseline) {
@@ -158,6 +265,7 @@ struct TDocumentStorage {
     }
 
     inline void Clear() {
+        ExternalFactors.clear();
         for (auto& factor : Factors) {
             factor.clear();
             factor.shrink_to_fit();
@@ -183,14 +291,31 @@ struct TDocumentStorage {
 
 struct TPool {
     mutable TDocumentStorage Docs; // allow freeing Factors[i] and Baseline[i] as Docs are binarized, to reduce memory footprint
+    /*
+     * Bin values of a pool quantized ahead of time, [featureIdx][docIdx]. Filled instead of
+     * Docs.Factors when the pool was loaded from a quantized file, so raw float columns are
+     * never materialized. Columns of features absent from the pool's quantization schema (or
+     * ignored on load) stay empty, the same way ignored raw factors do. Mutable for the same
+     * reason Docs is: bins may be moved out as the pool is turned into a dataset.
+     */
+    mutable TVector<TVector<ui8>> QuantizedFeatures;
+    TVector<TVector<float>> QuantizationBorders; // [featureIdx], borders the bins were computed with
+    TVector<ENanMode> QuantizationNanModes; // [featureIdx]
     TVector<int> CatFeatures;
     TVector<TString> FeatureId;
     THashMap<int, TString> CatFeaturesHashToString;
     TVector<TPair> Pairs;
     TPoolMetaInfo MetaInfo;
 
+    bool IsQuantized() const {
+        return !QuantizedFeatures.empty();
+    }
+
     void Swap(TPool& other) {
         Docs.Swap(other.Docs);
+        QuantizedFeatures.swap(other.QuantizedFeatures);
+        QuantizationBorders.swap(other.QuantizationBorders);
+        QuantizationNanModes.swap(other.QuantizationNanModes);
         CatFeatures.swap(other.CatFeatures);
         FeatureId.swap(other.FeatureId);
         CatFeaturesHashToString.swap(other.CatFeaturesHashToString);
@@ -279,3 +404,11 @@ inline int GetDocCount(const TVector<const TPool*>& testPoolPtrs) {
 
 void ApplyPermutation(const TVector<ui64>& permutation, TPool* pool, NPar::TLocalExecutor* localExecutor);
 void ApplyPermutationToPairs(const TVector<ui64>& permutation, TVector<TPair>* pairs);
+
+/*
+ * Group-preserving shuffle: permutes whole query blocks, documents inside a block keep their
+ * order, pairs are remapped. The rng is restorable from the seed, so the same seed reproduces
+ * the same document order. Used to fix a skewed on-disk order right after load instead of an
+ * external shuffle pass.
+ */
+void ShufflePool(ui64 seed, TPool* pool, NPar::TLocalExecutor* localExecutor);
@@ -0,0 +1,245 @@
+#include "pool_cache.h"
+
+#include <catboost/libs/helpers/exception.h>
+#include <catboost/libs/logging/logging.h>
+
+#include <util/memory/blob.h>
+#include <util/stream/file.h>
+#include <util/stream/mem.h>
+#include <util/string/cast.h>
+#include <util/system/env.h>
+#include <util/system/fs.h>
+#include <util/system/fstat.h>
+#include <util/ysaveload.h>
+
+#include <cstring>
+
+namespace NCB {
+
+    namespace {
+
+        const char CacheMagic[8] = {'C', 'B', 'P', 'O', 'O', 'L', 'B', 'C'};
+        const ui32 CacheVersion = 1;
+
+        struct TBinaryPoolCacheHeader {
+            char Magic[8];
+            ui32 Version = 0;
+            ui32 FactorCount = 0;
+            ui64 DocCount = 0;
+            ui32 BaselineDim = 0;
+            ui32 FeatureCount = 0;
+            ui32 BaselineCount = 0;
+            ui8 HasQueryId = 0;
+            ui8 HasSubgroupId = 0;
+            ui8 HasTrivialDocIds = 0;
+            ui8 HasColumnsInfo = 0;
+            ui8 HasGroupId = 0;
+            ui8 HasGroupWeight = 0;
+            ui8 HasSubgroupIds = 0;
+            ui8 HasDocIds = 0;
+            ui8 HasWeights = 0;
+            ui8 HasTimestamp = 0;
+            ui8 Padding[2] = {0, 0};
+        };
+
+        //doc ids generated by the builder are just row indices and don't have to be stored
+        bool AreDocIdsTrivial(const TVector<TString>& ids) {
+            for (size_t i = 0; i < ids.size(); ++i) {
+                if (ids[i] != ToString(i)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        template <class T>
+        void WriteColumn(const TVector<T>& column, ui64 docCount, IOutputStream* out) {
+            CB_ENSURE(column.size() == docCount, "pool column has unexpected length");
+            out->Write(column.data(), column.size() * sizeof(T));
+        }
+
+        template <class T>
+        void ReadColumn(const char** cursor, const char* end, ui64 count, TVector<T>* column) {
+            const ui64 bytes = count * sizeof(T);
+            CB_ENSURE(*cursor + bytes <= end, "binary pool cache is truncated");
+            column->resize(count);
+            memcpy(column->data(), *cursor, bytes);
+            *cursor += bytes;
+        }
+
+        void LoadPoolImpl(const TString& cachePath, TPool* pool) {
+            TBlob blob = TBlob::FromFile(cachePath);
+            const char* cursor = blob.AsCharPtr();
+            const char* end = cursor + blob.Size();
+
+            CB_ENSURE(blob.Size() >= sizeof(TBinaryPoolCacheHeader), "binary pool cache is truncated");
+            TBinaryPoolCacheHeader header;
+            memcpy(&header, cursor, sizeof(header));
+            cursor += sizeof(header);
+            CB_ENSURE(memcmp(header.Magic, CacheMagic, sizeof(CacheMagic)) == 0,
+                      "not a binary pool cache");
+            CB_ENSURE(header.Version == CacheVersion,
+                      "binary pool cache has version " << header.Version
+                      << ", expected " << CacheVersion);
+
+            auto& docs = pool->Docs;
+            ReadColumn(&cursor, end, header.DocCount, &docs.Target);
+            ReadColumn(&cursor, end, header.DocCount, &docs.Weight);
+            if (header.HasQueryId) {
+                ReadColumn(&cursor, end, header.DocCount, &docs.QueryId);
+            }
+            if (header.HasSubgroupId) {
+                ReadColumn(&cursor, end, header.DocCount, &docs.SubgroupId);
+            }
+            ReadColumn(&cursor, end, header.DocCount, &docs.Timestamp);
+            docs.Baseline.resize(header.BaselineDim);
+            for (ui32 dim = 0; dim < header.BaselineDim; ++dim) {
+                ReadColumn(&cursor, end, header.DocCount, &docs.Baseline[dim]);
+            }
+            docs.Factors.resize(header.FactorCount);
+            for (ui32 factorIdx = 0; factorIdx < header.FactorCount; ++factorIdx) {
+                ReadColumn(&cursor, end, header.DocCount, &docs.Factors[factorIdx]);
+            }
+
+            TMemoryInput in(cursor, end - cursor);
+            ::Load(&in, pool->CatFeatures);
+            ::Load(&in, pool->FeatureId);
+            ::Load(&in, pool->CatFeaturesHashToString);
+            ui64 pairCount = 0;
+            ::Load(&in, pairCount);
+            pool->Pairs.resize(pairCount);
+            in.LoadOrFail(pool->Pairs.data(), pairCount * sizeof(TPair));
+            if (header.HasTrivialDocIds) {
+                docs.Id.resize(header.DocCount);
+                for (ui64 i = 0; i < header.DocCount; ++i) {
+                    docs.Id[i] = ToString(i);
+                }
+            } else {
+                ::Load(&in, docs.Id);
+                CB_ENSURE(docs.Id.size() == header.DocCount, "binary pool cache is corrupted");
+            }
+
+            pool->MetaInfo = TPoolMetaInfo();
+            pool->MetaInfo.FeatureCount = header.FeatureCount;
+            pool->MetaInfo.BaselineCount = header.BaselineCount;
+            pool->MetaInfo.HasGroupId = header.HasGroupId;
+            pool->MetaInfo.HasGroupWeight = header.HasGroupWeight;
+            pool->MetaInfo.HasSubgroupIds = header.HasSubgroupIds;
+            pool->MetaInfo.HasDocIds = header.HasDocIds;
+            pool->MetaInfo.HasWeights = header.HasWeights;
+            pool->MetaInfo.HasTimestamp = header.HasTimestamp;
+            if (header.HasColumnsInfo) {
+                ui64 columnCount = 0;
+                ::Load(&in, columnCount);
+                TVector<TColumn> columns(columnCount);
+                for (auto& column : columns) {
+                    ui32 type = 0;
+                    ::Load(&in, type);
+                    column.Type = static_cast<EColumn>(type);
+                    ::Load(&in, column.Id);
+                }
+                pool->MetaInfo.ColumnsInfo = TPoolColumnsMetaInfo{std::move(columns)};
+            }
+        }
+
+    }
+
+    bool IsBinaryPoolCacheEnabled() {
+        return FromString<bool>(GetEnv("CB_BINARY_POOL_CACHE", "0"));
+    }
+
+    TString GetBinaryPoolCachePath(const TString& poolPath) {
+        return poolPath + ".bin";
+    }
+
+    bool TryLoadPoolFromBinaryCache(const TString& cachePath, const TString& poolPath, TPool* pool) {
+        if (!NFs::Exists(cachePath)) {
+            return false;
+        }
+        if (TFileStat(cachePath).MTime < TFileStat(poolPath).MTime) {
+            MATRIXNET_INFO_LOG << "Binary pool cache " << cachePath
+                               << " is older than the pool, rebuilding" << Endl;
+            return false;
+        }
+        try {
+            LoadPoolImpl(cachePath, pool);
+        } catch (const yexception& e) {
+            MATRIXNET_WARNING_LOG << "Ignoring binary pool cache " << cachePath
+                                  << ": " << e.what() << Endl;
+            *pool = TPool();
+            return false;
+        }
+        MATRIXNET_INFO_LOG << "Restored pool from binary cache " << cachePath << Endl;
+        return true;
+    }
+
+    void SavePoolToBinaryCache(const TPool& pool, const TString& cachePath) {
+        const auto& docs = pool.Docs;
+        CB_ENSURE(!docs.HasExternalFactors(),
+                  "cannot snapshot a pool with borrowed factor columns");
+
+        TBinaryPoolCacheHeader header;
+        memcpy(header.Magic, CacheMagic, sizeof(CacheMagic));
+        header.Version = CacheVersion;
+        header.FactorCount = docs.Factors.ysize();
+        header.DocCount = docs.GetDocCount();
+        header.BaselineDim = docs.GetBaselineDimension();
+        header.FeatureCount = pool.MetaInfo.FeatureCount;
+        header.BaselineCount = pool.MetaInfo.BaselineCount;
+        header.HasQueryId = !docs.QueryId.empty();
+        header.HasSubgroupId = !docs.SubgroupId.empty();
+        header.HasTrivialDocIds = AreDocIdsTrivial(docs.Id);
+        header.HasColumnsInfo = pool.MetaInfo.ColumnsInfo.Defined();
+        header.HasGroupId = pool.MetaInfo.HasGroupId;
+        header.HasGroupWeight = pool.MetaInfo.HasGroupWeight;
+        header.HasSubgroupIds = pool.MetaInfo.HasSubgroupIds;
+        header.HasDocIds = pool.MetaInfo.HasDocIds;
+        header.HasWeights = pool.MetaInfo.HasWeights;
+        header.HasTimestamp = pool.MetaInfo.HasTimestamp;
+
+        //write to a temporary and rename so a killed run never leaves a half-written cache
+        const TString tmpPath = cachePath + ".tmp";
+        {
+            TOFStream out(tmpPath);
+            out.Write(&header, sizeof(header));
+            WriteColumn(docs.Target, header.DocCount, &out);
+            WriteColumn(docs.Weight, header.DocCount, &out);
+            if (header.HasQueryId) {
+                WriteColumn(docs.QueryId, header.DocCount, &out);
+            }
+            if (header.HasSubgroupId) {
+                WriteColumn(docs.SubgroupId, header.DocCount, &out);
+            }
+            WriteColumn(docs.Timestamp, header.DocCount, &out);
+            for (const auto& dim : docs.Baseline) {
+                WriteColumn(dim, header.DocCount, &out);
+            }
+            for (const auto& factor : docs.Factors) {
+                WriteColumn(factor, header.DocCount, &out);
+            }
+
+            ::Save(&out, pool.CatFeatures);
+            ::Save(&out, pool.FeatureId);
+            ::Save(&out, pool.CatFeaturesHashToString);
+            const ui64 pairCount = pool.Pairs.size();
+            ::Save(&out, pairCount);
+            out.Write(pool.Pairs.data(), pairCount * sizeof(TPair));
+            if (!header.HasTrivialDocIds) {
+                ::Save(&out, docs.Id);
+            }
+            if (header.HasColumnsInfo) {
+                const auto& columns = pool.MetaInfo.ColumnsInfo->Columns;
+                const ui64 columnCount = columns.size();
+                ::Save(&out, columnCount);
+                for (const auto& column : columns) {
+                    ::Save(&out, static_cast<ui32>(column.Type));
+                    ::Save(&out, column.Id);
+                }
+            }
+            out.Finish();
+        }
+        NFs::Rename(tmpPath, cachePath);
+        MATRIXNET_INFO_LOG << "Saved binary pool cache to " << cachePath << Endl;
+    }
+
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "pool.h"
+
+#include <util/generic/string.h>
+
+namespace NCB {
+
+    /*
+     * Raw binary snapshot of a fully parsed TPool.
+     *
+     * Parsing a large dsv costs minutes per run while the resulting columns are
+     * plain arrays, so when CB_BINARY_POOL_CACHE=1 the pool is dumped in its
+     * in-memory layout next to the source file after the first load and restored
+     * with a file mapping and per-column memcpy on subsequent loads, as long as
+     * the cache is fresher than the source. Unlike quantized pools the snapshot
+     * keeps raw factor values, so binarization settings may vary between runs.
+     *
+     * The format is host-specific (no endianness or layout conversion); stale,
+     * truncated or incompatible caches are ignored and rebuilt.
+     */
+
+    bool IsBinaryPoolCacheEnabled();
+
+    // cache file stored beside the source pool
+    TString GetBinaryPoolCachePath(const TString& poolPath);
+
+    // returns false if the cache is missing, older than the source pool or unreadable
+    bool TryLoadPoolFromBinaryCache(const TString& cachePath, const TString& poolPath, TPool* pool);
+
+    void SavePoolToBinaryCache(const TPool& pool, const TString& cachePath);
+
+}
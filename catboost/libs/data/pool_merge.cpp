@@ -0,0 +1,128 @@
+#include "pool_merge.h"
+
+#include <catboost/libs/helpers/exception.h>
+
+#include <util/generic/hash.h>
+#include <util/generic/strbuf.h>
+
+namespace NCB {
+
+    static const ui32 NotMatchedIdx = Max<ui32>();
+
+    // Hash every id once up front; the partition of an id and the lookup table bucket both
+    // derive from this value, so build and probe never rehash the strings.
+    static TVector<ui64> CalcIdHashes(const TVector<TString>& ids, NPar::TLocalExecutor* localExecutor) {
+        TVector<ui64> hashes;
+        hashes.yresize(ids.size());
+        NPar::TLocalExecutor::TExecRangeParams blockParams(0, ids.ysize());
+        blockParams.SetBlockSize(10000);
+        localExecutor->ExecRange([&](int blockIdx) {
+            NPar::TLocalExecutor::BlockedLoopBody(blockParams, [&](int docIdx) {
+                hashes[docIdx] = THash<TString>()(ids[docIdx]);
+            })(blockIdx);
+        }, 0, blockParams.GetBlockCount(), NPar::TLocalExecutor::WAIT_COMPLETE);
+        return hashes;
+    }
+
+    THolder<TPool> MergePoolsById(
+        const TPool& leftPool,
+        const TPool& rightPool,
+        const TPoolMergeOptions& options,
+        NPar::TLocalExecutor* localExecutor
+    ) {
+        CB_ENSURE(!leftPool.IsQuantized() && !rightPool.IsQuantized(),
+            "pool merge by id is supported for raw pools only");
+
+        const int leftDocCount = leftPool.Docs.Id.ysize();
+        const int rightDocCount = rightPool.Docs.Id.ysize();
+        const ui32 partitionCount = localExecutor->GetThreadCount() + 1;
+
+        // build phase: each partition owns the right ids whose hash lands in it, so the
+        // per-partition lookup tables are filled in parallel without any shared state;
+        // the keys view into the right pool's id column and copy nothing
+        const TVector<ui64> rightIdHashes = CalcIdHashes(rightPool.Docs.Id, localExecutor);
+        TVector<THashMap<TStringBuf, ui32>> partitionIndex(partitionCount);
+        localExecutor->ExecRange([&](int partition) {
+            THashMap<TStringBuf, ui32>& index = partitionIndex[partition];
+            for (int docIdx = 0; docIdx < rightDocCount; ++docIdx) {
+                if (rightIdHashes[docIdx] % partitionCount != (ui64)partition) {
+                    continue;
+                }
+                const bool inserted = index.emplace(TStringBuf(rightPool.Docs.Id[docIdx]), (ui32)docIdx).second;
+                CB_ENSURE(inserted, "duplicate id in joined pool: " << rightPool.Docs.Id[docIdx]);
+            }
+        }, 0, partitionCount, NPar::TLocalExecutor::WAIT_COMPLETE);
+
+        // probe phase: parallel over left document blocks, each lookup only touches the
+        // partition its hash selects
+        TVector<ui32> rightIdxForLeftDoc;
+        rightIdxForLeftDoc.yresize(leftDocCount);
+        NPar::TLocalExecutor::TExecRangeParams probeParams(0, leftDocCount);
+        probeParams.SetBlockSize(10000);
+        localExecutor->ExecRange([&](int blockIdx) {
+            NPar::TLocalExecutor::BlockedLoopBody(probeParams, [&](int docIdx) {
+                const TString& id = leftPool.Docs.Id[docIdx];
+                const ui64 hash = THash<TString>()(id);
+                const ui32* rightIdx = partitionIndex[hash % partitionCount].FindPtr(TStringBuf(id));
+                rightIdxForLeftDoc[docIdx] = rightIdx ? *rightIdx : NotMatchedIdx;
+            })(blockIdx);
+        }, 0, probeParams.GetBlockCount(), NPar::TLocalExecutor::WAIT_COMPLETE);
+
+        // compact the matches keeping the left pool's row order
+        TVector<size_t> leftIndices;
+        TVector<ui32> rightIndices;
+        for (int docIdx = 0; docIdx < leftDocCount; ++docIdx) {
+            if (rightIdxForLeftDoc[docIdx] != NotMatchedIdx) {
+                leftIndices.push_back(docIdx);
+                rightIndices.push_back(rightIdxForLeftDoc[docIdx]);
+            }
+        }
+        CB_ENSURE(!leftIndices.empty(), "pool merge by id found no common ids");
+
+        THolder<TPool> merged = SlicePool(leftPool, leftIndices);
+        const int mergedDocCount = leftIndices.ysize();
+
+        if (options.TakeTargetFromRight) {
+            for (int docIdx = 0; docIdx < mergedDocCount; ++docIdx) {
+                merged->Docs.Target[docIdx] = rightPool.Docs.Target[rightIndices[docIdx]];
+            }
+        }
+
+        if (options.AppendRightFactors) {
+            const int leftFactorCount = merged->Docs.GetEffectiveFactorCount();
+            const int rightFactorCount = rightPool.Docs.GetEffectiveFactorCount();
+            merged->Docs.Factors.resize(leftFactorCount + rightFactorCount);
+            localExecutor->ExecRange([&](int rightFactorIdx) {
+                const TConstArrayRef<float> source = rightPool.Docs.GetFactorRef(rightFactorIdx);
+                if (source.empty()) { // ignored or freed factors stay empty in the merge as well
+                    return;
+                }
+                TVector<float>& column = merged->Docs.Factors[leftFactorCount + rightFactorIdx];
+                column.yresize(mergedDocCount);
+                for (int docIdx = 0; docIdx < mergedDocCount; ++docIdx) {
+                    column[docIdx] = source[rightIndices[docIdx]];
+                }
+            }, 0, rightFactorCount, NPar::TLocalExecutor::WAIT_COMPLETE);
+
+            // appended columns keep their relative order, so their indices just shift
+            for (int catFeatureIdx : rightPool.CatFeatures) {
+                merged->CatFeatures.push_back(leftFactorCount + catFeatureIdx);
+            }
+            for (const auto& hashAndString : rightPool.CatFeaturesHashToString) {
+                merged->CatFeaturesHashToString.emplace(hashAndString.first, hashAndString.second);
+            }
+            if (!merged->FeatureId.empty() || !rightPool.FeatureId.empty()) {
+                merged->FeatureId.resize(leftFactorCount);
+                for (int rightFactorIdx = 0; rightFactorIdx < rightFactorCount; ++rightFactorIdx) {
+                    merged->FeatureId.push_back(rightFactorIdx < rightPool.FeatureId.ysize()
+                        ? rightPool.FeatureId[rightFactorIdx]
+                        : ToString(leftFactorCount + rightFactorIdx));
+                }
+            }
+            merged->MetaInfo.FeatureCount = leftFactorCount + rightFactorCount;
+        }
+
+        return merged;
+    }
+
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "pool.h"
+
+#include <library/threading/local_executor/local_executor.h>
+
+namespace NCB {
+
+    /*
+     * Keyed pool merge: joins auxiliary per-document data (fresh labels, extra feature
+     * columns) from one raw pool onto another by the document id column, replacing the
+     * external join step that pipelines otherwise run before every train.
+     *
+     * The join is an inner one on Docs.Id preserving the left pool's row order: left
+     * documents without a match in the right pool are dropped, right-only documents are
+     * ignored. Right ids must be unique. Implemented as a partitioned hash join - the
+     * right id column is split by id hash into per-thread partitions whose lookup tables
+     * are built and probed in parallel without shared state.
+     */
+
+    struct TPoolMergeOptions {
+        // overwrite the target column with the right pool's values (label refresh)
+        bool TakeTargetFromRight = false;
+        // append the right pool's factor columns after the left ones as new features
+        bool AppendRightFactors = true;
+    };
+
+    THolder<TPool> MergePoolsById(
+        const TPool& leftPool,
+        const TPool& rightPool,
+        const TPoolMergeOptions& options,
+        NPar::TLocalExecutor* localExecutor);
+
+}
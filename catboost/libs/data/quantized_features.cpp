@@ -5,6 +5,14 @@ size_t TAllFeatures::GetDocCount() const {
         if (!floatHistogram.empty())
             return floatHistogram.size();
     }
+    for (const auto& bundle : FeatureBundles) {
+        if (!bundle.Bins.empty())
+            return bundle.Bins.size();
+    }
+    for (const auto& pack : FeaturePacks) {
+        if (!pack.Bins.empty())
+            return pack.Bins.size();
+    }
     for (const auto& catFeatures : CatFeaturesRemapped) {
         if (!catFeatures.empty())
             return catFeatures.size();
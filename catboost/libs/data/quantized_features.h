@@ -5,14 +5,87 @@
 #include <util/generic/vector.h>
 #include <util/system/types.h>
 
+// Where a bundled float feature lives inside its exclusive feature bundle.
+struct TFeatureBundleRef {
+    int BundleIdx = -1; // -1 = feature is not bundled
+    int BinOffset = 0;
+    int BinCount = 0; // bin count of the original feature, default bin included
+    int DefaultBin = 0;
+    SAVELOAD(BundleIdx, BinOffset, BinCount, DefaultBin);
+};
+
+/*
+ * A group of mutually exclusive float features sharing one ui8 column: on every document
+ * at most one member is outside its default bin. Bundle bin 0 means "every member is in
+ * its default bin"; member bins are stored shifted into disjoint ranges (see GetBundledBin).
+ */
+struct TExclusiveFeatureBundle {
+    TVector<ui8> Bins; // [doc]
+    TVector<int> FloatFeatures; // float feature indices of the members
+    SAVELOAD(Bins, FloatFeatures);
+};
+
+// Restore the original bin of a bundled feature from the shared bundle bin.
+inline ui8 GetBundledBin(ui8 bundleBin, const TFeatureBundleRef& ref) {
+    const int shifted = static_cast<int>(bundleBin) - ref.BinOffset;
+    if (shifted <= 0 || shifted >= ref.BinCount) {
+        return static_cast<ui8>(ref.DefaultBin);
+    }
+    const int nonDefaultIdx = shifted - 1;
+    return static_cast<ui8>(nonDefaultIdx < ref.DefaultBin ? nonDefaultIdx : nonDefaultIdx + 1);
+}
+
+// Where a bit-packed float feature lives inside its packed group column.
+struct TFeaturePackRef {
+    int PackIdx = -1; // -1 = feature is not packed
+    int BitOffset = 0;
+    int BitWidth = 0; // 1, 2 or 4
+    SAVELOAD(PackIdx, BitOffset, BitWidth);
+};
+
+/*
+ * Low-cardinality float features sharing one byte column. All members of a group need
+ * the same bit width, so a byte holds 8, 4 or 2 of them side by side and the original
+ * ui8-per-document columns are freed (see GetPackedBin).
+ */
+struct TPackedFeatureGroup {
+    TVector<ui8> Bins; // [doc], bit-packed member bins
+    TVector<int> FloatFeatures; // float feature indices of the members
+    SAVELOAD(Bins, FloatFeatures);
+};
+
+// Restore the original bin of a bit-packed feature from the shared group byte.
+inline ui8 GetPackedBin(ui8 packedBins, const TFeaturePackRef& ref) {
+    return (packedBins >> ref.BitOffset) & ((1 << ref.BitWidth) - 1);
+}
+
 struct TAllFeatures {
     TVector<TVector<ui8>> FloatHistograms; // [featureIdx][doc]
-    // FloatHistograms[featureIdx] might be empty if feature is const.
+    // FloatHistograms[featureIdx] might be empty if feature is const, moved into a bundle or bit-packed.
     TVector<TVector<int>> CatFeaturesRemapped; // [featureIdx][doc]
     TVector<TVector<int>> OneHotValues; // [featureIdx][valueIdx]
     TVector<bool> IsOneHot;
+    TVector<TExclusiveFeatureBundle> FeatureBundles;
+    TVector<TFeatureBundleRef> FloatFeatureBundleRefs; // [featureIdx]; empty when bundling was not performed
+    TVector<TPackedFeatureGroup> FeaturePacks;
+    TVector<TFeaturePackRef> FloatFeaturePackRefs; // [featureIdx]; empty when packing was not performed
+    /*
+     * Per cat feature: the number of remapped value ids present in this dataset (1 + max id)
+     * and how many of its documents carry each id. Precomputed in parallel right after
+     * binarization so online ctr calculation can use the remapped ids directly for simple
+     * projections instead of rebuilding per-value statistics on first use.
+     */
+    TVector<int> CatFeaturesValueCount; // [featureIdx]
+    TVector<TVector<int>> CatFeaturesPerValueCount; // [featureIdx][valueId]
     size_t GetDocCount() const;
-    SAVELOAD(FloatHistograms, CatFeaturesRemapped, OneHotValues, IsOneHot);
+    bool IsBundledFloatFeature(int floatFeatureIdx) const {
+        return !FloatFeatureBundleRefs.empty() && FloatFeatureBundleRefs[floatFeatureIdx].BundleIdx >= 0;
+    }
+    bool IsPackedFloatFeature(int floatFeatureIdx) const {
+        return !FloatFeaturePackRefs.empty() && FloatFeaturePackRefs[floatFeatureIdx].PackIdx >= 0;
+    }
+    SAVELOAD(FloatHistograms, CatFeaturesRemapped, OneHotValues, IsOneHot, FeatureBundles, FloatFeatureBundleRefs,
+             FeaturePacks, FloatFeaturePackRefs, CatFeaturesValueCount, CatFeaturesPerValueCount);
 };
 
 inline int GetDocCount(const TAllFeatures& allFeatures) {
@@ -0,0 +1,88 @@
+#include "doc_pool_data_provider.h"
+
+#include <catboost/libs/helpers/exception.h>
+#include <catboost/libs/quantization_schema/serialization.h>
+#include <catboost/libs/quantized_pool/pool.h>
+#include <catboost/libs/quantized_pool/quantized.h>
+#include <catboost/libs/quantized_pool/serialization.h>
+
+#include <util/generic/vector.h>
+
+
+namespace NCB {
+
+    namespace {
+
+    /*
+     * Reader for pools quantized ahead of time and saved in the quantized pool format.
+     * Chunks of bins are handed to the builder as is, so raw float columns are never
+     * materialized - training on such a pool keeps only one byte per value in memory.
+     * Registered under the "quantized" scheme.
+     */
+    class TCBQuantizedDataProvider : public IDocPoolDataProvider {
+    public:
+        explicit TCBQuantizedDataProvider(TDocPoolDataProviderArgs&& args)
+            : Args(std::move(args))
+        {
+        }
+
+        void Do(IPoolBuilder* poolBuilder) override {
+            TLoadQuantizedPoolParameters loadParameters;
+            loadParameters.LockMemory = false;
+            loadParameters.Precharge = false;
+            const TQuantizedPool pool = LoadQuantizedPool(Args.PoolPath.Path, loadParameters);
+
+            CB_ENSURE(GetCategoricalFeatureIndices(pool).empty(),
+                      "Categorical features are not supported in quantized pools");
+
+            const TPoolMetaInfo poolMetaInfo = GetPoolMetaInfo(pool);
+            TVector<bool> featureIgnored(poolMetaInfo.FeatureCount, false);
+            for (const int featureId : GetIgnoredFeatureIndices(pool)) {
+                featureIgnored[featureId] = true;
+            }
+            for (const int featureId : Args.IgnoredFeatures) {
+                CB_ENSURE(0 <= featureId && featureId < (int)poolMetaInfo.FeatureCount,
+                          "Invalid ignored feature id: " << featureId);
+                featureIgnored[featureId] = true;
+            }
+
+            poolBuilder->SetPoolQuantizationSchema(QuantizationSchemaFromProto(pool.QuantizationSchema));
+            poolBuilder->SetIgnoredFeatures(featureIgnored);
+            poolBuilder->Start(poolMetaInfo, pool.DocumentCount, TVector<int>());
+            poolBuilder->StartNextBlock(pool.DocumentCount);
+
+            const auto columnIndexToFeatureIndex = GetColumnIndexToFeatureIndexMap(pool);
+            size_t baselineIndex = 0;
+            for (const auto& kv : pool.ColumnIndexToLocalIndex) {
+                const auto columnIndex = kv.first;
+                const auto localIndex = kv.second;
+                const auto columnType = pool.ColumnTypes[localIndex];
+
+                if (pool.Chunks[localIndex].empty()) {
+                    continue;
+                }
+
+                const auto featureIndex = columnIndexToFeatureIndex.Value(columnIndex, 0);
+                pool.AddColumn(featureIndex, baselineIndex, columnType, localIndex, poolBuilder);
+
+                baselineIndex += static_cast<size_t>(columnType == EColumn::Baseline);
+            }
+
+            if (Args.PairsFilePath.Inited()) {
+                poolBuilder->SetPairs(ReadPairs(Args.PairsFilePath, pool.DocumentCount));
+            }
+            poolBuilder->Finish();
+        }
+
+        bool DoBlock(IPoolBuilder* /*poolBuilder*/) override {
+            CB_ENSURE(false, "Blockwise processing is not supported for quantized pools");
+        }
+
+    private:
+        TDocPoolDataProviderArgs Args;
+    };
+
+    TDocDataProviderObjectFactory::TRegistrator<TCBQuantizedDataProvider> QuantizedDataProviderReg("quantized");
+
+    }
+}
@@ -1,3 +1,4 @@
+#include <catboost/libs/data/float_parsing.h>
 #include <catboost/libs/data/load_data.h>
 
 #include <library/threading/local_executor/local_executor.h>
@@ -58,4 +59,38 @@ Y_UNIT_TEST_SUITE(TDataLoadTest) {
             }
         }
     }
+
+    Y_UNIT_TEST(TestFastFloatParsing) {
+        float value = 0;
+        UNIT_ASSERT(TryParseFloatFast("0", &value));
+        UNIT_ASSERT_VALUES_EQUAL(value, 0.0f);
+        UNIT_ASSERT(TryParseFloatFast("42", &value));
+        UNIT_ASSERT_VALUES_EQUAL(value, 42.0f);
+        UNIT_ASSERT(TryParseFloatFast("-17.25", &value));
+        UNIT_ASSERT_VALUES_EQUAL(value, -17.25f);
+        UNIT_ASSERT(TryParseFloatFast("+3.5", &value));
+        UNIT_ASSERT_VALUES_EQUAL(value, 3.5f);
+        UNIT_ASSERT(TryParseFloatFast("0.0078125", &value));
+        UNIT_ASSERT_VALUES_EQUAL(value, 0.0078125f);
+
+        TReallyFastRng32 rng(42);
+        for (int i = 0; i < 10000; ++i) {
+            const TString token = ToString(rng.GenRandReal2());
+            if (token.Contains('e')) { // tiny values may be printed in exponent notation
+                continue;
+            }
+            UNIT_ASSERT(TryParseFloatFast(token, &value));
+            UNIT_ASSERT_DOUBLES_EQUAL(value, FromString<float>(token), 1e-7);
+        }
+
+        // everything unusual must be left to the general parser
+        UNIT_ASSERT(!TryParseFloatFast("", &value));
+        UNIT_ASSERT(!TryParseFloatFast("-", &value));
+        UNIT_ASSERT(!TryParseFloatFast(".", &value));
+        UNIT_ASSERT(!TryParseFloatFast("1e-5", &value));
+        UNIT_ASSERT(!TryParseFloatFast("nan", &value));
+        UNIT_ASSERT(!TryParseFloatFast("inf", &value));
+        UNIT_ASSERT(!TryParseFloatFast("1.2.3", &value));
+        UNIT_ASSERT(!TryParseFloatFast("12345678901234567890", &value));
+    }
 }
@@ -0,0 +1,71 @@
+#include <catboost/libs/data/pool_merge.h>
+#include <catboost/libs/helpers/exception.h>
+
+#include <library/unittest/registar.h>
+#include <library/threading/local_executor/local_executor.h>
+
+using namespace NCB;
+
+static TPool MakePool(const TVector<TString>& ids, const TVector<float>& targets, const TVector<TVector<float>>& factors) {
+    TPool pool;
+    pool.Docs.Resize(ids.size(), factors.size());
+    pool.Docs.Id = ids;
+    pool.Docs.Target = targets;
+    for (size_t factorIdx = 0; factorIdx < factors.size(); ++factorIdx) {
+        pool.Docs.Factors[factorIdx] = factors[factorIdx];
+    }
+    pool.MetaInfo.FeatureCount = factors.size();
+    return pool;
+}
+
+Y_UNIT_TEST_SUITE(TPoolMergeTest) {
+    Y_UNIT_TEST(TestInnerJoinKeepsLeftOrder) {
+        NPar::TLocalExecutor localExecutor;
+        localExecutor.RunAdditionalThreads(2);
+
+        const TPool left = MakePool({"a", "b", "c", "d"}, {0.1f, 0.2f, 0.3f, 0.4f}, {{1, 2, 3, 4}});
+        const TPool right = MakePool({"d", "x", "b"}, {1.4f, 0.0f, 1.2f}, {{40, 0, 20}});
+
+        TPoolMergeOptions options;
+        THolder<TPool> merged = MergePoolsById(left, right, options, &localExecutor);
+
+        UNIT_ASSERT_EQUAL(merged->Docs.GetDocCount(), 2);
+        // left order: "b" before "d"; left-only "a", "c" and right-only "x" are dropped
+        UNIT_ASSERT_EQUAL(merged->Docs.Id[0], "b");
+        UNIT_ASSERT_EQUAL(merged->Docs.Id[1], "d");
+        UNIT_ASSERT_EQUAL(merged->Docs.GetEffectiveFactorCount(), 2);
+        UNIT_ASSERT_DOUBLES_EQUAL(merged->Docs.Factors[0][0], 2, 1e-9);
+        UNIT_ASSERT_DOUBLES_EQUAL(merged->Docs.Factors[1][0], 20, 1e-9);
+        UNIT_ASSERT_DOUBLES_EQUAL(merged->Docs.Factors[1][1], 40, 1e-9);
+        // targets stay the left ones unless the refresh option is set
+        UNIT_ASSERT_DOUBLES_EQUAL(merged->Docs.Target[0], 0.2f, 1e-9);
+        UNIT_ASSERT_EQUAL(merged->MetaInfo.FeatureCount, 2);
+    }
+
+    Y_UNIT_TEST(TestTargetRefresh) {
+        NPar::TLocalExecutor localExecutor;
+        localExecutor.RunAdditionalThreads(2);
+
+        const TPool left = MakePool({"a", "b"}, {0.1f, 0.2f}, {{1, 2}});
+        const TPool right = MakePool({"b", "a"}, {1.2f, 1.1f}, {});
+
+        TPoolMergeOptions options;
+        options.TakeTargetFromRight = true;
+        options.AppendRightFactors = false;
+        THolder<TPool> merged = MergePoolsById(left, right, options, &localExecutor);
+
+        UNIT_ASSERT_EQUAL(merged->Docs.GetDocCount(), 2);
+        UNIT_ASSERT_EQUAL(merged->Docs.GetEffectiveFactorCount(), 1);
+        UNIT_ASSERT_DOUBLES_EQUAL(merged->Docs.Target[0], 1.1f, 1e-9);
+        UNIT_ASSERT_DOUBLES_EQUAL(merged->Docs.Target[1], 1.2f, 1e-9);
+    }
+
+    Y_UNIT_TEST(TestDuplicateRightIdFails) {
+        NPar::TLocalExecutor localExecutor;
+
+        const TPool left = MakePool({"a"}, {0.1f}, {{1}});
+        const TPool right = MakePool({"a", "a"}, {1.1f, 2.1f}, {{10, 20}});
+
+        UNIT_ASSERT_EXCEPTION(MergePoolsById(left, right, TPoolMergeOptions(), &localExecutor), TCatboostException);
+    }
+}
@@ -0,0 +1,26 @@
+#include "data_types.h"
+
+namespace NCatboostDistributed {
+
+// Written once during initialization (InitializeMaster on the master, TPlainFoldBuilder on
+// workers) before any stats are serialized, then only read by serialization threads.
+static bool CompressedStatsTransfer = false;
+
+void SetCompressedStatsTransfer(bool enable) {
+    CompressedStatsTransfer = enable;
+}
+
+bool UseCompressedStatsTransfer() {
+    return CompressedStatsTransfer;
+}
+
+NPar::EFloatArrayCodec GetStatsWireCodec() {
+    /* fp16 with the delta+zstd transform: stats are bucket-ordered partial sums whose
+     * neighbours share magnitude, so the planes compress several times beyond the
+     * generic message codec, and the fp16 rounding is absorbed by the double
+     * accumulation on the master.
+     */
+    return NPar::EFloatArrayCodec::Fp16DeltaZstd;
+}
+
+} // NCatboostDistributed
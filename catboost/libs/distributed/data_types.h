@@ -13,6 +13,7 @@
 #include <catboost/libs/options/restrictions.h>
 
 #include <library/binsaver/bin_saver.h>
+#include <library/par/float_codec.h>
 #include <library/par/par.h>
 #include <library/par/par_util.h>
 
@@ -21,8 +22,23 @@
 #include <util/generic/singleton.h>
 
 #define SHARED_ID_TRAIN_DATA                (0xd66d480)
+#define SHARED_ID_APPLY_TASK                (0xd66d580)
 
 namespace NCatboostDistributed {
+
+// Controls the wire format of bucket statistics (see TStats3D::operator&). Set once from the
+// system options during master/worker initialization, before any stats cross the network.
+void SetCompressedStatsTransfer(bool enable);
+bool UseCompressedStatsTransfer();
+
+/* Wire codec declarations for the float-array payloads this layer ships (see
+ * library/par/float_codec.h; every encoded buffer is self-describing, so these only
+ * matter on the sending side). Histogram stats tolerate reduced precision because
+ * receivers accumulate in double, so they pack fp16 deltas; payloads that feed model
+ * values directly must declare a lossless codec.
+ */
+NPar::EFloatArrayCodec GetStatsWireCodec();
+
 template<typename TData>
 struct TEnvelope : public IObjectBase {
     OBJECT_NOCOPY_METHODS(TEnvelope);
@@ -47,7 +63,49 @@ struct TStats3D {
     , MaxLeafCount(maxLeafCount)
     {
     }
-    SAVELOAD(Stats, BucketCount, MaxLeafCount);
+
+    // Stats cross the network once per depth for every split candidate, and on wide pools
+    // this payload dominates depth-synchronization time. With compressed transfer enabled
+    // the sender flattens the components to a float array and packs it with the wire codec
+    // declared for the stats payload; receivers always accumulate in double, so the codec
+    // rounding error stays bounded per worker instead of compounding across the reduction.
+    // A tag byte plus the self-describing codec buffer makes a message parse correctly
+    // regardless of the local settings.
+    int operator&(IBinSaver& f) {
+        ui8 compressed = f.IsReading() ? 0 : static_cast<ui8>(UseCompressedStatsTransfer());
+        f.Add(2, &compressed);
+        if (compressed) {
+            TVector<char> packedStats;
+            if (!f.IsReading()) {
+                TVector<float> wireStats;
+                wireStats.yresize(Stats.ysize() * 4);
+                for (int statsIdx = 0; statsIdx < Stats.ysize(); ++statsIdx) {
+                    wireStats[4 * statsIdx + 0] = static_cast<float>(Stats[statsIdx].SumWeightedDelta);
+                    wireStats[4 * statsIdx + 1] = static_cast<float>(Stats[statsIdx].SumWeight);
+                    wireStats[4 * statsIdx + 2] = static_cast<float>(Stats[statsIdx].SumDelta);
+                    wireStats[4 * statsIdx + 3] = static_cast<float>(Stats[statsIdx].Count);
+                }
+                NPar::CompressFloatArray(GetStatsWireCodec(), wireStats, &packedStats);
+            }
+            f.Add(2, &packedStats);
+            if (f.IsReading()) {
+                TVector<float> wireStats;
+                NPar::DecompressFloatArray(packedStats, &wireStats);
+                Stats.yresize(wireStats.ysize() / 4);
+                for (int statsIdx = 0; statsIdx < Stats.ysize(); ++statsIdx) {
+                    Stats[statsIdx].SumWeightedDelta = wireStats[4 * statsIdx + 0];
+                    Stats[statsIdx].SumWeight = wireStats[4 * statsIdx + 1];
+                    Stats[statsIdx].SumDelta = wireStats[4 * statsIdx + 2];
+                    Stats[statsIdx].Count = wireStats[4 * statsIdx + 3];
+                }
+            }
+        } else {
+            f.Add(2, &Stats);
+        }
+        f.Add(2, &BucketCount);
+        f.Add(2, &MaxLeafCount);
+        return 0;
+    }
 };
 
 using TStats5D = TVector<TVector<TStats3D>>; // [cand][subCand][bodyTail & approxDim][leaf][bucket]
@@ -60,7 +118,10 @@ struct TTrainData : public IObjectBase {
     OBJECT_NOCOPY_METHODS(TTrainData);
 public:
     TTrainData() = default;
-    TTrainData(const ::TDataset& trainData,
+    // Takes the dataset shard by value so that callers can move it in: shards are
+    // pool-sized slices and copying them would double the master's transient memory
+    // while the worker parts are being serialized.
+    TTrainData(::TDataset trainData,
         const TVector<TTargetClassifier>& targetClassifiers,
         const TVector<int>& splitCounts,
         ui64 randomSeed,
@@ -68,7 +129,7 @@ public:
         const TString& stringParams,
         int allDocCount,
         double sumAllWeights)
-    : TrainData(trainData)
+    : TrainData(std::move(trainData))
     , TargetClassifiers(targetClassifiers)
     , SplitCounts(splitCounts)
     , RandomSeed(randomSeed)
@@ -90,6 +151,55 @@ public:
     SAVELOAD(TrainData, TargetClassifiers, SplitCounts, RandomSeed, ApproxDimension, StringParams, AllDocCount, SumAllWeights);
 };
 
+/*
+ * Task for two-phase distributed apply over sharded pools: the master ships the serialized
+ * model and per-worker shard locations once; each worker streams its local shard block by
+ * block through the evaluator, writes predictions to a local file and only completion
+ * stats travel back over the network.
+ */
+struct TApplyShardTask {
+    TString SerializedModel;
+    TVector<TString> WorkerPoolPaths; // [hostId]; a single entry means the same local path on every host
+    TVector<TString> WorkerOutputPaths; // [hostId]; same convention as WorkerPoolPaths
+    TString CdFilePath; // local path on the workers; may be empty
+    bool HasHeader = false;
+    char Delimiter = '\t';
+    EPredictionType PredictionType = EPredictionType::RawFormulaVal;
+    ui32 BlockSize = 65536;
+    ui32 ThreadCount = 1;
+
+    SAVELOAD(SerializedModel, WorkerPoolPaths, WorkerOutputPaths, CdFilePath, HasHeader, Delimiter,
+             PredictionType, BlockSize, ThreadCount);
+};
+
+struct TApplyShardResult {
+    ui64 DocCount = 0;
+    TString ErrorMessage; // empty on success; a failed shard must not lose the other shards' work
+
+    SAVELOAD(DocCount, ErrorMessage);
+};
+
+/*
+ * Sharded training snapshots: at snapshot time every worker persists its fold shard (the
+ * per-document approxes - the only worker state that outlives an iteration) to
+ * worker-local disk, so snapshot IO scales out with the cluster instead of funnelling
+ * every shard through the master. The master's snapshot stays the manifest: a shard is
+ * only usable on recovery if its tree count matches the master's.
+ */
+struct TFoldShardRequest {
+    TString ShardPathPrefix; // local path on the workers, the host id is appended
+    ui64 TreeCount = 0; // trees already applied to the shard's approxes
+
+    SAVELOAD(ShardPathPrefix, TreeCount);
+};
+
+struct TFoldShardStatus {
+    bool Ok = false; // saving: the shard was written; recovery: the local shard was used
+    TString ErrorMessage;
+
+    SAVELOAD(Ok, ErrorMessage);
+};
+
 struct TLocalTensorSearchData {
     Y_DECLARE_SINGLETON_FRIEND();
     // part of TLearnContext used by GreedyTensorSearch
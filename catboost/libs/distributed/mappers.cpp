@@ -1,8 +1,17 @@
 #include "mappers.h"
 
+#include <catboost/libs/algo/apply.h>
 #include <catboost/libs/algo/approx_calcer.h>
 #include <catboost/libs/algo/error_functions.h>
+#include <catboost/libs/data/doc_pool_data_provider.h>
+#include <catboost/libs/data/load_data.h>
+#include <catboost/libs/helpers/compensated_sum.h>
 #include <catboost/libs/helpers/exception.h>
+#include <catboost/libs/model/model.h>
+
+#include <util/stream/file.h>
+#include <util/string/cast.h>
+#include <util/system/fs.h>
 
 namespace NCatboostDistributed {
 void TPlainFoldBuilder::DoMap(NPar::IUserContext* ctx, int hostId, TInput* /*unused*/, TOutput* /*unused*/) const {
@@ -15,6 +24,8 @@ void TPlainFoldBuilder::DoMap(NPar::IUserContext* ctx, int hostId, TInput* /*unu
     const bool jsonParamsOK = ReadJsonTree(trainData->StringParams, &jsonParams);
     Y_ASSERT(jsonParamsOK);
     localData.Params.Load(jsonParams);
+    SetCompressedStatsTransfer(localData.Params.SystemOptions->CompressedStatsTransfer);
+    SetCompensatedAccumulation(localData.Params.SystemOptions->CompensatedAccumulation);
     localData.StoreExpApprox = IsStoreExpApprox(localData.Params.LossFunctionDescription->GetLossFunction());
     plainFold = TFold::BuildPlainFold(trainData->TrainData,
         trainData->TargetClassifiers,
@@ -26,8 +37,9 @@ void TPlainFoldBuilder::DoMap(NPar::IUserContext* ctx, int hostId, TInput* /*unu
         *localData.Rand);
     Y_ASSERT(plainFold.BodyTailArr.ysize() == 1);
     const bool isPairwiseScoring = IsPairwiseScoring(localData.Params.LossFunctionDescription->GetLossFunction());
-    localData.SampledDocs.Create({plainFold}, isPairwiseScoring, GetBernoulliSampleRate(localData.Params.ObliviousTreeOptions->BootstrapConfig));
-    localData.SmallestSplitSideDocs.Create({plainFold}, isPairwiseScoring);
+    const bool singlePrecisionDerivatives = localData.Params.ObliviousTreeOptions->SinglePrecisionDerivatives.Get();
+    localData.SampledDocs.Create({plainFold}, isPairwiseScoring, GetBernoulliSampleRate(localData.Params.ObliviousTreeOptions->BootstrapConfig), singlePrecisionDerivatives);
+    localData.SmallestSplitSideDocs.Create({plainFold}, isPairwiseScoring, /*sampleRate*/ 1.0f, singlePrecisionDerivatives);
     localData.PrevTreeLevelStats.Create({plainFold},
         CountNonCtrBuckets(trainData->SplitCounts, trainData->TrainData.AllFeatures.OneHotValues),
         localData.Params.ObliviousTreeOptions->MaxDepth);
@@ -135,7 +147,7 @@ void TRemoteScoreCalcer::DoMap(NPar::IUserContext* /*ctx*/, int /*hostId*/, TInp
     }
 }
 
-void TLeafIndexSetter::DoMap(NPar::IUserContext* ctx, int hostId, TInput* bestSplitCandidate, TOutput* /*unused*/) const {
+void TLeafIndexSetter::DoMap(NPar::IUserContext* ctx, int hostId, TInput* bestSplitCandidate, TOutput* isLeafEmpty) const {
     const TSplit bestSplit(bestSplitCandidate->Data.SplitCandidate, bestSplitCandidate->Data.BestBinBorderId);
     Y_ASSERT(bestSplit.Type != ESplitType::OnlineCtr);
     auto& localData = TLocalTensorSearchData::GetRef();
@@ -150,10 +162,6 @@ void TLeafIndexSetter::DoMap(NPar::IUserContext* ctx, int hostId, TInput* bestSp
         localData.SampledDocs.UpdateIndices(localData.Indices, &NPar::LocalExecutor());
         localData.SmallestSplitSideDocs.SelectSmallestSplitSide(localData.Depth + 1, localData.SampledDocs, &NPar::LocalExecutor());
     }
-}
-
-void TEmptyLeafFinder::DoMap(NPar::IUserContext* /*ctx*/, int /*hostId*/, TInput* /*unused*/, TOutput* isLeafEmpty) const {
-    auto& localData = TLocalTensorSearchData::GetRef();
     isLeafEmpty->Data = GetIsLeafEmpty(localData.Depth + 1, localData.Indices);
     ++localData.Depth; // tree level completed
 }
@@ -270,6 +278,90 @@ void TApproxUpdater::DoMap(NPar::IUserContext* /*unused*/, int /*unused*/, TInpu
     }
 }
 
+static void ReplayForestOntoApproxes(const ::TDataset& trainData,
+    const TVector<TSplitTree>& treeStructs,
+    const TVector<TVector<TVector<double>>>& leafValues)
+{
+    auto& localData = TLocalTensorSearchData::GetRef();
+    Y_ASSERT(treeStructs.ysize() == leafValues.ysize());
+    auto& bodyTail = localData.PlainFold.BodyTailArr[0];
+    const int approxDimension = localData.PlainFold.GetApproxDimension();
+    for (int treeIdx = 0; treeIdx < treeStructs.ysize(); ++treeIdx) {
+        const TVector<TIndexType> indices = BuildIndices(localData.PlainFold,
+            treeStructs[treeIdx],
+            trainData,
+            /*testDataPtrs*/ {},
+            &NPar::LocalExecutor());
+        TVector<TVector<double>> treeValues = leafValues[treeIdx]; // stored with the learning rate applied
+        for (int dim = 0; dim < approxDimension; ++dim) {
+            if (localData.StoreExpApprox) {
+                UpdateApproxDeltas</*StoreExpApprox*/ true>(indices,
+                    bodyTail.TailFinish,
+                    &NPar::LocalExecutor(),
+                    &treeValues[dim],
+                    &bodyTail.Approx[dim]);
+            } else {
+                UpdateApproxDeltas</*StoreExpApprox*/ false>(indices,
+                    bodyTail.TailFinish,
+                    &NPar::LocalExecutor(),
+                    &treeValues[dim],
+                    &bodyTail.Approx[dim]);
+            }
+        }
+    }
+}
+
+void TApproxReconstructor::DoMap(NPar::IUserContext* ctx, int hostId, TInput* forest, TOutput* /*unused*/) const {
+    NPar::TCtxPtr<TTrainData> trainData(ctx, SHARED_ID_TRAIN_DATA, hostId);
+    ReplayForestOntoApproxes(trainData->TrainData, forest->Data.first, forest->Data.second);
+}
+
+static TString GetFoldShardPath(const TString& pathPrefix, int hostId) {
+    return pathPrefix + ".fold_shard_" + ToString(hostId);
+}
+
+void TFoldShardSaver::DoMap(NPar::IUserContext* /*ctx*/, int hostId, TInput* request, TOutput* status) const {
+    auto& localData = TLocalTensorSearchData::GetRef();
+    const TString path = GetFoldShardPath(request->Data.ShardPathPrefix, hostId);
+    const TString tempPath = path + ".tmp";
+    try {
+        {
+            TOFStream out(tempPath);
+            ::Save(&out, request->Data.TreeCount);
+            localData.PlainFold.SaveApproxes(&out);
+        }
+        // commit atomically, like TProgressHelper does for the master snapshot
+        NFs::Rename(tempPath, path);
+        status->Data.Ok = true;
+    } catch (...) {
+        // report the failure to the master instead of tearing the whole job down
+        status->Data.ErrorMessage = CurrentExceptionMessage();
+        NFs::Remove(tempPath);
+    }
+}
+
+void TFoldShardRestorer::DoMap(NPar::IUserContext* ctx, int hostId, TInput* task, TOutput* status) const {
+    NPar::TCtxPtr<TTrainData> trainData(ctx, SHARED_ID_TRAIN_DATA, hostId);
+    auto& localData = TLocalTensorSearchData::GetRef();
+    // A truncated shard must not leave the approxes half-overwritten: the fresh values are
+    // the replay fallback's starting point.
+    const TVector<TVector<double>> freshApprox = localData.PlainFold.BodyTailArr[0].Approx;
+    try {
+        TIFStream in(GetFoldShardPath(task->Data.Request.ShardPathPrefix, hostId));
+        ui64 treeCount = 0;
+        ::Load(&in, treeCount);
+        CB_ENSURE(treeCount == task->Data.Request.TreeCount,
+            "shard holds " << treeCount << " trees, master snapshot holds " << task->Data.Request.TreeCount);
+        localData.PlainFold.LoadApproxes(&in);
+        status->Data.Ok = true;
+        return;
+    } catch (...) {
+        status->Data.ErrorMessage = CurrentExceptionMessage();
+        localData.PlainFold.BodyTailArr[0].Approx = freshApprox;
+    }
+    ReplayForestOntoApproxes(trainData->TrainData, task->Data.Forest.first, task->Data.Forest.second);
+}
+
 template<typename TError>
 void TDerivativeSetter<TError>::DoMap(NPar::IUserContext* /*ctx*/, int /*hostId*/, TInput* /*unused*/, TOutput* /*unused*/) const {
     auto& localData = TLocalTensorSearchData::GetRef();
@@ -383,6 +475,76 @@ void TDeltaMultiUpdater::DoMap(NPar::IUserContext* /*ctx*/, int /*hostId*/, TInp
     ++localData.GradientIteration; // gradient iteration completed
 }
 
+// Select this worker's entry from a per-host path list; a single entry is shared by all hosts.
+static const TString& GetHostPath(const TVector<TString>& paths, int hostId) {
+    CB_ENSURE(!paths.empty(), "no paths given for distributed apply");
+    if (paths.ysize() == 1) {
+        return paths.front();
+    }
+    CB_ENSURE(hostId < paths.ysize(), "no path given for worker " << hostId);
+    return paths[hostId];
+}
+
+void TModelApplier::DoMap(NPar::IUserContext* /*ctx*/, int hostId, TInput* task, TOutput* result) const {
+    result->DocCount = 0;
+    result->ErrorMessage.clear();
+    try {
+        const TFullModel model = DeserializeModel(task->SerializedModel);
+
+        NPar::TLocalExecutor localExecutor;
+        localExecutor.RunAdditionalThreads(task->ThreadCount - 1);
+
+        NCatboostOptions::TDsvPoolFormatParams dsvPoolFormatParams;
+        dsvPoolFormatParams.Format.HasHeader = task->HasHeader;
+        dsvPoolFormatParams.Format.Delimiter = task->Delimiter;
+        if (!task->CdFilePath.empty()) {
+            dsvPoolFormatParams.CdFilePath = NCB::TPathWithScheme(task->CdFilePath, "dsv");
+        }
+        const NCB::TPathWithScheme poolPath(GetHostPath(task->WorkerPoolPaths, hostId), "dsv");
+
+        TPool poolBlock;
+        THolder<NCB::IPoolBuilder> poolBuilder = NCB::InitBuilder(localExecutor, &poolBlock);
+        auto docPoolDataProvider = NCB::GetProcessor<NCB::IDocPoolDataProvider>(
+            poolPath, // for choosing processor
+
+            // processor args
+            NCB::TDocPoolDataProviderArgs {
+                poolPath,
+                /*PairsFilePath*/ NCB::TPathWithScheme(),
+                dsvPoolFormatParams,
+                /*IgnoredFeatures*/ {},
+                /*ClassNames*/ {},
+                task->BlockSize,
+                &localExecutor
+            }
+        );
+
+        TOFStream output(GetHostPath(task->WorkerOutputPaths, hostId));
+        while (docPoolDataProvider->DoBlock(poolBuilder.Get())) {
+            const TVector<TVector<double>> approx = ApplyModelMulti(model,
+                poolBlock,
+                task->PredictionType,
+                /*begin*/ 0,
+                /*end*/ 0,
+                localExecutor);
+            const size_t docCount = poolBlock.Docs.GetDocCount();
+            for (size_t docIdx = 0; docIdx < docCount; ++docIdx) {
+                for (size_t dim = 0; dim < approx.size(); ++dim) {
+                    if (dim > 0) {
+                        output << '\t';
+                    }
+                    output << approx[dim][docIdx];
+                }
+                output << '\n';
+            }
+            result->DocCount += docCount;
+        }
+    } catch (...) {
+        // report the failure to the master instead of tearing the whole job down
+        result->ErrorMessage = CurrentExceptionMessage();
+    }
+}
+
 } // NCatboostDistributed
 
 using namespace NCatboostDistributed;
@@ -395,7 +557,6 @@ REGISTER_SAVELOAD_NM_CLASS(0xd66d485, NCatboostDistributed, TScoreCalcer);
 REGISTER_SAVELOAD_NM_CLASS(0xd66d585, NCatboostDistributed, TRemoteBinCalcer);
 REGISTER_SAVELOAD_NM_CLASS(0xd66d685, NCatboostDistributed, TRemoteScoreCalcer);
 REGISTER_SAVELOAD_NM_CLASS(0xd66d486, NCatboostDistributed, TLeafIndexSetter);
-REGISTER_SAVELOAD_NM_CLASS(0xd66d487, NCatboostDistributed, TEmptyLeafFinder);
 REGISTER_SAVELOAD_NM_CLASS(0xd66d488, NCatboostDistributed, TCalcApproxStarter);
 REGISTER_SAVELOAD_NM_CLASS(0xd66d489, NCatboostDistributed, TDeltaSimpleUpdater);
 REGISTER_SAVELOAD_NM_CLASS(0xd66d48a, NCatboostDistributed, TApproxUpdater);
@@ -449,3 +610,11 @@ REGISTER_SAVELOAD_TEMPL1_NM_CLASS(0xd66d4bc, NCatboostDistributed, TBucketMultiU
 REGISTER_SAVELOAD_TEMPL1_NM_CLASS(0xd66d4bd, NCatboostDistributed, TBucketMultiUpdater, TCustomError);
 REGISTER_SAVELOAD_TEMPL1_NM_CLASS(0xd66d4be, NCatboostDistributed, TBucketMultiUpdater, TUserDefinedPerObjectError);
 REGISTER_SAVELOAD_TEMPL1_NM_CLASS(0xd66d4bf, NCatboostDistributed, TBucketMultiUpdater, TUserDefinedQuerywiseError);
+REGISTER_SAVELOAD_TEMPL1_NM_CLASS(0xd66d4c0, NCatboostDistributed, TEnvelope, TForest);
+REGISTER_SAVELOAD_NM_CLASS(0xd66d4c1, NCatboostDistributed, TApproxReconstructor);
+REGISTER_SAVELOAD_NM_CLASS(0xd66d4c2, NCatboostDistributed, TModelApplier);
+REGISTER_SAVELOAD_TEMPL1_NM_CLASS(0xd66d4c3, NCatboostDistributed, TEnvelope, TFoldShardRequest);
+REGISTER_SAVELOAD_TEMPL1_NM_CLASS(0xd66d4c4, NCatboostDistributed, TEnvelope, TFoldShardStatus);
+REGISTER_SAVELOAD_TEMPL1_NM_CLASS(0xd66d4c5, NCatboostDistributed, TEnvelope, TFoldShardRecoveryTask);
+REGISTER_SAVELOAD_NM_CLASS(0xd66d4c6, NCatboostDistributed, TFoldShardSaver);
+REGISTER_SAVELOAD_NM_CLASS(0xd66d4c7, NCatboostDistributed, TFoldShardRestorer);
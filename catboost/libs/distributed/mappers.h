@@ -41,13 +41,11 @@ class TRemoteScoreCalcer: public NPar::TMapReduceCmd<TStats4D, TVector<TVector<d
     OBJECT_NOCOPY_METHODS(TRemoteScoreCalcer);
     void DoMap(NPar::IUserContext* ctx, int hostId, TInput* bucketStats, TOutput* scores) const final;
 };
-class TLeafIndexSetter: public NPar::TMapReduceCmd<TEnvelope<TCandidateInfo>, TUnusedInitializedParam> {
+// Applies the chosen split and reports which of the resulting leaves are empty in a single
+// round trip, so each tree level costs one network synchronization instead of two.
+class TLeafIndexSetter: public NPar::TMapReduceCmd<TEnvelope<TCandidateInfo>, TEnvelope<TIsLeafEmpty>> {
     OBJECT_NOCOPY_METHODS(TLeafIndexSetter);
-    void DoMap(NPar::IUserContext* ctx, int hostId, TInput* bestSplitCandidate, TOutput* /*unused*/) const final;
-};
-class TEmptyLeafFinder: public NPar::TMapReduceCmd<TUnusedInitializedParam, TEnvelope<TIsLeafEmpty>> {
-    OBJECT_NOCOPY_METHODS(TEmptyLeafFinder);
-    void DoMap(NPar::IUserContext* /*ctx*/, int /*hostId*/, TInput* /*unused*/, TOutput* isLeafEmpty) const final;
+    void DoMap(NPar::IUserContext* ctx, int hostId, TInput* bestSplitCandidate, TOutput* isLeafEmpty) const final;
 };
 template<typename TError>
 class TBucketSimpleUpdater: public NPar::TMapReduceCmd<TUnusedInitializedParam, TEnvelope<TSums>> {
@@ -66,6 +64,35 @@ class TApproxUpdater: public NPar::TMapReduceCmd<TUnusedInitializedParam, TUnuse
     OBJECT_NOCOPY_METHODS(TApproxUpdater);
     void DoMap(NPar::IUserContext* ctx, int hostId, TInput* /*unused*/, TOutput* /*unused*/) const final;
 };
+using TForest = std::pair<TVector<TSplitTree>, TVector<TVector<TVector<double>>>>; // tree structures and [tree][dim][leaf] values
+// Replays an already-trained forest onto the worker's fold approxes, so a restarted
+// distributed run resumes from the master's snapshot instead of training from scratch.
+// The whole forest arrives in one message; leaf values are stored with the learning rate
+// already applied.
+class TApproxReconstructor: public NPar::TMapReduceCmd<TEnvelope<TForest>, TUnusedInitializedParam> {
+    OBJECT_NOCOPY_METHODS(TApproxReconstructor);
+    void DoMap(NPar::IUserContext* ctx, int hostId, TInput* forest, TOutput* /*unused*/) const final;
+};
+struct TFoldShardRecoveryTask {
+    TFoldShardRequest Request;
+    TForest Forest; // replay fallback; leaf values with the learning rate already applied
+
+    SAVELOAD(Request, Forest);
+};
+// Persists the worker's fold shard to worker-local disk at snapshot time; only the status
+// travels back to the master.
+class TFoldShardSaver: public NPar::TMapReduceCmd<TEnvelope<TFoldShardRequest>, TEnvelope<TFoldShardStatus>> {
+    OBJECT_NOCOPY_METHODS(TFoldShardSaver);
+    void DoMap(NPar::IUserContext* ctx, int hostId, TInput* request, TOutput* status) const final;
+};
+// Restores the shard saved by TFoldShardSaver. A worker whose local shard is missing,
+// truncated or written for a different tree count replays the attached forest onto its
+// fresh approxes instead, so a lost shard degrades only that worker to the old recovery
+// path without corrupting the others.
+class TFoldShardRestorer: public NPar::TMapReduceCmd<TEnvelope<TFoldShardRecoveryTask>, TEnvelope<TFoldShardStatus>> {
+    OBJECT_NOCOPY_METHODS(TFoldShardRestorer);
+    void DoMap(NPar::IUserContext* ctx, int hostId, TInput* task, TOutput* status) const final;
+};
 template<typename TError>
 class TDerivativeSetter: public NPar::TMapReduceCmd<TUnusedInitializedParam, TUnusedInitializedParam> {
     OBJECT_NOCOPY_METHODS(TDerivativeSetter);
@@ -80,5 +107,12 @@ class TDeltaMultiUpdater: public NPar::TMapReduceCmd<TEnvelope<TMultiSums>, TUnu
     OBJECT_NOCOPY_METHODS(TDeltaMultiUpdater);
     void DoMap(NPar::IUserContext* ctx, int hostId, TInput* sums, TOutput* /*unused*/) const final;
 };
+// Two-phase distributed apply: the model arrives once, the worker streams its local pool
+// shard block by block through the evaluator and writes predictions next to the shard, so
+// neither pool data nor predictions ever cross the network.
+class TModelApplier: public NPar::TMapReduceCmd<TApplyShardTask, TApplyShardResult> {
+    OBJECT_NOCOPY_METHODS(TModelApplier);
+    void DoMap(NPar::IUserContext* ctx, int hostId, TInput* task, TOutput* result) const final;
+};
 
 } // NCatboostDistributed
@@ -1,8 +1,10 @@
 #include "master.h"
 #include "mappers.h"
+#include "worker.h"
 
 #include <catboost/libs/algo/error_functions.h>
 #include <catboost/libs/algo/index_calcer.h>
+#include <catboost/libs/helpers/compensated_sum.h>
 #include <catboost/libs/helpers/data_split.h>
 
 #include <library/par/par_settings.h>
@@ -29,12 +31,40 @@ static TVector<TVector<TData>> GetWorkerPart(const TVector<TVector<TData>>& mast
     return workerPart;
 }
 
+static TVector<TExclusiveFeatureBundle> GetWorkerPart(const TVector<TExclusiveFeatureBundle>& bundles, const std::pair<size_t, size_t>& part) {
+    TVector<TExclusiveFeatureBundle> workerPart;
+    workerPart.reserve(bundles.size());
+    for (const auto& bundle : bundles) {
+        TExclusiveFeatureBundle bundlePart;
+        bundlePart.Bins = GetWorkerPart(bundle.Bins, part);
+        bundlePart.FloatFeatures = bundle.FloatFeatures;
+        workerPart.emplace_back(std::move(bundlePart));
+    }
+    return workerPart;
+}
+
+static TVector<TPackedFeatureGroup> GetWorkerPart(const TVector<TPackedFeatureGroup>& packs, const std::pair<size_t, size_t>& part) {
+    TVector<TPackedFeatureGroup> workerPart;
+    workerPart.reserve(packs.size());
+    for (const auto& pack : packs) {
+        TPackedFeatureGroup packPart;
+        packPart.Bins = GetWorkerPart(pack.Bins, part);
+        packPart.FloatFeatures = pack.FloatFeatures;
+        workerPart.emplace_back(std::move(packPart));
+    }
+    return workerPart;
+}
+
 static TAllFeatures GetWorkerPart(const TAllFeatures& allFeatures, const std::pair<size_t, size_t>& part) {
     TAllFeatures workerPart;
     workerPart.FloatHistograms = GetWorkerPart(allFeatures.FloatHistograms, part);
     workerPart.CatFeaturesRemapped = GetWorkerPart(allFeatures.CatFeaturesRemapped, part);
-    workerPart.OneHotValues = GetWorkerPart(allFeatures.OneHotValues, part);
+    workerPart.OneHotValues = allFeatures.OneHotValues; // per-feature value dictionary, not per-document data
     workerPart.IsOneHot = allFeatures.IsOneHot;
+    workerPart.FeatureBundles = GetWorkerPart(allFeatures.FeatureBundles, part);
+    workerPart.FloatFeatureBundleRefs = allFeatures.FloatFeatureBundleRefs;
+    workerPart.FeaturePacks = GetWorkerPart(allFeatures.FeaturePacks, part);
+    workerPart.FloatFeaturePackRefs = allFeatures.FloatFeaturePackRefs;
     return workerPart;
 }
 
@@ -55,7 +85,7 @@ void InitializeMaster(TLearnContext* ctx) {
     Y_ASSERT(ctx->Params.SystemOptions->IsMaster());
     const auto& systemOptions = ctx->Params.SystemOptions;
     const ui32 unusedNodePort = NCatboostOptions::TSystemOptions::GetUnusedNodePort();
-    NPar::TParNetworkSettings::GetRef().RequesterType = NPar::TParNetworkSettings::ERequesterType::NEH; // avoid Netliba
+    NPar::TParNetworkSettings::GetRef().RequesterType = GetRequesterType(systemOptions->NodeTransport);
     ctx->RootEnvironment = NPar::RunMaster(systemOptions->NodePort,
         systemOptions->NumThreads,
         systemOptions->FileWithHosts->c_str(),
@@ -64,6 +94,8 @@ void InitializeMaster(TLearnContext* ctx) {
     const int workerCount = ctx->RootEnvironment->GetSlaveCount();
     const auto& workerMapping = ctx->RootEnvironment->MakeHostIdMapping(workerCount);
     ctx->SharedTrainData = ctx->RootEnvironment->CreateEnvironment(SHARED_ID_TRAIN_DATA, workerMapping);
+    SetCompressedStatsTransfer(systemOptions->CompressedStatsTransfer);
+    SetCompensatedAccumulation(systemOptions->CompensatedAccumulation);
 }
 
 void FinalizeMaster(TLearnContext* ctx) {
@@ -90,6 +122,9 @@ void MapBuildPlainFold(const ::TDataset& trainData, TLearnContext* ctx) {
     NJson::TJsonValue jsonParams;
     ctx->Params.Save(&jsonParams);
     const TString stringParams = ToString(jsonParams);
+    // Build, serialize, and release worker shards strictly one at a time: the shard is moved
+    // into TTrainData and DELETE_RAW_DATA drops it right after serialization, so the master's
+    // transient overhead stays bounded by a single shard instead of several pool-sized copies.
     for (int workerIdx = 0; workerIdx < workerCount; ++workerIdx) {
         ctx->SharedTrainData->SetContextData(workerIdx,
             new NCatboostDistributed::TTrainData(
@@ -106,6 +141,55 @@ void MapBuildPlainFold(const ::TDataset& trainData, TLearnContext* ctx) {
     ApplyMapper<TPlainFoldBuilder>(workerCount, ctx->SharedTrainData);
 }
 
+void MapRestoreApproxFromTreeStruct(TLearnContext* ctx) {
+    Y_ASSERT(ctx->Params.SystemOptions->IsMaster());
+    ApplyMapper<TApproxReconstructor>(ctx->RootEnvironment->GetSlaveCount(),
+        ctx->SharedTrainData,
+        TEnvelope<TForest>(std::make_pair(ctx->LearnProgress.TreeStruct, ctx->LearnProgress.LeafValues)));
+}
+
+void MapSaveFoldShards(TLearnContext* ctx) {
+    Y_ASSERT(ctx->Params.SystemOptions->IsMaster());
+    if (!ctx->OutputOptions.SaveSnapshot()) {
+        return;
+    }
+    const int workerCount = ctx->RootEnvironment->GetSlaveCount();
+    TFoldShardRequest request;
+    request.ShardPathPrefix = ctx->Files.SnapshotFile;
+    request.TreeCount = ctx->LearnProgress.TreeStruct.size();
+    const TVector<TFoldShardSaver::TOutput> statuses
+        = ApplyMapper<TFoldShardSaver>(workerCount, ctx->SharedTrainData, TEnvelope<TFoldShardRequest>(request));
+    for (int workerIdx = 0; workerIdx < workerCount; ++workerIdx) {
+        if (!statuses[workerIdx].Data.Ok) {
+            // not fatal: on recovery this worker falls back to replaying the forest
+            MATRIXNET_WARNING_LOG << "Worker " << workerIdx << " failed to save its fold shard: "
+                << statuses[workerIdx].Data.ErrorMessage << Endl;
+        }
+    }
+}
+
+void MapRestoreFoldShards(TLearnContext* ctx) {
+    Y_ASSERT(ctx->Params.SystemOptions->IsMaster());
+    const int workerCount = ctx->RootEnvironment->GetSlaveCount();
+    TFoldShardRecoveryTask task;
+    task.Request.ShardPathPrefix = ctx->Files.SnapshotFile;
+    task.Request.TreeCount = ctx->LearnProgress.TreeStruct.size();
+    task.Forest = std::make_pair(ctx->LearnProgress.TreeStruct, ctx->LearnProgress.LeafValues);
+    const TVector<TFoldShardRestorer::TOutput> statuses
+        = ApplyMapper<TFoldShardRestorer>(workerCount, ctx->SharedTrainData, TEnvelope<TFoldShardRecoveryTask>(task));
+    int shardCount = 0;
+    for (int workerIdx = 0; workerIdx < workerCount; ++workerIdx) {
+        if (statuses[workerIdx].Data.Ok) {
+            ++shardCount;
+        } else {
+            MATRIXNET_INFO_LOG << "Worker " << workerIdx << " replayed the snapshot forest ("
+                << statuses[workerIdx].Data.ErrorMessage << ")" << Endl;
+        }
+    }
+    MATRIXNET_INFO_LOG << shardCount << " of " << workerCount
+        << " workers restored their local fold shards" << Endl;
+}
+
 void MapTensorSearchStart(TLearnContext* ctx) {
     Y_ASSERT(ctx->Params.SystemOptions->IsMaster());
     ApplyMapper<TTensorSearchStarter>(ctx->RootEnvironment->GetSlaveCount(), ctx->SharedTrainData);
@@ -175,16 +259,17 @@ void MapRemoteCalcScore(double scoreStDev, int /*depth*/, TCandidateList* candid
     }, 0, candidateCount, NPar::TLocalExecutor::WAIT_COMPLETE);
 }
 
-void MapSetIndices(const TCandidateInfo& bestSplitCandidate, TLearnContext* ctx) {
+THolder<NPar::TJobExecutor> MapSetIndices(const TCandidateInfo& bestSplitCandidate, TLearnContext* ctx) {
     Y_ASSERT(ctx->Params.SystemOptions->IsMaster());
     const int workerCount = ctx->RootEnvironment->GetSlaveCount();
-    ApplyMapper<TLeafIndexSetter>(workerCount, ctx->SharedTrainData, TEnvelope<TCandidateInfo>(bestSplitCandidate));
+    return ApplyMapperAsync<TLeafIndexSetter>(workerCount, ctx->SharedTrainData, TEnvelope<TCandidateInfo>(bestSplitCandidate));
 }
 
-int MapGetRedundantSplitIdx(TLearnContext* ctx) {
+int MapGetRedundantSplitIdx(THolder<NPar::TJobExecutor> setIndicesExecutor, TLearnContext* ctx) {
     Y_ASSERT(ctx->Params.SystemOptions->IsMaster());
     const int workerCount = ctx->RootEnvironment->GetSlaveCount();
-    TVector<TEmptyLeafFinder::TOutput> isLeafEmptyFromAllWorkers = ApplyMapper<TEmptyLeafFinder>(workerCount, ctx->SharedTrainData); // poll workers
+    TVector<TLeafIndexSetter::TOutput> isLeafEmptyFromAllWorkers;
+    setIndicesExecutor->GetResultVec(&isLeafEmptyFromAllWorkers);
     for (int workerIdx = 1; workerIdx < workerCount; ++workerIdx) {
         for (int leafIdx = 0; leafIdx < isLeafEmptyFromAllWorkers[0].Data.ysize(); ++leafIdx) {
             isLeafEmptyFromAllWorkers[0].Data[leafIdx] &= isLeafEmptyFromAllWorkers[workerIdx].Data[leafIdx];
@@ -192,3 +277,42 @@ int MapGetRedundantSplitIdx(TLearnContext* ctx) {
     }
     return GetRedundantSplitIdx(isLeafEmptyFromAllWorkers[0].Data);
 }
+
+TVector<TApplyShardResult> MapApplyModelToShards(
+    const TApplyShardTask& task,
+    const TString& fileWithHosts,
+    ui32 nodePort,
+    ui32 numThreads,
+    ENodeTransport transport)
+{
+    NPar::TParNetworkSettings::GetRef().RequesterType = GetRequesterType(transport);
+    const ui32 unusedNodePort = NCatboostOptions::TSystemOptions::GetUnusedNodePort();
+    TObj<NPar::IRootEnvironment> rootEnvironment = NPar::RunMaster(nodePort,
+        numThreads,
+        fileWithHosts.c_str(),
+        unusedNodePort,
+        unusedNodePort);
+    const int workerCount = rootEnvironment->GetSlaveCount();
+    CB_ENSURE(task.WorkerPoolPaths.ysize() == 1 || task.WorkerPoolPaths.ysize() == workerCount,
+              "pool path count " << task.WorkerPoolPaths.ysize() << " does not match worker count " << workerCount);
+    CB_ENSURE(task.WorkerOutputPaths.ysize() == 1 || task.WorkerOutputPaths.ysize() == workerCount,
+              "output path count " << task.WorkerOutputPaths.ysize() << " does not match worker count " << workerCount);
+    const auto& workerMapping = rootEnvironment->MakeHostIdMapping(workerCount);
+    TObj<NPar::IEnvironment> environment = rootEnvironment->CreateEnvironment(SHARED_ID_APPLY_TASK, workerMapping);
+    TVector<TApplyShardResult> results = ApplyMapper<TModelApplier>(workerCount, environment, task);
+    ui64 totalDocCount = 0;
+    int failedWorkerCount = 0;
+    for (int workerIdx = 0; workerIdx < workerCount; ++workerIdx) {
+        if (!results[workerIdx].ErrorMessage.empty()) {
+            ++failedWorkerCount;
+            MATRIXNET_WARNING_LOG << "Worker " << workerIdx << " failed to apply the model: "
+                << results[workerIdx].ErrorMessage << Endl;
+        } else {
+            totalDocCount += results[workerIdx].DocCount;
+        }
+    }
+    MATRIXNET_INFO_LOG << "Applied the model to " << totalDocCount << " documents on "
+        << workerCount - failedWorkerCount << " of " << workerCount << " workers" << Endl;
+    rootEnvironment->Stop();
+    return results;
+}
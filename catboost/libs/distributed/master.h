@@ -10,12 +10,36 @@
 void InitializeMaster(TLearnContext* ctx);
 void FinalizeMaster(TLearnContext* ctx);
 void MapBuildPlainFold(const TDataset& trainData, TLearnContext* ctx);
+void MapRestoreApproxFromTreeStruct(TLearnContext* ctx);
+// Sharded snapshots: each worker writes its fold shard to its own disk next to the
+// configured snapshot path, so snapshot time scales with the largest shard instead of the
+// sum of all of them. Per-worker save failures are logged and tolerated.
+void MapSaveFoldShards(TLearnContext* ctx);
+// Restores worker fold shards from worker-local disk in parallel; a worker without a
+// usable shard replays the snapshot forest instead. Replaces the unconditional
+// MapRestoreApproxFromTreeStruct on the resume path.
+void MapRestoreFoldShards(TLearnContext* ctx);
 void MapTensorSearchStart(TLearnContext* ctx);
 void MapBootstrap(TLearnContext* ctx);
 void MapCalcScore(double scoreStDev, int depth, TCandidateList* candidateList, TLearnContext* ctx);
 void MapRemoteCalcScore(double scoreStDev, int depth, TCandidateList* candidateList, TLearnContext* ctx);
-void MapSetIndices(const TCandidateInfo& bestSplitCandidate, TLearnContext* ctx);
-int MapGetRedundantSplitIdx(TLearnContext* ctx);
+// Launches the split application on all workers and returns without waiting, so the master
+// can do its own per-level bookkeeping while the workers update their indices. Collect the
+// result with MapGetRedundantSplitIdx.
+THolder<NPar::TJobExecutor> MapSetIndices(const TCandidateInfo& bestSplitCandidate, TLearnContext* ctx);
+int MapGetRedundantSplitIdx(THolder<NPar::TJobExecutor> setIndicesExecutor, TLearnContext* ctx);
+/*
+ * Two-phase distributed apply over sharded pools: starts a par master over the hosts file,
+ * broadcasts the task (model included) to every worker, waits for all of them to score their
+ * local shards and returns the per-worker completion stats. Pool data and predictions stay
+ * on the workers; failed shards come back with an error message instead of failing the job.
+ */
+TVector<NCatboostDistributed::TApplyShardResult> MapApplyModelToShards(
+    const NCatboostDistributed::TApplyShardTask& task,
+    const TString& fileWithHosts,
+    ui32 nodePort,
+    ui32 numThreads,
+    ENodeTransport transport);
 template<typename TError>
 void MapSetDerivatives(TLearnContext* ctx);
 template<typename TError>
@@ -24,16 +48,23 @@ template<typename TError>
 void MapSetApproxesMulti(const TSplitTree& splitTree, TLearnContext* ctx);
 
 namespace {
+// Dispatches the job to the workers and returns immediately; the caller collects the results
+// from the executor when it needs them, overlapping master-side work with the round trip.
 template<typename TMapper>
-static TVector<typename TMapper::TOutput> ApplyMapper(int workerCount, TObj<NPar::IEnvironment> environment, const typename TMapper::TInput& value = typename TMapper::TInput()) {
+static THolder<NPar::TJobExecutor> ApplyMapperAsync(int workerCount, TObj<NPar::IEnvironment> environment, const typename TMapper::TInput& value = typename TMapper::TInput()) {
     NPar::TJobDescription job;
     TVector<typename TMapper::TInput> mapperInput(1);
     mapperInput[0] = value;
     NPar::Map(&job, new TMapper(), &mapperInput);
     job.SeparateResults(workerCount);
-    NPar::TJobExecutor exec(&job, environment);
+    return THolder<NPar::TJobExecutor>(new NPar::TJobExecutor(&job, environment));
+}
+
+template<typename TMapper>
+static TVector<typename TMapper::TOutput> ApplyMapper(int workerCount, TObj<NPar::IEnvironment> environment, const typename TMapper::TInput& value = typename TMapper::TInput()) {
+    THolder<NPar::TJobExecutor> exec = ApplyMapperAsync<TMapper>(workerCount, environment, value);
     TVector<typename TMapper::TOutput> mapperOutput;
-    exec.GetResultVec(&mapperOutput);
+    exec->GetResultVec(&mapperOutput);
     return mapperOutput;
 }
 
@@ -95,7 +95,8 @@ TVector<TScoreBin> GetScoreBins(
     TVector<TScoreBin> scoreBin(bucketCount);
     for (int statsIdx = 0; statsIdx * splitStatsCount < bucketStats.ysize(); ++statsIdx) {
         const TBucketStats* stats = GetDataPtr(bucketStats) + statsIdx * splitStatsCount;
-        UpdateScoreBin(stats, leafCount, indexer, splitType, l2Regularizer, /*isPlainMode=*/std::true_type(), sumAllWeights, allDocCount, &scoreBin);
+        // monotone constraints are enforced in single host mode only
+        UpdateScoreBin(stats, leafCount, indexer, splitType, l2Regularizer, /*isPlainMode=*/std::true_type(), sumAllWeights, allDocCount, /*monotoneDirection=*/0, &scoreBin);
     }
     return scoreBin;
 }
@@ -6,7 +6,7 @@
 
 #include <library/par/par_settings.h>
 
-void RunWorker(ui32 numThreads, ui32 nodePort) {
-    NPar::TParNetworkSettings::GetRef().RequesterType = NPar::TParNetworkSettings::ERequesterType::NEH; // avoid Netliba
+void RunWorker(ui32 numThreads, ui32 nodePort, ENodeTransport transport) {
+    NPar::TParNetworkSettings::GetRef().RequesterType = GetRequesterType(transport);
     NPar::RunSlave(numThreads, nodePort);
 }
@@ -1,6 +1,24 @@
 #pragma once
 
+#include <catboost/libs/options/enums.h>
+
+#include <library/par/par_settings.h>
+
 #include <util/system/types.h>
 
-void RunWorker(ui32 numThreads, ui32 nodePort);
+// Maps the configured node transport onto library/par's requester. Netliba rides on the
+// ibverbs RDMA path (registered-memory sends) when an InfiniBand/RoCE port is present;
+// NEH is plain TCP.
+inline NPar::TParNetworkSettings::ERequesterType GetRequesterType(ENodeTransport transport) {
+    switch (transport) {
+        case ENodeTransport::Netliba:
+            return NPar::TParNetworkSettings::ERequesterType::Netliba;
+        case ENodeTransport::AutoDetect:
+            return NPar::TParNetworkSettings::ERequesterType::AutoDetect;
+        default:
+            return NPar::TParNetworkSettings::ERequesterType::NEH;
+    }
+}
+
+void RunWorker(ui32 numThreads, ui32 nodePort, ENodeTransport transport);
 
@@ -109,7 +109,15 @@ TDStrResult GetDocumentImportances(
     EDocumentStrengthType dstrType = FromString<EDocumentStrengthType>(dstrTypeStr);
     EImportanceValuesSign importanceValuesSign = FromString<EImportanceValuesSign>(importanceValuesSignStr);
     TDocumentImportancesEvaluator leafInfluenceEvaluator(model, trainPool, updateMethod, threadCount);
-    const TVector<TVector<double>> documentImportances = leafInfluenceEvaluator.GetDocumentImportances(testPool);
+    // For the Average strength type the result ranks train docs by the absolute
+    // summary importance, so train docs whose importance bound cannot reach the
+    // top can skip the per-test-doc propagation entirely.
+    const bool canPruneByTopSize = dstrType == EDocumentStrengthType::Average
+        && static_cast<size_t>(topSize) < trainPool.Docs.GetDocCount();
+    const TVector<TVector<double>> documentImportances = leafInfluenceEvaluator.GetDocumentImportances(
+        testPool,
+        canPruneByTopSize ? topSize : -1
+    );
     return GetFinalDocumentImportances(documentImportances, dstrType, topSize, importanceValuesSign);
 }
 
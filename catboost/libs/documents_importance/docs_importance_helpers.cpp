@@ -3,7 +3,27 @@
 
 #include <catboost/libs/algo/index_calcer.h>
 
-TVector<TVector<double>> TDocumentImportancesEvaluator::GetDocumentImportances(const TPool& pool) {
+#include <util/generic/queue.h>
+#include <util/system/guard.h>
+#include <util/system/spinlock.h>
+
+// Upper bound of |predicted derivative| for any test doc: each tree/iteration
+// contributes at most its largest absolute leaf derivative.
+static double CalcLeafDerivativesBound(const TVector<TVector<TVector<double>>>& leafDerivatives) {
+    double bound = 0;
+    for (const auto& treeDerivatives : leafDerivatives) {
+        for (const auto& iterationDerivatives : treeDerivatives) {
+            double maxAbsDerivative = 0;
+            for (double derivative : iterationDerivatives) {
+                maxAbsDerivative = Max(maxAbsDerivative, Abs(derivative));
+            }
+            bound += maxAbsDerivative;
+        }
+    }
+    return bound;
+}
+
+TVector<TVector<double>> TDocumentImportancesEvaluator::GetDocumentImportances(const TPool& pool, int topKTrainDocs) {
     NPar::TLocalExecutor localExecutor;
     localExecutor.RunAdditionalThreads(ThreadCount - 1);
 
@@ -16,12 +36,54 @@ TVector<TVector<double>> TDocumentImportancesEvaluator::GetDocumentImportances(c
     UpdateFinalFirstDerivatives(leafIndices, pool);
     TVector<TVector<double>> documentImportances(DocCount, TVector<double>(pool.Docs.GetDocCount()));
 
-    localExecutor.ExecRange([&] (int docId) {
-        // The derivative of leaf values with respect to train doc weight.
-        TVector<TVector<TVector<double>>> leafDerivatives(TreeCount, TVector<TVector<double>>(LeavesEstimationIterations)); // [treeCount][LeavesEstimationIterationsCount][leafCount]
-        UpdateLeavesDerivatives(docId, &leafDerivatives);
-        GetDocumentImportancesForOneTrainDoc(leafDerivatives, leafIndices, &documentImportances[docId]);
-    }, NPar::TLocalExecutor::TExecRangeParams(0, DocCount), NPar::TLocalExecutor::WAIT_COMPLETE);
+    double sumAbsFinalDerivatives = 0;
+    for (double derivative : FinalFirstDerivatives) {
+        sumAbsFinalDerivatives += Abs(derivative);
+    }
+
+    // The smallest confirmed summary score among the current top K candidates.
+    // The threshold only grows, so a stale read can at worst cause an extra
+    // exact computation, never an incorrect prune.
+    TAdaptiveLock topKLock;
+    TPriorityQueue<double, TVector<double>, std::greater<double>> topKScores;
+
+    NPar::TLocalExecutor::TExecRangeParams blockParams(0, DocCount);
+    blockParams.SetBlockCount(ThreadCount);
+    localExecutor.ExecRange([&] (int blockId) {
+        // The derivative of leaf values with respect to train doc weight,
+        // reused for all docs of the block to avoid reallocating the
+        // [treeCount][LeavesEstimationIterationsCount][leafCount] structure per doc.
+        TVector<TVector<TVector<double>>> leafDerivatives(TreeCount, TVector<TVector<double>>(LeavesEstimationIterations));
+        const int blockFirstId = blockId * blockParams.GetBlockSize();
+        const int blockLastId = Min<int>(DocCount, blockFirstId + blockParams.GetBlockSize());
+        for (int docId = blockFirstId; docId < blockLastId; ++docId) {
+            UpdateLeavesDerivatives(docId, &leafDerivatives);
+            if (topKTrainDocs != -1) {
+                const double importanceBound = sumAbsFinalDerivatives * CalcLeafDerivativesBound(leafDerivatives);
+                bool canReachTopK = true;
+                with_lock (topKLock) {
+                    canReachTopK = static_cast<int>(topKScores.size()) < topKTrainDocs || importanceBound >= topKScores.top();
+                }
+                if (!canReachTopK) {
+                    continue;
+                }
+            }
+            GetDocumentImportancesForOneTrainDoc(leafDerivatives, leafIndices, &documentImportances[docId]);
+            if (topKTrainDocs != -1) {
+                double summaryScore = 0;
+                for (double importance : documentImportances[docId]) {
+                    summaryScore += importance;
+                }
+                summaryScore = Abs(summaryScore);
+                with_lock (topKLock) {
+                    topKScores.push(summaryScore);
+                    if (static_cast<int>(topKScores.size()) > topKTrainDocs) {
+                        topKScores.pop();
+                    }
+                }
+            }
+        }
+    }, 0, blockParams.GetBlockCount(), NPar::TLocalExecutor::WAIT_COMPLETE);
     return documentImportances;
 }
 
@@ -60,7 +60,11 @@ public:
     }
 
     // Getting the importance of all train objects for all objects from pool.
-    TVector<TVector<double>> GetDocumentImportances(const TPool& pool);
+    // If topKTrainDocs != -1, only the K train objects with the largest absolute
+    // summary importance are guaranteed to be computed exactly; train objects
+    // whose importance upper bound cannot reach the current top K skip the
+    // per-test-doc propagation and keep zero importances.
+    TVector<TVector<double>> GetDocumentImportances(const TPool& pool, int topKTrainDocs = -1);
 
 private:
     // Evaluate first derivatives at the final approxes
@@ -5,8 +5,10 @@
 
 #include <library/fast_exp/fast_exp.h>
 
+#include <util/generic/algorithm.h>
 #include <util/generic/hash_set.h>
 #include <util/generic/ymath.h>
+#include <util/stream/str.h>
 
 #include <functional>
 
@@ -39,6 +41,29 @@ TVector<double> CalcSigmoid(const TVector<double>& approx) {
     return probabilities;
 }
 
+static TVector<double> CalcSigmoid(const TVector<double>& approx, NPar::TLocalExecutor* localExecutor) {
+    TVector<double> probabilities(approx.size());
+    const int threadCount = localExecutor->GetThreadCount() + 1;
+    const int blockSize = (approx.ysize() + threadCount - 1) / threadCount;
+    auto calcSigmoidInBlock = [&](const int blockId) {
+        const int firstLineId = blockId * blockSize;
+        const int lastLineId = Min(firstLineId + blockSize, approx.ysize());
+        if (firstLineId >= lastLineId) {
+            return;
+        }
+        double* block = probabilities.data() + firstLineId;
+        for (int lineInd = firstLineId; lineInd < lastLineId; ++lineInd) {
+            block[lineInd - firstLineId] = -approx[lineInd];
+        }
+        FastExpInplace(block, lastLineId - firstLineId);
+        for (int lineInd = 0; lineInd < lastLineId - firstLineId; ++lineInd) {
+            block[lineInd] = 1 / (1 + block[lineInd]);
+        }
+    };
+    localExecutor->ExecRange(calcSigmoidInBlock, 0, threadCount, NPar::TLocalExecutor::WAIT_COMPLETE);
+    return probabilities;
+}
+
 static TVector<TVector<double>> CalcSoftmax(const TVector<TVector<double>>& approx, NPar::TLocalExecutor* localExecutor) {
     TVector<TVector<double>> probabilities = approx;
     const int threadCount = localExecutor->GetThreadCount() + 1;
@@ -141,7 +166,7 @@ TVector<TVector<double>> PrepareEval(const EPredictionType predictionType,
             if (IsMulticlass(approx)) {
                 result = CalcSoftmax(approx, localExecutor);
             } else {
-                result = {CalcSigmoid(approx[0])};
+                result = {CalcSigmoid(approx[0], localExecutor)};
             }
             break;
         case EPredictionType::Class:
@@ -165,6 +190,39 @@ TVector<TVector<double>> PrepareEval(const EPredictionType predictionType,
     return result;
 }
 
+void TQueryTopKAccumulator::AddRow(TGroupId queryId, double score, const TString& row) {
+    auto it = QueryTopRows.find(queryId);
+    if (it == QueryTopRows.end()) {
+        QueryOrder.push_back(queryId);
+        it = QueryTopRows.emplace(queryId, TVector<TScoredRow>()).first;
+    }
+    auto& topRows = it->second;
+    // min-heap on score: the root is the weakest kept row and the first to be evicted
+    const auto scoreGreater = [](const TScoredRow& lhs, const TScoredRow& rhs) {
+        return lhs.Score > rhs.Score;
+    };
+    if (topRows.size() < TopSize) {
+        topRows.push_back({score, row});
+        PushHeap(topRows.begin(), topRows.end(), scoreGreater);
+    } else if (score > topRows.front().Score) {
+        PopHeap(topRows.begin(), topRows.end(), scoreGreater);
+        topRows.back() = {score, row};
+        PushHeap(topRows.begin(), topRows.end(), scoreGreater);
+    }
+}
+
+void TQueryTopKAccumulator::Output(IOutputStream* outputStream) const {
+    for (TGroupId queryId : QueryOrder) {
+        TVector<TScoredRow> rows = QueryTopRows.at(queryId);
+        Sort(rows.begin(), rows.end(), [](const TScoredRow& lhs, const TScoredRow& rhs) {
+            return lhs.Score > rhs.Score;
+        });
+        for (const auto& row : rows) {
+            *outputStream << row.Row << '\n';
+        }
+    }
+}
+
 void ValidateColumnOutput(const TVector<TString>& outputColumns,
                           const TPool& pool,
                           bool isPartOfFullTestSet,
@@ -216,6 +274,9 @@ void ValidateColumnOutput(const TVector<TString>& outputColumns,
             continue;
         }
 
+        // raw pool column values are re-read from the source file, which is not line-based
+        // for quantized pools (and their raw float values were never materialized anyway)
+        CB_ENSURE(!pool.IsQuantized(), "Pool column output is not supported for quantized pools");
         if (name[0] == '#') {
             CB_ENSURE(pool.MetaInfo.ColumnsInfo.Defined(),
                       "Non-columnar pool, can't specify column index");
@@ -371,28 +432,116 @@ namespace {
         const TString Header;
     };
 
-    class TEvalPrinter: public IColumnPrinter {
+    /* One output request usually asks for several prediction types over the same raw
+     * values (Probability plus Class plus RawFormulaVal in multi-output batch apply),
+     * and preparing each type separately paid for its own external class mapping and
+     * its own transform pass over the whole approx matrix. The cache computes the
+     * external approx and the probability transform lazily and exactly once, and
+     * serves every requested type from the shared buffers: Class is an argmax
+     * (threshold) pass over the approx and RawFormulaVal is served without a copy.
+     * The returned references stay valid as long as the cache is alive.
+     */
+    class TEvalTransformCache: public TThrRefBase {
     public:
-        TEvalPrinter(
+        TEvalTransformCache(
             NPar::TLocalExecutor* executor,
             const TVector<TVector<TVector<double>>>& rawValues,
+            const TVisibleLabelsHelper& visibleLabelsHelper)
+            : Executor(executor)
+            , RawValues(rawValues)
+            , VisibleLabelsHelper(visibleLabelsHelper)
+            , Iters(rawValues.size()) // never resized, so returned references stay valid
+        {
+        }
+
+        size_t GetEvalIterCount() const {
+            return RawValues.size();
+        }
+
+        const TVector<TVector<double>>& GetApprox(size_t evalIter) {
+            const auto& raws = RawValues[evalIter];
+            CB_ENSURE(VisibleLabelsHelper.IsInitialized() == IsMulticlass(raws),
+                      "Inappropriated usage of visible label helper: it MUST be initialized ONLY for multiclass problem");
+            if (!VisibleLabelsHelper.IsInitialized()) {
+                return raws;
+            }
+            auto& externalApprox = Iters[evalIter].ExternalApprox;
+            if (externalApprox.empty()) {
+                externalApprox = MakeExternalApprox(raws, VisibleLabelsHelper);
+            }
+            return externalApprox;
+        }
+
+        const TVector<TVector<double>>& GetEval(EPredictionType predictionType, size_t evalIter) {
+            switch (predictionType) {
+                case EPredictionType::RawFormulaVal:
+                    return GetApprox(evalIter);
+                case EPredictionType::Probability: {
+                    auto& probability = Iters[evalIter].Probability;
+                    if (probability.empty()) {
+                        const auto& approx = GetApprox(evalIter);
+                        if (IsMulticlass(approx)) {
+                            probability = CalcSoftmax(approx, Executor);
+                        } else {
+                            probability = {CalcSigmoid(approx[0], Executor)};
+                        }
+                    }
+                    return probability;
+                }
+                case EPredictionType::Class: {
+                    auto& classes = Iters[evalIter].Class;
+                    if (classes.empty()) {
+                        const auto& approx = GetApprox(evalIter);
+                        classes.resize(1);
+                        classes[0].reserve(approx[0].size());
+                        if (IsMulticlass(approx)) {
+                            TVector<int> predictions = SelectBestClass(approx, Executor);
+                            classes[0].assign(predictions.begin(), predictions.end());
+                        } else {
+                            for (const double prediction : approx[0]) {
+                                classes[0].push_back(prediction > 0);
+                            }
+                        }
+                    }
+                    return classes;
+                }
+            }
+            Y_UNREACHABLE();
+        }
+
+    private:
+        struct TEvalIterCache {
+            TVector<TVector<double>> ExternalApprox; // only filled when the labels helper remaps classes
+            TVector<TVector<double>> Probability;
+            TVector<TVector<double>> Class;
+        };
+
+        NPar::TLocalExecutor* Executor;
+        const TVector<TVector<TVector<double>>>& RawValues;
+        const TVisibleLabelsHelper& VisibleLabelsHelper;
+        TVector<TEvalIterCache> Iters; // [evalIter]
+    };
+
+    class TEvalPrinter: public IColumnPrinter {
+    public:
+        TEvalPrinter(
+            TIntrusivePtr<TEvalTransformCache> transformCache,
             const EPredictionType predictionType,
             const TVisibleLabelsHelper& visibleLabelsHelper,
             TMaybe<std::pair<size_t, size_t>> evalParameters = TMaybe<std::pair<size_t, size_t>>())
-            : VisibleLabelsHelper(visibleLabelsHelper) {
+            : TransformCache(transformCache)
+            , VisibleLabelsHelper(visibleLabelsHelper) {
             int begin = 0;
-            for (const auto& raws : rawValues) {
-                CB_ENSURE(VisibleLabelsHelper.IsInitialized() == IsMulticlass(raws),
-                          "Inappropriated usage of visible label helper: it MUST be initialized ONLY for multiclass problem");
-                const auto& approx = VisibleLabelsHelper.IsInitialized() ? MakeExternalApprox(raws, VisibleLabelsHelper) : raws;
-                Approxes.push_back(PrepareEval(predictionType, approx, executor));
-                for (int classId = 0; classId < Approxes.back().ysize(); ++classId) {
+            const size_t evalIterCount = TransformCache->GetEvalIterCount();
+            for (size_t evalIter = 0; evalIter < evalIterCount; ++evalIter) {
+                Approxes.push_back(&TransformCache->GetEval(predictionType, evalIter));
+                for (int classId = 0; classId < Approxes.back()->ysize(); ++classId) {
                     TStringBuilder str;
                     str << predictionType;
-                    if (Approxes.back().ysize() > 1) {
+                    if (Approxes.back()->ysize() > 1) {
                         str << ":Class=" << VisibleLabelsHelper.GetVisibleClassNameFromClass(classId);
                     }
-                    if (rawValues.ysize() > 1) {
+                    if (evalIterCount > 1) {
                         str << ":TreesCount=[" << begin << "," << Min(begin + evalParameters->first, evalParameters->second) << ")";
                     }
                     Header.push_back(str);
@@ -405,17 +554,17 @@ namespace {
 
         void OutputValue(IOutputStream* outStream, size_t docIndex) override {
             TString delimiter = "";
-            if (VisibleLabelsHelper.IsInitialized() && Approxes.back().ysize() == 1) { // class labels
-                for (const auto& approxes : Approxes) {
-                    for (const auto& approx : approxes) {
+            if (VisibleLabelsHelper.IsInitialized() && Approxes.back()->ysize() == 1) { // class labels
+                for (const auto* approxes : Approxes) {
+                    for (const auto& approx : *approxes) {
                         *outStream << delimiter
                                    << VisibleLabelsHelper.GetVisibleClassNameFromClass(static_cast<int>(approx[docIndex]));
                         delimiter = "\t";
                     }
                 }
             } else {
-                for (const auto& approxes : Approxes) {
-                    for (const auto& approx : approxes) {
+                for (const auto* approxes : Approxes) {
+                    for (const auto& approx : *approxes) {
                         *outStream << delimiter << approx[docIndex];
                         delimiter = "\t";
                     }
@@ -434,7 +583,8 @@ namespace {
 
     private:
         TVector<TString> Header;
-        TVector<TVector<TVector<double>>> Approxes;
+        TIntrusivePtr<TEvalTransformCache> TransformCache; // keeps the referenced buffers alive
+        TVector<const TVector<TVector<double>>*> Approxes;
         const TVisibleLabelsHelper& VisibleLabelsHelper;
     };
 
@@ -521,7 +671,8 @@ void TEvalResult::OutputToFile(
     std::pair<int, int> testFileWhichOf,
     const TDsvFormatOptions& testSetFormat,
     bool writeHeader,
-    TMaybe<std::pair<size_t, size_t>> evalParameters) {
+    TMaybe<std::pair<size_t, size_t>> evalParameters,
+    TQueryTopKAccumulator* topKAccumulator) {
 
     TFeatureIdToDesc featureIdToDesc = GetFeatureIdToDesc(pool);
 
@@ -531,6 +682,9 @@ void TEvalResult::OutputToFile(
 
     TIntrusivePtr<TPoolColumnsPrinter> poolColumnsPrinter;
 
+    // shared by all prediction-type columns, so each transform runs at most once
+    auto evalTransformCache = MakeIntrusive<TEvalTransformCache>(executor, RawValues, visibleLabelsHelper);
+
     // lazy init
     auto getPoolColumnsPrinter = [&]() {
         /* there's a special case when poolColumnsPrinter can be empty:
@@ -545,7 +699,7 @@ void TEvalResult::OutputToFile(
     for (const auto& columnName : outputColumns) {
         EPredictionType type;
         if (TryFromString<EPredictionType>(columnName, type)) {
-            columnPrinter.push_back(MakeHolder<TEvalPrinter>(executor, RawValues, type, visibleLabelsHelper, evalParameters));
+            columnPrinter.push_back(MakeHolder<TEvalPrinter>(evalTransformCache, type, visibleLabelsHelper, evalParameters));
             continue;
         }
         EColumn outputType;
@@ -626,6 +780,9 @@ void TEvalResult::OutputToFile(
             auto it = featureIdToDesc.find(columnName);
             CB_ENSURE(it != featureIdToDesc.end(),
                       "columnName [" << columnName << "] not found in featureIds");
+            CB_ENSURE(!pool.Docs.Factors[it->second.Index].empty(),
+                      "columnName [" << columnName << "] has no values; "
+                      "it was ignored when the pool was loaded");
             if (it->second.IsCategorical) {
                 columnPrinter.push_back(
                     MakeHolder<TCatFeaturePrinter>(
@@ -654,6 +811,24 @@ void TEvalResult::OutputToFile(
         }
         *outputStream << Endl;
     }
+    if (topKAccumulator != nullptr) {
+        // rows go into the per-query heaps instead of the stream; the scores ranking the
+        // rows are the final raw formula values of the first (only) model dimension
+        CB_ENSURE(!pool.Docs.QueryId.empty(), "top-K per query output requires query ids in the pool");
+        const TVector<double>& scores = RawValues.back()[0];
+        TStringStream rowStream;
+        for (size_t docId = 0; docId < pool.Docs.GetDocCount(); ++docId) {
+            rowStream.Clear();
+            TString delimiter = "";
+            for (auto& printer : columnPrinter) {
+                rowStream << delimiter;
+                printer->OutputValue(&rowStream, docId);
+                delimiter = printer->GetAfterColumnDelimiter();
+            }
+            topKAccumulator->AddRow(pool.Docs.QueryId[docId], scores[docId], rowStream.Str());
+        }
+        return;
+    }
     for (size_t docId = 0; docId < pool.Docs.GetDocCount(); ++docId) {
         TString delimiter = "";
         for (auto& printer : columnPrinter) {
@@ -665,6 +840,82 @@ void TEvalResult::OutputToFile(
     }
 }
 
+void TEvalResult::OutputBinaryToFile(
+    NPar::TLocalExecutor* executor,
+    const TVector<EPredictionType>& predictionTypes,
+    const TVisibleLabelsHelper& visibleLabelsHelper,
+    IOutputStream* outputStream,
+    const TString& schemaPath,
+    TMaybe<std::pair<size_t, size_t>> evalParameters) {
+
+    auto transformCache = MakeIntrusive<TEvalTransformCache>(executor, RawValues, visibleLabelsHelper);
+    TVector<const TVector<double>*> columns; // [column][docIdx]; the buffers are owned by the cache
+    TVector<TString> headers;
+    for (const auto predictionType : predictionTypes) {
+        int begin = 0;
+        for (size_t evalIter = 0; evalIter < transformCache->GetEvalIterCount(); ++evalIter) {
+            const auto& prepared = transformCache->GetEval(predictionType, evalIter);
+            for (int classId = 0; classId < prepared.ysize(); ++classId) {
+                TStringBuilder str;
+                str << predictionType;
+                if (prepared.ysize() > 1) {
+                    str << ":Class=" << visibleLabelsHelper.GetVisibleClassNameFromClass(classId);
+                }
+                if (RawValues.ysize() > 1) {
+                    str << ":TreesCount=[" << begin << "," << Min(begin + evalParameters->first, evalParameters->second) << ")";
+                }
+                headers.push_back(str);
+                columns.push_back(&prepared[classId]);
+            }
+            if (evalParameters) {
+                begin += evalParameters->first;
+            }
+        }
+    }
+
+    if (!schemaPath.empty()) {
+        TOFStream schemaStream(schemaPath);
+        schemaStream << "format\tdouble,little-endian,row-major" << Endl;
+        for (const auto& header : headers) {
+            schemaStream << "column\t" << header << Endl;
+        }
+    }
+
+    const size_t columnCount = columns.size();
+    const size_t docCount = columnCount > 0 ? columns[0]->size() : 0;
+    if (docCount == 0) {
+        return;
+    }
+
+    /* Each thread interleaves its document range from the column-major
+     * prediction vectors into a private row-major buffer; buffers are then
+     * flushed sequentially so documents stay in pool order. Doubles are
+     * written in host byte order: all supported platforms are little-endian.
+     */
+    const int threadCount = executor->GetThreadCount() + 1;
+    const size_t blockSize = (docCount + threadCount - 1) / threadCount;
+    TVector<TVector<double>> packedBlocks(threadCount);
+    auto packBlock = [&](const int blockId) {
+        const size_t firstDoc = blockId * blockSize;
+        const size_t lastDoc = Min(firstDoc + blockSize, docCount);
+        if (firstDoc >= lastDoc) {
+            return;
+        }
+        TVector<double>& packed = packedBlocks[blockId];
+        packed.yresize((lastDoc - firstDoc) * columnCount);
+        size_t offset = 0;
+        for (size_t docId = firstDoc; docId < lastDoc; ++docId) {
+            for (size_t column = 0; column < columnCount; ++column) {
+                packed[offset++] = (*columns[column])[docId];
+            }
+        }
+    };
+    executor->ExecRange(packBlock, 0, threadCount, NPar::TLocalExecutor::WAIT_COMPLETE);
+    for (const auto& packed : packedBlocks) {
+        outputStream->Write(packed.data(), packed.size() * sizeof(double));
+    }
+}
+
 void TEvalResult::OutputToFile(
     int threadCount,
     const TVector<TString>& outputColumns,
@@ -10,6 +10,7 @@
 #include <library/threading/local_executor/local_executor.h>
 
 #include <util/string/builder.h>
+#include <util/generic/hash.h>
 #include <util/generic/vector.h>
 #include <util/generic/map.h>
 #include <util/generic/maybe.h>
@@ -19,6 +20,11 @@
 #include <util/string/iterator.h>
 #include <util/string/cast.h>
 
+enum class EEvalOutputFormat {
+    Dsv,    // tab-separated text, one formatted column per prediction
+    Binary  // packed row-major doubles plus a text schema sidecar
+};
+
 void CalcSoftmax(const TVector<double>& approx, TVector<double>* softmax);
 
 TVector<double> CalcSigmoid(const TVector<double>& approx);
@@ -38,6 +44,33 @@ void ValidateColumnOutput(const TVector<TString>& outputColumns,
                           bool isPartOfFullTestSet=false,
                           bool CV_mode=false);
 
+/* Per-query top-K filter for ranking output: formatted rows are accumulated into bounded
+ * per-query heaps during blocked apply (a query may span block boundaries) and written
+ * out once at the end - each query's K best-scoring rows in descending score order,
+ * queries in the order they first appear in the pool. Replaces the external
+ * sort-and-truncate job over the full text output.
+ */
+class TQueryTopKAccumulator {
+public:
+    explicit TQueryTopKAccumulator(size_t topSize)
+        : TopSize(topSize)
+    {
+    }
+
+    void AddRow(TGroupId queryId, double score, const TString& row);
+    void Output(IOutputStream* outputStream) const;
+
+private:
+    struct TScoredRow {
+        double Score;
+        TString Row;
+    };
+
+    size_t TopSize;
+    TVector<TGroupId> QueryOrder; // queries in first-seen order
+    THashMap<TGroupId, TVector<TScoredRow>> QueryTopRows; // min-heap on Score, at most TopSize rows
+};
+
 class TEvalResult {
 public:
     TEvalResult() {
@@ -61,6 +94,21 @@ public:
         std::pair<int, int> testFileWhichOf,
         const NCB::TDsvFormatOptions& testSetFormat,
         bool writeHeader = true,
+        TMaybe<std::pair<size_t, size_t>> evalParameters = TMaybe<std::pair<size_t, size_t>>(),
+        TQueryTopKAccumulator* topKAccumulator = nullptr); // divert rows into per-query heaps instead of the stream
+    /* Append predictions as packed binary doubles, row-major: all prediction
+     * columns of a document are laid out contiguously, so blocks of a pool
+     * processed in sequence concatenate into one valid file. Packing runs in
+     * parallel over document ranges; buffers are flushed in document order.
+     * If schemaPath is non-empty, a text sidecar describing the columns is
+     * written (pass it for the first block only).
+     */
+    void OutputBinaryToFile(
+        NPar::TLocalExecutor* executor,
+        const TVector<EPredictionType>& predictionTypes,
+        const TVisibleLabelsHelper& visibleLabelsHelper,
+        IOutputStream* outputStream,
+        const TString& schemaPath = TString(),
         TMaybe<std::pair<size_t, size_t>> evalParameters = TMaybe<std::pair<size_t, size_t>>());
     void OutputToFile(
         int threadCount,
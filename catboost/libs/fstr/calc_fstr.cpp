@@ -79,7 +79,7 @@ TVector<TMxTree> BuildMatrixnetTrees(const TFullModel& model, TVector<TFeature>*
     return BuildTrees(featureToIdx, model);
 }
 
-TVector<std::pair<double, TFeature>> CalcFeatureEffect(const TFullModel& model, const TPool* pool) {
+TVector<std::pair<double, TFeature>> CalcFeatureEffect(const TFullModel& model, const TPool* pool, int threadCount) {
     if (model.GetTreeCount() == 0) {
         return TVector<std::pair<double, TFeature>>();
     }
@@ -93,7 +93,9 @@ TVector<std::pair<double, TFeature>> CalcFeatureEffect(const TFullModel& model,
         CB_ENSURE(pool->Docs.GetDocCount() != 0, "no docs in pool");
         CB_ENSURE(pool->Docs.GetEffectiveFactorCount() > 0, "no features in pool");
 
-        leavesStatisticsOnPool = CollectLeavesStatistics(*pool, model);
+        NPar::TLocalExecutor localExecutor;
+        localExecutor.RunAdditionalThreads(threadCount - 1);
+        leavesStatisticsOnPool = CollectLeavesStatistics(*pool, model, &localExecutor);
     }
 
     TVector<TFeature> features;
@@ -169,10 +171,10 @@ TVector<TFeatureEffect> CalcRegularFeatureEffect(const TVector<std::pair<double,
     return regularFeatureEffect;
 }
 
-TVector<double> CalcRegularFeatureEffect(const TFullModel& model, const TPool* pool) {
+TVector<double> CalcRegularFeatureEffect(const TFullModel& model, const TPool* pool, int threadCount) {
     TFeaturesLayout layout(model.ObliviousTrees.FloatFeatures, model.ObliviousTrees.CatFeatures);
 
-    TVector<TFeatureEffect> regularEffect = CalcRegularFeatureEffect(CalcFeatureEffect(model, pool),
+    TVector<TFeatureEffect> regularEffect = CalcRegularFeatureEffect(CalcFeatureEffect(model, pool, threadCount),
                                                                      model.GetNumCatFeatures(),
                                                                      model.GetNumFloatFeatures());
 
@@ -278,11 +280,11 @@ TString TFeature::BuildDescription(const TFeaturesLayout& layout) const {
     return result;
 }
 
-static TVector<TVector<double>> CalcFstr(const TFullModel& model, const TPool* pool){
+static TVector<TVector<double>> CalcFstr(const TFullModel& model, const TPool* pool, int threadCount){
     CB_ENSURE(!model.ObliviousTrees.LeafWeights.empty() || (pool != nullptr),
               "CalcFstr requires either non-empty LeafWeights in model or provided dataset");
 
-    TVector<double> regularEffect = CalcRegularFeatureEffect(model, pool);
+    TVector<double> regularEffect = CalcRegularFeatureEffect(model, pool, threadCount);
     TVector<TVector<double>> result;
     for (const auto& value : regularEffect){
         TVector<double> vec = {value};
@@ -328,7 +330,7 @@ TVector<TVector<double>> GetFeatureImportances(const TString& type,
 
     switch (FstrType) {
         case EFstrType::FeatureImportance:
-            return CalcFstr(model, pool);
+            return CalcFstr(model, pool, threadCount);
         case EFstrType::Interaction:
             return CalcInteraction(model);
         case EFstrType::ShapValues: {
@@ -88,10 +88,10 @@ struct TInternalFeatureInteraction {
         , SecondFeature(secondFeature) {}
 };
 
-TVector<std::pair<double, TFeature>> CalcFeatureEffect(const TFullModel& model, const TPool* pool);
+TVector<std::pair<double, TFeature>> CalcFeatureEffect(const TFullModel& model, const TPool* pool, int threadCount = 1);
 TVector<TFeatureEffect> CalcRegularFeatureEffect(const TVector<std::pair<double, TFeature>>& effect,
                                                  int catFeaturesCount, int floatFeaturesCount);
-TVector<double> CalcRegularFeatureEffect(const TFullModel& model, const TPool* pool);
+TVector<double> CalcRegularFeatureEffect(const TFullModel& model, const TPool* pool, int threadCount = 1);
 
 TVector<TInternalFeatureInteraction> CalcInternalFeatureInteraction(const TFullModel& model);
 TVector<TFeatureInteraction> CalcFeatureInteraction(const TVector<TInternalFeatureInteraction>& internalFeatureInteraction,
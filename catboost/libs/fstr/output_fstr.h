@@ -68,10 +68,11 @@ inline void OutputFeatureImportanceMatrix(const TVector<TVector<double>>& featur
 inline void CalcAndOutputFstr(const TFullModel& model,
                               const TPool* pool,
                               const TString* regularFstrPath,
-                              const TString* internalFstrPath) {
+                              const TString* internalFstrPath,
+                              int threadCount = 1) {
     TFeaturesLayout layout(model.ObliviousTrees.FloatFeatures, model.ObliviousTrees.CatFeatures);
 
-    TVector<std::pair<double, TFeature>> internalEffect = CalcFeatureEffect(model, pool);
+    TVector<std::pair<double, TFeature>> internalEffect = CalcFeatureEffect(model, pool, threadCount);
     if (internalFstrPath != nullptr && !internalFstrPath->empty()) {
         OutputFstr(layout, internalEffect, *internalFstrPath);
     }
@@ -6,6 +6,9 @@
 #include <catboost/libs/logging/profile_info.h>
 
 #include <util/generic/algorithm.h>
+#include <util/random/fast.h>
+#include <util/random/shuffle.h>
+#include <util/stream/str.h>
 
 namespace {
     struct TFeaturePathElement {
@@ -24,19 +27,6 @@ namespace {
         {
         }
     };
-
-    struct TShapValue {
-        int Feature;
-        TVector<double> Value;
-
-        TShapValue() = default;
-
-        TShapValue(int feature, int approxDimension)
-            : Feature(feature)
-            , Value(approxDimension)
-        {
-        }
-    };
 } //anonymous
 
 static TVector<TFeaturePathElement> ExtendFeaturePath(
@@ -356,11 +346,13 @@ static void CalcShapValuesForDocumentBlock(
     const TFullModel& model,
     const TPool& pool,
     NPar::TLocalExecutor& localExecutor,
+    const TVector<size_t>& treeIndices,
     const TVector<TVector<TVector<TShapValue>>>& shapValuesByLeafForAllTrees,
     const TVector<TVector<double>>& meanValuesForAllTrees,
     size_t start,
     size_t end,
-    TVector<TVector<double>>* shapValuesForAllDocuments
+    TVector<TVector<double>>* shapValuesForAllDocuments,
+    TVector<TVector<double>>* shapValueVariances
 ) {
     const TObliviousTrees& forest = model.ObliviousTrees;
     const size_t documentCount = end - start;
@@ -369,29 +361,164 @@ static void CalcShapValuesForDocumentBlock(
 
     const int flatFeatureCount = pool.Docs.GetEffectiveFactorCount();
 
+    const size_t totalTreeCount = forest.GetTreeCount();
+    const size_t sampledTreeCount = treeIndices.size();
+    // Every sampled tree's contribution is scaled by the inverse sampling fraction,
+    // which keeps the estimate unbiased for any subset of trees.
+    const double treeWeight = static_cast<double>(totalTreeCount) / sampledTreeCount;
+
     const int oldShapValuesSize = shapValuesForAllDocuments->size();
     shapValuesForAllDocuments->resize(oldShapValuesSize + end - start);
+    if (shapValueVariances != nullptr) {
+        shapValueVariances->resize(oldShapValuesSize + end - start);
+    }
 
     NPar::TLocalExecutor::TExecRangeParams blockParams(0, documentCount);
     localExecutor.ExecRange([&] (size_t documentIdx) {
         const int approxDimension = forest.ApproxDimension;
+        const int valuesCount = approxDimension * (flatFeatureCount + 1);
         TVector<double>& shapValues = (*shapValuesForAllDocuments)[oldShapValuesSize + documentIdx];
-        shapValues.assign(approxDimension * (flatFeatureCount + 1), 0.0);
+        shapValues.assign(valuesCount, 0.0);
+        TVector<double> valueSquareSums;
+        if (shapValueVariances != nullptr) {
+            valueSquareSums.assign(valuesCount, 0.0);
+        }
 
         TVector<ui8> binarizedFeatures = GetBinarizedFeaturesForDocument(binarizedFeaturesForDocumentBlock, documentCount, documentIdx);
 
-        const size_t treeCount = forest.GetTreeCount();
-        for (size_t treeIdx = 0; treeIdx < treeCount; ++treeIdx) {
+        for (size_t treeIdx : treeIndices) {
             size_t leafIdx = CalcLeafToFallForDocument(forest, treeIdx, binarizedFeatures);
             for (const TShapValue& shapValue : shapValuesByLeafForAllTrees[treeIdx][leafIdx]) {
                 for (int dimension = 0; dimension < approxDimension; ++dimension) {
-                    shapValues[dimension * (flatFeatureCount + 1) + shapValue.Feature]
-                        += shapValue.Value[dimension];
+                    const double value = shapValue.Value[dimension];
+                    shapValues[dimension * (flatFeatureCount + 1) + shapValue.Feature] += value;
+                    if (shapValueVariances != nullptr) {
+                        valueSquareSums[dimension * (flatFeatureCount + 1) + shapValue.Feature] += value * value;
+                    }
+                }
+            }
+            for (int dimension = 0; dimension < approxDimension; ++dimension) {
+                const double value = meanValuesForAllTrees[treeIdx][dimension];
+                shapValues[dimension * (flatFeatureCount + 1) + flatFeatureCount] += value;
+                if (shapValueVariances != nullptr) {
+                    valueSquareSums[dimension * (flatFeatureCount + 1) + flatFeatureCount] += value * value;
+                }
+            }
+        }
+
+        if (shapValueVariances != nullptr) {
+            // Variance of the scaled sum under sampling without replacement:
+            // treeCount * (treeCount - sampledCount) / sampledCount * s^2,
+            // where s^2 is the sample variance of per tree contributions.
+            TVector<double>& variances = (*shapValueVariances)[oldShapValuesSize + documentIdx];
+            variances.assign(valuesCount, 0.0);
+            if (sampledTreeCount > 1 && sampledTreeCount < totalTreeCount) {
+                const double varianceCoefficient
+                    = static_cast<double>(totalTreeCount) * (totalTreeCount - sampledTreeCount) / sampledTreeCount;
+                for (int valueIdx = 0; valueIdx < valuesCount; ++valueIdx) {
+                    const double sampleVariance
+                        = (valueSquareSums[valueIdx] - shapValues[valueIdx] * shapValues[valueIdx] / sampledTreeCount)
+                        / (sampledTreeCount - 1);
+                    variances[valueIdx] = varianceCoefficient * Max(sampleVariance, 0.0);
+                }
+            }
+        }
+        if (sampledTreeCount != totalTreeCount) {
+            for (auto& value : shapValues) {
+                value *= treeWeight;
+            }
+        }
+    }, blockParams, NPar::TLocalExecutor::WAIT_COMPLETE);
+}
+
+// [depth][nodeIdx * approxDimension + dim]: weighted mean leaf value of the subtree fixed by
+// the first depth split decisions; the entry at depth 0 is the tree mean.
+static TVector<TVector<double>> CalcSubtreeValuesForTree(
+    const TObliviousTrees& forest,
+    const TVector<TVector<double>>& subtreeWeights,
+    size_t treeIdx
+) {
+    const int approxDimension = forest.ApproxDimension;
+    const int treeDepth = forest.TreeSizes[treeIdx];
+    auto firstLeafPtr = forest.GetFirstLeafPtrForTree(treeIdx);
+
+    TVector<TVector<double>> subtreeValues(treeDepth + 1);
+    subtreeValues[treeDepth].assign(firstLeafPtr, firstLeafPtr + (size_t(1) << treeDepth) * approxDimension);
+
+    for (int depth = treeDepth - 1; depth >= 0; --depth) {
+        const size_t nodeCount = size_t(1) << depth;
+        subtreeValues[depth].assign(nodeCount * approxDimension, 0.0);
+        for (size_t nodeIdx = 0; nodeIdx < nodeCount; ++nodeIdx) {
+            const size_t goNodeIdx = nodeIdx;
+            const size_t skipNodeIdx = nodeIdx | (size_t(1) << depth);
+            const double weight = subtreeWeights[depth][nodeIdx];
+            if (FuzzyEquals(weight, 0.0)) {
+                // No training document falls here; zero means keep the telescoping sum
+                // over any document path equal to the leaf value at the bottom level.
+                continue;
+            }
+            for (int dimension = 0; dimension < approxDimension; ++dimension) {
+                subtreeValues[depth][nodeIdx * approxDimension + dimension]
+                    = (subtreeValues[depth + 1][goNodeIdx * approxDimension + dimension] * subtreeWeights[depth + 1][goNodeIdx]
+                     + subtreeValues[depth + 1][skipNodeIdx * approxDimension + dimension] * subtreeWeights[depth + 1][skipNodeIdx])
+                    / weight;
+            }
+        }
+    }
+    return subtreeValues;
+}
+
+static void CalcFeatureContributionsForDocumentBlock(
+    const TFullModel& model,
+    const TPool& pool,
+    NPar::TLocalExecutor& localExecutor,
+    const TVector<int>& binFeatureCombinationClass,
+    const TVector<TVector<int>>& combinationClassFeatures,
+    const TVector<TVector<TVector<double>>>& subtreeValuesForAllTrees,
+    size_t start,
+    size_t end,
+    TVector<TVector<double>>* contributionsForAllDocuments
+) {
+    const TObliviousTrees& forest = model.ObliviousTrees;
+    const size_t documentCount = end - start;
+
+    TVector<ui8> binarizedFeaturesForDocumentBlock = BinarizeFeatures(model, pool, start, end);
+
+    const int flatFeatureCount = pool.Docs.GetEffectiveFactorCount();
+
+    const int oldContributionsSize = contributionsForAllDocuments->size();
+    contributionsForAllDocuments->resize(oldContributionsSize + documentCount);
+
+    NPar::TLocalExecutor::TExecRangeParams blockParams(0, documentCount);
+    localExecutor.ExecRange([&] (size_t documentIdx) {
+        const int approxDimension = forest.ApproxDimension;
+        TVector<double>& contributions = (*contributionsForAllDocuments)[oldContributionsSize + documentIdx];
+        contributions.assign(approxDimension * (flatFeatureCount + 1), 0.0);
+
+        TVector<ui8> binarizedFeatures = GetBinarizedFeaturesForDocument(binarizedFeaturesForDocumentBlock, documentCount, documentIdx);
+
+        for (size_t treeIdx = 0; treeIdx < forest.GetTreeCount(); ++treeIdx) {
+            const size_t leafIdx = CalcLeafToFallForDocument(forest, treeIdx, binarizedFeatures);
+            const TVector<TVector<double>>& subtreeValues = subtreeValuesForAllTrees[treeIdx];
+
+            for (int depth = 0; depth < forest.TreeSizes[treeIdx]; ++depth) {
+                const size_t nodeIdx = leafIdx & ((size_t(1) << depth) - 1);
+                const size_t goNodeIdx = leafIdx & ((size_t(1) << (depth + 1)) - 1);
+
+                const TRepackedBin& split = forest.GetRepackedBins()[forest.TreeStartOffsets[treeIdx] + depth];
+                const TVector<int>& flatFeatures = combinationClassFeatures[binFeatureCombinationClass[split.FeatureIndex]];
+
+                for (int dimension = 0; dimension < approxDimension; ++dimension) {
+                    const double delta = subtreeValues[depth + 1][goNodeIdx * approxDimension + dimension]
+                                       - subtreeValues[depth][nodeIdx * approxDimension + dimension];
+                    // Ctr combinations attribute to several flat features; split the delta evenly.
+                    for (int flatFeatureIdx : flatFeatures) {
+                        contributions[dimension * (flatFeatureCount + 1) + flatFeatureIdx] += delta / flatFeatures.size();
+                    }
                 }
             }
             for (int dimension = 0; dimension < approxDimension; ++dimension) {
-                shapValues[dimension * (flatFeatureCount + 1) + flatFeatureCount]
-                    += meanValuesForAllTrees[treeIdx][dimension];
+                contributions[dimension * (flatFeatureCount + 1) + flatFeatureCount] += subtreeValues[0][dimension];
             }
         }
     }, blockParams, NPar::TLocalExecutor::WAIT_COMPLETE);
@@ -400,6 +527,7 @@ static void CalcShapValuesForDocumentBlock(
 static void CalcShapValuesByLeafForTreeBlock(
     const TObliviousTrees& forest,
     const TVector<TVector<double>>& leafWeights,
+    const TVector<size_t>& treeIndices,
     NPar::TLocalExecutor& localExecutor,
     int start,
     int end,
@@ -411,7 +539,8 @@ static void CalcShapValuesByLeafForTreeBlock(
     MapBinFeaturesToClasses(forest, &binFeatureCombinationClass, &combinationClassFeatures);
 
     NPar::TLocalExecutor::TExecRangeParams blockParams(start, end);
-    localExecutor.ExecRange([&] (size_t treeIdx) {
+    localExecutor.ExecRange([&] (size_t positionIdx) {
+        const size_t treeIdx = treeIndices[positionIdx];
         const size_t leafCount = (size_t(1) << forest.TreeSizes[treeIdx]);
         TVector<TVector<TShapValue>>& shapValuesByLeaf = (*shapValuesByLeafForAllTrees)[treeIdx];
         shapValuesByLeaf.resize(leafCount);
@@ -427,9 +556,9 @@ static void CalcShapValuesByLeafForTreeBlock(
                 treeIdx,
                 subtreeWeights,
                 &shapValuesByLeaf[leafIdx]);
-
-            (*meanValuesForAllTrees)[treeIdx] = CalcMeanValueForTree(forest, subtreeWeights, treeIdx);
         }
+
+        (*meanValuesForAllTrees)[treeIdx] = CalcMeanValueForTree(forest, subtreeWeights, treeIdx);
     }, blockParams, NPar::TLocalExecutor::WAIT_COMPLETE);
 }
 
@@ -446,6 +575,7 @@ static void WarnForComplexCtrs(const TObliviousTrees& forest) {
 static void PrepareTrees(
     const TFullModel& model,
     const TPool& pool,
+    const TVector<size_t>& treeIndices,
     NPar::TLocalExecutor& localExecutor,
     int logPeriod,
     TVector<TVector<TVector<TShapValue>>>* shapValuesByLeafForAllTrees,
@@ -453,7 +583,7 @@ static void PrepareTrees(
 ) {
     WarnForComplexCtrs(model.ObliviousTrees);
 
-    const size_t treeCount = model.GetTreeCount();
+    const size_t treeCount = treeIndices.size();
     const size_t treeBlockSize = CB_THREAD_LIMIT; // least necessary for threading
 
     TFstrLogger treesLogger(treeCount, "trees processed", "Processing trees...", logPeriod);
@@ -461,11 +591,11 @@ static void PrepareTrees(
     // use only if model.ObliviousTrees.LeafWeights is empty
     TVector<TVector<double>> leafWeights;
     if (model.ObliviousTrees.LeafWeights.empty()) {
-        leafWeights = CollectLeavesStatistics(pool, model);
+        leafWeights = CollectLeavesStatistics(pool, model, &localExecutor);
     }
 
-    shapValuesByLeafForAllTrees->resize(treeCount);
-    meanValuesForAllTrees->resize(treeCount);
+    shapValuesByLeafForAllTrees->resize(model.GetTreeCount());
+    meanValuesForAllTrees->resize(model.GetTreeCount());
 
     TProfileInfo processTreesProfile(treeCount);
 
@@ -477,6 +607,7 @@ static void PrepareTrees(
         CalcShapValuesByLeafForTreeBlock(
             model.ObliviousTrees,
             model.ObliviousTrees.LeafWeights.empty() ? leafWeights : model.ObliviousTrees.LeafWeights,
+            treeIndices,
             localExecutor,
             start,
             end,
@@ -490,50 +621,248 @@ static void PrepareTrees(
     }
 }
 
-TVector<TVector<double>> CalcShapValues(
+static const char* const ShapPreparedTreesModelInfoKey = "shap_prepared_trees";
+static const ui32 ShapPreparedTreesFormatVersion = 1;
+
+static bool TryLoadShapPreparedTreesFromModel(const TFullModel& model, TShapPreparedTrees* preparedTrees) {
+    const TString* blob = model.ModelInfo.FindPtr(ShapPreparedTreesModelInfoKey);
+    if (blob == nullptr) {
+        return false;
+    }
+    try {
+        TStringInput in(*blob);
+        ui32 version = 0;
+        ::Load(&in, version);
+        CB_ENSURE(version == ShapPreparedTreesFormatVersion, "Unknown prepared shap data format version " << version);
+        ::Load(&in, *preparedTrees);
+        CB_ENSURE(
+            preparedTrees->ShapValuesByLeafForAllTrees.size() == model.GetTreeCount()
+                && preparedTrees->MeanValuesForAllTrees.size() == model.GetTreeCount(),
+            "Prepared shap data does not match the model"
+        );
+        return true;
+    } catch (...) {
+        MATRIXNET_WARNING_LOG << "Can't use prepared shap data from the model, will recompute it: "
+            << CurrentExceptionMessage() << Endl;
+        return false;
+    }
+}
+
+static TVector<size_t> MakeAllTreeIndices(size_t treeCount) {
+    TVector<size_t> treeIndices(treeCount);
+    Iota(treeIndices.begin(), treeIndices.end(), static_cast<size_t>(0));
+    return treeIndices;
+}
+
+static TVector<size_t> SampleTreeIndices(size_t treeCount, double treeSampleRate, ui64 randomSeed) {
+    CB_ENSURE(treeSampleRate > 0.0 && treeSampleRate <= 1.0, "Tree sample rate must be in (0, 1]");
+    const size_t sampledTreeCount = Max<size_t>(1, static_cast<size_t>(treeCount * treeSampleRate));
+
+    TVector<size_t> treeIndices = MakeAllTreeIndices(treeCount);
+    TFastRng64 rand(randomSeed);
+    Shuffle(treeIndices.begin(), treeIndices.end(), rand);
+    treeIndices.resize(sampledTreeCount);
+    Sort(treeIndices.begin(), treeIndices.end());
+    return treeIndices;
+}
+
+static TVector<TVector<double>> CalcShapValuesForTrees(
     const TFullModel& model,
     const TPool& pool,
+    const TVector<size_t>& treeIndices,
     int threadCount,
-    int logPeriod
+    int logPeriod,
+    TVector<TVector<double>>* shapValueVariances
 ) {
     NPar::TLocalExecutor localExecutor;
     localExecutor.RunAdditionalThreads(threadCount - 1);
 
-    TVector<TVector<TVector<TShapValue>>> shapValuesByLeafForAllTrees;
-    TVector<TVector<double>> meanValuesForAllTrees;
+    TShapPreparedTrees preparedTrees;
+    if (!TryLoadShapPreparedTreesFromModel(model, &preparedTrees)) {
+        PrepareTrees(
+            model,
+            pool,
+            treeIndices,
+            localExecutor,
+            logPeriod,
+            &preparedTrees.ShapValuesByLeafForAllTrees,
+            &preparedTrees.MeanValuesForAllTrees
+        );
+    }
+
+    const size_t documentCount = pool.Docs.GetDocCount();
+    const size_t documentBlockSize = CB_THREAD_LIMIT; // least necessary for threading
+
+    TFstrLogger documentsLogger(documentCount, "documents processed", "Processing documents...", logPeriod);
+
+    TVector<TVector<double>> shapValues;
+    shapValues.reserve(documentCount);
 
+    TProfileInfo processDocumentsProfile(documentCount);
+
+    for (size_t start = 0; start < documentCount; start += documentBlockSize) {
+        size_t end = Min(start + documentBlockSize, documentCount);
+
+        processDocumentsProfile.StartIterationBlock();
+
+        CalcShapValuesForDocumentBlock(
+            model,
+            pool,
+            localExecutor,
+            treeIndices,
+            preparedTrees.ShapValuesByLeafForAllTrees,
+            preparedTrees.MeanValuesForAllTrees,
+            start,
+            end,
+            &shapValues,
+            shapValueVariances
+        );
+
+        processDocumentsProfile.FinishIterationBlock(end - start);
+        auto profileResults = processDocumentsProfile.GetProfileResults();
+        documentsLogger.Log(profileResults);
+    }
+
+    return shapValues;
+}
+
+TShapPreparedTrees PrepareShapTrees(
+    const TFullModel& model,
+    const TPool& pool,
+    int threadCount,
+    int logPeriod
+) {
+    NPar::TLocalExecutor localExecutor;
+    localExecutor.RunAdditionalThreads(threadCount - 1);
+
+    TShapPreparedTrees preparedTrees;
     PrepareTrees(
         model,
         pool,
+        MakeAllTreeIndices(model.GetTreeCount()),
         localExecutor,
         logPeriod,
-        &shapValuesByLeafForAllTrees,
-        &meanValuesForAllTrees
+        &preparedTrees.ShapValuesByLeafForAllTrees,
+        &preparedTrees.MeanValuesForAllTrees
     );
+    return preparedTrees;
+}
+
+void SaveShapPreparedTreesToModel(const TShapPreparedTrees& preparedTrees, TFullModel* model) {
+    CB_ENSURE(
+        preparedTrees.ShapValuesByLeafForAllTrees.size() == model->GetTreeCount()
+            && preparedTrees.MeanValuesForAllTrees.size() == model->GetTreeCount(),
+        "Prepared shap data does not match the model"
+    );
+    TString blob;
+    {
+        TStringOutput out(blob);
+        ::Save(&out, ShapPreparedTreesFormatVersion);
+        ::Save(&out, preparedTrees);
+    }
+    model->ModelInfo[ShapPreparedTreesModelInfoKey] = blob;
+}
+
+TVector<TVector<double>> CalcShapValues(
+    const TFullModel& model,
+    const TPool& pool,
+    int threadCount,
+    int logPeriod
+) {
+    return CalcShapValuesForTrees(
+        model,
+        pool,
+        MakeAllTreeIndices(model.GetTreeCount()),
+        threadCount,
+        logPeriod,
+        /*shapValueVariances*/ nullptr
+    );
+}
+
+TVector<TVector<double>> CalcSampledShapValues(
+    const TFullModel& model,
+    const TPool& pool,
+    int threadCount,
+    double treeSampleRate,
+    ui64 randomSeed,
+    TVector<TVector<double>>* shapValueVariances,
+    int logPeriod
+) {
+    const TVector<size_t> treeIndices = SampleTreeIndices(model.GetTreeCount(), treeSampleRate, randomSeed);
+    MATRIXNET_INFO_LOG << "Calculating SHAP values on " << treeIndices.size()
+        << " of " << model.GetTreeCount() << " trees" << Endl;
+    return CalcShapValuesForTrees(
+        model,
+        pool,
+        treeIndices,
+        threadCount,
+        logPeriod,
+        shapValueVariances
+    );
+}
+
+TVector<TVector<double>> CalcFeatureContributions(
+    const TFullModel& model,
+    const TPool& pool,
+    int threadCount,
+    int logPeriod
+) {
+    NPar::TLocalExecutor localExecutor;
+    localExecutor.RunAdditionalThreads(threadCount - 1);
+
+    const TObliviousTrees& forest = model.ObliviousTrees;
+
+    TVector<int> binFeatureCombinationClass;
+    TVector<TVector<int>> combinationClassFeatures;
+    MapBinFeaturesToClasses(forest, &binFeatureCombinationClass, &combinationClassFeatures);
+
+    // use only if model.ObliviousTrees.LeafWeights is empty
+    TVector<TVector<double>> collectedLeafWeights;
+    if (forest.LeafWeights.empty()) {
+        collectedLeafWeights = CollectLeavesStatistics(pool, model, &localExecutor);
+    }
+    const TVector<TVector<double>>& leafWeights = forest.LeafWeights.empty() ? collectedLeafWeights : forest.LeafWeights;
+
+    const size_t treeCount = forest.GetTreeCount();
+    TVector<TVector<TVector<double>>> subtreeValuesForAllTrees(treeCount);
+    NPar::TLocalExecutor::TExecRangeParams treeBlockParams(0, treeCount);
+    localExecutor.ExecRange([&] (size_t treeIdx) {
+        const TVector<TVector<double>> subtreeWeights = CalcSubtreeWeightsForTree(leafWeights[treeIdx], forest.TreeSizes[treeIdx]);
+        subtreeValuesForAllTrees[treeIdx] = CalcSubtreeValuesForTree(forest, subtreeWeights, treeIdx);
+    }, treeBlockParams, NPar::TLocalExecutor::WAIT_COMPLETE);
 
     const size_t documentCount = pool.Docs.GetDocCount();
     const size_t documentBlockSize = CB_THREAD_LIMIT; // least necessary for threading
 
     TFstrLogger documentsLogger(documentCount, "documents processed", "Processing documents...", logPeriod);
 
-    TVector<TVector<double>> shapValues;
-    shapValues.reserve(documentCount);
+    TVector<TVector<double>> contributions;
+    contributions.reserve(documentCount);
 
     TProfileInfo processDocumentsProfile(documentCount);
 
     for (size_t start = 0; start < documentCount; start += documentBlockSize) {
         size_t end = Min(start + documentBlockSize, documentCount);
-
         processDocumentsProfile.StartIterationBlock();
 
-        CalcShapValuesForDocumentBlock(model, pool, localExecutor, shapValuesByLeafForAllTrees, meanValuesForAllTrees, start, end, &shapValues);
+        CalcFeatureContributionsForDocumentBlock(
+            model,
+            pool,
+            localExecutor,
+            binFeatureCombinationClass,
+            combinationClassFeatures,
+            subtreeValuesForAllTrees,
+            start,
+            end,
+            &contributions
+        );
 
         processDocumentsProfile.FinishIterationBlock(end - start);
         auto profileResults = processDocumentsProfile.GetProfileResults();
         documentsLogger.Log(profileResults);
     }
 
-    return shapValues;
+    return contributions;
 }
 
 static void OutputShapValues(const TVector<TVector<double>>& shapValues, TFileOutput& out) {
@@ -555,17 +884,19 @@ void CalcAndOutputShapValues(
     NPar::TLocalExecutor localExecutor;
     localExecutor.RunAdditionalThreads(threadCount - 1);
 
-    TVector<TVector<TVector<TShapValue>>> shapValuesByLeafForAllTrees;
-    TVector<TVector<double>> meanValuesForAllTrees;
-
-    PrepareTrees(
-        model,
-        pool,
-        localExecutor,
-        logPeriod,
-        &shapValuesByLeafForAllTrees,
-        &meanValuesForAllTrees
-    );
+    const TVector<size_t> treeIndices = MakeAllTreeIndices(model.GetTreeCount());
+    TShapPreparedTrees preparedTrees;
+    if (!TryLoadShapPreparedTreesFromModel(model, &preparedTrees)) {
+        PrepareTrees(
+            model,
+            pool,
+            treeIndices,
+            localExecutor,
+            logPeriod,
+            &preparedTrees.ShapValuesByLeafForAllTrees,
+            &preparedTrees.MeanValuesForAllTrees
+        );
+    }
 
     const size_t documentCount = pool.Docs.GetDocCount();
     const size_t documentBlockSize = CB_THREAD_LIMIT; // least necessary for threading
@@ -586,11 +917,13 @@ void CalcAndOutputShapValues(
             model,
             pool,
             localExecutor,
-            shapValuesByLeafForAllTrees,
-            meanValuesForAllTrees,
+            treeIndices,
+            preparedTrees.ShapValuesByLeafForAllTrees,
+            preparedTrees.MeanValuesForAllTrees,
             start,
             end,
-            &shapValuesForBlock
+            &shapValuesForBlock,
+            /*shapValueVariances*/ nullptr
         );
 
         OutputShapValues(shapValuesForBlock, out);
@@ -4,6 +4,50 @@
 #include <catboost/libs/data/pool.h>
 
 #include <util/generic/vector.h>
+#include <util/ysaveload.h>
+
+struct TShapValue {
+    int Feature = -1;
+    TVector<double> Value;
+
+    TShapValue() = default;
+
+    TShapValue(int feature, int approxDimension)
+        : Feature(feature)
+        , Value(approxDimension)
+    {
+    }
+
+    Y_SAVELOAD_DEFINE(Feature, Value);
+};
+
+/*Result of the per tree preprocessing needed to calculate shap values:
+shap decomposition for every leaf and the mean value of every tree.
+Computing it is the expensive part of the calculation, so for repeated explanation
+runs over the same model it can be computed once with PrepareShapTrees and stored
+inside the model with SaveShapPreparedTreesToModel; subsequent CalcShapValues calls
+on that model reuse the stored data instead of recomputing it.*/
+struct TShapPreparedTrees {
+    TVector<TVector<TVector<TShapValue>>> ShapValuesByLeafForAllTrees; // [treeIdx][leafIdx][shapFeature]
+    TVector<TVector<double>> MeanValuesForAllTrees;                    // [treeIdx][dim]
+
+    Y_SAVELOAD_DEFINE(ShapValuesByLeafForAllTrees, MeanValuesForAllTrees);
+};
+
+/*Runs the per tree preprocessing for all trees of the model.
+The leaf statistics are taken from the model if it stores leaf weights,
+otherwise they are collected from the pool; in the latter case the prepared
+data is only valid for explanations of that pool.*/
+TShapPreparedTrees PrepareShapTrees(
+    const TFullModel& model,
+    const TPool& pool,
+    int threadCount,
+    int logPeriod = 0
+);
+
+/*Stores the prepared trees inside the model as a metadata blob, so that it is
+saved and loaded together with the model and reused by the calculation functions below.*/
+void SaveShapPreparedTreesToModel(const TShapPreparedTrees& preparedTrees, TFullModel* model);
 
 /*In case of multiclass the returned value for each document in pool is
 a vector of length (feature_count + 1) * approxDimension: shap values for each dimension in order.
@@ -15,6 +59,36 @@ TVector<TVector<double>> CalcShapValues(
     int logPeriod = 0
 );
 
+/*Approximate mode: shap values are calculated on a random treeSampleRate fraction of the trees,
+sampled without replacement, and every sampled tree's contribution is scaled by the inverse
+sampling fraction, so the result is an unbiased estimate of the exact shap values.
+If shapValueVariances is not nullptr, it is filled with per value estimates of the variance
+introduced by the tree sampling, in the same layout as the returned values.
+The returned value layout matches CalcShapValues.*/
+TVector<TVector<double>> CalcSampledShapValues(
+    const TFullModel& model,
+    const TPool& pool,
+    int threadCount,
+    double treeSampleRate,
+    ui64 randomSeed,
+    TVector<TVector<double>>* shapValueVariances = nullptr,
+    int logPeriod = 0
+);
+
+/*Fast Saabas-style alternative to CalcShapValues for online explanation.
+The contribution of the split at depth d of a tree is the change of the weighted mean
+leaf value between the subtree fixed by the first d split decisions of the document
+and the subtree fixed by the first d + 1; the tree mean goes to the bias slot.
+Contributions sum to the raw prediction exactly, like shap values, but the per document
+cost is a single leaf index computation per tree instead of the per leaf shap recursion.
+The returned value layout matches CalcShapValues.*/
+TVector<TVector<double>> CalcFeatureContributions(
+    const TFullModel& model,
+    const TPool& pool,
+    int threadCount,
+    int logPeriod = 0
+);
+
 /*In case of multiclass the returned value for each document in pool is
 a vector of length (feature_count + 1) * approxDimension: shap values for each dimension in order.
 The values are calculated for raw values.*/
@@ -3,38 +3,44 @@
 #include <catboost/libs/algo/index_calcer.h>
 
 
-TVector<TVector<double>> CollectLeavesStatistics(const TPool& pool, const TFullModel& model) {
-    const size_t treeCount = model.ObliviousTrees.TreeSizes.size();
+TVector<TVector<double>> CollectLeavesStatistics(
+    const TPool& pool,
+    const TFullModel& model,
+    NPar::TLocalExecutor* localExecutor
+) {
+    const int treeCount = model.ObliviousTrees.TreeSizes.ysize();
     TVector<TVector<double>> leavesStatistics(treeCount);
-    for (size_t index = 0; index < treeCount; ++index) {
+    for (int index = 0; index < treeCount; ++index) {
         leavesStatistics[index].resize(1 << model.ObliviousTrees.TreeSizes[index]);
     }
 
-    auto binFeatures = BinarizeFeatures(model, pool);
-
-    const auto documentsCount = pool.Docs.GetDocCount();
-    for (size_t treeIdx = 0; treeIdx < treeCount; ++treeIdx) {
-        TVector<TIndexType> indices = BuildIndicesForBinTree(
-            model,
-            binFeatures,
-            treeIdx);
-
-        if (indices.empty()) {
-            continue;
-        }
-
-        if (pool.Docs.Weight.empty()) {
-            for (size_t doc = 0; doc < documentsCount; ++doc) {
-                const TIndexType valueIndex = indices[doc];
-                leavesStatistics[treeIdx][valueIndex] += 1.0;
+    const size_t documentCount = pool.Docs.GetDocCount();
+    // Documents are binarized block by block, so the binarized matrix never has to be
+    // materialized for the whole pool; the statistics do not depend on the block layout.
+    const size_t documentBlockSize = 10000;
+
+    for (size_t start = 0; start < documentCount; start += documentBlockSize) {
+        const size_t end = Min(documentCount, start + documentBlockSize);
+        const size_t blockDocumentCount = end - start;
+        const TVector<ui8> binFeatures = BinarizeFeatures(model, pool, start, end);
+
+        // Each task accumulates into its own tree's row, so no partial sums have to be merged.
+        localExecutor->ExecRange([&](int treeIdx) {
+            const TVector<TIndexType> indices = BuildIndicesForBinTree(model, binFeatures, treeIdx);
+            if (indices.empty()) {
+                return;
             }
-        } else {
-            for (size_t doc = 0; doc < documentsCount; ++doc) {
-                const TIndexType valueIndex = indices[doc];
-                leavesStatistics[treeIdx][valueIndex] += pool.Docs.Weight[doc];
+            TVector<double>& treeStatistics = leavesStatistics[treeIdx];
+            if (pool.Docs.Weight.empty()) {
+                for (size_t doc = 0; doc < blockDocumentCount; ++doc) {
+                    treeStatistics[indices[doc]] += 1.0;
+                }
+            } else {
+                for (size_t doc = 0; doc < blockDocumentCount; ++doc) {
+                    treeStatistics[indices[doc]] += pool.Docs.Weight[start + doc];
+                }
             }
-        }
+        }, 0, treeCount, NPar::TLocalExecutor::WAIT_COMPLETE);
     }
     return leavesStatistics;
 }
-
@@ -0,0 +1,54 @@
+#include "alloc_profiler.h"
+
+#include <catboost/libs/logging/logging.h>
+
+#include <util/generic/utility.h>
+#include <util/string/builder.h>
+
+TStringBuf GetAllocTagName(EAllocTag tag) {
+    switch (tag) {
+        case EAllocTag::Untagged:
+            return "untagged";
+        case EAllocTag::CandidateList:
+            return "candidate_list";
+        case EAllocTag::OnlineCtr:
+            return "online_ctr";
+        case EAllocTag::MetricCompute:
+            return "metric_compute";
+        case EAllocTag::Count:
+            break;
+    }
+    return "unknown";
+}
+
+void LogAllocationProfile() {
+    int maxTag = 0;
+    int numSizes = 0;
+    const auto info = NAllocDbg::GetPerTagAllocInfo(/*flushPerThreadCounters*/ true, maxTag, numSizes);
+    if (!info) {
+        return;
+    }
+
+    // The allocator reports live counters (allocations minus frees), so the peak
+    // is the high-water mark over the dump points, not the true in-between peak;
+    // dumps run on the training thread once per metric period, no locking needed.
+    static ssize_t peakSize[static_cast<size_t>(EAllocTag::Count)] = {};
+
+    TStringBuilder out;
+    out << "Alloc profile:";
+    const int tagCount = Min<int>(static_cast<int>(EAllocTag::Count), maxTag);
+    for (int tag = 0; tag < tagCount; ++tag) {
+        ssize_t count = 0;
+        ssize_t size = 0;
+        for (int sizeIdx = 0; sizeIdx < numSizes; ++sizeIdx) {
+            const auto& entry = info[tag * numSizes + sizeIdx];
+            count += entry.Count;
+            size += entry.Size;
+        }
+        peakSize[tag] = Max(peakSize[tag], size);
+        out << " " << GetAllocTagName(static_cast<EAllocTag>(tag))
+            << "=" << count << "/" << (size >> 20) << "MB"
+            << "(peak " << (peakSize[tag] >> 20) << "MB)";
+    }
+    MATRIXNET_DEBUG_LOG << out << Endl;
+}
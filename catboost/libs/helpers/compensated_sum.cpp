@@ -0,0 +1,12 @@
+#include "compensated_sum.h"
+
+// Written once before training or evaluation starts, then only read by accumulation loops.
+static bool CompensatedAccumulation = false;
+
+void SetCompensatedAccumulation(bool enable) {
+    CompensatedAccumulation = enable;
+}
+
+bool UseCompensatedAccumulation() {
+    return CompensatedAccumulation;
+}
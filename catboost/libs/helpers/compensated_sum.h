@@ -0,0 +1,32 @@
+#pragma once
+
+#include <util/generic/array_ref.h>
+
+/* Kahan-compensated accumulation for the long summation chains of training and metric
+ * evaluation. Plain double accumulation over billions of addends drifts by the condition
+ * of the sum; the compensation term recovers the low-order bits lost on every add, so the
+ * running sum stays accurate to a few ulps at the cost of three extra flops per add. The
+ * running sum itself carries the correction, so readers of an accumulator in progress
+ * need no finalization step. Per-lane helpers keep one compensation per array element,
+ * so compensated array merges vectorize as well as the plain ones.
+ */
+
+// Opt-in switch for the run (see compensated_accumulation in the system options); set
+// once before training or evaluation starts, then only read from accumulation loops.
+void SetCompensatedAccumulation(bool enable);
+bool UseCompensatedAccumulation();
+
+inline void AddCompensated(double value, double* sum, double* compensation) {
+    const double corrected = value - *compensation;
+    const double updated = *sum + corrected;
+    *compensation = (updated - *sum) - corrected;
+    *sum = updated;
+}
+
+// Element-wise compensated merge: lane i of `compensations` belongs to lane i of `sums`,
+// so the loop has no cross-iteration dependencies beyond each lane's own state.
+inline void AddCompensated(TConstArrayRef<double> values, TArrayRef<double> sums, TArrayRef<double> compensations) {
+    for (size_t i = 0; i < values.size(); ++i) {
+        AddCompensated(values[i], &sums[i], &compensations[i]);
+    }
+}
@@ -1,7 +1,10 @@
 #pragma once
 
+#include <util/generic/algorithm.h>
 #include <util/generic/array_ref.h>
+#include <util/generic/vector.h>
 #include <util/digest/numeric.h>
+#include <util/system/compiler.h>
 
 namespace NCatboost {
 
@@ -43,6 +46,11 @@ namespace NCatboost {
             return NotFoundIndex;
         }
 
+        //! Prefetch the probe start bucket for a hash that will be resolved shortly
+        void PrefetchBucket(ui64 idx) const {
+            Y_PREFETCH_READ(&Buckets[idx & HashMask], 3);
+        }
+
         const TConstArrayRef<TBucket> GetBuckets() const {
             return Buckets;
         }
@@ -51,6 +59,138 @@ namespace NCatboost {
         TConstArrayRef<TBucket> Buckets;
     };
 
+    /*
+     * Minimal perfect index hash over a fixed key set: one slot per key and a one-probe
+     * lookup with no chains. Keys are grouped by `hash % groupCount`; the builder searches a
+     * per-group displacement so that `(IntHash(hash) + displacement) % slotCount` lands every
+     * key of the group in its own slot (hash-and-displace construction). The full hash is kept
+     * in the slot, so keys that were not in the build set still resolve to NotFoundIndex.
+     */
+    class TDenseIndexMphView {
+    public:
+        static constexpr ui32 NotFoundIndex = TDenseIndexHashView::NotFoundIndex;
+        TDenseIndexMphView(TConstArrayRef<TBucket> slots, TConstArrayRef<ui32> displacements)
+            : Slots(slots)
+            , Displacements(displacements)
+        {
+        }
+
+        ui32 GetIndex(ui64 hash) const {
+            if (Slots.empty()) {
+                return NotFoundIndex;
+            }
+            const ui64 displacement = Displacements[hash % Displacements.size()];
+            const TBucket& slot = Slots[(IntHash(hash) + displacement) % Slots.size()];
+            return slot.Hash == hash ? slot.IndexValue : NotFoundIndex;
+        }
+
+        //! Prefetch the displacement cell for a hash that will be resolved shortly
+        void PrefetchBucket(ui64 hash) const {
+            if (!Displacements.empty()) {
+                Y_PREFETCH_READ(&Displacements[hash % Displacements.size()], 3);
+            }
+        }
+
+        const TConstArrayRef<TBucket> GetSlots() const {
+            return Slots;
+        }
+
+        const TConstArrayRef<ui32> GetDisplacements() const {
+            return Displacements;
+        }
+    private:
+        TConstArrayRef<TBucket> Slots;
+        TConstArrayRef<ui32> Displacements;
+    };
+
+    class TDenseIndexMphBuilder {
+    public:
+        /*
+         * Build the perfect hash over the given (hash, index) entries. Returns false when no
+         * displacement assignment is found within a linear attempt budget (rare; more likely
+         * the larger the groups that collide), in which case the outputs are left empty and
+         * the caller should keep its open-addressed index.
+         */
+        static bool Build(TConstArrayRef<TBucket> entries, TVector<TBucket>* slots, TVector<ui32>* displacements) {
+            slots->clear();
+            displacements->clear();
+            const size_t slotCount = entries.size();
+            if (slotCount == 0) {
+                return true;
+            }
+            const size_t groupCount = slotCount / 4 + 1;
+            TVector<TVector<ui32>> groups(groupCount); // entry indices
+            for (ui32 entryIdx = 0; entryIdx < entries.size(); ++entryIdx) {
+                groups[entries[entryIdx].Hash % groupCount].push_back(entryIdx);
+            }
+            TVector<ui32> groupOrder(groupCount);
+            for (ui32 groupIdx = 0; groupIdx < groupCount; ++groupIdx) {
+                groupOrder[groupIdx] = groupIdx;
+            }
+            // place the largest groups while most slots are still free
+            StableSort(groupOrder.begin(), groupOrder.end(), [&groups](ui32 left, ui32 right) {
+                return groups[left].size() > groups[right].size();
+            });
+
+            TVector<bool> usedSlots(slotCount, false);
+            TVector<TBucket> builtSlots(slotCount, TBucket{TBucket::InvalidHashValue, 0});
+            TVector<ui32> builtDisplacements(groupCount, 0);
+            size_t freeSlotCursor = 0;
+            ui64 attemptBudget = 64 * static_cast<ui64>(slotCount) + 1024;
+            for (ui32 groupIdx : groupOrder) {
+                const TVector<ui32>& group = groups[groupIdx];
+                if (group.empty()) {
+                    continue;
+                }
+                if (group.size() == 1) {
+                    // a singleton can take any free slot, the displacement follows from it
+                    while (usedSlots[freeSlotCursor]) {
+                        ++freeSlotCursor;
+                    }
+                    const ui64 base = IntHash(entries[group[0]].Hash) % slotCount;
+                    builtDisplacements[groupIdx] = static_cast<ui32>((freeSlotCursor + slotCount - base) % slotCount);
+                    usedSlots[freeSlotCursor] = true;
+                    builtSlots[freeSlotCursor] = entries[group[0]];
+                    continue;
+                }
+                bool placed = false;
+                TVector<size_t> positions(group.size());
+                for (size_t displacement = 0; displacement < slotCount && !placed; ++displacement) {
+                    if (attemptBudget-- == 0) {
+                        return false;
+                    }
+                    size_t markedCount = 0;
+                    for (; markedCount < group.size(); ++markedCount) {
+                        const size_t slotIdx = (IntHash(entries[group[markedCount]].Hash) + displacement) % slotCount;
+                        if (usedSlots[slotIdx]) {
+                            break;
+                        }
+                        // marking as we probe also catches collisions inside the group itself
+                        usedSlots[slotIdx] = true;
+                        positions[markedCount] = slotIdx;
+                    }
+                    if (markedCount == group.size()) {
+                        for (size_t inGroupIdx = 0; inGroupIdx < group.size(); ++inGroupIdx) {
+                            builtSlots[positions[inGroupIdx]] = entries[group[inGroupIdx]];
+                        }
+                        builtDisplacements[groupIdx] = static_cast<ui32>(displacement);
+                        placed = true;
+                    } else {
+                        for (size_t rollbackIdx = 0; rollbackIdx < markedCount; ++rollbackIdx) {
+                            usedSlots[positions[rollbackIdx]] = false;
+                        }
+                    }
+                }
+                if (!placed) {
+                    return false;
+                }
+            }
+            slots->swap(builtSlots);
+            displacements->swap(builtDisplacements);
+            return true;
+        }
+    };
+
     class TDenseIndexHashBuilder {
     public:
         static_assert(sizeof(TBucket) == 12, "Expected sizeof(TBucket) == 12 bytes");
@@ -0,0 +1,69 @@
+#include "huge_pages.h"
+
+#if defined(_linux_)
+
+#include <catboost/libs/logging/logging.h>
+
+#include <util/generic/strbuf.h>
+#include <util/generic/string.h>
+#include <util/stream/file.h>
+#include <util/string/cast.h>
+#include <util/string/strip.h>
+#include <util/system/align.h>
+
+#include <sys/mman.h>
+
+namespace NCB {
+    namespace {
+        const size_t HUGE_PAGE_SIZE = size_t(2) << 20;
+    }
+
+    void AdviseHugePages(void* data, size_t size) {
+        const uintptr_t begin = AlignUp(reinterpret_cast<uintptr_t>(data), HUGE_PAGE_SIZE);
+        const uintptr_t end = AlignDown(reinterpret_cast<uintptr_t>(data) + size, HUGE_PAGE_SIZE);
+        if (begin >= end) {
+            return; // the range does not cover a single aligned huge page
+        }
+        if (madvise(reinterpret_cast<void*>(begin), end - begin, MADV_HUGEPAGE) != 0) {
+            MATRIXNET_DEBUG_LOG << "madvise(MADV_HUGEPAGE) failed with err " << errno
+                << ", training arrays stay on 4KB pages" << Endl;
+        }
+    }
+
+    ui64 GetAnonHugePageBytes() {
+        try {
+            TIFStream status("/proc/self/status");
+            TString line;
+            while (status.ReadLine(line)) {
+                if (!line.StartsWith("AnonHugePages:")) {
+                    continue;
+                }
+                // the line looks like "AnonHugePages:    524288 kB"
+                TStringBuf value = TStringBuf(line).Skip(TStringBuf("AnonHugePages:").size());
+                value = StripString(value);
+                value = value.Before(' ');
+                ui64 kiloBytes = 0;
+                if (TryFromString(value, kiloBytes)) {
+                    return kiloBytes << 10;
+                }
+                break;
+            }
+        } catch (...) {
+            // the field is absent on kernels without THP accounting
+        }
+        return 0;
+    }
+}
+
+#else
+
+namespace NCB {
+    void AdviseHugePages(void* /*data*/, size_t /*size*/) {
+    }
+
+    ui64 GetAnonHugePageBytes() {
+        return 0;
+    }
+}
+
+#endif
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <util/system/types.h>
+
+#include <cstddef>
+
+namespace NCB {
+
+    /*
+     * Ask the kernel to back [data, data + size) with transparent 2MB pages (madvise
+     * MADV_HUGEPAGE on the 2MB-aligned subrange). The arrays stay ordinary TVector
+     * storage: the kernel collapses their pages in the background, so this is best
+     * effort and safe to call on any range. No-op on platforms without THP support,
+     * on ranges smaller than one huge page, and when the advice is rejected (e.g.
+     * transparent_hugepage is set to 'never').
+     */
+    void AdviseHugePages(void* data, size_t size);
+
+    /// @return bytes of this process currently backed by transparent huge pages
+    /// (AnonHugePages from /proc/self/status), 0 where the kernel does not report it.
+    ui64 GetAnonHugePageBytes();
+}
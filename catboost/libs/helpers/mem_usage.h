@@ -2,8 +2,65 @@
 
 #include <catboost/libs/logging/logging.h>
 
+#include <util/generic/map.h>
+#include <util/generic/singleton.h>
+#include <util/generic/utility.h>
+#include <util/string/builder.h>
+#include <util/system/guard.h>
 #include <util/system/rusage.h>
+#include <util/system/spinlock.h>
 
 inline void DumpMemUsage(const TString& msg) {
     MATRIXNET_DEBUG_LOG << "Mem usage: " << msg << ": " << TRusage::Get().Rss << Endl;
 }
+
+// Tagged accounting of the dominant training allocations. Subsystems report
+// their current footprint under a fixed tag and the training loop logs the
+// breakdown together with current and peak RSS every metric period, so memory
+// growth can be attributed to a subsystem before the process runs out of
+// memory instead of from a post-mortem.
+class TMemoryUsageTracker {
+public:
+    void Set(const TString& tag, ui64 bytes) {
+        with_lock (Lock) {
+            UsageByTag[tag] = bytes;
+        }
+    }
+
+    // Returns current RSS and refreshes the high-water mark.
+    ui64 UpdatePeakRss() {
+        const ui64 rss = TRusage::Get().Rss;
+        with_lock (Lock) {
+            PeakRss = Max(PeakRss, rss);
+        }
+        return rss;
+    }
+
+    ui64 GetPeakRss() {
+        with_lock (Lock) {
+            return PeakRss;
+        }
+    }
+
+    void LogState(int iteration) {
+        const ui64 rss = UpdatePeakRss();
+        TStringBuilder out;
+        out << "Mem usage at iteration " << iteration << ":";
+        with_lock (Lock) {
+            for (const auto& tagUsage : UsageByTag) {
+                out << " " << tagUsage.first << "=" << (tagUsage.second >> 20) << "MB";
+            }
+            out << " rss=" << (rss >> 20) << "MB peak_rss=" << (PeakRss >> 20) << "MB";
+        }
+        MATRIXNET_DEBUG_LOG << out << Endl;
+    }
+
+private:
+    TAdaptiveLock Lock;
+    TMap<TString, ui64> UsageByTag;
+    ui64 PeakRss = 0;
+};
+
+inline TMemoryUsageTracker& MemoryUsageTracker() {
+    return *Singleton<TMemoryUsageTracker>();
+}
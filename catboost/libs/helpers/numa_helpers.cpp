@@ -0,0 +1,130 @@
+#include "numa_helpers.h"
+
+#if defined(WITH_HWLOC)
+
+#include <catboost/libs/logging/logging.h>
+
+#include <hwloc.h>
+
+#include <util/generic/singleton.h>
+
+namespace NCB {
+    namespace {
+        class TNumaTopology {
+        public:
+            TNumaTopology() {
+                int errCode = hwloc_topology_init(&Context);
+                if (errCode != -1) {
+                    errCode = hwloc_topology_load(Context);
+                }
+                if (errCode == -1) {
+                    MATRIXNET_ERROR_LOG << "Error: can't init hwloc topology" << Endl;
+                    HasContext = false;
+                } else {
+                    HasContext = true;
+                }
+            }
+
+            ~TNumaTopology() {
+                if (HasContext) {
+                    hwloc_topology_destroy(Context);
+                    HasContext = false;
+                }
+            }
+
+            int GetNodeCount() const {
+                if (!HasContext) {
+                    return 1;
+                }
+                const int nodeCount = hwloc_get_nbobjs_by_type(Context, HWLOC_OBJ_NODE);
+                return nodeCount > 0 ? nodeCount : 1;
+            }
+
+            void InterleaveArea(void* data, size_t size) {
+                if (!HasContext || GetNodeCount() < 2 || size == 0) {
+                    return;
+                }
+                const int errCode = hwloc_set_area_membind_nodeset(
+                    Context,
+                    data,
+                    size,
+                    hwloc_topology_get_complete_nodeset(Context),
+                    HWLOC_MEMBIND_INTERLEAVE,
+                    0);
+                if (errCode == -1) {
+                    MATRIXNET_ERROR_LOG << "Can't interleave memory across NUMA nodes with err " << errno << Endl;
+                }
+            }
+
+            void BindCurrentThreadToNode(int nodeIdx) {
+                if (!HasContext || GetNodeCount() < 2) {
+                    return;
+                }
+                const hwloc_obj_t node = hwloc_get_obj_by_type(Context, HWLOC_OBJ_NODE, nodeIdx);
+                if (node == nullptr) {
+                    return;
+                }
+                int errCode = hwloc_set_cpubind(Context, node->cpuset, HWLOC_CPUBIND_THREAD);
+                if (errCode == -1) {
+                    MATRIXNET_ERROR_LOG << "Can't bind thread to NUMA node " << nodeIdx << " with err " << errno << Endl;
+                }
+                errCode = hwloc_set_membind_nodeset(Context, node->nodeset, HWLOC_MEMBIND_BIND, HWLOC_CPUBIND_THREAD);
+                if (errCode == -1) {
+                    MATRIXNET_ERROR_LOG << "Can't bind memory to NUMA node " << nodeIdx << " with err " << errno << Endl;
+                }
+            }
+
+        private:
+            hwloc_topology_t Context;
+            bool HasContext = false;
+        };
+
+        TNumaTopology& NumaTopology() {
+            return *Singleton<TNumaTopology>();
+        }
+    }
+
+    int GetNumaNodeCount() {
+        return NumaTopology().GetNodeCount();
+    }
+
+    void InterleaveMemoryAcrossNumaNodes(void* data, size_t size) {
+        NumaTopology().InterleaveArea(data, size);
+    }
+
+    void SpreadExecutorThreadsAcrossNumaNodes(NPar::TLocalExecutor* executor) {
+        const int nodeCount = GetNumaNodeCount();
+        if (nodeCount < 2) {
+            return;
+        }
+        const int threadCount = executor->GetThreadCount();
+        if (threadCount > 0) {
+            // best effort: every task binds whichever worker runs it by its stable worker id,
+            // repeated binds of the same worker are idempotent
+            executor->ExecRange(
+                [executor, nodeCount](int) {
+                    NumaTopology().BindCurrentThreadToNode(executor->GetWorkerThreadId() % nodeCount);
+                },
+                0,
+                threadCount,
+                NPar::TLocalExecutor::WAIT_COMPLETE);
+        }
+        NumaTopology().BindCurrentThreadToNode(0);
+    }
+}
+
+#else
+
+namespace NCB {
+    int GetNumaNodeCount() {
+        return 1;
+    }
+
+    void InterleaveMemoryAcrossNumaNodes(void* /*data*/, size_t /*size*/) {
+    }
+
+    void SpreadExecutorThreadsAcrossNumaNodes(NPar::TLocalExecutor* /*executor*/) {
+    }
+}
+
+#endif
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <library/threading/local_executor/local_executor.h>
+
+#include <util/system/types.h>
+
+#include <cstddef>
+
+namespace NCB {
+
+    /// @return the number of NUMA nodes (1 when hwloc is unavailable or the box is single-node).
+    int GetNumaNodeCount();
+
+    /*
+     * Interleave the pages of [data, data + size) round-robin across all NUMA nodes, so that
+     * document-parallel scans over the array pay a bounded remote-access cost instead of
+     * hammering the single node that happened to first-touch it. No-op without hwloc support
+     * (build with WITH_HWLOC) or on single-node boxes.
+     */
+    void InterleaveMemoryAcrossNumaNodes(void* data, size_t size);
+
+    /*
+     * Bind the executor's worker threads round-robin across NUMA nodes (the calling thread is
+     * bound to node 0), aligning the thread-to-node mapping with interleaved data placement.
+     * No-op without hwloc support or on single-node boxes.
+     */
+    void SpreadExecutorThreadsAcrossNumaNodes(NPar::TLocalExecutor* executor);
+}
@@ -76,6 +76,30 @@ static void GenerateRandomly(
     }
 }
 
+void GeneratePairLogitPairsForQuery(
+    int groupBegin,
+    int groupEnd,
+    const TVector<float>& targetId,
+    int maxPairCount,
+    TRestorableFastRng64* rand,
+    TVector<TPair>* result
+) {
+    THashMap<float, int> targetCount;
+    for (int docIdx = groupBegin; docIdx < groupEnd; ++docIdx) {
+        targetCount[targetId[docIdx]]++;
+    }
+    int pairCount = 0;
+    for (auto target: targetCount) {
+        pairCount += target.second * (groupEnd - groupBegin - target.second);
+    }
+    pairCount /= 2;
+    if (maxPairCount == NCatboostOptions::MAX_AUTOGENERATED_PAIRS_COUNT || pairCount / 2 < maxPairCount) {
+        GenerateBruteForce(groupBegin, groupEnd, maxPairCount, pairCount, targetId, rand, result);
+    } else {
+        GenerateRandomly(groupBegin, groupEnd, maxPairCount, targetId, rand, result);
+    }
+}
+
 void GeneratePairLogitPairs(
     const TVector<TGroupId>& groupId,
     const TVector<float>& targetId,
@@ -84,26 +108,11 @@ void GeneratePairLogitPairs(
     TVector<TPair>* result
 ) {
     CB_ENSURE(!targetId.empty(), "Pool labels are not provided. Cannot generate pairs.");
-    THashMap<float, int> targetCount;
-    targetCount[targetId[0]] = 1;
     for (int docIdx = 1, groupBeginIdx = 0; docIdx <= groupId.ysize(); ++docIdx) {
         if (docIdx == groupId.ysize() || groupId[docIdx] != groupId[groupBeginIdx]) {
-            int pairCount = 0;
-            for (auto target: targetCount) {
-                pairCount += target.second * (docIdx - groupBeginIdx - target.second);
-            }
-            pairCount /= 2;
-            if (maxPairCount == NCatboostOptions::MAX_AUTOGENERATED_PAIRS_COUNT || pairCount / 2 < maxPairCount) {
-                GenerateBruteForce(groupBeginIdx, docIdx, maxPairCount, pairCount, targetId, rand, result);
-            } else {
-                GenerateRandomly(groupBeginIdx, docIdx, maxPairCount, targetId, rand, result);
-            }
-            targetCount.clear();
+            GeneratePairLogitPairsForQuery(groupBeginIdx, docIdx, targetId, maxPairCount, rand, result);
             groupBeginIdx = docIdx;
         }
-        if (docIdx < targetId.ysize()) {
-            targetCount[targetId[docIdx]]++;
-        }
     }
 }
 
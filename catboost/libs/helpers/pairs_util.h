@@ -4,6 +4,15 @@
 #include <catboost/libs/helpers/restorable_rng.h>
 
 
+// generate pairs for a single query [groupBegin, groupEnd); used for per-iteration pair resampling
+void GeneratePairLogitPairsForQuery(
+    int groupBegin,
+    int groupEnd,
+    const TVector<float>& targetId,
+    int maxPairCount,
+    TRestorableFastRng64* rand,
+    TVector<TPair>* result);
+
 void GeneratePairLogitPairs(
     const TVector<TGroupId>& groupId,
     const TVector<float>& targetId,
@@ -51,3 +51,34 @@ void Shuffle(const TVector<TGroupId>& queryId, TRandGen& rand, TVector<TDataType
         idxInResult += size;
     }
 }
+
+//permutes whole query blocks, keeping documents inside each block in their original order;
+//pools without query ids degrade to a plain document shuffle
+template<typename TDataType, typename TRandGen>
+void ShuffleGroups(const TVector<TGroupId>& queryId, TRandGen& rand, TVector<TDataType>* indices) {
+    if (queryId.empty()) {
+        Shuffle(indices->begin(), indices->end(), rand);
+        return;
+    }
+
+    TVector<std::pair<int, int>> queryStartAndSize;
+    const int docsToPermute = indices->ysize();
+    for (int docIdx = 0; docIdx < docsToPermute; ++docIdx) {
+        if (docIdx == 0 || queryId[docIdx] != queryId[docIdx - 1]) {
+            queryStartAndSize.emplace_back(docIdx, 1);
+        }
+        else {
+            queryStartAndSize.back().second++;
+        }
+    }
+    Shuffle(queryStartAndSize.begin(), queryStartAndSize.end(), rand);
+
+    int idxInResult = 0;
+    for (int queryIdx = 0; queryIdx < queryStartAndSize.ysize(); queryIdx++) {
+        const auto& query = queryStartAndSize[queryIdx];
+        for (int doc = 0; doc < query.second; doc++) {
+            (*indices)[idxInResult + doc] = query.first + doc;
+        }
+        idxInResult += query.second;
+    }
+}
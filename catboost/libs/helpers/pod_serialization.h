@@ -0,0 +1,52 @@
+#pragma once
+
+#include <util/generic/vector.h>
+#include <util/ysaveload.h>
+
+#include <type_traits>
+
+/*
+ * Bulk save/load for vectors of trivially copyable elements.
+ *
+ * The generic TVector serializer streams elements one by one, which costs a stream
+ * Write call per element; for the large snapshot arrays (approxes, online ctr tables)
+ * that is the dominant serialization cost. These helpers write the same elements as a
+ * single contiguous array. The element count prefix is a ui64, so the format differs
+ * from the generic serializer and save and load sides must agree on which one is used.
+ */
+
+template <typename T>
+inline void SavePodVector(IOutputStream* s, const TVector<T>& vector) {
+    static_assert(std::is_trivially_copyable<T>::value, "bulk serialization requires trivially copyable elements");
+    const ui64 size = vector.size();
+    ::Save(s, size);
+    ::SavePodArray(s, vector.data(), vector.size());
+}
+
+template <typename T>
+inline void LoadPodVector(IInputStream* s, TVector<T>* vector) {
+    static_assert(std::is_trivially_copyable<T>::value, "bulk serialization requires trivially copyable elements");
+    ui64 size = 0;
+    ::Load(s, size);
+    vector->yresize(size);
+    ::LoadPodArray(s, vector->data(), vector->size());
+}
+
+template <typename T>
+inline void SavePodMatrix(IOutputStream* s, const TVector<TVector<T>>& matrix) {
+    const ui64 rowCount = matrix.size();
+    ::Save(s, rowCount);
+    for (const auto& row : matrix) {
+        SavePodVector(s, row);
+    }
+}
+
+template <typename T>
+inline void LoadPodMatrix(IInputStream* s, TVector<TVector<T>>* matrix) {
+    ui64 rowCount = 0;
+    ::Load(s, rowCount);
+    matrix->resize(rowCount);
+    for (auto& row : *matrix) {
+        LoadPodVector(s, &row);
+    }
+}
@@ -59,6 +59,10 @@ void TOutputFiles::InitializeFiles(const NCatboostOptions::TOutputFilesOptions&
     CB_ENSURE(!profileLogFilename.empty(), "empty profile_log filename");
     ProfileLogFile = TOutputFiles::AlignFilePathAndCreateDir(trainDir, profileLogFilename, "");
 
+    if (!params.GetTelemetryLogFilename().empty()) {
+        TelemetryLogFile = TOutputFiles::AlignFilePathAndCreateDir(trainDir, params.GetTelemetryLogFilename(), "");
+    }
+
     ExperimentName = params.GetName();
     TrainDir = trainDir;
 }
@@ -98,17 +102,26 @@ void AddFileLoggers(
         const TString& timeLogFile,
         const TString& jsonLogFile,
         const TString& profileLogFile,
+        const TString& telemetryLogFile,
         const TString& trainDir,
         const NJson::TJsonValue& metaJson,
         int metricPeriod,
         TLogger* logger
 ) {
     TIntrusivePtr<ILoggingBackend> jsonLoggingBackend = new TJsonLoggingBackend(jsonLogFile, metaJson, metricPeriod);
+    // One instance per file: the telemetry backend merges all sources into one row per iteration.
+    TIntrusivePtr<ILoggingBackend> telemetryLoggingBackend;
+    if (!telemetryLogFile.empty()) {
+        telemetryLoggingBackend.Reset(new TColumnarTelemetryLoggingBackend(telemetryLogFile));
+    }
     for (auto& jsonToken : metaJson["learn_sets"].GetArraySafe()) {
         TString token = jsonToken.GetString();
         logger->AddBackend(token, TIntrusivePtr<ILoggingBackend>(new TErrorFileLoggingBackend(learnErrorLogFile)));
         logger->AddBackend(token, TIntrusivePtr<ILoggingBackend>(new TTensorBoardLoggingBackend(JoinFsPaths(trainDir, token))));
         logger->AddBackend(token, jsonLoggingBackend);
+        if (telemetryLoggingBackend) {
+            logger->AddBackend(token, telemetryLoggingBackend);
+        }
     }
     TIntrusivePtr<ILoggingBackend> errorFileLoggingBackend;
     for (auto& jsonToken : metaJson["test_sets"].GetArraySafe()) {
@@ -119,9 +132,15 @@ void AddFileLoggers(
         logger->AddBackend(token, errorFileLoggingBackend);
         logger->AddBackend(token, TIntrusivePtr<ILoggingBackend>(new TTensorBoardLoggingBackend(JoinFsPaths(trainDir, token))));
         logger->AddBackend(token, jsonLoggingBackend);
+        if (telemetryLoggingBackend) {
+            logger->AddBackend(token, telemetryLoggingBackend);
+        }
     }
     logger->AddProfileBackend(TIntrusivePtr<ILoggingBackend>(new TTimeFileLoggingBackend(timeLogFile)));
     logger->AddProfileBackend(jsonLoggingBackend);
+    if (telemetryLoggingBackend) {
+        logger->AddProfileBackend(telemetryLoggingBackend);
+    }
     if (detailedProfile) {
         logger->AddProfileBackend(TIntrusivePtr<ILoggingBackend>(new TProfileLoggingBackend(profileLogFile)));
         logger->AddProfileBackend(TIntrusivePtr<ILoggingBackend>(new TJsonProfileLoggingBackend(profileLogFile + ".json")));
@@ -285,6 +304,7 @@ void InitializeFileLoggers(
             outputFiles.TimeLeftLogFile,
             outputFiles.JsonLogFile,
             outputFiles.ProfileLogFile,
+            outputFiles.TelemetryLogFile,
             outputFiles.TrainDir,
             GetJsonMeta(
                     catboostOptions.BoostingOptions->IterationCount.Get(),
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "columnar_telemetry.h"
 #include "logger.h"
 #include <catboost/libs/options/catboost_options.h>
 #include <catboost/libs/metrics/metric.h>
@@ -44,6 +45,7 @@ public:
     TString MetaFile;
     TString JsonLogFile;
     TString ProfileLogFile;
+    TString TelemetryLogFile;
     TString TrainDir;
     TString ExperimentName;
 
@@ -70,6 +72,7 @@ void AddFileLoggers(
     const TString& timeLogFile,
     const TString& jsonLogFile,
     const TString& profileLogFile,
+    const TString& telemetryLogFile,
     const TString& trainDir,
     const NJson::TJsonValue& metaJson,
     int metricPeriod,
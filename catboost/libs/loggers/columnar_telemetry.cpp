@@ -0,0 +1,73 @@
+#include "columnar_telemetry.h"
+
+#include <util/generic/algorithm.h>
+#include <util/system/rusage.h>
+#include <util/ysaveload.h>
+
+#include <cstring>
+#include <limits>
+
+static const ui64 ColumnarTelemetryMagic = 0x314C544253424354ULL; // "TCBSBTL1"
+static const ui32 ColumnarTelemetryVersion = 1;
+
+void TColumnarTelemetryLoggingBackend::SetValue(const TString& columnName, double value) {
+    auto it = ColumnIndex.find(columnName);
+    if (it == ColumnIndex.end()) {
+        if (!IsFirstIteration) {
+            return;
+        }
+        ColumnIndex[columnName] = ColumnNames.size();
+        ColumnNames.push_back(columnName);
+        RowValues.push_back(value);
+        return;
+    }
+    RowValues[it->second] = value;
+}
+
+void TColumnarTelemetryLoggingBackend::Flush(const int currentIteration) {
+    SetValue("rss:max_bytes", static_cast<double>(TRusage::Get().MaxRss));
+    if (IsFirstIteration) {
+        ::Save(File.Get(), ColumnarTelemetryMagic);
+        ::Save(File.Get(), ColumnarTelemetryVersion);
+        ::Save(File.Get(), ColumnNames);
+        IsFirstIteration = false;
+    }
+    ::Save(File.Get(), static_cast<ui32>(currentIteration));
+    File->Write(RowValues.data(), RowValues.size() * sizeof(double));
+    File->Flush();
+    Fill(RowValues.begin(), RowValues.end(), std::numeric_limits<double>::quiet_NaN());
+}
+
+TColumnarTelemetry ReadColumnarTelemetry(const TString& fileName) {
+    TIFStream in(fileName);
+    ui64 magic = 0;
+    ::Load(&in, magic);
+    CB_ENSURE(magic == ColumnarTelemetryMagic, "File " << fileName << " is not a columnar telemetry log");
+    ui32 version = 0;
+    ::Load(&in, version);
+    CB_ENSURE(version == ColumnarTelemetryVersion,
+        "Unsupported telemetry log version " << version << " in " << fileName);
+
+    TColumnarTelemetry result;
+    ::Load(&in, result.ColumnNames);
+    const size_t columnCount = result.ColumnNames.size();
+    const size_t rowSize = sizeof(ui32) + columnCount * sizeof(double);
+
+    const TString rows = in.ReadAll();
+    const size_t rowCount = rows.size() / rowSize; // an incomplete trailing row is dropped
+    result.Iterations.yresize(rowCount);
+    result.Columns.resize(columnCount);
+    for (auto& column : result.Columns) {
+        column.yresize(rowCount);
+    }
+    const char* data = rows.data();
+    for (size_t row = 0; row < rowCount; ++row) {
+        memcpy(&result.Iterations[row], data, sizeof(ui32));
+        data += sizeof(ui32);
+        for (size_t column = 0; column < columnCount; ++column) {
+            memcpy(&result.Columns[column][row], data, sizeof(double));
+            data += sizeof(double);
+        }
+    }
+    return result;
+}
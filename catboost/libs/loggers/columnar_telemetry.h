@@ -0,0 +1,67 @@
+#pragma once
+
+#include "logger.h"
+
+#include <catboost/libs/helpers/exception.h>
+
+#include <util/generic/hash.h>
+#include <util/generic/string.h>
+#include <util/generic/vector.h>
+#include <util/stream/file.h>
+
+/* Compact columnar telemetry log for per-iteration training statistics.
+ *
+ * File layout (all integers little-endian, doubles raw IEEE 754):
+ *   ui64 magic, ui32 version, column names (standard ysaveload vector of strings),
+ * followed by one fixed-width row per iteration: ui32 iteration number and one
+ * double per column. A column with no value on some iteration holds NaN.
+ *
+ * The schema is frozen after the first iteration, so appending a row is a single
+ * sequential write of a known size and a reader can seek to any iteration without
+ * parsing. An incomplete trailing row (e.g. after a crash) is dropped on read.
+ */
+
+struct TColumnarTelemetry {
+    TVector<TString> ColumnNames;
+    TVector<ui32> Iterations;         // [row]
+    TVector<TVector<double>> Columns; // [column][row]
+
+    size_t GetRowCount() const {
+        return Iterations.size();
+    }
+};
+
+TColumnarTelemetry ReadColumnarTelemetry(const TString& fileName);
+
+class TColumnarTelemetryLoggingBackend : public ILoggingBackend {
+public:
+    explicit TColumnarTelemetryLoggingBackend(const TString& fileName)
+        : File(new TOFStream(fileName))
+    {
+    }
+
+    void OutputMetric(const TString& sourceName, const IMetricEvalResult& evalResult) {
+        SetValue(sourceName + ":" + evalResult.GetMetricName(), evalResult.GetMetricValue());
+    }
+
+    void OutputProfile(const TProfileResults& profileResults) {
+        SetValue("time:passed_sec", profileResults.PassedTime);
+        SetValue("time:remaining_sec", profileResults.RemainingTime);
+        for (const auto& it : profileResults.OperationToTime) {
+            SetValue("phase:" + it.first, it.second);
+        }
+    }
+
+    void Flush(const int currentIteration);
+
+private:
+    void SetValue(const TString& columnName, double value);
+
+    THolder<TOFStream> File;
+    // Schema is built from the values seen on the first iteration and frozen on the
+    // first Flush; columns that only appear later are not recorded.
+    TVector<TString> ColumnNames;
+    THashMap<TString, size_t> ColumnIndex;
+    TVector<double> RowValues;
+    bool IsFirstIteration = true;
+};
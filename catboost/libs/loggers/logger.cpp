@@ -18,5 +18,15 @@ void LogAverages(const TProfileResults& profileResults) {
         MATRIXNET_NOTICE_LOG << it.first << ": "
                              << FloatToString(it.second / profileResults.PassedIterations, PREC_NDIGITS, 3) << " sec" << Endl;
     }
+    if (!profileResults.OperationToHardwareCountersInAllIterations.empty()) {
+        MATRIXNET_NOTICE_LOG << Endl << "Average hardware counters:" << Endl;
+        for (const auto& it : profileResults.OperationToHardwareCountersInAllIterations) {
+            MATRIXNET_NOTICE_LOG << it.first << ": "
+                                 << it.second.Cycles / profileResults.PassedIterations << " cycles, "
+                                 << it.second.Instructions / profileResults.PassedIterations << " instructions, "
+                                 << it.second.CacheMisses / profileResults.PassedIterations << " LLC misses, "
+                                 << it.second.GetBytesReadEstimate() / profileResults.PassedIterations << " bytes read" << Endl;
+        }
+    }
     MATRIXNET_NOTICE_LOG << Endl;
 }
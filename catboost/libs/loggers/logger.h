@@ -194,6 +194,10 @@ public:
         for (const auto& it : profileResults.OperationToTime) {
             Stream << it.first << ": " << FloatToString(it.second, PREC_NDIGITS, 3) << " sec" << Endl;
         }
+        for (const auto& it : profileResults.OperationToHardwareCounters) {
+            Stream << it.first << ": " << it.second.Cycles << " cycles, " << it.second.Instructions
+                << " instructions, " << it.second.CacheMisses << " LLC misses" << Endl;
+        }
         Stream << "Passed: " << FloatToString(profileResults.CurrentTime, PREC_NDIGITS, 3) << " sec" << Endl;
         if (profileResults.IsIterationGood) {
             Stream << "\ttotal: " << HumanReadable(TDuration::Seconds(profileResults.PassedTime));
@@ -253,9 +257,13 @@ public:
         for (const auto& it : profileResults.OperationToTime) {
             times[it.first] = it.second;
         }
+        if (!profileResults.OperationToHardwareCounters.empty()) {
+            AppendHardwareCounters(profileResults.OperationToHardwareCounters, /*averagePeriod*/ 1, &CurrentValue["hardware_counters"]);
+        }
 
         PassedIterations = profileResults.PassedIterations;
         OperationToTimeInAllIterations = profileResults.OperationToTimeInAllIterations;
+        OperationToHardwareCountersInAllIterations = profileResults.OperationToHardwareCountersInAllIterations;
     }
 
     void Flush(const int ) {
@@ -284,12 +292,27 @@ private:
         for (const auto& it : OperationToTimeInAllIterations) {
             times[it.first] = it.second / PassedIterations;
         }
+        if (!OperationToHardwareCountersInAllIterations.empty()) {
+            AppendHardwareCounters(OperationToHardwareCountersInAllIterations, PassedIterations, &CurrentValue["hardware_counters"]);
+        }
         *File << CurrentValue.GetStringRobust() << Endl;
     }
+
+    static void AppendHardwareCounters(const TMap<TString, THardwareCounters>& operationToCounters, int averagePeriod, NJson::TJsonValue* countersJson) {
+        for (const auto& it : operationToCounters) {
+            auto& operationJson = (*countersJson)[it.first];
+            operationJson["cycles"] = it.second.Cycles / averagePeriod;
+            operationJson["instructions"] = it.second.Instructions / averagePeriod;
+            operationJson["llc_misses"] = it.second.CacheMisses / averagePeriod;
+            operationJson["bytes_read_estimate"] = it.second.GetBytesReadEstimate() / averagePeriod;
+        }
+    }
+
     NJson::TJsonValue CurrentValue;
     THolder<TOFStream> File;
     int PassedIterations;
     TMap<TString, double> OperationToTimeInAllIterations;
+    TMap<TString, THardwareCounters> OperationToHardwareCountersInAllIterations;
 };
 
 
@@ -0,0 +1,93 @@
+#include "async_log_backend.h"
+
+#include <utility>
+
+TAsyncLogBackend::TAsyncLogBackend(THolder<TLogBackend> slave, size_t queueSizeLimit)
+    : Slave(std::move(slave))
+    , QueueSizeLimit(queueSizeLimit)
+    , WriterThread(WriterThreadProc, this)
+{
+    WriterThread.Start();
+}
+
+TAsyncLogBackend::~TAsyncLogBackend() {
+    try {
+        Stop();
+    } catch (...) {
+    }
+}
+
+void* TAsyncLogBackend::WriterThreadProc(void* self) {
+    static_cast<TAsyncLogBackend*>(self)->WriterLoop();
+    return nullptr;
+}
+
+void TAsyncLogBackend::WriterLoop() {
+    for (;;) {
+        TQueuedRecord record;
+        {
+            TGuard<TMutex> guard(Mutex);
+            while (Queue.empty() && !Finishing) {
+                QueueNotEmpty.WaitI(Mutex);
+            }
+            if (Queue.empty()) {
+                return;
+            }
+            record = std::move(Queue.front());
+            Queue.pop_front();
+            QueueNotFull.Signal();
+        }
+        Slave->WriteData(TLogRecord(record.Priority, record.Data.data(), record.Data.size()));
+    }
+}
+
+bool TAsyncLogBackend::DropOldestVerboseRecord() {
+    for (auto it = Queue.begin(); it != Queue.end(); ++it) {
+        if (it->Priority >= TLOG_DEBUG) {
+            Queue.erase(it);
+            return true;
+        }
+    }
+    return false;
+}
+
+void TAsyncLogBackend::WriteData(const TLogRecord& rec) {
+    TQueuedRecord record = {rec.Priority, TString(rec.Data, rec.Len)};
+    TGuard<TMutex> guard(Mutex);
+    while (Queue.size() >= QueueSizeLimit && !Finishing) {
+        if (DropOldestVerboseRecord()) {
+            break;
+        }
+        QueueNotFull.WaitI(Mutex);
+    }
+    Queue.push_back(std::move(record));
+    QueueNotEmpty.Signal();
+}
+
+void TAsyncLogBackend::ReopenLog() {
+    Slave->ReopenLog();
+}
+
+void TAsyncLogBackend::Stop() {
+    {
+        TGuard<TMutex> guard(Mutex);
+        if (Finishing) {
+            return;
+        }
+        Finishing = true;
+        QueueNotEmpty.Signal();
+        QueueNotFull.BroadCast();
+    }
+    WriterThread.Join();
+    // The writer only exits with an empty queue; records that raced in afterwards are
+    // flushed here, where no other thread touches the slave anymore.
+    for (const auto& record : Queue) {
+        Slave->WriteData(TLogRecord(record.Priority, record.Data.data(), record.Data.size()));
+    }
+    Queue.clear();
+}
+
+THolder<TLogBackend> TAsyncLogBackend::ReleaseSlave() {
+    Stop();
+    return std::move(Slave);
+}
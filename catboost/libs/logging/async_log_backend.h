@@ -0,0 +1,52 @@
+#pragma once
+
+#include <library/logger/backend.h>
+#include <library/logger/record.h>
+
+#include <util/generic/deque.h>
+#include <util/generic/ptr.h>
+#include <util/generic/string.h>
+#include <util/system/condvar.h>
+#include <util/system/mutex.h>
+#include <util/system/thread.h>
+
+/*
+ * Log backend that hands records over to a dedicated writer thread through a bounded
+ * queue, so the logging cost on the training thread is a queue push instead of a
+ * format-and-flush that can block on a full pipe. When the queue is full, the oldest
+ * verbose record (TLOG_DEBUG and below) is dropped to make room; metric and warning
+ * lines are never dropped — if only those are queued, the producer waits for the
+ * writer to catch up, which bounds both memory use and message loss.
+ */
+class TAsyncLogBackend: public TLogBackend {
+public:
+    explicit TAsyncLogBackend(THolder<TLogBackend> slave, size_t queueSizeLimit = 1 << 12);
+    ~TAsyncLogBackend() override;
+
+    void WriteData(const TLogRecord& rec) override;
+    void ReopenLog() override;
+
+    // Stops the writer thread, flushes everything queued and gives the wrapped backend back.
+    THolder<TLogBackend> ReleaseSlave();
+
+private:
+    struct TQueuedRecord {
+        ELogPriority Priority;
+        TString Data;
+    };
+
+    static void* WriterThreadProc(void* self);
+    void WriterLoop();
+    void Stop();
+    bool DropOldestVerboseRecord();
+
+private:
+    THolder<TLogBackend> Slave;
+    const size_t QueueSizeLimit;
+    TDeque<TQueuedRecord> Queue;
+    TMutex Mutex;
+    TCondVar QueueNotEmpty;
+    TCondVar QueueNotFull;
+    bool Finishing = false;
+    TThread WriterThread;
+};
@@ -0,0 +1,114 @@
+#include "hw_counters.h"
+#include "logging.h"
+
+#if defined(_linux_)
+
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <dirent.h>
+#include <errno.h>
+#include <string.h>
+
+static int PerfEventOpen(ui64 config, pid_t tid) {
+    perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = config;
+    attr.inherit = 1; // also count threads this one spawns later
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return syscall(__NR_perf_event_open, &attr, tid, /*cpu*/ -1, /*groupFd*/ -1, /*flags*/ 0);
+}
+
+static TVector<pid_t> ListProcessThreads() {
+    TVector<pid_t> tids;
+    DIR* taskDir = opendir("/proc/self/task");
+    if (taskDir == nullptr) {
+        return tids;
+    }
+    while (const dirent* entry = readdir(taskDir)) {
+        if (entry->d_name[0] != '.') {
+            tids.push_back(atoi(entry->d_name));
+        }
+    }
+    closedir(taskDir);
+    return tids;
+}
+
+bool THardwareCounterProfiler::Enable() {
+    if (IsEnabled()) {
+        return true;
+    }
+    const TVector<pid_t> tids = ListProcessThreads();
+    for (pid_t tid : tids) {
+        const int cycleFd = PerfEventOpen(PERF_COUNT_HW_CPU_CYCLES, tid);
+        const int instructionFd = PerfEventOpen(PERF_COUNT_HW_INSTRUCTIONS, tid);
+        const int cacheMissFd = PerfEventOpen(PERF_COUNT_HW_CACHE_MISSES, tid);
+        if (cycleFd < 0 || instructionFd < 0 || cacheMissFd < 0) {
+            const int openErrno = errno;
+            close(cycleFd);
+            close(instructionFd);
+            close(cacheMissFd);
+            Disable();
+            MATRIXNET_WARNING_LOG << "Hardware counters are unavailable (perf_event_open: "
+                << strerror(openErrno) << "); check kernel.perf_event_paranoid" << Endl;
+            return false;
+        }
+        CycleFds.push_back(cycleFd);
+        InstructionFds.push_back(instructionFd);
+        CacheMissFds.push_back(cacheMissFd);
+    }
+    return IsEnabled();
+}
+
+static ui64 SumCounterFds(const TVector<int>& fds) {
+    ui64 sum = 0;
+    for (int fd : fds) {
+        ui64 value = 0;
+        if (read(fd, &value, sizeof(value)) == sizeof(value)) {
+            sum += value;
+        }
+    }
+    return sum;
+}
+
+THardwareCounters THardwareCounterProfiler::Read() const {
+    THardwareCounters counters;
+    counters.Cycles = SumCounterFds(CycleFds);
+    counters.Instructions = SumCounterFds(InstructionFds);
+    counters.CacheMisses = SumCounterFds(CacheMissFds);
+    return counters;
+}
+
+void THardwareCounterProfiler::Disable() {
+    for (const auto* fds : {&CycleFds, &InstructionFds, &CacheMissFds}) {
+        for (int fd : *fds) {
+            close(fd);
+        }
+    }
+    CycleFds.clear();
+    InstructionFds.clear();
+    CacheMissFds.clear();
+}
+
+#else
+
+bool THardwareCounterProfiler::Enable() {
+    return false;
+}
+
+THardwareCounters THardwareCounterProfiler::Read() const {
+    return THardwareCounters();
+}
+
+void THardwareCounterProfiler::Disable() {
+}
+
+#endif
+
+THardwareCounterProfiler::~THardwareCounterProfiler() {
+    Disable();
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <util/generic/vector.h>
+#include <util/system/types.h>
+
+// Aggregated hardware counter readings for one training phase. The bytes-read estimate is
+// derived from last-level cache misses assuming 64-byte lines, which is what every CPU we
+// run on uses; it counts demand traffic to memory, not prefetches.
+struct THardwareCounters {
+    ui64 Cycles = 0;
+    ui64 Instructions = 0;
+    ui64 CacheMisses = 0;
+
+    THardwareCounters& operator+=(const THardwareCounters& rhs) {
+        Cycles += rhs.Cycles;
+        Instructions += rhs.Instructions;
+        CacheMisses += rhs.CacheMisses;
+        return *this;
+    }
+
+    THardwareCounters operator-(const THardwareCounters& rhs) const {
+        THardwareCounters result;
+        result.Cycles = Cycles - rhs.Cycles;
+        result.Instructions = Instructions - rhs.Instructions;
+        result.CacheMisses = CacheMisses - rhs.CacheMisses;
+        return result;
+    }
+
+    ui64 GetBytesReadEstimate() const {
+        return CacheMisses * 64;
+    }
+};
+
+// Samples cycle, instruction and last-level cache miss counts for all threads of the process
+// through perf_event. Enable() attaches to every thread alive at that moment and, via
+// inheritance, to the threads they spawn later; attach after the thread pool is up. When the
+// kernel interface is unavailable (non-Linux platform, restricted perf_event_paranoid) the
+// profiler stays disabled, Enable() returns false and Read() returns zeros.
+class THardwareCounterProfiler {
+public:
+    ~THardwareCounterProfiler();
+
+    bool Enable();
+    bool IsEnabled() const {
+        return !CycleFds.empty();
+    }
+    THardwareCounters Read() const;
+
+private:
+    void Disable();
+
+    TVector<int> CycleFds;
+    TVector<int> InstructionFds;
+    TVector<int> CacheMissFds;
+};
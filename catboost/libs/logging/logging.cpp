@@ -1,4 +1,5 @@
 #include "logging.h"
+#include "async_log_backend.h"
 
 #include <library/logger/filter.h>
 #include <library/logger/global/rty_formater.h>
@@ -97,9 +98,38 @@ void TCatboostLog::Output(const TCatboostLogEntry& entry) {
 }
 
 void TCatboostLog::ResetBackend(THolder<TLogBackend>&& backend) {
+    AsyncBackend = nullptr; // the wrapper goes away with the replaced backend
     ImplHolder->ResetBackend(backend);
 }
 
 void TCatboostLog::RestoreDefaultBackend() {
+    AsyncBackend = nullptr;
     ImplHolder->ResetBackend(CreateLogBackend("cout"));
 }
+
+void TCatboostLog::EnableAsyncOutput(size_t queueSizeLimit) {
+    if (AsyncBackend != nullptr) {
+        return;
+    }
+    THolder<TAsyncLogBackend> asyncBackend(new TAsyncLogBackend(ImplHolder->ReleaseBackend(), queueSizeLimit));
+    AsyncBackend = asyncBackend.Get();
+    ImplHolder->ResetBackend(asyncBackend.Release());
+}
+
+void TCatboostLog::DisableAsyncOutput() {
+    if (AsyncBackend == nullptr) {
+        return;
+    }
+    THolder<TAsyncLogBackend> asyncBackend(static_cast<TAsyncLogBackend*>(ImplHolder->ReleaseBackend().Release()));
+    Y_ASSERT(asyncBackend.Get() == AsyncBackend);
+    AsyncBackend = nullptr;
+    ImplHolder->ResetBackend(asyncBackend->ReleaseSlave());
+}
+
+TAsyncLogOutputGuard::TAsyncLogOutputGuard() {
+    TMatrixnetLogSettings::GetRef().Log.EnableAsyncOutput();
+}
+
+TAsyncLogOutputGuard::~TAsyncLogOutputGuard() {
+    TMatrixnetLogSettings::GetRef().Log.DisableAsyncOutput();
+}
@@ -31,6 +31,8 @@ public:
     const ELogPriority Priority;
 };
 
+class TAsyncLogBackend;
+
 class TCatboostLog {
 public:
     TCatboostLog();
@@ -38,9 +40,25 @@ public:
     void Output(const TCatboostLogEntry& entry);
     void ResetBackend(THolder<TLogBackend>&& backend);
     void RestoreDefaultBackend();
+
+    /* Wraps the current backend into TAsyncLogBackend so that logging costs the caller a
+     * queue push; see async_log_backend.h for the bounding and drop policy. Disabling
+     * flushes everything queued and restores the wrapped backend. No-ops when already
+     * in the requested state.
+     */
+    void EnableAsyncOutput(size_t queueSizeLimit = 1 << 12);
+    void DisableAsyncOutput();
 private:
     class TImpl;
     THolder<TImpl> ImplHolder;
+    TAsyncLogBackend* AsyncBackend = nullptr; // owned through ImplHolder when set
+};
+
+// Keeps async log output enabled for the lifetime of the scope, e.g. a training session.
+class TAsyncLogOutputGuard {
+public:
+    TAsyncLogOutputGuard();
+    ~TAsyncLogOutputGuard();
 };
 
 class TMatrixnetLogSettings {
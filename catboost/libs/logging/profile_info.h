@@ -1,5 +1,6 @@
 #pragma once
 
+#include "hw_counters.h"
 #include "logging.h"
 
 #include <util/ysaveload.h>
@@ -16,7 +17,9 @@ struct TProfileResults {
         double currentTime = 0,
         int passedIterations = 0,
         TMap<TString, double> operationToTime = {},
-        TMap<TString, double> operationToTimeInAllIterations = {}
+        TMap<TString, double> operationToTimeInAllIterations = {},
+        TMap<TString, THardwareCounters> operationToHardwareCounters = {},
+        TMap<TString, THardwareCounters> operationToHardwareCountersInAllIterations = {}
     )
         : PassedTime(passedTime)
         , RemainingTime(remainingTime)
@@ -25,6 +28,8 @@ struct TProfileResults {
         , PassedIterations(passedIterations)
         , OperationToTime(operationToTime)
         , OperationToTimeInAllIterations(operationToTimeInAllIterations)
+        , OperationToHardwareCounters(operationToHardwareCounters)
+        , OperationToHardwareCountersInAllIterations(operationToHardwareCountersInAllIterations)
     {
     }
 
@@ -35,6 +40,8 @@ struct TProfileResults {
     int PassedIterations;
     TMap<TString, double> OperationToTime;
     TMap<TString, double> OperationToTimeInAllIterations;
+    TMap<TString, THardwareCounters> OperationToHardwareCounters;
+    TMap<TString, THardwareCounters> OperationToHardwareCountersInAllIterations;
 };
 
 struct TProfileInfoData {
@@ -86,10 +93,23 @@ public:
         InitIterations = ProfileData.PassedIterations;
     }
 
+    // Per-phase hardware counters piggyback on the wall-time phase boundaries; the counter
+    // rollup is kept out of TProfileInfoData on purpose so the snapshot format does not change
+    // and a restarted run simply starts counting from zero.
+    void EnableHardwareCounters() {
+        if (HardwareProfiler.Enable()) {
+            LastHardwareCounters = HardwareProfiler.Read();
+        }
+    }
+
     void StartIterationBlock() {
         CurrentTime = 0;
         Timer.Reset();
         OperationToTime.clear();
+        OperationToHardwareCounters.clear();
+        if (HardwareProfiler.IsEnabled()) {
+            LastHardwareCounters = HardwareProfiler.Read();
+        }
     }
 
     void StartNextIteration() {
@@ -100,6 +120,21 @@ public:
         double passedTime = Timer.PassedReset();
         CurrentTime += passedTime;
         OperationToTime[operation] += passedTime; // operations can be repeated in one iteration
+        if (HardwareProfiler.IsEnabled()) {
+            const THardwareCounters counters = HardwareProfiler.Read();
+            OperationToHardwareCounters[operation] += counters - LastHardwareCounters;
+            LastHardwareCounters = counters;
+        }
+    }
+
+    /*
+     * Record an operation whose duration was measured by the caller, e.g. one task of a
+     * parallel section. The entry shows up in the profile log next to the regular phases
+     * but does not advance the phase timer: the surrounding wall time elapses concurrently
+     * and is still attributed to the enclosing AddOperation phase.
+     */
+    void AddMeasuredOperation(const TString& operation, double passedTime) {
+        OperationToTime[operation] += passedTime;
     }
 
     void FinishIterationBlock(int blockSize) {
@@ -118,6 +153,9 @@ public:
             for (const auto &it : OperationToTime) {
                 ProfileData.OperationToTimeInAllIterations[it.first] += it.second;
             }
+            for (const auto& it : OperationToHardwareCounters) {
+                OperationToHardwareCountersInAllIterations[it.first] += it.second;
+            }
             RemainingTime = LocalPassedTime / (ProfileData.PassedIterations - InitIterations - ProfileData.BadIterations) * (Iterations - ProfileData.PassedIterations);
         }
         IsIterationGood = (ProfileData.PassedIterations != InitIterations + ProfileData.BadIterations);
@@ -135,7 +173,9 @@ public:
             CurrentTime,
             ProfileData.PassedIterations,
             OperationToTime,
-            ProfileData.OperationToTimeInAllIterations
+            ProfileData.OperationToTimeInAllIterations,
+            OperationToHardwareCounters,
+            OperationToHardwareCountersInAllIterations
         };
     }
 
@@ -143,6 +183,10 @@ private:
     static constexpr int MAX_TIME_RATIO = 100;
     TProfileInfoData ProfileData;
     TMap<TString, double> OperationToTime;
+    TMap<TString, THardwareCounters> OperationToHardwareCounters;
+    TMap<TString, THardwareCounters> OperationToHardwareCountersInAllIterations;
+    THardwareCounterProfiler HardwareProfiler;
+    THardwareCounters LastHardwareCounters;
     THPTimer Timer;
     int InitIterations;
     bool IsIterationGood;
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <library/chromium_trace/global.h>
+#include <library/chromium_trace/guard.h>
+
+#include <util/generic/strbuf.h>
+#include <util/generic/string.h>
+
+//Hierarchical scope profiler on top of library/chromium_trace. While a session is
+//alive every TTraceProfilerScope (and every cuda profiler label) is emitted as a
+//chromium trace event carrying its thread id, so CPU phases and GPU stream labels
+//from the same run line up on one timeline in Perfetto / chrome://tracing.
+//Without a session a scope costs a single null check on the global tracer.
+
+class TTraceProfilerSession {
+public:
+    explicit TTraceProfilerSession(const TString& outputFile)
+        : JsonSink(outputFile)
+    {
+    }
+
+private:
+    NChromiumTrace::TGlobalJsonFileSink JsonSink;
+};
+
+//nestable labeled RAII scope; the name must outlive the scope (string literals do)
+class TTraceProfilerScope {
+public:
+    explicit TTraceProfilerScope(TStringBuf name, TStringBuf category = AsStringBuf("cpu"))
+        : Guard(NChromiumTrace::GetGlobalTracer(), name, category)
+    {
+    }
+
+private:
+    NChromiumTrace::TCompleteEventGuard Guard;
+};
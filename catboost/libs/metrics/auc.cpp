@@ -1,6 +1,7 @@
 #include "auc.h"
 
 #include <util/generic/algorithm.h>
+#include <util/generic/bitops.h>
 
 using NMetrics::TSample;
 
@@ -76,3 +77,73 @@ double CalcAUC(TVector<TSample>* samples, double* outWeightSum, double* outPairW
     return (optimisticAUC + pessimisticAUC) / 2.0;
 }
 
+double CalcApproxAUC(const TVector<TSample>& samples, NPar::TLocalExecutor* localExecutor) {
+    const int sampleCount = samples.ysize();
+    if (sampleCount == 0) {
+        return 0;
+    }
+
+    // The resolution never needs to exceed the sample count; a power of two keeps bucket scaling cheap.
+    const ui32 bucketCount = Min<ui32>(ui32(1) << 20, FastClp2(static_cast<ui32>(sampleCount)));
+    // Bounds the memory spent on partial histograms: each block owns two arrays of bucketCount doubles.
+    const int maxBlockCount = 16;
+
+    NPar::TLocalExecutor::TExecRangeParams blockParams(0, sampleCount);
+    blockParams.SetBlockSize(Max<int>(bucketCount, (sampleCount + maxBlockCount - 1) / maxBlockCount));
+    const int blockCount = blockParams.GetBlockCount();
+    const int blockSize = blockParams.GetBlockSize();
+
+    TVector<double> blockMinPrediction(blockCount, samples[0].Prediction);
+    TVector<double> blockMaxPrediction(blockCount, samples[0].Prediction);
+    localExecutor->ExecRange([&](int blockIdx) {
+        const int blockStart = blockIdx * blockSize;
+        const int blockEnd = Min(blockStart + blockSize, sampleCount);
+        double minPrediction = samples[blockStart].Prediction;
+        double maxPrediction = samples[blockStart].Prediction;
+        for (int i = blockStart; i < blockEnd; ++i) {
+            minPrediction = Min(minPrediction, samples[i].Prediction);
+            maxPrediction = Max(maxPrediction, samples[i].Prediction);
+        }
+        blockMinPrediction[blockIdx] = minPrediction;
+        blockMaxPrediction[blockIdx] = maxPrediction;
+    }, 0, blockCount, NPar::TLocalExecutor::WAIT_COMPLETE);
+
+    const double minPrediction = *MinElement(blockMinPrediction.begin(), blockMinPrediction.end());
+    const double maxPrediction = *MaxElement(blockMaxPrediction.begin(), blockMaxPrediction.end());
+    const double scale = minPrediction < maxPrediction ? bucketCount / (maxPrediction - minPrediction) : 0.0;
+
+    TVector<TVector<double>> blockPositiveWeight(blockCount, TVector<double>(bucketCount));
+    TVector<TVector<double>> blockNegativeWeight(blockCount, TVector<double>(bucketCount));
+    localExecutor->ExecRange([&](int blockIdx) {
+        const int blockStart = blockIdx * blockSize;
+        const int blockEnd = Min(blockStart + blockSize, sampleCount);
+        TVector<double>& positiveWeight = blockPositiveWeight[blockIdx];
+        TVector<double>& negativeWeight = blockNegativeWeight[blockIdx];
+        for (int i = blockStart; i < blockEnd; ++i) {
+            const TSample& sample = samples[i];
+            const ui32 bucketIdx = Min(bucketCount - 1, static_cast<ui32>((sample.Prediction - minPrediction) * scale));
+            (sample.Target > 0 ? positiveWeight : negativeWeight)[bucketIdx] += sample.Weight;
+        }
+    }, 0, blockCount, NPar::TLocalExecutor::WAIT_COMPLETE);
+
+    double auc = 0;
+    double positiveWeightSum = 0;
+    double negativeWeightSum = 0;
+    for (ui32 bucketIdx = 0; bucketIdx < bucketCount; ++bucketIdx) {
+        double positiveWeight = 0;
+        double negativeWeight = 0;
+        for (int blockIdx = 0; blockIdx < blockCount; ++blockIdx) {
+            positiveWeight += blockPositiveWeight[blockIdx][bucketIdx];
+            negativeWeight += blockNegativeWeight[blockIdx][bucketIdx];
+        }
+        auc += positiveWeight * (negativeWeightSum + negativeWeight / 2.0);
+        positiveWeightSum += positiveWeight;
+        negativeWeightSum += negativeWeight;
+    }
+    const double pairWeightSum = positiveWeightSum * negativeWeightSum;
+    if (pairWeightSum == 0) {
+        return 0;
+    }
+    return auc / pairWeightSum;
+}
+
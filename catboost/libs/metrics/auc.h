@@ -2,4 +2,16 @@
 
 #include "sample.h"
 
+#include <library/threading/local_executor/local_executor.h>
+
 double CalcAUC(TVector<NMetrics::TSample>* samples, double* outWeightSum = nullptr, double* outPairWeightSum = nullptr);
+
+/*
+ * Approximate AUC for binary targets (Target is 0 or 1): accumulates fixed-resolution per-class
+ * prediction histograms block-parallel and evaluates AUC with a single pass over the buckets,
+ * so no sorting of the samples is needed and the working memory does not depend on the sample count.
+ * Cross-class pairs sharing a bucket are credited 0.5, which is exactly how CalcAUC treats tied
+ * predictions; the error is therefore bounded by half the pair weight of unequal predictions
+ * falling into the same bucket.
+ */
+double CalcApproxAUC(const TVector<NMetrics::TSample>& samples, NPar::TLocalExecutor* localExecutor);
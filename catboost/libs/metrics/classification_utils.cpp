@@ -1,26 +1,6 @@
+#include "classification_utils.h"
 #include "metric_holder.h"
 
-#include <util/generic/array_ref.h>
-#include <util/generic/vector.h>
-
-/* Classification helpers */
-
-int GetApproxClass(TConstArrayRef<TVector<double>> approx, int docIdx) {
-    if (approx.size() == 1) {
-        return approx[0][docIdx] > 0.0;
-    }
-    double maxApprox = approx[0][docIdx];
-    int maxApproxIndex = 0;
-
-    for (size_t dim = 1; dim < approx.size(); ++dim) {
-        if (approx[dim][docIdx] > maxApprox) {
-            maxApprox = approx[dim][docIdx];
-            maxApproxIndex = dim;
-        }
-    }
-    return maxApproxIndex;
-}
-
 void GetPositiveStats(
         TConstArrayRef<TVector<double>> approx,
         TConstArrayRef<float> target,
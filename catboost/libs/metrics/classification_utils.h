@@ -1,10 +1,29 @@
 #pragma once
 
-#include <util/generic/fwd.h>
+#include <util/generic/array_ref.h>
+#include <util/generic/vector.h>
 
 struct TMetricHolder;
 
-int GetApproxClass(TConstArrayRef<TVector<double>> approx, int docIdx);
+/* Classification helpers */
+
+// Inline on purpose: every classification metric calls this per document each iteration,
+// an out-of-line call here is measurable when several such metrics are evaluated.
+inline int GetApproxClass(TConstArrayRef<TVector<double>> approx, int docIdx) {
+    if (approx.size() == 1) {
+        return approx[0][docIdx] > 0.0;
+    }
+    double maxApprox = approx[0][docIdx];
+    int maxApproxIndex = 0;
+
+    for (size_t dim = 1; dim < approx.size(); ++dim) {
+        if (approx[dim][docIdx] > maxApprox) {
+            maxApprox = approx[dim][docIdx];
+            maxApproxIndex = dim;
+        }
+    }
+    return maxApproxIndex;
+}
 
 void GetPositiveStats(
         TConstArrayRef<TVector<double>> approx,
@@ -28,26 +28,33 @@ double CalcDCGSorted(TConstArrayRef<TSample> samples, TMaybe<double> expDecay) {
 }
 }
 
-double CalcDCG(TConstArrayRef<TSample> samplesRef, TMaybe<double> expDecay = Nothing()) {
-    TVector<TSample> samples(samplesRef.begin(), samplesRef.end());
-    Sort(samples.begin(), samples.end(), [](const TSample& left, const TSample& right) {
+double CalcDCG(TVector<TSample>* samples, TMaybe<double> expDecay) {
+    Sort(samples->begin(), samples->end(), [](const TSample& left, const TSample& right) {
         return CompareDocs(left.Prediction, right.Target, right.Prediction, left.Target);
     });
-    auto optimisticDCG = CalcDCGSorted(samples, expDecay);
-    Sort(samples.begin(), samples.end(), [](const TSample& left, const TSample& right) {
+    auto optimisticDCG = CalcDCGSorted(*samples, expDecay);
+    Sort(samples->begin(), samples->end(), [](const TSample& left, const TSample& right) {
         return CompareDocs(left.Prediction, left.Target, right.Prediction, right.Target);
     });
-    auto pessimisticDCG = CalcDCGSorted(samples, expDecay);
+    auto pessimisticDCG = CalcDCGSorted(*samples, expDecay);
     return (optimisticDCG + pessimisticDCG) / 2;
 }
 
-double CalcIDCG(TConstArrayRef<TSample> samplesRef, TMaybe<double> expDecay = Nothing()) {
+double CalcDCG(TConstArrayRef<TSample> samplesRef, TMaybe<double> expDecay = Nothing()) {
     TVector<TSample> samples(samplesRef.begin(), samplesRef.end());
+    return CalcDCG(&samples, expDecay);
+}
 
-    Sort(samples.begin(), samples.end(), [](const TSample& left, const TSample& right) {
+double CalcIDCG(TVector<TSample>* samples, TMaybe<double> expDecay) {
+    Sort(samples->begin(), samples->end(), [](const TSample& left, const TSample& right) {
         return left.Target > right.Target;
     });
-    return CalcDCGSorted(samples, expDecay);
+    return CalcDCGSorted(*samples, expDecay);
+}
+
+double CalcIDCG(TConstArrayRef<TSample> samplesRef, TMaybe<double> expDecay = Nothing()) {
+    TVector<TSample> samples(samplesRef.begin(), samplesRef.end());
+    return CalcIDCG(&samples, expDecay);
 }
 
 
@@ -12,3 +12,8 @@ double CalcNDCG(TConstArrayRef<NMetrics::TSample> samples);
 
 double CalcDCG(TConstArrayRef<NMetrics::TSample> samples, TMaybe<double> expDecay = {});
 double CalcIDCG(TConstArrayRef<NMetrics::TSample> samples, TMaybe<double> expDecay = {});
+
+// In-place variants: sort the caller's buffer instead of copying it, so per-query loops can
+// reuse one buffer and evaluate without any allocation.
+double CalcDCG(TVector<NMetrics::TSample>* samples, TMaybe<double> expDecay = {});
+double CalcIDCG(TVector<NMetrics::TSample>* samples, TMaybe<double> expDecay = {});
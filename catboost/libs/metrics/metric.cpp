@@ -14,6 +14,7 @@
 #include <util/generic/ymath.h>
 #include <util/generic/string.h>
 #include <util/generic/maybe.h>
+#include <util/random/fast.h>
 #include <util/string/iterator.h>
 #include <util/string/cast.h>
 #include <util/string/printf.h>
@@ -679,6 +680,16 @@ TMetricHolder TPFoundMetric::EvalSingleThread(
     int queryStartIndex,
     int queryEndIndex
 ) const {
+    TVector<TVector<int>>* cachedOrders;
+    with_lock (OrderCacheLock) {
+        TVector<TVector<int>>& datasetOrders = OrderCache[target.data()];
+        if (datasetOrders.ysize() != queriesInfo.ysize()) {
+            datasetOrders.clear();
+            datasetOrders.resize(queriesInfo.size());
+        }
+        cachedOrders = &datasetOrders;
+    }
+
     TPFoundCalcer calcer(TopSize, Decay);
     for (int queryIndex = queryStartIndex; queryIndex < queryEndIndex; ++queryIndex) {
         int queryBegin = queriesInfo[queryIndex].Begin;
@@ -688,7 +699,7 @@ TMetricHolder TPFoundMetric::EvalSingleThread(
         if (!queriesInfo[queryIndex].SubgroupId.empty()) {
             subgroupIdData = queriesInfo[queryIndex].SubgroupId.data();
         }
-        calcer.AddQuery(target.data() + queryBegin, approx[0].data() + queryBegin, queryWeight, subgroupIdData, queryEnd - queryBegin);
+        calcer.AddQuery(target.data() + queryBegin, approx[0].data() + queryBegin, queryWeight, subgroupIdData, queryEnd - queryBegin, &(*cachedOrders)[queryIndex]);
     }
     return calcer.GetMetric();
 }
@@ -732,7 +743,19 @@ TMetricHolder TNDCGMetric::EvalSingleThread(
     int queryStartIndex,
     int queryEndIndex
 ) const {
+    TVector<double>* cachedIdcgs;
+    with_lock (IdcgCacheLock) {
+        TVector<double>& datasetIdcgs = IdcgCache[target.data()];
+        if (datasetIdcgs.ysize() != queriesInfo.ysize()) {
+            datasetIdcgs.assign(queriesInfo.size(), -1.0);
+        }
+        cachedIdcgs = &datasetIdcgs;
+    }
+
     TMetricHolder error(2);
+    // The pool is query-contiguous, so the samples are gathered with unit stride into one
+    // buffer reused for every query of the block.
+    TVector<NMetrics::TSample> samples;
     for (int queryIndex = queryStartIndex; queryIndex < queryEndIndex; ++queryIndex) {
         int queryBegin = queriesInfo[queryIndex].Begin;
         int queryEnd = queriesInfo[queryIndex].End;
@@ -740,10 +763,16 @@ TMetricHolder TNDCGMetric::EvalSingleThread(
         const float queryWeight = queriesInfo[queryIndex].Weight;
         size_t sampleSize = (TopSize < 0 || querySize < TopSize) ? querySize : static_cast<size_t>(TopSize);
 
-        TVector<double> approxCopy(approx[0].data() + queryBegin, approx[0].data() + queryBegin + sampleSize);
-        TVector<double> targetCopy(target.data() + queryBegin, target.data() + queryBegin + sampleSize);
-        TVector<NMetrics::TSample> samples = NMetrics::TSample::FromVectors(targetCopy, approxCopy);
-        error.Stats[0] += queryWeight * CalcNDCG(samples);
+        samples.clear();
+        for (size_t docId = 0; docId < sampleSize; ++docId) {
+            samples.emplace_back(target[queryBegin + docId], approx[0][queryBegin + docId]);
+        }
+        double& idcg = (*cachedIdcgs)[queryIndex];
+        if (idcg < 0) {
+            idcg = CalcIDCG(&samples);
+        }
+        const double dcg = CalcDCG(&samples);
+        error.Stats[0] += queryWeight * (idcg > 0 ? dcg / idcg : 0);
         error.Stats[1] += queryWeight;
     }
     return error;
@@ -907,16 +936,19 @@ void TR2Metric::GetBestValue(EMetricBestValue* valueType, float*) const {
 
 /* AUC */
 
-THolder<TAUCMetric> TAUCMetric::CreateBinClassMetric(double border) {
-    return new TAUCMetric(border);
+THolder<TAUCMetric> TAUCMetric::CreateBinClassMetric(double border, bool approximate) {
+    auto metric = new TAUCMetric(border);
+    metric->Approximate = approximate;
+    return metric;
 }
 
-THolder<TAUCMetric> TAUCMetric::CreateMultiClassMetric(int positiveClass) {
+THolder<TAUCMetric> TAUCMetric::CreateMultiClassMetric(int positiveClass, bool approximate) {
     CB_ENSURE(positiveClass >= 0, "Class id should not be negative");
 
     auto metric = new TAUCMetric();
     metric->PositiveClass = positiveClass;
     metric->IsMultiClass = true;
+    metric->Approximate = approximate;
     return metric;
 }
 
@@ -927,7 +959,7 @@ TMetricHolder TAUCMetric::Eval(
     const TVector<TQueryInfo>& /*queriesInfo*/,
     int begin,
     int end,
-    NPar::TLocalExecutor& /* executor */
+    NPar::TLocalExecutor& executor
 ) const {
     Y_ASSERT((approx.size() > 1) == IsMultiClass);
     const auto& approxVec = approx.ysize() == 1 ? approx.front() : approx[PositiveClass];
@@ -958,17 +990,22 @@ TMetricHolder TAUCMetric::Eval(
     }
 
     TMetricHolder error(2);
-    error.Stats[0] = CalcAUC(&samples);
+    error.Stats[0] = Approximate ? CalcApproxAUC(samples, &executor) : CalcAUC(&samples);
     error.Stats[1] = 1.0;
     return error;
 }
 
 TString TAUCMetric::GetDescription() const {
+    TString description;
     if (IsMultiClass) {
-        return Sprintf("%s:class=%d", ToString(ELossFunction::AUC).c_str(), PositiveClass);
+        description = Sprintf("%s:class=%d", ToString(ELossFunction::AUC).c_str(), PositiveClass);
     } else {
-        return AddBorderIfNotDefault(ToString(ELossFunction::AUC), Border);
+        description = AddBorderIfNotDefault(ToString(ELossFunction::AUC), Border);
     }
+    if (Approximate) {
+        description += ":approximate=true";
+    }
+    return description;
 }
 
 void TAUCMetric::GetBestValue(EMetricBestValue* valueType, float*) const {
@@ -1950,13 +1987,15 @@ static TVector<THolder<IMetric>> CreateMetric(ELossFunction metric, TMap<TString
             break;
 
         case ELossFunction::AUC: {
+            const bool approximate = params.has("approximate") && FromString<bool>(params.at("approximate"));
             if (approxDimension == 1) {
-                result.emplace_back(TAUCMetric::CreateBinClassMetric(border));
-                validParams = {"border"};
+                result.emplace_back(TAUCMetric::CreateBinClassMetric(border, approximate));
+                validParams = {"border", "approximate"};
             } else {
                 for (int i = 0; i < approxDimension; ++i) {
-                    result.emplace_back(TAUCMetric::CreateMultiClassMetric(i));
+                    result.emplace_back(TAUCMetric::CreateMultiClassMetric(i, approximate));
                 }
+                validParams = {"approximate"};
             }
             break;
         }
@@ -2197,6 +2236,17 @@ TVector<bool> GetSkipMetricOnTrain(const TVector<const IMetric*>& metrics) {
     return result;
 }
 
+TMetricHolder IMetric::EvalBlock(
+    const TVector<TVector<double>>& /*approx*/,
+    const TVector<float>& /*target*/,
+    const TVector<float>& /*weight*/,
+    const TVector<TQueryInfo>& /*queriesInfo*/,
+    int /*begin*/,
+    int /*end*/
+) const {
+    CB_ENSURE(false, "Metric " << GetDescription() << " does not support block evaluation.");
+}
+
 double EvalErrors(
         const TVector<TVector<double>>& approx,
         const TVector<float>& target,
@@ -2218,6 +2268,143 @@ double EvalErrors(
     return error->GetFinalError(metric);
 }
 
+TVector<double> EvalErrorsFused(
+    const TVector<const IMetric*>& metrics,
+    const TVector<TVector<double>>& approx,
+    const TVector<float>& target,
+    const TVector<float>& weight,
+    const TVector<TQueryInfo>& queriesInfo,
+    NPar::TLocalExecutor* localExecutor
+) {
+    return EvalErrorsFusedWithBootstrap(metrics, approx, target, weight, queriesInfo,
+                                        /*replicateCount*/ 0, /*randomSeed*/ 0,
+                                        /*confidenceIntervals*/ nullptr, localExecutor);
+}
+
+static inline int SamplePoisson1(TFastRng64* rng) {
+    // Inversion for Poisson(1); the tail past 8 has negligible mass.
+    const double u = rng->GenRandReal1();
+    double p = exp(-1.0);
+    double cdf = p;
+    int k = 0;
+    while (u > cdf && k < 8) {
+        ++k;
+        p /= k;
+        cdf += p;
+    }
+    return k;
+}
+
+static void AddScaled(const TMetricHolder& other, int weight, TMetricHolder* result) {
+    if (result->Stats.empty()) {
+        result->Stats.resize(other.Stats.size());
+    }
+    Y_ASSERT(result->Stats.size() == other.Stats.size());
+    for (int statIdx = 0; statIdx < other.Stats.ysize(); ++statIdx) {
+        result->Stats[statIdx] += weight * other.Stats[statIdx];
+    }
+}
+
+TVector<double> EvalErrorsFusedWithBootstrap(
+    const TVector<const IMetric*>& metrics,
+    const TVector<TVector<double>>& approx,
+    const TVector<float>& target,
+    const TVector<float>& weight,
+    const TVector<TQueryInfo>& queriesInfo,
+    int replicateCount,
+    ui64 randomSeed,
+    TVector<TMetricConfidenceInterval>* confidenceIntervals,
+    NPar::TLocalExecutor* localExecutor
+) {
+    if (metrics.empty()) {
+        if (confidenceIntervals != nullptr) {
+            confidenceIntervals->clear();
+        }
+        return {};
+    }
+    for (const IMetric* metric : metrics) {
+        CB_ENSURE(metric->IsAdditiveMetric() && metric->GetErrorType() == EErrorType::PerObjectError,
+                  "Fused evaluation supports only additive per-object metrics, got " << metric->GetDescription());
+    }
+    const int begin = 0;
+    const int end = target.ysize();
+    Y_VERIFY(approx[0].ysize() == end - begin);
+
+    // Keep the blocking identical to TAdditiveMetric::Eval: a 10000-document block of approx,
+    // target and weight stays in cache while every metric consumes it, and merging the partial
+    // sums in block id order reproduces each metric's standalone result exactly.
+    NPar::TLocalExecutor::TExecRangeParams blockParams(begin, end);
+    const int MinBlockSize = 10000;
+    blockParams.SetBlockSize(MinBlockSize);
+
+    const int blockSize = blockParams.GetBlockSize();
+    const ui32 blockCount = blockParams.GetBlockCount();
+
+    TVector<TVector<TMetricHolder>> blockResults(blockCount, TVector<TMetricHolder>(metrics.size()));
+    NPar::ParallelFor(*localExecutor, 0, blockCount, [&](int blockId) {
+        const int from = begin + blockId * blockSize;
+        const int to = Min<int>(begin + (blockId + 1) * blockSize, end);
+        Y_ASSERT(from < to);
+        for (int metricIdx = 0; metricIdx < metrics.ysize(); ++metricIdx) {
+            blockResults[blockId][metricIdx] = metrics[metricIdx]->EvalBlock(approx, target, weight, queriesInfo, from, to);
+        }
+    });
+
+    TVector<double> errors;
+    errors.reserve(metrics.size());
+    const bool compensatedMerge = UseCompensatedAccumulation();
+    for (int metricIdx = 0; metricIdx < metrics.ysize(); ++metricIdx) {
+        TMetricHolder result;
+        TVector<double> compensation;
+        for (ui32 blockId = 0; blockId < blockCount; ++blockId) {
+            if (compensatedMerge) {
+                result.AddCompensated(blockResults[blockId][metricIdx], &compensation);
+            } else {
+                result.Add(blockResults[blockId][metricIdx]);
+            }
+        }
+        errors.push_back(metrics[metricIdx]->GetFinalError(result));
+    }
+
+    if (confidenceIntervals != nullptr) {
+        confidenceIntervals->assign(metrics.size(), TMetricConfidenceInterval());
+        if (replicateCount > 0 && blockCount > 1) {
+            /* The resampling weight of a block is drawn from a stream seeded by the block id
+             * alone, so the intervals do not depend on the thread schedule and are comparable
+             * across iterations of the same fit. */
+            TVector<TVector<int>> blockWeights(blockCount, TVector<int>(replicateCount));
+            for (ui32 blockId = 0; blockId < blockCount; ++blockId) {
+                TFastRng64 rng(randomSeed + blockId);
+                for (int replicate = 0; replicate < replicateCount; ++replicate) {
+                    blockWeights[blockId][replicate] = SamplePoisson1(&rng);
+                }
+            }
+            TVector<double> replicateErrors(replicateCount);
+            for (int metricIdx = 0; metricIdx < metrics.ysize(); ++metricIdx) {
+                for (int replicate = 0; replicate < replicateCount; ++replicate) {
+                    TMetricHolder resampled;
+                    for (ui32 blockId = 0; blockId < blockCount; ++blockId) {
+                        const int blockWeight = blockWeights[blockId][replicate];
+                        if (blockWeight != 0) {
+                            AddScaled(blockResults[blockId][metricIdx], blockWeight, &resampled);
+                        }
+                    }
+                    replicateErrors[replicate] = metrics[metricIdx]->GetFinalError(resampled);
+                }
+                Sort(replicateErrors.begin(), replicateErrors.end());
+                (*confidenceIntervals)[metricIdx].Lower = replicateErrors[int(0.025 * (replicateCount - 1))];
+                (*confidenceIntervals)[metricIdx].Upper = replicateErrors[int(ceil(0.975 * (replicateCount - 1)))];
+            }
+        } else {
+            for (int metricIdx = 0; metricIdx < metrics.ysize(); ++metricIdx) {
+                (*confidenceIntervals)[metricIdx].Lower = errors[metricIdx];
+                (*confidenceIntervals)[metricIdx].Upper = errors[metricIdx];
+            }
+        }
+    }
+    return errors;
+}
+
 
 static inline double BestQueryShift(const double* cursor,
                                     const float* targets,
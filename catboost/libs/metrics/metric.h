@@ -14,6 +14,7 @@
 #include <library/containers/2d_array/2d_array.h>
 
 #include <util/generic/hash.h>
+#include <util/system/spinlock.h>
 
 #include <cmath>
 
@@ -75,6 +76,17 @@ struct IMetric {
     virtual bool IsAdditiveMetric() const = 0;
     virtual const TMap<TString, TString>& GetHints() const = 0;
     virtual void AddHint(const TString& key, const TString& value) = 0;
+    //! Evaluates the metric on [begin, end) in the calling thread without spawning tasks.
+    //! Supported only by additive metrics; fused multi-metric evaluation uses it to feed
+    //! every metric one cache-resident block at a time.
+    virtual TMetricHolder EvalBlock(
+        const TVector<TVector<double>>& approx,
+        const TVector<float>& target,
+        const TVector<float>& weight,
+        const TVector<TQueryInfo>& queriesInfo,
+        int begin,
+        int end
+    ) const;
     virtual ~IMetric()
     {
     }
@@ -103,11 +115,11 @@ struct TAdditiveMetric: public TMetric {
     ) const final {
         NPar::TLocalExecutor::TExecRangeParams blockParams(begin, end);
 
-        const int threadCount = executor.GetThreadCount() + 1;
+        /* Block boundaries must depend on the data size only: partial sums are merged in block id
+         * order, so a fixed partitioning keeps metric values bit-identical for any thread count.
+         */
         const int MinBlockSize = 10000;
-        const int effectiveBlockCount = Min(threadCount, (int)ceil((end - begin) * 1.0 / MinBlockSize));
-
-        blockParams.SetBlockCount(effectiveBlockCount);
+        blockParams.SetBlockSize(MinBlockSize);
 
         const int blockSize = blockParams.GetBlockSize();
         const ui32 blockCount = blockParams.GetBlockCount();
@@ -121,8 +133,15 @@ struct TAdditiveMetric: public TMetric {
         });
 
         TMetricHolder result;
-        for (int i = 0; i < results.ysize(); ++i) {
-            result.Add(results[i]);
+        if (UseCompensatedAccumulation()) {
+            TVector<double> compensation;
+            for (int i = 0; i < results.ysize(); ++i) {
+                result.AddCompensated(results[i], &compensation);
+            }
+        } else {
+            for (int i = 0; i < results.ysize(); ++i) {
+                result.Add(results[i]);
+            }
         }
         return result;
     }
@@ -130,6 +149,17 @@ struct TAdditiveMetric: public TMetric {
     bool IsAdditiveMetric() const final {
         return true;
     }
+
+    TMetricHolder EvalBlock(
+        const TVector<TVector<double>>& approx,
+        const TVector<float>& target,
+        const TVector<float>& weight,
+        const TVector<TQueryInfo>& queriesInfo,
+        int begin,
+        int end
+    ) const final {
+        return static_cast<const TImpl*>(this)->EvalSingleThread(approx, target, weight, queriesInfo, begin, end);
+    }
 };
 
 struct TNonAdditiveMetric: public TMetric {
@@ -408,6 +438,12 @@ struct TPFoundMetric : public TAdditiveMetric<TPFoundMetric> {
 private:
     int TopSize;
     double Decay;
+    /* Per-query sorted orders from the previous evaluation, keyed by the target data pointer
+     * that identifies the dataset. The lock only protects per-dataset slot creation; parallel
+     * evaluation blocks own disjoint query ranges and touch disjoint entries.
+     */
+    mutable TAdaptiveLock OrderCacheLock;
+    mutable THashMap<const float*, TVector<TVector<int>>> OrderCache;
 };
 
 struct TNDCGMetric: public TAdditiveMetric<TNDCGMetric> {
@@ -426,6 +462,11 @@ struct TNDCGMetric: public TAdditiveMetric<TNDCGMetric> {
     virtual void GetBestValue(EMetricBestValue* valueType, float* bestValue) const override;
 private:
     int TopSize;
+    /* IDCG depends on the targets only, so it is computed once per query per dataset
+     * (keyed by the target data pointer) and reused on every subsequent evaluation.
+     */
+    mutable TAdaptiveLock IdcgCacheLock;
+    mutable THashMap<const float*, TVector<double>> IdcgCache;
 };
 
 struct TQuerySoftMaxMetric : public TAdditiveMetric<TQuerySoftMaxMetric> {
@@ -452,8 +493,8 @@ private:
 };
 
 struct TAUCMetric: public TNonAdditiveMetric {
-    static THolder<TAUCMetric> CreateBinClassMetric(double border = GetDefaultClassificationBorder());
-    static THolder<TAUCMetric> CreateMultiClassMetric(int positiveClass);
+    static THolder<TAUCMetric> CreateBinClassMetric(double border = GetDefaultClassificationBorder(), bool approximate = false);
+    static THolder<TAUCMetric> CreateMultiClassMetric(int positiveClass, bool approximate = false);
     virtual TMetricHolder Eval(
         const TVector<TVector<double>>& approx,
         const TVector<float>& target,
@@ -468,6 +509,7 @@ private:
     int PositiveClass = 1;
     bool IsMultiClass = false;
     double Border = GetDefaultClassificationBorder();
+    bool Approximate = false;
 
     explicit TAUCMetric(double border = GetDefaultClassificationBorder())
             : Border(border)
@@ -899,6 +941,48 @@ double EvalErrors(
     NPar::TLocalExecutor* localExecutor
 );
 
+/*
+ * Evaluates several additive per-object metrics in a single sweep over approx/target/weight:
+ * the documents are processed in cache-resident blocks and every metric consumes a block while
+ * it is hot, so the data is read from memory once no matter how many metrics are requested.
+ * Blocking and merge order match TAdditiveMetric::Eval, so each returned value is bit-identical
+ * to the standalone evaluation of that metric.
+ */
+TVector<double> EvalErrorsFused(
+    const TVector<const IMetric*>& metrics,
+    const TVector<TVector<double>>& approx,
+    const TVector<float>& target,
+    const TVector<float>& weight,
+    const TVector<TQueryInfo>& queriesInfo,
+    NPar::TLocalExecutor* localExecutor
+);
+
+struct TMetricConfidenceInterval {
+    double Lower = 0.0;
+    double Upper = 0.0;
+};
+
+/*
+ * Same fused sweep as EvalErrorsFused, but additionally estimates a 95% confidence interval
+ * for every metric by block bootstrap: the per-block partial sums that the fused sweep already
+ * materializes are resampled into replicateCount alternative aggregates with deterministic
+ * Poisson(1) weights, so the intervals cost a handful of scalar additions per block instead of
+ * a second pass over the documents. The point estimates are untouched and stay bit-identical
+ * to EvalErrorsFused. When there are fewer than two blocks the intervals degenerate to the
+ * point estimates.
+ */
+TVector<double> EvalErrorsFusedWithBootstrap(
+    const TVector<const IMetric*>& metrics,
+    const TVector<TVector<double>>& approx,
+    const TVector<float>& target,
+    const TVector<float>& weight,
+    const TVector<TQueryInfo>& queriesInfo,
+    int replicateCount,
+    ui64 randomSeed,
+    TVector<TMetricConfidenceInterval>* confidenceIntervals,
+    NPar::TLocalExecutor* localExecutor
+);
+
 inline bool IsMaxOptimal(const IMetric& metric) {
     EMetricBestValue bestValueType;
     float bestPossibleValue;
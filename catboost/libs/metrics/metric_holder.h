@@ -1,5 +1,7 @@
 #pragma once
 
+#include <catboost/libs/helpers/compensated_sum.h>
+
 #include <util/generic/vector.h>
 #include <util/system/yassert.h>
 
@@ -21,5 +23,23 @@ struct TMetricHolder {
             Stats[i] += other.Stats[i];
         }
     }
+
+    // Kahan-compensated Add for the long block-merge chains (one compensation lane per
+    // stat, owned by the caller and reused across the whole chain).
+    void AddCompensated(const TMetricHolder& other, TVector<double>* compensation) {
+        Y_VERIFY(Stats.empty() || other.Stats.empty() || Stats.size() == other.Stats.size());
+        if (other.Stats.empty()) {
+            return;
+        }
+        if (Stats.empty()) {
+            Stats = other.Stats;
+            compensation->assign(Stats.size(), 0.0);
+            return;
+        }
+        if (compensation->size() != Stats.size()) {
+            compensation->assign(Stats.size(), 0.0);
+        }
+        ::AddCompensated(other.Stats, Stats, *compensation);
+    }
 };
 
@@ -19,13 +19,42 @@ public:
     {
     }
 
+    /* cachedOrder, when given, holds the query's sorted order from the previous evaluation
+     * and receives the current one. Since only a few trees' deltas separate consecutive
+     * evaluations the old order is usually almost intact, so it is verified and repaired
+     * with an insertion pass instead of being rebuilt by a full sort.
+     */
     template <class TRelevsType, class TApproxType>
-    void AddQuery(const TRelevsType* relevs, const TApproxType* approxes, float queryWeight, const ui32* subgroupData, ui32 querySize) {
-        TVector<int> qurls(querySize);
-        std::iota(qurls.begin(), qurls.end(), 0);
-        Sort(qurls.begin(), qurls.end(), [&](int left, int right) -> bool {
+    void AddQuery(const TRelevsType* relevs, const TApproxType* approxes, float queryWeight, const ui32* subgroupData, ui32 querySize, TVector<int>* cachedOrder = nullptr) {
+        TVector<int> localOrder;
+        TVector<int>& qurls = cachedOrder != nullptr ? *cachedOrder : localOrder;
+        const auto docIsRankedHigher = [&](int left, int right) -> bool {
             return CompareDocs(approxes[left], relevs[left], approxes[right], relevs[right]);
-        });
+        };
+        if (qurls.size() == querySize) {
+            ui32 misplacedCount = 0;
+            for (ui32 i = 1; i < querySize; ++i) {
+                misplacedCount += docIsRankedHigher(qurls[i], qurls[i - 1]);
+            }
+            if (misplacedCount * 8 > querySize) {
+                // The order is heavily perturbed, an insertion pass could degrade to O(n^2).
+                Sort(qurls.begin(), qurls.end(), docIsRankedHigher);
+            } else if (misplacedCount > 0) {
+                for (ui32 i = 1; i < querySize; ++i) {
+                    const int doc = qurls[i];
+                    ui32 j = i;
+                    while (j > 0 && docIsRankedHigher(doc, qurls[j - 1])) {
+                        qurls[j] = qurls[j - 1];
+                        --j;
+                    }
+                    qurls[j] = doc;
+                }
+            }
+        } else {
+            qurls.resize(querySize);
+            std::iota(qurls.begin(), qurls.end(), 0);
+            Sort(qurls.begin(), qurls.end(), docIsRankedHigher);
+        }
 
         double pLook = 1, pFound = 0;
         const ui32 depth = Min<ui32>(querySize, Depth);
@@ -0,0 +1,44 @@
+#include "apply_cache.h"
+
+#include <util/digest/city.h>
+
+ui64 TApplyResultCache::CalcRowHash(const TConstArrayRef<float> features) {
+    return CityHash64(reinterpret_cast<const char*>(features.data()), features.size() * sizeof(float));
+}
+
+bool TApplyResultCache::TryGet(const TConstArrayRef<float> features, double* result) const {
+    const ui64 hash = CalcRowHash(features);
+    const TSlot& slot = Slots[hash & SlotIndexMask];
+    const ui32 generation = Generation.load(std::memory_order_acquire);
+    const ui64 versionBefore = slot.Version.load(std::memory_order_acquire);
+    if (versionBefore % 2 != 0) {
+        return false; // write in progress
+    }
+    const ui64 slotHash = slot.Hash;
+    const ui32 slotGeneration = slot.Generation;
+    const double value = slot.Value;
+    if (slot.Version.load(std::memory_order_acquire) != versionBefore) {
+        return false; // slot overwritten while reading
+    }
+    if (slotHash != hash || slotGeneration != generation) {
+        return false;
+    }
+    *result = value;
+    return true;
+}
+
+void TApplyResultCache::Put(const TConstArrayRef<float> features, double result) {
+    const ui64 hash = CalcRowHash(features);
+    TSlot& slot = Slots[hash & SlotIndexMask];
+    ui64 version = slot.Version.load(std::memory_order_relaxed);
+    if (version % 2 != 0) {
+        return; // another writer owns the slot; caching is best effort
+    }
+    if (!slot.Version.compare_exchange_strong(version, version + 1, std::memory_order_acquire)) {
+        return;
+    }
+    slot.Hash = hash;
+    slot.Generation = Generation.load(std::memory_order_relaxed);
+    slot.Value = result;
+    slot.Version.store(version + 2, std::memory_order_release);
+}
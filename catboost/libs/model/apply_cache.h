@@ -0,0 +1,79 @@
+#pragma once
+
+#include "model.h"
+
+#include <util/generic/array_ref.h>
+#include <util/generic/utility.h>
+#include <util/generic/vector.h>
+#include <util/system/types.h>
+
+#include <atomic>
+
+/*
+ * Optional memoization layer in front of single-dimension model application.
+ * Scoring traffic often contains exact-duplicate feature rows (retry storms,
+ * duplicated candidates); caching final scores keyed by a hash of the raw row
+ * turns those repeats into table lookups.
+ *
+ * The cache is a bounded power-of-two slot table with a sequence counter per
+ * slot: readers and writers never block, and a concurrent overwrite only turns
+ * a hit into a miss. Hash collisions overwrite the slot, newest row wins.
+ * Call Invalidate() when the underlying model is swapped - it bumps the
+ * generation stamped into every slot, so stale scores stop matching.
+ */
+class TApplyResultCache {
+public:
+    explicit TApplyResultCache(size_t sizeLog2 = 16)
+        : Slots(size_t(1) << sizeLog2)
+        , SlotIndexMask((size_t(1) << sizeLog2) - 1)
+    {
+    }
+
+    //! @return true and fill *result if a score for this exact row is cached.
+    bool TryGet(TConstArrayRef<float> features, double* result) const;
+
+    void Put(TConstArrayRef<float> features, double result);
+
+    //! Drop all cached scores; call whenever the underlying model changes.
+    void Invalidate() {
+        Generation.fetch_add(1, std::memory_order_acq_rel);
+    }
+
+private:
+    struct TSlot {
+        std::atomic<ui64> Version{0}; // even: stable, odd: write in progress
+        ui64 Hash = 0;
+        ui32 Generation = Max<ui32>(); // never matches a live generation until written
+        double Value = 0.0;
+    };
+
+    static ui64 CalcRowHash(TConstArrayRef<float> features);
+
+    TVector<TSlot> Slots;
+    size_t SlotIndexMask;
+    std::atomic<ui32> Generation{0};
+};
+
+/*
+ * Apply the model to one flat feature row through the cache. Only
+ * single-dimension models are memoized; multiclass models and a null cache
+ * fall through to a plain CalcFlat call.
+ */
+inline void CalcFlatCached(
+    const TFullModel& model,
+    TApplyResultCache* cache,
+    TConstArrayRef<float> features,
+    TArrayRef<double> result
+) {
+    if (cache == nullptr || model.ObliviousTrees.ApproxDimension != 1) {
+        model.CalcFlat(features, result);
+        return;
+    }
+    double value;
+    if (cache->TryGet(features, &value)) {
+        result[0] = value;
+        return;
+    }
+    model.CalcFlat(features, result);
+    cache->Put(features, result[0]);
+}
@@ -0,0 +1,233 @@
+#include "approximate_scoring.h"
+
+#include <catboost/libs/helpers/exception.h>
+#include <catboost/libs/helpers/restorable_rng.h>
+
+#include <util/generic/algorithm.h>
+#include <util/generic/utility.h>
+#include <util/random/shuffle.h>
+
+#include <numeric>
+
+static const char* ApproximateModelBlobKey = "approximate_model";
+
+//leaf count differs between trees, so leaf-value vectors are folded into fixed-size
+//signatures before clustering: leaf i of L contributes to bin i * size / L
+static const size_t SignatureSize = 64;
+
+static double SquaredDistance(const TVector<double>& a, const TVector<double>& b) {
+    double result = 0.0;
+    for (size_t i = 0; i < a.size(); ++i) {
+        const double diff = a[i] - b[i];
+        result += diff * diff;
+    }
+    return result;
+}
+
+static double DotProduct(const TVector<double>& a, const TVector<double>& b) {
+    double result = 0.0;
+    for (size_t i = 0; i < a.size(); ++i) {
+        result += a[i] * b[i];
+    }
+    return result;
+}
+
+TFullModel BuildApproximateModel(const TFullModel& model, const TApproximateModelParams& params) {
+    const TObliviousTrees& trees = model.ObliviousTrees;
+    CB_ENSURE(trees.IsOblivious(), "Approximate models are supported for oblivious trees only");
+    const size_t treeCount = trees.GetTreeCount();
+    CB_ENSURE(treeCount > 0, "Model has no trees");
+    CB_ENSURE(params.ClusterCount > 0, "Cluster count should be positive");
+    const size_t clusterCount = Min<size_t>(params.ClusterCount, treeCount);
+
+    const size_t approxDimension = trees.ApproxDimension;
+    TVector<size_t> firstLeafOffsets(treeCount + 1, 0);
+    for (size_t tree = 0; tree < treeCount; ++tree) {
+        firstLeafOffsets[tree + 1] = firstLeafOffsets[tree] + (size_t(1) << trees.TreeSizes[tree]) * approxDimension;
+    }
+
+    const bool floatLeaves = trees.HasFloat32Leaves();
+    TConstArrayRef<double> leafValues = floatLeaves ? TConstArrayRef<double>() : trees.GetLeafValuesRef();
+    auto leafValueAt = [&](size_t idx) -> double {
+        return floatLeaves ? trees.LeafValuesFloat[idx] : leafValues[idx];
+    };
+
+    TVector<TVector<double>> signatures(treeCount, TVector<double>(SignatureSize, 0.0));
+    for (size_t tree = 0; tree < treeCount; ++tree) {
+        const size_t leafCount = firstLeafOffsets[tree + 1] - firstLeafOffsets[tree];
+        for (size_t leaf = 0; leaf < leafCount; ++leaf) {
+            signatures[tree][leaf * SignatureSize / leafCount] += leafValueAt(firstLeafOffsets[tree] + leaf);
+        }
+    }
+
+    //k-means over the signatures, seeded from distinct random trees
+    TRestorableFastRng64 rand(params.Seed);
+    TVector<size_t> initOrder(treeCount);
+    std::iota(initOrder.begin(), initOrder.end(), /*starting value*/ 0);
+    Shuffle(initOrder.begin(), initOrder.end(), rand);
+
+    TVector<TVector<double>> centroids(clusterCount);
+    for (size_t cluster = 0; cluster < clusterCount; ++cluster) {
+        centroids[cluster] = signatures[initOrder[cluster]];
+    }
+
+    TVector<size_t> assignment(treeCount, 0);
+    for (ui32 iteration = 0; iteration < params.KMeansIterations; ++iteration) {
+        bool changed = false;
+        for (size_t tree = 0; tree < treeCount; ++tree) {
+            size_t best = 0;
+            double bestDistance = SquaredDistance(signatures[tree], centroids[0]);
+            for (size_t cluster = 1; cluster < clusterCount; ++cluster) {
+                const double distance = SquaredDistance(signatures[tree], centroids[cluster]);
+                if (distance < bestDistance) {
+                    bestDistance = distance;
+                    best = cluster;
+                }
+            }
+            if (assignment[tree] != best) {
+                assignment[tree] = best;
+                changed = true;
+            }
+        }
+        if (!changed && iteration > 0) {
+            break;
+        }
+        TVector<TVector<double>> sums(clusterCount, TVector<double>(SignatureSize, 0.0));
+        TVector<size_t> counts(clusterCount, 0);
+        for (size_t tree = 0; tree < treeCount; ++tree) {
+            const auto& signature = signatures[tree];
+            auto& sum = sums[assignment[tree]];
+            for (size_t i = 0; i < SignatureSize; ++i) {
+                sum[i] += signature[i];
+            }
+            ++counts[assignment[tree]];
+        }
+        for (size_t cluster = 0; cluster < clusterCount; ++cluster) {
+            if (counts[cluster] == 0) {
+                continue; //empty cluster keeps its old centroid
+            }
+            for (size_t i = 0; i < SignatureSize; ++i) {
+                centroids[cluster][i] = sums[cluster][i] / counts[cluster];
+            }
+        }
+    }
+
+    //medoid per cluster plus a scale that preserves the cluster's total contribution:
+    //every member is projected onto the medoid's signature, so the scaled representative
+    //is the least-squares stand-in for its cluster in leaf-signature space
+    TVector<size_t> medoids(clusterCount, Max<size_t>());
+    for (size_t tree = 0; tree < treeCount; ++tree) {
+        const size_t cluster = assignment[tree];
+        if (medoids[cluster] == Max<size_t>() ||
+            SquaredDistance(signatures[tree], centroids[cluster]) <
+                SquaredDistance(signatures[medoids[cluster]], centroids[cluster]))
+        {
+            medoids[cluster] = tree;
+        }
+    }
+
+    TVector<double> scales(clusterCount, 0.0);
+    TVector<size_t> clusterSizes(clusterCount, 0);
+    for (size_t tree = 0; tree < treeCount; ++tree) {
+        ++clusterSizes[assignment[tree]];
+    }
+    for (size_t cluster = 0; cluster < clusterCount; ++cluster) {
+        if (medoids[cluster] == Max<size_t>()) {
+            continue;
+        }
+        const double medoidNorm = DotProduct(signatures[medoids[cluster]], signatures[medoids[cluster]]);
+        if (medoidNorm < 1e-12) {
+            scales[cluster] = static_cast<double>(clusterSizes[cluster]);
+            continue;
+        }
+        for (size_t tree = 0; tree < treeCount; ++tree) {
+            if (assignment[tree] == cluster) {
+                scales[cluster] += DotProduct(signatures[tree], signatures[medoids[cluster]]) / medoidNorm;
+            }
+        }
+    }
+
+    //assemble the representative model in source tree order, so the result is deterministic
+    TVector<size_t> representativeOrder;
+    for (size_t cluster = 0; cluster < clusterCount; ++cluster) {
+        if (medoids[cluster] != Max<size_t>()) {
+            representativeOrder.push_back(cluster);
+        }
+    }
+    Sort(representativeOrder.begin(), representativeOrder.end(), [&](size_t left, size_t right) {
+        return medoids[left] < medoids[right];
+    });
+
+    TFullModel result;
+    TObliviousTrees& resultTrees = result.ObliviousTrees;
+    resultTrees.ApproxDimension = trees.ApproxDimension;
+    resultTrees.FloatFeatures = trees.FloatFeatures;
+    resultTrees.CatFeatures = trees.CatFeatures;
+    resultTrees.OneHotFeatures = trees.OneHotFeatures;
+    resultTrees.CtrFeatures = trees.CtrFeatures;
+
+    for (size_t cluster : representativeOrder) {
+        const size_t tree = medoids[cluster];
+        resultTrees.TreeStartOffsets.push_back(resultTrees.TreeSplits.ysize());
+        for (int split = 0; split < trees.TreeSizes[tree]; ++split) {
+            resultTrees.TreeSplits.push_back(trees.TreeSplits[trees.TreeStartOffsets[tree] + split]);
+        }
+        resultTrees.TreeSizes.push_back(trees.TreeSizes[tree]);
+        for (size_t leaf = firstLeafOffsets[tree]; leaf < firstLeafOffsets[tree + 1]; ++leaf) {
+            resultTrees.LeafValues.push_back(leafValueAt(leaf) * scales[cluster]);
+        }
+        if (!trees.LeafWeights.empty()) {
+            resultTrees.LeafWeights.push_back(trees.LeafWeights[tree]);
+        }
+    }
+
+    result.CtrProvider = model.CtrProvider;
+    result.ModelInfo["approximate:source_tree_count"] = ToString(treeCount);
+    result.ModelInfo["approximate:cluster_count"] = ToString(representativeOrder.size());
+    result.UpdateDynamicData();
+    return result;
+}
+
+void AttachApproximateModel(const TFullModel& approximateModel, TFullModel* model) {
+    model->ModelInfo[ApproximateModelBlobKey] = SerializeModel(approximateModel);
+}
+
+TMaybe<TFullModel> TryLoadApproximateModel(const TFullModel& model) {
+    const TString* blob = model.ModelInfo.FindPtr(ApproximateModelBlobKey);
+    if (blob == nullptr) {
+        return Nothing();
+    }
+    return DeserializeModel(*blob);
+}
+
+void CalcApproximateFlat(
+    const TFullModel& model,
+    const TFullModel& approximateModel,
+    const TVector<TConstArrayRef<float>>& features,
+    double decisionThreshold,
+    double fallbackMargin,
+    TArrayRef<double> results)
+{
+    CB_ENSURE(approximateModel.ObliviousTrees.ApproxDimension == 1,
+              "Approximate scoring with fallback supports single-dimension models only");
+    CB_ENSURE(results.size() == features.size());
+
+    approximateModel.CalcFlat(features, results);
+
+    TVector<size_t> borderlineDocs;
+    TVector<TConstArrayRef<float>> borderlineFeatures;
+    for (size_t doc = 0; doc < features.size(); ++doc) {
+        if (Abs(results[doc] - decisionThreshold) <= fallbackMargin) {
+            borderlineDocs.push_back(doc);
+            borderlineFeatures.push_back(features[doc]);
+        }
+    }
+    if (borderlineDocs.empty()) {
+        return;
+    }
+    TVector<double> exactScores(borderlineDocs.size());
+    model.CalcFlat(borderlineFeatures, exactScores);
+    for (size_t i = 0; i < borderlineDocs.size(); ++i) {
+        results[borderlineDocs[i]] = exactScores[i];
+    }
+}
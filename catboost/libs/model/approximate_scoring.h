@@ -0,0 +1,45 @@
+#pragma once
+
+#include "model.h"
+
+#include <util/generic/maybe.h>
+
+struct TApproximateModelParams {
+    ui32 ClusterCount = 64;
+    ui32 KMeansIterations = 10;
+    ui64 Seed = 0;
+};
+
+/**
+ * Approximate scoring for candidate generation: trees are clustered by their leaf-value
+ * vectors (k-means over fixed-size leaf signatures), and only one representative tree per
+ * cluster is kept, with its leaf values scaled so the cluster's total contribution is
+ * preserved. Scoring the representatives costs treeCount / clusterCount less than the full
+ * model at a bounded score error; borderline candidates can be re-scored exactly with
+ * CalcApproximateFlat.
+ */
+
+/**
+ * Build the representative model: clusterCount trees of the source model with scaled leaves.
+ * The source model must be oblivious; ctr tables are shared with the source model.
+ */
+TFullModel BuildApproximateModel(const TFullModel& model, const TApproximateModelParams& params);
+
+//! Store the representative model inside the full model as an optional ModelInfo blob
+void AttachApproximateModel(const TFullModel& approximateModel, TFullModel* model);
+
+//! Load the attached representative model, Nothing() if the blob is absent
+TMaybe<TFullModel> TryLoadApproximateModel(const TFullModel& model);
+
+/**
+ * Score documents with the representative model and re-score exactly the documents whose
+ * approximate score lies within fallbackMargin of decisionThreshold, so accept/reject
+ * decisions near the threshold are made on exact scores. Single-dimension models only.
+ */
+void CalcApproximateFlat(
+    const TFullModel& model,
+    const TFullModel& approximateModel,
+    const TVector<TConstArrayRef<float>>& features,
+    double decisionThreshold,
+    double fallbackMargin,
+    TArrayRef<double> results);
@@ -6,20 +6,33 @@
 
 using namespace CoreML::Specification;
 
-void NCatboost::NCoreML::ConfigureTrees(const TFullModel& model, TreeEnsembleParameters* ensemble) {
+void NCatboost::NCoreML::ConfigureTrees(const TFullModel& model, TreeEnsembleParameters* ensemble, NPar::TLocalExecutor* localExecutor) {
     const auto classesCount = static_cast<size_t>(model.ObliviousTrees.ApproxDimension);
     CB_ENSURE(model.ObliviousTrees.CatFeatures.empty(), "model with only float features supported");
     auto& binFeatures = model.ObliviousTrees.GetBinFeatures();
-    size_t currentSplitIndex = 0;
-    auto currentTreeFirstLeafPtr = model.ObliviousTrees.LeafValues.data();
-    for (size_t treeIdx = 0; treeIdx < model.ObliviousTrees.TreeSizes.size(); ++treeIdx) {
+    const size_t treeCount = model.ObliviousTrees.TreeSizes.size();
+
+    TVector<size_t> treeFirstLeafOffsets(treeCount, 0);
+    for (size_t treeIdx = 1; treeIdx < treeCount; ++treeIdx) {
+        treeFirstLeafOffsets[treeIdx] = treeFirstLeafOffsets[treeIdx - 1] +
+            (1uLL << model.ObliviousTrees.TreeSizes[treeIdx - 1]) * classesCount;
+    }
+
+    //trees are independent, so their node blocks are built in parallel and attached to
+    //the ensemble serially afterwards (protobuf repeated fields are not thread safe)
+    TVector<TVector<TreeEnsembleParameters::TreeNode*>> builtTrees(treeCount);
+    NPar::TLocalExecutor::TExecRangeParams blockParams(0, static_cast<int>(treeCount));
+    localExecutor->ExecRange([&](int treeIdx) {
         const size_t leafCount = (1uLL << model.ObliviousTrees.TreeSizes[treeIdx]);
+        const double* currentTreeFirstLeafPtr = model.ObliviousTrees.LeafValues.data() + treeFirstLeafOffsets[treeIdx];
         size_t lastNodeId = 0;
+        auto& treeNodes = builtTrees[treeIdx];
 
         TVector<TreeEnsembleParameters::TreeNode*> outputLeaves(leafCount);
 
         for (size_t leafIdx = 0; leafIdx < leafCount; ++leafIdx) {
-            auto leafNode = ensemble->add_nodes();
+            auto leafNode = new TreeEnsembleParameters::TreeNode;
+            treeNodes.push_back(leafNode);
             leafNode->set_treeid(treeIdx);
             leafNode->set_nodeid(lastNodeId);
             ++lastNodeId;
@@ -37,8 +50,8 @@ void NCatboost::NCoreML::ConfigureTrees(const TFullModel& model, TreeEnsemblePar
 
             outputLeaves[leafIdx] = leafNode;
         }
-        currentTreeFirstLeafPtr += leafCount * model.ObliviousTrees.ApproxDimension;
 
+        size_t currentSplitIndex = model.ObliviousTrees.TreeStartOffsets[treeIdx];
         auto& previousLayer = outputLeaves;
         auto treeDepth = model.ObliviousTrees.TreeSizes[treeIdx];
         for (int layer = treeDepth - 1; layer >= 0; --layer) {
@@ -51,7 +64,8 @@ void NCatboost::NCoreML::ConfigureTrees(const TFullModel& model, TreeEnsemblePar
             TVector<TreeEnsembleParameters::TreeNode*> currentLayer(nodesInLayerCount);
 
             for (size_t nodeIdx = 0; nodeIdx < nodesInLayerCount; ++nodeIdx) {
-                auto branchNode = ensemble->add_nodes();
+                auto branchNode = new TreeEnsembleParameters::TreeNode;
+                treeNodes.push_back(branchNode);
 
                 branchNode->set_treeid(treeIdx);
                 branchNode->set_nodeid(lastNodeId);
@@ -71,6 +85,12 @@ void NCatboost::NCoreML::ConfigureTrees(const TFullModel& model, TreeEnsemblePar
 
             previousLayer = currentLayer;
         }
+    }, blockParams, NPar::TLocalExecutor::WAIT_COMPLETE);
+
+    for (auto& treeNodes : builtTrees) {
+        for (auto* node : treeNodes) {
+            ensemble->mutable_nodes()->AddAllocated(node);
+        }
     }
 }
 
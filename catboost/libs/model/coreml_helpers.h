@@ -6,10 +6,11 @@
 #include <contrib/libs/coreml/Model.pb.h>
 
 #include <library/json/json_reader.h>
+#include <library/threading/local_executor/local_executor.h>
 
 namespace NCatboost {
     namespace NCoreML {
-        void ConfigureTrees(const TFullModel& model, CoreML::Specification::TreeEnsembleParameters* ensemble);
+        void ConfigureTrees(const TFullModel& model, CoreML::Specification::TreeEnsembleParameters* ensemble, NPar::TLocalExecutor* localExecutor);
         void ConfigureIO(const TFullModel& model, const NJson::TJsonValue& userParameters, CoreML::Specification::TreeEnsembleRegressor* regressor, CoreML::Specification::ModelDescription* description);
         void ConfigureMetadata(const TFullModel& model, const NJson::TJsonValue& userParameters, CoreML::Specification::ModelDescription* description);
 
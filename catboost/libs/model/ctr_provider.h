@@ -27,6 +27,10 @@ public:
         const TVector<TCatFeature>& catFeatures) = 0;
 
     virtual void AddCtrCalcerData(TCtrValueTable&& valueTable) = 0;
+
+    //! Drop ctr tables the model no longer references, see TFullModel::OptimizeForInference
+    virtual void DropUnusedTables(TConstArrayRef<TModelCtrBase>) {
+    }
     virtual bool IsSerializable() const {
         return false;
     }
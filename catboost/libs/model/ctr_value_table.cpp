@@ -14,26 +14,38 @@ void TCtrValueTable::Save(IOutputStream* s) const {
         auto indexHashOffset = serializer.FlatbufBuilder.CreateVector((const ui8*) solid.IndexBuckets.data(),
                                                 sizeof(NCatboost::TBucket) * solid.IndexBuckets.size());
         auto ctrBlob = serializer.FlatbufBuilder.CreateVector(solid.CTRBlob);
+        auto mphSlotsOffset = serializer.FlatbufBuilder.CreateVector((const ui8*) solid.MphSlots.data(),
+                                                sizeof(NCatboost::TBucket) * solid.MphSlots.size());
+        auto mphDisplacementsOffset = serializer.FlatbufBuilder.CreateVector((const ui8*) solid.MphDisplacements.data(),
+                                                sizeof(ui32) * solid.MphDisplacements.size());
         auto ctrValueTable = CreateTCtrValueTable(
             serializer.FlatbufBuilder,
             serializer.GetOffset(ModelCtrBase),
             indexHashOffset,
             ctrBlob,
             CounterDenominator,
-            TargetClassesCount);
+            TargetClassesCount,
+            mphSlotsOffset,
+            mphDisplacementsOffset);
         serializer.FlatbufBuilder.Finish(ctrValueTable);
     } else {
         auto& thin = Impl.As<TThinTable>();
         auto indexHashOffset = serializer.FlatbufBuilder.CreateVector((const ui8*) thin.IndexBuckets.data(),
                                                 sizeof(NCatboost::TBucket) * thin.IndexBuckets.size());
         auto ctrBlob = serializer.FlatbufBuilder.CreateVector(thin.CTRBlob.data(), thin.CTRBlob.size());
+        auto mphSlotsOffset = serializer.FlatbufBuilder.CreateVector((const ui8*) thin.MphSlots.data(),
+                                                sizeof(NCatboost::TBucket) * thin.MphSlots.size());
+        auto mphDisplacementsOffset = serializer.FlatbufBuilder.CreateVector((const ui8*) thin.MphDisplacements.data(),
+                                                sizeof(ui32) * thin.MphDisplacements.size());
         auto ctrValueTable = CreateTCtrValueTable(
             serializer.FlatbufBuilder,
             serializer.GetOffset(ModelCtrBase),
             indexHashOffset,
             ctrBlob,
             CounterDenominator,
-            TargetClassesCount);
+            TargetClassesCount,
+            mphSlotsOffset,
+            mphDisplacementsOffset);
         serializer.FlatbufBuilder.Finish(ctrValueTable);
     }
     SaveSize(s, serializer.FlatbufBuilder.GetSize());
@@ -61,4 +73,10 @@ void TCtrValueTable::LoadSolid(void* buf, size_t length) {
 
     solid.CTRBlob.assign(ctrValueTable->CTRBlob()->data(),
                          ctrValueTable->CTRBlob()->data() + ctrValueTable->CTRBlob()->size());
+    if (ctrValueTable->IndexMphSlotsRaw() && ctrValueTable->IndexMphSlotsRaw()->size() > 0) {
+        solid.MphSlots.assign((NCatboost::TBucket*)ctrValueTable->IndexMphSlotsRaw()->data(),
+                              (NCatboost::TBucket*)(ctrValueTable->IndexMphSlotsRaw()->data() + ctrValueTable->IndexMphSlotsRaw()->size()));
+        solid.MphDisplacements.assign((const ui32*)ctrValueTable->IndexMphDisplacementsRaw()->data(),
+                                      (const ui32*)(ctrValueTable->IndexMphDisplacementsRaw()->data() + ctrValueTable->IndexMphDisplacementsRaw()->size()));
+    }
 }
@@ -14,21 +14,29 @@ class TCtrValueTable {
     struct TSolidTable {
         TVector<NCatboost::TBucket> IndexBuckets;
         TVector<ui8> CTRBlob;
+        TVector<NCatboost::TBucket> MphSlots;
+        TVector<ui32> MphDisplacements;
         bool operator==(const TSolidTable& other) const {
-            return std::tie(IndexBuckets, CTRBlob) == std::tie(other.IndexBuckets, other.CTRBlob);
+            return std::tie(IndexBuckets, CTRBlob, MphSlots, MphDisplacements) ==
+                   std::tie(other.IndexBuckets, other.CTRBlob, other.MphSlots, other.MphDisplacements);
         }
     };
     struct TThinTable {
         TConstArrayRef<NCatboost::TBucket> IndexBuckets;
         TConstArrayRef<ui8> CTRBlob;
+        TConstArrayRef<NCatboost::TBucket> MphSlots;
+        TConstArrayRef<ui32> MphDisplacements;
 
         bool operator==(const TThinTable& other) const {
-            return std::tie(IndexBuckets, CTRBlob) == std::tie(other.IndexBuckets, other.CTRBlob);
+            return std::tie(IndexBuckets, CTRBlob, MphSlots, MphDisplacements) ==
+                   std::tie(other.IndexBuckets, other.CTRBlob, other.MphSlots, other.MphDisplacements);
         }
 
         void ToSolidTable(TSolidTable* table) {
             table->IndexBuckets.assign(IndexBuckets.begin(), IndexBuckets.end());
             table->CTRBlob.assign(CTRBlob.begin(), CTRBlob.end());
+            table->MphSlots.assign(MphSlots.begin(), MphSlots.end());
+            table->MphDisplacements.assign(MphDisplacements.begin(), MphDisplacements.end());
         }
     };
 public:
@@ -76,12 +84,110 @@ public:
         }
     }
 
+    bool HasPerfectHashIndex() const {
+        if (Impl.Is<TSolidTable>()) {
+            return !Impl.As<TSolidTable>().MphSlots.empty();
+        } else {
+            return !Impl.As<TThinTable>().MphSlots.empty();
+        }
+    }
+
+    NCatboost::TDenseIndexMphView GetPerfectHashViewer() const {
+        if (Impl.Is<TSolidTable>()) {
+            auto& solid = Impl.As<TSolidTable>();
+            return NCatboost::TDenseIndexMphView(solid.MphSlots, solid.MphDisplacements);
+        } else {
+            auto& thin = Impl.As<TThinTable>();
+            return NCatboost::TDenseIndexMphView(thin.MphSlots, thin.MphDisplacements);
+        }
+    }
+
     NCatboost::TDenseIndexHashBuilder GetIndexHashBuilder(size_t uniqueValuesCount) {
         auto& solid = Impl.As<TSolidTable>();
         auto bucketCount = NCatboost::TDenseIndexHashBuilder::GetProperBucketsCount(uniqueValuesCount);
         solid.IndexBuckets.resize(bucketCount);
         return NCatboost::TDenseIndexHashBuilder(solid.IndexBuckets);
     }
+    /**
+     * Rebuild the index hash into the smallest power-of-two bucket array that keeps the requested
+     * load factor. Trims the slack left by the 0.5 build-time load factor so hot tables stay
+     * resident in cache at apply time; compacted tables are serialized as is into the model file.
+     */
+    void CompactBuckets(float loadFactor = 0.75f) {
+        if (Impl.Is<TThinTable>()) {
+            TSolidTable solid;
+            Impl.As<TThinTable>().ToSolidTable(&solid);
+            Impl = std::move(solid);
+        }
+        auto& solid = Impl.As<TSolidTable>();
+        size_t usedCount = 0;
+        for (const auto& bucket : solid.IndexBuckets) {
+            usedCount += (bucket.Hash != NCatboost::TBucket::InvalidHashValue);
+        }
+        const auto newBucketCount = NCatboost::TDenseIndexHashBuilder::GetProperBucketsCount(usedCount, loadFactor);
+        if (newBucketCount >= solid.IndexBuckets.size()) {
+            return;
+        }
+        TVector<NCatboost::TBucket> oldBuckets;
+        oldBuckets.swap(solid.IndexBuckets);
+        solid.IndexBuckets.resize(newBucketCount);
+        NCatboost::TDenseIndexHashBuilder builder(solid.IndexBuckets);
+        for (const auto& bucket : oldBuckets) {
+            if (bucket.Hash != NCatboost::TBucket::InvalidHashValue) {
+                builder.SetIndex(bucket.Hash, bucket.IndexValue);
+            }
+        }
+    }
+
+    /**
+     * Replace the open-addressed index hash with a minimal perfect hash over the final key set:
+     * one slot per key instead of at least 2x slack, and a guaranteed single probe per lookup.
+     * Returns false (keeping the index hash untouched) in the rare case no perfect hash is
+     * found within the construction budget. Models saved with a perfect hash index cannot be
+     * loaded by binaries that predate it.
+     */
+    bool BuildPerfectHashIndex() {
+        if (Impl.Is<TThinTable>()) {
+            TSolidTable solid;
+            Impl.As<TThinTable>().ToSolidTable(&solid);
+            Impl = std::move(solid);
+        }
+        auto& solid = Impl.As<TSolidTable>();
+        if (!solid.MphSlots.empty()) {
+            return true;
+        }
+        TVector<NCatboost::TBucket> entries;
+        for (const auto& bucket : solid.IndexBuckets) {
+            if (bucket.Hash != NCatboost::TBucket::InvalidHashValue) {
+                entries.push_back(bucket);
+            }
+        }
+        if (!NCatboost::TDenseIndexMphBuilder::Build(entries, &solid.MphSlots, &solid.MphDisplacements)) {
+            return false;
+        }
+        TVector<NCatboost::TBucket>().swap(solid.IndexBuckets);
+        return true;
+    }
+
+    /**
+     * Occupied index buckets in a power-of-two open-addressed layout, regardless of the index
+     * representation this table holds. Code exporters emit this layout because the generated
+     * applicators do their own linear probing.
+     */
+    TVector<NCatboost::TBucket> BuildDenseIndexBuckets() const {
+        if (!HasPerfectHashIndex()) {
+            const auto buckets = GetIndexHashViewer().GetBuckets();
+            return TVector<NCatboost::TBucket>(buckets.begin(), buckets.end());
+        }
+        const auto slots = GetPerfectHashViewer().GetSlots();
+        TVector<NCatboost::TBucket> buckets(NCatboost::TDenseIndexHashBuilder::GetProperBucketsCount(slots.size()));
+        NCatboost::TDenseIndexHashBuilder builder(buckets);
+        for (const auto& slot : slots) {
+            builder.SetIndex(slot.Hash, slot.IndexValue);
+        }
+        return buckets;
+    }
+
     void Save(IOutputStream* s) const;
 
     void Load(IInputStream* s);
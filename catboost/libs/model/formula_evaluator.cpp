@@ -1,10 +1,20 @@
 #include "formula_evaluator.h"
 
 #include <util/stream/format.h>
+#include <util/system/cpu_id.h>
 
 #include <emmintrin.h>
 #include <pmmintrin.h>
 
+void CalcTreesBlockedAvx2SingleClass(const TFullModel& model, const ui8* __restrict binFeatures, size_t docCountInBlock, TCalcerIndexType* __restrict indexesVec, size_t treeStart, size_t treeEnd, double* __restrict resultsPtr);
+void CalcTreesBlockedAvx2SingleClassXored(const TFullModel& model, const ui8* __restrict binFeatures, size_t docCountInBlock, TCalcerIndexType* __restrict indexesVec, size_t treeStart, size_t treeEnd, double* __restrict resultsPtr);
+void CalcTreesBlockedAvx2MultiClass(const TFullModel& model, const ui8* __restrict binFeatures, size_t docCountInBlock, TCalcerIndexType* __restrict indexesVec, size_t treeStart, size_t treeEnd, double* __restrict resultsPtr);
+void CalcTreesBlockedAvx2MultiClassXored(const TFullModel& model, const ui8* __restrict binFeatures, size_t docCountInBlock, TCalcerIndexType* __restrict indexesVec, size_t treeStart, size_t treeEnd, double* __restrict resultsPtr);
+void CalcTreesBlockedAvx512SingleClass(const TFullModel& model, const ui8* __restrict binFeatures, size_t docCountInBlock, TCalcerIndexType* __restrict indexesVec, size_t treeStart, size_t treeEnd, double* __restrict resultsPtr);
+void CalcTreesBlockedAvx512SingleClassXored(const TFullModel& model, const ui8* __restrict binFeatures, size_t docCountInBlock, TCalcerIndexType* __restrict indexesVec, size_t treeStart, size_t treeEnd, double* __restrict resultsPtr);
+void CalcTreesBlockedAvx512MultiClass(const TFullModel& model, const ui8* __restrict binFeatures, size_t docCountInBlock, TCalcerIndexType* __restrict indexesVec, size_t treeStart, size_t treeEnd, double* __restrict resultsPtr);
+void CalcTreesBlockedAvx512MultiClassXored(const TFullModel& model, const ui8* __restrict binFeatures, size_t docCountInBlock, TCalcerIndexType* __restrict indexesVec, size_t treeStart, size_t treeEnd, double* __restrict resultsPtr);
+
 void TFeatureCachedTreeEvaluator::Calc(size_t treeStart, size_t treeEnd, TArrayRef<double> results) const {
     CB_ENSURE(results.size() == DocCount * Model.ObliviousTrees.ApproxDimension);
     Fill(results.begin(), results.end(), 0.0);
@@ -26,6 +36,90 @@ void TFeatureCachedTreeEvaluator::Calc(size_t treeStart, size_t treeEnd, TArrayR
     }
 }
 
+void TFeatureCachedTreeEvaluator::Calc(
+    size_t treeStart,
+    size_t treeEnd,
+    TArrayRef<double> results,
+    NPar::TLocalExecutor* executor) const
+{
+    CB_ENSURE(results.size() == DocCount * Model.ObliviousTrees.ApproxDimension);
+    Fill(results.begin(), results.end(), 0.0);
+
+    const int blockCount = BinFeatures.ysize();
+    executor->ExecRange([&](int blockId) {
+        TVector<TCalcerIndexType> indexesVec(BlockSize);
+        const size_t blockStart = blockId * BlockSize;
+        const auto docCountInBlock = Min<size_t>(BlockSize, DocCount - blockStart);
+        CalcFunction(
+                Model,
+                BinFeatures[blockId].data(),
+                docCountInBlock,
+                indexesVec.data(),
+                treeStart,
+                treeEnd,
+                results.data() + blockStart * Model.ObliviousTrees.ApproxDimension
+        );
+    }, 0, blockCount, NPar::TLocalExecutor::WAIT_COMPLETE);
+}
+
+void TStagedTreeEvaluator::CalcStage(size_t treeEnd) {
+    CB_ENSURE(TreesProcessed <= treeEnd && treeEnd <= Model.GetTreeCount());
+    if (treeEnd == TreesProcessed) {
+        return;
+    }
+    const int approxDimension = Model.ObliviousTrees.ApproxDimension;
+    TVector<TCalcerIndexType> indexesVec(BlockSize);
+    // stage results go through a zeroed temporary because the calc functions expect
+    // zero-initialized output
+    TVector<double> stageResults(BlockSize * approxDimension);
+    for (size_t blockId = 0; blockId < BinFeatures.size(); ++blockId) {
+        if (BlockActiveDocCounts[blockId] == 0) {
+            continue;
+        }
+        const size_t blockStart = blockId * BlockSize;
+        const auto docCountInBlock = Min<size_t>(BlockSize, DocCount - blockStart);
+        Fill(stageResults.begin(), stageResults.begin() + docCountInBlock * approxDimension, 0.0);
+        CalcFunction(
+                Model,
+                BinFeatures[blockId].data(),
+                docCountInBlock,
+                indexesVec.data(),
+                TreesProcessed,
+                treeEnd,
+                stageResults.data()
+        );
+        double* partialPtr = PartialResults.data() + blockStart * approxDimension;
+        for (size_t i = 0; i < docCountInBlock * approxDimension; ++i) {
+            partialPtr[i] += stageResults[i];
+        }
+    }
+    TreesProcessed = treeEnd;
+}
+
+size_t TStagedTreeEvaluator::ApplyMarginEarlyExit(double threshold) {
+    CB_ENSURE(Model.ObliviousTrees.ApproxDimension == 1, "margin early exit supports single dimension models only");
+    const auto& suffixMaxSums = Model.ObliviousTrees.GetSuffixMaxLeafValueSums();
+    CB_ENSURE(!suffixMaxSums.empty(), "leaf value bounds are not available");
+    const double remainingMax = suffixMaxSums[TreesProcessed];
+    size_t activeCount = 0;
+    for (size_t blockId = 0; blockId < BinFeatures.size(); ++blockId) {
+        const size_t blockStart = blockId * BlockSize;
+        const auto docCountInBlock = Min<size_t>(BlockSize, DocCount - blockStart);
+        for (size_t docId = blockStart; docId < blockStart + docCountInBlock; ++docId) {
+            if (!ActiveDocs[docId]) {
+                continue;
+            }
+            if (PartialResults[docId] + remainingMax < threshold) {
+                ActiveDocs[docId] = false;
+                --BlockActiveDocCounts[blockId];
+            } else {
+                ++activeCount;
+            }
+        }
+    }
+    return activeCount;
+}
+
 constexpr size_t SSE_BLOCK_SIZE = 16;
 
 template<bool NeedXorMask, size_t START_BLOCK, typename TIndexType>
@@ -219,8 +313,8 @@ Y_FORCE_INLINE void CalcIndexesSse(
 #undef STORE_16_DOCS_RESULT
 }
 
-template<typename TIndexType>
-Y_FORCE_INLINE void CalculateLeafValues(const size_t docCountInBlock, const double* __restrict treeLeafPtr, const TIndexType* __restrict indexesPtr, double* __restrict writePtr) {
+template<typename TIndexType, typename TLeafType>
+Y_FORCE_INLINE void CalculateLeafValues(const size_t docCountInBlock, const TLeafType* __restrict treeLeafPtr, const TIndexType* __restrict indexesPtr, double* __restrict writePtr) {
     Y_PREFETCH_READ(treeLeafPtr, 3);
     Y_PREFETCH_READ(treeLeafPtr + 128, 3);
     const auto docCountInBlock4 = (docCountInBlock | 0x3) ^ 0x3;
@@ -239,8 +333,8 @@ Y_FORCE_INLINE void CalculateLeafValues(const size_t docCountInBlock, const doub
     }
 }
 
-template<int SSEBlockCount>
-Y_FORCE_INLINE static void GatherAddLeafSSE(const double* __restrict treeLeafPtr, const ui8* __restrict indexesPtr, __m128d* __restrict writePtr) {
+template<int SSEBlockCount, typename TLeafType>
+Y_FORCE_INLINE static void GatherAddLeafSSE(const TLeafType* __restrict treeLeafPtr, const ui8* __restrict indexesPtr, __m128d* __restrict writePtr) {
     _mm_prefetch((const char*)(treeLeafPtr + 64), _MM_HINT_T2);
 
     for (size_t blockId = 0; blockId < SSEBlockCount; ++blockId) {
@@ -271,13 +365,13 @@ Y_FORCE_INLINE static void GatherAddLeafSSE(const double* __restrict treeLeafPtr
 #undef ADD_LEAFS
 }
 
-template<int SSEBlockCount>
+template<int SSEBlockCount, typename TLeafType>
 Y_FORCE_INLINE void CalculateLeafValues4(
     const size_t docCountInBlock,
-    const double* __restrict treeLeafPtr0,
-    const double* __restrict treeLeafPtr1,
-    const double* __restrict treeLeafPtr2,
-    const double* __restrict treeLeafPtr3,
+    const TLeafType* __restrict treeLeafPtr0,
+    const TLeafType* __restrict treeLeafPtr1,
+    const TLeafType* __restrict treeLeafPtr2,
+    const TLeafType* __restrict treeLeafPtr3,
     const ui8* __restrict indexesPtr0,
     const ui8* __restrict indexesPtr1,
     const ui8* __restrict indexesPtr2,
@@ -309,8 +403,8 @@ Y_FORCE_INLINE void CalculateLeafValues4(
     }
 }
 
-template<typename TIndexType>
-Y_FORCE_INLINE void CalculateLeafValuesMulti(const size_t docCountInBlock, const double* __restrict leafPtr, const TIndexType* __restrict indexesVec, const int approxDimension, double* __restrict writePtr) {
+template<typename TIndexType, typename TLeafType>
+Y_FORCE_INLINE void CalculateLeafValuesMulti(const size_t docCountInBlock, const TLeafType* __restrict leafPtr, const TIndexType* __restrict indexesVec, const int approxDimension, double* __restrict writePtr) {
     for (size_t docId = 0; docId < docCountInBlock; ++docId) {
         auto leafValuePtr = leafPtr + indexesVec[docId] * approxDimension;
         for (int classId = 0; classId < approxDimension; ++classId) {
@@ -320,7 +414,20 @@ Y_FORCE_INLINE void CalculateLeafValuesMulti(const size_t docCountInBlock, const
     }
 }
 
-template<bool IsSingleClassModel, bool NeedXorMask, int SSEBlockCount>
+template<typename TLeafType>
+Y_FORCE_INLINE const TLeafType* GetModelLeafValuesPtr(const TObliviousTrees& trees);
+
+template<>
+Y_FORCE_INLINE const double* GetModelLeafValuesPtr<double>(const TObliviousTrees& trees) {
+    return trees.GetLeafValuesRef().data();
+}
+
+template<>
+Y_FORCE_INLINE const float* GetModelLeafValuesPtr<float>(const TObliviousTrees& trees) {
+    return trees.LeafValuesFloat.data();
+}
+
+template<bool IsSingleClassModel, bool NeedXorMask, int SSEBlockCount, typename TLeafType>
 Y_FORCE_INLINE void CalcTreesBlockedImpl(
     const TFullModel& model,
     const ui8* __restrict binFeatures,
@@ -339,7 +446,7 @@ Y_FORCE_INLINE void CalcTreesBlockedImpl(
         [](int depth) { return depth <= 8; }
     );
     ui8* __restrict indexesVec = (ui8*)indexesVecUI32;
-    const auto treeLeafPtr = model.ObliviousTrees.LeafValues.data();
+    const TLeafType* treeLeafPtr = GetModelLeafValuesPtr<TLeafType>(model.ObliviousTrees);
     auto firstLeafOffsetsPtr = model.ObliviousTrees.GetFirstLeafOffsets().data();
     if (IsSingleClassModel && allTreesAreShallow) {
         auto alignedResultsPtr = resultsPtr;
@@ -406,8 +513,8 @@ Y_FORCE_INLINE void CalcTreesBlockedImpl(
     }
 }
 
-template<bool IsSingleClassModel, bool NeedXorMask>
-inline void CalcTreesBlocked(
+template<bool IsSingleClassModel, bool NeedXorMask, typename TLeafType>
+inline void CalcTreesBlockedDispatch(
     const TFullModel& model,
     const ui8* __restrict binFeatures,
     size_t docCountInBlock,
@@ -417,31 +524,31 @@ inline void CalcTreesBlocked(
     double* __restrict resultsPtr) {
     switch (docCountInBlock / SSE_BLOCK_SIZE) {
     case 0:
-        CalcTreesBlockedImpl<IsSingleClassModel, NeedXorMask, 0>(model, binFeatures, docCountInBlock, indexesVec, treeStart, treeEnd, resultsPtr);
+        CalcTreesBlockedImpl<IsSingleClassModel, NeedXorMask, 0, TLeafType>(model, binFeatures, docCountInBlock, indexesVec, treeStart, treeEnd, resultsPtr);
         break;
     case 1:
-        CalcTreesBlockedImpl<IsSingleClassModel, NeedXorMask, 1>(model, binFeatures, docCountInBlock, indexesVec, treeStart, treeEnd, resultsPtr);
+        CalcTreesBlockedImpl<IsSingleClassModel, NeedXorMask, 1, TLeafType>(model, binFeatures, docCountInBlock, indexesVec, treeStart, treeEnd, resultsPtr);
         break;
     case 2:
-        CalcTreesBlockedImpl<IsSingleClassModel, NeedXorMask, 2>(model, binFeatures, docCountInBlock, indexesVec, treeStart, treeEnd, resultsPtr);
+        CalcTreesBlockedImpl<IsSingleClassModel, NeedXorMask, 2, TLeafType>(model, binFeatures, docCountInBlock, indexesVec, treeStart, treeEnd, resultsPtr);
         break;
     case 3:
-        CalcTreesBlockedImpl<IsSingleClassModel, NeedXorMask, 3>(model, binFeatures, docCountInBlock, indexesVec, treeStart, treeEnd, resultsPtr);
+        CalcTreesBlockedImpl<IsSingleClassModel, NeedXorMask, 3, TLeafType>(model, binFeatures, docCountInBlock, indexesVec, treeStart, treeEnd, resultsPtr);
         break;
     case 4:
-        CalcTreesBlockedImpl<IsSingleClassModel, NeedXorMask, 4>(model, binFeatures, docCountInBlock, indexesVec, treeStart, treeEnd, resultsPtr);
+        CalcTreesBlockedImpl<IsSingleClassModel, NeedXorMask, 4, TLeafType>(model, binFeatures, docCountInBlock, indexesVec, treeStart, treeEnd, resultsPtr);
         break;
     case 5:
-        CalcTreesBlockedImpl<IsSingleClassModel, NeedXorMask, 5>(model, binFeatures, docCountInBlock, indexesVec, treeStart, treeEnd, resultsPtr);
+        CalcTreesBlockedImpl<IsSingleClassModel, NeedXorMask, 5, TLeafType>(model, binFeatures, docCountInBlock, indexesVec, treeStart, treeEnd, resultsPtr);
         break;
     case 6:
-        CalcTreesBlockedImpl<IsSingleClassModel, NeedXorMask, 6>(model, binFeatures, docCountInBlock, indexesVec, treeStart, treeEnd, resultsPtr);
+        CalcTreesBlockedImpl<IsSingleClassModel, NeedXorMask, 6, TLeafType>(model, binFeatures, docCountInBlock, indexesVec, treeStart, treeEnd, resultsPtr);
         break;
     case 7:
-        CalcTreesBlockedImpl<IsSingleClassModel, NeedXorMask, 7>(model, binFeatures, docCountInBlock, indexesVec, treeStart, treeEnd, resultsPtr);
+        CalcTreesBlockedImpl<IsSingleClassModel, NeedXorMask, 7, TLeafType>(model, binFeatures, docCountInBlock, indexesVec, treeStart, treeEnd, resultsPtr);
         break;
     case 8:
-        CalcTreesBlockedImpl<IsSingleClassModel, NeedXorMask, 8>(model, binFeatures, docCountInBlock, indexesVec, treeStart, treeEnd, resultsPtr);
+        CalcTreesBlockedImpl<IsSingleClassModel, NeedXorMask, 8, TLeafType>(model, binFeatures, docCountInBlock, indexesVec, treeStart, treeEnd, resultsPtr);
         break;
     default:
         Y_UNREACHABLE();
@@ -449,6 +556,22 @@ inline void CalcTreesBlocked(
 }
 
 template<bool IsSingleClassModel, bool NeedXorMask>
+inline void CalcTreesBlocked(
+    const TFullModel& model,
+    const ui8* __restrict binFeatures,
+    size_t docCountInBlock,
+    TCalcerIndexType* __restrict indexesVec,
+    size_t treeStart,
+    size_t treeEnd,
+    double* __restrict resultsPtr) {
+    if (model.ObliviousTrees.HasFloat32Leaves()) {
+        CalcTreesBlockedDispatch<IsSingleClassModel, NeedXorMask, float>(model, binFeatures, docCountInBlock, indexesVec, treeStart, treeEnd, resultsPtr);
+    } else {
+        CalcTreesBlockedDispatch<IsSingleClassModel, NeedXorMask, double>(model, binFeatures, docCountInBlock, indexesVec, treeStart, treeEnd, resultsPtr);
+    }
+}
+
+template<bool IsSingleClassModel, bool NeedXorMask, typename TLeafType>
 inline void CalcTreesSingleDocImpl(
     const TFullModel& model,
     const ui8* __restrict binFeatures,
@@ -461,7 +584,8 @@ inline void CalcTreesSingleDocImpl(
     const TRepackedBin* treeSplitsCurPtr =
         model.ObliviousTrees.GetRepackedBins().data() + model.ObliviousTrees.TreeStartOffsets[treeStart];
     double result = 0.0;
-    const double* treeLeafPtr = model.ObliviousTrees.GetFirstLeafPtrForTree(treeStart);
+    const TLeafType* treeLeafPtr = GetModelLeafValuesPtr<TLeafType>(model.ObliviousTrees)
+        + model.ObliviousTrees.GetFirstLeafOffsets()[treeStart];
     for (size_t treeId = treeStart; treeId < treeEnd; ++treeId) {
         const auto curTreeSize = model.ObliviousTrees.TreeSizes[treeId];
         TCalcerIndexType index = 0;
@@ -491,33 +615,239 @@ inline void CalcTreesSingleDocImpl(
     }
 }
 
+template<bool IsSingleClassModel, bool NeedXorMask>
+inline void CalcTreesSingleDoc(
+    const TFullModel& model,
+    const ui8* __restrict binFeatures,
+    size_t docCountInBlock,
+    TCalcerIndexType* __restrict indexesVec,
+    size_t treeStart,
+    size_t treeEnd,
+    double* __restrict results)
+{
+    if (model.ObliviousTrees.HasFloat32Leaves()) {
+        CalcTreesSingleDocImpl<IsSingleClassModel, NeedXorMask, float>(model, binFeatures, docCountInBlock, indexesVec, treeStart, treeEnd, results);
+    } else {
+        CalcTreesSingleDocImpl<IsSingleClassModel, NeedXorMask, double>(model, binFeatures, docCountInBlock, indexesVec, treeStart, treeEnd, results);
+    }
+}
+
+template<bool IsSingleClassModel, bool NeedXorMask, typename TLeafType>
+inline void CalcNonSymmetricTreesImpl(
+    const TFullModel& model,
+    const ui8* __restrict binFeatures,
+    size_t docCountInBlock,
+    TCalcerIndexType* __restrict,
+    size_t treeStart,
+    size_t treeEnd,
+    double* __restrict resultsPtr)
+{
+    const TRepackedBin* treeSplitsPtr = model.ObliviousTrees.GetRepackedBins().data();
+    const TNonSymmetricTreeStepNode* stepNodesPtr = model.ObliviousTrees.NonSymmetricStepNodes.data();
+    const ui32* nodeIdToLeafIdPtr = model.ObliviousTrees.NonSymmetricNodeIdToLeafId.data();
+    const TLeafType* leafValuesPtr = GetModelLeafValuesPtr<TLeafType>(model.ObliviousTrees);
+    const int approxDimension = model.ObliviousTrees.ApproxDimension;
+    for (size_t treeId = treeStart; treeId < treeEnd; ++treeId) {
+        const ui32 treeNodesStart = model.ObliviousTrees.TreeStartOffsets[treeId];
+        for (size_t docId = 0; docId < docCountInBlock; ++docId) {
+            ui32 nodeIdx = treeNodesStart;
+            while (true) {
+                const TRepackedBin split = treeSplitsPtr[nodeIdx];
+                ui8 binFeatureValue = binFeatures[split.FeatureIndex * docCountInBlock + docId];
+                if (NeedXorMask) {
+                    binFeatureValue ^= split.XorMask;
+                }
+                // step selection compiles to a conditional move, descent only branches on leaf arrival
+                const TNonSymmetricTreeStepNode stepNode = stepNodesPtr[nodeIdx];
+                const ui16 step = (binFeatureValue >= split.SplitIdx) ? stepNode.RightSubtreeDiff
+                                                                      : stepNode.LeftSubtreeDiff;
+                if (step == 0) {
+                    break;
+                }
+                nodeIdx += step;
+            }
+            const ui32 leafIdx = nodeIdToLeafIdPtr[nodeIdx];
+            if (IsSingleClassModel) {
+                resultsPtr[docId] += leafValuesPtr[leafIdx];
+            } else {
+                auto leafValuePtr = leafValuesPtr + leafIdx * approxDimension;
+                for (int classId = 0; classId < approxDimension; ++classId) {
+                    resultsPtr[docId * approxDimension + classId] += leafValuePtr[classId];
+                }
+            }
+        }
+    }
+}
+
+template<bool IsSingleClassModel, bool NeedXorMask>
+inline void CalcNonSymmetricTrees(
+    const TFullModel& model,
+    const ui8* __restrict binFeatures,
+    size_t docCountInBlock,
+    TCalcerIndexType* __restrict indexesVec,
+    size_t treeStart,
+    size_t treeEnd,
+    double* __restrict resultsPtr)
+{
+    if (model.ObliviousTrees.HasFloat32Leaves()) {
+        CalcNonSymmetricTreesImpl<IsSingleClassModel, NeedXorMask, float>(model, binFeatures, docCountInBlock, indexesVec, treeStart, treeEnd, resultsPtr);
+    } else {
+        CalcNonSymmetricTreesImpl<IsSingleClassModel, NeedXorMask, double>(model, binFeatures, docCountInBlock, indexesVec, treeStart, treeEnd, resultsPtr);
+    }
+}
+
+bool HasBinaryFeaturesOnly(const TFullModel& model) {
+    if (!model.ObliviousTrees.IsOblivious() || !model.ObliviousTrees.OneHotFeatures.empty()) {
+        return false;
+    }
+    for (const auto& floatFeature : model.ObliviousTrees.FloatFeatures) {
+        if (floatFeature.Borders.size() > 1) {
+            return false;
+        }
+    }
+    for (const auto& ctrFeature : model.ObliviousTrees.CtrFeatures) {
+        if (ctrFeature.Borders.size() > 1) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void BuildBinaryFeatureMasks(const ui8* binFeatures, size_t bucketCount, size_t docCountInBlock, ui64* masks) {
+    Y_ASSERT(docCountInBlock <= BINARY_FEATURE_MASK_WORDS * 64);
+    for (size_t bucketId = 0; bucketId < bucketCount; ++bucketId) {
+        const ui8* __restrict src = binFeatures + bucketId * docCountInBlock;
+        ui64* __restrict row = masks + bucketId * BINARY_FEATURE_MASK_WORDS;
+        for (size_t wordId = 0; wordId < BINARY_FEATURE_MASK_WORDS; ++wordId) {
+            row[wordId] = 0;
+        }
+        for (size_t docId = 0; docId < docCountInBlock; ++docId) {
+            row[docId >> 6] |= ui64(src[docId] & 1) << (docId & 63);
+        }
+    }
+}
+
+template<bool IsSingleClassModel, typename TLeafType>
+static void CalcTreesBinaryFeaturesImpl(
+    const TFullModel& model,
+    const ui8* __restrict binFeatureMasks,
+    size_t docCountInBlock,
+    TCalcerIndexType* __restrict indexesVec,
+    size_t treeStart,
+    size_t treeEnd,
+    double* __restrict resultsPtr)
+{
+    const TRepackedBin* treeSplitsCurPtr =
+        model.ObliviousTrees.GetRepackedBins().data() + model.ObliviousTrees.TreeStartOffsets[treeStart];
+    const ui64* __restrict masks = reinterpret_cast<const ui64*>(binFeatureMasks);
+    const TLeafType* treeLeafPtr = GetModelLeafValuesPtr<TLeafType>(model.ObliviousTrees);
+    auto firstLeafOffsetsPtr = model.ObliviousTrees.GetFirstLeafOffsets().data();
+    for (size_t treeId = treeStart; treeId < treeEnd; ++treeId) {
+        const auto curTreeSize = model.ObliviousTrees.TreeSizes[treeId];
+        memset(indexesVec, 0, sizeof(TCalcerIndexType) * docCountInBlock);
+        for (int depth = 0; depth < curTreeSize; ++depth) {
+            // binary features make borders trivial: the split result is the mask bit itself
+            const ui64* __restrict row = masks + treeSplitsCurPtr[depth].FeatureIndex * BINARY_FEATURE_MASK_WORDS;
+            for (size_t docId = 0; docId < docCountInBlock; ++docId) {
+                indexesVec[docId] |= ((row[docId >> 6] >> (docId & 63)) & 1) << depth;
+            }
+        }
+        if (IsSingleClassModel) {
+            CalculateLeafValues(docCountInBlock, treeLeafPtr + firstLeafOffsetsPtr[treeId], indexesVec, resultsPtr);
+        } else {
+            CalculateLeafValuesMulti(docCountInBlock, treeLeafPtr + firstLeafOffsetsPtr[treeId], indexesVec, model.ObliviousTrees.ApproxDimension, resultsPtr);
+        }
+        treeSplitsCurPtr += curTreeSize;
+    }
+}
+
+template<bool IsSingleClassModel>
+static void CalcTreesBinaryFeatures(
+    const TFullModel& model,
+    const ui8* __restrict binFeatureMasks,
+    size_t docCountInBlock,
+    TCalcerIndexType* __restrict indexesVec,
+    size_t treeStart,
+    size_t treeEnd,
+    double* __restrict resultsPtr)
+{
+    if (model.ObliviousTrees.HasFloat32Leaves()) {
+        CalcTreesBinaryFeaturesImpl<IsSingleClassModel, float>(model, binFeatureMasks, docCountInBlock, indexesVec, treeStart, treeEnd, resultsPtr);
+    } else {
+        CalcTreesBinaryFeaturesImpl<IsSingleClassModel, double>(model, binFeatureMasks, docCountInBlock, indexesVec, treeStart, treeEnd, resultsPtr);
+    }
+}
+
+TTreeCalcFunction GetCalcTreesBinaryFeaturesFunction(const TFullModel& model) {
+    Y_ASSERT(HasBinaryFeaturesOnly(model));
+    if (model.ObliviousTrees.ApproxDimension == 1) {
+        return CalcTreesBinaryFeatures<true>;
+    }
+    return CalcTreesBinaryFeatures<false>;
+}
+
 TTreeCalcFunction GetCalcTreesFunction(const TFullModel& model, size_t docCountInBlock) {
     const bool hasOneHots = !model.ObliviousTrees.OneHotFeatures.empty();
+    if (!model.ObliviousTrees.IsOblivious()) {
+        if (model.ObliviousTrees.ApproxDimension == 1) {
+            return hasOneHots ? CalcNonSymmetricTrees<true, true> : CalcNonSymmetricTrees<true, false>;
+        } else {
+            return hasOneHots ? CalcNonSymmetricTrees<false, true> : CalcNonSymmetricTrees<false, false>;
+        }
+    }
+    // AVX kernels gather double leaves only, float32 leaf models go through the SSE path
+    const bool doubleLeaves = !model.ObliviousTrees.HasFloat32Leaves();
+    const bool haveAvx2 = NX86::CachedHaveAVX2() && doubleLeaves;
+    const bool haveAvx512 = NX86::CachedHaveAVX512F() && NX86::CachedHaveAVX512BW() && doubleLeaves;
     if (model.ObliviousTrees.ApproxDimension == 1) {
         if (docCountInBlock == 1) {
             if (hasOneHots) {
-                return CalcTreesSingleDocImpl<true, true>;
+                return CalcTreesSingleDoc<true, true>;
             } else {
-                return CalcTreesSingleDocImpl<true, false>;
+                return CalcTreesSingleDoc<true, false>;
             }
         } else {
             if (hasOneHots) {
+                if (haveAvx512) {
+                    return CalcTreesBlockedAvx512SingleClassXored;
+                }
+                if (haveAvx2) {
+                    return CalcTreesBlockedAvx2SingleClassXored;
+                }
                 return CalcTreesBlocked<true, true>;
             } else {
+                if (haveAvx512) {
+                    return CalcTreesBlockedAvx512SingleClass;
+                }
+                if (haveAvx2) {
+                    return CalcTreesBlockedAvx2SingleClass;
+                }
                 return CalcTreesBlocked<true, false>;
             }
         }
     } else {
         if (docCountInBlock == 1) {
             if (hasOneHots) {
-                return CalcTreesSingleDocImpl<false, true>;
+                return CalcTreesSingleDoc<false, true>;
             } else {
-                return CalcTreesSingleDocImpl<false, false>;
+                return CalcTreesSingleDoc<false, false>;
             }
         } else {
             if (hasOneHots) {
+                if (haveAvx512) {
+                    return CalcTreesBlockedAvx512MultiClassXored;
+                }
+                if (haveAvx2) {
+                    return CalcTreesBlockedAvx2MultiClassXored;
+                }
                 return CalcTreesBlocked<false, true>;
             } else {
+                if (haveAvx512) {
+                    return CalcTreesBlockedAvx512MultiClass;
+                }
+                if (haveAvx2) {
+                    return CalcTreesBlockedAvx2MultiClass;
+                }
                 return CalcTreesBlocked<false, false>;
             }
         }
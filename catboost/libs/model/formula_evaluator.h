@@ -2,6 +2,7 @@
 
 #include "model.h"
 #include <catboost/libs/helpers/exception.h>
+#include <library/threading/local_executor/local_executor.h>
 #include <util/generic/ymath.h>
 #include <emmintrin.h>
 
@@ -262,6 +263,23 @@ void CalcIndexes(
 
 TTreeCalcFunction GetCalcTreesFunction(const TFullModel& model, size_t docCountInBlock);
 
+constexpr size_t BINARY_FEATURE_MASK_WORDS = FORMULA_EVALUATION_BLOCK_SIZE / 64;
+
+/**
+ * Binary-feature bit-matrix serving layout: when every feature of an oblivious model
+ * contributes at most one border (no one-hot conditions), every binarized byte is 0/1 and a
+ * 128-document block can store each feature as a 128-bit mask instead of 128 bytes. The
+ * cached-feature evaluators switch to this layout automatically: 8x less binarized feature
+ * memory, and tree descent extracts split bits straight from the masks.
+ */
+bool HasBinaryFeaturesOnly(const TFullModel& model);
+
+//! Pack the 0/1 feature bytes of one block into masks, one row of BINARY_FEATURE_MASK_WORDS per bucket
+void BuildBinaryFeatureMasks(const ui8* binFeatures, size_t bucketCount, size_t docCountInBlock, ui64* masks);
+
+//! Tree calculator over the bit-matrix layout; binFeatures must point to the packed masks
+TTreeCalcFunction GetCalcTreesBinaryFeaturesFunction(const TFullModel& model);
+
 template<class X>
 inline X* GetAligned(X* val) {
     uintptr_t off = ((uintptr_t)val) & 0xf;
@@ -269,6 +287,73 @@ inline X* GetAligned(X* val) {
     return val;
 }
 
+/**
+ * Caller-owned scratch buffers for model evaluation. The buffers grow on demand and are never
+ * shrunk, so a context reused across calls makes steady-state scoring free of heap allocations.
+ * A context is not thread safe; use one per scoring thread.
+ */
+struct TEvaluationContext {
+    TVector<ui8> BinFeatures;
+    TVector<TCalcerIndexType> IndexesVec;
+    TVector<int> TransposedHash;
+    TVector<float> Ctrs;
+};
+
+template<typename TFloatFeatureAccessor, typename TCatFeatureAccessor>
+inline void CalcGeneric(
+    const TFullModel& model,
+    TFloatFeatureAccessor floatFeatureAccessor,
+    TCatFeatureAccessor catFeaturesAccessor,
+    size_t docCount,
+    size_t treeStart,
+    size_t treeEnd,
+    TArrayRef<double> results,
+    TEvaluationContext& context)
+{
+    const size_t blockSize = Min<size_t>(FORMULA_EVALUATION_BLOCK_SIZE, docCount);
+    const size_t binSlots = blockSize * model.ObliviousTrees.GetEffectiveBinaryFeaturesBucketsCount();
+    const size_t hashSlots = blockSize * model.ObliviousTrees.CatFeatures.size();
+    const size_t ctrSlots = blockSize * model.ObliviousTrees.GetUsedModelCtrs().size();
+    if (context.BinFeatures.size() < binSlots) {
+        context.BinFeatures.yresize(binSlots);
+    }
+    if (context.IndexesVec.size() < blockSize) {
+        context.IndexesVec.yresize(blockSize);
+    }
+    if (context.TransposedHash.size() < hashSlots) {
+        context.TransposedHash.yresize(hashSlots);
+    }
+    if (context.Ctrs.size() < ctrSlots) {
+        context.Ctrs.yresize(ctrSlots);
+    }
+    auto binFeatures = MakeArrayRef(context.BinFeatures.data(), binSlots);
+    auto calcTrees = GetCalcTreesFunction(model, blockSize);
+    CB_ENSURE(results.size() == docCount * model.ObliviousTrees.ApproxDimension);
+    std::fill(results.begin(), results.end(), 0.0);
+    for (size_t blockStart = 0; blockStart < docCount; blockStart += blockSize) {
+        const auto docCountInBlock = Min(blockSize, docCount - blockStart);
+        BinarizeFeatures(
+            model,
+            floatFeatureAccessor,
+            catFeaturesAccessor,
+            blockStart,
+            blockStart + docCountInBlock,
+            binFeatures,
+            context.TransposedHash,
+            context.Ctrs
+        );
+        calcTrees(
+            model,
+            binFeatures.data(),
+            docCountInBlock,
+            docCount == 1 ? nullptr : context.IndexesVec.data(),
+            treeStart,
+            treeEnd,
+            results.data() + blockStart * model.ObliviousTrees.ApproxDimension
+        );
+    }
+}
+
 template<typename TFloatFeatureAccessor, typename TCatFeatureAccessor>
 inline void CalcGeneric(
     const TFullModel& model,
@@ -363,13 +448,19 @@ public:
             , DocCount(docCount) {
         size_t blockSize = FORMULA_EVALUATION_BLOCK_SIZE;
         BlockSize = Min(blockSize, docCount);
-        CalcFunction = GetCalcTreesFunction(Model, BlockSize);
+        const bool packToBitMasks = HasBinaryFeaturesOnly(model);
+        if (packToBitMasks) {
+            CalcFunction = GetCalcTreesBinaryFeaturesFunction(Model);
+        } else {
+            CalcFunction = GetCalcTreesFunction(Model, BlockSize);
+        }
+        const size_t bucketCount = model.ObliviousTrees.GetEffectiveBinaryFeaturesBucketsCount();
         TVector<int> transposedHash(blockSize * model.ObliviousTrees.CatFeatures.size());
         TVector<float> ctrs(model.ObliviousTrees.GetUsedModelCtrs().size() * blockSize);
         {
             for (size_t blockStart = 0; blockStart < docCount; blockStart += blockSize) {
                 const auto docCountInBlock = Min(blockSize, docCount - blockStart);
-                TVector<ui8> binFeatures(model.ObliviousTrees.GetEffectiveBinaryFeaturesBucketsCount() * blockSize);
+                TVector<ui8> binFeatures(bucketCount * blockSize);
                 BinarizeFeatures(
                         model,
                         floatFeatureAccessor,
@@ -380,18 +471,116 @@ public:
                         transposedHash,
                         ctrs
                 );
-                BinFeatures.push_back(std::move(binFeatures));
+                if (packToBitMasks) {
+                    TVector<ui8> masks(bucketCount * BINARY_FEATURE_MASK_WORDS * sizeof(ui64));
+                    BuildBinaryFeatureMasks(binFeatures.data(), bucketCount, docCountInBlock, (ui64*)masks.data());
+                    BinFeatures.push_back(std::move(masks));
+                } else {
+                    BinFeatures.push_back(std::move(binFeatures));
+                }
             }
         }
     }
 
     void Calc(size_t treeStart, size_t treeEnd, TArrayRef<double> results) const;
+
+    /**
+     * Parallel version: binarized document blocks are partitioned across the
+     * executor threads. Every block writes to a disjoint slice of results, so
+     * no extra accumulation buffers are needed.
+     */
+    void Calc(size_t treeStart, size_t treeEnd, TArrayRef<double> results, NPar::TLocalExecutor* executor) const;
+private:
+    const TFullModel& Model;
+    TVector<TVector<ui8>> BinFeatures;
+    TTreeCalcFunction CalcFunction;
+    ui64 DocCount;
+    ui64 BlockSize;
+};
+
+/**
+ * Staged evaluator for ranking cascades: binarized features and per-document partial sums stay
+ * alive across stages, so candidates can be scored on a tree prefix, filtered and only the
+ * survivors carried through the remaining trees. Early exit uses the per-tree leaf value bounds
+ * stored in TObliviousTrees metadata. Documents are only skipped at whole-block granularity, so
+ * savings materialize once all documents of a 128-doc block are discarded.
+ */
+class TStagedTreeEvaluator {
+public:
+    template<typename TFloatFeatureAccessor,
+             typename TCatFeatureAccessor>
+    TStagedTreeEvaluator(const TFullModel& model,
+                         TFloatFeatureAccessor floatFeatureAccessor,
+                         TCatFeatureAccessor catFeaturesAccessor,
+                         size_t docCount)
+            : Model(model)
+            , DocCount(docCount) {
+        size_t blockSize = FORMULA_EVALUATION_BLOCK_SIZE;
+        BlockSize = Min(blockSize, docCount);
+        const bool packToBitMasks = HasBinaryFeaturesOnly(model);
+        if (packToBitMasks) {
+            CalcFunction = GetCalcTreesBinaryFeaturesFunction(Model);
+        } else {
+            CalcFunction = GetCalcTreesFunction(Model, BlockSize);
+        }
+        const size_t bucketCount = model.ObliviousTrees.GetEffectiveBinaryFeaturesBucketsCount();
+        PartialResults.resize(docCount * model.ObliviousTrees.ApproxDimension, 0.0);
+        ActiveDocs.resize(docCount, true);
+        TVector<int> transposedHash(blockSize * model.ObliviousTrees.CatFeatures.size());
+        TVector<float> ctrs(model.ObliviousTrees.GetUsedModelCtrs().size() * blockSize);
+        for (size_t blockStart = 0; blockStart < docCount; blockStart += blockSize) {
+            const auto docCountInBlock = Min(blockSize, docCount - blockStart);
+            TVector<ui8> binFeatures(bucketCount * blockSize);
+            BinarizeFeatures(
+                    model,
+                    floatFeatureAccessor,
+                    catFeaturesAccessor,
+                    blockStart,
+                    blockStart + docCountInBlock,
+                    binFeatures,
+                    transposedHash,
+                    ctrs
+            );
+            if (packToBitMasks) {
+                TVector<ui8> masks(bucketCount * BINARY_FEATURE_MASK_WORDS * sizeof(ui64));
+                BuildBinaryFeatureMasks(binFeatures.data(), bucketCount, docCountInBlock, (ui64*)masks.data());
+                BinFeatures.push_back(std::move(masks));
+            } else {
+                BinFeatures.push_back(std::move(binFeatures));
+            }
+            BlockActiveDocCounts.push_back(docCountInBlock);
+        }
+    }
+
+    //! Evaluate trees [GetTreesProcessed(); treeEnd), accumulating into the internal partial sums
+    void CalcStage(size_t treeEnd);
+
+    /**
+     * Deactivate documents that cannot reach the threshold even if all remaining trees give their
+     * maximal leaf values (single dimension models only). Returns remaining active document count.
+     */
+    size_t ApplyMarginEarlyExit(double threshold);
+
+    bool IsActive(size_t docId) const {
+        return ActiveDocs[docId];
+    }
+    size_t GetTreesProcessed() const {
+        return TreesProcessed;
+    }
+    TConstArrayRef<double> GetPartialResults() const {
+        return PartialResults;
+    }
+
 private:
     const TFullModel& Model;
     TVector<TVector<ui8>> BinFeatures;
     TTreeCalcFunction CalcFunction;
+    TVector<double> PartialResults;
+    TVector<bool> ActiveDocs;
+    TVector<size_t> BlockActiveDocCounts;
     ui64 DocCount;
     ui64 BlockSize;
+    size_t TreesProcessed = 0;
 };
 
 template<typename TFloatFeatureAccessor, typename TCatFeatureAccessor>
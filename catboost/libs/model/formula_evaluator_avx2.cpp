@@ -0,0 +1,159 @@
+#include "formula_evaluator.h"
+
+#include <immintrin.h>
+
+namespace {
+    constexpr size_t AVX2_BLOCK_SIZE = 32;
+    constexpr size_t MAX_AVX2_BLOCKS = FORMULA_EVALUATION_BLOCK_SIZE / AVX2_BLOCK_SIZE;
+
+    template<bool NeedXorMask, typename TIndexType>
+    Y_FORCE_INLINE void CalcIndexesScalarTail(
+        const ui8* __restrict binFeatures,
+        size_t docCountInBlock,
+        size_t tailStart,
+        TIndexType* __restrict indexesVec,
+        const TRepackedBin* __restrict treeSplitsCurPtr,
+        int curTreeSize)
+    {
+        for (int depth = 0; depth < curTreeSize; ++depth) {
+            const ui8 borderVal = (ui8)(treeSplitsCurPtr[depth].SplitIdx);
+            const ui8* __restrict binFeaturePtr = binFeatures + treeSplitsCurPtr[depth].FeatureIndex * docCountInBlock;
+            const ui8 xorMask = treeSplitsCurPtr[depth].XorMask;
+            for (size_t docId = tailStart; docId < docCountInBlock; ++docId) {
+                if (NeedXorMask) {
+                    indexesVec[docId] |= TIndexType((binFeaturePtr[docId] ^ xorMask) >= borderVal) << depth;
+                } else {
+                    indexesVec[docId] |= TIndexType(binFeaturePtr[docId] >= borderVal) << depth;
+                }
+            }
+        }
+    }
+
+    template<bool NeedXorMask>
+    Y_FORCE_INLINE void CalcIndexesAvx2(
+        const ui8* __restrict binFeatures,
+        size_t docCountInBlock,
+        ui8* __restrict indexesVec,
+        const TRepackedBin* __restrict treeSplitsCurPtr,
+        const int curTreeSize)
+    {
+        const size_t blockCount = docCountInBlock / AVX2_BLOCK_SIZE;
+        __m256i v[MAX_AVX2_BLOCKS];
+        for (size_t blockId = 0; blockId < blockCount; ++blockId) {
+            v[blockId] = _mm256_setzero_si256();
+        }
+        __m256i bitMask = _mm256_set1_epi8(0x01);
+        for (int depth = 0; depth < curTreeSize; ++depth) {
+            const ui8* __restrict binFeaturePtr = binFeatures + treeSplitsCurPtr[depth].FeatureIndex * docCountInBlock;
+            const __m256i borderVec = _mm256_set1_epi8(treeSplitsCurPtr[depth].SplitIdx);
+            const __m256i xorMaskVec = _mm256_set1_epi8(treeSplitsCurPtr[depth].XorMask);
+            for (size_t blockId = 0; blockId < blockCount; ++blockId) {
+                __m256i vals = _mm256_loadu_si256((const __m256i*)(binFeaturePtr + blockId * AVX2_BLOCK_SIZE));
+                if (NeedXorMask) {
+                    vals = _mm256_xor_si256(vals, xorMaskVec);
+                }
+                const __m256i isGe = _mm256_cmpeq_epi8(_mm256_max_epu8(vals, borderVec), vals);
+                v[blockId] = _mm256_or_si256(v[blockId], _mm256_and_si256(isGe, bitMask));
+            }
+            bitMask = _mm256_slli_epi16(bitMask, 1);
+        }
+        for (size_t blockId = 0; blockId < blockCount; ++blockId) {
+            _mm256_storeu_si256((__m256i*)(indexesVec + blockId * AVX2_BLOCK_SIZE), v[blockId]);
+        }
+        const size_t tailStart = blockCount * AVX2_BLOCK_SIZE;
+        if (tailStart < docCountInBlock) {
+            CalcIndexesScalarTail<NeedXorMask>(binFeatures, docCountInBlock, tailStart, indexesVec, treeSplitsCurPtr, curTreeSize);
+        }
+    }
+
+    Y_FORCE_INLINE void GatherAddLeafAvx2(
+        const size_t docCountInBlock,
+        const double* __restrict treeLeafPtr,
+        const ui8* __restrict indexesPtr,
+        double* __restrict writePtr)
+    {
+        _mm_prefetch((const char*)(treeLeafPtr + 64), _MM_HINT_T2);
+        const size_t docCountInBlock4 = (docCountInBlock | 0x3) ^ 0x3;
+        for (size_t docId = 0; docId < docCountInBlock4; docId += 4) {
+            const __m128i idx32 = _mm_cvtepu8_epi32(_mm_cvtsi32_si128(*(const int*)(indexesPtr + docId)));
+            const __m256d leaves = _mm256_i32gather_pd(treeLeafPtr, idx32, sizeof(double));
+            _mm256_storeu_pd(writePtr + docId, _mm256_add_pd(_mm256_loadu_pd(writePtr + docId), leaves));
+        }
+        for (size_t docId = docCountInBlock4; docId < docCountInBlock; ++docId) {
+            writePtr[docId] += treeLeafPtr[indexesPtr[docId]];
+        }
+    }
+
+    template<typename TIndexType>
+    Y_FORCE_INLINE void AddLeafValuesMulti(
+        const size_t docCountInBlock,
+        const double* __restrict leafPtr,
+        const TIndexType* __restrict indexesVec,
+        const int approxDimension,
+        double* __restrict writePtr)
+    {
+        for (size_t docId = 0; docId < docCountInBlock; ++docId) {
+            auto leafValuePtr = leafPtr + indexesVec[docId] * approxDimension;
+            for (int classId = 0; classId < approxDimension; ++classId) {
+                writePtr[classId] += leafValuePtr[classId];
+            }
+            writePtr += approxDimension;
+        }
+    }
+
+    template<bool IsSingleClassModel, bool NeedXorMask>
+    void CalcTreesBlockedAvx2(
+        const TFullModel& model,
+        const ui8* __restrict binFeatures,
+        size_t docCountInBlock,
+        TCalcerIndexType* __restrict indexesVecUI32,
+        size_t treeStart,
+        size_t treeEnd,
+        double* __restrict resultsPtr)
+    {
+        const TRepackedBin* treeSplitsCurPtr =
+            model.ObliviousTrees.GetRepackedBins().data() + model.ObliviousTrees.TreeStartOffsets[treeStart];
+        ui8* __restrict indexesVec = (ui8*)indexesVecUI32;
+        const auto treeLeafPtr = model.ObliviousTrees.GetLeafValuesRef().data();
+        auto firstLeafOffsetsPtr = model.ObliviousTrees.GetFirstLeafOffsets().data();
+        for (size_t treeId = treeStart; treeId < treeEnd; ++treeId) {
+            const auto curTreeSize = model.ObliviousTrees.TreeSizes[treeId];
+            if (curTreeSize <= 8) {
+                memset(indexesVec, 0, docCountInBlock);
+                CalcIndexesAvx2<NeedXorMask>(binFeatures, docCountInBlock, indexesVec, treeSplitsCurPtr, curTreeSize);
+                if (IsSingleClassModel) {
+                    GatherAddLeafAvx2(docCountInBlock, treeLeafPtr + firstLeafOffsetsPtr[treeId], indexesVec, resultsPtr);
+                } else {
+                    AddLeafValuesMulti(docCountInBlock, treeLeafPtr + firstLeafOffsetsPtr[treeId], indexesVec, model.ObliviousTrees.ApproxDimension, resultsPtr);
+                }
+            } else {
+                memset(indexesVecUI32, 0, sizeof(ui32) * docCountInBlock);
+                CalcIndexesScalarTail<NeedXorMask>(binFeatures, docCountInBlock, 0, indexesVecUI32, treeSplitsCurPtr, curTreeSize);
+                if (IsSingleClassModel) {
+                    for (size_t docId = 0; docId < docCountInBlock; ++docId) {
+                        resultsPtr[docId] += (treeLeafPtr + firstLeafOffsetsPtr[treeId])[indexesVecUI32[docId]];
+                    }
+                } else {
+                    AddLeafValuesMulti(docCountInBlock, treeLeafPtr + firstLeafOffsetsPtr[treeId], indexesVecUI32, model.ObliviousTrees.ApproxDimension, resultsPtr);
+                }
+            }
+            treeSplitsCurPtr += curTreeSize;
+        }
+    }
+}
+
+void CalcTreesBlockedAvx2SingleClass(const TFullModel& model, const ui8* __restrict binFeatures, size_t docCountInBlock, TCalcerIndexType* __restrict indexesVec, size_t treeStart, size_t treeEnd, double* __restrict resultsPtr) {
+    CalcTreesBlockedAvx2<true, false>(model, binFeatures, docCountInBlock, indexesVec, treeStart, treeEnd, resultsPtr);
+}
+
+void CalcTreesBlockedAvx2SingleClassXored(const TFullModel& model, const ui8* __restrict binFeatures, size_t docCountInBlock, TCalcerIndexType* __restrict indexesVec, size_t treeStart, size_t treeEnd, double* __restrict resultsPtr) {
+    CalcTreesBlockedAvx2<true, true>(model, binFeatures, docCountInBlock, indexesVec, treeStart, treeEnd, resultsPtr);
+}
+
+void CalcTreesBlockedAvx2MultiClass(const TFullModel& model, const ui8* __restrict binFeatures, size_t docCountInBlock, TCalcerIndexType* __restrict indexesVec, size_t treeStart, size_t treeEnd, double* __restrict resultsPtr) {
+    CalcTreesBlockedAvx2<false, false>(model, binFeatures, docCountInBlock, indexesVec, treeStart, treeEnd, resultsPtr);
+}
+
+void CalcTreesBlockedAvx2MultiClassXored(const TFullModel& model, const ui8* __restrict binFeatures, size_t docCountInBlock, TCalcerIndexType* __restrict indexesVec, size_t treeStart, size_t treeEnd, double* __restrict resultsPtr) {
+    CalcTreesBlockedAvx2<false, true>(model, binFeatures, docCountInBlock, indexesVec, treeStart, treeEnd, resultsPtr);
+}
@@ -0,0 +1,158 @@
+#include "formula_evaluator.h"
+
+#include <immintrin.h>
+
+namespace {
+    constexpr size_t AVX512_BLOCK_SIZE = 64;
+    constexpr size_t MAX_AVX512_BLOCKS = FORMULA_EVALUATION_BLOCK_SIZE / AVX512_BLOCK_SIZE;
+
+    template<bool NeedXorMask, typename TIndexType>
+    Y_FORCE_INLINE void CalcIndexesScalar(
+        const ui8* __restrict binFeatures,
+        size_t docCountInBlock,
+        size_t docStart,
+        TIndexType* __restrict indexesVec,
+        const TRepackedBin* __restrict treeSplitsCurPtr,
+        int curTreeSize)
+    {
+        for (int depth = 0; depth < curTreeSize; ++depth) {
+            const ui8 borderVal = (ui8)(treeSplitsCurPtr[depth].SplitIdx);
+            const ui8* __restrict binFeaturePtr = binFeatures + treeSplitsCurPtr[depth].FeatureIndex * docCountInBlock;
+            const ui8 xorMask = treeSplitsCurPtr[depth].XorMask;
+            for (size_t docId = docStart; docId < docCountInBlock; ++docId) {
+                if (NeedXorMask) {
+                    indexesVec[docId] |= TIndexType((binFeaturePtr[docId] ^ xorMask) >= borderVal) << depth;
+                } else {
+                    indexesVec[docId] |= TIndexType(binFeaturePtr[docId] >= borderVal) << depth;
+                }
+            }
+        }
+    }
+
+    template<bool NeedXorMask>
+    Y_FORCE_INLINE void CalcIndexesAvx512(
+        const ui8* __restrict binFeatures,
+        size_t docCountInBlock,
+        ui8* __restrict indexesVec,
+        const TRepackedBin* __restrict treeSplitsCurPtr,
+        const int curTreeSize)
+    {
+        const size_t blockCount = docCountInBlock / AVX512_BLOCK_SIZE;
+        __m512i v[MAX_AVX512_BLOCKS];
+        for (size_t blockId = 0; blockId < blockCount; ++blockId) {
+            v[blockId] = _mm512_setzero_si512();
+        }
+        for (int depth = 0; depth < curTreeSize; ++depth) {
+            const ui8* __restrict binFeaturePtr = binFeatures + treeSplitsCurPtr[depth].FeatureIndex * docCountInBlock;
+            const __m512i borderVec = _mm512_set1_epi8(treeSplitsCurPtr[depth].SplitIdx);
+            const __m512i xorMaskVec = _mm512_set1_epi8(treeSplitsCurPtr[depth].XorMask);
+            const __m512i bitVec = _mm512_set1_epi8((ui8)(1 << depth));
+            for (size_t blockId = 0; blockId < blockCount; ++blockId) {
+                __m512i vals = _mm512_loadu_si512((const void*)(binFeaturePtr + blockId * AVX512_BLOCK_SIZE));
+                if (NeedXorMask) {
+                    vals = _mm512_xor_si512(vals, xorMaskVec);
+                }
+                const __mmask64 isGe = _mm512_cmpge_epu8_mask(vals, borderVec);
+                v[blockId] = _mm512_or_si512(v[blockId], _mm512_maskz_mov_epi8(isGe, bitVec));
+            }
+        }
+        for (size_t blockId = 0; blockId < blockCount; ++blockId) {
+            _mm512_storeu_si512((void*)(indexesVec + blockId * AVX512_BLOCK_SIZE), v[blockId]);
+        }
+        const size_t tailStart = blockCount * AVX512_BLOCK_SIZE;
+        if (tailStart < docCountInBlock) {
+            CalcIndexesScalar<NeedXorMask>(binFeatures, docCountInBlock, tailStart, indexesVec, treeSplitsCurPtr, curTreeSize);
+        }
+    }
+
+    Y_FORCE_INLINE void GatherAddLeafAvx512(
+        const size_t docCountInBlock,
+        const double* __restrict treeLeafPtr,
+        const ui8* __restrict indexesPtr,
+        double* __restrict writePtr)
+    {
+        _mm_prefetch((const char*)(treeLeafPtr + 64), _MM_HINT_T2);
+        const size_t docCountInBlock8 = (docCountInBlock | 0x7) ^ 0x7;
+        for (size_t docId = 0; docId < docCountInBlock8; docId += 8) {
+            const __m256i idx32 = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(indexesPtr + docId)));
+            const __m512d leaves = _mm512_i32gather_pd(idx32, treeLeafPtr, sizeof(double));
+            _mm512_storeu_pd(writePtr + docId, _mm512_add_pd(_mm512_loadu_pd(writePtr + docId), leaves));
+        }
+        for (size_t docId = docCountInBlock8; docId < docCountInBlock; ++docId) {
+            writePtr[docId] += treeLeafPtr[indexesPtr[docId]];
+        }
+    }
+
+    template<typename TIndexType>
+    Y_FORCE_INLINE void AddLeafValuesMulti(
+        const size_t docCountInBlock,
+        const double* __restrict leafPtr,
+        const TIndexType* __restrict indexesVec,
+        const int approxDimension,
+        double* __restrict writePtr)
+    {
+        for (size_t docId = 0; docId < docCountInBlock; ++docId) {
+            auto leafValuePtr = leafPtr + indexesVec[docId] * approxDimension;
+            for (int classId = 0; classId < approxDimension; ++classId) {
+                writePtr[classId] += leafValuePtr[classId];
+            }
+            writePtr += approxDimension;
+        }
+    }
+
+    template<bool IsSingleClassModel, bool NeedXorMask>
+    void CalcTreesBlockedAvx512(
+        const TFullModel& model,
+        const ui8* __restrict binFeatures,
+        size_t docCountInBlock,
+        TCalcerIndexType* __restrict indexesVecUI32,
+        size_t treeStart,
+        size_t treeEnd,
+        double* __restrict resultsPtr)
+    {
+        const TRepackedBin* treeSplitsCurPtr =
+            model.ObliviousTrees.GetRepackedBins().data() + model.ObliviousTrees.TreeStartOffsets[treeStart];
+        ui8* __restrict indexesVec = (ui8*)indexesVecUI32;
+        const auto treeLeafPtr = model.ObliviousTrees.GetLeafValuesRef().data();
+        auto firstLeafOffsetsPtr = model.ObliviousTrees.GetFirstLeafOffsets().data();
+        for (size_t treeId = treeStart; treeId < treeEnd; ++treeId) {
+            const auto curTreeSize = model.ObliviousTrees.TreeSizes[treeId];
+            if (curTreeSize <= 8) {
+                memset(indexesVec, 0, docCountInBlock);
+                CalcIndexesAvx512<NeedXorMask>(binFeatures, docCountInBlock, indexesVec, treeSplitsCurPtr, curTreeSize);
+                if (IsSingleClassModel) {
+                    GatherAddLeafAvx512(docCountInBlock, treeLeafPtr + firstLeafOffsetsPtr[treeId], indexesVec, resultsPtr);
+                } else {
+                    AddLeafValuesMulti(docCountInBlock, treeLeafPtr + firstLeafOffsetsPtr[treeId], indexesVec, model.ObliviousTrees.ApproxDimension, resultsPtr);
+                }
+            } else {
+                memset(indexesVecUI32, 0, sizeof(ui32) * docCountInBlock);
+                CalcIndexesScalar<NeedXorMask>(binFeatures, docCountInBlock, 0, indexesVecUI32, treeSplitsCurPtr, curTreeSize);
+                if (IsSingleClassModel) {
+                    for (size_t docId = 0; docId < docCountInBlock; ++docId) {
+                        resultsPtr[docId] += (treeLeafPtr + firstLeafOffsetsPtr[treeId])[indexesVecUI32[docId]];
+                    }
+                } else {
+                    AddLeafValuesMulti(docCountInBlock, treeLeafPtr + firstLeafOffsetsPtr[treeId], indexesVecUI32, model.ObliviousTrees.ApproxDimension, resultsPtr);
+                }
+            }
+            treeSplitsCurPtr += curTreeSize;
+        }
+    }
+}
+
+void CalcTreesBlockedAvx512SingleClass(const TFullModel& model, const ui8* __restrict binFeatures, size_t docCountInBlock, TCalcerIndexType* __restrict indexesVec, size_t treeStart, size_t treeEnd, double* __restrict resultsPtr) {
+    CalcTreesBlockedAvx512<true, false>(model, binFeatures, docCountInBlock, indexesVec, treeStart, treeEnd, resultsPtr);
+}
+
+void CalcTreesBlockedAvx512SingleClassXored(const TFullModel& model, const ui8* __restrict binFeatures, size_t docCountInBlock, TCalcerIndexType* __restrict indexesVec, size_t treeStart, size_t treeEnd, double* __restrict resultsPtr) {
+    CalcTreesBlockedAvx512<true, true>(model, binFeatures, docCountInBlock, indexesVec, treeStart, treeEnd, resultsPtr);
+}
+
+void CalcTreesBlockedAvx512MultiClass(const TFullModel& model, const ui8* __restrict binFeatures, size_t docCountInBlock, TCalcerIndexType* __restrict indexesVec, size_t treeStart, size_t treeEnd, double* __restrict resultsPtr) {
+    CalcTreesBlockedAvx512<false, false>(model, binFeatures, docCountInBlock, indexesVec, treeStart, treeEnd, resultsPtr);
+}
+
+void CalcTreesBlockedAvx512MultiClassXored(const TFullModel& model, const ui8* __restrict binFeatures, size_t docCountInBlock, TCalcerIndexType* __restrict indexesVec, size_t treeStart, size_t treeEnd, double* __restrict resultsPtr) {
+    CalcTreesBlockedAvx512<false, true>(model, binFeatures, docCountInBlock, indexesVec, treeStart, treeEnd, resultsPtr);
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "model.h"
+
+#include <catboost/libs/options/enums.h>
+
+#include <library/object_factory/object_factory.h>
+
+#include <util/generic/array_ref.h>
+#include <util/generic/vector.h>
+
+//! Device-side batch applier for oblivious-tree models. Implementations live in
+//! catboost/cuda and register themselves in TGpuModelEvaluatorFactory, so binaries
+//! built without CUDA support just find the factory empty for ETaskType::GPU.
+class IGpuModelEvaluator {
+public:
+    virtual ~IGpuModelEvaluator() = default;
+
+    //! Apply trees [treeBegin, treeEnd) of a model without categorical features.
+    //! floatFeatureColumns[i] is the value column for model float feature i
+    //! (ObliviousTrees.FloatFeatures order); all columns share one document count.
+    //! result gets one raw formula value per document and is overwritten.
+    virtual void CalcFlat(const TFullModel& model,
+                          const TVector<TConstArrayRef<float>>& floatFeatureColumns,
+                          size_t treeBegin,
+                          size_t treeEnd,
+                          TArrayRef<double> result) = 0;
+};
+
+using TGpuModelEvaluatorFactory = NObjectFactory::TParametrizedObjectFactory<IGpuModelEvaluator, ETaskType>;
@@ -15,8 +15,13 @@
 
 #include <library/json/json_reader.h>
 
+#include <util/generic/algorithm.h>
+#include <util/generic/ymath.h>
 #include <util/string/builder.h>
 #include <util/stream/buffer.h>
+#include <util/stream/mem.h>
+#include <util/system/info.h>
+#include <util/system/unaligned_mem.h>
 #include <util/stream/str.h>
 #include <util/stream/file.h>
 
@@ -26,6 +31,30 @@ ui32 GetModelFormatDescriptor() {
     return *reinterpret_cast<const ui32*>(MODEL_FILE_DESCRIPTOR_CHARS);
 }
 
+// Streamed model format: the core flatbuffer is built without leaf values and
+// weights, and they are written right after it straight from the model arrays.
+// See TFullModel::StreamLeafDataOnSave.
+static const char STREAMED_MODEL_FILE_DESCRIPTOR_CHARS[4] = {'C', 'B', 'M', '2'};
+
+static ui32 GetStreamedModelFormatDescriptor() {
+    return *reinterpret_cast<const ui32*>(STREAMED_MODEL_FILE_DESCRIPTOR_CHARS);
+}
+
+/* Streamed leaf data block layout, written right after the core flatbuffer:
+ *   ui8 valueType, ui8 padLen, ui64 valueCount, double scale, double bias,
+ *   padLen zero bytes, raw leaf values, ui64 flatWeightCount, raw leaf weights.
+ * Padding aligns the leaf values to 8 bytes in the file so the mmap reader can
+ * view double leaves in place. scale/bias are identity unless valueType is Int16.
+ */
+enum class EStreamedLeafValuesType : ui8 {
+    Double = 0,
+    Float = 1,
+    Int16 = 2,
+};
+
+static const size_t StreamedLeafDataHeaderSize = 2 * sizeof(ui8) + sizeof(ui64) + 2 * sizeof(double);
+static const size_t StreamedLeafValuesPerChunk = 1 << 20;
+
 static const char* CURRENT_CORE_FORMAT_STRING = "FlabuffersModel_v1";
 
 void OutputModel(const TFullModel& model, const TString& modelFile) {
@@ -85,6 +114,141 @@ TFullModel ReadModel(const void* binaryBuffer, size_t binaryBufferSize, EModelTy
     return ReadModel(&bs, format);
 }
 
+// Metadata the library itself reads through ModelInfo must be materialized even
+// when large; everything else above the threshold is exposed through
+// LazyModelInfo without touching the mapped pages.
+static bool IsEagerlyLoadedInfoKey(const TStringBuf key) {
+    return key == "params" || key == "multiclass_params";
+}
+
+static const size_t LazyModelInfoValueSizeThreshold = 16 * 1024;
+
+/* Mapped-file counterpart of LoadStreamedLeafData: double leaves are viewed in
+ * place (the writer 8-byte aligns them in the file), float/int16 leaves and leaf
+ * weights are materialized. Returns the offset right past the leaf data block.
+ */
+static size_t ReadStreamedLeafDataFromBlob(const ui8* dataPtr, size_t blobSize, size_t offset, TObliviousTrees* trees) {
+    CB_ENSURE(offset + StreamedLeafDataHeaderSize <= blobSize, "incorrect model leaf data size");
+    const ui8 valueType = dataPtr[offset];
+    const ui8 padLen = dataPtr[offset + 1];
+    const ui64 valueCount = ReadUnaligned<ui64>(dataPtr + offset + 2);
+    const double scale = ReadUnaligned<double>(dataPtr + offset + 2 + sizeof(ui64));
+    const double bias = ReadUnaligned<double>(dataPtr + offset + 2 + sizeof(ui64) + sizeof(double));
+    offset += StreamedLeafDataHeaderSize + padLen;
+    switch (static_cast<EStreamedLeafValuesType>(valueType)) {
+        case EStreamedLeafValuesType::Double: {
+            CB_ENSURE(offset + valueCount * sizeof(double) <= blobSize, "incorrect model leaf data size");
+            Y_ASSERT(reinterpret_cast<uintptr_t>(dataPtr + offset) % alignof(double) == 0);
+            trees->LeafValuesView = MakeArrayRef(reinterpret_cast<const double*>(dataPtr + offset), valueCount);
+            offset += valueCount * sizeof(double);
+            break;
+        }
+        case EStreamedLeafValuesType::Float:
+            CB_ENSURE(offset + valueCount * sizeof(float) <= blobSize, "incorrect model leaf data size");
+            trees->LeafValuesFloat.yresize(valueCount);
+            memcpy(trees->LeafValuesFloat.data(), dataPtr + offset, valueCount * sizeof(float));
+            offset += valueCount * sizeof(float);
+            break;
+        case EStreamedLeafValuesType::Int16: {
+            CB_ENSURE(offset + valueCount * sizeof(i16) <= blobSize, "incorrect model leaf data size");
+            trees->LeafValuesFloat.yresize(valueCount);
+            for (size_t i = 0; i < valueCount; ++i) {
+                trees->LeafValuesFloat[i] = static_cast<float>(
+                    bias + scale * ReadUnaligned<i16>(dataPtr + offset + i * sizeof(i16)));
+            }
+            offset += valueCount * sizeof(i16);
+            break;
+        }
+        default:
+            CB_ENSURE(false, "unknown leaf values type in streamed model: " << static_cast<int>(valueType));
+    }
+    CB_ENSURE(offset + sizeof(ui64) <= blobSize, "incorrect model leaf data size");
+    const ui64 flatWeightCount = ReadUnaligned<ui64>(dataPtr + offset);
+    offset += sizeof(ui64);
+    if (flatWeightCount) {
+        CB_ENSURE(offset + flatWeightCount * sizeof(double) <= blobSize, "incorrect model leaf data size");
+        trees->LeafWeights.resize(trees->TreeSizes.size());
+        ui64 readWeights = 0;
+        for (size_t treeId = 0; treeId < trees->TreeSizes.size(); ++treeId) {
+            const size_t treeLeafCount = size_t(1) << trees->TreeSizes[treeId];
+            trees->LeafWeights[treeId].yresize(treeLeafCount);
+            memcpy(trees->LeafWeights[treeId].data(), dataPtr + offset, treeLeafCount * sizeof(double));
+            offset += treeLeafCount * sizeof(double);
+            readWeights += treeLeafCount;
+        }
+        CB_ENSURE(readWeights == flatWeightCount, "corrupted streamed model leaf weights");
+    }
+    return offset;
+}
+
+TFullModel ReadModelFromMappedFile(const TString& modelFile) {
+    using namespace flatbuffers;
+    using namespace NCatBoostFbs;
+    TBlob blob = TBlob::FromFile(modelFile);
+    CB_ENSURE(blob.Size() > 2 * sizeof(ui32), "incorrect model file size");
+    const ui8* dataPtr = blob.AsUnsignedCharPtr();
+    const ui32 fileDescriptor = ReadUnaligned<ui32>(dataPtr);
+    const bool streamedLeafData = fileDescriptor == GetStreamedModelFormatDescriptor();
+    CB_ENSURE(
+        streamedLeafData || fileDescriptor == GetModelFormatDescriptor(),
+        "Incorrect model file descriptor"
+    );
+    size_t coreOffset = sizeof(ui32);
+    ui64 coreSize = ReadUnaligned<ui32>(dataPtr + coreOffset);
+    coreOffset += sizeof(ui32);
+    if (coreSize == Max<ui32>()) { // huge model cores store 64-bit size, see SaveSize()
+        coreSize = ReadUnaligned<ui64>(dataPtr + coreOffset);
+        coreOffset += sizeof(ui64);
+    }
+    CB_ENSURE(coreOffset + coreSize <= blob.Size(), "incorrect model core size");
+    const ui8* corePtr = dataPtr + coreOffset;
+    {
+        flatbuffers::Verifier verifier(corePtr, coreSize);
+        CB_ENSURE(VerifyTModelCoreBuffer(verifier), "Flatbuffers model verification failed");
+    }
+    auto fbModelCore = GetTModelCore(corePtr);
+    CB_ENSURE(
+        fbModelCore->FormatVersion() && fbModelCore->FormatVersion()->str() == CURRENT_CORE_FORMAT_STRING,
+        "Unsupported model format: " << fbModelCore->FormatVersion()->str()
+    );
+    TFullModel model;
+    model.ModelFileBlob = blob;
+    if (fbModelCore->ObliviousTrees()) {
+        model.ObliviousTrees.FBDeserialize(fbModelCore->ObliviousTrees(), /*leafValuesAsView*/ true);
+    }
+    size_t ctrPartOffset = coreOffset + coreSize;
+    if (streamedLeafData) {
+        ctrPartOffset = ReadStreamedLeafDataFromBlob(dataPtr, blob.Size(), ctrPartOffset, &model.ObliviousTrees);
+    }
+    model.StreamLeafDataOnSave = streamedLeafData;
+    if (fbModelCore->InfoMap()) {
+        for (auto keyVal : *fbModelCore->InfoMap()) {
+            const auto* value = keyVal->Value();
+            if (value->size() > LazyModelInfoValueSizeThreshold && !IsEagerlyLoadedInfoKey(keyVal->Key()->str())) {
+                // heavy blobs (training logs, feature stats) stay unread in the mapped file
+                model.LazyModelInfo[keyVal->Key()->str()] = TStringBuf(value->c_str(), value->size());
+            } else {
+                model.ModelInfo[keyVal->Key()->str()] = value->str();
+            }
+        }
+    }
+    TVector<TString> modelParts;
+    if (fbModelCore->ModelPartIds()) {
+        for (auto part : *fbModelCore->ModelPartIds()) {
+            modelParts.emplace_back(part->str());
+        }
+    }
+    if (!modelParts.empty()) {
+        CB_ENSURE(modelParts.size() == 1, "only single part model supported now");
+        model.CtrProvider = new TStaticCtrProvider;
+        CB_ENSURE(modelParts[0] == model.CtrProvider->ModelPartIdentifier(), "only static ctr models supported");
+        TMemoryInput ctrStream(dataPtr + ctrPartOffset, blob.Size() - ctrPartOffset);
+        model.CtrProvider->Load(&ctrStream);
+    }
+    model.UpdateDynamicData();
+    return model;
+}
+
 void OutputModelCoreML(const TFullModel& model, const TString& modelFile, const NJson::TJsonValue& userParameters) {
     CoreML::Specification::Model outModel;
     outModel.set_specificationversion(1);
@@ -94,7 +258,11 @@ void OutputModelCoreML(const TFullModel& model, const TString& modelFile, const
     auto description = outModel.mutable_description();
 
     NCatboost::NCoreML::ConfigureMetadata(model, userParameters, description);
-    NCatboost::NCoreML::ConfigureTrees(model, ensemble);
+    {
+        NPar::TLocalExecutor localExecutor;
+        localExecutor.RunAdditionalThreads(NSystemInfo::CachedNumberOfCpus() - 1);
+        NCatboost::NCoreML::ConfigureTrees(model, ensemble, &localExecutor);
+    }
     NCatboost::NCoreML::ConfigureIO(model, userParameters, regressor, description);
 
     TString data;
@@ -156,6 +324,7 @@ namespace {
 }
 
 void TObliviousTrees::Truncate(size_t begin, size_t end) {
+    CB_ENSURE(IsOblivious(), "Truncate is not supported for non-symmetric trees");
     auto originalTreeCount = TreeSizes.size();
     auto treeBinStart = TreeSplits.begin() + TreeStartOffsets[begin];
     TreeSplits.erase(TreeSplits.begin(), treeBinStart);
@@ -170,13 +339,44 @@ void TObliviousTrees::Truncate(size_t begin, size_t end) {
             TreeStartOffsets[i] = TreeStartOffsets[i - 1] + TreeSizes[i - 1];
         }
     }
-    size_t lastLeafIdx = (end == originalTreeCount) ? LeafValues.size() : MetaData->TreeFirstLeafOffsets[end];
-    TruncateVector(MetaData->TreeFirstLeafOffsets[begin], lastLeafIdx, &LeafValues);
+    if (HasFloat32Leaves()) {
+        size_t lastLeafIdx = (end == originalTreeCount) ? LeafValuesFloat.size() : MetaData->TreeFirstLeafOffsets[end];
+        TruncateVector(MetaData->TreeFirstLeafOffsets[begin], lastLeafIdx, &LeafValuesFloat);
+    } else {
+        size_t lastLeafIdx = (end == originalTreeCount) ? LeafValues.size() : MetaData->TreeFirstLeafOffsets[end];
+        TruncateVector(MetaData->TreeFirstLeafOffsets[begin], lastLeafIdx, &LeafValues);
+    }
     UpdateMetadata();
 }
 
+void TObliviousTrees::ConvertLeafValuesToFloat32() {
+    if (HasFloat32Leaves()) {
+        return;
+    }
+    const auto leafValues = GetLeafValuesRef();
+    LeafValuesFloat.yresize(leafValues.size());
+    Copy(leafValues.begin(), leafValues.end(), LeafValuesFloat.begin());
+    TVector<double>().swap(LeafValues);
+    LeafValuesView = TConstArrayRef<double>();
+    UpdateMetadata();
+}
+
+static void CalcLeafValuesInt16ScaleBias(const TVector<float>& leafValues, double* scale, double* bias) {
+    const float minLeaf = *MinElement(leafValues.begin(), leafValues.end());
+    const float maxLeaf = *MaxElement(leafValues.begin(), leafValues.end());
+    *bias = (static_cast<double>(minLeaf) + maxLeaf) / 2.0;
+    *scale = (static_cast<double>(maxLeaf) - minLeaf) / 65534.0;
+    if (*scale == 0.0) {
+        *scale = 1.0;
+    }
+}
+
+static i16 QuantizeLeafValueToInt16(float value, double scale, double bias) {
+    return static_cast<i16>(ClampVal<i64>(llround((value - bias) / scale), -32767, 32767));
+}
+
 flatbuffers::Offset<NCatBoostFbs::TObliviousTrees>
-TObliviousTrees::FBSerialize(TModelPartsCachingSerializer& serializer) const {
+TObliviousTrees::FBSerialize(TModelPartsCachingSerializer& serializer, bool skipLeafData) const {
     std::vector<flatbuffers::Offset<NCatBoostFbs::TCatFeature>> catFeaturesOffsets;
     for (const auto& catFeature : CatFeatures) {
         catFeaturesOffsets.push_back(catFeature.FBSerialize(serializer.FlatbufBuilder));
@@ -194,12 +394,36 @@ TObliviousTrees::FBSerialize(TModelPartsCachingSerializer& serializer) const {
         ctrFeaturesOffsets.push_back(ctrFeature.FBSerialize(serializer));
     }
     TVector<double> flatLeafWeights;
-    for (const auto& oneTreeLeafWeights: LeafWeights) {
-        flatLeafWeights.insert(
-                flatLeafWeights.end(),
-                oneTreeLeafWeights.begin(),
-                oneTreeLeafWeights.end()
-        );
+    if (!skipLeafData) {
+        for (const auto& oneTreeLeafWeights: LeafWeights) {
+            flatLeafWeights.insert(
+                    flatLeafWeights.end(),
+                    oneTreeLeafWeights.begin(),
+                    oneTreeLeafWeights.end()
+            );
+        }
+    }
+    const TVector<float>* leafValuesFloatPtr = nullptr;
+    TVector<i16> quantizedLeafValues;
+    const TVector<i16>* leafValuesInt16Ptr = nullptr;
+    double leafValueScale = 1.0;
+    double leafValueBias = 0.0;
+    if (!skipLeafData && HasFloat32Leaves()) {
+        if (QuantizeLeafValuesToInt16OnSave) {
+            CalcLeafValuesInt16ScaleBias(LeafValuesFloat, &leafValueScale, &leafValueBias);
+            quantizedLeafValues.yresize(LeafValuesFloat.size());
+            for (size_t i = 0; i < LeafValuesFloat.size(); ++i) {
+                quantizedLeafValues[i] = QuantizeLeafValueToInt16(LeafValuesFloat[i], leafValueScale, leafValueBias);
+            }
+            leafValuesInt16Ptr = &quantizedLeafValues;
+        } else {
+            leafValuesFloatPtr = &LeafValuesFloat;
+        }
+    }
+    std::vector<NCatBoostFbs::TNonSymmetricTreeStepNode> stepNodes;
+    stepNodes.reserve(NonSymmetricStepNodes.size());
+    for (const auto& stepNode : NonSymmetricStepNodes) {
+        stepNodes.emplace_back(stepNode.LeftSubtreeDiff, stepNode.RightSubtreeDiff);
     }
     return NCatBoostFbs::CreateTObliviousTreesDirect(
         serializer.FlatbufBuilder,
@@ -211,8 +435,14 @@ TObliviousTrees::FBSerialize(TModelPartsCachingSerializer& serializer) const {
         &floatFeaturesOffsets,
         &oneHotFeaturesOffsets,
         &ctrFeaturesOffsets,
-        &LeafValues,
-        &flatLeafWeights
+        skipLeafData ? nullptr : &LeafValues,
+        skipLeafData ? nullptr : &flatLeafWeights,
+        leafValuesFloatPtr,
+        leafValuesInt16Ptr,
+        leafValueScale,
+        leafValueBias,
+        NonSymmetricStepNodes.empty() ? nullptr : &stepNodes,
+        NonSymmetricNodeIdToLeafId.empty() ? nullptr : &NonSymmetricNodeIdToLeafId
     );
 }
 
@@ -226,10 +456,34 @@ void TObliviousTrees::UpdateMetadata() const {
     auto& ref = MetaData.GetRef();
 
     ref.TreeFirstLeafOffsets.resize(TreeSizes.size());
-    size_t currentOffset = 0;
-    for (size_t i = 0; i < TreeSizes.size(); ++i) {
-        ref.TreeFirstLeafOffsets[i] = currentOffset;
-        currentOffset += (1 << TreeSizes[i]) * ApproxDimension;
+    if (IsOblivious()) {
+        size_t currentOffset = 0;
+        for (size_t i = 0; i < TreeSizes.size(); ++i) {
+            ref.TreeFirstLeafOffsets[i] = currentOffset;
+            currentOffset += (1 << TreeSizes[i]) * ApproxDimension;
+        }
+    }
+
+    if (IsOblivious() && ApproxDimension == 1 && !TreeSizes.empty()) {
+        const auto leafValues = GetLeafValuesRef();
+        const auto getLeafValue = [&](size_t idx) -> double {
+            return LeafValuesFloat.empty() ? leafValues[idx] : LeafValuesFloat[idx];
+        };
+        ref.SuffixMinLeafValueSums.resize(TreeSizes.size() + 1, 0.0);
+        ref.SuffixMaxLeafValueSums.resize(TreeSizes.size() + 1, 0.0);
+        for (size_t i = TreeSizes.size(); i > 0; --i) {
+            const size_t treeId = i - 1;
+            const size_t leafCount = size_t(1) << TreeSizes[treeId];
+            double minLeaf = getLeafValue(ref.TreeFirstLeafOffsets[treeId]);
+            double maxLeaf = minLeaf;
+            for (size_t leafId = 1; leafId < leafCount; ++leafId) {
+                const double value = getLeafValue(ref.TreeFirstLeafOffsets[treeId] + leafId);
+                minLeaf = Min(minLeaf, value);
+                maxLeaf = Max(maxLeaf, value);
+            }
+            ref.SuffixMinLeafValueSums[treeId] = ref.SuffixMinLeafValueSums[treeId + 1] + minLeaf;
+            ref.SuffixMaxLeafValueSums[treeId] = ref.SuffixMaxLeafValueSums[treeId + 1] + maxLeaf;
+        }
     }
 
     for (const auto& ctrFeature : CtrFeatures) {
@@ -288,6 +542,150 @@ void TObliviousTrees::UpdateMetadata() const {
     }
 }
 
+void TFullModel::OptimizeForInference() {
+    ObliviousTrees.UpdateMetadata();
+    THashSet<int> usedSplits(ObliviousTrees.TreeSplits.begin(), ObliviousTrees.TreeSplits.end());
+    const auto& oldBinFeatures = ObliviousTrees.GetBinFeatures();
+
+    // kept splits keep their relative order, so new split ids are assigned by a running counter
+    TVector<int> oldToNewSplitId(oldBinFeatures.size(), -1);
+    int oldSplitId = 0;
+    int newSplitId = 0;
+    const auto filterSplits = [&](auto* values) {
+        auto keptValues = *values;
+        keptValues.clear();
+        for (const auto& value : *values) {
+            if (usedSplits.has(oldSplitId)) {
+                oldToNewSplitId[oldSplitId] = newSplitId++;
+                keptValues.push_back(value);
+            }
+            ++oldSplitId;
+        }
+        *values = std::move(keptValues);
+    };
+    for (auto& floatFeature : ObliviousTrees.FloatFeatures) {
+        filterSplits(&floatFeature.Borders);
+    }
+    for (auto& oneHotFeature : ObliviousTrees.OneHotFeatures) {
+        filterSplits(&oneHotFeature.Values);
+    }
+    for (auto& ctrFeature : ObliviousTrees.CtrFeatures) {
+        filterSplits(&ctrFeature.Borders);
+    }
+    for (auto& treeSplit : ObliviousTrees.TreeSplits) {
+        Y_ASSERT(oldToNewSplitId[treeSplit] != -1);
+        treeSplit = oldToNewSplitId[treeSplit];
+    }
+
+    // features without any remaining split cost a binarization bucket each, drop them entirely
+    const auto dropEmptyFeatures = [](auto* features, auto&& getSplits) {
+        auto keptFeatures = *features;
+        keptFeatures.clear();
+        for (auto& feature : *features) {
+            if (!getSplits(feature).empty()) {
+                keptFeatures.push_back(std::move(feature));
+            }
+        }
+        *features = std::move(keptFeatures);
+    };
+    dropEmptyFeatures(&ObliviousTrees.FloatFeatures, [](const TFloatFeature& f) -> const TVector<float>& { return f.Borders; });
+    dropEmptyFeatures(&ObliviousTrees.OneHotFeatures, [](const TOneHotFeature& f) -> const TVector<int>& { return f.Values; });
+    dropEmptyFeatures(&ObliviousTrees.CtrFeatures, [](const TCtrFeature& f) -> const TVector<float>& { return f.Borders; });
+
+    if (CtrProvider) {
+        THashSet<TModelCtrBase> usedCtrBases;
+        for (const auto& ctrFeature : ObliviousTrees.CtrFeatures) {
+            usedCtrBases.insert(ctrFeature.Ctr.Base);
+        }
+        TVector<TModelCtrBase> usedCtrBasesVec(usedCtrBases.begin(), usedCtrBases.end());
+        CtrProvider->DropUnusedTables(usedCtrBasesVec);
+    }
+    UpdateDynamicData();
+}
+
+TFullModel TFullModel::ProjectToFeatureSubset(const TVector<int>& flatFeatureIndexes) const {
+    CB_ENSURE(ObliviousTrees.IsOblivious(),
+              "feature subset projection is not supported for non-symmetric trees");
+    TFullModel result = *this;
+    TObliviousTrees& trees = result.ObliviousTrees;
+    trees.UpdateMetadata();
+
+    const THashSet<int> availableFeatures(flatFeatureIndexes.begin(), flatFeatureIndexes.end());
+    THashMap<int, int> floatFlatIndexes;
+    for (const auto& feature : trees.FloatFeatures) {
+        floatFlatIndexes[feature.FeatureIndex] = feature.FlatFeatureIndex;
+    }
+    THashMap<int, int> catFlatIndexes;
+    for (const auto& feature : trees.CatFeatures) {
+        catFlatIndexes[feature.FeatureIndex] = feature.FlatFeatureIndex;
+    }
+    const auto isAvailableSplit = [&](const TModelSplit& split) {
+        if (split.Type == ESplitType::FloatFeature) {
+            return availableFeatures.has(floatFlatIndexes.at(split.FloatFeature.FloatFeature));
+        }
+        if (split.Type == ESplitType::OneHotFeature) {
+            return availableFeatures.has(catFlatIndexes.at(split.OneHotFeature.CatFeatureIdx));
+        }
+        Y_ASSERT(split.Type == ESplitType::OnlineCtr);
+        const TFeatureCombination& proj = split.OnlineCtr.Ctr.Base.Projection;
+        return AllOf(proj.CatFeatures, [&](int catFeatureIdx) {
+                   return availableFeatures.has(catFlatIndexes.at(catFeatureIdx));
+               }) &&
+               AllOf(proj.BinFeatures, [&](const TFloatSplit& floatSplit) {
+                   return availableFeatures.has(floatFlatIndexes.at(floatSplit.FloatFeature));
+               }) &&
+               AllOf(proj.OneHotFeatures, [&](const TOneHotSplit& oneHotSplit) {
+                   return availableFeatures.has(catFlatIndexes.at(oneHotSplit.CatFeatureIdx));
+               });
+    };
+
+    const auto& binFeatures = trees.GetBinFeatures();
+    const auto& firstLeafOffsets = trees.GetFirstLeafOffsets();
+    const auto leafValues = trees.GetLeafValuesRef();
+    TVector<int> keptTreeSplits;
+    TVector<int> keptTreeSizes;
+    TVector<int> keptTreeStartOffsets;
+    TVector<double> keptLeafValues;
+    TVector<float> keptLeafValuesFloat;
+    TVector<TVector<double>> keptLeafWeights;
+    for (size_t treeIdx = 0; treeIdx < trees.TreeSizes.size(); ++treeIdx) {
+        const int* treeSplitsBegin = trees.TreeSplits.data() + trees.TreeStartOffsets[treeIdx];
+        const int* treeSplitsEnd = treeSplitsBegin + trees.TreeSizes[treeIdx];
+        const bool keepTree = std::all_of(treeSplitsBegin, treeSplitsEnd, [&](int binSplit) {
+            return isAvailableSplit(binFeatures[binSplit]);
+        });
+        if (!keepTree) {
+            continue;
+        }
+        keptTreeStartOffsets.push_back(keptTreeSplits.ysize());
+        keptTreeSplits.insert(keptTreeSplits.end(), treeSplitsBegin, treeSplitsEnd);
+        keptTreeSizes.push_back(trees.TreeSizes[treeIdx]);
+        const size_t leafCount = (size_t(1) << trees.TreeSizes[treeIdx]) * trees.ApproxDimension;
+        if (trees.HasFloat32Leaves()) {
+            keptLeafValuesFloat.insert(keptLeafValuesFloat.end(),
+                                       trees.LeafValuesFloat.begin() + firstLeafOffsets[treeIdx],
+                                       trees.LeafValuesFloat.begin() + firstLeafOffsets[treeIdx] + leafCount);
+        } else {
+            keptLeafValues.insert(keptLeafValues.end(),
+                                  leafValues.begin() + firstLeafOffsets[treeIdx],
+                                  leafValues.begin() + firstLeafOffsets[treeIdx] + leafCount);
+        }
+        if (treeIdx < trees.LeafWeights.size()) {
+            keptLeafWeights.push_back(trees.LeafWeights[treeIdx]);
+        }
+    }
+    trees.TreeSplits = std::move(keptTreeSplits);
+    trees.TreeSizes = std::move(keptTreeSizes);
+    trees.TreeStartOffsets = std::move(keptTreeStartOffsets);
+    trees.LeafValues = std::move(keptLeafValues);
+    trees.LeafValuesView = TConstArrayRef<double>();
+    trees.LeafValuesFloat = std::move(keptLeafValuesFloat);
+    trees.LeafWeights = std::move(keptLeafWeights);
+
+    result.OptimizeForInference();
+    return result;
+}
+
 void TFullModel::CalcFlat(const TVector<TConstArrayRef<float>>& features,
                                  size_t treeStart,
                                  size_t treeEnd,
@@ -313,6 +711,84 @@ void TFullModel::CalcFlat(const TVector<TConstArrayRef<float>>& features,
     );
 }
 
+void TFullModel::CalcFlat(const TVector<TConstArrayRef<float>>& features,
+                          size_t treeStart,
+                          size_t treeEnd,
+                          TArrayRef<double> results,
+                          TEvaluationContext& context) const {
+    const auto expectedFlatVecSize = ObliviousTrees.GetFlatFeatureVectorExpectedSize();
+    for (const auto& flatFeaturesVec : features) {
+        CB_ENSURE(flatFeaturesVec.size() >= expectedFlatVecSize,
+                  "insufficient flat features vector size: " << flatFeaturesVec.size()
+                                                             << " expected: " << expectedFlatVecSize);
+    }
+    CalcGeneric(
+        *this,
+        [&features](const TFloatFeature& floatFeature, size_t index) -> float {
+            return features[index][floatFeature.FlatFeatureIndex];
+        },
+        [&features](const TCatFeature& catFeature, size_t index) -> int {
+            return ConvertFloatCatFeatureToIntHash(features[index][catFeature.FlatFeatureIndex]);
+        },
+        features.size(),
+        treeStart,
+        treeEnd,
+        results,
+        context
+    );
+}
+
+void TFullModel::CalcQuantized(const TVector<TConstArrayRef<ui8>>& quantizedFeatures,
+                               size_t treeStart,
+                               size_t treeEnd,
+                               TArrayRef<double> results) const {
+    const size_t bucketCount = ObliviousTrees.GetEffectiveBinaryFeaturesBucketsCount();
+    CB_ENSURE(quantizedFeatures.size() == bucketCount,
+              "quantized feature columns count mismatch: " << quantizedFeatures.size()
+                                                           << " expected: " << bucketCount);
+    const size_t docCount = bucketCount > 0 ? quantizedFeatures.front().size() : 0;
+    for (const auto& column : quantizedFeatures) {
+        CB_ENSURE(column.size() == docCount, "quantized feature columns should have equal sizes");
+    }
+    {
+        size_t bucketId = 0;
+        for (const auto& floatFeature : ObliviousTrees.FloatFeatures) {
+            const ui8 maxBin = (ui8)floatFeature.Borders.size();
+            for (const ui8 bin : quantizedFeatures[bucketId]) {
+                CB_ENSURE(bin <= maxBin,
+                          "quantized bin " << (int)bin << " out of range for float feature "
+                                           << floatFeature.FeatureIndex << ", borders count: " << (int)maxBin);
+            }
+            ++bucketId;
+        }
+    }
+    CB_ENSURE(results.size() == docCount * ObliviousTrees.ApproxDimension);
+    std::fill(results.begin(), results.end(), 0.0);
+    const size_t blockSize = Min<size_t>(FORMULA_EVALUATION_BLOCK_SIZE, docCount);
+    auto calcTrees = GetCalcTreesFunction(*this, blockSize);
+    TVector<ui8> binFeatures(bucketCount * blockSize);
+    TVector<TCalcerIndexType> indexesVec(blockSize);
+    for (size_t blockStart = 0; blockStart < docCount; blockStart += blockSize) {
+        const auto docCountInBlock = Min(blockSize, docCount - blockStart);
+        for (size_t bucketId = 0; bucketId < bucketCount; ++bucketId) {
+            memcpy(
+                binFeatures.data() + bucketId * docCountInBlock,
+                quantizedFeatures[bucketId].data() + blockStart,
+                docCountInBlock
+            );
+        }
+        calcTrees(
+            *this,
+            binFeatures.data(),
+            docCountInBlock,
+            indexesVec.data(),
+            treeStart,
+            treeEnd,
+            results.data() + blockStart * ObliviousTrees.ApproxDimension
+        );
+    }
+}
+
 void TFullModel::CalcFlatSingle(const TConstArrayRef<float>& features, size_t treeStart, size_t treeEnd, TArrayRef<double> results) const {
     CalcGeneric(
         *this,
@@ -382,6 +858,41 @@ void TFullModel::Calc(const TVector<TConstArrayRef<float>>& floatFeatures,
     );
 }
 
+void TFullModel::Calc(const TVector<TConstArrayRef<float>>& floatFeatures,
+                      const TVector<TConstArrayRef<int>>& catFeatures,
+                      size_t treeStart,
+                      size_t treeEnd,
+                      TArrayRef<double> results,
+                      TEvaluationContext& context) const {
+    if (!floatFeatures.empty() && !catFeatures.empty()) {
+        CB_ENSURE(catFeatures.size() == floatFeatures.size());
+    }
+    for (const auto& floatFeaturesVec : floatFeatures) {
+        CB_ENSURE(floatFeaturesVec.size() >= ObliviousTrees.GetNumFloatFeatures(),
+                  "insufficient float features vector size: " << floatFeaturesVec.size()
+                                                              << " expected: " << ObliviousTrees.GetNumFloatFeatures());
+    }
+    for (const auto& catFeaturesVec : catFeatures) {
+        CB_ENSURE(catFeaturesVec.size() >= ObliviousTrees.GetNumCatFeatures(),
+                  "insufficient cat features vector size: " << catFeaturesVec.size()
+                                                            << " expected: " << ObliviousTrees.GetNumCatFeatures());
+    }
+    CalcGeneric(
+        *this,
+        [&floatFeatures](const TFloatFeature& floatFeature, size_t index) -> float {
+            return floatFeatures[index][floatFeature.FeatureIndex];
+        },
+        [&catFeatures](const TCatFeature& catFeature, size_t index) -> int {
+            return catFeatures[index][catFeature.FeatureIndex];
+        },
+        floatFeatures.size(),
+        treeStart,
+        treeEnd,
+        results,
+        context
+    );
+}
+
 void TFullModel::Calc(const TVector<TConstArrayRef<float>>& floatFeatures,
                              const TVector<TVector<TStringBuf>>& catFeatures, size_t treeStart, size_t treeEnd,
                              TArrayRef<double> results) const {
@@ -413,6 +924,21 @@ void TFullModel::Calc(const TVector<TConstArrayRef<float>>& floatFeatures,
     );
 }
 
+void TFullModel::CalcWithHashedCat(const TVector<TConstArrayRef<float>>& floatFeatures,
+                                   const TVector<TVector<TStringBuf>>& catFeatures,
+                                   size_t treeStart,
+                                   size_t treeEnd,
+                                   TArrayRef<double> results) const {
+    TVector<TVector<int>> hashedCatFeatures(catFeatures.size());
+    TVector<TConstArrayRef<int>> hashedCatFeatureRefs(catFeatures.size());
+    for (size_t objectIdx = 0; objectIdx < catFeatures.size(); ++objectIdx) {
+        hashedCatFeatures[objectIdx].yresize(catFeatures[objectIdx].size());
+        CalcCatFeatureHashes(catFeatures[objectIdx], hashedCatFeatures[objectIdx]);
+        hashedCatFeatureRefs[objectIdx] = hashedCatFeatures[objectIdx];
+    }
+    Calc(floatFeatures, hashedCatFeatureRefs, treeStart, treeEnd, results);
+}
+
 TVector<TVector<double>> TFullModel::CalcTreeIntervals(
     const TVector<TConstArrayRef<float>>& floatFeatures,
     const TVector<TConstArrayRef<int>>& catFeatures,
@@ -464,12 +990,127 @@ TVector<TVector<double>> TFullModel::CalcTreeIntervalsFlat(
     );
 }
 
+static void SaveStreamedLeafData(const TObliviousTrees& trees, ui64 blockFileOffset, IOutputStream* s) {
+    const ui8 padLen = (8 - (blockFileOffset + StreamedLeafDataHeaderSize) % 8) % 8;
+    EStreamedLeafValuesType valueType = EStreamedLeafValuesType::Double;
+    ui64 valueCount = 0;
+    double scale = 1.0;
+    double bias = 0.0;
+    if (trees.HasFloat32Leaves()) {
+        valueType = trees.QuantizeLeafValuesToInt16OnSave
+            ? EStreamedLeafValuesType::Int16
+            : EStreamedLeafValuesType::Float;
+        valueCount = trees.LeafValuesFloat.size();
+        if (valueType == EStreamedLeafValuesType::Int16) {
+            CalcLeafValuesInt16ScaleBias(trees.LeafValuesFloat, &scale, &bias);
+        }
+    } else {
+        valueCount = trees.GetLeafValuesRef().size();
+    }
+    ::Save(s, static_cast<ui8>(valueType));
+    ::Save(s, padLen);
+    ::Save(s, valueCount);
+    ::Save(s, scale);
+    ::Save(s, bias);
+    if (padLen) {
+        const char zeros[8] = {};
+        s->Write(zeros, padLen);
+    }
+    switch (valueType) {
+        case EStreamedLeafValuesType::Double: {
+            const auto leafValues = trees.GetLeafValuesRef();
+            s->Write(leafValues.data(), leafValues.size() * sizeof(double));
+            break;
+        }
+        case EStreamedLeafValuesType::Float:
+            s->Write(trees.LeafValuesFloat.data(), trees.LeafValuesFloat.size() * sizeof(float));
+            break;
+        case EStreamedLeafValuesType::Int16: {
+            // quantize chunk by chunk so the temporary never holds more than a chunk
+            TVector<i16> quantized;
+            quantized.yresize(Min<size_t>(valueCount, StreamedLeafValuesPerChunk));
+            for (size_t offset = 0; offset < valueCount; offset += StreamedLeafValuesPerChunk) {
+                const size_t chunkSize = Min<size_t>(valueCount - offset, StreamedLeafValuesPerChunk);
+                for (size_t i = 0; i < chunkSize; ++i) {
+                    quantized[i] = QuantizeLeafValueToInt16(trees.LeafValuesFloat[offset + i], scale, bias);
+                }
+                s->Write(quantized.data(), chunkSize * sizeof(i16));
+            }
+            break;
+        }
+    }
+    ui64 flatWeightCount = 0;
+    for (const auto& oneTreeLeafWeights : trees.LeafWeights) {
+        flatWeightCount += oneTreeLeafWeights.size();
+    }
+    ::Save(s, flatWeightCount);
+    for (const auto& oneTreeLeafWeights : trees.LeafWeights) {
+        s->Write(oneTreeLeafWeights.data(), oneTreeLeafWeights.size() * sizeof(double));
+    }
+}
+
+static void LoadStreamedLeafData(IInputStream* s, TObliviousTrees* trees) {
+    ui8 valueType = 0;
+    ui8 padLen = 0;
+    ui64 valueCount = 0;
+    double scale = 1.0;
+    double bias = 0.0;
+    ::Load(s, valueType);
+    ::Load(s, padLen);
+    ::Load(s, valueCount);
+    ::Load(s, scale);
+    ::Load(s, bias);
+    if (padLen) {
+        char zeros[8];
+        CB_ENSURE(padLen <= sizeof(zeros), "corrupted streamed model leaf data header");
+        s->LoadOrFail(zeros, padLen);
+    }
+    switch (static_cast<EStreamedLeafValuesType>(valueType)) {
+        case EStreamedLeafValuesType::Double:
+            trees->LeafValues.yresize(valueCount);
+            s->LoadOrFail(trees->LeafValues.data(), valueCount * sizeof(double));
+            break;
+        case EStreamedLeafValuesType::Float:
+            trees->LeafValuesFloat.yresize(valueCount);
+            s->LoadOrFail(trees->LeafValuesFloat.data(), valueCount * sizeof(float));
+            break;
+        case EStreamedLeafValuesType::Int16: {
+            trees->LeafValuesFloat.yresize(valueCount);
+            TVector<i16> quantized;
+            quantized.yresize(Min<size_t>(valueCount, StreamedLeafValuesPerChunk));
+            for (size_t offset = 0; offset < valueCount; offset += StreamedLeafValuesPerChunk) {
+                const size_t chunkSize = Min<size_t>(valueCount - offset, StreamedLeafValuesPerChunk);
+                s->LoadOrFail(quantized.data(), chunkSize * sizeof(i16));
+                for (size_t i = 0; i < chunkSize; ++i) {
+                    trees->LeafValuesFloat[offset + i] = static_cast<float>(bias + scale * quantized[i]);
+                }
+            }
+            break;
+        }
+        default:
+            CB_ENSURE(false, "unknown leaf values type in streamed model: " << static_cast<int>(valueType));
+    }
+    ui64 flatWeightCount = 0;
+    ::Load(s, flatWeightCount);
+    if (flatWeightCount) {
+        trees->LeafWeights.resize(trees->TreeSizes.size());
+        ui64 loadedWeights = 0;
+        for (size_t treeId = 0; treeId < trees->TreeSizes.size(); ++treeId) {
+            const size_t treeLeafCount = size_t(1) << trees->TreeSizes[treeId];
+            trees->LeafWeights[treeId].yresize(treeLeafCount);
+            s->LoadOrFail(trees->LeafWeights[treeId].data(), treeLeafCount * sizeof(double));
+            loadedWeights += treeLeafCount;
+        }
+        CB_ENSURE(loadedWeights == flatWeightCount, "corrupted streamed model leaf weights");
+    }
+}
+
 void TFullModel::Save(IOutputStream* s) const {
     using namespace flatbuffers;
     using namespace NCatBoostFbs;
-    ::Save(s, GetModelFormatDescriptor());
+    ::Save(s, StreamLeafDataOnSave ? GetStreamedModelFormatDescriptor() : GetModelFormatDescriptor());
     TModelPartsCachingSerializer serializer;
-    auto obliviousTreesOffset = ObliviousTrees.FBSerialize(serializer);
+    auto obliviousTreesOffset = ObliviousTrees.FBSerialize(serializer, StreamLeafDataOnSave);
     std::vector<flatbuffers::Offset<TKeyValue>> infoMap;
     for (const auto& key_value : ModelInfo) {
         auto keyValueOffset = CreateTKeyValue(
@@ -483,6 +1124,21 @@ void TFullModel::Save(IOutputStream* s) const {
         );
         infoMap.push_back(keyValueOffset);
     }
+    for (const auto& key_value : LazyModelInfo) {
+        if (ModelInfo.has(key_value.first)) {
+            continue; // an eagerly stored value overrides the mapped-file view
+        }
+        auto keyValueOffset = CreateTKeyValue(
+            serializer.FlatbufBuilder,
+            serializer.FlatbufBuilder.CreateString(
+                key_value.first.c_str(),
+                key_value.first.size()),
+            serializer.FlatbufBuilder.CreateString(
+                key_value.second.data(),
+                key_value.second.size())
+        );
+        infoMap.push_back(keyValueOffset);
+    }
     std::vector<flatbuffers::Offset<flatbuffers::String>> modelPartIds;
     if (!!CtrProvider && CtrProvider->IsSerializable()) {
         modelPartIds.push_back(serializer.FlatbufBuilder.CreateString(CtrProvider->ModelPartIdentifier()));
@@ -497,6 +1153,11 @@ void TFullModel::Save(IOutputStream* s) const {
     serializer.FlatbufBuilder.Finish(coreOffset);
     SaveSize(s, serializer.FlatbufBuilder.GetSize());
     s->Write(serializer.FlatbufBuilder.GetBufferPointer(), serializer.FlatbufBuilder.GetSize());
+    if (StreamLeafDataOnSave) {
+        const ui64 coreSize = serializer.FlatbufBuilder.GetSize();
+        const ui64 sizePrefixBytes = coreSize < Max<ui32>() ? sizeof(ui32) : sizeof(ui32) + sizeof(ui64);
+        SaveStreamedLeafData(ObliviousTrees, sizeof(ui32) + sizePrefixBytes + coreSize, s);
+    }
     if (!!CtrProvider && CtrProvider->IsSerializable()) {
         CtrProvider->Save(s);
     }
@@ -507,7 +1168,11 @@ void TFullModel::Load(IInputStream* s) {
     using namespace NCatBoostFbs;
     ui32 fileDescriptor;
     ::Load(s, fileDescriptor);
-    CB_ENSURE(fileDescriptor == GetModelFormatDescriptor(), "Incorrect model file descriptor");
+    const bool streamedLeafData = fileDescriptor == GetStreamedModelFormatDescriptor();
+    CB_ENSURE(
+        streamedLeafData || fileDescriptor == GetModelFormatDescriptor(),
+        "Incorrect model file descriptor"
+    );
     auto coreSize = ::LoadSize(s);
     TArrayHolder<ui8> arrayHolder = new ui8[coreSize];
     s->LoadOrFail(arrayHolder.Get(), coreSize);
@@ -524,7 +1189,12 @@ void TFullModel::Load(IInputStream* s) {
     if (fbModelCore->ObliviousTrees()) {
         ObliviousTrees.FBDeserialize(fbModelCore->ObliviousTrees());
     }
+    if (streamedLeafData) {
+        LoadStreamedLeafData(s, &ObliviousTrees);
+    }
+    StreamLeafDataOnSave = streamedLeafData;
     ModelInfo.clear();
+    LazyModelInfo.clear();
     if (fbModelCore->InfoMap()) {
         for (auto keyVal : *fbModelCore->InfoMap()) {
             ModelInfo[keyVal->Key()->str()] = keyVal->Value()->str();
@@ -13,10 +13,12 @@
 
 #include <library/json/json_reader.h>
 
+#include <util/memory/blob.h>
 #include <util/system/mutex.h>
 #include <util/stream/file.h>
 
 class TModelPartsCachingSerializer;
+struct TEvaluationContext;
 
 /*!
     \brief Oblivious tree model structure
@@ -45,6 +47,21 @@ struct TRepackedBin {
     ui8 XorMask = 0;
     ui8 SplitIdx = 0;
 };
+
+/*
+    Step node of a non-symmetric tree. Subtree diffs are relative offsets to the left/right
+    child inside the per-tree node array; leaves are represented as nodes with both diffs
+    equal to 0 (their split condition is a dummy and is never used for descent).
+*/
+struct TNonSymmetricTreeStepNode {
+    ui16 LeftSubtreeDiff = 0;
+    ui16 RightSubtreeDiff = 0;
+
+    bool operator==(const TNonSymmetricTreeStepNode& other) const {
+        return LeftSubtreeDiff == other.LeftSubtreeDiff && RightSubtreeDiff == other.RightSubtreeDiff;
+    }
+};
+
 struct TObliviousTrees {
 
     /**
@@ -78,6 +95,12 @@ struct TObliviousTrees {
 
         //! Offset of first tree leaf in flat tree leafs array
         TVector<size_t> TreeFirstLeafOffsets;
+
+        //! Suffix sums of per-tree minimal/maximal leaf values (single dimension models only):
+        //! element i bounds the total contribution of trees [i; treeCount). Size treeCount + 1,
+        //! last element is 0. Used for margin-based early exit in staged scoring.
+        TVector<double> SuffixMinLeafValueSums;
+        TVector<double> SuffixMaxLeafValueSums;
     };
 
     //! Number of classes in model, in most cases equals to 1.
@@ -92,9 +115,28 @@ struct TObliviousTrees {
     //! Offset of first split in TreeSplits array
     TVector<int> TreeStartOffsets;
 
+    //! Non-symmetric trees only: one step node per TreeSplits entry. For such models
+    //! TreeSizes holds per-tree node counts instead of depths. Empty for oblivious models.
+    TVector<TNonSymmetricTreeStepNode> NonSymmetricStepNodes;
+
+    //! Non-symmetric trees only: maps node index to index of its leaf in the leaf values array
+    TVector<ui32> NonSymmetricNodeIdToLeafId;
+
     //! Leaf values layout: [treeIndex][leafId * ApproxDimension + dimension]
     TVector<double> LeafValues;
 
+    //! For mmap-backed models: view of leaf values directly inside the mapped model core.
+    //! Empty for regular models, see GetLeafValuesRef()
+    TConstArrayRef<double> LeafValuesView;
+
+    //! Optional float32 leaf storage with the same layout as LeafValues, filled instead of it.
+    //! Halves leaf memory traffic on evaluation; leaf values are still accumulated in double.
+    TVector<float> LeafValuesFloat;
+
+    //! If set, Save() stores float32 leaves quantized to int16 with a scale and bias,
+    //! halving the leaf part of the model file once more. Only affects serialization.
+    bool QuantizeLeafValuesToInt16OnSave = false;
+
     //! Leaf weights layout: [treeIndex][leafId]
     TVector<TVector<double>> LeafWeights;
 
@@ -115,15 +157,44 @@ struct TObliviousTrees {
     /**
      * Method for oblivious trees serialization with repeated parts caching
      * @param serializer our caching flatbuffers serializator
+     * @param skipLeafData do not copy leaf values and leaf weights into the flatbuffer;
+     *        the streamed model format writes them after the core blob instead
      * @return offset in flatbuffer
      */
-    flatbuffers::Offset<NCatBoostFbs::TObliviousTrees> FBSerialize(TModelPartsCachingSerializer& serializer) const;
+    flatbuffers::Offset<NCatBoostFbs::TObliviousTrees> FBSerialize(
+        TModelPartsCachingSerializer& serializer,
+        bool skipLeafData = false) const;
 
     /**
      * Deserialize from flatbuffers object
      * @param fbObj
      */
-    void FBDeserialize(const NCatBoostFbs::TObliviousTrees* fbObj) {
+    //! Leaf values of the model: the owning LeafValues vector for regular models,
+    //! a view into the mapped model core for mmap-backed ones
+    TConstArrayRef<double> GetLeafValuesRef() const {
+        if (LeafValuesView.data() != nullptr) {
+            return LeafValuesView;
+        }
+        return MakeArrayRef(LeafValues);
+    }
+
+    bool HasFloat32Leaves() const {
+        return !LeafValuesFloat.empty();
+    }
+
+    /**
+     * Switch to float32 leaf storage to halve the leaf memory footprint.
+     * Evaluation accumulates float leaves into double sums, so predictions may differ
+     * from the double-leaf model in the low-order bits.
+     */
+    void ConvertLeafValuesToFloat32();
+
+    /**
+     * Deserialize from flatbuffers object.
+     * With leafValuesAsView = true leaf values are not copied, LeafValuesView points into fbObj
+     * and the caller is responsible for keeping the underlying buffer alive.
+     */
+    void FBDeserialize(const NCatBoostFbs::TObliviousTrees* fbObj, bool leafValuesAsView = false) {
         ApproxDimension = fbObj->ApproxDimension();
         if (fbObj->TreeSplits()) {
             TreeSplits.assign(fbObj->TreeSplits()->begin(), fbObj->TreeSplits()->end());
@@ -136,7 +207,32 @@ struct TObliviousTrees {
         }
 
         if (fbObj->LeafValues()) {
-            LeafValues.assign(fbObj->LeafValues()->begin(), fbObj->LeafValues()->end());
+            if (leafValuesAsView) {
+                LeafValuesView = MakeArrayRef(fbObj->LeafValues()->data(), fbObj->LeafValues()->size());
+            } else {
+                LeafValues.assign(fbObj->LeafValues()->begin(), fbObj->LeafValues()->end());
+            }
+        }
+        if (fbObj->LeafValuesInt16()) {
+            const double scale = fbObj->LeafValueScale();
+            const double bias = fbObj->LeafValueBias();
+            LeafValuesFloat.yresize(fbObj->LeafValuesInt16()->size());
+            for (size_t i = 0; i < LeafValuesFloat.size(); ++i) {
+                LeafValuesFloat[i] = static_cast<float>(bias + scale * fbObj->LeafValuesInt16()->Get(i));
+            }
+        } else if (fbObj->LeafValuesFloat()) {
+            LeafValuesFloat.assign(fbObj->LeafValuesFloat()->begin(), fbObj->LeafValuesFloat()->end());
+        }
+        if (fbObj->NonSymmetricStepNodes()) {
+            NonSymmetricStepNodes.yresize(fbObj->NonSymmetricStepNodes()->size());
+            for (size_t i = 0; i < NonSymmetricStepNodes.size(); ++i) {
+                const auto* stepNode = fbObj->NonSymmetricStepNodes()->Get(i);
+                NonSymmetricStepNodes[i].LeftSubtreeDiff = stepNode->LeftSubtreeDiff();
+                NonSymmetricStepNodes[i].RightSubtreeDiff = stepNode->RightSubtreeDiff();
+            }
+        }
+        if (fbObj->NonSymmetricNodeIdToLeafId()) {
+            NonSymmetricNodeIdToLeafId.assign(fbObj->NonSymmetricNodeIdToLeafId()->begin(), fbObj->NonSymmetricNodeIdToLeafId()->end());
         }
         if (fbObj->LeafWeights()) {
             LeafWeights.resize(TreeSizes.size());
@@ -182,6 +278,9 @@ struct TObliviousTrees {
                         TreeSizes,
                         TreeStartOffsets,
                         LeafValues,
+                        LeafValuesFloat,
+                        NonSymmetricStepNodes,
+                        NonSymmetricNodeIdToLeafId,
                         CatFeatures,
                         FloatFeatures,
                         OneHotFeatures,
@@ -191,6 +290,9 @@ struct TObliviousTrees {
                        other.TreeSizes,
                        other.TreeStartOffsets,
                        other.LeafValues,
+                       other.LeafValuesFloat,
+                       other.NonSymmetricStepNodes,
+                       other.NonSymmetricNodeIdToLeafId,
                        other.CatFeatures,
                        other.FloatFeatures,
                        other.OneHotFeatures,
@@ -202,6 +304,9 @@ struct TObliviousTrees {
     size_t GetTreeCount() const {
         return TreeSizes.size();
     }
+    bool IsOblivious() const {
+        return NonSymmetricStepNodes.empty();
+    }
     /**
      * Truncate oblivous trees to contain only trees from [begin; end) interval.
      * @param begin
@@ -240,9 +345,19 @@ struct TObliviousTrees {
         return MetaData->TreeFirstLeafOffsets;
     }
 
+    const TVector<double>& GetSuffixMinLeafValueSums() const {
+        Y_ENSURE(MetaData.Defined(), "metadata should be initialized");
+        return MetaData->SuffixMinLeafValueSums;
+    }
+
+    const TVector<double>& GetSuffixMaxLeafValueSums() const {
+        Y_ENSURE(MetaData.Defined(), "metadata should be initialized");
+        return MetaData->SuffixMaxLeafValueSums;
+    }
+
     const double* GetFirstLeafPtrForTree(size_t treeIdx) const {
         Y_ENSURE(MetaData.Defined(), "metadata should be initialized");
-        return &LeafValues[MetaData->TreeFirstLeafOffsets[treeIdx]];
+        return &GetLeafValuesRef()[MetaData->TreeFirstLeafOffsets[treeIdx]];
     }
 
     /**
@@ -300,12 +415,53 @@ struct TFullModel {
      * Model information key-value storage.
      */
     THashMap<TString, TString> ModelInfo;
+    /**
+     * Views into ModelFileBlob for heavy metadata values left unread in the mapped
+     * model file, see ReadModelFromMappedFile. Keyed like ModelInfo; a key is present
+     * in at most one of the two maps. Empty for regular models.
+     */
+    THashMap<TString, TStringBuf> LazyModelInfo;
     TIntrusivePtr<ICtrProvider> CtrProvider;
+    /**
+     * Keeps the mapped model file alive for mmap-backed models, see ReadModelFromMappedFile.
+     * Empty for regular models.
+     */
+    TBlob ModelFileBlob;
+    /**
+     * If set, Save() uses the streamed model format: leaf values and weights are left
+     * out of the core flatbuffer and written after it straight from the model arrays,
+     * so save needs O(chunk) extra memory instead of a second copy of the leaf data.
+     * Streamed files start with their own descriptor and are rejected by older readers.
+     * Set automatically when loading a streamed file so re-saving keeps the format.
+     */
+    bool StreamLeafDataOnSave = false;
 
     void Swap(TFullModel& other) {
         DoSwap(ObliviousTrees, other.ObliviousTrees);
         DoSwap(ModelInfo, other.ModelInfo);
+        DoSwap(LazyModelInfo, other.LazyModelInfo);
         DoSwap(CtrProvider, other.CtrProvider);
+        DoSwap(ModelFileBlob, other.ModelFileBlob);
+        DoSwap(StreamLeafDataOnSave, other.StreamLeafDataOnSave);
+    }
+
+    //! Check metadata key presence in both the eager and the lazy storage.
+    bool HasModelInfoKey(const TString& key) const {
+        return ModelInfo.has(key) || LazyModelInfo.has(key);
+    }
+
+    /**
+     * Metadata value lookup covering both eager and lazy storage. Lazy values are
+     * read from the mapped model file only on access; the returned view stays valid
+     * while this model (and so ModelFileBlob) is alive.
+     */
+    TStringBuf GetModelInfoValue(const TString& key) const {
+        if (const TString* value = ModelInfo.FindPtr(key)) {
+            return *value;
+        }
+        const TStringBuf* lazyValue = LazyModelInfo.FindPtr(key);
+        CB_ENSURE(lazyValue, "There is no key \"" << key << "\" in model info");
+        return *lazyValue;
     }
 
     /**
@@ -371,6 +527,22 @@ struct TFullModel {
      * For single class models it is just [objectIndex]
      */
     void CalcFlatTransposed(const TVector<TConstArrayRef<float>>& transposedFeatures, size_t treeStart, size_t treeEnd, TArrayRef<double> results) const;
+    /**
+     * Special interface for model evaluation on pre-binarized features, skipping the binarization pass.
+     * @param[in] quantizedFeatures column-major ui8 bins, one column per effective binary feature bucket
+     * in model order (float features, then one-hot features, then ctr features). Bin values for float
+     * features are the count of passed borders, validated against ObliviousTrees borders.
+     * @param[in] treeStart Index of first tree in model to start evaluation
+     * @param[in] treeEnd Index of tree after the last tree in model to evaluate
+     * @param[out] results Flat double vector with indexation [objectIndex * ApproxDimension + classId].
+     */
+    void CalcQuantized(const TVector<TConstArrayRef<ui8>>& quantizedFeatures, size_t treeStart, size_t treeEnd, TArrayRef<double> results) const;
+    /**
+     * Call CalcQuantized on all model trees
+     */
+    void CalcQuantized(const TVector<TConstArrayRef<ui8>>& quantizedFeatures, TArrayRef<double> results) const {
+        CalcQuantized(quantizedFeatures, 0, ObliviousTrees.TreeSizes.size(), results);
+    }
     /**
      * Special interface for model evaluation on flat feature vectors. Flat here means that float features and categorical feature are in the same float array.
      * @param[in] features vector of flat features array reference. First dimension is object index, second dimension is feature index.
@@ -390,6 +562,12 @@ struct TFullModel {
     void CalcFlat(const TVector<TConstArrayRef<float>>& features, TArrayRef<double> results) const {
         CalcFlat(features, 0, ObliviousTrees.TreeSizes.size(), results);
     }
+    /**
+     * Same as CalcFlat but reuses caller-owned scratch buffers from context, so repeated calls
+     * perform no heap allocations once the buffers have grown to fit.
+     * @param[in,out] context evaluation scratch buffers, one per scoring thread
+     */
+    void CalcFlat(const TVector<TConstArrayRef<float>>& features, size_t treeStart, size_t treeEnd, TArrayRef<double> results, TEvaluationContext& context) const;
     /**
      * Same as CalcFlat method but for one object
      * @param[in] features flat features array reference. First dimension is object index, second dimension is feature index.
@@ -459,6 +637,17 @@ struct TFullModel {
               TArrayRef<double> results) const {
         Calc(floatFeatures, catFeatures, 0, ObliviousTrees.TreeSizes.size(), results);
     }
+    /**
+     * Same as Calc but reuses caller-owned scratch buffers from context, so repeated calls
+     * perform no heap allocations once the buffers have grown to fit.
+     * @param[in,out] context evaluation scratch buffers, one per scoring thread
+     */
+    void Calc(const TVector<TConstArrayRef<float>>& floatFeatures,
+              const TVector<TConstArrayRef<int>>& catFeatures,
+              size_t treeStart,
+              size_t treeEnd,
+              TArrayRef<double> results,
+              TEvaluationContext& context) const;
     /**
      * Evaluate raw formula prediction for one object. Uses all model trees
      * @param floatFeatures
@@ -496,6 +685,29 @@ struct TFullModel {
               TArrayRef<double> results) const {
         Calc(floatFeatures, catFeatures, 0, ObliviousTrees.TreeSizes.size(), results);
     }
+    /**
+     * Same as the TStringBuf Calc overload, but hashes categorical strings in one
+     * batched pass per object up front instead of per model split lookup. Prefer it
+     * for categorical-heavy models.
+     * @param floatFeatures
+     * @param catFeatures vector of vector of TStringBuf with categorical features strings
+     * @param treeStart
+     * @param treeEnd
+     * @param results indexation is [objectIndex * ApproxDimension + classId]
+     */
+    void CalcWithHashedCat(const TVector<TConstArrayRef<float>>& floatFeatures,
+                           const TVector<TVector<TStringBuf>>& catFeatures,
+                           size_t treeStart,
+                           size_t treeEnd,
+                           TArrayRef<double> results) const;
+    /**
+     * Call CalcWithHashedCat on all model trees
+     */
+    void CalcWithHashedCat(const TVector<TConstArrayRef<float>>& floatFeatures,
+                           const TVector<TVector<TStringBuf>>& catFeatures,
+                           TArrayRef<double> results) const {
+        CalcWithHashedCat(floatFeatures, catFeatures, 0, ObliviousTrees.TreeSizes.size(), results);
+    }
     /**
      * Truncate model to contain only trees from [begin; end) interval.
      * @param begin
@@ -508,6 +720,23 @@ struct TFullModel {
         return result;
     }
 
+    /**
+     * Shrink model structures after modifications like tree truncation: drops borders and
+     * one hot values no remaining split references, removes features and ctr tables that
+     * became completely unused and remaps tree splits accordingly. Narrows the per-block
+     * binarization buffer and cuts binarization work proportionally.
+     */
+    void OptimizeForInference();
+
+    /**
+     * Project the model onto a subset of its input features (flat pool indexes): every
+     * tree with at least one split on a feature outside the subset is dropped, the
+     * remaining trees keep their leaf values, and the unused features, splits and ctr
+     * tables are shrunk away. No retraining happens, so the result only approximates the
+     * full model and degrades with the share of dropped trees.
+     */
+    TFullModel ProjectToFeatureSubset(const TVector<int>& flatFeatureIndexes) const;
+
     /**
      * Internal usage only.
      * Updates indexes in CTR provider and recalculates metadata in Oblivious trees after model modifications.
@@ -527,6 +756,14 @@ void OutputModel(const TFullModel& model, const TString& modelFile);
 TFullModel ReadModel(const TString& modelFile, EModelType format = EModelType::CatboostBinary);
 TFullModel ReadModel(const void* binaryBuffer, size_t binaryBufferSize, EModelType format = EModelType::CatboostBinary);
 
+/**
+ * Zero-copy model loading: the file is mmap-ed and leaf values are exposed as views into the
+ * mapped flatbuffers core, so several serving processes on one host share a single page-cache
+ * copy and loading large models avoids doubling RSS. The mapping is kept alive by the returned
+ * model (TFullModel::ModelFileBlob). Only the CatboostBinary format is supported.
+ */
+TFullModel ReadModelFromMappedFile(const TString& modelFile);
+
 /**
  * Export model in our binary or protobuf CoreML format
  * @param model
@@ -0,0 +1,104 @@
+#include "model_ensemble_evaluator.h"
+
+#include <catboost/libs/cat_feature/cat_feature.h>
+
+TModelEnsembleEvaluator::TModelEnsembleEvaluator(TVector<const TFullModel*> models)
+    : Models(std::move(models))
+{
+    CB_ENSURE(!Models.empty(), "model ensemble should contain at least one model");
+    const auto& leadTrees = Models.front()->ObliviousTrees;
+    for (const auto* model : Models) {
+        CB_ENSURE(model != nullptr, "model ensemble got nullptr model");
+        const auto& trees = model->ObliviousTrees;
+        CB_ENSURE(
+            trees.FloatFeatures == leadTrees.FloatFeatures,
+            "ensemble models should have identical float feature borders"
+        );
+        CB_ENSURE(
+            trees.CatFeatures == leadTrees.CatFeatures,
+            "ensemble models should have identical categorical features"
+        );
+        CB_ENSURE(
+            trees.OneHotFeatures == leadTrees.OneHotFeatures,
+            "ensemble models should have identical one hot features"
+        );
+        CB_ENSURE(
+            trees.CtrFeatures == leadTrees.CtrFeatures,
+            "ensemble models should have identical ctr features"
+        );
+    }
+    CalcFunctions.reserve(Models.size());
+    for (const auto* model : Models) {
+        CalcFunctions.push_back(GetCalcTreesFunction(*model, FORMULA_EVALUATION_BLOCK_SIZE));
+    }
+}
+
+template<typename TFloatFeatureAccessor, typename TCatFeatureAccessor>
+void TModelEnsembleEvaluator::CalcGenericEnsemble(
+    TFloatFeatureAccessor floatFeatureAccessor,
+    TCatFeatureAccessor catFeaturesAccessor,
+    size_t docCount,
+    TArrayRef<TArrayRef<double>> results) const
+{
+    const auto& leadModel = *Models.front();
+    CB_ENSURE(results.size() == Models.size(), "results count should match ensemble model count");
+    for (size_t modelId = 0; modelId < Models.size(); ++modelId) {
+        CB_ENSURE(
+            results[modelId].size() == docCount * Models[modelId]->ObliviousTrees.ApproxDimension,
+            "insufficient result array size for model " << modelId
+        );
+        Fill(results[modelId].begin(), results[modelId].end(), 0.0);
+    }
+    const size_t blockSize = Min<size_t>(FORMULA_EVALUATION_BLOCK_SIZE, docCount);
+    TVector<ui8> binFeatures(leadModel.ObliviousTrees.GetEffectiveBinaryFeaturesBucketsCount() * blockSize);
+    TVector<TCalcerIndexType> indexesVec(blockSize);
+    TVector<int> transposedHash(blockSize * leadModel.ObliviousTrees.CatFeatures.size());
+    TVector<float> ctrs(leadModel.ObliviousTrees.GetUsedModelCtrs().size() * blockSize);
+    for (size_t blockStart = 0; blockStart < docCount; blockStart += blockSize) {
+        const auto docCountInBlock = Min(blockSize, docCount - blockStart);
+        BinarizeFeatures(
+            leadModel,
+            floatFeatureAccessor,
+            catFeaturesAccessor,
+            blockStart,
+            blockStart + docCountInBlock,
+            binFeatures,
+            transposedHash,
+            ctrs
+        );
+        for (size_t modelId = 0; modelId < Models.size(); ++modelId) {
+            const auto& model = *Models[modelId];
+            CalcFunctions[modelId](
+                model,
+                binFeatures.data(),
+                docCountInBlock,
+                indexesVec.data(),
+                0,
+                model.ObliviousTrees.TreeSizes.size(),
+                results[modelId].data() + blockStart * model.ObliviousTrees.ApproxDimension
+            );
+        }
+    }
+}
+
+void TModelEnsembleEvaluator::CalcFlat(
+    const TVector<TConstArrayRef<float>>& features,
+    TArrayRef<TArrayRef<double>> results) const
+{
+    const auto expectedFlatVecSize = Models.front()->ObliviousTrees.GetFlatFeatureVectorExpectedSize();
+    for (const auto& flatFeaturesVec : features) {
+        CB_ENSURE(flatFeaturesVec.size() >= expectedFlatVecSize,
+                  "insufficient flat features vector size: " << flatFeaturesVec.size()
+                                                             << " expected: " << expectedFlatVecSize);
+    }
+    CalcGenericEnsemble(
+        [&features](const TFloatFeature& floatFeature, size_t index) -> float {
+            return features[index][floatFeature.FlatFeatureIndex];
+        },
+        [&features](const TCatFeature& catFeature, size_t index) -> int {
+            return ConvertFloatCatFeatureToIntHash(features[index][catFeature.FlatFeatureIndex]);
+        },
+        features.size(),
+        results
+    );
+}
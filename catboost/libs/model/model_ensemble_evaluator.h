@@ -0,0 +1,42 @@
+#pragma once
+
+#include "model.h"
+#include "formula_evaluator.h"
+
+/**
+ * Evaluator for several models sharing one feature binarization pass.
+ *
+ * All models must have identical binarization layouts (float feature borders,
+ * one-hot values and ctr features), which is the common case for
+ * champion/challenger ensembles trained on the same quantization grid.
+ * Features are binarized once per document block and every model's tree
+ * traversal runs over the shared ui8 buffer.
+ */
+class TModelEnsembleEvaluator {
+public:
+    explicit TModelEnsembleEvaluator(TVector<const TFullModel*> models);
+
+    /**
+     * Evaluate all models on a set of flat feature vectors.
+     * results[modelIdx] must have size docCount * ApproxDimension of the corresponding model.
+     */
+    void CalcFlat(
+        const TVector<TConstArrayRef<float>>& features,
+        TArrayRef<TArrayRef<double>> results) const;
+
+    size_t GetModelCount() const {
+        return Models.size();
+    }
+
+private:
+    template<typename TFloatFeatureAccessor, typename TCatFeatureAccessor>
+    void CalcGenericEnsemble(
+        TFloatFeatureAccessor floatFeatureAccessor,
+        TCatFeatureAccessor catFeaturesAccessor,
+        size_t docCount,
+        TArrayRef<TArrayRef<double>> results) const;
+
+private:
+    TVector<const TFullModel*> Models;
+    TVector<TTreeCalcFunction> CalcFunctions;
+};
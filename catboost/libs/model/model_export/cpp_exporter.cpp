@@ -2,6 +2,7 @@
 
 #include "export_helpers.h"
 
+#include <library/json/json_reader.h>
 #include <library/resource/resource.h>
 
 #include <util/string/builder.h>
@@ -12,6 +13,20 @@
 namespace NCatboost {
     using namespace NCatboostModelExportHelpers;
 
+    TCatboostModelToCppConverter::TCatboostModelToCppConverter(const TString& modelFile, bool addFileFormatExtension, const TString& userParametersJSON)
+        : Out(modelFile + (addFileFormatExtension ? ".cpp" : ""))
+    {
+        if (!userParametersJSON.empty()) {
+            NJson::TJsonValue params;
+            CB_ENSURE(NJson::ReadJsonTree(userParametersJSON, &params), "incorrect user params JSON for C++ export");
+            for (const auto& keyValue : params.GetMap()) {
+                CB_ENSURE(keyValue.first == "vectorized",
+                          "Unsupported user param for C++ export: " << keyValue.first);
+                Vectorized = keyValue.second.GetBooleanSafe();
+            }
+        }
+    }
+
     /*
      * Tiny code for case when cat features not present
      */
@@ -83,6 +98,61 @@ namespace NCatboost {
         Out << '\n';
     }
 
+    /*
+     * Blocked (vectorized) export: same data layout as the in-process formula evaluator
+     */
+
+    void TCatboostModelToCppConverter::WriteHeaderVectorized() {
+        Out << "#include <algorithm>" << '\n';
+        Out << "#include <cstring>" << '\n';
+        Out << "#include <vector>" << '\n';
+        Out << '\n';
+        Out << "#include <emmintrin.h>" << '\n';
+        Out << '\n';
+    }
+
+    void TCatboostModelToCppConverter::WriteModelVectorized(const TFullModel& model) {
+        CB_ENSURE(!model.HasCategoricalFeatures(), "Vectorized export of model with categorical features to CPP is not yet supported.");
+        CB_ENSURE(model.ObliviousTrees.ApproxDimension == 1, "Vectorized export of MultiClassification model to CPP is not supported.");
+        for (const int treeSize : model.ObliviousTrees.TreeSizes) {
+            CB_ENSURE(treeSize <= 8, "Vectorized export supports trees of depth up to 8");
+        }
+        const auto& repackedBins = model.ObliviousTrees.GetRepackedBins();
+        const auto& firstLeafOffsets = model.ObliviousTrees.GetFirstLeafOffsets();
+
+        Out << "/* Model data */" << '\n';
+
+        int binaryFeatureCount = GetBinaryFeatureCount(model);
+
+        Out << "static const struct CatboostModel {" << '\n';
+        Out << "    unsigned int FloatFeatureCount = " << model.ObliviousTrees.FloatFeatures.size() << ";" << '\n';
+        Out << "    unsigned int BinaryFeatureCount = " << binaryFeatureCount << ";" << '\n';
+        Out << "    unsigned int TreeCount = " << model.ObliviousTrees.TreeSizes.size() << ";" << '\n';
+
+        Out << "    unsigned int TreeDepth[" << model.ObliviousTrees.TreeSizes.size() << "] = {" << OutputArrayInitializer(model.ObliviousTrees.TreeSizes) << "};" << '\n';
+
+        Out << "    /* Repacked per-depth split descriptors in tree order */" << '\n';
+        Out << "    unsigned short RepackedFeatureIndex[" << repackedBins.size() << "] = {"
+            << OutputArrayInitializer([&repackedBins](size_t i) { return repackedBins[i].FeatureIndex; }, repackedBins.size()) << "};" << '\n';
+        Out << "    unsigned char RepackedSplitIdx[" << repackedBins.size() << "] = {"
+            << OutputArrayInitializer([&repackedBins](size_t i) { return (int)repackedBins[i].SplitIdx; }, repackedBins.size()) << "};" << '\n';
+
+        Out << "    unsigned int BorderCounts[" << model.ObliviousTrees.FloatFeatures.size() << "] = {" << OutputBorderCounts(model) << "};" << '\n';
+        Out << "    float Borders[" << binaryFeatureCount << "] = {" << OutputBorders(model, true) << "};" << '\n';
+
+        Out << "    unsigned int FirstLeafOffsets[" << firstLeafOffsets.size() << "] = {" << OutputArrayInitializer(firstLeafOffsets) << "};" << '\n';
+        Out << '\n';
+        Out << "    /* Aggregated array of leaf values for trees. Each tree is represented by a separate line: */" << '\n';
+        Out << "    double LeafValues[" << model.ObliviousTrees.LeafValues.size() << "] = {" << OutputLeafValues(model, TIndent(1));
+        Out << "    };" << '\n';
+        Out << "} CatboostModelStatic;" << '\n';
+        Out << '\n';
+    }
+
+    void TCatboostModelToCppConverter::WriteApplicatorVectorized() {
+        Out << NResource::Find("catboost_model_export_cpp_blocked_model_applicator");
+    }
+
     /*
      * Full model code with complete support of cat features
      */
@@ -195,7 +265,9 @@ namespace NCatboost {
             out << indent << learnCtr.first.GetHash() << "ull," << '\n';
             out << indent++ << "{" << '\n';
             out << indent << WN("IndexHashViewer") << "{";
-            const TConstArrayRef<TBucket> HashViewerBuckets = learnCtr.second.GetIndexHashViewer().GetBuckets();
+            // the generated applicator does its own linear probing, so emit the open-addressed
+            // layout even for tables that hold a perfect hash index
+            const TVector<TBucket> HashViewerBuckets = learnCtr.second.BuildDenseIndexBuckets();
             commaInner.ResetCount(HashViewerBuckets.size());
             for (const auto& bucket : HashViewerBuckets) {
                 out << "{" << bucket.Hash << "ull, " << bucket.IndexValue << "}" << commaInner;
@@ -8,17 +8,18 @@ namespace NCatboost {
         TOFStream Out;
 
     public:
-        TCatboostModelToCppConverter(const TString& modelFile, bool addFileFormatExtension, const TString& userParametersJSON)
-            : Out(modelFile + (addFileFormatExtension ? ".cpp" : ""))
-        {
-            CB_ENSURE(userParametersJSON.empty(), "JSON user params for exporting the model to C++ are not supported");
-        };
+        TCatboostModelToCppConverter(const TString& modelFile, bool addFileFormatExtension, const TString& userParametersJSON);
 
         void Write(const TFullModel& model) override {
             if (model.HasCategoricalFeatures()) {
+                CB_ENSURE(!Vectorized, "Vectorized C++ export of models with categorical features is not yet supported");
                 WriteHeaderCatFeatures();
                 WriteModelCatFeatures(model);
                 WriteApplicatorCatFeatures();
+            } else if (Vectorized) {
+                WriteHeaderVectorized();
+                WriteModelVectorized(model);
+                WriteApplicatorVectorized();
             } else {
                 WriteHeader();
                 WriteModel(model);
@@ -30,9 +31,15 @@ namespace NCatboost {
         void WriteApplicator();
         void WriteModel(const TFullModel& model);
         void WriteHeader();
+        void WriteApplicatorVectorized();
+        void WriteModelVectorized(const TFullModel& model);
+        void WriteHeaderVectorized();
         void WriteHeaderCatFeatures();
         void WriteCTRStructs();
         void WriteModelCatFeatures(const TFullModel& model);
         void WriteApplicatorCatFeatures();
+
+    private:
+        bool Vectorized = false;
     };
 }
@@ -168,7 +168,9 @@ namespace NCatboost {
             out << indent << learnCtr.first.GetHash() << " :" << '\n';
             out << indent++ << "catboost_ctr_value_table(" << '\n';
             out << indent << "index_hash_viewer = {";
-            const TConstArrayRef<TBucket> HashViewerBuckets = learnCtr.second.GetIndexHashViewer().GetBuckets();
+            // the generated applicator does its own linear probing, so emit the open-addressed
+            // layout even for tables that hold a perfect hash index
+            const TVector<TBucket> HashViewerBuckets = learnCtr.second.BuildDenseIndexBuckets();
             commaInner.ResetCount(HashViewerBuckets.size());
             for (const auto& bucket : HashViewerBuckets) {
                 out << bucket.Hash << " : " << bucket.IndexValue << commaInner;
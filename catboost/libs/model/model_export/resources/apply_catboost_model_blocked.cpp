@@ -0,0 +1,126 @@
+/* Blocked model applicator, mirrors the in-process evaluator layout:
+ * documents are processed in blocks of 128, features are binarized into a
+ * bucket-major unsigned char buffer and tree traversal works on repacked
+ * per-depth split descriptors with SSE kernels. */
+
+static const size_t CatboostModelBlockSize = 128;
+
+static inline void BinarizeBlock(
+    const float* floatFeatures,
+    size_t floatFeatureStride,
+    size_t docCountInBlock,
+    unsigned char* binFeatures)
+{
+    const struct CatboostModel& model = CatboostModelStatic;
+    unsigned int borderIndex = 0;
+    unsigned char* result = binFeatures;
+    for (unsigned int featureId = 0; featureId < model.FloatFeatureCount; ++featureId) {
+        memset(result, 0, docCountInBlock);
+        const size_t docCount16 = docCountInBlock - docCountInBlock % 16;
+        for (size_t docId = 0; docId < docCount16; docId += 16) {
+            float val[16];
+            for (size_t i = 0; i < 16; ++i) {
+                val[i] = floatFeatures[(docId + i) * floatFeatureStride + featureId];
+            }
+            const __m128i mask = _mm_set1_epi8(1);
+            const __m128 floats0 = _mm_loadu_ps(val);
+            const __m128 floats1 = _mm_loadu_ps(val + 4);
+            const __m128 floats2 = _mm_loadu_ps(val + 8);
+            const __m128 floats3 = _mm_loadu_ps(val + 12);
+            __m128i resultVec = _mm_loadu_si128((const __m128i*)(result + docId));
+            for (unsigned int j = 0; j < model.BorderCounts[featureId]; ++j) {
+                const __m128 borderVec = _mm_set1_ps(model.Borders[borderIndex + j]);
+                const __m128i r0 = _mm_castps_si128(_mm_cmpgt_ps(floats0, borderVec));
+                const __m128i r1 = _mm_castps_si128(_mm_cmpgt_ps(floats1, borderVec));
+                const __m128i r2 = _mm_castps_si128(_mm_cmpgt_ps(floats2, borderVec));
+                const __m128i r3 = _mm_castps_si128(_mm_cmpgt_ps(floats3, borderVec));
+                const __m128i packed = _mm_packs_epi16(_mm_packs_epi32(r0, r1), _mm_packs_epi32(r2, r3));
+                resultVec = _mm_add_epi8(resultVec, _mm_and_si128(packed, mask));
+            }
+            _mm_storeu_si128((__m128i*)(result + docId), resultVec);
+        }
+        for (size_t docId = docCount16; docId < docCountInBlock; ++docId) {
+            const float val = floatFeatures[docId * floatFeatureStride + featureId];
+            for (unsigned int j = 0; j < model.BorderCounts[featureId]; ++j) {
+                result[docId] += (unsigned char)(val > model.Borders[borderIndex + j]);
+            }
+        }
+        borderIndex += model.BorderCounts[featureId];
+        result += docCountInBlock;
+    }
+}
+
+static inline void CalcTreeIndexesBlock(
+    const unsigned char* binFeatures,
+    size_t docCountInBlock,
+    unsigned int treeSplitStart,
+    unsigned int treeDepth,
+    unsigned char* indexes)
+{
+    const struct CatboostModel& model = CatboostModelStatic;
+    memset(indexes, 0, docCountInBlock);
+    const size_t docCount16 = docCountInBlock - docCountInBlock % 16;
+    __m128i mask = _mm_set1_epi8(1);
+    for (unsigned int depth = 0; depth < treeDepth; ++depth) {
+        const unsigned char* binFeaturePtr =
+            binFeatures + model.RepackedFeatureIndex[treeSplitStart + depth] * docCountInBlock;
+        const unsigned char borderVal = model.RepackedSplitIdx[treeSplitStart + depth];
+        const __m128i borderVec = _mm_set1_epi8(borderVal);
+        for (size_t docId = 0; docId < docCount16; docId += 16) {
+            const __m128i vals = _mm_loadu_si128((const __m128i*)(binFeaturePtr + docId));
+            const __m128i isGe = _mm_cmpeq_epi8(_mm_max_epu8(vals, borderVec), vals);
+            const __m128i cur = _mm_loadu_si128((const __m128i*)(indexes + docId));
+            _mm_storeu_si128((__m128i*)(indexes + docId), _mm_or_si128(cur, _mm_and_si128(isGe, mask)));
+        }
+        for (size_t docId = docCount16; docId < docCountInBlock; ++docId) {
+            indexes[docId] |= (unsigned char)(binFeaturePtr[docId] >= borderVal) << depth;
+        }
+        mask = _mm_slli_epi16(mask, 1);
+    }
+}
+
+/* Model applicator: doc-major float features, results[docId] gets the raw formula value */
+void ApplyCatboostModelBlocked(
+    const float* floatFeatures,
+    size_t docCount,
+    size_t floatFeatureStride,
+    double* results)
+{
+    const struct CatboostModel& model = CatboostModelStatic;
+    std::vector<unsigned char> binFeatures(model.FloatFeatureCount * CatboostModelBlockSize);
+    std::vector<unsigned char> indexes(CatboostModelBlockSize);
+    for (size_t blockStart = 0; blockStart < docCount; blockStart += CatboostModelBlockSize) {
+        const size_t docCountInBlock = std::min(CatboostModelBlockSize, docCount - blockStart);
+        BinarizeBlock(
+            floatFeatures + blockStart * floatFeatureStride,
+            floatFeatureStride,
+            docCountInBlock,
+            binFeatures.data());
+        double* writePtr = results + blockStart;
+        memset(writePtr, 0, docCountInBlock * sizeof(double));
+        unsigned int treeSplitStart = 0;
+        for (unsigned int treeId = 0; treeId < model.TreeCount; ++treeId) {
+            const unsigned int treeDepth = model.TreeDepth[treeId];
+            CalcTreeIndexesBlock(binFeatures.data(), docCountInBlock, treeSplitStart, treeDepth, indexes.data());
+            const double* leafValues = model.LeafValues + model.FirstLeafOffsets[treeId];
+            const size_t docCount4 = docCountInBlock - docCountInBlock % 4;
+            for (size_t docId = 0; docId < docCount4; docId += 4) {
+                writePtr[docId + 0] += leafValues[indexes[docId + 0]];
+                writePtr[docId + 1] += leafValues[indexes[docId + 1]];
+                writePtr[docId + 2] += leafValues[indexes[docId + 2]];
+                writePtr[docId + 3] += leafValues[indexes[docId + 3]];
+            }
+            for (size_t docId = docCount4; docId < docCountInBlock; ++docId) {
+                writePtr[docId] += leafValues[indexes[docId]];
+            }
+            treeSplitStart += treeDepth;
+        }
+    }
+}
+
+/* Compatibility wrapper for single-document scoring */
+double ApplyCatboostModel(const std::vector<float>& features) {
+    double result = 0.0;
+    ApplyCatboostModelBlocked(features.data(), 1, features.size(), &result);
+    return result;
+}
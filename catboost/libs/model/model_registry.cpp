@@ -0,0 +1,86 @@
+#include "model_registry.h"
+#include "static_ctr_provider.h"
+
+#include <util/digest/city.h>
+#include <util/digest/multi.h>
+
+#include <algorithm>
+
+static ui64 CalcCtrTableContentHash(const TCtrValueTable& table) {
+    ui64 hash = MultiHash(table.CounterDenominator, table.TargetClassesCount);
+    const auto blob = table.GetTypedArrayRefForBlobData<char>();
+    hash = CityHash64WithSeed(blob.data(), blob.size(), hash);
+    if (table.HasPerfectHashIndex()) {
+        const auto viewer = table.GetPerfectHashViewer();
+        hash = CityHash64WithSeed(
+            reinterpret_cast<const char*>(viewer.GetSlots().data()),
+            viewer.GetSlots().size() * sizeof(NCatboost::TBucket),
+            hash);
+        hash = CityHash64WithSeed(
+            reinterpret_cast<const char*>(viewer.GetDisplacements().data()),
+            viewer.GetDisplacements().size() * sizeof(ui32),
+            hash);
+    } else {
+        const auto buckets = table.GetIndexHashViewer().GetBuckets();
+        hash = CityHash64WithSeed(
+            reinterpret_cast<const char*>(buckets.data()),
+            buckets.size() * sizeof(NCatboost::TBucket),
+            hash);
+    }
+    return hash;
+}
+
+THashMap<TModelCtrBase, ui64> TModelRegistry::CalcCtrContentHashes(const ICtrProvider* ctrProvider) {
+    THashMap<TModelCtrBase, ui64> hashes;
+    const auto* staticProvider = dynamic_cast<const TStaticCtrProvider*>(ctrProvider);
+    if (staticProvider == nullptr) {
+        return hashes;
+    }
+    for (const auto& learnCtr : staticProvider->CtrData.LearnCtrs) {
+        hashes[learnCtr.first] = CalcCtrTableContentHash(learnCtr.second);
+    }
+    return hashes;
+}
+
+void TModelRegistry::Publish(TFullModel&& model) {
+    auto generation = MakeIntrusive<TModelGeneration>();
+    generation->Model = std::move(model);
+    auto ctrHashes = CalcCtrContentHashes(generation->Model.CtrProvider.Get());
+
+    TIntrusivePtr<TModelGeneration> previous = Pin();
+    const bool canShareCtrProvider =
+        previous &&
+        previous->Model.CtrProvider &&
+        !ctrHashes.empty() &&
+        ctrHashes == CurrentCtrHashes &&
+        // the provider's bin feature indexes are set up from these, sharing is only safe
+        // when they would come out identical
+        generation->Model.ObliviousTrees.FloatFeatures == previous->Model.ObliviousTrees.FloatFeatures &&
+        generation->Model.ObliviousTrees.OneHotFeatures == previous->Model.ObliviousTrees.OneHotFeatures &&
+        generation->Model.ObliviousTrees.CatFeatures == previous->Model.ObliviousTrees.CatFeatures;
+    if (canShareCtrProvider) {
+        // drops the duplicate ctr tables right away instead of holding them until the
+        // previous generation drains
+        generation->Model.CtrProvider = previous->Model.CtrProvider;
+    }
+    CurrentCtrHashes = std::move(ctrHashes);
+
+    with_lock (Lock) {
+        if (Current) {
+            Retired.push_back(Current);
+        }
+        generation->Generation = NextGeneration++;
+        Current = generation;
+    }
+    DrainRetired();
+}
+
+void TModelRegistry::DrainRetired() {
+    with_lock (Lock) {
+        Retired.erase(
+            std::remove_if(Retired.begin(), Retired.end(), [](const TIntrusivePtr<TModelGeneration>& generation) {
+                return generation->RefCount() == 1;
+            }),
+            Retired.end());
+    }
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "model.h"
+
+#include <util/generic/hash.h>
+#include <util/generic/ptr.h>
+#include <util/generic/vector.h>
+#include <util/system/spinlock.h>
+
+/*
+ * Generation-based model registry for serving processes that hot-swap models.
+ *
+ * Readers pin the current generation with Pin() - a reference-counted grab under a
+ * spinlock held only for the pointer copy - and keep evaluating against it for as long
+ * as they hold the pointer. Publish() installs a new generation without waiting for
+ * in-flight requests; superseded generations are retired and reclaimed once the last
+ * reader drops its pin (RCU-style, with the reference count standing in for the epoch).
+ *
+ * Publish() also performs delta loading: when the incoming model carries the same ctr
+ * tables as the current one (compared by per-table content hash) and the same feature
+ * binarization, the new generation shares the current ctr provider instead of keeping a
+ * duplicate, so an unchanged ctr section - usually the bulk of the model - is not held
+ * twice while old generations drain.
+ *
+ * Pin() may be called from any thread. Publish() and DrainRetired() must be serialized
+ * by the caller; one loader thread is the expected setup.
+ */
+struct TModelGeneration : public TAtomicRefCount<TModelGeneration> {
+    TFullModel Model;
+    ui64 Generation = 0;
+};
+
+class TModelRegistry {
+public:
+    //! Grab the current generation; evaluate through pin->Model while holding the pointer.
+    TIntrusivePtr<TModelGeneration> Pin() const {
+        with_lock (Lock) {
+            return Current;
+        }
+    }
+
+    //! Install a new model as the current generation and retire the previous one.
+    void Publish(TFullModel&& model);
+
+    //! Reclaim retired generations with no remaining readers; Publish() calls this too,
+    //! a periodic maintenance call keeps memory bounded between rare publishes.
+    void DrainRetired();
+
+    ui64 GetCurrentGeneration() const {
+        with_lock (Lock) {
+            return Current ? Current->Generation : 0;
+        }
+    }
+
+    size_t GetRetiredGenerationCount() const {
+        with_lock (Lock) {
+            return Retired.size();
+        }
+    }
+
+private:
+    static THashMap<TModelCtrBase, ui64> CalcCtrContentHashes(const ICtrProvider* ctrProvider);
+
+    mutable TAdaptiveLock Lock;
+    TIntrusivePtr<TModelGeneration> Current;
+    TVector<TIntrusivePtr<TModelGeneration>> Retired;
+    // ctr content hashes of the current generation, kept to make the delta check on the
+    // next Publish() one-sided; touched only from the loader thread
+    THashMap<TModelCtrBase, ui64> CurrentCtrHashes;
+    ui64 NextGeneration = 1;
+};
@@ -2,6 +2,8 @@
 
 #include <catboost/libs/helpers/exception.h>
 
+#include <util/system/compiler.h>
+
 struct TCompressedModelCtr {
     const TFeatureCombination* Projection;
     TVector<const TModelCtr*> ModelCtrs;
@@ -48,16 +50,33 @@ void TStaticCtrProvider::CalcCtrs(const TVector<TModelCtr>& neededCtrs,
         for (size_t j = 0; j < compressedModelCtrs[i].ModelCtrs.size(); ++j) {
             auto& ctr = *compressedModelCtrs[i].ModelCtrs[j];
             auto& learnCtr = CtrData.LearnCtrs.at(ctr.Base);
-            auto hashIndexResolver = learnCtr.GetIndexHashViewer();
             const ECtrType ctrType = ctr.Base.CtrType;
             auto ptrBuckets = buckets.data();
-            for (size_t docId = 0; docId < samplesCount; ++docId) {
-                ptrBuckets[docId] = hashIndexResolver.GetIndex(ctrHashes[docId]);
+            // Both the bucket resolution and the value lookups below are dependent loads
+            // into tables far larger than the cache; running the address computation a few
+            // documents ahead hides most of the miss latency.
+            constexpr size_t PrefetchDistance = 8;
+            auto resolveBuckets = [&](const auto& hashIndexResolver) {
+                for (size_t docId = 0; docId < samplesCount; ++docId) {
+                    if (docId + PrefetchDistance < samplesCount) {
+                        hashIndexResolver.PrefetchBucket(ctrHashes[docId + PrefetchDistance]);
+                    }
+                    ptrBuckets[docId] = hashIndexResolver.GetIndex(ctrHashes[docId]);
+                }
+            };
+            if (learnCtr.HasPerfectHashIndex()) {
+                resolveBuckets(learnCtr.GetPerfectHashViewer());
+            } else {
+                resolveBuckets(learnCtr.GetIndexHashViewer());
             }
             if (ctrType == ECtrType::BinarizedTargetMeanValue || ctrType == ECtrType::FloatTargetMeanValue) {
                 const auto emptyVal = ctr.Calc(0.f, 0.f);
                 auto ctrMean = learnCtr.GetTypedArrayRefForBlobData<TCtrMeanHistory>();
                 for (size_t doc = 0; doc < samplesCount; ++doc) {
+                    if (doc + PrefetchDistance < samplesCount &&
+                        ptrBuckets[doc + PrefetchDistance] != NCatboost::TDenseIndexHashView::NotFoundIndex) {
+                        Y_PREFETCH_READ(&ctrMean[ptrBuckets[doc + PrefetchDistance]], 3);
+                    }
                     if (ptrBuckets[doc] != NCatboost::TDenseIndexHashView::NotFoundIndex) {
                         const TCtrMeanHistory& ctrMeanHistory = ctrMean[ptrBuckets[doc]];
                         resultPtr[doc + resultIdx] = ctr.Calc(ctrMeanHistory.Sum, ctrMeanHistory.Count);
@@ -70,6 +89,10 @@ void TStaticCtrProvider::CalcCtrs(const TVector<TModelCtr>& neededCtrs,
                 const int denominator = learnCtr.CounterDenominator;
                 auto emptyVal = ctr.Calc(0, denominator);
                 for (size_t doc = 0; doc < samplesCount; ++doc) {
+                    if (doc + PrefetchDistance < samplesCount &&
+                        ptrBuckets[doc + PrefetchDistance] != NCatboost::TDenseIndexHashView::NotFoundIndex) {
+                        Y_PREFETCH_READ(&ctrTotal[ptrBuckets[doc + PrefetchDistance]], 3);
+                    }
                     if (ptrBuckets[doc] != NCatboost::TDenseIndexHashView::NotFoundIndex) {
                         resultPtr[doc + resultIdx] = ctr.Calc(ctrTotal[ptrBuckets[doc]], denominator);
                     } else {
@@ -81,6 +104,10 @@ void TStaticCtrProvider::CalcCtrs(const TVector<TModelCtr>& neededCtrs,
                 const int targetClassesCount = learnCtr.TargetClassesCount;
                 auto emptyVal = ctr.Calc(0, 0);
                 for (size_t doc = 0; doc < samplesCount; ++doc) {
+                    if (doc + PrefetchDistance < samplesCount &&
+                        ptrBuckets[doc + PrefetchDistance] != NCatboost::TDenseIndexHashView::NotFoundIndex) {
+                        Y_PREFETCH_READ(ctrIntArray.data() + ptrBuckets[doc + PrefetchDistance] * targetClassesCount, 3);
+                    }
                     if (ptrBuckets[doc] != NCatboost::TDenseIndexHashView::NotFoundIndex) {
                         int goodCount = 0;
                         int totalCount = 0;
@@ -103,6 +130,10 @@ void TStaticCtrProvider::CalcCtrs(const TVector<TModelCtr>& neededCtrs,
                     for (size_t doc = 0; doc < samplesCount; ++doc) {
                         int goodCount = 0;
                         int totalCount = 0;
+                        if (doc + PrefetchDistance < samplesCount &&
+                            ptrBuckets[doc + PrefetchDistance] != NCatboost::TDenseIndexHashView::NotFoundIndex) {
+                            Y_PREFETCH_READ(ctrIntArray.data() + ptrBuckets[doc + PrefetchDistance] * targetClassesCount, 3);
+                        }
                         if (ptrBuckets[doc] != NCatboost::TDenseIndexHashView::NotFoundIndex) {
                             auto ctrHistory = MakeArrayRef(ctrIntArray.data() + ptrBuckets[doc] * targetClassesCount, targetClassesCount);
                             for (int classId = 0; classId < ctr.TargetBorderIdx + 1; ++classId) {
@@ -117,6 +148,10 @@ void TStaticCtrProvider::CalcCtrs(const TVector<TModelCtr>& neededCtrs,
                     }
                 } else {
                     for (size_t doc = 0; doc < samplesCount; ++doc) {
+                        if (doc + PrefetchDistance < samplesCount &&
+                            ptrBuckets[doc + PrefetchDistance] != NCatboost::TDenseIndexHashView::NotFoundIndex) {
+                            Y_PREFETCH_READ(&ctrIntArray[ptrBuckets[doc + PrefetchDistance] * 2], 3);
+                        }
                         if (ptrBuckets[doc] != NCatboost::TDenseIndexHashView::NotFoundIndex) {
                             const int* ctrHistory = &ctrIntArray[ptrBuckets[doc] * 2];
                             resultPtr[doc + resultIdx] = ctr.Calc(ctrHistory[1], ctrHistory[0] + ctrHistory[1]);
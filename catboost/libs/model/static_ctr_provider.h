@@ -1,5 +1,6 @@
 #pragma once
 
+#include <util/generic/hash_set.h>
 #include <util/system/mutex.h>
 #include <library/threading/local_executor/local_executor.h>
 #include <catboost/libs/helpers/exception.h>
@@ -35,6 +36,19 @@ public:
         CtrData.LearnCtrs[ctrBase] = std::move(valueTable);
     }
 
+    void DropUnusedTables(TConstArrayRef<TModelCtrBase> usedTables) override {
+        THashSet<TModelCtrBase> usedTablesSet(usedTables.begin(), usedTables.end());
+        TVector<TModelCtrBase> tablesToDrop;
+        for (const auto& learnCtr : CtrData.LearnCtrs) {
+            if (!usedTablesSet.has(learnCtr.first)) {
+                tablesToDrop.push_back(learnCtr.first);
+            }
+        }
+        for (const auto& ctrBase : tablesToDrop) {
+            CtrData.LearnCtrs.erase(ctrBase);
+        }
+    }
+
     void Save(IOutputStream* out) const override {
         ::Save(out, CtrData);
     }
@@ -47,6 +61,27 @@ public:
         return "static_provider_v1";
     }
 
+    /**
+     * Model-finalization pass: compact every ctr table index hash, see TCtrValueTable::CompactBuckets.
+     * Compacted tables are stored in the model file on the next Save.
+     */
+    void CompactCtrTables(float loadFactor = 0.75f) {
+        for (auto& learnCtr : CtrData.LearnCtrs) {
+            learnCtr.second.CompactBuckets(loadFactor);
+        }
+    }
+
+    /**
+     * Model-finalization pass: replace every ctr table index hash with a minimal perfect hash,
+     * see TCtrValueTable::BuildPerfectHashIndex. Smaller model files and a single probe per
+     * lookup at apply time, at the cost of requiring a reader that knows the representation.
+     */
+    void BuildPerfectHashIndexes() {
+        for (auto& learnCtr : CtrData.LearnCtrs) {
+            learnCtr.second.BuildPerfectHashIndex();
+        }
+    }
+
     const THashMap<TFloatSplit, TBinFeatureIndexValue>& GetFloatFeatureIndexes() const {
         return FloatFeatureIndexes;
     }
@@ -0,0 +1,57 @@
+#include "model_test_helpers.h"
+
+#include <catboost/libs/model/approximate_scoring.h>
+
+#include <library/unittest/registar.h>
+
+Y_UNIT_TEST_SUITE(TApproximateScoring) {
+    Y_UNIT_TEST(AttachLoadRoundtrip) {
+        TFullModel model = TrainFloatCatboostModel();
+        TApproximateModelParams params;
+        params.ClusterCount = 2;
+        TFullModel approximateModel = BuildApproximateModel(model, params);
+        UNIT_ASSERT(approximateModel.GetTreeCount() > 0);
+        UNIT_ASSERT(approximateModel.GetTreeCount() <= 2);
+
+        AttachApproximateModel(approximateModel, &model);
+        TMaybe<TFullModel> loaded = TryLoadApproximateModel(model);
+        UNIT_ASSERT(loaded.Defined());
+        UNIT_ASSERT_VALUES_EQUAL(loaded->GetTreeCount(), approximateModel.GetTreeCount());
+        UNIT_ASSERT(!TryLoadApproximateModel(approximateModel).Defined());
+    }
+
+    Y_UNIT_TEST(FallbackMatchesExact) {
+        TFullModel model = TrainFloatCatboostModel();
+        TApproximateModelParams params;
+        params.ClusterCount = 2;
+        TFullModel approximateModel = BuildApproximateModel(model, params);
+
+        TVector<TVector<float>> docStorage = {
+            {+0.5f, +0.7f, -2.0f},
+            {+1.5f, +6.4f, -1.0f},
+            {-2.5f, +2.4f, +6.0f}
+        };
+        TVector<TConstArrayRef<float>> docs;
+        for (const auto& doc : docStorage) {
+            docs.emplace_back(doc);
+        }
+
+        TVector<double> exactScores(docs.size());
+        model.CalcFlat(docs, exactScores);
+
+        //an unbounded fallback margin re-scores every document exactly
+        TVector<double> scores(docs.size());
+        CalcApproximateFlat(model, approximateModel, docs, /*decisionThreshold*/ 0.0, /*fallbackMargin*/ 1e9, scores);
+        for (size_t doc = 0; doc < docs.size(); ++doc) {
+            UNIT_ASSERT_DOUBLES_EQUAL(scores[doc], exactScores[doc], 1e-9);
+        }
+
+        //a zero margin keeps the approximate scores
+        TVector<double> approximateScores(docs.size());
+        approximateModel.CalcFlat(docs, approximateScores);
+        CalcApproximateFlat(model, approximateModel, docs, /*decisionThreshold*/ 1e9, /*fallbackMargin*/ 0.0, scores);
+        for (size_t doc = 0; doc < docs.size(); ++doc) {
+            UNIT_ASSERT_DOUBLES_EQUAL(scores[doc], approximateScores[doc], 1e-9);
+        }
+    }
+}
@@ -86,6 +86,59 @@ Y_UNIT_TEST_SUITE(TObliviousTreeModel) {
         UNIT_ASSERT_EQUAL(canonVals, result);
     }
 
+    Y_UNIT_TEST(TestBinaryFeaturesBitMatrixCalc) {
+        TFullModel model;
+        model.ObliviousTrees.FloatFeatures = {
+            TFloatFeature{
+                false, 0, 0,
+                {0.5f}, // bin split 0
+                ""
+            },
+            TFloatFeature{
+                false, 1, 1,
+                {0.5f}, // bin split 1
+                ""
+            },
+            TFloatFeature{
+                false, 2, 2,
+                {0.5f}, // bin split 2
+                ""
+            }
+        };
+        {
+            TVector<int> tree = {0, 1, 2};
+            model.ObliviousTrees.AddBinTree(tree);
+            model.ObliviousTrees.LeafValues = {
+                {0., 1., 2., 3., 4., 5., 6., 7.}
+            };
+        }
+        model.UpdateDynamicData();
+        UNIT_ASSERT(HasBinaryFeaturesOnly(model));
+
+        // covers both words of the 128-bit masks and a partial trailing block
+        const size_t docCount = 200;
+        TVector<TVector<float>> features(docCount, TVector<float>(3));
+        for (size_t docId = 0; docId < docCount; ++docId) {
+            for (size_t featureId = 0; featureId < 3; ++featureId) {
+                features[docId][featureId] = (float)((docId >> featureId) & 1);
+            }
+        }
+        TVector<TConstArrayRef<float>> featureRefs(features.begin(), features.end());
+        TVector<double> expected(docCount);
+        model.CalcFlat(featureRefs, expected);
+
+        TFeatureCachedTreeEvaluator evaluator(
+            model,
+            [&features](const TFloatFeature& floatFeature, size_t index) {
+                return features[index][floatFeature.FlatFeatureIndex];
+            },
+            [](const TCatFeature&, size_t) { return 0; },
+            docCount);
+        TVector<double> result(docCount);
+        evaluator.Calc(0, model.GetTreeCount(), result);
+        UNIT_ASSERT_EQUAL(expected, result);
+    }
+
     Y_UNIT_TEST(TestFlatCalcMultiVal) {
         auto modelCalcer = MultiValueFloatModel();
         TVector<TConstArrayRef<float>> features = {
@@ -14,6 +14,20 @@ Y_UNIT_TEST_SUITE(TModelSerialization) {
         UNIT_ASSERT_EQUAL(trainedModel, deserializedModel);
     }
 
+    Y_UNIT_TEST(TestSerializeDeserializeStreamedLeafData) {
+        TFullModel trainedModel = TrainFloatCatboostModel();
+        trainedModel.StreamLeafDataOnSave = true;
+        TStringStream strStream;
+        trainedModel.Save(&strStream);
+        TFullModel deserializedModel;
+        deserializedModel.Load(&strStream);
+        UNIT_ASSERT_EQUAL(trainedModel, deserializedModel);
+        UNIT_ASSERT_EQUAL(
+            trainedModel.ObliviousTrees.LeafWeights,
+            deserializedModel.ObliviousTrees.LeafWeights);
+        UNIT_ASSERT(deserializedModel.StreamLeafDataOnSave);
+    }
+
     Y_UNIT_TEST(TestSerializeDeserializeCoreML) {
         TFullModel trainedModel = TrainFloatCatboostModel();
         TStringStream strStream;
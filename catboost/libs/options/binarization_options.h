@@ -13,6 +13,8 @@ namespace NCatboostOptions {
             : BorderSelectionType("border_type", borderSelectionType)
             , BorderCount("border_count", discretization)
             , NanMode("nan_mode", nanMode)
+            , BorderBuildSampleCount("border_build_sample_count", 0)
+            , AdaptiveBorderCount("adaptive_border_count", false)
         {
         }
 
@@ -21,8 +23,8 @@ namespace NCatboostOptions {
         }
 
         bool operator==(const TBinarizationOptions& rhs) const {
-            return std::tie(BorderSelectionType, BorderCount, NanMode) ==
-                   std::tie(rhs.BorderSelectionType, rhs.BorderCount, rhs.NanMode);
+            return std::tie(BorderSelectionType, BorderCount, NanMode, BorderBuildSampleCount, AdaptiveBorderCount) ==
+                   std::tie(rhs.BorderSelectionType, rhs.BorderCount, rhs.NanMode, rhs.BorderBuildSampleCount, rhs.AdaptiveBorderCount);
         }
 
         bool operator!=(const TBinarizationOptions& rhs) const {
@@ -30,12 +32,12 @@ namespace NCatboostOptions {
         }
 
         void Load(const NJson::TJsonValue& options) {
-            CheckedLoad(options, &BorderSelectionType, &BorderCount, &NanMode);
+            CheckedLoad(options, &BorderSelectionType, &BorderCount, &NanMode, &BorderBuildSampleCount, &AdaptiveBorderCount);
             Validate();
         }
 
         void Save(NJson::TJsonValue* options) const {
-            SaveFields(options, BorderSelectionType, BorderCount, NanMode);
+            SaveFields(options, BorderSelectionType, BorderCount, NanMode, BorderBuildSampleCount, AdaptiveBorderCount);
         }
 
         void Validate() const {
@@ -43,12 +45,20 @@ namespace NCatboostOptions {
         }
 
         ui64 GetHash() const {
-            return MultiHash(BorderSelectionType, BorderCount, NanMode);
+            return MultiHash(BorderSelectionType, BorderCount, NanMode, BorderBuildSampleCount, AdaptiveBorderCount);
         }
 
         TOption<EBorderSelectionType> BorderSelectionType;
         TOption<ui32> BorderCount;
         TOption<ENanMode> NanMode;
+        // Build borders on a random sample of this many documents instead of the full pool
+        // (0 == use all documents). Trades border exactness for a much faster start on huge pools.
+        TOption<ui32> BorderBuildSampleCount;
+        // Re-share the global bin budget (border_count per feature) between float features
+        // proportionally to a quick estimate of their splitting value, so rich continuous
+        // features get a fine grid and near-binary ones release the bins they cannot use
+        // (see GenerateBorders). The total bin count stays at the uniform budget.
+        TOption<bool> AdaptiveBorderCount;
     };
 }
 
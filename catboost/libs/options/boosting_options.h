@@ -19,6 +19,10 @@ namespace NCatboostOptions {
             , OverfittingDetector("od_config", TOverfittingDetectorOptions())
             , BoostingType("boosting_type", EBoostingType::Ordered)
             , ApproxOnFullHistory("approx_on_full_history", false, taskType)
+            , AsyncMetrics("async_metrics", false)
+            , EvalTimeFraction("eval_time_fraction", 0.0f, taskType)
+            , LazyTestApprox("lazy_test_approx", false, taskType)
+            , QuantizeLeafValues("quantize_leaf_values", false, taskType)
             , MinFoldSize("min_fold_size", 100, taskType)
             , DataPartitionType("data_partition", EDataPartitionType::FeatureParallel, taskType)
         {
@@ -27,23 +31,25 @@ namespace NCatboostOptions {
         void Load(const NJson::TJsonValue& options) {
             CheckedLoad(options,
                         &LearningRate, &FoldLenMultiplier, &PermutationBlockSize, &IterationCount, &OverfittingDetector,
-                        &BoostingType, &PermutationCount, &MinFoldSize, &ApproxOnFullHistory, &DataPartitionType);
+                        &BoostingType, &PermutationCount, &MinFoldSize, &ApproxOnFullHistory, &AsyncMetrics, &EvalTimeFraction,
+                        &LazyTestApprox, &QuantizeLeafValues, &DataPartitionType);
 
             Validate();
         }
 
         void Save(NJson::TJsonValue* options) const {
             SaveFields(options, LearningRate, FoldLenMultiplier, PermutationBlockSize, IterationCount, OverfittingDetector,
-                       BoostingType, PermutationCount, MinFoldSize, ApproxOnFullHistory, DataPartitionType);
+                       BoostingType, PermutationCount, MinFoldSize, ApproxOnFullHistory, AsyncMetrics, EvalTimeFraction,
+                       LazyTestApprox, QuantizeLeafValues, DataPartitionType);
         }
 
         bool operator==(const TBoostingOptions& rhs) const {
             return std::tie(LearningRate, FoldLenMultiplier, PermutationBlockSize, IterationCount, OverfittingDetector,
-                            ApproxOnFullHistory, BoostingType, PermutationCount,
-                            MinFoldSize, DataPartitionType) ==
+                            ApproxOnFullHistory, AsyncMetrics, EvalTimeFraction, LazyTestApprox, QuantizeLeafValues, BoostingType,
+                            PermutationCount, MinFoldSize, DataPartitionType) ==
                    std::tie(rhs.LearningRate, rhs.FoldLenMultiplier, rhs.PermutationBlockSize, rhs.IterationCount,
-                            rhs.OverfittingDetector, rhs.ApproxOnFullHistory, rhs.BoostingType,
-                            rhs.PermutationCount, rhs.MinFoldSize, rhs.DataPartitionType);
+                            rhs.OverfittingDetector, rhs.ApproxOnFullHistory, rhs.AsyncMetrics, rhs.EvalTimeFraction, rhs.LazyTestApprox,
+                            rhs.QuantizeLeafValues, rhs.BoostingType, rhs.PermutationCount, rhs.MinFoldSize, rhs.DataPartitionType);
         }
 
         bool operator!=(const TBoostingOptions& rhs) const {
@@ -66,6 +72,8 @@ namespace NCatboostOptions {
             }
 
             CB_ENSURE(!(ApproxOnFullHistory.GetUnchecked() && BoostingType.Get() == EBoostingType::Plain), "Can't use approx-on-full-history with Plain boosting-type");
+            CB_ENSURE(EvalTimeFraction.GetUnchecked() >= 0.0f && EvalTimeFraction.GetUnchecked() < 1.0f,
+                "eval_time_fraction should be in [0, 1)");
             if (LearningRate.IsSet() && LearningRate.Get() > 1) {
                 MATRIXNET_WARNING_LOG << "learning rate is greater than 1. You probably need to decrease learning rate." << Endl;
             }
@@ -79,6 +87,23 @@ namespace NCatboostOptions {
         TOption<TOverfittingDetectorOptions> OverfittingDetector;
         TOption<EBoostingType> BoostingType;
         TCpuOnlyOption<bool> ApproxOnFullHistory;
+        TOption<bool> AsyncMetrics;
+        // When positive, widen the effective metric period online so that metric evaluation
+        // stays below this fraction of the training wall time. Between true evaluations the
+        // overfitting detector is fed the value from the last evaluation, so its iteration
+        // counting keeps running. Has no effect with async_metrics, where evaluation is
+        // already off the critical path.
+        TCpuOnlyOption<float> EvalTimeFraction;
+        // Train each iteration without the test sets and apply the accumulated trees to the
+        // test approxes only on metric calculation iterations. Saves the test share of the
+        // per-document ctr and index structures when metric_period is large; between metric
+        // calculations the overfitting detector sees the value from the last calculation.
+        TCpuOnlyOption<bool> LazyTestApprox;
+        // Round every tree's leaf values to a signed 8-bit grid with a per-tree scale right
+        // after leaf estimation. Later iterations see the rounding error in the residuals
+        // and absorb it, so the finished model's leaves lie on the int8 grid and can be
+        // stored quantized without post-training loss.
+        TCpuOnlyOption<bool> QuantizeLeafValues;
 
         TGpuOnlyOption<ui32> MinFoldSize;
         TGpuOnlyOption<EDataPartitionType> DataPartitionType;
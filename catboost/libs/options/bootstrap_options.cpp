@@ -6,6 +6,9 @@ namespace NCatboostOptions {
         CB_ENSURE(GetBaggingTemperature() >= 0, "Bagging temperature should be >= 0");
 
         EBootstrapType type = BootstrapType;
+        if (TopFraction.IsSet() && type != EBootstrapType::Goss) {
+            ythrow TCatboostException() << "Error: top fraction available for GOSS bootstrap only";
+        }
         switch (type) {
             case EBootstrapType::Bayesian: {
                 if (TakenFraction.IsSet()) {
@@ -20,6 +23,19 @@ namespace NCatboostOptions {
                 }
                 break;
             }
+            case EBootstrapType::Goss: {
+                if (TaskType == ETaskType::GPU) {
+                    ythrow TCatboostException()
+                        << "Error: GOSS bootstrap is not supported on GPU";
+                }
+                if (BaggingTemperature.IsSet()) {
+                    ythrow TCatboostException() << "Error: bagging temperature available for bayesian bootstrap only";
+                }
+                CB_ENSURE((GetTopFraction() >= 0) && (GetTopFraction() < 1.0f), "Top fraction should be in [0,1)");
+                CB_ENSURE(GetTopFraction() + GetTakenFraction() <= 1.0f,
+                          "Sum of top fraction and subsample should not exceed 1 for GOSS bootstrap");
+                break;
+            }
             case EBootstrapType::Poisson: {
                 if (TaskType == ETaskType::CPU) {
                     ythrow TCatboostException()
@@ -12,6 +12,7 @@ namespace NCatboostOptions {
     public:
         explicit TBootstrapConfig(ETaskType taskType)
             : TakenFraction("subsample", 0.66f)
+            , TopFraction("top_fraction", 0.2f)
             , BaggingTemperature("bagging_temperature", 1.0)
             , BootstrapType("type", EBootstrapType::Bayesian)
             , TaskType(taskType)
@@ -22,6 +23,10 @@ namespace NCatboostOptions {
             return TakenFraction.Get();
         }
 
+        float GetTopFraction() const {
+            return TopFraction.Get();
+        }
+
         float GetPoissonLambda() const {
             const float takenFraction = TakenFraction.Get();
             return takenFraction < 1 ? -log(1 - takenFraction) : -1;
@@ -41,6 +46,10 @@ namespace NCatboostOptions {
             return TakenFraction;
         }
 
+        TOption<float>& GetTopFraction() {
+            return TopFraction;
+        }
+
         TOption<float>& GetBaggingTemperature() {
             return BaggingTemperature;
         }
@@ -50,7 +59,7 @@ namespace NCatboostOptions {
         }
 
         void Load(const NJson::TJsonValue& options) {
-            CheckedLoad(options, &TakenFraction, &BaggingTemperature, &BootstrapType);
+            CheckedLoad(options, &TakenFraction, &TopFraction, &BaggingTemperature, &BootstrapType);
         }
 
         void Save(NJson::TJsonValue* options) const {
@@ -59,6 +68,10 @@ namespace NCatboostOptions {
                     SaveFields(options, BaggingTemperature, BootstrapType);
                     break;
                 }
+                case EBootstrapType::Goss: {
+                    SaveFields(options, TakenFraction, TopFraction, BootstrapType);
+                    break;
+                }
                 case EBootstrapType::No: {
                     SaveFields(options, BootstrapType);
                     break;
@@ -71,8 +84,8 @@ namespace NCatboostOptions {
         }
 
         bool operator==(const TBootstrapConfig& rhs) const {
-            return std::tie(TakenFraction, BaggingTemperature, BootstrapType) ==
-                   std::tie(rhs.TakenFraction, rhs.BaggingTemperature, rhs.BootstrapType);
+            return std::tie(TakenFraction, TopFraction, BaggingTemperature, BootstrapType) ==
+                   std::tie(rhs.TakenFraction, rhs.TopFraction, rhs.BaggingTemperature, rhs.BootstrapType);
         }
 
         bool operator!=(const TBootstrapConfig& rhs) const {
@@ -82,6 +95,7 @@ namespace NCatboostOptions {
 
     private:
         TOption<float> TakenFraction;
+        TOption<float> TopFraction;
         TOption<float> BaggingTemperature;
         TOption<EBootstrapType> BootstrapType;
         ETaskType TaskType;
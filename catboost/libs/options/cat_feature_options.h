@@ -2,6 +2,7 @@
 
 #include "restrictions.h"
 #include "binarization_options.h"
+#include "system_options.h"
 #include <catboost/libs/ctr_description/ctr_type.h>
 #include <util/generic/vector.h>
 #include <util/string/split.h>
@@ -128,31 +129,33 @@ namespace NCatboostOptions {
             , PerFeatureCtrs("per_feature_ctrs", TMap<ui32, TVector<TCtrDescription>>())
             , MaxTensorComplexity("max_ctr_complexity", 4)
             , OneHotMaxSize("one_hot_max_size", 2)
+            , OneHotMinCount("one_hot_min_count", 0)
             , CounterCalcMethod("counter_calc_method", ECounterCalc::Full)
             , StoreAllSimpleCtrs("store_all_simple_ctr", false, taskType)
             , CtrLeafCountLimit("ctr_leaf_count_limit", Max<ui64>(), taskType)
+            , CtrTableMemoryLimit("ctr_table_memory_limit", TString(), taskType)
             , TargetBorders("target_borders", TBinarizationOptions(EBorderSelectionType::MinEntropy, 1), taskType) {
             TargetBorders.GetUnchecked().DisableNanModeOption();
         }
 
         void Load(const NJson::TJsonValue& options) {
             CheckedLoad(options,
-                        &SimpleCtrs, &CombinationCtrs, &PerFeatureCtrs, &MaxTensorComplexity, &OneHotMaxSize, &CounterCalcMethod,
-                        &StoreAllSimpleCtrs, &CtrLeafCountLimit, &TargetBorders);
+                        &SimpleCtrs, &CombinationCtrs, &PerFeatureCtrs, &MaxTensorComplexity, &OneHotMaxSize, &OneHotMinCount, &CounterCalcMethod,
+                        &StoreAllSimpleCtrs, &CtrLeafCountLimit, &CtrTableMemoryLimit, &TargetBorders);
             Validate();
         }
 
         void Save(NJson::TJsonValue* options) const {
             SaveFields(options,
-                       SimpleCtrs, CombinationCtrs, PerFeatureCtrs, MaxTensorComplexity, OneHotMaxSize, CounterCalcMethod,
-                       StoreAllSimpleCtrs, CtrLeafCountLimit, TargetBorders);
+                       SimpleCtrs, CombinationCtrs, PerFeatureCtrs, MaxTensorComplexity, OneHotMaxSize, OneHotMinCount, CounterCalcMethod,
+                       StoreAllSimpleCtrs, CtrLeafCountLimit, CtrTableMemoryLimit, TargetBorders);
         }
 
         bool operator==(const TCatFeatureParams& rhs) const {
-            return std::tie(SimpleCtrs, CombinationCtrs, PerFeatureCtrs, MaxTensorComplexity, OneHotMaxSize, CounterCalcMethod,
-                            StoreAllSimpleCtrs, CtrLeafCountLimit, TargetBorders) ==
+            return std::tie(SimpleCtrs, CombinationCtrs, PerFeatureCtrs, MaxTensorComplexity, OneHotMaxSize, OneHotMinCount, CounterCalcMethod,
+                            StoreAllSimpleCtrs, CtrLeafCountLimit, CtrTableMemoryLimit, TargetBorders) ==
                    std::tie(rhs.SimpleCtrs, rhs.CombinationCtrs, rhs.PerFeatureCtrs, rhs.MaxTensorComplexity, rhs.OneHotMaxSize,
-                            rhs.CounterCalcMethod, rhs.StoreAllSimpleCtrs, rhs.CtrLeafCountLimit, rhs.TargetBorders);
+                            rhs.OneHotMinCount, rhs.CounterCalcMethod, rhs.StoreAllSimpleCtrs, rhs.CtrLeafCountLimit, rhs.CtrTableMemoryLimit, rhs.TargetBorders);
         }
 
         bool operator!=(const TCatFeatureParams& rhs) const {
@@ -169,6 +172,9 @@ namespace NCatboostOptions {
                 CB_ENSURE(CtrLeafCountLimit.Get() > 0,
                           "Error: ctr_leaf_count_limit must be positive");
             }
+            if (!CtrTableMemoryLimit.IsUnimplementedForCurrentTask()) {
+                ParseMemorySizeDescription(CtrTableMemoryLimit.Get());
+            }
         }
 
         void AddSimpleCtrDescription(const TCtrDescription& description) {
@@ -185,10 +191,18 @@ namespace NCatboostOptions {
 
         TOption<ui32> MaxTensorComplexity;
         TOption<ui32> OneHotMaxSize;
+        // Values of a one-hot feature seen fewer than this many times in the learn set are
+        // merged into the never-split "other" bin, so high-cardinality one-hot features only
+        // produce split candidates for their frequent values. 0 or 1 disables the pruning.
+        TOption<ui32> OneHotMinCount;
         TOption<ECounterCalc> CounterCalcMethod;
 
         TCpuOnlyOption<bool> StoreAllSimpleCtrs;
         TCpuOnlyOption<ui64> CtrLeafCountLimit;
+        // Budget for the cached online CTR tables of each training fold; memory size
+        // description like used_ram_limit, empty means unlimited. Least-recently-used
+        // projections are evicted and recomputed on the next lookup.
+        TCpuOnlyOption<TString> CtrTableMemoryLimit;
 
         TGpuOnlyOption<TBinarizationOptions> TargetBorders;
     };
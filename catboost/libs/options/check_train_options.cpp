@@ -13,7 +13,8 @@ void CheckFitParams(
     auto options = NCatboostOptions::LoadOptions(catBoostJsonOptions);
 
     if (options.LossFunctionDescription->GetLossFunction() == ELossFunction::Custom) {
-        CB_ENSURE(objectiveDescriptor != nullptr, "Error: provide objective descriptor for custom loss");
+        CB_ENSURE(objectiveDescriptor != nullptr || options.LossFunctionDescription->GetLossParams().has("plugin"),
+                  "Error: provide objective descriptor or a plugin library for custom loss");
     }
 
     if (options.MetricOptions->EvalMetric.IsSet() && options.MetricOptions->EvalMetric->GetLossFunction() == ELossFunction::Custom) {
@@ -15,4 +15,6 @@ struct TCrossValidationParams {
     int PartitionRandSeed = 0;
     bool Shuffle = true;
     bool Stratified = false;
+    // train folds concurrently, splitting the thread budget between them
+    bool ParallelFolds = false;
 };
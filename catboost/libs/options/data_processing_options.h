@@ -17,25 +17,26 @@ namespace NCatboostOptions {
             , ClassesCount("classes_count", 0)
             , ClassWeights("class_weights", TVector<float>())
             , ClassNames("class_names", TVector<TString>())
+            , QuantizationCachePath("quantization_cache_path", TString())
             , GpuCatFeaturesStorage("gpu_cat_features_storage", EGpuCatFeaturesStorage::GpuRam, type)
         {
             GpuCatFeaturesStorage.ChangeLoadUnimplementedPolicy(ELoadUnimplementedPolicy::SkipWithWarning);
         }
 
         void Load(const NJson::TJsonValue& options) {
-            CheckedLoad(options, &IgnoredFeatures, &HasTimeFlag, &AllowConstLabel, &FloatFeaturesBinarization, &ClassesCount, &ClassWeights, &ClassNames, &GpuCatFeaturesStorage);
+            CheckedLoad(options, &IgnoredFeatures, &HasTimeFlag, &AllowConstLabel, &FloatFeaturesBinarization, &ClassesCount, &ClassWeights, &ClassNames, &QuantizationCachePath, &GpuCatFeaturesStorage);
             CB_ENSURE(FloatFeaturesBinarization->BorderCount <= GetMaxBinCount(), "Error: catboost doesn't support binarization with >= 256 levels");
         }
 
         void Save(NJson::TJsonValue* options) const {
-            SaveFields(options, IgnoredFeatures, HasTimeFlag, AllowConstLabel, FloatFeaturesBinarization, ClassesCount, ClassWeights, ClassNames, GpuCatFeaturesStorage);
+            SaveFields(options, IgnoredFeatures, HasTimeFlag, AllowConstLabel, FloatFeaturesBinarization, ClassesCount, ClassWeights, ClassNames, QuantizationCachePath, GpuCatFeaturesStorage);
         }
 
         bool operator==(const TDataProcessingOptions& rhs) const {
             return std::tie(IgnoredFeatures, HasTimeFlag, AllowConstLabel, FloatFeaturesBinarization, ClassesCount, ClassWeights,
-                            ClassNames, GpuCatFeaturesStorage) ==
+                            ClassNames, QuantizationCachePath, GpuCatFeaturesStorage) ==
                    std::tie(rhs.IgnoredFeatures, rhs.HasTimeFlag, rhs.AllowConstLabel, rhs.FloatFeaturesBinarization, rhs.ClassesCount,
-                            rhs.ClassWeights, rhs.ClassNames, rhs.GpuCatFeaturesStorage);
+                            rhs.ClassWeights, rhs.ClassNames, rhs.QuantizationCachePath, rhs.GpuCatFeaturesStorage);
         }
 
         bool operator!=(const TDataProcessingOptions& rhs) const {
@@ -49,6 +50,7 @@ namespace NCatboostOptions {
         TOption<ui32> ClassesCount;
         TOption<TVector<float>> ClassWeights;
         TOption<TVector<TString>> ClassNames;
+        TOption<TString> QuantizationCachePath;
         TGpuOnlyOption<EGpuCatFeaturesStorage> GpuCatFeaturesStorage;
     };
 
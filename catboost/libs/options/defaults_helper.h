@@ -37,12 +37,39 @@ inline void UpdateCtrsTargetBordersOption(ELossFunction lossFunction, ui32 appro
     }
 }
 
+// Ordered boosting's leakage protection matters most on small pools; above this size the
+// variance it removes is negligible while its body-tail folds still cost 2-3x per iteration,
+// so the default switches to plain boosting (an explicit boosting_type overrides).
 inline void UpdateBoostingTypeOption(size_t learnSampleCount, NCatboostOptions::TOption<EBoostingType>* boostingTypeOption) {
     if (boostingTypeOption->NotSet() && learnSampleCount >= 50000) {
         *boostingTypeOption = EBoostingType::Plain;
     }
 }
 
+/*
+ * The estimation permutations exist to average out the target leakage that a single online
+ * ctr estimation order introduces. That noise shrinks with dataset size while the cost of
+ * every extra permutation stays linear in it, so the default permutation count steps down
+ * as the pool grows: three permutations past one million documents and two (a single
+ * estimation fold plus the averaging fold) past ten million. An explicit permutation_count
+ * always wins; the per-permutation cost is reported in the profile log to judge the
+ * trade-off on a concrete pool.
+ */
+inline void UpdatePermutationCountOption(size_t learnSampleCount, NCatboostOptions::TOption<ui32>* permutationCountOption) {
+    if (!permutationCountOption->NotSet()) {
+        return;
+    }
+    if (learnSampleCount >= 10000000) {
+        *permutationCountOption = 2;
+    } else if (learnSampleCount >= 1000000) {
+        *permutationCountOption = 3;
+    } else {
+        return;
+    }
+    MATRIXNET_INFO_LOG << "permutation_count defaulted to " << permutationCountOption->Get()
+        << " for " << learnSampleCount << " learn objects (set permutation_count to override)" << Endl;
+}
+
 inline void UpdateUseBestModel(bool hasTest, bool hasTestConstTarget, NCatboostOptions::TOption<bool>* useBestModel) {
     if (useBestModel->NotSet() && hasTest && !hasTestConstTarget) {
         *useBestModel = true;
@@ -110,6 +137,7 @@ inline void SetDataDependantDefaults(
 ) {
     UpdateUseBestModel(testPoolSize, hasTestConstTarget, useBestModel);
     UpdateBoostingTypeOption(learnPoolSize, &catBoostOptions->BoostingOptions->BoostingType);
+    UpdatePermutationCountOption(learnPoolSize, &catBoostOptions->BoostingOptions->PermutationCount);
     UpdateLearningRate(learnPoolSize, useBestModel->Get(), catBoostOptions);
 
     // TODO(nikitxskv): Remove it when the l2 normalization will be added.
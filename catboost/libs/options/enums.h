@@ -64,6 +64,7 @@ enum class EBootstrapType {
     Poisson,
     Bayesian,
     Bernoulli,
+    Goss,
     No
 };
 
@@ -199,6 +200,12 @@ enum class ENodeType {
     SingleHost
 };
 
+enum class ENodeTransport {
+    Neh,
+    Netliba,
+    AutoDetect
+};
+
 enum class EModelType {
     CatboostBinary,
     AppleCoreML,
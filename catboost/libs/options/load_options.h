@@ -43,6 +43,9 @@ namespace NCatboostOptions {
         TVector<int> IgnoredFeatures;
         TString BordersFile;
 
+        //group-preserving shuffle of the learn pool right after load; undefined means no shuffle
+        TMaybe<ui64> ShuffleSeed;
+
         TPoolLoadParams() = default;
 
         void Validate(TMaybe<ETaskType> taskType = {}) const {
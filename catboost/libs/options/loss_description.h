@@ -119,6 +119,15 @@ namespace NCatboostOptions {
         }
         return MAX_AUTOGENERATED_PAIRS_COUNT;
     }
+
+    inline bool IsPairResamplingEnabled(const TLossDescription& lossFunctionConfig) {
+        Y_ASSERT(IsPairLogit(lossFunctionConfig.GetLossFunction()));
+        const auto& lossParams = lossFunctionConfig.GetLossParams();
+        if (lossParams.has("resample_pairs")) {
+            return FromString<bool>(lossParams.at("resample_pairs"));
+        }
+        return false;
+    }
 }
 
 template <>
@@ -24,6 +24,13 @@ namespace NCatboostOptions {
             , Rsm("rsm", 1.0)
             , SamplingFrequency("sampling_frequency", ESamplingFrequency::PerTreeLevel, taskType)
             , ModelSizeReg("model_size_reg", 0.5, taskType)
+            , CandidatePruningSampleRate("candidate_pruning_sample_rate", 0.0f, taskType)
+            , ColdFeatureDemotionIters("cold_feature_demotion_iters", 0, taskType)
+            , ColdFeatureScorePeriod("cold_feature_score_period", 10, taskType)
+            , GrowDepthSchedule("grow_depth_schedule", false, taskType)
+            , LeavesEstimationConvergenceTolerance("leaf_estimation_convergence_tolerance", 0.0f, taskType)
+            , SinglePrecisionDerivatives("single_precision_derivatives", false, taskType)
+            , MonotoneConstraints("monotone_constraints", TVector<int>(), taskType)
             , ObservationsToBootstrap("observations_to_bootstrap", EObservationsToBootstrap::TestOnly, taskType) //it's specific for fold-based scheme, so here and not in bootstrap options
             , FoldSizeLossNormalization("fold_size_loss_normalization", false, taskType)
             , AddRidgeToTargetFunctionFlag("add_ridge_penalty_to_loss_function", false, taskType)
@@ -51,7 +58,14 @@ namespace NCatboostOptions {
                         &ObservationsToBootstrap,
                         &PairwiseNonDiagReg,
                         &LeavesEstimationBacktrackingType,
-                        &SamplingFrequency);
+                        &SamplingFrequency,
+                        &CandidatePruningSampleRate,
+                        &ColdFeatureDemotionIters,
+                        &ColdFeatureScorePeriod,
+                        &GrowDepthSchedule,
+                        &LeavesEstimationConvergenceTolerance,
+                        &SinglePrecisionDerivatives,
+                        &MonotoneConstraints);
 
             Validate();
         }
@@ -63,19 +77,29 @@ namespace NCatboostOptions {
                        ScoreFunction,
                        PairwiseNonDiagReg,
                        LeavesEstimationBacktrackingType,
-                       MaxCtrComplexityForBordersCaching, Rsm, ObservationsToBootstrap, SamplingFrequency);
+                       MaxCtrComplexityForBordersCaching, Rsm, ObservationsToBootstrap, SamplingFrequency,
+                       CandidatePruningSampleRate, ColdFeatureDemotionIters, ColdFeatureScorePeriod,
+                       GrowDepthSchedule,
+                       LeavesEstimationConvergenceTolerance, SinglePrecisionDerivatives,
+                       MonotoneConstraints);
         }
 
         bool operator==(const TObliviousTreeLearnerOptions& rhs) const {
             return std::tie(MaxDepth, LeavesEstimationIterations, LeavesEstimationMethod, L2Reg, ModelSizeReg, RandomStrength,
                             BootstrapConfig, Rsm, SamplingFrequency, ObservationsToBootstrap, FoldSizeLossNormalization,
                             AddRidgeToTargetFunctionFlag, ScoreFunction, MaxCtrComplexityForBordersCaching,
-                            PairwiseNonDiagReg, LeavesEstimationBacktrackingType
+                            PairwiseNonDiagReg, LeavesEstimationBacktrackingType, CandidatePruningSampleRate,
+                            ColdFeatureDemotionIters, ColdFeatureScorePeriod, GrowDepthSchedule,
+                            LeavesEstimationConvergenceTolerance, SinglePrecisionDerivatives, MonotoneConstraints
             ) ==
                    std::tie(rhs.MaxDepth, rhs.LeavesEstimationIterations, rhs.LeavesEstimationMethod, rhs.L2Reg, rhs.ModelSizeReg,
                             rhs.RandomStrength, rhs.BootstrapConfig, rhs.Rsm, rhs.SamplingFrequency,
                             rhs.ObservationsToBootstrap, rhs.FoldSizeLossNormalization, rhs.AddRidgeToTargetFunctionFlag,
-                            rhs.ScoreFunction, rhs.MaxCtrComplexityForBordersCaching, rhs.PairwiseNonDiagReg, rhs.LeavesEstimationBacktrackingType);
+                            rhs.ScoreFunction, rhs.MaxCtrComplexityForBordersCaching, rhs.PairwiseNonDiagReg, rhs.LeavesEstimationBacktrackingType,
+                            rhs.CandidatePruningSampleRate, rhs.ColdFeatureDemotionIters, rhs.ColdFeatureScorePeriod,
+                            rhs.GrowDepthSchedule,
+                            rhs.LeavesEstimationConvergenceTolerance,
+                            rhs.SinglePrecisionDerivatives, rhs.MonotoneConstraints);
         }
 
         bool operator!=(const TObliviousTreeLearnerOptions& rhs) const {
@@ -91,6 +115,19 @@ namespace NCatboostOptions {
             CB_ENSURE(LeavesEstimationIterations.Get() > 0, "Leaves estimation iterations should be positive");
             CB_ENSURE(L2Reg.Get() >= 0, "L2LeafRegularizer should be >= 0, current value: " << L2Reg.Get());
             CB_ENSURE(PairwiseNonDiagReg.Get() >= 0, "PairwiseNonDiagReg should be >= 0, current value: " << PairwiseNonDiagReg.Get());
+            const float candidatePruningSampleRate = CandidatePruningSampleRate.Get();
+            CB_ENSURE(candidatePruningSampleRate >= 0 && candidatePruningSampleRate < 1,
+                      "Candidate pruning sample rate should be in [0, 1), current value: " << candidatePruningSampleRate);
+            if (ColdFeatureDemotionIters.Get() > 0) {
+                CB_ENSURE(ColdFeatureScorePeriod.Get() > 0,
+                          "Cold feature score period should be positive when demotion is enabled");
+            }
+            CB_ENSURE(LeavesEstimationConvergenceTolerance.Get() >= 0,
+                      "Leaf estimation convergence tolerance should be >= 0, current value: " << LeavesEstimationConvergenceTolerance.Get());
+            for (int constraint : MonotoneConstraints.Get()) {
+                CB_ENSURE(constraint >= -1 && constraint <= 1,
+                          "Monotone constraint should be -1, 0 or 1, current value: " << constraint);
+            }
         }
 
         TOption<ui32> MaxDepth;
@@ -104,6 +141,20 @@ namespace NCatboostOptions {
 
         TCpuOnlyOption<ESamplingFrequency> SamplingFrequency;
         TCpuOnlyOption<float> ModelSizeReg;
+        TCpuOnlyOption<float> CandidatePruningSampleRate;
+        // Candidates whose features have not won a split for this many iterations are only
+        // scored every ColdFeatureScorePeriod-th iteration; 0 disables the demotion schedule.
+        TCpuOnlyOption<ui32> ColdFeatureDemotionIters;
+        TCpuOnlyOption<ui32> ColdFeatureScorePeriod;
+        // Start trees at depth 2 and grow towards `depth` whenever the per-tree split-gain
+        // improvements at the current depth flatten (see greedy_tensor_search.cpp); the
+        // schedule state lives in the learn progress, so snapshots resume it seamlessly.
+        TCpuOnlyOption<bool> GrowDepthSchedule;
+        TCpuOnlyOption<float> LeavesEstimationConvergenceTolerance;
+        TCpuOnlyOption<bool> SinglePrecisionDerivatives;
+        // Per flat feature index: 1 - non-decreasing, -1 - non-increasing, 0 - unconstrained.
+        // A shorter vector leaves the remaining features unconstrained.
+        TCpuOnlyOption<TVector<int>> MonotoneConstraints;
 
         TGpuOnlyOption<EObservationsToBootstrap> ObservationsToBootstrap;
         TGpuOnlyOption<bool> FoldSizeLossNormalization;
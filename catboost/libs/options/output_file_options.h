@@ -19,6 +19,8 @@ namespace NCatboostOptions {
             , MetaFile("meta", "meta.tsv")
             , JsonLogPath("json_log", "catboost_training.json")
             , ProfileLogPath("profile_log", "catboost_profile.log")
+            , TelemetryLogPath("telemetry_log", "")
+            , TraceLogPath("trace_log", "")
             , LearnErrorLogPath("learn_error_log", "learn_error.tsv")
             , ModelFormats("model_format", {EModelType::CatboostBinary})
             , TestErrorLogPath("test_error_log", "test_error.tsv")
@@ -35,6 +37,7 @@ namespace NCatboostOptions {
             , OutputBordersFileName("output_borders", "", taskType)
             , VerbosePeriod("verbose", 1)
             , MetricPeriod("metric_period", 1)
+            , MetricConfidenceIntervals("metric_confidence_intervals", false)
             , PredictionTypes("prediction_type", {EPredictionType::RawFormulaVal}, taskType)
             , OutputColumns("output_columns", {"DocId", "RawFormulaVal", "Label"}, taskType) {
             SnapshotSaveIntervalSeconds.ChangeLoadUnimplementedPolicy(ELoadUnimplementedPolicy::SkipWithWarning);
@@ -91,6 +94,20 @@ namespace NCatboostOptions {
             return ProfileLogPath.Get();
         }
 
+        // Empty means the columnar telemetry log is not written.
+        const TString& GetTelemetryLogFilename() const {
+            return TelemetryLogPath.Get();
+        }
+
+        // Empty means the chromium trace timeline is not written.
+        const TString& GetTraceLogFilename() const {
+            return TraceLogPath.Get();
+        }
+
+        TString CreateTraceLogFullPath() const {
+            return GetFullPath(TraceLogPath.Get());
+        }
+
         const TString& GetResultModelFilename() const {
             return ResultModelPath.Get();
         }
@@ -139,6 +156,10 @@ namespace NCatboostOptions {
             return MetricPeriod.Get();
         }
 
+        bool CalcMetricConfidenceIntervals() const {
+            return MetricConfidenceIntervals.Get();
+        }
+
         TString CreateFstrRegularFullPath() const {
             return GetFullPath(FstrRegularFileName.Get());
         }
@@ -157,18 +178,18 @@ namespace NCatboostOptions {
 
         bool operator==(const TOutputFilesOptions& rhs) const {
             return std::tie(
-                TrainDir, Name, MetaFile, JsonLogPath, ProfileLogPath, LearnErrorLogPath, TestErrorLogPath,
+                TrainDir, Name, MetaFile, JsonLogPath, ProfileLogPath, TelemetryLogPath, TraceLogPath, LearnErrorLogPath, TestErrorLogPath,
                 TimeLeftLog, ResultModelPath, SnapshotPath, ModelFormats, SaveSnapshotFlag,
                 AllowWriteFilesFlag, FinalCtrComputationMode, UseBestModel, SnapshotSaveIntervalSeconds,
                 EvalFileName, FstrRegularFileName, FstrInternalFileName, TrainingOptionsFileName,
-                OutputBordersFileName
+                OutputBordersFileName, MetricConfidenceIntervals
             ) == std::tie(
                 rhs.TrainDir, rhs.Name, rhs.MetaFile, rhs.JsonLogPath, rhs.ProfileLogPath,
-                rhs.LearnErrorLogPath, rhs.TestErrorLogPath, rhs.TimeLeftLog, rhs.ResultModelPath,
+                rhs.TelemetryLogPath, rhs.TraceLogPath, rhs.LearnErrorLogPath, rhs.TestErrorLogPath, rhs.TimeLeftLog, rhs.ResultModelPath,
                 rhs.SnapshotPath, rhs.ModelFormats, rhs.SaveSnapshotFlag, rhs.AllowWriteFilesFlag,
                 rhs.FinalCtrComputationMode, rhs.UseBestModel, rhs.SnapshotSaveIntervalSeconds,
                 rhs.EvalFileName, rhs.FstrRegularFileName, rhs.FstrInternalFileName,
-                rhs.TrainingOptionsFileName, rhs.OutputBordersFileName
+                rhs.TrainingOptionsFileName, rhs.OutputBordersFileName, rhs.MetricConfidenceIntervals
             );
         }
 
@@ -179,12 +200,12 @@ namespace NCatboostOptions {
         void Load(const NJson::TJsonValue& options) {
             CheckedLoad(
                 options,
-                &TrainDir, &Name, &MetaFile, &JsonLogPath, &ProfileLogPath, &LearnErrorLogPath,
+                &TrainDir, &Name, &MetaFile, &JsonLogPath, &ProfileLogPath, &TelemetryLogPath, &TraceLogPath, &LearnErrorLogPath,
                 &TestErrorLogPath, &TimeLeftLog, &ResultModelPath, &SnapshotPath, &ModelFormats,
                 &SaveSnapshotFlag, &AllowWriteFilesFlag, &FinalCtrComputationMode, &UseBestModel,
                 &SnapshotSaveIntervalSeconds, &EvalFileName, &OutputColumns, &FstrRegularFileName,
                 &FstrInternalFileName, &TrainingOptionsFileName, &MetricPeriod, &VerbosePeriod,
-                &PredictionTypes, &OutputBordersFileName
+                &PredictionTypes, &OutputBordersFileName, &MetricConfidenceIntervals
             );
             if (!VerbosePeriod.IsSet()) {
                 VerbosePeriod.Set(MetricPeriod.Get());
@@ -195,11 +216,12 @@ namespace NCatboostOptions {
         void Save(NJson::TJsonValue* options) const {
             SaveFields(
                 options,
-                TrainDir, Name, MetaFile, JsonLogPath, ProfileLogPath, LearnErrorLogPath, TestErrorLogPath,
+                TrainDir, Name, MetaFile, JsonLogPath, ProfileLogPath, TelemetryLogPath, TraceLogPath, LearnErrorLogPath, TestErrorLogPath,
                 TimeLeftLog, ResultModelPath, SnapshotPath, ModelFormats, SaveSnapshotFlag,
                 AllowWriteFilesFlag, FinalCtrComputationMode, UseBestModel, SnapshotSaveIntervalSeconds,
                 EvalFileName, OutputColumns, FstrRegularFileName, FstrInternalFileName,
-                TrainingOptionsFileName, MetricPeriod, VerbosePeriod, PredictionTypes, OutputBordersFileName
+                TrainingOptionsFileName, MetricPeriod, VerbosePeriod, PredictionTypes, OutputBordersFileName,
+                MetricConfidenceIntervals
             );
         }
 
@@ -234,6 +256,8 @@ namespace NCatboostOptions {
         TOption<TString> MetaFile;
         TOption<TString> JsonLogPath;
         TOption<TString> ProfileLogPath;
+        TOption<TString> TelemetryLogPath;
+        TOption<TString> TraceLogPath;
         TOption<TString> LearnErrorLogPath;
         TOption<TVector<EModelType>> ModelFormats;
         TOption<TString> TestErrorLogPath;
@@ -251,6 +275,7 @@ namespace NCatboostOptions {
         TGpuOnlyOption<TString> OutputBordersFileName;
         TOption<int> VerbosePeriod;
         TOption<int> MetricPeriod;
+        TOption<bool> MetricConfidenceIntervals;
 
         TCpuOnlyOption<TVector<EPredictionType>> PredictionTypes;
         TCpuOnlyOption<TVector<TString>> OutputColumns;
@@ -96,6 +96,7 @@ namespace NCatboostOptions {
         CopyOption(plainOptions, "meta", &outputFilesJson, &seenKeys);
         CopyOption(plainOptions, "json_log", &outputFilesJson, &seenKeys);
         CopyOption(plainOptions, "profile_log", &outputFilesJson, &seenKeys);
+        CopyOption(plainOptions, "telemetry_log", &outputFilesJson, &seenKeys);
         CopyOption(plainOptions, "learn_error_log", &outputFilesJson, &seenKeys);
         CopyOption(plainOptions, "test_error_log", &outputFilesJson, &seenKeys);
         CopyOption(plainOptions, "time_left_log", &outputFilesJson, &seenKeys);
@@ -105,6 +106,7 @@ namespace NCatboostOptions {
         CopyOption(plainOptions, "snapshot_save_interval_secs", &outputFilesJson, &seenKeys);
         CopyOption(plainOptions, "verbose", &outputFilesJson, &seenKeys);
         CopyOption(plainOptions, "metric_period", &outputFilesJson, &seenKeys);
+        CopyOption(plainOptions, "metric_confidence_intervals", &outputFilesJson, &seenKeys);
         CopyOption(plainOptions, "prediction_type", &outputFilesJson, &seenKeys);
         CopyOption(plainOptions, "output_columns", &outputFilesJson, &seenKeys);
         CopyOption(plainOptions, "allow_writing_files", &outputFilesJson, &seenKeys);
@@ -127,6 +129,10 @@ namespace NCatboostOptions {
         CopyOption(plainOptions, "learning_rate", &boostingOptionsRef, &seenKeys);
         CopyOption(plainOptions, "fold_len_multiplier", &boostingOptionsRef, &seenKeys);
         CopyOption(plainOptions, "approx_on_full_history", &boostingOptionsRef, &seenKeys);
+        CopyOption(plainOptions, "async_metrics", &boostingOptionsRef, &seenKeys);
+        CopyOption(plainOptions, "eval_time_fraction", &boostingOptionsRef, &seenKeys);
+        CopyOption(plainOptions, "lazy_test_approx", &boostingOptionsRef, &seenKeys);
+        CopyOption(plainOptions, "quantize_leaf_values", &boostingOptionsRef, &seenKeys);
         CopyOption(plainOptions, "fold_permutation_block", &boostingOptionsRef, &seenKeys);
         CopyOption(plainOptions, "min_fold_size", &boostingOptionsRef, &seenKeys);
         CopyOption(plainOptions, "permutation_count", &boostingOptionsRef, &seenKeys);
@@ -144,12 +150,18 @@ namespace NCatboostOptions {
         treeOptions.SetType(NJson::JSON_MAP);
         CopyOption(plainOptions, "rsm", &treeOptions, &seenKeys);
         CopyOption(plainOptions, "leaf_estimation_iterations", &treeOptions, &seenKeys);
+        CopyOption(plainOptions, "leaf_estimation_convergence_tolerance", &treeOptions, &seenKeys);
         CopyOption(plainOptions, "leaf_estimation_backtracking", &treeOptions, &seenKeys);
         CopyOption(plainOptions, "depth", &treeOptions, &seenKeys);
         CopyOption(plainOptions, "l2_leaf_reg", &treeOptions, &seenKeys);
         CopyOption(plainOptions, "bayesian_matrix_reg", &treeOptions, &seenKeys);
         CopyOption(plainOptions, "model_size_reg", &treeOptions, &seenKeys);
         CopyOption(plainOptions, "random_strength", &treeOptions, &seenKeys);
+        CopyOption(plainOptions, "candidate_pruning_sample_rate", &treeOptions, &seenKeys);
+        CopyOption(plainOptions, "cold_feature_demotion_iters", &treeOptions, &seenKeys);
+        CopyOption(plainOptions, "cold_feature_score_period", &treeOptions, &seenKeys);
+        CopyOption(plainOptions, "single_precision_derivatives", &treeOptions, &seenKeys);
+        CopyOption(plainOptions, "monotone_constraints", &treeOptions, &seenKeys);
         CopyOption(plainOptions, "leaf_estimation_method", &treeOptions, &seenKeys);
         CopyOption(plainOptions, "score_function", &treeOptions, &seenKeys);
         CopyOption(plainOptions, "fold_size_loss_normalization", &treeOptions, &seenKeys);
@@ -164,6 +176,7 @@ namespace NCatboostOptions {
         CopyOptionWithNewKey(plainOptions, "bootstrap_type", "type", &bootstrapOptions, &seenKeys);
         CopyOption(plainOptions, "bagging_temperature", &bootstrapOptions, &seenKeys);
         CopyOption(plainOptions, "subsample", &bootstrapOptions, &seenKeys);
+        CopyOption(plainOptions, "top_fraction", &bootstrapOptions, &seenKeys);
 
         //cat-features
         auto& ctrOptions = trainOptions["cat_feature_params"];
@@ -185,7 +198,9 @@ namespace NCatboostOptions {
         CopyOption(plainOptions, "counter_calc_method", &ctrOptions, &seenKeys);
         CopyOption(plainOptions, "store_all_simple_ctr", &ctrOptions, &seenKeys);
         CopyOption(plainOptions, "one_hot_max_size", &ctrOptions, &seenKeys);
+        CopyOption(plainOptions, "one_hot_min_count", &ctrOptions, &seenKeys);
         CopyOption(plainOptions, "ctr_leaf_count_limit", &ctrOptions, &seenKeys);
+        CopyOption(plainOptions, "ctr_table_memory_limit", &ctrOptions, &seenKeys);
 
         //data processing
         auto& dataProcessingOptions = trainOptions["data_processing_options"];
@@ -197,6 +212,7 @@ namespace NCatboostOptions {
         CopyOption(plainOptions, "classes_count", &dataProcessingOptions, &seenKeys);
         CopyOption(plainOptions, "class_names", &dataProcessingOptions, &seenKeys);
         CopyOption(plainOptions, "class_weights", &dataProcessingOptions, &seenKeys);
+        CopyOption(plainOptions, "quantization_cache_path", &dataProcessingOptions, &seenKeys);
         CopyOption(plainOptions, "gpu_cat_features_storage", &dataProcessingOptions, &seenKeys);
 
         auto& floatFeaturesBinarization = dataProcessingOptions["float_features_binarization"];
@@ -205,6 +221,7 @@ namespace NCatboostOptions {
         CopyOption(plainOptions, "border_count", &floatFeaturesBinarization, &seenKeys);
         CopyOptionWithNewKey(plainOptions, "feature_border_type", "border_type", &floatFeaturesBinarization, &seenKeys);
         CopyOption(plainOptions, "nan_mode", &floatFeaturesBinarization, &seenKeys);
+        CopyOption(plainOptions, "border_build_sample_count", &floatFeaturesBinarization, &seenKeys);
 
         //system
         auto& systemOptions = trainOptions["system_options"];
@@ -220,6 +237,10 @@ namespace NCatboostOptions {
         CopyOption(plainOptions, "node_type", &systemOptions, &seenKeys);
         CopyOption(plainOptions, "node_port", &systemOptions, &seenKeys);
         CopyOption(plainOptions, "file_with_hosts", &systemOptions, &seenKeys);
+        CopyOption(plainOptions, "node_transport", &systemOptions, &seenKeys);
+        CopyOption(plainOptions, "compressed_stats_transfer", &systemOptions, &seenKeys);
+        CopyOption(plainOptions, "spin_dispatch", &systemOptions, &seenKeys);
+        CopyOption(plainOptions, "huge_pages", &systemOptions, &seenKeys);
 
 
         //rest
@@ -15,9 +15,14 @@ TSystemOptions::TSystemOptions(ETaskType taskType)
     , Devices("devices", "-1", taskType)
     , GpuRamPart("gpu_ram_part", 0.95, taskType)
     , PinnedMemorySize("pinned_memory_bytes", 104857600, taskType)
+    , SpinDispatch("spin_dispatch", false, taskType)
+    , HugePages("huge_pages", false, taskType)
     , NodeType("node_type", ENodeType::SingleHost, taskType)
     , FileWithHosts("file_with_hosts", "hosts.txt", taskType)
     , NodePort("node_port", GetUnusedNodePort(), taskType)
+    , NodeTransport("node_transport", ENodeTransport::Neh, taskType)
+    , CompressedStatsTransfer("compressed_stats_transfer", false, taskType)
+    , CompensatedAccumulation("compensated_accumulation", false, taskType)
 {
     Devices.ChangeLoadUnimplementedPolicy(ELoadUnimplementedPolicy::SkipWithWarning);
     GpuRamPart.ChangeLoadUnimplementedPolicy(ELoadUnimplementedPolicy::SkipWithWarning);
@@ -25,18 +30,20 @@ TSystemOptions::TSystemOptions(ETaskType taskType)
 }
 
 void TSystemOptions::Load(const NJson::TJsonValue& options) {
-    CheckedLoad(options, &NumThreads, &CpuUsedRamLimit, &Devices, &GpuRamPart, &PinnedMemorySize, &NodeType, &FileWithHosts, &NodePort);
+    CheckedLoad(options, &NumThreads, &CpuUsedRamLimit, &Devices, &GpuRamPart, &PinnedMemorySize, &SpinDispatch, &HugePages, &NodeType, &FileWithHosts, &NodePort, &NodeTransport, &CompressedStatsTransfer, &CompensatedAccumulation);
 }
 
 void TSystemOptions::Save(NJson::TJsonValue* options) const {
-    SaveFields(options, NumThreads, CpuUsedRamLimit, Devices, GpuRamPart, PinnedMemorySize, NodeType, FileWithHosts, NodePort);
+    SaveFields(options, NumThreads, CpuUsedRamLimit, Devices, GpuRamPart, PinnedMemorySize, SpinDispatch, HugePages, NodeType, FileWithHosts, NodePort, NodeTransport, CompressedStatsTransfer, CompensatedAccumulation);
 }
 
 bool TSystemOptions::operator==(const TSystemOptions& rhs) const {
     return std::tie(NumThreads, CpuUsedRamLimit, Devices,
-                    GpuRamPart, PinnedMemorySize, NodeType, FileWithHosts, NodePort) ==
+                    GpuRamPart, PinnedMemorySize, SpinDispatch, HugePages, NodeType, FileWithHosts, NodePort,
+                    NodeTransport, CompressedStatsTransfer, CompensatedAccumulation) ==
            std::tie(rhs.NumThreads, rhs.CpuUsedRamLimit, rhs.Devices,
-                    rhs.GpuRamPart, rhs.PinnedMemorySize, rhs.NodeType, rhs.FileWithHosts, rhs.NodePort);
+                    rhs.GpuRamPart, rhs.PinnedMemorySize, rhs.SpinDispatch, rhs.HugePages, rhs.NodeType, rhs.FileWithHosts, rhs.NodePort,
+                    rhs.NodeTransport, rhs.CompressedStatsTransfer, rhs.CompensatedAccumulation);
 }
 
 bool TSystemOptions::operator!=(const TSystemOptions& rhs) const {
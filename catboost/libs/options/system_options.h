@@ -23,9 +23,27 @@ namespace NCatboostOptions {
         TGpuOnlyOption<double> GpuRamPart;
         TGpuOnlyOption<ui64> PinnedMemorySize;
 
+        // Spin-then-park task dispatch with core-pinned worker threads: workers keep spinning
+        // through the gaps between the many short fork-join regions of an iteration instead
+        // of parking after each one, removing the wakeup latency from every region at the
+        // cost of busy cpus for the whole training run.
+        TCpuOnlyOption<bool> SpinDispatch;
+
+        // Back the large training arrays (bin columns, fold approxes) with transparent
+        // 2MB pages to cut TLB misses of the histogram gathers; best effort, falls back
+        // to 4KB pages when the kernel refuses.
+        TCpuOnlyOption<bool> HugePages;
+
         TCpuOnlyOption<ENodeType> NodeType;
         TCpuOnlyOption<TString> FileWithHosts;
         TCpuOnlyOption<ui32> NodePort;
+        TCpuOnlyOption<ENodeTransport> NodeTransport;
+        TCpuOnlyOption<bool> CompressedStatsTransfer;
+
+        // Kahan-compensated summation for the long accumulation chains (metric block
+        // merges, leaf derivative buckets); a few extra flops per add buy sums that stay
+        // accurate over billions of documents (see helpers/compensated_sum.h).
+        TCpuOnlyOption<bool> CompensatedAccumulation;
 
         static ui32 GetUnusedNodePort() { return 0; }
         bool IsMaster() const;
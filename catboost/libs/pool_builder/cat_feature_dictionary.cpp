@@ -0,0 +1,24 @@
+#include "cat_feature_dictionary.h"
+
+#include <util/system/yassert.h>
+
+namespace NCB {
+    float TCatFeatureDictionary::GetOrAddValue(const TStringBuf feature) {
+        const auto it = ValueToCode.find(feature);
+        if (it != ValueToCode.end()) {
+            return it->second;
+        }
+        const int hashVal = CalcCatFeatureHash(feature);
+        const float code = ConvertCatFeatureHashToFloat(hashVal);
+        ValueToCode.emplace(TString(feature), code);
+        HashToString.emplace(hashVal, TString(feature));
+        return code;
+    }
+
+    void TCatFeatureDictionary::GetOrAddValues(const TConstArrayRef<TStringBuf> features, TArrayRef<float> values) {
+        Y_ASSERT(features.size() == values.size());
+        for (size_t i = 0; i < features.size(); ++i) {
+            values[i] = GetOrAddValue(features[i]);
+        }
+    }
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <catboost/libs/cat_feature/cat_feature.h>
+
+#include <util/generic/array_ref.h>
+#include <util/generic/hash.h>
+#include <util/generic/strbuf.h>
+#include <util/generic/string.h>
+
+namespace NCB {
+    /* Interning dictionary for categorical cell values. Real pools repeat a few
+     * thousand distinct values across billions of cells, so each distinct value is
+     * hashed and its string copied exactly once; a repeated cell costs one lookup
+     * that returns the stored float-encoded hash code.
+     */
+    class TCatFeatureDictionary {
+    public:
+        float GetOrAddValue(TStringBuf feature);
+
+        // Batched variant for a row or column of cells; each miss falls back to the per-cell path.
+        void GetOrAddValues(TConstArrayRef<TStringBuf> features, TArrayRef<float> values);
+
+        const THashMap<int, TString>& GetHashToString() const {
+            return HashToString;
+        }
+
+    private:
+        THashMap<TString, float> ValueToCode; // distinct value -> float-encoded hash
+        THashMap<int, TString> HashToString;
+    };
+}
@@ -3,6 +3,8 @@
 #include <catboost/libs/column_description/column.h>
 #include <catboost/libs/data_types/groupid.h>
 #include <catboost/libs/data_types/pair.h>
+#include <catboost/libs/helpers/exception.h>
+#include <catboost/libs/quantization_schema/schema.h>
 
 #include <util/generic/array_ref.h>
 #include <util/generic/fwd.h>
@@ -53,15 +55,49 @@ struct TPoolMetaInfo {
 namespace NCB {
     class IPoolBuilder {
     public:
+        /* Marks features whose values will never be added: builders may skip
+         * allocating per-document storage for them entirely. Must be called
+         * before Start; the default keeps storing every feature.
+         */
+        virtual void SetIgnoredFeatures(const TVector<bool>& /*ignoredFeatures*/) {
+        }
+        /* Declares that float features arrive pre-quantized: the subsequent
+         * AddBinarizedFloatFeature(Block) calls carry bins computed with the borders from
+         * `schema` and no raw float values will ever be added. Must be called before Start.
+         * The default rejects it - builders that can only store raw factor values cannot
+         * represent such a pool.
+         */
+        virtual void SetPoolQuantizationSchema(const TPoolQuantizationSchema& /*schema*/) {
+            CB_ENSURE(false, "This pool builder does not support pre-quantized features");
+        }
         virtual void Start(const TPoolMetaInfo& poolMetaInfo,
                            int docCount,
                            const TVector<int>& catFeatureIds) = 0;
         virtual void StartNextBlock(ui32 blockSize) = 0;
 
         virtual float GetCatFeatureValue(const TStringBuf& feature) = 0;
+        /* Batched variant of GetCatFeatureValue for a row or column of categorical
+         * cells. Builders override it to hash the whole batch in one pass; the
+         * default just loops over the per-cell method.
+         */
+        virtual void GetCatFeatureValues(TConstArrayRef<TStringBuf> features, TArrayRef<float> values) {
+            for (size_t i = 0; i < features.size(); ++i) {
+                values[i] = GetCatFeatureValue(features[i]);
+            }
+        }
         virtual void AddCatFeature(ui32 localIdx, ui32 featureId, const TStringBuf& feature) = 0;
         virtual void AddFloatFeature(ui32 localIdx, ui32 featureId, float feature) = 0;
         virtual void AddBinarizedFloatFeature(ui32 localIdx, ui32 featureId, ui8 binarizedFeature) = 0;
+        /* Batched variant of AddBinarizedFloatFeature for a contiguous run of documents of
+         * one feature column, as stored in quantized pool chunks. Builders override it to
+         * ingest a whole chunk in one pass; the default just loops over the per-document
+         * method.
+         */
+        virtual void AddBinarizedFloatFeatureBlock(ui32 localIdx, ui32 featureId, TConstArrayRef<ui8> binarizedFeatures) {
+            for (size_t i = 0; i < binarizedFeatures.size(); ++i) {
+                AddBinarizedFloatFeature(localIdx + i, featureId, binarizedFeatures[i]);
+            }
+        }
         virtual void AddAllFloatFeatures(ui32 localIdx, TConstArrayRef<float> features) = 0;
         virtual void AddTarget(ui32 localIdx, float value) = 0;
         virtual void AddWeight(ui32 localIdx, float value) = 0;
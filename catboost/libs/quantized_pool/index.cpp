@@ -0,0 +1,134 @@
+#include "index.h"
+
+#include <catboost/libs/helpers/exception.h>
+#include <catboost/libs/logging/logging.h>
+
+#include <util/folder/path.h>
+#include <util/generic/algorithm.h>
+#include <util/generic/strbuf.h>
+#include <util/stream/input.h>
+#include <util/stream/output.h>
+#include <util/string/cast.h>
+
+TVector<NCB::TQuantizedPoolIndexEntry> NCB::IndexQuantizedPoolDirectory(const TString& directory) {
+    const TFsPath directoryPath(directory);
+    CB_ENSURE(directoryPath.IsDirectory(), "not a directory: " << directory);
+
+    TVector<TFsPath> children;
+    directoryPath.List(children);
+    Sort(children.begin(), children.end(), [](const TFsPath& lhs, const TFsPath& rhs) {
+        return lhs.GetPath() < rhs.GetPath();
+    });
+
+    TVector<TQuantizedPoolIndexEntry> index;
+    for (const auto& child : children) {
+        if (!child.IsFile() || !IsQuantizedPoolFile(child.GetPath())) {
+            continue;
+        }
+
+        const auto fingerprint = LoadQuantizedPoolFingerprint(child.GetPath());
+        if (!fingerprint.Defined()) {
+            MATRIXNET_WARNING_LOG << "quantized pool " << child.GetPath()
+                << " predates the fingerprint block and was skipped; re-save it to index it" << Endl;
+            continue;
+        }
+
+        TQuantizedPoolIndexEntry entry;
+        entry.Path = child.GetPath();
+        entry.Fingerprint = *fingerprint;
+        index.push_back(std::move(entry));
+    }
+
+    return index;
+}
+
+void NCB::SaveQuantizedPoolIndex(
+    const TVector<TQuantizedPoolIndexEntry>& index,
+    IOutputStream* const output) {
+
+    for (const auto& entry : index) {
+        const auto& fingerprint = entry.Fingerprint;
+        (*output) << entry.Path
+            << '\t' << fingerprint.DocumentCount
+            << '\t' << fingerprint.ContentHash
+            << '\t' << fingerprint.SchemaHash
+            << '\t';
+        if (fingerprint.FeatureBorderHashes.empty()) {
+            (*output) << '-';
+        } else {
+            bool first = true;
+            for (const auto& featureIndexToHash : fingerprint.FeatureBorderHashes) {
+                if (!first) {
+                    (*output) << ',';
+                }
+                first = false;
+                (*output) << featureIndexToHash.first << ':' << featureIndexToHash.second;
+            }
+        }
+        (*output) << '\n';
+    }
+}
+
+TVector<NCB::TQuantizedPoolIndexEntry> NCB::LoadQuantizedPoolIndex(IInputStream* const input) {
+    TVector<TQuantizedPoolIndexEntry> index;
+    TString line;
+    while (input->ReadLine(line)) {
+        if (line.empty()) {
+            continue;
+        }
+
+        TStringBuf fields(line);
+        TQuantizedPoolIndexEntry entry;
+        entry.Path = TString(fields.NextTok('\t'));
+        entry.Fingerprint.DocumentCount = FromString<ui64>(fields.NextTok('\t'));
+        entry.Fingerprint.ContentHash = FromString<ui64>(fields.NextTok('\t'));
+        entry.Fingerprint.SchemaHash = FromString<ui64>(fields.NextTok('\t'));
+
+        const TStringBuf borderHashes = fields.NextTok('\t');
+        if (borderHashes != TStringBuf("-")) {
+            TStringBuf pairs(borderHashes);
+            while (!pairs.empty()) {
+                TStringBuf pair = pairs.NextTok(',');
+                const TStringBuf featureIndex = pair.NextTok(':');
+                entry.Fingerprint.FeatureBorderHashes.emplace(
+                    FromString<ui32>(featureIndex),
+                    FromString<ui64>(pair));
+            }
+        }
+
+        index.push_back(std::move(entry));
+    }
+
+    return index;
+}
+
+bool NCB::ArePoolSchemasCompatible(
+    const TQuantizedPoolFingerprint& lhs,
+    const TQuantizedPoolFingerprint& rhs,
+    TVector<ui32>* const mismatchingFeatures) {
+
+    if (lhs.SchemaHash == rhs.SchemaHash) {
+        return true;
+    }
+
+    bool compatible = true;
+    for (const auto& featureIndexToHash : lhs.FeatureBorderHashes) {
+        const auto* const rhsHash = rhs.FeatureBorderHashes.FindPtr(featureIndexToHash.first);
+        if (rhsHash == nullptr || *rhsHash != featureIndexToHash.second) {
+            compatible = false;
+            if (mismatchingFeatures != nullptr) {
+                mismatchingFeatures->push_back(featureIndexToHash.first);
+            }
+        }
+    }
+    for (const auto& featureIndexToHash : rhs.FeatureBorderHashes) {
+        if (!lhs.FeatureBorderHashes.has(featureIndexToHash.first)) {
+            compatible = false;
+            if (mismatchingFeatures != nullptr) {
+                mismatchingFeatures->push_back(featureIndexToHash.first);
+            }
+        }
+    }
+
+    return compatible;
+}
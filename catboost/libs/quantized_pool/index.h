@@ -0,0 +1,33 @@
+#pragma once
+
+#include "serialization.h"
+
+#include <util/generic/string.h>
+#include <util/generic/vector.h>
+#include <util/stream/fwd.h>
+
+namespace NCB {
+
+    struct TQuantizedPoolIndexEntry {
+        TString Path;
+        TQuantizedPoolFingerprint Fingerprint;
+    };
+
+    // Fingerprint every quantized pool directly inside the directory (non-recursive). Files
+    // without the quantized pool magic are skipped; files saved before format version 3 carry
+    // no fingerprint and are reported with a warning. Each pool contributes only a header and
+    // a footer read, so indexing a directory of large pools takes milliseconds.
+    TVector<TQuantizedPoolIndexEntry> IndexQuantizedPoolDirectory(const TString& directory);
+
+    // Tab-separated index: path, document count, content hash, schema hash, then
+    // "featureIndex:bordersHash" pairs separated by commas (a single "-" when there are none).
+    void SaveQuantizedPoolIndex(const TVector<TQuantizedPoolIndexEntry>& index, IOutputStream* output);
+    TVector<TQuantizedPoolIndexEntry> LoadQuantizedPoolIndex(IInputStream* input);
+
+    // Pools may be trained or applied interchangeably iff they were quantized with the same
+    // schema; the per-feature border hashes pinpoint the mismatching features otherwise.
+    bool ArePoolSchemasCompatible(
+        const TQuantizedPoolFingerprint& lhs,
+        const TQuantizedPoolFingerprint& rhs,
+        TVector<ui32>* mismatchingFeatures = nullptr);
+}
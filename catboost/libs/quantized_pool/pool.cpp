@@ -2,6 +2,7 @@
 
 #include <catboost/idl/pool/flat/quantized_chunk_t.fbs.h>
 #include <catboost/libs/helpers/exception.h>
+#include <util/generic/array_ref.h>
 #include <util/system/unaligned_mem.h>
 
 namespace NCB {
@@ -16,12 +17,14 @@ void TQuantizedPool::AddColumn(
         case EColumn::Num: {
             for (const auto& descriptor : Chunks[localIndex]) {
                 CB_ENSURE(static_cast<size_t>(descriptor.Chunk->BitsPerDocument()) == sizeof(ui8) * 8);
-                TUnalignedMemoryIterator<ui8> it(
-                    descriptor.Chunk->Quants()->data(),
-                    descriptor.Chunk->Quants()->size());
-                for (ui32 i = descriptor.DocumentOffset; !it.AtEnd(); it.Next(), (void)++i) {
-                    builder->AddBinarizedFloatFeature(i, featureIndex, it.Cur());
-                }
+                // Single-byte quants need no alignment fixup, so the mapped chunk can be
+                // handed to the builder as one block instead of a per-document call chain.
+                builder->AddBinarizedFloatFeatureBlock(
+                    descriptor.DocumentOffset,
+                    featureIndex,
+                    MakeArrayRef(
+                        reinterpret_cast<const ui8*>(descriptor.Chunk->Quants()->data()),
+                        descriptor.Chunk->Quants()->size()));
             }
             break;
         }
@@ -8,6 +8,9 @@
 
 #include <contrib/libs/flatbuffers/include/flatbuffers/flatbuffers.h>
 
+#include <library/blockcodecs/codecs.h>
+
+#include <util/digest/city.h>
 #include <util/digest/numeric.h>
 #include <util/folder/path.h>
 #include <util/generic/algorithm.h>
@@ -34,9 +37,12 @@ static const char Magic[] = "CatboostQuantizedPool";
 static const size_t MagicSize = Y_ARRAY_SIZE(Magic);  // yes, with terminating zero
 static const char MagicEnd[] = "CatboostQuantizedPoolEnd";
 static const size_t MagicEndSize = Y_ARRAY_SIZE(MagicEnd);  // yes, with terminating zero
-static const ui32 Version = 1;
+static const ui32 Version = 3;
 static const ui32 VersionHash = IntHash(Version);
 
+// Version 2 aligns chunks to cache line size so mapped column segments never split a line
+static const ui64 ChunkAlignment = 64;
+
 template <typename T>
 static TDeque<ui32> CollectAndSortKeys(const T& m) {
     TDeque<ui32> res;
@@ -89,13 +95,15 @@ namespace {
         ui64 Offset = 0;
         ui32 DocumentOffset = 0;
         ui32 DocumentsInChunkCount = 0;
+        ui32 RawSize = 0;  // uncompressed chunk size; 0 if the chunk is stored uncompressed
 
         TChunkInfo() = default;
-        TChunkInfo(ui32 size, ui64 offset, ui32 documentOffset, ui32 documentsInChunkCount)
+        TChunkInfo(ui32 size, ui64 offset, ui32 documentOffset, ui32 documentsInChunkCount, ui32 rawSize)
             : Size(size)
             , Offset(offset)
             , DocumentOffset(documentOffset)
-            , DocumentsInChunkCount(documentsInChunkCount) {
+            , DocumentsInChunkCount(documentsInChunkCount)
+            , RawSize(rawSize) {
         }
     };
 }
@@ -104,7 +112,9 @@ static void WriteChunk(
     const NCB::TQuantizedPool::TChunkDescription& chunk,
     TCountingOutput* const output,
     TDeque<TChunkInfo>* const chunkInfos,
-    flatbuffers::FlatBufferBuilder* const builder) {
+    flatbuffers::FlatBufferBuilder* const builder,
+    const NBlockCodecs::ICodec* const codec,
+    ui64* const contentHash) {
 
     builder->Clear();
 
@@ -116,12 +126,25 @@ static void WriteChunk(
     chunkBuilder.add_Quants(quantsOffset);
     builder->Finish(chunkBuilder.Finish());
 
-    AddPadding(16, output);
+    AddPadding(ChunkAlignment, output);
 
     const auto chunkOffset = output->Counter();
-    output->Write(builder->GetBufferPointer(), builder->GetSize());
-
-    chunkInfos->emplace_back(builder->GetSize(), chunkOffset, chunk.DocumentOffset, chunk.DocumentCount);
+    if (codec) {
+        const NBlockCodecs::TData rawData(
+            TStringBuf(reinterpret_cast<const char*>(builder->GetBufferPointer()), builder->GetSize()));
+        TBuffer compressed;
+        compressed.Resize(codec->MaxCompressedLength(rawData));
+        const auto compressedSize = codec->Compress(rawData, compressed.Data());
+        output->Write(compressed.Data(), compressedSize);
+        chunkInfos->emplace_back(compressedSize, chunkOffset, chunk.DocumentOffset, chunk.DocumentCount, builder->GetSize());
+        *contentHash = CombineHashes(*contentHash, CityHash64(compressed.Data(), compressedSize));
+    } else {
+        output->Write(builder->GetBufferPointer(), builder->GetSize());
+        chunkInfos->emplace_back(builder->GetSize(), chunkOffset, chunk.DocumentOffset, chunk.DocumentCount, 0);
+        *contentHash = CombineHashes(
+            *contentHash,
+            CityHash64(reinterpret_cast<const char*>(builder->GetBufferPointer()), builder->GetSize()));
+    }
 }
 
 static void WriteHeader(TCountingOutput* const output) {
@@ -199,7 +222,11 @@ static TPoolMetainfo MakePoolMetainfo(
     return metainfo;
 }
 
-static void WriteAsOneFile(const NCB::TQuantizedPool& pool, IOutputStream* slave) {
+static void WriteAsOneFile(
+    const NCB::TQuantizedPool& pool,
+    IOutputStream* slave,
+    const NBlockCodecs::ICodec* const codec) {
+
     TCountingOutput output(slave);
 
     WriteHeader(&output);
@@ -209,13 +236,14 @@ static void WriteAsOneFile(const NCB::TQuantizedPool& pool, IOutputStream* slave
     const auto sortedTrueFeatureIndices = CollectAndSortKeys(pool.ColumnIndexToLocalIndex);
     TDeque<TDeque<TChunkInfo>> perFeatureChunkInfos;
     perFeatureChunkInfos.resize(pool.ColumnIndexToLocalIndex.size());
+    ui64 contentHash = 0;
     {
         flatbuffers::FlatBufferBuilder builder;
         for (const auto trueFeatureIndex : sortedTrueFeatureIndices) {
             const auto localIndex = pool.ColumnIndexToLocalIndex.at(trueFeatureIndex);
             auto* const chunkInfos = &perFeatureChunkInfos[localIndex];
             for (const auto& chunk : pool.Chunks[localIndex]) {
-                WriteChunk(chunk, &output, chunkInfos, &builder);
+                WriteChunk(chunk, &output, chunkInfos, &builder, codec, &contentHash);
             }
         }
     }
@@ -233,11 +261,18 @@ static void WriteAsOneFile(const NCB::TQuantizedPool& pool, IOutputStream* slave
     }
 
     const ui64 quantizationSchemaSizeOffset = output.Counter();
-    const ui32 quantizationSchemaSize = pool.QuantizationSchema.ByteSizeLong();
+    const TString serializedSchema = pool.QuantizationSchema.SerializeAsString();
+    const ui32 quantizationSchemaSize = serializedSchema.size();
     WriteLittleEndian(quantizationSchemaSize, &output);
-    pool.QuantizationSchema.SerializeToStream(&output);
+    output.Write(serializedSchema.data(), serializedSchema.size());
 
     const ui64 featureCountOffset = output.Counter();
+    {
+        const TStringBuf codecName = codec ? codec->Name() : TStringBuf();
+        const ui32 codecNameSize = codecName.size();
+        WriteLittleEndian(codecNameSize, &output);
+        output.Write(codecName.data(), codecNameSize);
+    }
     const ui32 featureCount = sortedTrueFeatureIndices.size();
     WriteLittleEndian(featureCount, &output);
     for (const ui32 trueFeatureIndex : sortedTrueFeatureIndices) {
@@ -251,6 +286,31 @@ static void WriteAsOneFile(const NCB::TQuantizedPool& pool, IOutputStream* slave
             WriteLittleEndian(chunkInfo.Offset, &output);
             WriteLittleEndian(chunkInfo.DocumentOffset, &output);
             WriteLittleEndian(chunkInfo.DocumentsInChunkCount, &output);
+            WriteLittleEndian(chunkInfo.RawSize, &output);
+        }
+    }
+
+    // Version 3 fingerprint block: a fixed-size identity of the pool that lives next to the
+    // trailing offsets, so compatibility checks touch only the first and last pages of the
+    // mapping instead of scanning the chunks.
+    const ui64 fingerprintOffset = output.Counter();
+    {
+        WriteLittleEndian(contentHash, &output);
+        const ui64 schemaHash = CityHash64(serializedSchema.data(), serializedSchema.size());
+        WriteLittleEndian(schemaHash, &output);
+        const ui64 documentCount = pool.DocumentCount;
+        WriteLittleEndian(documentCount, &output);
+
+        const auto schemaFeatureIndices = CollectAndSortKeys(pool.QuantizationSchema.GetFeatureIndexToSchema());
+        const ui32 borderHashCount = schemaFeatureIndices.size();
+        WriteLittleEndian(borderHashCount, &output);
+        for (const ui32 featureIndex : schemaFeatureIndices) {
+            const auto& borders = pool.QuantizationSchema.GetFeatureIndexToSchema().at(featureIndex).GetBorders();
+            const ui64 bordersHash = CityHash64(
+                reinterpret_cast<const char*>(borders.data()),
+                borders.size() * sizeof(float));
+            WriteLittleEndian(featureIndex, &output);
+            WriteLittleEndian(bordersHash, &output);
         }
     }
 
@@ -258,11 +318,23 @@ static void WriteAsOneFile(const NCB::TQuantizedPool& pool, IOutputStream* slave
     WriteLittleEndian(poolMetainfoSizeOffset, &output);
     WriteLittleEndian(quantizationSchemaSizeOffset, &output);
     WriteLittleEndian(featureCountOffset, &output);
+    WriteLittleEndian(fingerprintOffset, &output);
     output.Write(MagicEnd, MagicEndSize);
 }
 
 void NCB::SaveQuantizedPool(const TQuantizedPool& pool, IOutputStream* const output) {
-    WriteAsOneFile(pool, output);
+    WriteAsOneFile(pool, output, nullptr);
+}
+
+void NCB::SaveQuantizedPool(
+    const TQuantizedPool& pool,
+    IOutputStream* const output,
+    const TSaveQuantizedPoolParameters& params) {
+
+    const NBlockCodecs::ICodec* const codec = params.ChunkCodec
+        ? NBlockCodecs::Codec(params.ChunkCodec)
+        : nullptr;
+    WriteAsOneFile(pool, output, codec);
 }
 
 static void ValidatePoolPart(const TConstArrayRef<char> blob) {
@@ -270,7 +342,7 @@ static void ValidatePoolPart(const TConstArrayRef<char> blob) {
     (void)blob;
 }
 
-static void ReadHeader(TCountingInput* const input) {
+static ui32 ReadHeader(TCountingInput* const input) {
     char magic[MagicSize];
     const auto magicSize = input->Load(magic, MagicSize);
     CB_ENSURE(MagicSize == magicSize);
@@ -278,11 +350,11 @@ static void ReadHeader(TCountingInput* const input) {
 
     ui32 version;
     ReadLittleEndian(&version, input);
-    CB_ENSURE(Version == version);
+    CB_ENSURE(version >= 1 && version <= Version, "unsupported quantized pool format version " << version);
 
     ui32 versionHash;
     ReadLittleEndian(&versionHash, input);
-    CB_ENSURE(VersionHash == versionHash);
+    CB_ENSURE(IntHash(version) == versionHash);
 
     ui32 metainfoSize;
     ReadLittleEndian(&metainfoSize, input);
@@ -291,6 +363,8 @@ static void ReadHeader(TCountingInput* const input) {
 
     const auto metainfoBytesSkipped = input->Skip(metainfoSize);
     CB_ENSURE(metainfoSize == metainfoBytesSkipped);
+
+    return version;
 }
 
 template <typename T>
@@ -379,43 +453,50 @@ namespace {
         ui64 PoolMetainfoSizeOffset = 0;
         ui64 QuantizationSchemaSizeOffset = 0;
         ui64 FeatureCountOffset = 0;
+        ui64 FingerprintOffset = 0;  // 0 for files older than version 3
     };
 }
 
-static TEpilogOffsets ReadEpilogOffsets(const TConstArrayRef<char> blob) {
+static TEpilogOffsets ReadEpilogOffsets(const TConstArrayRef<char> blob, const ui32 version) {
     TEpilogOffsets offsets;
 
     CB_ENSURE(!std::memcmp(MagicEnd, blob.data() + blob.size() - MagicEndSize, MagicEndSize));
 
-    offsets.ChunksOffset = LittleToHost(ReadUnaligned<ui64>(
-        blob.data() + blob.size() - MagicEndSize - sizeof(ui64) * 4));
+    const ui64 offsetCount = version >= 3 ? 5 : 4;
+    const char* const offsetsBegin = blob.data() + blob.size() - MagicEndSize - sizeof(ui64) * offsetCount;
+
+    offsets.ChunksOffset = LittleToHost(ReadUnaligned<ui64>(offsetsBegin));
 
-    offsets.PoolMetainfoSizeOffset = LittleToHost(ReadUnaligned<ui64>(
-        blob.data() + blob.size() - MagicEndSize - sizeof(ui64) * 3));
+    offsets.PoolMetainfoSizeOffset = LittleToHost(ReadUnaligned<ui64>(offsetsBegin + sizeof(ui64)));
     CB_ENSURE(offsets.PoolMetainfoSizeOffset < blob.size());
     CB_ENSURE(offsets.PoolMetainfoSizeOffset > offsets.ChunksOffset);
 
-    offsets.QuantizationSchemaSizeOffset = LittleToHost(ReadUnaligned<ui64>(
-        blob.data() + blob.size() - MagicEndSize - sizeof(ui64) * 2));
+    offsets.QuantizationSchemaSizeOffset = LittleToHost(ReadUnaligned<ui64>(offsetsBegin + sizeof(ui64) * 2));
     CB_ENSURE(offsets.QuantizationSchemaSizeOffset < blob.size());
     CB_ENSURE(offsets.QuantizationSchemaSizeOffset > offsets.PoolMetainfoSizeOffset);
 
-    offsets.FeatureCountOffset = LittleToHost(ReadUnaligned<ui64>(
-        blob.data() + blob.size() - MagicEndSize - sizeof(ui64)));
+    offsets.FeatureCountOffset = LittleToHost(ReadUnaligned<ui64>(offsetsBegin + sizeof(ui64) * 3));
     CB_ENSURE(offsets.FeatureCountOffset < blob.size());
     CB_ENSURE(offsets.FeatureCountOffset > offsets.QuantizationSchemaSizeOffset);
 
+    if (version >= 3) {
+        offsets.FingerprintOffset = LittleToHost(ReadUnaligned<ui64>(offsetsBegin + sizeof(ui64) * 4));
+        CB_ENSURE(offsets.FingerprintOffset < blob.size());
+        CB_ENSURE(offsets.FingerprintOffset > offsets.FeatureCountOffset);
+    }
+
     return offsets;
 }
 
 static void CollectChunks(const TConstArrayRef<char> blob, NCB::TQuantizedPool& pool) {
-    const auto chunksOffsetByReading = [blob] {
+    ui32 version = 0;
+    const auto chunksOffsetByReading = [blob, &version] {
         TMemoryInput slave(blob.data(), blob.size());
         TCountingInput input(&slave);
-        ReadHeader(&input);
+        version = ReadHeader(&input);
         return input.Counter();
     }();
-    const auto epilogOffsets = ReadEpilogOffsets(blob);
+    const auto epilogOffsets = ReadEpilogOffsets(blob, version);
     CB_ENSURE(chunksOffsetByReading == epilogOffsets.ChunksOffset);
 
     TPoolMetainfo poolMetainfo;
@@ -437,6 +518,19 @@ static void CollectChunks(const TConstArrayRef<char> blob, NCB::TQuantizedPool&
         blob.data() + epilogOffsets.FeatureCountOffset,
         blob.size() - epilogOffsets.FeatureCountOffset - MagicEndSize - sizeof(ui64) + 4);
 
+    const NBlockCodecs::ICodec* codec = nullptr;
+    if (version >= 2) {
+        ui32 codecNameSize;
+        ReadLittleEndian(&codecNameSize, &epilog);
+        if (codecNameSize > 0) {
+            TString codecName;
+            codecName.resize(codecNameSize);
+            const auto codecNameBytesRead = epilog.Load(codecName.begin(), codecNameSize);
+            CB_ENSURE(codecNameBytesRead == codecNameSize);
+            codec = NBlockCodecs::Codec(codecName);
+        }
+    }
+
     ui32 featureCount;
     ReadLittleEndian(&featureCount, &epilog);
     for (ui32 i = 0; i < featureCount; ++i) {
@@ -469,9 +563,28 @@ static void CollectChunks(const TConstArrayRef<char> blob, NCB::TQuantizedPool&
             ui32 docsInChunkCount;
             ReadLittleEndian(&docsInChunkCount, &epilog);
 
-            const TConstArrayRef<char> chunkBlob{blob.data() + chunkOffset, chunkSize};
-            // TODO(yazevnul): validate flatbuffer, including document count
-            const auto* const chunk = flatbuffers::GetRoot<NCB::NIdl::TQuantizedFeatureChunk>(chunkBlob.data());
+            ui32 rawSize = 0;
+            if (version >= 2) {
+                ReadLittleEndian(&rawSize, &epilog);
+            }
+
+            const NCB::NIdl::TQuantizedFeatureChunk* chunk;
+            if (rawSize > 0) {
+                // compressed chunk: decompress into an owned blob; uncompressed chunks stay
+                // zero-copy views into the mapping
+                CB_ENSURE(codec, "quantized pool has compressed chunks but no chunk codec");
+                TVector<char> rawChunk;
+                rawChunk.yresize(rawSize);
+                const NBlockCodecs::TData compressedData(TStringBuf(blob.data() + chunkOffset, chunkSize));
+                const auto decompressedSize = codec->Decompress(compressedData, rawChunk.data());
+                CB_ENSURE(decompressedSize == rawSize);
+                pool.Blobs.push_back(TBlob::Copy(rawChunk.data(), rawSize));
+                chunk = flatbuffers::GetRoot<NCB::NIdl::TQuantizedFeatureChunk>(pool.Blobs.back().Data());
+            } else {
+                const TConstArrayRef<char> chunkBlob{blob.data() + chunkOffset, chunkSize};
+                // TODO(yazevnul): validate flatbuffer, including document count
+                chunk = flatbuffers::GetRoot<NCB::NIdl::TQuantizedFeatureChunk>(chunkBlob.data());
+            }
 
             pool.Chunks[localFeatureIndex].emplace_back(docOffset, docsInChunkCount, chunk);
         }
@@ -579,13 +692,14 @@ static NCB::TQuantizedPoolDigest GetQuantizedPoolDigest(
 NCB::TQuantizedPoolDigest NCB::CalculateQuantizedPoolDigest(const TStringBuf path) {
     const auto file = TBlob::FromFile(TString(path));
     const TConstArrayRef<char> blob(file.AsCharPtr(), file.Size());
-    const auto chunksOffsetByReading = [blob] {
+    ui32 version = 0;
+    const auto chunksOffsetByReading = [blob, &version] {
         TMemoryInput slave(blob.data(), blob.size());
         TCountingInput input(&slave);
-        ReadHeader(&input);
+        version = ReadHeader(&input);
         return input.Counter();
     }();
-    const auto epilogOffsets = ReadEpilogOffsets(blob);
+    const auto epilogOffsets = ReadEpilogOffsets(blob, version);
     CB_ENSURE(chunksOffsetByReading == epilogOffsets.ChunksOffset);
 
     const auto columnsInfoSize = LittleToHost(ReadUnaligned<ui32>(
@@ -609,13 +723,14 @@ NCB::TQuantizedPoolDigest NCB::CalculateQuantizedPoolDigest(const TStringBuf pat
 NCB::NIdl::TPoolQuantizationSchema NCB::LoadQuantizationSchemaFromPool(const TStringBuf path) {
     const auto file = TBlob::FromFile(TString(path));
     const TConstArrayRef<char> blob(file.AsCharPtr(), file.Size());
-    const auto chunksOffsetByReading = [blob] {
+    ui32 version = 0;
+    const auto chunksOffsetByReading = [blob, &version] {
         TMemoryInput slave(blob.data(), blob.size());
         TCountingInput input(&slave);
-        ReadHeader(&input);
+        version = ReadHeader(&input);
         return input.Counter();
     }();
-    const auto epilogOffsets = ReadEpilogOffsets(blob);
+    const auto epilogOffsets = ReadEpilogOffsets(blob, version);
     CB_ENSURE(chunksOffsetByReading == epilogOffsets.ChunksOffset);
 
     NCB::NIdl::TPoolQuantizationSchema quantizationSchema;
@@ -629,16 +744,65 @@ NCB::NIdl::TPoolQuantizationSchema NCB::LoadQuantizationSchemaFromPool(const TSt
     return quantizationSchema;
 }
 
+bool NCB::IsQuantizedPoolFile(const TStringBuf path) {
+    char magic[MagicSize];
+    TFileInput input(TString(path));
+    const auto bytesRead = input.Load(magic, MagicSize);
+    return bytesRead == MagicSize && !std::memcmp(magic, Magic, MagicSize);
+}
+
+TMaybe<NCB::TQuantizedPoolFingerprint> NCB::LoadQuantizedPoolFingerprint(const TStringBuf path) {
+    const auto file = TBlob::FromFile(TString(path));
+    const TConstArrayRef<char> blob(file.AsCharPtr(), file.Size());
+
+    // Only the header and the epilog pages of the mapping are touched: the fingerprint block
+    // sits right before the trailing offsets, so identifying a multi-gigabyte pool costs a
+    // couple of page faults.
+    ui32 version = 0;
+    {
+        TMemoryInput slave(blob.data(), blob.size());
+        TCountingInput input(&slave);
+        version = ReadHeader(&input);
+    }
+    if (version < 3) {
+        return Nothing();
+    }
+
+    const auto epilogOffsets = ReadEpilogOffsets(blob, version);
+
+    TMemoryInput input(
+        blob.data() + epilogOffsets.FingerprintOffset,
+        blob.size() - epilogOffsets.FingerprintOffset - MagicEndSize);
+
+    TQuantizedPoolFingerprint fingerprint;
+    ReadLittleEndian(&fingerprint.ContentHash, &input);
+    ReadLittleEndian(&fingerprint.SchemaHash, &input);
+    ReadLittleEndian(&fingerprint.DocumentCount, &input);
+
+    ui32 borderHashCount;
+    ReadLittleEndian(&borderHashCount, &input);
+    for (ui32 i = 0; i < borderHashCount; ++i) {
+        ui32 featureIndex;
+        ReadLittleEndian(&featureIndex, &input);
+        ui64 bordersHash;
+        ReadLittleEndian(&bordersHash, &input);
+        fingerprint.FeatureBorderHashes.emplace(featureIndex, bordersHash);
+    }
+
+    return fingerprint;
+}
+
 NCB::NIdl::TPoolMetainfo NCB::LoadPoolMetainfo(const TStringBuf path) {
     const auto file = TBlob::FromFile(TString(path));
     const TConstArrayRef<char> blob(file.AsCharPtr(), file.Size());
-    const auto chunksOffsetByReading = [blob] {
+    ui32 version = 0;
+    const auto chunksOffsetByReading = [blob, &version] {
         TMemoryInput slave(blob.data(), blob.size());
         TCountingInput input(&slave);
-        ReadHeader(&input);
+        version = ReadHeader(&input);
         return input.Counter();
     }();
-    const auto epilogOffsets = ReadEpilogOffsets(blob);
+    const auto epilogOffsets = ReadEpilogOffsets(blob, version);
     CB_ENSURE(chunksOffsetByReading == epilogOffsets.ChunksOffset);
 
     NCB::NIdl::TPoolMetainfo poolMetainfo;
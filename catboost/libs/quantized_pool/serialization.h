@@ -1,7 +1,10 @@
 #pragma once
 
 #include <util/generic/fwd.h>
+#include <util/generic/map.h>
+#include <util/generic/maybe.h>
 #include <util/stream/fwd.h>
+#include <util/system/types.h>
 
 namespace NCB {
     struct TQuantizedPool;
@@ -16,6 +19,17 @@ namespace NCB {
 namespace NCB {
     void SaveQuantizedPool(const TQuantizedPool& pool, IOutputStream* output);
 
+    struct TSaveQuantizedPoolParameters {
+        // library/blockcodecs codec name used to compress each chunk; empty means chunks are
+        // stored uncompressed and are loaded as zero-copy views into the mapped file
+        TString ChunkCodec;
+    };
+
+    void SaveQuantizedPool(
+        const TQuantizedPool& pool,
+        IOutputStream* output,
+        const TSaveQuantizedPoolParameters& params);
+
     struct TLoadQuantizedPoolParameters {
         bool LockMemory = true;
         bool Precharge = true;
@@ -27,4 +41,28 @@ namespace NCB {
     NIdl::TPoolQuantizationSchema LoadQuantizationSchemaFromPool(TStringBuf path);
     NIdl::TPoolMetainfo LoadPoolMetainfo(TStringBuf path);
     TQuantizedPoolDigest CalculateQuantizedPoolDigest(TStringBuf path);
+
+    // Identity of a quantized pool recorded in the version 3 footer at save time: reading it
+    // touches only the first and last pages of the file, so pool/model/border compatibility
+    // can be checked without scanning the chunks.
+    struct TQuantizedPoolFingerprint {
+        ui64 ContentHash = 0;    // combined hash of all chunk bytes as stored
+        ui64 SchemaHash = 0;     // hash of the serialized quantization schema
+        ui64 DocumentCount = 0;
+        TMap<ui32, ui64> FeatureBorderHashes;  // feature index -> hash of its borders
+
+        bool operator==(const TQuantizedPoolFingerprint& rhs) const {
+            return ContentHash == rhs.ContentHash
+                && SchemaHash == rhs.SchemaHash
+                && DocumentCount == rhs.DocumentCount
+                && FeatureBorderHashes == rhs.FeatureBorderHashes;
+        }
+    };
+
+    // Check that the file starts with the quantized pool magic.
+    bool IsQuantizedPoolFile(TStringBuf path);
+
+    // Load the fingerprint from the pool footer; Nothing() for files saved before version 3,
+    // which have no fingerprint block and need full-scan validation instead.
+    TMaybe<TQuantizedPoolFingerprint> LoadQuantizedPoolFingerprint(TStringBuf path);
 }
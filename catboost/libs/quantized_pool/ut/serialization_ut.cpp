@@ -171,6 +171,47 @@ Y_UNIT_TEST_SUITE(SerializationTests) {
     }
 }
 
+Y_UNIT_TEST_SUITE(FingerprintTests) {
+    Y_UNIT_TEST(TestLoadFingerprint) {
+        const auto pool = MakeQuantizedPool();
+        const auto path = TFsPath(GetSystemTempDir()) / "quantized_pool.bin";
+
+        {
+            TFileOutput output(path.GetPath());
+            NCB::SaveQuantizedPool(pool, &output);
+        }
+
+        const auto fingerprint = NCB::LoadQuantizedPoolFingerprint(path.GetPath());
+        UNIT_ASSERT(fingerprint.Defined());
+        UNIT_ASSERT_VALUES_EQUAL(fingerprint->DocumentCount, pool.DocumentCount);
+        UNIT_ASSERT_UNEQUAL(fingerprint->ContentHash, 0);
+        UNIT_ASSERT_UNEQUAL(fingerprint->SchemaHash, 0);
+        UNIT_ASSERT_VALUES_EQUAL(fingerprint->FeatureBorderHashes.size(), 1);
+        UNIT_ASSERT(fingerprint->FeatureBorderHashes.has(0));
+    }
+
+    Y_UNIT_TEST(TestFingerprintIsDeterministic) {
+        const auto pool = MakeQuantizedPool();
+        const auto path = TFsPath(GetSystemTempDir()) / "quantized_pool.bin";
+        const auto otherPath = TFsPath(GetSystemTempDir()) / "quantized_pool_copy.bin";
+
+        {
+            TFileOutput output(path.GetPath());
+            NCB::SaveQuantizedPool(pool, &output);
+        }
+        {
+            TFileOutput output(otherPath.GetPath());
+            NCB::SaveQuantizedPool(pool, &output);
+        }
+
+        const auto fingerprint = NCB::LoadQuantizedPoolFingerprint(path.GetPath());
+        const auto otherFingerprint = NCB::LoadQuantizedPoolFingerprint(otherPath.GetPath());
+        UNIT_ASSERT(fingerprint.Defined());
+        UNIT_ASSERT(otherFingerprint.Defined());
+        UNIT_ASSERT(*fingerprint == *otherFingerprint);
+    }
+}
+
 Y_UNIT_TEST_SUITE(DigestTests) {
     Y_UNIT_TEST(Test) {
         const auto pool = MakeQuantizedPool();
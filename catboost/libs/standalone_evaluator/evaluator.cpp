@@ -2,11 +2,19 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <exception>
 #include <fstream>
 #include <functional>
 #include <iterator>
 
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 
 static const char MODEL_FILE_DESCRIPTOR_CHARS[4] = {'C', 'B', 'M', '1'};
 
@@ -22,6 +30,33 @@ namespace {
     static inline T Sigmoid(T val) {
         return 1 / (1 + exp(-val));
     }
+
+    const NCatBoostFbs::TModelCore* ValidateAndGetModelCore(const unsigned char* blob, size_t blobSize) {
+        const auto modelBufferStartOffset = sizeof(unsigned int) * 2;
+        if (blob == nullptr || blobSize < modelBufferStartOffset) {
+            throw std::runtime_error("trying to initialize evaluator from empty model blob");
+        }
+        {
+            const unsigned int* intPtr = reinterpret_cast<const unsigned int*>(blob);
+            // verify model file descriptor
+            if (intPtr[0] != GetModelFormatDescriptor()) {
+                throw std::runtime_error("incorrect model format descriptor");
+            }
+            // verify model blob length
+            if (intPtr[1] + modelBufferStartOffset > blobSize) {
+                throw std::runtime_error("insufficient model length");
+            }
+        }
+        auto flatbufStartPtr = blob + modelBufferStartOffset;
+        // verify flatbuffers
+        {
+            flatbuffers::Verifier verifier(flatbufStartPtr, blobSize - modelBufferStartOffset);
+            if (!NCatBoostFbs::VerifyTModelCoreBuffer(verifier)) {
+                throw std::runtime_error("corrupted flatbuffer model");
+            }
+        }
+        return NCatBoostFbs::GetTModelCore(flatbufStartPtr);
+    }
 }
 
 namespace NCatboostStandalone {
@@ -107,31 +142,88 @@ namespace NCatboostStandalone {
     }
 
     void TOwningEvaluator::InitEvaluator() {
-        const auto modelBufferStartOffset = sizeof(unsigned int) * 2;
-        if (ModelBlob.empty()) {
-            throw std::runtime_error("trying to initialize evaluator from empty ModelBlob");
+        SetModelPtr(ValidateAndGetModelCore(ModelBlob.data(), ModelBlob.size()));
+    }
+
+#if defined(_WIN32)
+    void TSharedMemoryModelPublisher::Publish(const std::string&, const std::string&) {
+        throw std::runtime_error("shared memory model deployment is not supported on this platform");
+    }
+
+    void TSharedMemoryModelPublisher::Remove(const std::string&) {
+        throw std::runtime_error("shared memory model deployment is not supported on this platform");
+    }
+
+    TSharedMemoryEvaluator::TSharedMemoryEvaluator(const std::string&) {
+        throw std::runtime_error("shared memory model deployment is not supported on this platform");
+    }
+
+    TSharedMemoryEvaluator::~TSharedMemoryEvaluator() = default;
+#else
+    void TSharedMemoryModelPublisher::Publish(const std::string& shmName, const std::string& modelFile) {
+        std::ifstream file(modelFile, std::ios::binary);
+        std::vector<unsigned char> modelBlob(
+            (std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        // fail early instead of publishing a segment nobody can attach to
+        ValidateAndGetModelCore(modelBlob.data(), modelBlob.size());
+
+        int fd = shm_open(shmName.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+        if (fd == -1) {
+            throw std::runtime_error("cannot create shared memory segment " + shmName);
         }
-        {
-            const unsigned int* intPtr = reinterpret_cast<const unsigned int*>(ModelBlob.data());
-            // verify model file descriptor
-            if (intPtr[0] != GetModelFormatDescriptor()) {
-                throw std::runtime_error("incorrect model format descriptor");
-            }
-            // verify model blob length
-            if (intPtr[1] + modelBufferStartOffset > ModelBlob.size()) {
-                throw std::runtime_error("insufficient model length");
-            }
+        if (ftruncate(fd, modelBlob.size()) == -1) {
+            close(fd);
+            shm_unlink(shmName.c_str());
+            throw std::runtime_error("cannot resize shared memory segment " + shmName);
         }
-        auto flatbufStartPtr = ModelBlob.data() + modelBufferStartOffset;
-        // verify flatbuffers
-        {
-            flatbuffers::Verifier verifier(flatbufStartPtr, ModelBlob.size() - modelBufferStartOffset);
-            if (!NCatBoostFbs::VerifyTModelCoreBuffer(verifier)) {
-                throw std::runtime_error("corrupted flatbuffer model");
-            }
+        void* mapping = mmap(nullptr, modelBlob.size(), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        if (mapping == MAP_FAILED) {
+            shm_unlink(shmName.c_str());
+            throw std::runtime_error("cannot map shared memory segment " + shmName);
+        }
+        memcpy(mapping, modelBlob.data(), modelBlob.size());
+        munmap(mapping, modelBlob.size());
+    }
+
+    void TSharedMemoryModelPublisher::Remove(const std::string& shmName) {
+        if (shm_unlink(shmName.c_str()) == -1) {
+            throw std::runtime_error("cannot unlink shared memory segment " + shmName);
+        }
+    }
+
+    TSharedMemoryEvaluator::TSharedMemoryEvaluator(const std::string& shmName) {
+        int fd = shm_open(shmName.c_str(), O_RDONLY, 0);
+        if (fd == -1) {
+            throw std::runtime_error("cannot open shared memory segment " + shmName);
+        }
+        struct stat segmentStat;
+        if (fstat(fd, &segmentStat) == -1) {
+            close(fd);
+            throw std::runtime_error("cannot stat shared memory segment " + shmName);
+        }
+        MappingSize = static_cast<size_t>(segmentStat.st_size);
+        Mapping = mmap(nullptr, MappingSize, PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        if (Mapping == MAP_FAILED) {
+            Mapping = nullptr;
+            throw std::runtime_error("cannot map shared memory segment " + shmName);
+        }
+        try {
+            SetModelPtr(ValidateAndGetModelCore(
+                static_cast<const unsigned char*>(Mapping), MappingSize));
+        } catch (...) {
+            munmap(Mapping, MappingSize);
+            Mapping = nullptr;
+            throw;
+        }
+    }
+
+    TSharedMemoryEvaluator::~TSharedMemoryEvaluator() {
+        if (Mapping != nullptr) {
+            munmap(Mapping, MappingSize);
         }
-        auto flatbufModelCore = NCatBoostFbs::GetTModelCore(flatbufStartPtr);
-        SetModelPtr(flatbufModelCore);
     }
+#endif
 }
 
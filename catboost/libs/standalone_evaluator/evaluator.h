@@ -50,5 +50,35 @@ namespace NCatboostStandalone {
     private:
         std::vector<unsigned char> ModelBlob;
     };
+
+    /**
+     * Shared-memory deployment mode (POSIX platforms only).
+     * One process per host publishes a model file into a named shared memory segment;
+     * worker processes attach with TSharedMemoryEvaluator and map the same read-only
+     * pages, so the host holds a single model copy no matter how many workers run.
+     * Segment names follow shm_open rules: "/name" with no further slashes.
+     */
+    class TSharedMemoryModelPublisher {
+        TSharedMemoryModelPublisher() = delete;
+    public:
+        //! Create the segment and copy the model file into it. Throws if the segment already exists.
+        static void Publish(const std::string& shmName, const std::string& modelFile);
+        //! Unlink the segment. Already attached evaluators keep their mappings alive.
+        static void Remove(const std::string& shmName);
+    };
+
+    //! Evaluator over a model previously published into shared memory.
+    class TSharedMemoryEvaluator : public TZeroCopyEvaluator {
+        TSharedMemoryEvaluator() = delete;
+    public:
+        explicit TSharedMemoryEvaluator(const std::string& shmName);
+        ~TSharedMemoryEvaluator();
+
+        TSharedMemoryEvaluator(const TSharedMemoryEvaluator&) = delete;
+        TSharedMemoryEvaluator& operator=(const TSharedMemoryEvaluator&) = delete;
+    private:
+        void* Mapping = nullptr;
+        size_t MappingSize = 0;
+    };
 }
 
@@ -4,6 +4,7 @@
 
 #include <catboost/libs/algo/train.h>
 #include <catboost/libs/algo/helpers.h>
+#include <catboost/libs/algo/quantization.h>
 #include <catboost/libs/metrics/metric.h>
 #include <catboost/libs/loggers/logger.h>
 #include <catboost/libs/helpers/data_split.h>
@@ -16,6 +17,8 @@
 #include <catboost/libs/overfitting_detector/error_tracker.h>
 #include <catboost/libs/options/plain_options_helper.h>
 
+#include <library/threading/local_executor/local_executor.h>
+
 #include <util/random/shuffle.h>
 
 #include <limits>
@@ -118,6 +121,23 @@ static void PrepareFolds(
         docsInTest.swap(docsInTrain);
     }
 
+    //borders are the same for every fold, so per-document float bins are too:
+    //binarize the whole pool once and let each fold gather its documents from the result
+    //instead of re-binarizing the documents it shares with the other folds
+    TVector<TVector<ui8>> fullFloatHistograms;
+    if (pool.IsQuantized()) {
+        /* a pre-quantized pool already is the full per-document bin table; it has no
+         * categorical features, so feature indices and float feature indices coincide */
+        CB_ENSURE(pool.CatFeatures.empty(), "Categorical features are not supported in quantized pools");
+        fullFloatHistograms = pool.QuantizedFeatures;
+    } else {
+        PrepareFullFloatHistograms(contexts.front()->CatFeatures,
+                                   contexts.front()->LearnProgress.FloatFeatures,
+                                   contexts.front()->LocalExecutor,
+                                   &pool.Docs,
+                                   &fullFloatHistograms);
+    }
+
     TVector<size_t> docIndices;
     docIndices.reserve(docCount);
     for (size_t foldIdx = 0; foldIdx < cvParams.FoldCount; ++foldIdx) {
@@ -152,9 +172,11 @@ static void PrepareFolds(
             contexts[foldIdx]->Params.DataProcessingOptions->IgnoredFeatures,
             /*ignoreRedundantFeatures=*/true,
             (size_t)contexts[foldIdx]->Params.CatFeatureParams->OneHotMaxSize,
+            (size_t)contexts[foldIdx]->Params.CatFeatureParams->OneHotMinCount,
             /*clearPool=*/false,
             contexts[foldIdx]->LocalExecutor,
             docsInTrain[foldIdx],
+            &fullFloatHistograms,
             &pool.Docs,
             &learnData.AllFeatures
         );
@@ -167,6 +189,7 @@ static void PrepareFolds(
             /*clearPool=*/false,
             contexts[foldIdx]->LocalExecutor,
             docsInTest[foldIdx],
+            &fullFloatHistograms,
             &pool.Docs,
             &testData.AllFeatures
         );
@@ -233,6 +256,15 @@ void CrossValidate(
 
     const int featureCount = pool.Docs.GetEffectiveFactorCount();
 
+    const bool parallelFolds = cvParams.ParallelFolds && cvParams.FoldCount > 1;
+    if (parallelFolds) {
+        /* each fold trains on its own context executor, so the thread budget is split
+         * between folds instead of being time-shared by them
+         */
+        const ui32 threadsPerFold = Max<ui32>(1, params.SystemOptions->NumThreads / cvParams.FoldCount);
+        params.SystemOptions->NumThreads = threadsPerFold;
+    }
+
     TVector<THolder<TLearnContext>> contexts;
     contexts.reserve(cvParams.FoldCount);
 
@@ -330,8 +362,9 @@ void CrossValidate(
     const bool isPairwiseScoring = IsPairwiseScoring(ctx->Params.LossFunctionDescription->GetLossFunction());
     for (size_t foldIdx = 0; foldIdx < learnFolds.size(); ++foldIdx) {
         TLearnContext& ctx = *contexts[foldIdx];
+        const bool singlePrecisionDerivatives = ctx.Params.ObliviousTreeOptions->SinglePrecisionDerivatives.Get();
         if (IsSamplingPerTree(ctx.Params.ObliviousTreeOptions.Get())) {
-            ctx.SmallestSplitSideDocs.Create(ctx.LearnProgress.Folds, isPairwiseScoring);
+            ctx.SmallestSplitSideDocs.Create(ctx.LearnProgress.Folds, isPairwiseScoring, /*sampleRate*/ 1.0f, singlePrecisionDerivatives);
             ctx.PrevTreeLevelStats.Create(
                 ctx.LearnProgress.Folds,
                 CountNonCtrBuckets(CountSplits(ctx.LearnProgress.FloatFeatures), learnFolds[foldIdx].AllFeatures.OneHotValues),
@@ -341,8 +374,18 @@ void CrossValidate(
         ctx.SampledDocs.Create(
             ctx.LearnProgress.Folds,
             isPairwiseScoring,
-            GetBernoulliSampleRate(ctx.Params.ObliviousTreeOptions->BootstrapConfig)
+            GetBernoulliSampleRate(ctx.Params.ObliviousTreeOptions->BootstrapConfig),
+            singlePrecisionDerivatives
         ); // TODO(espetrov): create only if sample rate < 1
+        const float candidatePruningSampleRate = ctx.Params.ObliviousTreeOptions->CandidatePruningSampleRate;
+        if (candidatePruningSampleRate > 0) {
+            ctx.PruningSampledDocs.Create(
+                ctx.LearnProgress.Folds,
+                isPairwiseScoring,
+                candidatePruningSampleRate * GetBernoulliSampleRate(ctx.Params.ObliviousTreeOptions->BootstrapConfig),
+                singlePrecisionDerivatives
+            );
+        }
     }
 
     EMetricBestValue bestValueType;
@@ -373,6 +416,7 @@ void CrossValidate(
             ctx->Files.TimeLeftLogFile,
             ctx->Files.JsonLogFile,
             ctx->Files.ProfileLogFile,
+            ctx->Files.TelemetryLogFile,
             ctx->OutputOptions.GetTrainDir(),
             GetJsonMeta(
                 ctx->Params.BoostingOptions->IterationCount.Get(),
@@ -395,6 +439,11 @@ void CrossValidate(
         &logger
     );
 
+    NPar::TLocalExecutor foldExecutor;
+    if (parallelFolds) {
+        foldExecutor.RunAdditionalThreads(learnFolds.ysize() - 1);
+    }
+
     TProfileInfo& profile = ctx->Profile;
     for (ui32 iteration = 0; iteration < ctx->Params.BoostingOptions->IterationCount; ++iteration) {
         profile.StartNextIteration();
@@ -408,7 +457,12 @@ void CrossValidate(
             ctx->OutputOptions.GetMetricPeriod()
         );
 
-        for (size_t foldIdx = 0; foldIdx < learnFolds.size(); ++foldIdx) {
+        /* folds share no mutable state (shared quantized pool data is read-only, everything
+         * fold-specific lives in the fold's TLearnContext and datasets), so with ParallelFolds
+         * their iterations run concurrently and metric aggregation below starts as soon as the
+         * last fold finishes
+         */
+        auto trainFoldIteration = [&](int foldIdx) {
             TrainOneIteration(learnFolds[foldIdx], &testFolds[foldIdx], contexts[foldIdx].Get());
             CalcErrors(
                 learnFolds[foldIdx],
@@ -418,6 +472,13 @@ void CrossValidate(
                 overfittingDetectorMetricIdx,
                 contexts[foldIdx].Get()
             );
+        };
+        if (parallelFolds) {
+            foldExecutor.ExecRangeWithThrow(trainFoldIteration, 0, learnFolds.ysize(), NPar::TLocalExecutor::WAIT_COMPLETE);
+        } else {
+            for (int foldIdx = 0; foldIdx < learnFolds.ysize(); ++foldIdx) {
+                trainFoldIteration(foldIdx);
+            }
         }
 
         TOneInterationLogger oneIterLogger(logger);
@@ -0,0 +1,267 @@
+#include "feature_evaluation.h"
+#include "train_model.h"
+#include "preprocess.h"
+
+#include <catboost/libs/algo/train.h>
+#include <catboost/libs/algo/helpers.h>
+#include <catboost/libs/algo/quantization.h>
+#include <catboost/libs/helpers/permutation.h>
+#include <catboost/libs/helpers/vector_helpers.h>
+#include <catboost/libs/logging/logging.h>
+#include <catboost/libs/options/plain_options_helper.h>
+#include <catboost/libs/options/defaults_helper.h>
+
+#include <util/generic/hash_set.h>
+#include <util/random/shuffle.h>
+
+#include <numeric>
+
+static TVector<int> GetBranchIgnoredFeatures(
+    const TVector<int>& alwaysIgnoredFeatures,
+    const THashSet<int>& allCandidateFeatures,
+    const TVector<int>& enabledCandidateFeatures
+) {
+    THashSet<int> ignored(alwaysIgnoredFeatures.begin(), alwaysIgnoredFeatures.end());
+    for (int feature : allCandidateFeatures) {
+        ignored.insert(feature);
+    }
+    for (int feature : enabledCandidateFeatures) {
+        ignored.erase(feature);
+    }
+    return TVector<int>(ignored.begin(), ignored.end());
+}
+
+void EvaluateFeatures(
+    const NJson::TJsonValue& plainJsonParams,
+    const TMaybe<TCustomObjectiveDescriptor>& objectiveDescriptor,
+    const TMaybe<TCustomMetricDescriptor>& evalMetricDescriptor,
+    const TVector<TCandidateFeatureSet>& candidates,
+    ui32 baselineIterationCount,
+    TPool& learnPool,
+    TPool& testPool,
+    TVector<TFeatureEvaluationResult>* results
+) {
+    NJson::TJsonValue jsonParams;
+    NJson::TJsonValue outputJsonParams;
+    NCatboostOptions::PlainJsonToOptions(plainJsonParams, &jsonParams, &outputJsonParams);
+    NCatboostOptions::TOutputFilesOptions outputFileOptions(ETaskType::CPU);
+    outputFileOptions.Load(outputJsonParams);
+    NCatboostOptions::TCatBoostOptions params(NCatboostOptions::LoadOptions(jsonParams));
+
+    CB_ENSURE(learnPool.Docs.GetDocCount() != 0, "Learn pool is empty");
+    CB_ENSURE(testPool.Docs.GetDocCount() != 0, "Feature evaluation requires a test pool");
+    CB_ENSURE(!candidates.empty(), "No candidate feature sets to evaluate");
+
+    const int featureCount = learnPool.Docs.GetEffectiveFactorCount();
+    THashSet<int> allCandidateFeatures;
+    for (const auto& candidate : candidates) {
+        CB_ENSURE(!candidate.Features.empty(),
+                  "Candidate feature set " << candidate.Name << " is empty");
+        for (int feature : candidate.Features) {
+            CB_ENSURE(feature >= 0 && feature < featureCount,
+                      "Candidate feature index " << feature << " is out of range");
+            allCandidateFeatures.insert(feature);
+        }
+    }
+
+    SetDataDependantDefaults(
+        learnPool.Docs.GetDocCount(),
+        /*testPoolSize=*/testPool.Docs.GetDocCount(),
+        /*hasTestLabels=*/true,
+        learnPool.MetaInfo.HasWeights,
+        &outputFileOptions.UseBestModel,
+        &params
+    );
+    const ui32 iterationCount = params.BoostingOptions->IterationCount;
+    CB_ENSURE(baselineIterationCount < iterationCount,
+              "Baseline iteration count " << baselineIterationCount
+              << " leaves no continuation iterations out of " << iterationCount);
+
+    // branch 0 continues on the common features and provides the baseline sample
+    const size_t branchCount = candidates.size() + 1;
+    TVector<THolder<TLearnContext>> contexts;
+    contexts.reserve(branchCount);
+    for (size_t branchIdx = 0; branchIdx < branchCount; ++branchIdx) {
+        contexts.emplace_back(new TLearnContext(
+            params,
+            objectiveDescriptor,
+            evalMetricDescriptor,
+            outputFileOptions,
+            featureCount,
+            learnPool.CatFeatures,
+            learnPool.FeatureId,
+            branchIdx == 0 ? "baseline_" : candidates[branchIdx - 1].Name + "_"
+        ));
+    }
+    auto& ctx = contexts.front();
+
+    SetLogingLevel(ctx->Params.LoggingLevel);
+    auto loggingGuard = Finally([&] { SetSilentLogingMode(); });
+
+    if (IsMultiClassError(ctx->Params.LossFunctionDescription->GetLossFunction())) {
+        for (const auto& context : contexts) {
+            int classesCount = GetClassesCount(
+                context->Params.DataProcessingOptions->ClassesCount,
+                context->Params.DataProcessingOptions->ClassNames
+            );
+            context->LearnProgress.LabelConverter.Initialize(learnPool.Docs.Target, classesCount);
+            context->LearnProgress.ApproxDimension = context->LearnProgress.LabelConverter.GetApproxDimension();
+        }
+    }
+
+    TVector<THolder<IMetric>> metrics = CreateMetrics(
+        ctx->Params.LossFunctionDescription,
+        ctx->Params.MetricOptions,
+        ctx->EvalMetricDescriptor,
+        ctx->LearnProgress.ApproxDimension
+    );
+    CheckMetrics(metrics, ctx->Params.LossFunctionDescription.Get().GetLossFunction());
+
+    TVector<ui64> indices(learnPool.Docs.GetDocCount());
+    std::iota(indices.begin(), indices.end(), 0);
+    if (!ctx->Params.DataProcessingOptions->HasTimeFlag) {
+        Shuffle(learnPool.Docs.QueryId, ctx->Rand, &indices);
+    }
+    ApplyPermutation(InvertPermutation(indices), &learnPool, &ctx->LocalExecutor);
+    auto permutationGuard = Finally([&] { ApplyPermutation(indices, &learnPool, &ctx->LocalExecutor); });
+
+    TVector<TFloatFeature> floatFeatures;
+    GenerateBorders(learnPool, ctx.Get(), &floatFeatures);
+    for (const auto& context : contexts) {
+        context->LearnProgress.FloatFeatures = floatFeatures;
+    }
+
+    // the non-feature data is identical across branches, only quantization differs
+    TDataset commonLearn = BuildDataset(learnPool);
+    TDataset commonTest = BuildDataset(testPool);
+    UpdateQueryInfo(&commonLearn);
+    UpdateQueryInfo(&commonTest);
+
+    const TVector<float>& classWeights = ctx->Params.DataProcessingOptions->ClassWeights;
+    const auto& labelConverter = ctx->LearnProgress.LabelConverter;
+    Preprocess(ctx->Params.LossFunctionDescription, classWeights, labelConverter, commonLearn);
+    CheckLearnConsistency(ctx->Params.LossFunctionDescription, ctx->Params.DataProcessingOptions->AllowConstLabel.Get(), commonLearn);
+    Preprocess(ctx->Params.LossFunctionDescription, classWeights, labelConverter, commonTest);
+    CheckTestConsistency(ctx->Params.LossFunctionDescription, commonLearn, commonTest);
+
+    TVector<TDataset> learnBranches(branchCount, commonLearn);
+    TVector<TDataset> testBranches(branchCount, commonTest);
+    for (size_t branchIdx = 0; branchIdx < branchCount; ++branchIdx) {
+        const TVector<int> ignoredFeatures = GetBranchIgnoredFeatures(
+            ctx->Params.DataProcessingOptions->IgnoredFeatures,
+            allCandidateFeatures,
+            branchIdx == 0 ? TVector<int>() : candidates[branchIdx - 1].Features
+        );
+        TVector<TDataset> testDatasets(1, testBranches[branchIdx]);
+        QuantizeTrainPools(
+            TClearablePoolPtrs(learnPool, {&testPool}),
+            floatFeatures,
+            Nothing(),
+            ignoredFeatures,
+            ctx->Params.CatFeatureParams->OneHotMaxSize,
+            ctx->Params.CatFeatureParams->OneHotMinCount,
+            /*quantizationCachePath=*/TString(),
+            ctx->LocalExecutor,
+            &learnBranches[branchIdx],
+            &testDatasets
+        );
+        testBranches[branchIdx] = std::move(testDatasets[0]);
+    }
+
+    const bool isPairwiseScoring = IsPairwiseScoring(ctx->Params.LossFunctionDescription->GetLossFunction());
+    for (size_t branchIdx = 0; branchIdx < branchCount; ++branchIdx) {
+        TLearnContext& branchCtx = *contexts[branchIdx];
+        branchCtx.InitContext(learnBranches[branchIdx], {&testBranches[branchIdx]});
+        const bool singlePrecisionDerivatives = branchCtx.Params.ObliviousTreeOptions->SinglePrecisionDerivatives.Get();
+        if (IsSamplingPerTree(branchCtx.Params.ObliviousTreeOptions.Get())) {
+            branchCtx.SmallestSplitSideDocs.Create(branchCtx.LearnProgress.Folds, isPairwiseScoring, /*sampleRate*/ 1.0f, singlePrecisionDerivatives);
+            branchCtx.PrevTreeLevelStats.Create(
+                branchCtx.LearnProgress.Folds,
+                CountNonCtrBuckets(CountSplits(branchCtx.LearnProgress.FloatFeatures), learnBranches[branchIdx].AllFeatures.OneHotValues),
+                static_cast<int>(branchCtx.Params.ObliviousTreeOptions->MaxDepth)
+            );
+        }
+        branchCtx.SampledDocs.Create(
+            branchCtx.LearnProgress.Folds,
+            isPairwiseScoring,
+            GetBernoulliSampleRate(branchCtx.Params.ObliviousTreeOptions->BootstrapConfig),
+            singlePrecisionDerivatives
+        );
+        const float candidatePruningSampleRate = branchCtx.Params.ObliviousTreeOptions->CandidatePruningSampleRate;
+        if (candidatePruningSampleRate > 0) {
+            branchCtx.PruningSampledDocs.Create(
+                branchCtx.LearnProgress.Folds,
+                isPairwiseScoring,
+                candidatePruningSampleRate * GetBernoulliSampleRate(branchCtx.Params.ObliviousTreeOptions->BootstrapConfig),
+                singlePrecisionDerivatives
+            );
+        }
+    }
+
+    const size_t overfittingDetectorMetricIdx =
+        ctx->Params.MetricOptions->EvalMetric.IsSet() ? 0 : (metrics.size() - 1);
+
+    auto trainIteration = [&](size_t branchIdx) {
+        TLearnContext* branchCtx = contexts[branchIdx].Get();
+        branchCtx->Profile.StartNextIteration();
+        TrainOneIteration(learnBranches[branchIdx], &testBranches[branchIdx], branchCtx);
+        // metrics are evaluated every iteration: the per-iteration test values
+        // of the continuation are the paired samples for the significance test
+        CalcErrors(
+            learnBranches[branchIdx],
+            {&testBranches[branchIdx]},
+            metrics,
+            /*calcMetrics=*/true,
+            overfittingDetectorMetricIdx,
+            branchCtx
+        );
+        branchCtx->Profile.FinishIteration();
+    };
+
+    MATRIXNET_NOTICE_LOG << "Training shared baseline prefix: " << baselineIterationCount << " iterations" << Endl;
+    for (ui32 iteration = 0; iteration < baselineIterationCount; ++iteration) {
+        trainIteration(/*branchIdx=*/0);
+    }
+
+    // branch the baseline before its own continuation mutates it
+    for (size_t branchIdx = 1; branchIdx < branchCount; ++branchIdx) {
+        contexts[branchIdx]->LearnProgress = ctx->LearnProgress;
+        contexts[branchIdx]->Rand = ctx->Rand; // identical rng state keeps continuations comparable
+    }
+
+    for (size_t branchIdx = 0; branchIdx < branchCount; ++branchIdx) {
+        MATRIXNET_NOTICE_LOG << "Training continuation for "
+            << (branchIdx == 0 ? "baseline" : candidates[branchIdx - 1].Name)
+            << ": " << (iterationCount - baselineIterationCount) << " iterations" << Endl;
+        for (ui32 iteration = baselineIterationCount; iteration < iterationCount; ++iteration) {
+            trainIteration(branchIdx);
+        }
+    }
+
+    const int primaryMetricIdx = 0;
+    auto getContinuationTestMetrics = [&](size_t branchIdx) {
+        const auto& history = contexts[branchIdx]->LearnProgress.MetricsAndTimeHistory.TestMetricsHistory;
+        TVector<double> values;
+        values.reserve(iterationCount - baselineIterationCount);
+        for (size_t iteration = baselineIterationCount; iteration < history.size(); ++iteration) {
+            values.push_back(history[iteration][0][primaryMetricIdx]);
+        }
+        return values;
+    };
+
+    const TVector<double> baselineMetrics = getContinuationTestMetrics(/*branchIdx=*/0);
+    results->clear();
+    results->reserve(candidates.size());
+    for (size_t candidateIdx = 0; candidateIdx < candidates.size(); ++candidateIdx) {
+        const TVector<double> candidateMetrics = getContinuationTestMetrics(candidateIdx + 1);
+        TFeatureEvaluationResult result;
+        result.Name = candidates[candidateIdx].Name;
+        result.BaselineMetric = baselineMetrics.back();
+        result.CandidateMetric = candidateMetrics.back();
+        result.WxTest = WxTest(baselineMetrics, candidateMetrics);
+        MATRIXNET_NOTICE_LOG << result.Name << ": " << metrics[primaryMetricIdx]->GetDescription()
+            << " " << result.BaselineMetric << " -> " << result.CandidateMetric
+            << ", wx-test p-value " << result.WxTest.PValue << Endl;
+        results->push_back(result);
+    }
+}
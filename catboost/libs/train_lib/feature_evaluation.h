@@ -0,0 +1,49 @@
+#pragma once
+
+#include <catboost/libs/data/pool.h>
+#include <catboost/libs/helpers/wx_test.h>
+#include <catboost/libs/metrics/metric.h>
+
+#include <library/json/json_reader.h>
+
+#include <util/generic/maybe.h>
+#include <util/generic/string.h>
+#include <util/generic/vector.h>
+
+struct TCandidateFeatureSet {
+    TString Name;
+    TVector<int> Features; // flat feature indices enabled on top of the common set
+};
+
+struct TFeatureEvaluationResult {
+    TString Name;
+    double BaselineMetric = 0.0;  // final test value of the primary metric, common features only
+    double CandidateMetric = 0.0; // final test value with the candidate set enabled
+    TWxTestResult WxTest;         // paired over the per-iteration test metrics of the continuation
+};
+
+/*
+ * Screens candidate features by prefix-shared with/without training instead of
+ * training every variant from scratch. A baseline is trained on the common
+ * feature set (all candidate features ignored) for baselineIterationCount
+ * iterations; its learn progress - trees, approxes and fold state - is then
+ * branched per candidate set, and every branch (including a common-features
+ * baseline branch) continues to the full iteration count with identical rng
+ * state. Only the continuation is trained per candidate, so screening cost
+ * drops by the shared prefix length.
+ *
+ * Per candidate the result reports the final test value of the primary metric
+ * for the baseline and candidate branches, plus a Wilcoxon signed-rank test
+ * over their per-iteration test metrics of the continuation window. The
+ * overfitting detector is deliberately off: every branch trains the same
+ * number of trees, so the deltas compare equal-sized models.
+ */
+void EvaluateFeatures(
+    const NJson::TJsonValue& plainJsonParams,
+    const TMaybe<TCustomObjectiveDescriptor>& objectiveDescriptor,
+    const TMaybe<TCustomMetricDescriptor>& evalMetricDescriptor,
+    const TVector<TCandidateFeatureSet>& candidates,
+    ui32 baselineIterationCount,
+    TPool& learnPool,
+    TPool& testPool,
+    TVector<TFeatureEvaluationResult>* results);
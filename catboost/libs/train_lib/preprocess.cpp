@@ -107,6 +107,10 @@ void Preprocess(const NCatboostOptions::TLossDescription& lossDescription,
     if (!classWeights.empty()) {
         // TODO(annaveronika): check class weight not negative.
         int dataSize = data.Target.ysize();
+        if (data.Weights.empty()) {
+            // trivial weights are stored as an empty vector; class weights make them real
+            data.Weights.resize(dataSize, 1.0f);
+        }
         for (int i = 0; i < dataSize; ++i) {
             CB_ENSURE(data.Target[i] < classWeights.ysize(), "class " + ToString(data.Target[i]) + " is missing in class weights");
             data.Weights[i] *= classWeights[data.Target[i]];
@@ -127,13 +131,15 @@ void CheckLearnConsistency(
 
     CheckTrainBaseline(lossDescription.GetLossFunction(), learnData.Baseline);
 
-    TMinMax<float> weightBounds = CalcMinMax(learnData.Weights);
-    CB_ENSURE(weightBounds.Min >= 0, "Has negative weight: " + ToString(weightBounds.Min));
-    CB_ENSURE(weightBounds.Max > 0, "All weights are 0");
+    if (!learnData.Weights.empty()) { // empty means trivial all-ones weights
+        TMinMax<float> weightBounds = CalcMinMax(learnData.Weights);
+        CB_ENSURE(weightBounds.Min >= 0, "Has negative weight: " + ToString(weightBounds.Min));
+        CB_ENSURE(weightBounds.Max > 0, "All weights are 0");
 
-    if (IsPairwiseError(lossDescription.GetLossFunction())) {
-        if (weightBounds.Min != weightBounds.Max && !learnData.HasGroupWeight) {
-            MATRIXNET_WARNING_LOG << "Pairwise losses don't support document weights. They will be ignored in optimization. If a custom metric is specified then they will be used for custom metric calculation." << Endl;
+        if (IsPairwiseError(lossDescription.GetLossFunction())) {
+            if (weightBounds.Min != weightBounds.Max && !learnData.HasGroupWeight) {
+                MATRIXNET_WARNING_LOG << "Pairwise losses don't support document weights. They will be ignored in optimization. If a custom metric is specified then they will be used for custom metric calculation." << Endl;
+            }
         }
     }
 
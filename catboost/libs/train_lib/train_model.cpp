@@ -6,11 +6,17 @@
 #include <catboost/libs/options/system_options.h>
 #include <catboost/libs/algo/train.h>
 #include <catboost/libs/algo/helpers.h>
+#include <catboost/libs/algo/index_calcer.h>
+#include <catboost/libs/algo/objective_plugin.h>
+#include <catboost/libs/algo/online_ctr.h>
 #include <catboost/libs/distributed/master.h>
 #include <catboost/libs/distributed/worker.h>
 #include <catboost/libs/helpers/permutation.h>
 #include <catboost/libs/helpers/query_info_helper.h>
 #include <catboost/libs/helpers/binarize_target.h>
+#include <catboost/libs/helpers/compensated_sum.h>
+#include <catboost/libs/logging/trace_profiler.h>
+#include <catboost/libs/helpers/interrupt.h>
 #include <catboost/libs/helpers/pairs_util.h>
 #include <catboost/libs/model/ctr_data.h>
 #include <catboost/libs/model/model_build_helper.h>
@@ -20,7 +26,10 @@
 #include <catboost/libs/algo/cv_data_partition.h>
 #include <catboost/libs/data/load_data.h>
 #include <catboost/libs/eval_result/eval_helpers.h>
+#include <catboost/libs/helpers/alloc_profiler.h>
 #include <catboost/libs/helpers/mem_usage.h>
+#include <catboost/libs/helpers/huge_pages.h>
+#include <catboost/libs/helpers/numa_helpers.h>
 #include <catboost/libs/helpers/vector_helpers.h>
 #include <catboost/libs/logging/profile_info.h>
 #include <catboost/libs/loggers/logger.h>
@@ -29,7 +38,10 @@
 
 #include <library/grid_creator/binarization.h>
 #include <library/json/json_prettifier.h>
+#include <library/json/json_writer.h>
+#include <library/threading/future/async.h>
 #include <util/random/shuffle.h>
+#include <util/generic/maybe.h>
 #include <util/generic/vector.h>
 #include <util/generic/ymath.h>
 #include <util/system/info.h>
@@ -39,6 +51,125 @@ namespace {
 void ShrinkModel(int itCount, TLearnProgress* progress) {
     progress->LeafValues.resize(itCount);
     progress->TreeStruct.resize(itCount);
+    progress->TreeStats.resize(itCount);
+}
+
+// Refresh the per-subsystem memory tags and log the breakdown; called every
+// metric period so attribution is available before an out-of-memory death.
+void UpdateMemoryUsageStats(TLearnContext* ctx, int iteration) {
+    size_t foldBytes = 0;
+    size_t ctrBytes = 0;
+    for (const auto& fold : ctx->LearnProgress.Folds) {
+        foldBytes += fold.EstimateBytesUsed();
+        ctrBytes += fold.EstimateCtrBytesUsed();
+    }
+    foldBytes += ctx->LearnProgress.AveragingFold.EstimateBytesUsed();
+    ctrBytes += ctx->LearnProgress.AveragingFold.EstimateCtrBytesUsed();
+
+    size_t modelBytes = ctx->LearnProgress.TreeStruct.capacity() * sizeof(TSplitTree);
+    for (const auto& treeLeafValues : ctx->LearnProgress.LeafValues) {
+        for (const auto& dim : treeLeafValues) {
+            modelBytes += dim.capacity() * sizeof(double);
+        }
+    }
+
+    auto& tracker = MemoryUsageTracker();
+    tracker.Set("fold_storage", foldBytes);
+    tracker.Set("ctr_tables", ctrBytes);
+    tracker.Set("bucket_stats_cache", ctx->PrevTreeLevelStats.GetBytesUsed());
+    tracker.Set("model", modelBytes);
+    if (ctx->Params.SystemOptions->HugePages) {
+        // page composition: how much of the advised memory the kernel actually collapsed
+        tracker.Set("anon_huge_pages", NCB::GetAnonHugePageBytes());
+    }
+    tracker.LogState(iteration);
+    LogAllocationProfile();
+}
+
+// Evict the recomputable caches when RSS nears the used_ram_limit budget
+// instead of letting the process be killed mid-training. Bucket stats and
+// online CTR tables are rebuilt on demand, so eviction costs time, not
+// correctness.
+void EnforceMemoryBudget(TLearnContext* ctx) {
+    const ui64 memoryBudget = ParseMemorySizeDescription(ctx->Params.SystemOptions->CpuUsedRamLimit.Get());
+    if (memoryBudget == Max<ui64>()) {
+        return;
+    }
+    const ui64 currentRss = MemoryUsageTracker().UpdatePeakRss();
+    if (currentRss < memoryBudget / 10 * 9) {
+        return;
+    }
+    MATRIXNET_WARNING_LOG << "Memory budget almost exhausted (rss " << (currentRss >> 20)
+        << "MB, budget " << (memoryBudget >> 20)
+        << "MB), dropping bucket stats cache and online CTR tables" << Endl;
+    ctx->PrevTreeLevelStats.Reset();
+    for (auto& fold : ctx->LearnProgress.Folds) {
+        fold.DropAllOnlineCtrs();
+    }
+    ctx->LearnProgress.AveragingFold.DropAllOnlineCtrs();
+}
+
+// LRU eviction of cached online CTR tables down to the ctr_table_memory_limit
+// budget. The budget is split evenly between the training folds and the
+// averaging fold; evicted projections are recomputed on the next lookup.
+void EnforceCtrTableMemoryLimit(TLearnContext* ctx) {
+    const TString& limitDescription = ctx->Params.CatFeatureParams->CtrTableMemoryLimit.GetUnchecked();
+    if (limitDescription.empty()) {
+        return;
+    }
+    const ui64 memoryLimit = ParseMemorySizeDescription(limitDescription);
+    if (memoryLimit == Max<ui64>()) {
+        return;
+    }
+    const ui64 perFoldLimit = memoryLimit / (ctx->LearnProgress.Folds.size() + 1);
+    for (auto& fold : ctx->LearnProgress.Folds) {
+        fold.EnforceCtrMemoryLimit(perFoldLimit);
+    }
+    ctx->LearnProgress.AveragingFold.EnforceCtrMemoryLimit(perFoldLimit);
+}
+
+// Applies the trees not yet reflected in TestApprox to the test approx vectors.
+// With lazy_test_approx the iterations train on an empty test set, so the online CTR
+// and index structures never cover the test documents; they are rebuilt here for the
+// pending trees only, on the averaging fold, right before metrics are computed.
+void MaterializeLazyTestApprox(const TDataset& learnData, const TDatasetPtrs& testDataPtrs, TLearnContext* ctx) {
+    const size_t treeCount = ctx->LearnProgress.TreeStruct.size();
+    const size_t learnSampleCount = learnData.GetSampleCount();
+    const size_t totalSampleCount = learnSampleCount + GetSampleCount(testDataPtrs);
+    const TVector<size_t> testOffsets = CalcTestOffsets(learnSampleCount, testDataPtrs);
+    TFold& fold = ctx->LearnProgress.AveragingFold;
+    for (size_t treeIdx = ctx->LearnProgress.TestApproxTreeCount; treeIdx < treeCount; ++treeIdx) {
+        const TSplitTree& tree = ctx->LearnProgress.TreeStruct[treeIdx];
+        for (const auto& split : tree.Splits) {
+            if (split.Type != ESplitType::OnlineCtr) {
+                continue;
+            }
+            const TProjection& proj = split.Ctr.Projection;
+            TOnlineCTR& ctr = fold.GetCtrRef(proj);
+            if (ctr.Feature.empty() || ctr.Feature[0][0][0].size() < totalSampleCount) {
+                ComputeOnlineCTRs(learnData, testDataPtrs, fold, proj, ctx, &ctr, /*computeTestTails*/ true);
+            }
+        }
+        const TVector<TIndexType> indices = BuildIndices(fold, tree, learnData, testDataPtrs, &ctx->LocalExecutor);
+        const auto& treeValues = ctx->LearnProgress.LeafValues[treeIdx]; // [dim][leafId], learning rate already applied
+        for (int dim = 0; dim < treeValues.ysize(); ++dim) {
+            const double* treeValuesData = treeValues[dim].data();
+            for (int testIdx = 0; testIdx < testDataPtrs.ysize(); ++testIdx) {
+                const size_t testSampleCount = testDataPtrs[testIdx]->GetSampleCount();
+                double* testApproxData = ctx->LearnProgress.TestApprox[testIdx][dim].data();
+                const TIndexType* indicesData = indices.data() + testOffsets[testIdx];
+                ctx->LocalExecutor.ExecRange(
+                    [&](size_t docIdx) {
+                        testApproxData[docIdx] += treeValuesData[indicesData[docIdx]];
+                    },
+                    NPar::TLocalExecutor::TExecRangeParams(0, testSampleCount).SetBlockSize(1000),
+                    NPar::TLocalExecutor::WAIT_COMPLETE
+                );
+            }
+        }
+        CheckInterrupted(); // check after long-lasting operation
+    }
+    ctx->LearnProgress.TestApproxTreeCount = treeCount;
 }
 
 static int GetThreadCount(const NCatboostOptions::TCatBoostOptions& options) {
@@ -98,6 +229,11 @@ static void Train(
 ) {
     TProfileInfo& profile = ctx->Profile;
 
+    /* Per-iteration log lines are formatted and flushed on a writer thread for the
+     * duration of training, so a slow stdout consumer shows up as dropped verbose
+     * lines instead of iteration-time jitter. */
+    TAsyncLogOutputGuard asyncLogGuard;
+
     const int approxDimension = ctx->LearnProgress.ApproxDimension;
     const bool hasTest = GetSampleCount(testDataPtrs) > 0;
     auto trainOneIterationFunc = GetOneIterationFunc(ctx->Params.LossFunctionDescription->GetLossFunction());
@@ -119,6 +255,12 @@ static void Train(
     const bool useBestModel = ctx->OutputOptions.ShrinkModelToBestIteration();
 
     ctx->TryLoadProgress();
+    if (!ctx->Params.SystemOptions->IsSingleHost() && !ctx->LearnProgress.TreeStruct.empty()) {
+        // The workers' freshly built folds hold neutral approxes; restore each worker's
+        // locally persisted fold shard (workers without a usable shard replay the snapshot
+        // forest instead) so that resumed training continues from the checkpoint.
+        MapRestoreFoldShards(ctx);
+    }
 
     if (ctx->OutputOptions.GetMetricPeriod() > 1 && useBestModel && hasTest) {
         MATRIXNET_WARNING_LOG << "Warning: Parameter 'use_best_model' is true, thus evaluation metric is" <<
@@ -162,18 +304,27 @@ static void Train(
 
     TVector<TVector<TVector<double>>> errorsHistory = ctx->LearnProgress.MetricsAndTimeHistory.TestMetricsHistory;
     for (int iter = 0; iter < errorsHistory.ysize(); ++iter) {
-        const bool calcMetrics = DivisibleOrLastIteration(iter, errorsHistory.ysize(), ctx->OutputOptions.GetMetricPeriod());
+        bool calcMetrics = DivisibleOrLastIteration(iter, errorsHistory.ysize(), ctx->OutputOptions.GetMetricPeriod());
         const int testIdxToLog = errorsHistory[iter].size() - 1;
+        if (ctx->Params.BoostingOptions->EvalTimeFraction.Get() > 0) {
+            // Under an adaptive metric period the record shape, not the static period,
+            // tells which snapshot iterations were true evaluations.
+            calcMetrics = errorsHistory[iter][testIdxToLog].ysize() > 1 || metrics.ysize() == 1;
+        }
         const int metricIdxToLog = calcMetrics ? overfittingDetectorMetricIdx : 0;
         overfittingDetectorErrorTracker.AddError(errorsHistory[iter][testIdxToLog][metricIdxToLog], iter);
         if (calcMetrics) {
             bestModelErrorTracker.AddError(errorsHistory[iter][testIdxToLog][metricIdxToLog], iter);
+            if (useBestModel && iter == bestModelErrorTracker.GetBestIteration()) {
+                ctx->LearnProgress.BestModelTreeCount = iter + 1;
+            }
         }
     }
 
     const bool isPairwiseScoring = IsPairwiseScoring(ctx->Params.LossFunctionDescription->GetLossFunction());
+    const bool singlePrecisionDerivatives = ctx->Params.ObliviousTreeOptions->SinglePrecisionDerivatives.Get();
     if (IsSamplingPerTree(ctx->Params.ObliviousTreeOptions.Get())) {
-        ctx->SmallestSplitSideDocs.Create(ctx->LearnProgress.Folds, isPairwiseScoring);
+        ctx->SmallestSplitSideDocs.Create(ctx->LearnProgress.Folds, isPairwiseScoring, /*sampleRate*/ 1.0f, singlePrecisionDerivatives);
         ctx->PrevTreeLevelStats.Create(
             ctx->LearnProgress.Folds,
             CountNonCtrBuckets(CountSplits(ctx->LearnProgress.FloatFeatures), learnData.AllFeatures.OneHotValues),
@@ -183,36 +334,212 @@ static void Train(
     ctx->SampledDocs.Create(
         ctx->LearnProgress.Folds,
         isPairwiseScoring,
-        GetBernoulliSampleRate(ctx->Params.ObliviousTreeOptions->BootstrapConfig)
+        GetBernoulliSampleRate(ctx->Params.ObliviousTreeOptions->BootstrapConfig),
+        singlePrecisionDerivatives
     ); // TODO(espetrov): create only if sample rate < 1
+    const float candidatePruningSampleRate = ctx->Params.ObliviousTreeOptions->CandidatePruningSampleRate;
+    if (candidatePruningSampleRate > 0) {
+        ctx->PruningSampledDocs.Create(
+            ctx->LearnProgress.Folds,
+            isPairwiseScoring,
+            candidatePruningSampleRate * GetBernoulliSampleRate(ctx->Params.ObliviousTreeOptions->BootstrapConfig),
+            singlePrecisionDerivatives
+        );
+    }
+
+    // With async_metrics the metrics for iteration i are evaluated on approx snapshots by a
+    // background thread while iteration i + 1 trains; the error trackers, loggers and progress
+    // saving consume the results one iteration late, so the overfitting detector stops with at
+    // most one extra iteration trained.
+    const bool asyncMetrics = ctx->Params.BoostingOptions->AsyncMetrics.Get() && ctx->Params.SystemOptions->IsSingleHost();
+
+    // With lazy_test_approx the iterations train as if there were no test sets and the
+    // accumulated trees are applied to the test approxes in one batch per metric period,
+    // so the per-document ctr and index structures cover only the learn documents
+    // between metric calculations.
+    const bool lazyTestApprox = ctx->Params.BoostingOptions->LazyTestApprox.Get() &&
+        hasTest &&
+        ctx->Params.SystemOptions->IsSingleHost() &&
+        ctx->OutputOptions.GetMetricPeriod() > 1;
+    const TDatasetPtrs emptyTestDataPtrs;
+    TMtpQueue metricsQueue;
+    if (asyncMetrics) {
+        metricsQueue.Start(1);
+    }
+
+    // With eval_time_fraction the effective metric period is tuned online so that the
+    // "Calc errors" share of wall time stays below the requested fraction; the cost model
+    // is rebuilt from the profiler's per-operation times after each iteration. Between
+    // true evaluations the history gets the value from the last evaluation, so it keeps
+    // one record per iteration and the overfitting detector keeps counting iterations.
+    // With async_metrics evaluation is already off the critical path, so nothing to tune.
+    const float evalTimeFraction = ctx->Params.BoostingOptions->EvalTimeFraction.Get();
+    const bool adaptiveEvalPeriod = evalTimeFraction > 0 && hasTest && !asyncMetrics;
+    const int minEvalPeriod = Max(1, ctx->OutputOptions.GetMetricPeriod());
+    int maxEvalPeriod = Max<int>(minEvalPeriod, ctx->Params.BoostingOptions->IterationCount.Get() / 10);
+    const auto& odOptions = ctx->Params.BoostingOptions->OverfittingDetector.Get();
+    if (adaptiveEvalPeriod &&
+        (odOptions.AutoStopPValue.Get() > 0 ||
+         odOptions.OverfittingDetectorType.Get() == EOverfittingDetectorType::Iter)) {
+        // Held values never improve on the detector's best, so a period comparable to the
+        // detector's wait would let the holds alone run the wait counter out.
+        maxEvalPeriod = Min(maxEvalPeriod, Max(minEvalPeriod, odOptions.IterationsWait.Get() / 4));
+    }
+    int evalPeriod = minEvalPeriod;
+    ui32 nextEvalIter = ctx->LearnProgress.TreeStruct.ysize();
+    double smoothedEvalTime = 0;
+    double smoothedTrainTime = 0;
+    TVector<double> heldOdtErrors; // per test set, from the last true evaluation
+
+    struct TPendingMetrics {
+        ui32 Iter = 0;
+        bool CalcMetrics = false;
+        TVector<TVector<double>> AvrgApproxSnapshot;
+        TVector<TVector<TVector<double>>> TestApproxSnapshot;
+        TMaybe<TProfileResults> ProfileResults;
+        NThreading::TFuture<void> Future;
+    };
+    THolder<TPendingMetrics> pendingMetrics;
+
+    auto consumePendingMetrics = [&]() {
+        if (!pendingMetrics) {
+            return;
+        }
+        pendingMetrics->Future.GetValueSync();
+        if (hasTest) {
+            const auto testErrors = ctx->LearnProgress.MetricsAndTimeHistory.TestMetricsHistory.back();
+            // Use only (last_test, last_metric) for overfitting detection
+            const int testIdxToLog = testErrors.size() - 1;
+            const int metricIdxToLog = pendingMetrics->CalcMetrics ? overfittingDetectorMetricIdx : 0;
+
+            overfittingDetectorErrorTracker.AddError(testErrors[testIdxToLog][metricIdxToLog], pendingMetrics->Iter);
+            if (pendingMetrics->CalcMetrics) {
+                bestModelErrorTracker.AddError(testErrors[testIdxToLog][metricIdxToLog], pendingMetrics->Iter);
+                if (useBestModel && pendingMetrics->Iter == static_cast<ui32>(bestModelErrorTracker.GetBestIteration())) {
+                    ctx->LearnProgress.BestTestApprox = pendingMetrics->TestApproxSnapshot[0];
+                    ctx->LearnProgress.BestModelTreeCount = pendingMetrics->Iter + 1;
+                }
+            }
+        }
+        Log(
+            GetMetricsDescription(metrics),
+            GetSkipMetricOnTrain(metrics),
+            ctx->LearnProgress.MetricsAndTimeHistory.LearnMetricsHistory,
+            ctx->LearnProgress.MetricsAndTimeHistory.TestMetricsHistory,
+            bestModelErrorTracker.GetBestError(),
+            bestModelErrorTracker.GetBestIteration(),
+            *pendingMetrics->ProfileResults,
+            learnToken,
+            testTokens,
+            pendingMetrics->CalcMetrics,
+            &logger
+        );
+        ctx->SaveProgress();
+        if (!ctx->Params.SystemOptions->IsSingleHost()) {
+            MapSaveFoldShards(ctx);
+        }
+        pendingMetrics.Destroy();
+    };
 
     for (ui32 iter = ctx->LearnProgress.TreeStruct.ysize(); iter < ctx->Params.BoostingOptions->IterationCount; ++iter) {
         profile.StartNextIteration();
 
-        trainOneIterationFunc(learnData, testDataPtrs, ctx);
+        trainOneIterationFunc(learnData, lazyTestApprox ? emptyTestDataPtrs : testDataPtrs, ctx);
+        if (!lazyTestApprox) {
+            ctx->LearnProgress.TestApproxTreeCount = ctx->LearnProgress.TreeStruct.size();
+        }
+
+        // The metrics of the previous iteration were computing while this iteration trained.
+        consumePendingMetrics();
 
         bool calcMetrics = DivisibleOrLastIteration(
             iter,
             ctx->Params.BoostingOptions->IterationCount,
             ctx->OutputOptions.GetMetricPeriod()
         );
+        if (adaptiveEvalPeriod) {
+            // A true evaluation always computes all metrics, so the static metric period
+            // only sets the floor of the adaptive one.
+            calcMetrics = iter >= nextEvalIter || iter + 1 == ctx->Params.BoostingOptions->IterationCount;
+        }
 
-        CalcErrors(learnData, testDataPtrs, metrics, calcMetrics, overfittingDetectorMetricIdx, ctx);
+        if (calcMetrics) {
+            UpdateMemoryUsageStats(ctx, static_cast<int>(iter));
+            MATRIXNET_DEBUG_LOG << "Online CTR cache: " << AtomicGet(ctx->CtrCacheHits) << " hits, "
+                << AtomicGet(ctx->CtrCacheMisses) << " misses" << Endl;
+        }
+        EnforceCtrTableMemoryLimit(ctx);
+        EnforceMemoryBudget(ctx);
 
-        profile.AddOperation("Calc errors");
-        if (hasTest) {
-            const auto testErrors = ctx->LearnProgress.MetricsAndTimeHistory.TestMetricsHistory.back();
-            // Use only (last_test, last_metric) for overfitting detection
-            const int testIdxToLog = testErrors.size() - 1;
-            const int metricIdxToLog = calcMetrics ? overfittingDetectorMetricIdx : 0;
+        if (lazyTestApprox && calcMetrics) {
+            MaterializeLazyTestApprox(learnData, testDataPtrs, ctx);
+            profile.AddOperation("Materialize lazy test approx");
+        }
 
-            overfittingDetectorErrorTracker.AddError(testErrors[testIdxToLog][metricIdxToLog], iter);
-            if (calcMetrics) {
-                bestModelErrorTracker.AddError(testErrors[testIdxToLog][metricIdxToLog], iter);
-                if (useBestModel && iter == static_cast<ui32>(bestModelErrorTracker.GetBestIteration())) {
-                    ctx->LearnProgress.BestTestApprox = ctx->LearnProgress.TestApprox[0];
+        if (asyncMetrics) {
+            pendingMetrics = new TPendingMetrics;
+            pendingMetrics->Iter = iter;
+            pendingMetrics->CalcMetrics = calcMetrics;
+            pendingMetrics->AvrgApproxSnapshot = ctx->LearnProgress.AvrgApprox;
+            pendingMetrics->TestApproxSnapshot = ctx->LearnProgress.TestApprox;
+            TPendingMetrics* pending = pendingMetrics.Get();
+            pendingMetrics->Future = NThreading::Async(
+                [pending, &learnData, &testDataPtrs, &metrics, calcMetrics, overfittingDetectorMetricIdx, ctx]() {
+                    CalcErrors(
+                        learnData,
+                        testDataPtrs,
+                        pending->AvrgApproxSnapshot,
+                        pending->TestApproxSnapshot,
+                        metrics,
+                        calcMetrics,
+                        overfittingDetectorMetricIdx,
+                        ctx
+                    );
+                },
+                metricsQueue
+            );
+            profile.AddOperation("Start async calc errors");
+        } else if (!adaptiveEvalPeriod || calcMetrics) {
+            CalcErrors(learnData, testDataPtrs, metrics, calcMetrics, overfittingDetectorMetricIdx, ctx);
+
+            profile.AddOperation("Calc errors");
+            if (hasTest) {
+                const auto testErrors = ctx->LearnProgress.MetricsAndTimeHistory.TestMetricsHistory.back();
+                // Use only (last_test, last_metric) for overfitting detection
+                const int testIdxToLog = testErrors.size() - 1;
+                const int metricIdxToLog = calcMetrics ? overfittingDetectorMetricIdx : 0;
+
+                overfittingDetectorErrorTracker.AddError(testErrors[testIdxToLog][metricIdxToLog], iter);
+                if (calcMetrics) {
+                    bestModelErrorTracker.AddError(testErrors[testIdxToLog][metricIdxToLog], iter);
+                    if (useBestModel && iter == static_cast<ui32>(bestModelErrorTracker.GetBestIteration())) {
+                        ctx->LearnProgress.BestTestApprox = ctx->LearnProgress.TestApprox[0];
+                        ctx->LearnProgress.BestModelTreeCount = iter + 1;
+                    }
+                }
+                if (adaptiveEvalPeriod) {
+                    heldOdtErrors.clear();
+                    for (const auto& metricValues : testErrors) {
+                        heldOdtErrors.push_back(metricValues.empty() ? 0 : metricValues[overfittingDetectorMetricIdx]);
+                    }
                 }
             }
+        } else {
+            // Evaluation skipped by the adaptive period: append the held values in the
+            // same shape CalcErrors would have used for a non-metric iteration, so the
+            // history keeps one record per iteration and its consumers stay unchanged.
+            if (learnData.GetSampleCount() > 0) {
+                ctx->LearnProgress.MetricsAndTimeHistory.LearnMetricsHistory.emplace_back();
+            }
+            ctx->LearnProgress.MetricsAndTimeHistory.TestMetricsHistory.emplace_back();
+            auto& testMetricErrors = ctx->LearnProgress.MetricsAndTimeHistory.TestMetricsHistory.back();
+            for (size_t testIdx = 0; testIdx < testDataPtrs.size(); ++testIdx) {
+                testMetricErrors.emplace_back();
+                if (testDataPtrs[testIdx] != nullptr && testDataPtrs[testIdx]->GetSampleCount() > 0) {
+                    testMetricErrors.back().push_back(heldOdtErrors[testIdx]);
+                }
+            }
+            overfittingDetectorErrorTracker.AddError(heldOdtErrors.back(), iter);
         }
 
         profile.FinishIteration();
@@ -220,21 +547,54 @@ static void Train(
         TProfileResults profileResults = profile.GetProfileResults();
         ctx->LearnProgress.MetricsAndTimeHistory.TimeHistory.push_back({profileResults.PassedTime, profileResults.RemainingTime});
 
-        Log(
-            GetMetricsDescription(metrics),
-            GetSkipMetricOnTrain(metrics),
-            ctx->LearnProgress.MetricsAndTimeHistory.LearnMetricsHistory,
-            ctx->LearnProgress.MetricsAndTimeHistory.TestMetricsHistory,
-            bestModelErrorTracker.GetBestError(),
-            bestModelErrorTracker.GetBestIteration(),
-            profileResults,
-            learnToken,
-            testTokens,
-            calcMetrics,
-            &logger
-        );
+        if (adaptiveEvalPeriod) {
+            // Light exponential smoothing is enough: both costs drift slowly as the
+            // forest grows, and a spike should not swing the period by itself.
+            const double* calcErrorsTime = profileResults.OperationToTime.FindPtr("Calc errors");
+            const double evalTime = calcErrorsTime != nullptr ? *calcErrorsTime : 0;
+            const double trainTime = Max(profileResults.CurrentTime - evalTime, 0.0);
+            smoothedTrainTime = smoothedTrainTime > 0 ? 0.75 * smoothedTrainTime + 0.25 * trainTime : trainTime;
+            if (calcMetrics) {
+                smoothedEvalTime = smoothedEvalTime > 0 ? 0.75 * smoothedEvalTime + 0.25 * evalTime : evalTime;
+                if (smoothedTrainTime > 0) {
+                    // One evaluation per period iterations costs a fraction
+                    // e / (e + p * t) of wall time; solve it for p against the budget.
+                    const double targetPeriod =
+                        smoothedEvalTime * (1.0 - evalTimeFraction) / (evalTimeFraction * smoothedTrainTime);
+                    const int newPeriod = Min(Max(static_cast<int>(ceil(targetPeriod)), minEvalPeriod), maxEvalPeriod);
+                    if (newPeriod != evalPeriod) {
+                        MATRIXNET_DEBUG_LOG << "Adaptive metric period: " << evalPeriod << " -> " << newPeriod
+                            << " (eval " << FloatToString(smoothedEvalTime, PREC_NDIGITS, 3)
+                            << " sec, iteration " << FloatToString(smoothedTrainTime, PREC_NDIGITS, 3) << " sec)" << Endl;
+                        evalPeriod = newPeriod;
+                    }
+                }
+                nextEvalIter = iter + evalPeriod;
+            }
+        }
 
-        ctx->SaveProgress();
+        if (asyncMetrics) {
+            pendingMetrics->ProfileResults = profileResults;
+        } else {
+            Log(
+                GetMetricsDescription(metrics),
+                GetSkipMetricOnTrain(metrics),
+                ctx->LearnProgress.MetricsAndTimeHistory.LearnMetricsHistory,
+                ctx->LearnProgress.MetricsAndTimeHistory.TestMetricsHistory,
+                bestModelErrorTracker.GetBestError(),
+                bestModelErrorTracker.GetBestIteration(),
+                profileResults,
+                learnToken,
+                testTokens,
+                calcMetrics,
+                &logger
+            );
+
+            ctx->SaveProgress();
+            if (!ctx->Params.SystemOptions->IsSingleHost()) {
+                MapSaveFoldShards(ctx);
+            }
+        }
 
         if (HasInvalidValues(ctx->LearnProgress.LeafValues)) {
             ctx->LearnProgress.LeafValues.pop_back();
@@ -251,6 +611,13 @@ static void Train(
         }
     }
 
+    consumePendingMetrics();
+
+    if (lazyTestApprox) {
+        // An early stop can land between metric calculations; apply the remaining trees.
+        MaterializeLazyTestApprox(learnData, testDataPtrs, ctx);
+    }
+
     if (hasTest) {
         (*testMultiApprox) = ctx->LearnProgress.TestApprox;
         if (useBestModel) {
@@ -260,6 +627,23 @@ static void Train(
 
     ctx->LearnProgress.Folds.clear();
 
+    if (!ctx->LearnProgress.FeatureChosenCount.empty()) {
+        const auto& featureIds = ctx->Layout.GetExternalFeatureIds();
+        size_t chosenFeatureCount = 0;
+        for (ui64 chosenCount : ctx->LearnProgress.FeatureChosenCount) {
+            chosenFeatureCount += chosenCount > 0;
+        }
+        MATRIXNET_INFO_LOG << "Split selection: " << chosenFeatureCount << " of "
+            << ctx->LearnProgress.FeatureChosenCount.size() << " features won at least one split" << Endl;
+        for (size_t featureIdx = 0; featureIdx < ctx->LearnProgress.FeatureChosenCount.size(); ++featureIdx) {
+            MATRIXNET_DEBUG_LOG << "feature " << featureIdx
+                << (featureIdx < featureIds.size() && !featureIds[featureIdx].empty() ? " (" + featureIds[featureIdx] + ")" : "")
+                << ": candidates=" << ctx->LearnProgress.FeatureCandidateCount[featureIdx]
+                << " chosen=" << ctx->LearnProgress.FeatureChosenCount[featureIdx]
+                << " lastChosenIter=" << ctx->LearnProgress.FeatureLastChosenIteration[featureIdx] << Endl;
+        }
+    }
+
     if (hasTest) {
         MATRIXNET_NOTICE_LOG << "\n";
         MATRIXNET_NOTICE_LOG << "bestTest = " << bestModelErrorTracker.GetBestError() << "\n";
@@ -268,7 +652,10 @@ static void Train(
     }
 
     if (useBestModel && ctx->Params.BoostingOptions->IterationCount > 0) {
-        const int itCount = bestModelErrorTracker.GetBestIteration() + 1;
+        // The best prefix was tracked online, so this is a plain truncation: no metric
+        // replay and no growth past the forest that actually exists (the last tree may
+        // have been dropped as degenerate after its metrics were recorded).
+        const int itCount = Min<int>(ctx->LearnProgress.BestModelTreeCount, ctx->LearnProgress.TreeStruct.ysize());
         MATRIXNET_NOTICE_LOG << "Shrink model to first " << itCount << " iterations." << Endl;
         ShrinkModel(itCount, &ctx->LearnProgress);
     }
@@ -330,9 +717,16 @@ class TCPUModelTrainer : public IModelTrainer {
             &updatedParams
         );
 
+        // A loss description like Custom:plugin=/path/libloss.so supplies the objective as a
+        // native shared object; an explicitly passed descriptor (Python/R bindings) wins.
+        TMaybe<TCustomObjectiveDescriptor> effectiveObjectiveDescriptor = objectiveDescriptor;
+        if (!effectiveObjectiveDescriptor.Defined()) {
+            effectiveObjectiveDescriptor = NCB::LoadObjectivePlugin(updatedParams.LossFunctionDescription);
+        }
+
         TLearnContext ctx(
             updatedParams,
-            objectiveDescriptor,
+            effectiveObjectiveDescriptor,
             evalMetricDescriptor,
             updatedOutputOptions,
             featureCount,
@@ -340,6 +734,12 @@ class TCPUModelTrainer : public IModelTrainer {
             pools.Learn->FeatureId
         );
         SetLogingLevel(ctx.Params.LoggingLevel);
+        SetCompensatedAccumulation(ctx.Params.SystemOptions->CompensatedAccumulation);
+
+        THolder<TTraceProfilerSession> traceProfilerSession;
+        if (ctx.OutputOptions.AllowWriteFiles() && !ctx.OutputOptions.GetTraceLogFilename().empty()) {
+            traceProfilerSession = MakeHolder<TTraceProfilerSession>(ctx.OutputOptions.CreateTraceLogFullPath());
+        }
 
         auto loggingGuard = Finally([&] { SetSilentLogingMode(); });
 
@@ -358,6 +758,18 @@ class TCPUModelTrainer : public IModelTrainer {
         }
 
         ELossFunction lossFunction = ctx.Params.LossFunctionDescription.Get().GetLossFunction();
+        if (!ctx.Params.ObliviousTreeOptions->MonotoneConstraints.Get().empty()) {
+            // pairwise scoring and remote score calculation bypass the constrained split evaluation
+            CB_ENSURE(!IsPairwiseScoring(lossFunction),
+                      "Monotone constraints are not supported for pairwise scoring loss functions");
+            CB_ENSURE(ctx.Params.SystemOptions->IsSingleHost(),
+                      "Monotone constraints require single host training");
+        }
+        if (IsPairLogit(lossFunction) && NCatboostOptions::IsPairResamplingEnabled(ctx.Params.LossFunctionDescription)) {
+            CB_ENSURE(
+                NCatboostOptions::GetMaxPairCount(ctx.Params.LossFunctionDescription) != NCatboostOptions::MAX_AUTOGENERATED_PAIRS_COUNT,
+                "resample_pairs requires max_pairs to bound per-iteration pair memory");
+        }
         if (IsPairLogit(lossFunction) && pools.Learn->Pairs.empty()) {
             CB_ENSURE(
                     !pools.Learn->Docs.Target.empty(),
@@ -454,19 +866,84 @@ class TCPUModelTrainer : public IModelTrainer {
 
         const auto& catFeatureParams = ctx.Params.CatFeatureParams.Get();
 
+        TVector<int> duplicateFeatureAliases;
         QuantizeTrainPools(
             pools,
             ctx.LearnProgress.FloatFeatures,
             Nothing(),
             ctx.Params.DataProcessingOptions->IgnoredFeatures,
             catFeatureParams.OneHotMaxSize,
+            catFeatureParams.OneHotMinCount,
+            ctx.Params.DataProcessingOptions->QuantizationCachePath,
             ctx.LocalExecutor,
             &learnData,
-            &testDatasets
+            &testDatasets,
+            &duplicateFeatureAliases
         );
 
+        if (NCB::GetNumaNodeCount() > 1) {
+            /* Quantization is feature-parallel, so with a first-touch policy every bin array
+             * lands wholly on one node while score calculation scans them document-parallel
+             * from all nodes. Interleave the learn bin arrays and align worker threads with
+             * the topology to bound remote-node traffic on multi-socket boxes.
+             */
+            NCB::SpreadExecutorThreadsAcrossNumaNodes(&ctx.LocalExecutor);
+            for (auto& histogram : learnData.AllFeatures.FloatHistograms) {
+                NCB::InterleaveMemoryAcrossNumaNodes(histogram.data(), histogram.size() * sizeof(ui8));
+            }
+            for (auto& remapped : learnData.AllFeatures.CatFeaturesRemapped) {
+                NCB::InterleaveMemoryAcrossNumaNodes(remapped.data(), remapped.size() * sizeof(int));
+            }
+            for (auto& bundle : learnData.AllFeatures.FeatureBundles) {
+                NCB::InterleaveMemoryAcrossNumaNodes(bundle.Bins.data(), bundle.Bins.size() * sizeof(ui8));
+            }
+            for (auto& pack : learnData.AllFeatures.FeaturePacks) {
+                NCB::InterleaveMemoryAcrossNumaNodes(pack.Bins.data(), pack.Bins.size() * sizeof(ui8));
+            }
+        }
+
+        if (ctx.Params.SystemOptions->HugePages) {
+            /* The bin columns are read with random-ish strides by the histogram gathers,
+             * so on pools of hundreds of GB the TLB working set far exceeds the 4KB-page
+             * coverage. Advise transparent 2MB pages for the learn bin arrays; the fold
+             * approx arrays get the same advice after InitContext below.
+             */
+            for (auto& histogram : learnData.AllFeatures.FloatHistograms) {
+                NCB::AdviseHugePages(histogram.data(), histogram.size() * sizeof(ui8));
+            }
+            for (auto& remapped : learnData.AllFeatures.CatFeaturesRemapped) {
+                NCB::AdviseHugePages(remapped.data(), remapped.size() * sizeof(int));
+            }
+            for (auto& bundle : learnData.AllFeatures.FeatureBundles) {
+                NCB::AdviseHugePages(bundle.Bins.data(), bundle.Bins.size() * sizeof(ui8));
+            }
+            for (auto& pack : learnData.AllFeatures.FeaturePacks) {
+                NCB::AdviseHugePages(pack.Bins.data(), pack.Bins.size() * sizeof(ui8));
+            }
+        }
+
         ctx.InitContext(learnData, testDataPtrs);
 
+        if (ctx.Params.SystemOptions->HugePages) {
+            const auto adviseFoldApproxes = [](TFold* fold) {
+                for (auto& bodyTail : fold->BodyTailArr) {
+                    for (auto& approxDim : bodyTail.Approx) {
+                        NCB::AdviseHugePages(approxDim.data(), approxDim.size() * sizeof(double));
+                    }
+                    for (auto& derDim : bodyTail.WeightedDerivatives) {
+                        NCB::AdviseHugePages(derDim.data(), derDim.size() * sizeof(double));
+                    }
+                    for (auto& derDim : bodyTail.SampleWeightedDerivatives) {
+                        NCB::AdviseHugePages(derDim.data(), derDim.size() * sizeof(double));
+                    }
+                }
+            };
+            for (auto& fold : ctx.LearnProgress.Folds) {
+                adviseFoldApproxes(&fold);
+            }
+            adviseFoldApproxes(&ctx.LearnProgress.AveragingFold);
+        }
+
         ctx.LearnProgress.CatFeatures.resize(sortedCatFeatures.size());
         for (size_t i = 0; i < sortedCatFeatures.size(); ++i) {
             auto& catFeature = ctx.LearnProgress.CatFeatures[i];
@@ -483,7 +960,19 @@ class TCPUModelTrainer : public IModelTrainer {
         if (!systemOptions->IsSingleHost()) { // send target, weights, baseline (if present), binarized features to workers and ask them to create plain folds
             InitializeMaster(&ctx);
             CB_ENSURE(IsPlainMode(ctx.Params.BoostingOptions->BoostingType), "Distributed training requires plain boosting");
-            CB_ENSURE(pools.Learn->CatFeatures.empty(), "Distributed training requires all numeric data");
+            /* One-hot categorical features need no online CTR state, so the workers can score
+             * them from the binarized columns they already receive. CTR-based features keep
+             * counters that are sequential in the learn permutation and so far live only on
+             * a single host.
+             */
+            bool hasCtrCatFeatures = false;
+            for (int catIdx = 0; catIdx < learnData.AllFeatures.CatFeaturesRemapped.ysize(); ++catIdx) {
+                if (!learnData.AllFeatures.CatFeaturesRemapped[catIdx].empty() && !learnData.AllFeatures.IsOneHot[catIdx]) {
+                    hasCtrCatFeatures = true;
+                    break;
+                }
+            }
+            CB_ENSURE(!hasCtrCatFeatures, "Distributed training supports only numeric and one-hot categorical features (value count <= one_hot_max_size); CTR-based features require single host mode");
             MapBuildPlainFold(learnData, &ctx);
         }
         TVector<TVector<double>> oneRawValues(ctx.LearnProgress.ApproxDimension);
@@ -546,9 +1035,30 @@ class TCPUModelTrainer : public IModelTrainer {
             featureCombinationToProjectionMap
         );
 
+        /* Quantized columns collapsed as exact duplicates never enter the model; record which
+         * kept feature each of them mirrored so that consumers of fstr and model output can
+         * map the kept feature's importance back to its aliases.
+         */
+        TString collapsedDuplicatesInfo;
+        if (!duplicateFeatureAliases.empty()) {
+            NJson::TJsonValue aliasesJson(NJson::JSON_ARRAY);
+            for (int featureIdx = 0; featureIdx < duplicateFeatureAliases.ysize(); ++featureIdx) {
+                if (duplicateFeatureAliases[featureIdx] != -1) {
+                    NJson::TJsonValue alias(NJson::JSON_MAP);
+                    alias.InsertValue("feature_index", featureIdx);
+                    alias.InsertValue("duplicate_of", duplicateFeatureAliases[featureIdx]);
+                    aliasesJson.AppendValue(alias);
+                }
+            }
+            collapsedDuplicatesInfo = NJson::WriteJson(aliasesJson, /*formatOutput=*/false);
+        }
+
         if (modelPtr) {
             modelPtr->ObliviousTrees = std::move(obliviousTrees);
             modelPtr->ModelInfo["params"] = ctx.LearnProgress.SerializedTrainParams;
+            if (!collapsedDuplicatesInfo.empty()) {
+                modelPtr->ModelInfo["collapsed_duplicate_features"] = collapsedDuplicatesInfo;
+            }
             CB_ENSURE(isMulticlass == ctx.LearnProgress.LabelConverter.IsInitialized(),
                       "LabelConverter must be initialized ONLY for multiclass problem");
             if (isMulticlass) {
@@ -565,6 +1075,9 @@ class TCPUModelTrainer : public IModelTrainer {
             TFullModel Model;
             Model.ObliviousTrees = std::move(obliviousTrees);
             Model.ModelInfo["params"] = ctx.LearnProgress.SerializedTrainParams;
+            if (!collapsedDuplicatesInfo.empty()) {
+                Model.ModelInfo["collapsed_duplicate_features"] = collapsedDuplicatesInfo;
+            }
             CB_ENSURE(isMulticlass == ctx.LearnProgress.LabelConverter.IsInitialized(),
                       "LabelConverter must be initialized ONLY for multiclass problem");
             if (isMulticlass) {
@@ -619,7 +1132,7 @@ class TCPUModelTrainer : public IModelTrainer {
         int threadCount = GetThreadCount(catBoostOptions);
 
         if (catBoostOptions.SystemOptions->IsWorker()) {
-            RunWorker(threadCount, catBoostOptions.SystemOptions->NodePort);
+            RunWorker(threadCount, catBoostOptions.SystemOptions->NodePort, catBoostOptions.SystemOptions->NodeTransport);
             return;
         }
 
@@ -747,7 +1260,7 @@ void TrainModel(const NJson::TJsonValue& plainJsonParams,
     catBoostOptions.Load(trainOptions);
 
     if (taskType == ETaskType::CPU && catBoostOptions.SystemOptions->IsWorker()) {
-        RunWorker(catBoostOptions.SystemOptions->NumThreads, catBoostOptions.SystemOptions->NodePort);
+        RunWorker(catBoostOptions.SystemOptions->NumThreads, catBoostOptions.SystemOptions->NodePort, catBoostOptions.SystemOptions->NodeTransport);
         return;
     }
 
@@ -0,0 +1,35 @@
+#include "train_session.h"
+
+#include <catboost/libs/helpers/exception.h>
+
+#include <util/folder/path.h>
+
+TTrainSession::TTrainSession(const TClearablePoolPtrs& pools, const TString& cacheDir)
+    : Pools(pools)
+{
+    CB_ENSURE(Pools.Learn, "Train session requires a learn pool");
+    CB_ENSURE(!Pools.AllowClearLearn && !Pools.AllowClearTest,
+              "Train session pools cannot be cleared: they are reused between trials");
+    if (cacheDir.empty()) {
+        TempCacheDir.ConstructInPlace();
+        CacheDir = TempCacheDir->Name();
+    } else {
+        TFsPath(cacheDir).MkDirs();
+        CacheDir = cacheDir;
+    }
+}
+
+void TTrainSession::Train(
+    const NJson::TJsonValue& plainJsonParams,
+    const TMaybe<TCustomObjectiveDescriptor>& objectiveDescriptor,
+    const TMaybe<TCustomMetricDescriptor>& evalMetricDescriptor,
+    const TString& outputModelPath,
+    TFullModel* model,
+    const TVector<TEvalResult*>& evalResultPtrs) const
+{
+    NJson::TJsonValue trialParams = plainJsonParams;
+    if (!trialParams.Has("quantization_cache_path")) {
+        trialParams["quantization_cache_path"] = CacheDir;
+    }
+    TrainModel(trialParams, objectiveDescriptor, evalMetricDescriptor, Pools, outputModelPath, model, evalResultPtrs);
+}
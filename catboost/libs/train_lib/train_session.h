@@ -0,0 +1,48 @@
+#pragma once
+
+#include "train_model.h"
+
+#include <util/folder/tempdir.h>
+#include <util/generic/maybe.h>
+#include <util/generic/string.h>
+
+/*
+ * Runs several trainings back-to-back over one set of pools, e.g. a
+ * hyperparameter search. The session pins a quantization cache directory for
+ * all trials, so a trial whose quantization-affecting parameters
+ * (per-feature binarization settings, ignored features, one_hot_max_size)
+ * match an earlier one reuses its quantized features instead of recomputing
+ * borders and binarizing the pool again. The cache key hashes exactly those
+ * inputs together with the pool contents, so parameters that genuinely
+ * change the quantized representation invalidate the reuse automatically.
+ *
+ * The pools must stay unchanged between trials; the session forbids
+ * pool clearing for that reason.
+ */
+class TTrainSession {
+public:
+    // If cacheDir is empty, a temporary directory is created and removed
+    // together with the session; otherwise the caller-provided directory is
+    // used and kept, so the cache survives across sessions.
+    explicit TTrainSession(const TClearablePoolPtrs& pools, const TString& cacheDir = TString());
+
+    // Equivalent to a standalone TrainModel call with the session pools,
+    // except that the session quantization cache is plugged into the params.
+    // An explicit "quantization_cache_path" in plainJsonParams wins.
+    void Train(
+        const NJson::TJsonValue& plainJsonParams,
+        const TMaybe<TCustomObjectiveDescriptor>& objectiveDescriptor,
+        const TMaybe<TCustomMetricDescriptor>& evalMetricDescriptor,
+        const TString& outputModelPath,
+        TFullModel* model,
+        const TVector<TEvalResult*>& evalResultPtrs) const;
+
+    const TString& GetCacheDir() const {
+        return CacheDir;
+    }
+
+private:
+    TClearablePoolPtrs Pools;
+    TMaybe<TTempDir> TempCacheDir;
+    TString CacheDir;
+};
@@ -299,6 +299,7 @@ cdef extern from "catboost/libs/options/cross_validation_params.h":
         int PartitionRandSeed
         bool_t Shuffle
         bool_t Stratified
+        bool_t ParallelFolds
         int EvalPeriod
 
 cdef extern from "catboost/libs/options/check_train_options.h":
@@ -360,6 +361,18 @@ cdef extern from "catboost/libs/algo/apply.h":
         int threadCount
     ) nogil except +ProcessException
 
+    cdef TVector[TVector[double]] ApplyModelMultiForDocRange(
+        const TFullModel& calcer,
+        const TPool& pool,
+        bool_t verbose,
+        const EPredictionType predictionType,
+        int begin,
+        int end,
+        size_t docBegin,
+        size_t docEnd,
+        int threadCount
+    ) nogil except +ProcessException
+
 cdef extern from "catboost/libs/algo/helpers.h":
     cdef void ConfigureMalloc() nogil except *
 
@@ -455,6 +468,29 @@ cdef extern from "catboost/python-package/catboost/helpers.h":
         const TVector[TString]& metricsDescription
     ) nogil except +ProcessException
 
+    cdef void SetPoolNumFeaturesZeroCopy(
+        TPool* pool,
+        const float* data,
+        size_t docCount,
+        size_t featureCount
+    ) nogil except +ProcessException
+
+    cdef void CopyPoolNumFeatures(
+        TPool* pool,
+        const float* data,
+        size_t docCount,
+        size_t featureCount,
+        bool_t rowMajor
+    ) nogil except +ProcessException
+
+    cdef void CopyPoolNumFeatures(
+        TPool* pool,
+        const double* data,
+        size_t docCount,
+        size_t featureCount,
+        bool_t rowMajor
+    ) nogil except +ProcessException
+
     cdef TVector[double] EvalMetricsForUtils(
         const TVector[float]& label,
         const TVector[TVector[double]]& approx,
@@ -867,10 +903,13 @@ class FeaturesData(object):
 cdef class _PoolBase:
     cdef TPool* __pool
     cdef bool_t has_label_
+    # keeps the numpy array alive while the pool borrows its memory for factor columns
+    cdef object __data_holder
 
     def __cinit__(self):
         self.__pool = new TPool()
         self.has_label_ = False
+        self.__data_holder = None
 
     def __dealloc__(self):
         del self.__pool
@@ -988,6 +1027,42 @@ cdef class _PoolBase:
                 dst_feature_idx += 1
 
 
+    cdef bool_t _try_set_data_buffer(self, np.ndarray data) except *:
+        """
+        Load a contiguous float32/float64 matrix through the buffer protocol: one bulk
+        pass in C++ instead of a per-element python loop. Column-contiguous float32
+        data is not copied at all - the pool borrows the array's memory for its factor
+        columns. Only applicable when the pool has no categorical features.
+        """
+        if data.ndim != 2 or data.shape[0] == 0 or data.shape[1] == 0:
+            return False
+        if not self.__pool.CatFeatures.empty():
+            return False
+        cdef np.float32_t [::1,:] data_f32_colmajor
+        cdef np.float32_t [:,::1] data_f32_rowmajor
+        cdef np.float64_t [::1,:] data_f64_colmajor
+        cdef np.float64_t [:,::1] data_f64_rowmajor
+        if data.dtype == np.float32:
+            if data.flags['F_CONTIGUOUS']:
+                data_f32_colmajor = data
+                SetPoolNumFeaturesZeroCopy(self.__pool, &data_f32_colmajor[0, 0], data.shape[0], data.shape[1])
+                self.__data_holder = data
+                return True
+            if data.flags['C_CONTIGUOUS']:
+                data_f32_rowmajor = data
+                CopyPoolNumFeatures(self.__pool, &data_f32_rowmajor[0, 0], data.shape[0], data.shape[1], True)
+                return True
+        elif data.dtype == np.float64:
+            if data.flags['F_CONTIGUOUS']:
+                data_f64_colmajor = data
+                CopyPoolNumFeatures(self.__pool, &data_f64_colmajor[0, 0], data.shape[0], data.shape[1], False)
+                return True
+            if data.flags['C_CONTIGUOUS']:
+                data_f64_rowmajor = data
+                CopyPoolNumFeatures(self.__pool, &data_f64_rowmajor[0, 0], data.shape[0], data.shape[1], True)
+                return True
+        return False
+
     cdef TVector[bool_t] _get_is_cat_feature_mask(self, int feature_count):
         cdef TVector[bool_t] mask
         mask.resize(feature_count, False)
@@ -1037,11 +1112,14 @@ cdef class _PoolBase:
 
     cpdef _set_data_and_feature_names(self, data, feature_names):
         self.__pool.Docs.Clear()
+        self.__data_holder = None
         if isinstance(data, FeaturesData):
             self._set_data_np(data.num_feature_data, data.cat_feature_data)
             self._set_feature_names(data.get_feature_names())
         else:
-            if isinstance(data, np.ndarray) and data.dtype == np.float32:
+            if isinstance(data, np.ndarray) and self._try_set_data_buffer(data):
+                pass
+            elif isinstance(data, np.ndarray) and data.dtype == np.float32:
                 self._set_data_np(data, None)
             else:
                 self._set_data_from_generic_matrix(data)
@@ -1073,7 +1151,8 @@ cdef class _PoolBase:
         rows = self.num_row()
         if rows == 0:
             return
-        self.__pool.Docs.Resize(rows, self.__pool.Docs.GetEffectiveFactorCount(), self.__pool.Docs.GetBaselineDimension(), True, False)
+        # resize only the column being set: a full Docs.Resize would drop borrowed factor columns
+        self.__pool.Docs.QueryId.resize(rows)
         cdef object id_as_bytes
         cdef TStringBuf id_as_strbuf
         for i in range(rows):
@@ -1091,7 +1170,7 @@ cdef class _PoolBase:
         rows = self.num_row()
         if rows == 0:
             return
-        self.__pool.Docs.Resize(rows, self.__pool.Docs.GetEffectiveFactorCount(), self.__pool.Docs.GetBaselineDimension(), False, False)
+        self.__pool.Docs.Weight.resize(rows)
         for i in range(rows):
             self.__pool.Docs.Weight[i] = float(group_weight[i])
         self.__pool.MetaInfo.HasGroupWeight = True
@@ -1103,7 +1182,7 @@ cdef class _PoolBase:
         rows = self.num_row()
         if rows == 0:
             return
-        self.__pool.Docs.Resize(rows, self.__pool.Docs.GetEffectiveFactorCount(), self.__pool.Docs.GetBaselineDimension(), False, True)
+        self.__pool.Docs.SubgroupId.resize(rows)
         cdef object id_as_bytes
         cdef TStringBuf id_as_strbuf
         for i in range(rows):
@@ -1126,7 +1205,9 @@ cdef class _PoolBase:
         rows = self.num_row()
         if rows == 0:
             return
-        self.__pool.Docs.Resize(rows, self.__pool.Docs.GetEffectiveFactorCount(), len(baseline[0]), False, False)
+        self.__pool.Docs.Baseline.resize(len(baseline[0]))
+        for j in range(len(baseline[0])):
+            self.__pool.Docs.Baseline[j].resize(rows)
         for i in range(rows):
             for j, value in enumerate(baseline[i]):
                 self.__pool.Docs.Baseline[j][i] = float(value)
@@ -1202,10 +1283,12 @@ cdef class _PoolBase:
         feature matrix : list(list)
         """
         data = []
+        cdef int factor_count = self.__pool.Docs.GetEffectiveFactorCount()
+        cdef int factor_idx
         for doc in range(self.__pool.Docs.GetDocCount()):
             factors = []
-            for factor in self.__pool.Docs.Factors:
-                factors.append(factor[doc])
+            for factor_idx in range(factor_count):
+                factors.append(self.__pool.Docs.GetFeatureValue(doc, factor_idx))
             data.append(factors)
         return data
 
@@ -1417,6 +1500,12 @@ cdef class _CatBoost:
         stagedPredictIterator.set_model(self.__model)
         return stagedPredictIterator
 
+    cpdef _chunked_predict_iterator(self, _PoolBase pool, str prediction_type, int ntree_start, int ntree_end, size_t chunk_size, int thread_count, verbose):
+        thread_count = UpdateThreadCount(thread_count);
+        chunkedPredictIterator = _ChunkedPredictIterator(pool, prediction_type, ntree_start, ntree_end, chunk_size, thread_count, verbose)
+        chunkedPredictIterator.set_model(self.__model)
+        return chunkedPredictIterator
+
     cpdef _base_eval_metrics(self, _PoolBase pool, metric_descriptions, int ntree_start, int ntree_end, int eval_period, int thread_count, result_dir, tmp_dir):
         result_dir = to_binary_str(result_dir)
         tmp_dir = to_binary_str(tmp_dir)
@@ -1600,7 +1689,7 @@ cdef class _MetadataHashProxy:
 
 
 cpdef _cv(dict params, _PoolBase pool, int fold_count, bool_t inverted, int partition_random_seed,
-          bool_t shuffle, bool_t stratified, bool_t as_pandas):
+          bool_t shuffle, bool_t stratified, bool_t as_pandas, bool_t parallel_folds):
     prep_params = _PreprocessParams(params)
     cdef TCrossValidationParams cvParams
     cdef TVector[TCVResult] results
@@ -1610,6 +1699,7 @@ cpdef _cv(dict params, _PoolBase pool, int fold_count, bool_t inverted, int part
     cvParams.Shuffle = shuffle
     cvParams.Stratified = stratified
     cvParams.Inverted = inverted
+    cvParams.ParallelFolds = parallel_folds
 
     with nogil:
         SetPythonInterruptHandler()
@@ -1693,6 +1783,72 @@ cdef class _StagedPredictIterator:
         return [[value for value in vec] for vec in pred]
 
 
+cdef class _ChunkedPredictIterator:
+    """
+    Evaluates the model over consecutive document chunks of a pool; the GIL is
+    released while the native evaluator runs, so consumers can pipeline
+    post-processing with scoring and peak result memory stays one chunk.
+    """
+    cdef TFullModel* __model
+    cdef _PoolBase pool
+    cdef str prediction_type
+    cdef int ntree_start, ntree_end, thread_count
+    cdef size_t doc_offset, doc_count, chunk_size
+    cdef bool_t verbose
+
+    cdef set_model(self, TFullModel* model):
+        self.__model = model
+
+    def __cinit__(self, _PoolBase pool, str prediction_type, int ntree_start, int ntree_end, size_t chunk_size, int thread_count, verbose):
+        self.pool = pool
+        self.prediction_type = prediction_type
+        self.ntree_start = ntree_start
+        self.ntree_end = ntree_end
+        self.chunk_size = chunk_size
+        self.thread_count = thread_count
+        self.verbose = verbose
+        self.doc_offset = 0
+        self.doc_count = pool.num_row()
+
+    def __deepcopy__(self, _):
+        raise CatboostError('Can\'t deepcopy _ChunkedPredictIterator object')
+
+    def __iter__(self):
+        return self
+
+    def __next__(self):
+        if self.doc_offset >= self.doc_count:
+            raise StopIteration
+
+        cdef size_t doc_begin = self.doc_offset
+        cdef size_t doc_end = self.doc_offset + self.chunk_size
+        if doc_end > self.doc_count:
+            doc_end = self.doc_count
+        cdef EPredictionType predictionType = PyPredictionType(self.prediction_type).predictionType
+        cdef const TFullModel* model = self.__model
+        cdef const TPool* pool = self.pool.__pool
+        cdef bool_t verbose = self.verbose
+        cdef int ntree_start = self.ntree_start
+        cdef int ntree_end = self.ntree_end
+        cdef int thread_count = self.thread_count
+        cdef TVector[TVector[double]] pred
+        with nogil:
+            pred = ApplyModelMultiForDocRange(dereference(model),
+                                              dereference(pool),
+                                              verbose,
+                                              predictionType,
+                                              ntree_start,
+                                              ntree_end,
+                                              doc_begin,
+                                              doc_end,
+                                              thread_count)
+        self.doc_offset = doc_end
+        return [[value for value in vec] for vec in pred]
+
+    def next(self):
+        return self.__next__()
+
+
 class MetricDescription:
 
     def __init__(self, metric_name, is_max_optimal):
@@ -863,6 +863,9 @@ class _CatBoostBase(object):
     def _base_predict_multi(self, pool, prediction_type, ntree_start, ntree_end, thread_count, verbose):
         return self._object._base_predict_multi(pool, prediction_type, ntree_start, ntree_end, thread_count, verbose)
 
+    def _chunked_predict_iterator(self, pool, prediction_type, ntree_start, ntree_end, chunk_size, thread_count, verbose):
+        return self._object._chunked_predict_iterator(pool, prediction_type, ntree_start, ntree_end, chunk_size, thread_count, verbose)
+
     def _staged_predict_iterator(self, pool, prediction_type, ntree_start, ntree_end, eval_period, thread_count, verbose):
         return self._object._staged_predict_iterator(pool, prediction_type, ntree_start, ntree_end, eval_period, thread_count, verbose)
 
@@ -1253,6 +1256,85 @@ class CatBoost(_CatBoostBase):
         """
         return self._predict(data, prediction_type, ntree_start, ntree_end, thread_count, verbose)
 
+    def _predict_iter(self, data, prediction_type, ntree_start, ntree_end, chunk_size, thread_count, verbose):
+        verbose = verbose or self.get_param('verbose')
+        if verbose is None:
+            verbose = False
+        if not self.is_fitted_:
+            raise CatboostError("There is no trained model to use predict_iter(). Use fit() to train model. Then use predict_iter().")
+        if not isinstance(data, Pool):
+            data = Pool(
+                data=data,
+                cat_features=self._get_cat_feature_indices() if not isinstance(data, FeaturesData) else None
+            )
+        elif not np.all(set(self._get_cat_feature_indices()).issubset(data.get_cat_feature_indices())):
+            raise CatboostError("Data cat_features in predict_iter()={} are not equal data cat_features in fit()={}.".format(data.get_cat_feature_indices(), self._get_cat_feature_indices()))
+        if not isinstance(prediction_type, STRING_TYPES):
+            raise CatboostError("Invalid prediction_type type={}: must be str().".format(type(prediction_type)))
+        if prediction_type not in ('Class', 'RawFormulaVal', 'Probability'):
+            raise CatboostError("Invalid value of prediction_type={}: must be Class, RawFormulaVal or Probability.".format(prediction_type))
+        if chunk_size <= 0:
+            raise CatboostError("Invalid chunk_size={}: must be positive.".format(chunk_size))
+        chunked_predict_iterator = self._chunked_predict_iterator(data, prediction_type, ntree_start, ntree_end, chunk_size, thread_count, verbose)
+        loss_function = self.get_param('loss_function')
+        while True:
+            try:
+                predictions = chunked_predict_iterator.next()
+            except StopIteration:
+                return
+            if loss_function is not None and (loss_function == 'MultiClass' or loss_function == 'MultiClassOneVsAll'):
+                predictions = np.transpose(predictions)
+            else:
+                predictions = np.array(predictions[0])
+                if prediction_type == 'Probability':
+                    predictions = np.transpose([1 - predictions, predictions])
+            yield predictions
+
+    def predict_iter(self, data, prediction_type='RawFormulaVal', ntree_start=0, ntree_end=0, chunk_size=65536, thread_count=-1, verbose=None):
+        """
+        Predict with data, yielding the result in document chunks.
+
+        Unlike predict(), the whole prediction is never materialized at once: the model is
+        applied to chunk_size documents at a time with the GIL released, and each chunk is
+        yielded as soon as it is computed, so post-processing can overlap with scoring and
+        peak memory for the result stays proportional to one chunk.
+
+        Parameters
+        ----------
+        data : catboost.Pool or list or numpy.array or pandas.DataFrame or pandas.Series
+                or catboost.FeaturesData
+            Data to predict.
+
+        prediction_type : string, optional (default='RawFormulaVal')
+            Can be:
+            - 'RawFormulaVal' : return raw value.
+            - 'Class' : return majority vote class.
+            - 'Probability' : return probability for every class.
+
+        ntree_start: int, optional (default=0)
+            Model is applyed on the interval [ntree_start, ntree_end) (zero-based indexing).
+
+        ntree_end: int, optional (default=0)
+            Model is applyed on the interval [ntree_start, ntree_end) (zero-based indexing).
+            If value equals to 0 this parameter is ignored and ntree_end equal to tree_count_.
+
+        chunk_size: int, optional (default=65536)
+            The number of documents evaluated and yielded at a time.
+
+        thread_count : int (default=-1)
+            The number of threads to use when applying the model.
+            Allows you to optimize the speed of execution. This parameter doesn't affect results.
+            If -1, then the number of threads is set to the number of cores.
+
+        verbose : bool, optional (default=False)
+            If True, writes the evaluation metric measured set to stderr.
+
+        Returns
+        -------
+        prediction : generator numpy.array for each chunk of documents
+        """
+        return self._predict_iter(data, prediction_type, ntree_start, ntree_end, chunk_size, thread_count, verbose)
+
     def _staged_predict(self, data, prediction_type, ntree_start, ntree_end, eval_period, thread_count, verbose):
         verbose = verbose or self.get_param('verbose')
         if verbose is None:
@@ -2597,7 +2679,8 @@ def train(pool=None, params=None, dtrain=None, logging_level=None, verbose=None,
 def cv(pool=None, params=None, dtrain=None, iterations=None, num_boost_round=None,
        fold_count=3, nfold=None, inverted=False, partition_random_seed=0, seed=None,
        shuffle=True, logging_level=None, stratified=False, as_pandas=True, metric_period=None,
-       verbose=None, verbose_eval=None, plot=False, early_stopping_rounds=None):
+       verbose=None, verbose_eval=None, plot=False, early_stopping_rounds=None,
+       parallel_folds=False):
     """
     Cross-validate the CatBoost model.
 
@@ -2676,6 +2759,10 @@ def cv(pool=None, params=None, dtrain=None, iterations=None, num_boost_round=Non
     early_stopping_rounds : int
         Activates Iter overfitting detector with od_wait set to early_stopping_rounds.
 
+    parallel_folds : bool, optional (default=False)
+        Train the folds concurrently, splitting the thread budget between them.
+        Useful when a single fold cannot saturate all cores.
+
     Returns
     -------
     cv results : pandas.core.frame.DataFrame with cross-validation results
@@ -2740,7 +2827,8 @@ def cv(pool=None, params=None, dtrain=None, iterations=None, num_boost_round=Non
         widget._run_update()
 
     with log_fixup():
-        return _cv(params, pool, fold_count, inverted, partition_random_seed, shuffle, stratified, as_pandas)
+        return _cv(params, pool, fold_count, inverted, partition_random_seed, shuffle, stratified, as_pandas,
+                   parallel_folds)
 
 
 class BatchMetricCalcer(_MetricCalcerBase):
@@ -5,6 +5,8 @@
 #include <catboost/libs/helpers/exception.h>
 #include <catboost/libs/helpers/interrupt.h>
 
+#include <util/generic/utility.h>
+
 extern "C" PyObject* PyCatboostExceptionType;
 
 void ProcessException() {
@@ -77,6 +79,55 @@ TVector<TVector<double>> EvalMetrics(
     return metricsScore;
 }
 
+void SetPoolNumFeaturesZeroCopy(TPool* pool, const float* data, size_t docCount, size_t featureCount) {
+    TVector<TConstArrayRef<float>> factorColumns(featureCount);
+    for (size_t featureIdx = 0; featureIdx < featureCount; ++featureIdx) {
+        factorColumns[featureIdx] = MakeArrayRef(data + featureIdx * docCount, docCount);
+    }
+    pool->Docs.SetExternalFactors(factorColumns);
+}
+
+template <typename T>
+static void CopyPoolNumFeaturesImpl(TPool* pool, const T* data, size_t docCount, size_t featureCount, bool rowMajor) {
+    pool->Docs.Resize(docCount, featureCount);
+    if (docCount == 0 || featureCount == 0) {
+        return;
+    }
+    if (!rowMajor) {
+        for (size_t featureIdx = 0; featureIdx < featureCount; ++featureIdx) {
+            const T* column = data + featureIdx * docCount;
+            float* factor = pool->Docs.Factors[featureIdx].data();
+            for (size_t docIdx = 0; docIdx < docCount; ++docIdx) {
+                factor[docIdx] = static_cast<float>(column[docIdx]);
+            }
+        }
+        return;
+    }
+    // blocked transpose: every source cache line loaded for a block is reused for all its features
+    const size_t docBlockSize = 256;
+    const size_t featureBlockSize = 32;
+    for (size_t docBlockStart = 0; docBlockStart < docCount; docBlockStart += docBlockSize) {
+        const size_t docBlockEnd = Min(docCount, docBlockStart + docBlockSize);
+        for (size_t featureBlockStart = 0; featureBlockStart < featureCount; featureBlockStart += featureBlockSize) {
+            const size_t featureBlockEnd = Min(featureCount, featureBlockStart + featureBlockSize);
+            for (size_t featureIdx = featureBlockStart; featureIdx < featureBlockEnd; ++featureIdx) {
+                float* factor = pool->Docs.Factors[featureIdx].data();
+                for (size_t docIdx = docBlockStart; docIdx < docBlockEnd; ++docIdx) {
+                    factor[docIdx] = static_cast<float>(data[docIdx * featureCount + featureIdx]);
+                }
+            }
+        }
+    }
+}
+
+void CopyPoolNumFeatures(TPool* pool, const float* data, size_t docCount, size_t featureCount, bool rowMajor) {
+    CopyPoolNumFeaturesImpl(pool, data, docCount, featureCount, rowMajor);
+}
+
+void CopyPoolNumFeatures(TPool* pool, const double* data, size_t docCount, size_t featureCount, bool rowMajor) {
+    CopyPoolNumFeaturesImpl(pool, data, docCount, featureCount, rowMajor);
+}
+
 TVector<TString> GetMetricNames(const TFullModel& model, const TVector<TString>& metricsDescription) {
     auto metrics = CreateMetricsFromDescription(metricsDescription, model.ObliviousTrees.ApproxDimension);
     TVector<TString> metricNames;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <catboost/libs/algo/plot.h>
+#include <catboost/libs/data/pool.h>
 #include <catboost/libs/data_types/groupid.h>
 
 #include <util/generic/noncopyable.h>
@@ -38,6 +39,20 @@ TVector<TVector<double>> EvalMetrics(
 
 TVector<TString> GetMetricNames(const TFullModel& model, const TVector<TString>& metricsDescription);
 
+/*
+ * Borrow a column-contiguous float32 feature matrix as the pool's factor columns without
+ * copying: `data` holds `featureCount` columns of `docCount` values each. The buffer must
+ * outlive the pool; the python side keeps a reference to the source array for that.
+ */
+void SetPoolNumFeaturesZeroCopy(TPool* pool, const float* data, size_t docCount, size_t featureCount);
+
+/*
+ * Bulk-load a contiguous feature matrix into owned pool columns in one pass over the
+ * source memory; row-major input is transposed in cache-sized blocks.
+ */
+void CopyPoolNumFeatures(TPool* pool, const float* data, size_t docCount, size_t featureCount, bool rowMajor);
+void CopyPoolNumFeatures(TPool* pool, const double* data, size_t docCount, size_t featureCount, bool rowMajor);
+
 TVector<double> EvalMetricsForUtils(
     const TVector<float>& label,
     const TVector<TVector<double>>& approx,
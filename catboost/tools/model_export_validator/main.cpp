@@ -0,0 +1,154 @@
+#include <catboost/libs/data/load_data.h>
+#include <catboost/libs/helpers/exception.h>
+#include <catboost/libs/model/coreml_helpers.h>
+#include <catboost/libs/model/model.h>
+#include <catboost/libs/options/enums.h>
+#include <catboost/libs/options/load_options.h>
+
+#include <library/getopt/small/last_getopt.h>
+
+#include <util/generic/ymath.h>
+#include <util/stream/file.h>
+#include <util/system/hp_timer.h>
+#include <util/system/info.h>
+
+/*
+ * Export validation harness: exports a model, scores a sampled pool with both the in-process
+ * evaluator and the re-imported exported artifact, and reports export time, docs/sec of each
+ * evaluator and the score deltas. Exits non-zero if the largest delta exceeds the tolerance,
+ * so export fidelity and performance are measured instead of assumed.
+ */
+
+static TFullModel ReimportArtifact(const TString& artifactPath, EModelType format) {
+    if (format == EModelType::AppleCoreML) {
+        TIFStream in(artifactPath);
+        const TString data = in.ReadAll();
+        CoreML::Specification::Model coreMLModel;
+        CB_ENSURE(coreMLModel.ParseFromString(data), "Can not parse CoreML artifact " << artifactPath);
+        TFullModel model;
+        NCatboost::NCoreML::ConvertCoreMLToCatboostModel(coreMLModel, &model);
+        return model;
+    }
+    CB_ENSURE(format == EModelType::CatboostBinary, "Re-import is not supported for " << format << " artifacts");
+    return ReadModel(artifactPath);
+}
+
+static double MeasureScoring(const TFullModel& model, const TVector<TConstArrayRef<float>>& docs, TVector<double>* results) {
+    results->yresize(docs.size() * model.ObliviousTrees.ApproxDimension);
+    THPTimer timer;
+    model.CalcFlat(docs, *results);
+    return timer.Passed();
+}
+
+int main(int argc, const char* argv[]) {
+    TString modelPath;
+    TString poolPath;
+    TString cdPath;
+    TString artifactPath = "export_validation_artifact";
+    EModelType format = EModelType::AppleCoreML;
+    size_t sampleCount = 10000;
+    double tolerance = 1e-6;
+    int threadCount = static_cast<int>(NSystemInfo::CachedNumberOfCpus());
+
+    auto parser = NLastGetopt::TOpts();
+    parser.AddHelpOption();
+    parser.AddLongOption('m', "model-path", "path to model")
+        .RequiredArgument("PATH")
+        .Required()
+        .StoreResult(&modelPath);
+    parser.AddLongOption('f', "input-path", "pool to sample validation documents from")
+        .RequiredArgument("PATH")
+        .Required()
+        .StoreResult(&poolPath);
+    parser.AddLongOption("column-description", "column description file")
+        .RequiredArgument("PATH")
+        .StoreResult(&cdPath);
+    parser.AddLongOption("export-format", "one of CatboostBinary, AppleCoreML")
+        .RequiredArgument("FORMAT")
+        .DefaultValue("AppleCoreML")
+        .StoreResult(&format);
+    parser.AddLongOption('o', "output-path", "where to write the exported artifact")
+        .RequiredArgument("PATH")
+        .StoreResult(&artifactPath);
+    parser.AddLongOption("sample-count", "number of documents to score (evenly strided over the pool)")
+        .RequiredArgument("COUNT")
+        .DefaultValue("10000")
+        .StoreResult(&sampleCount);
+    parser.AddLongOption("tolerance", "largest allowed |score delta|")
+        .RequiredArgument("DELTA")
+        .DefaultValue("1e-6")
+        .StoreResult(&tolerance);
+    parser.AddLongOption('T', "threads", "thread count for pool loading")
+        .RequiredArgument("COUNT")
+        .StoreResult(&threadCount);
+    parser.SetFreeArgsMax(0);
+    NLastGetopt::TOptsParseResult parserResult{&parser, argc, argv};
+
+    TFullModel model = ReadModel(modelPath);
+
+    NCatboostOptions::TDsvPoolFormatParams dsvPoolFormatParams;
+    if (!cdPath.empty()) {
+        dsvPoolFormatParams.CdFilePath = NCB::TPathWithScheme(cdPath, "file");
+    }
+    TPool pool;
+    NCB::ReadPool(NCB::TPathWithScheme(poolPath, "dsv"),
+                  NCB::TPathWithScheme(),
+                  dsvPoolFormatParams,
+                  /*ignoredFeatures*/ {},
+                  threadCount,
+                  /*verbose*/ false,
+                  /*classNames*/ {},
+                  &pool);
+
+    const size_t docCount = pool.Docs.GetDocCount();
+    CB_ENSURE(docCount > 0, "Pool is empty");
+    sampleCount = Min<size_t>(sampleCount, docCount);
+    const size_t stride = docCount / sampleCount;
+    const size_t factorCount = pool.Docs.GetEffectiveFactorCount();
+
+    TVector<TVector<float>> docStorage(sampleCount);
+    TVector<TConstArrayRef<float>> docs(sampleCount);
+    for (size_t i = 0; i < sampleCount; ++i) {
+        const size_t docIdx = i * stride;
+        auto& row = docStorage[i];
+        row.yresize(factorCount);
+        for (size_t factorIdx = 0; factorIdx < factorCount; ++factorIdx) {
+            row[factorIdx] = pool.Docs.Factors[factorIdx].empty() ? 0.0f : pool.Docs.Factors[factorIdx][docIdx];
+        }
+        docs[i] = row;
+    }
+
+    THPTimer exportTimer;
+    ExportModel(model, artifactPath, format, /*userParametersJSON*/ "", /*addFileFormatExtension*/ false);
+    const double exportSeconds = exportTimer.Passed();
+    Cout << "Exported " << format << " artifact to " << artifactPath << " in " << exportSeconds << " sec" << Endl;
+
+    TVector<double> referenceScores;
+    const double referenceSeconds = MeasureScoring(model, docs, &referenceScores);
+    Cout << "In-process evaluator: " << sampleCount << " docs in " << referenceSeconds
+         << " sec (" << static_cast<ui64>(sampleCount / Max(referenceSeconds, 1e-9)) << " docs/sec)" << Endl;
+
+    const TFullModel reimportedModel = ReimportArtifact(artifactPath, format);
+    TVector<double> artifactScores;
+    const double artifactSeconds = MeasureScoring(reimportedModel, docs, &artifactScores);
+    Cout << "Exported artifact:    " << sampleCount << " docs in " << artifactSeconds
+         << " sec (" << static_cast<ui64>(sampleCount / Max(artifactSeconds, 1e-9)) << " docs/sec)" << Endl;
+
+    CB_ENSURE(referenceScores.size() == artifactScores.size(),
+              "Approx dimension mismatch between model and exported artifact");
+    double maxDelta = 0.0;
+    double deltaSum = 0.0;
+    for (size_t i = 0; i < referenceScores.size(); ++i) {
+        const double delta = Abs(referenceScores[i] - artifactScores[i]);
+        maxDelta = Max(maxDelta, delta);
+        deltaSum += delta;
+    }
+    Cout << "Score delta: max " << maxDelta << ", mean " << deltaSum / referenceScores.size() << Endl;
+
+    if (maxDelta > tolerance) {
+        Cout << "FAIL: max score delta " << maxDelta << " exceeds tolerance " << tolerance << Endl;
+        return 1;
+    }
+    Cout << "OK" << Endl;
+    return 0;
+}
@@ -0,0 +1,143 @@
+#include "quantile_sketch.h"
+
+#include <util/generic/algorithm.h>
+#include <util/generic/ymath.h>
+
+#include <algorithm>
+#include <iterator>
+
+namespace NSplitSelection {
+    static bool CompareByValue(const TQuantileSketch::TWeightedValue& lhs,
+                               const TQuantileSketch::TWeightedValue& rhs) {
+        return lhs.Value < rhs.Value;
+    }
+
+    static void CombineEqualValues(TVector<TQuantileSketch::TWeightedValue>* points) {
+        size_t dst = 0;
+        for (size_t i = 1; i < points->size(); ++i) {
+            if ((*points)[i].Value == (*points)[dst].Value) {
+                (*points)[dst].Weight += (*points)[i].Weight;
+            } else {
+                (*points)[++dst] = (*points)[i];
+            }
+        }
+        if (!points->empty()) {
+            points->resize(dst + 1);
+        }
+    }
+
+    /* Downsample onto an even cumulative weight grid: every emitted point carries the
+     * whole weight accumulated since the previous one, so the total is exact and any
+     * rank moves by less than one grid step. The largest value always survives; the
+     * smallest may be absorbed into the first emitted point.
+     */
+    static void Prune(size_t maxSize, TVector<TQuantileSketch::TWeightedValue>* points) {
+        if (points->size() <= maxSize) {
+            return;
+        }
+        double total = 0;
+        for (const auto& point : *points) {
+            total += point.Weight;
+        }
+        const double step = total / maxSize;
+        TVector<TQuantileSketch::TWeightedValue> pruned;
+        pruned.reserve(maxSize + 1);
+        double carry = 0;
+        for (size_t i = 0; i < points->size(); ++i) {
+            carry += (*points)[i].Weight;
+            if (carry >= step || i + 1 == points->size()) {
+                pruned.push_back({(*points)[i].Value, carry});
+                carry = 0;
+            }
+        }
+        points->swap(pruned);
+    }
+
+    TQuantileSketch::TQuantileSketch(size_t maxSize)
+        : MaxSize(Max<size_t>(maxSize, 2))
+    {
+    }
+
+    void TQuantileSketch::Add(float value, double weight) {
+        if (IsNan(value) || !(weight > 0)) {
+            return;
+        }
+        Buffer.push_back({value, weight});
+        TotalWeight += weight;
+        if (Buffer.size() >= MaxSize) {
+            Compact();
+        }
+    }
+
+    void TQuantileSketch::Merge(const TQuantileSketch& other) {
+        Buffer.insert(Buffer.end(), other.Summary.begin(), other.Summary.end());
+        Buffer.insert(Buffer.end(), other.Buffer.begin(), other.Buffer.end());
+        TotalWeight += other.TotalWeight;
+        if (Buffer.size() >= MaxSize) {
+            Compact();
+        }
+    }
+
+    void TQuantileSketch::Compact() {
+        Sort(Buffer.begin(), Buffer.end(), CompareByValue);
+        TVector<TWeightedValue> merged;
+        merged.reserve(Summary.size() + Buffer.size());
+        std::merge(Summary.begin(), Summary.end(), Buffer.begin(), Buffer.end(),
+                   std::back_inserter(merged), CompareByValue);
+        Buffer.clear();
+        CombineEqualValues(&merged);
+        Prune(MaxSize, &merged);
+        Summary.swap(merged);
+    }
+
+    TVector<TQuantileSketch::TWeightedValue> TQuantileSketch::GetSummary() const {
+        TVector<TWeightedValue> buffer = Buffer;
+        Sort(buffer.begin(), buffer.end(), CompareByValue);
+        TVector<TWeightedValue> summary;
+        summary.reserve(Summary.size() + buffer.size());
+        std::merge(Summary.begin(), Summary.end(), buffer.begin(), buffer.end(),
+                   std::back_inserter(summary), CompareByValue);
+        CombineEqualValues(&summary);
+        return summary;
+    }
+
+    THashSet<float> TQuantileSketch::GetBorders(int borderCount, EBorderSelectionType type) const {
+        const TVector<TWeightedValue> summary = GetSummary();
+        if (summary.empty()) {
+            return THashSet<float>();
+        }
+        /* The selection algorithms take unweighted samples, so the summary is expanded
+         * into a pseudo-sample with per-point multiplicity proportional to its weight;
+         * the granularity this costs is of the same order as the sketch's own rank
+         * error. Every point appears at least once so rare extreme values survive.
+         */
+        const size_t sampleSize = 4 * MaxSize;
+        TVector<float> values;
+        values.reserve(sampleSize + summary.size());
+        for (const auto& point : summary) {
+            const size_t multiplicity = Max<size_t>(1,
+                static_cast<size_t>(point.Weight / TotalWeight * sampleSize + 0.5));
+            for (size_t i = 0; i < multiplicity; ++i) {
+                values.push_back(point.Value);
+            }
+        }
+        return BestSplit(values, borderCount, type, /*nanValueIsInfty*/ false, /*featuresAreSorted*/ true);
+    }
+
+    void TQuantileSketch::Save(IOutputStream* out) const {
+        const TVector<TWeightedValue> summary = GetSummary();
+        ::Save(out, static_cast<ui64>(MaxSize));
+        ::Save(out, TotalWeight);
+        ::Save(out, summary);
+    }
+
+    void TQuantileSketch::Load(IInputStream* in) {
+        ui64 maxSize = 0;
+        ::Load(in, maxSize);
+        MaxSize = Max<size_t>(maxSize, 2);
+        ::Load(in, TotalWeight);
+        Buffer.clear();
+        ::Load(in, Summary);
+        Prune(MaxSize, &Summary); // tolerate a summary written with a larger budget
+    }
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "binarization.h"
+
+#include <util/generic/hash_set.h>
+#include <util/generic/vector.h>
+#include <util/stream/input.h>
+#include <util/stream/output.h>
+#include <util/ysaveload.h>
+
+namespace NSplitSelection {
+    /*
+     * Mergeable weighted quantile sketch for computing consistent borders over sharded
+     * pools: every shard feeds its local feature values into a sketch during the pool
+     * scan, the fixed-size sketches are merged (merging is associative and
+     * order-independent up to the rank error bound) and borders are derived from the
+     * merged summary, so border selection costs O(sketch size) network traffic instead
+     * of shipping raw columns.
+     *
+     * The summary is a sorted list of weighted points maintained by merge-and-prune:
+     * whenever it outgrows the size budget it is downsampled onto an even cumulative
+     * weight grid. The total weight is preserved exactly and the rank of any quantile
+     * estimate is off by at most O(totalWeight / maxSize), so a budget of a few
+     * thousand points is ample for border counts up to 255.
+     */
+    class TQuantileSketch {
+    public:
+        struct TWeightedValue {
+            float Value = 0;
+            double Weight = 0;
+        };
+
+    public:
+        explicit TQuantileSketch(size_t maxSize = 4096);
+
+        // NaN values and non-positive weights are ignored, matching BestSplit's input
+        // expectations.
+        void Add(float value, double weight = 1.0);
+        void Merge(const TQuantileSketch& other);
+
+        // Sorted weighted summary of everything added so far; weights sum to the total
+        // added weight.
+        TVector<TWeightedValue> GetSummary() const;
+        double GetTotalWeight() const {
+            return TotalWeight;
+        }
+
+        /* Derives borders from the summary with any of the grid_creator selection
+         * algorithms by expanding the summary into a weight-proportional pseudo-sample.
+         */
+        THashSet<float> GetBorders(int borderCount, EBorderSelectionType type) const;
+
+        void Save(IOutputStream* out) const;
+        void Load(IInputStream* in);
+
+    private:
+        void Compact();
+
+    private:
+        size_t MaxSize;
+        double TotalWeight = 0;
+        TVector<TWeightedValue> Summary; // sorted by value, at most about MaxSize points
+        TVector<TWeightedValue> Buffer; // unsorted recent additions, folded in by Compact
+    };
+}
+
+Y_DECLARE_PODTYPE(NSplitSelection::TQuantileSketch::TWeightedValue);
@@ -0,0 +1,128 @@
+#include <library/unittest/registar.h>
+
+#include <library/grid_creator/quantile_sketch.h>
+
+#include <util/generic/algorithm.h>
+#include <util/generic/vector.h>
+#include <util/random/fast.h>
+#include <util/stream/buffer.h>
+
+#include <limits>
+
+using NSplitSelection::TQuantileSketch;
+
+static TVector<float> GenerateValues(size_t count, ui64 seed) {
+    TFastRng64 rng(seed);
+    TVector<float> values;
+    values.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        values.push_back(static_cast<float>(rng.GenRandReal1() * 100 - 50));
+    }
+    return values;
+}
+
+static double GetRank(const TVector<float>& values, float border) {
+    size_t below = 0;
+    for (float value : values) {
+        below += value <= border;
+    }
+    return static_cast<double>(below) / values.size();
+}
+
+static TVector<float> SortedBorders(const THashSet<float>& borderSet) {
+    TVector<float> borders(borderSet.begin(), borderSet.end());
+    Sort(borders.begin(), borders.end());
+    return borders;
+}
+
+Y_UNIT_TEST_SUITE(QuantileSketchTests) {
+    Y_UNIT_TEST(TestEmpty) {
+        TQuantileSketch sketch;
+        UNIT_ASSERT_VALUES_EQUAL(sketch.GetTotalWeight(), 0.0);
+        UNIT_ASSERT(sketch.GetBorders(10, EBorderSelectionType::Median).empty());
+    }
+
+    Y_UNIT_TEST(TestRankAccuracy) {
+        const TVector<float> values = GenerateValues(100000, 42);
+        TQuantileSketch sketch(512);
+        for (float value : values) {
+            sketch.Add(value);
+        }
+        const int borderCount = 15;
+        TVector<float> valuesCopy = values;
+        const TVector<float> exactBorders = SortedBorders(
+            BestSplit(valuesCopy, borderCount, EBorderSelectionType::Median));
+        const TVector<float> sketchBorders = SortedBorders(
+            sketch.GetBorders(borderCount, EBorderSelectionType::Median));
+        UNIT_ASSERT_VALUES_EQUAL(exactBorders.size(), sketchBorders.size());
+        for (size_t i = 0; i < exactBorders.size(); ++i) {
+            UNIT_ASSERT_DOUBLES_EQUAL(
+                GetRank(values, exactBorders[i]),
+                GetRank(values, sketchBorders[i]),
+                /*rank error is O(1/maxSize) per prune*/ 0.02);
+        }
+    }
+
+    Y_UNIT_TEST(TestMergeMatchesSingleSketch) {
+        const TVector<float> values = GenerateValues(60000, 17);
+        TQuantileSketch whole(512);
+        TVector<TQuantileSketch> shards(3, TQuantileSketch(512));
+        for (size_t i = 0; i < values.size(); ++i) {
+            whole.Add(values[i]);
+            shards[i % shards.size()].Add(values[i]);
+        }
+        TQuantileSketch merged(512);
+        for (const auto& shard : shards) {
+            merged.Merge(shard);
+        }
+        UNIT_ASSERT_DOUBLES_EQUAL(whole.GetTotalWeight(), merged.GetTotalWeight(), 1e-6);
+        const int borderCount = 31;
+        const TVector<float> wholeBorders = SortedBorders(
+            whole.GetBorders(borderCount, EBorderSelectionType::Median));
+        const TVector<float> mergedBorders = SortedBorders(
+            merged.GetBorders(borderCount, EBorderSelectionType::Median));
+        UNIT_ASSERT_VALUES_EQUAL(wholeBorders.size(), mergedBorders.size());
+        for (size_t i = 0; i < wholeBorders.size(); ++i) {
+            UNIT_ASSERT_DOUBLES_EQUAL(
+                GetRank(values, wholeBorders[i]),
+                GetRank(values, mergedBorders[i]),
+                0.02);
+        }
+    }
+
+    Y_UNIT_TEST(TestWeights) {
+        // half the weight on a single point must put the median border next to it
+        TQuantileSketch sketch(256);
+        for (int i = 0; i < 1000; ++i) {
+            sketch.Add(static_cast<float>(i), 1.0);
+        }
+        sketch.Add(2000.0f, 1000.0);
+        const TVector<float> borders = SortedBorders(sketch.GetBorders(1, EBorderSelectionType::Median));
+        UNIT_ASSERT_VALUES_EQUAL(borders.size(), 1);
+        UNIT_ASSERT(borders[0] >= 990.0f);
+    }
+
+    Y_UNIT_TEST(TestSaveLoad) {
+        const TVector<float> values = GenerateValues(20000, 7);
+        TQuantileSketch sketch(512);
+        for (float value : values) {
+            sketch.Add(value);
+        }
+        TBufferStream stream;
+        sketch.Save(&stream);
+        TQuantileSketch restored;
+        restored.Load(&stream);
+        UNIT_ASSERT_DOUBLES_EQUAL(sketch.GetTotalWeight(), restored.GetTotalWeight(), 1e-6);
+        UNIT_ASSERT_VALUES_EQUAL(
+            SortedBorders(sketch.GetBorders(15, EBorderSelectionType::Median)),
+            SortedBorders(restored.GetBorders(15, EBorderSelectionType::Median)));
+    }
+
+    Y_UNIT_TEST(TestIgnoresNansAndZeroWeights) {
+        TQuantileSketch sketch;
+        sketch.Add(std::numeric_limits<float>::quiet_NaN());
+        sketch.Add(1.0f, 0.0);
+        sketch.Add(1.0f, -1.0);
+        UNIT_ASSERT_VALUES_EQUAL(sketch.GetTotalWeight(), 0.0);
+    }
+}
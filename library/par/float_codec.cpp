@@ -0,0 +1,239 @@
+#include "float_codec.h"
+
+#include <library/blockcodecs/codecs.h>
+
+#include <util/generic/utility.h>
+#include <util/generic/yexception.h>
+#include <util/system/unaligned_mem.h>
+
+#include <cmath>
+#include <limits>
+
+namespace NPar {
+    static const NBlockCodecs::ICodec* GetPayloadCodec() {
+        // zstd_1 beats lz4 noticeably on delta-transformed planes and stays fast enough
+        // for per-message encoding
+        static const NBlockCodecs::ICodec* codecPtr = NBlockCodecs::Codec("zstd_1");
+        return codecPtr;
+    }
+
+    static const float Fp16MaxValue = 65504.0f;
+
+    static ui16 Fp32ToFp16(float value) {
+        union {
+            float F;
+            ui32 U;
+        } conv;
+        conv.F = value;
+        const ui32 bits = conv.U;
+        const ui16 sign = static_cast<ui16>((bits >> 16) & 0x8000);
+        const i32 exponent = static_cast<i32>((bits >> 23) & 0xff) - 127 + 15;
+        ui32 mantissa = bits & 0x007fffff;
+        if (exponent >= 31) {
+            // overflow saturates to infinity, NaN keeps a payload bit
+            return sign + 0x7c00 + (((bits & 0x7fffffff) > 0x7f800000) ? 0x200 : 0);
+        }
+        if (exponent <= 0) {
+            if (exponent < -10) {
+                return sign; // rounds to zero
+            }
+            mantissa |= 0x00800000;
+            const int shift = 14 - exponent;
+            // addition instead of bitwise or: rounding may carry into the exponent field
+            return sign + static_cast<ui16>((mantissa + (1u << (shift - 1))) >> shift);
+        }
+        return sign + static_cast<ui16>(exponent << 10) + static_cast<ui16>((mantissa + 0x1000) >> 13);
+    }
+
+    static float Fp16ToFp32(ui16 half) {
+        const ui32 sign = static_cast<ui32>(half & 0x8000) << 16;
+        ui32 exponent = (half >> 10) & 0x1f;
+        ui32 mantissa = half & 0x3ff;
+        ui32 bits;
+        if (exponent == 0) {
+            if (mantissa == 0) {
+                bits = sign;
+            } else {
+                int shift = 0;
+                while (!(mantissa & 0x400)) {
+                    mantissa <<= 1;
+                    ++shift;
+                }
+                bits = sign | ((113 - shift) << 23) | ((mantissa & 0x3ff) << 13);
+            }
+        } else if (exponent == 31) {
+            bits = sign | 0x7f800000 | (mantissa << 13);
+        } else {
+            bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+        }
+        union {
+            ui32 U;
+            float F;
+        } conv;
+        conv.U = bits;
+        return conv.F;
+    }
+
+    // split into per-byte planes and delta-encode each: neighbouring floats share high
+    // bytes, so the planes become long runs the block codec packs tightly
+    static void PlaneDeltaEncode(const char* src, size_t count, size_t stride, TVector<char>* planes) {
+        planes->yresize(count * stride);
+        char* out = planes->data();
+        for (size_t plane = 0; plane < stride; ++plane) {
+            char prev = 0;
+            for (size_t i = 0; i < count; ++i) {
+                const char cur = src[i * stride + plane];
+                *out++ = cur - prev;
+                prev = cur;
+            }
+        }
+    }
+
+    static void PlaneDeltaDecode(const char* planes, size_t count, size_t stride, char* dst) {
+        for (size_t plane = 0; plane < stride; ++plane) {
+            char prev = 0;
+            for (size_t i = 0; i < count; ++i) {
+                prev += *planes++;
+                dst[i * stride + plane] = prev;
+            }
+        }
+    }
+
+    static void AppendBlockCompressed(const char* src, size_t size, TVector<char>* dst) {
+        const NBlockCodecs::ICodec* codec = GetPayloadCodec();
+        const TStringBuf srcData{src, size};
+        const size_t previousSize = dst->size();
+        dst->yresize(previousSize + codec->MaxCompressedLength(srcData));
+        const size_t packedSize = codec->Compress(srcData, dst->data() + previousSize);
+        dst->yresize(previousSize + packedSize);
+    }
+
+    static void BlockDecompress(TConstArrayRef<char> src, TVector<char>* dst) {
+        const NBlockCodecs::ICodec* codec = GetPayloadCodec();
+        const TStringBuf srcData{src.data(), src.size()};
+        dst->yresize(codec->DecompressedLength(srcData));
+        dst->yresize(codec->Decompress(srcData, dst->data()));
+    }
+
+    template <typename T>
+    static void AppendPod(T value, TVector<char>* dst) {
+        const size_t previousSize = dst->size();
+        dst->yresize(previousSize + sizeof(T));
+        WriteUnaligned<T>(dst->data() + previousSize, value);
+    }
+
+    template <typename T>
+    static T ReadPod(TConstArrayRef<char>* src) {
+        Y_ENSURE(src->size() >= sizeof(T), "float payload is truncated");
+        const T value = ReadUnaligned<T>(src->data());
+        *src = src->Slice(sizeof(T), src->size() - sizeof(T));
+        return value;
+    }
+
+    static float ComputeFp16Scale(TConstArrayRef<float> src) {
+        float maxAbs = 0.0f;
+        for (float value : src) {
+            const float absValue = std::fabs(value);
+            if (absValue > maxAbs && absValue <= std::numeric_limits<float>::max()) {
+                maxAbs = absValue;
+            }
+        }
+        return maxAbs > Fp16MaxValue ? maxAbs / Fp16MaxValue : 1.0f;
+    }
+
+    static void EncodeFp16(TConstArrayRef<float> src, float scale, TVector<ui16>* halves) {
+        halves->yresize(src.size());
+        for (size_t i = 0; i < src.size(); ++i) {
+            (*halves)[i] = Fp32ToFp16(src[i] / scale);
+        }
+    }
+
+    void CompressFloatArray(EFloatArrayCodec codec, TConstArrayRef<float> src, TVector<char>* dst) {
+        dst->clear();
+        AppendPod<ui8>(static_cast<ui8>(codec), dst);
+        AppendPod<ui32>(static_cast<ui32>(src.size()), dst);
+        if (src.empty()) {
+            return;
+        }
+        switch (codec) {
+            case EFloatArrayCodec::Raw: {
+                const size_t previousSize = dst->size();
+                dst->yresize(previousSize + src.size() * sizeof(float));
+                memcpy(dst->data() + previousSize, src.data(), src.size() * sizeof(float));
+                break;
+            }
+            case EFloatArrayCodec::Fp16: {
+                const float scale = ComputeFp16Scale(src);
+                AppendPod<float>(scale, dst);
+                TVector<ui16> halves;
+                EncodeFp16(src, scale, &halves);
+                const size_t previousSize = dst->size();
+                dst->yresize(previousSize + halves.size() * sizeof(ui16));
+                memcpy(dst->data() + previousSize, halves.data(), halves.size() * sizeof(ui16));
+                break;
+            }
+            case EFloatArrayCodec::ByteDeltaZstd: {
+                TVector<char> planes;
+                PlaneDeltaEncode(reinterpret_cast<const char*>(src.data()), src.size(), sizeof(float), &planes);
+                AppendBlockCompressed(planes.data(), planes.size(), dst);
+                break;
+            }
+            case EFloatArrayCodec::Fp16DeltaZstd: {
+                const float scale = ComputeFp16Scale(src);
+                AppendPod<float>(scale, dst);
+                TVector<ui16> halves;
+                EncodeFp16(src, scale, &halves);
+                TVector<char> planes;
+                PlaneDeltaEncode(reinterpret_cast<const char*>(halves.data()), halves.size(), sizeof(ui16), &planes);
+                AppendBlockCompressed(planes.data(), planes.size(), dst);
+                break;
+            }
+        }
+    }
+
+    void DecompressFloatArray(TConstArrayRef<char> src, TVector<float>* dst) {
+        const ui8 codecByte = ReadPod<ui8>(&src);
+        const ui32 count = ReadPod<ui32>(&src);
+        dst->yresize(count);
+        if (count == 0) {
+            return;
+        }
+        switch (static_cast<EFloatArrayCodec>(codecByte)) {
+            case EFloatArrayCodec::Raw: {
+                Y_ENSURE(src.size() == count * sizeof(float), "float payload is truncated");
+                memcpy(dst->data(), src.data(), count * sizeof(float));
+                break;
+            }
+            case EFloatArrayCodec::Fp16: {
+                const float scale = ReadPod<float>(&src);
+                Y_ENSURE(src.size() == count * sizeof(ui16), "float payload is truncated");
+                for (ui32 i = 0; i < count; ++i) {
+                    (*dst)[i] = Fp16ToFp32(ReadUnaligned<ui16>(src.data() + i * sizeof(ui16))) * scale;
+                }
+                break;
+            }
+            case EFloatArrayCodec::ByteDeltaZstd: {
+                TVector<char> planes;
+                BlockDecompress(src, &planes);
+                Y_ENSURE(planes.size() == count * sizeof(float), "float payload is truncated");
+                PlaneDeltaDecode(planes.data(), count, sizeof(float), reinterpret_cast<char*>(dst->data()));
+                break;
+            }
+            case EFloatArrayCodec::Fp16DeltaZstd: {
+                const float scale = ReadPod<float>(&src);
+                TVector<char> planes;
+                BlockDecompress(src, &planes);
+                Y_ENSURE(planes.size() == count * sizeof(ui16), "float payload is truncated");
+                TVector<ui16> halves;
+                halves.yresize(count);
+                PlaneDeltaDecode(planes.data(), count, sizeof(ui16), reinterpret_cast<char*>(halves.data()));
+                for (ui32 i = 0; i < count; ++i) {
+                    (*dst)[i] = Fp16ToFp32(halves[i]) * scale;
+                }
+                break;
+            }
+            default:
+                ythrow yexception() << "unknown float payload codec " << static_cast<int>(codecByte);
+        }
+    }
+}
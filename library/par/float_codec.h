@@ -0,0 +1,28 @@
+#pragma once
+
+#include <util/generic/array_ref.h>
+#include <util/generic/vector.h>
+#include <util/system/defaults.h>
+
+namespace NPar {
+    /* Typed codecs for float-array payloads. The generic message compression in
+     * compression.cpp treats payloads as opaque bytes; float arrays compress far better
+     * when the encoder knows their layout, and for many of them (histograms, partial
+     * sums that receivers re-accumulate in wider types) reduced precision is acceptable.
+     * The caller declares a codec per payload type; the encoded buffer is
+     * self-describing, so the receiver needs no configuration.
+     *
+     * Fp16 variants store one scale factor per array (maxAbs / fp16 max when the values
+     * exceed the half-precision range), so relative precision stays ~3 decimal digits
+     * for payloads of any magnitude.
+     */
+    enum class EFloatArrayCodec : ui8 {
+        Raw = 0, // float32 verbatim, lossless
+        Fp16 = 1, // scaled half precision, halves the wire size
+        ByteDeltaZstd = 2, // lossless: byte-plane split + delta transform + zstd
+        Fp16DeltaZstd = 3, // scaled half precision, then byte-plane delta + zstd
+    };
+
+    void CompressFloatArray(EFloatArrayCodec codec, TConstArrayRef<float> src, TVector<char>* dst);
+    void DecompressFloatArray(TConstArrayRef<char> src, TVector<float>* dst);
+}
@@ -4,6 +4,7 @@
 
 #include <util/generic/utility.h>
 #include <util/system/event.h>
+#include <util/system/info.h>
 #include <util/system/thread.h>
 #include <util/system/tls.h>
 #include <util/system/yield.h>
@@ -15,6 +16,22 @@
 #include <sys/syscall.h>
 #endif
 
+#ifdef _linux_
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+static void PinCurrentThreadToCpu(int cpu) {
+#ifdef _linux_
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    CPU_SET(cpu % NSystemInfo::NumberOfCpus(), &cpuSet);
+    pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet);
+#else
+    Y_UNUSED(cpu);
+#endif
+}
+
 #ifdef _win_
 static void RegularYield() {
 }
@@ -211,6 +228,9 @@ public:
     TAtomic MPQueueSize{0};
     TAtomic LPQueueSize{0};
     TAtomic ThreadId{0};
+    TAtomic SpinIterations{200};
+    TAtomic ParkedCount{0};
+    TAtomic PinWorkers{0};
 
     Y_THREAD(int)
     CurrentTaskPriority;
@@ -219,6 +239,13 @@ public:
 
     static void* HostWorkerThread(void* p);
     bool GetJob(TSingleJob* job);
+    // Wake parked workers; skipped entirely while every worker is still spinning, so at
+    // spin-dispatch task granularity the handoff is a lock-free enqueue plus this check.
+    void SignalHasJob() {
+        if (AtomicGet(ParkedCount) > 0) {
+            HasJob.Signal();
+        }
+    }
     void RunNewThread();
     void LaunchRange(TIntrusivePtr<TLocalRangeExecutor> execRange, int queueSizeLimit,
                      TAtomic* queueSize, TLockFreeQueue<TSingleJob>* jobQueue);
@@ -237,15 +264,17 @@ NPar::TLocalExecutor::TImpl::~TImpl() {
 }
 
 void* NPar::TLocalExecutor::TImpl::HostWorkerThread(void* p) {
-    static const int FAST_ITERATIONS = 200;
-
     auto* const ctx = (TImpl*)p;
     TThread::CurrentThreadSetName("ParLocalExecutor");
     ctx->WorkerThreadId = AtomicAdd(ctx->ThreadId, 1);
+    if (AtomicGet(ctx->PinWorkers)) {
+        PinCurrentThreadToCpu(ctx->WorkerThreadId);
+    }
     for (bool cont = true; cont;) {
         TSingleJob job;
         bool gotJob = false;
-        for (int iter = 0; iter < FAST_ITERATIONS; ++iter) {
+        const int spinIterations = AtomicGet(ctx->SpinIterations);
+        for (int iter = 0; iter < spinIterations; ++iter) {
             if (ctx->GetJob(&job)) {
                 gotJob = true;
                 break;
@@ -253,10 +282,16 @@ void* NPar::TLocalExecutor::TImpl::HostWorkerThread(void* p) {
         }
         if (!gotJob) {
             ctx->HasJob.Reset();
+            // publish the parked state before the last dequeue attempt: a producer that
+            // enqueues after that attempt is then guaranteed to observe ParkedCount > 0
+            // and issue the wakeup
+            AtomicAdd(ctx->ParkedCount, 1);
             if (!ctx->GetJob(&job)) {
                 ctx->HasJob.Wait();
+                AtomicAdd(ctx->ParkedCount, -1);
                 continue;
             }
+            AtomicAdd(ctx->ParkedCount, -1);
         }
         if (job.Exec.Get()) {
             job.Exec->LocalExec(job.Id);
@@ -308,7 +343,7 @@ void NPar::TLocalExecutor::TImpl::LaunchRange(TIntrusivePtr<TLocalRangeExecutor>
     for (int i = 0; i < count; ++i) {
         jobQueue->Enqueue(TSingleJob(rangeExec, 0));
     }
-    HasJob.Signal();
+    SignalHasJob();
 }
 
 NPar::TLocalExecutor::TLocalExecutor()
@@ -322,6 +357,15 @@ void NPar::TLocalExecutor::RunAdditionalThreads(int threadCount) {
         Impl_->RunNewThread();
 }
 
+void NPar::TLocalExecutor::SetWorkerSpinIterations(int spinIterations) {
+    Y_ASSERT(spinIterations > 0);
+    AtomicSet(Impl_->SpinIterations, spinIterations);
+}
+
+void NPar::TLocalExecutor::PinWorkerThreadsToCpus(bool pin) {
+    AtomicSet(Impl_->PinWorkers, pin ? 1 : 0);
+}
+
 void NPar::TLocalExecutor::Exec(TIntrusivePtr<ILocallyExecutable> exec, int id, int flags) {
     Y_ASSERT((flags & WAIT_COMPLETE) == 0); // unsupported
     int prior = Max<int>(Impl_->CurrentTaskPriority, flags & PRIORITY_MASK);
@@ -342,7 +386,7 @@ void NPar::TLocalExecutor::Exec(TIntrusivePtr<ILocallyExecutable> exec, int id,
             Y_ASSERT(0);
             break;
     }
-    Impl_->HasJob.Signal();
+    Impl_->SignalHasJob();
 }
 
 void NPar::TLocalExecutor::Exec(TLocallyExecutableFunction exec, int id, int flags) {
@@ -8,7 +8,9 @@
 #include <util/generic/noncopyable.h>
 #include <util/generic/ptr.h>
 #include <util/generic/singleton.h>
+#include <util/generic/utility.h>
 
+#include <atomic>
 #include <functional>
 
 namespace NPar {
@@ -136,6 +138,20 @@ namespace NPar {
         // @param threadCount       Number of threads to add.
         void RunAdditionalThreads(int threadCount);
 
+        // Spin-then-park dispatch tuning: the number of dequeue attempts an idle worker makes
+        // before parking on the wakeup event. Raising it keeps workers spinning through the
+        // gaps between short fork-join regions, trading idle cpu for wakeup-free task handoff
+        // (the producer only issues a wakeup when some worker has actually parked).
+        //
+        // @param spinIterations    Dequeue attempts before parking; default is 200.
+        void SetWorkerSpinIterations(int spinIterations);
+
+        // Pin every worker thread started afterwards to a fixed cpu: worker `i` goes to
+        // cpu `i`, leaving cpu 0 to the parent thread. Stops the scheduler from migrating
+        // spinning workers and keeps their cache state put. Only effective on platforms with
+        // thread affinity support; call before `RunAdditionalThreads`.
+        void PinWorkerThreadsToCpus(bool pin);
+
         // Add task for further execution.
         //
         // @param exec          Task description.
@@ -209,6 +225,52 @@ namespace NPar {
         ParallelFor(LocalExecutor(), from, to, std::forward<TBody>(body));
     }
 
+    // Guided scheduling for ranges with skewed per-block cost: instead of a static
+    // partition, worker tasks repeatedly claim the next chunk of the range from a
+    // shared position. Chunk sizes decrease geometrically as the range drains (down
+    // to `minBlockSize`), so workers that finish cheap chunks pick up the remaining
+    // work of slower ones and the completion time tracks the mean rather than the
+    // max chunk cost. `body` is called with half-open [blockFirstId, blockLastId)
+    // subranges.
+    //
+    template <typename TBlockedBody>
+    inline void GuidedBlockedParallelFor(TLocalExecutor& executor, int from, int to, int minBlockSize, TBlockedBody&& body) {
+        if (from >= to) {
+            return;
+        }
+        const int workerCount = executor.GetThreadCount() + 1;
+        if (workerCount == 1 || to - from <= minBlockSize) {
+            body(from, to);
+            return;
+        }
+        std::atomic<int> position(from);
+        executor.ExecRange([&](int) {
+            for (;;) {
+                const int remaining = to - position.load(std::memory_order_relaxed);
+                if (remaining <= 0) {
+                    break;
+                }
+                const int blockSize = Max(remaining / (2 * workerCount), minBlockSize);
+                const int blockFirstId = position.fetch_add(blockSize);
+                if (blockFirstId >= to) {
+                    break;
+                }
+                body(blockFirstId, Min(to, blockFirstId + blockSize));
+            }
+        }, 0, workerCount, TLocalExecutor::WAIT_COMPLETE);
+    }
+
+    // Per-item version of `GuidedBlockedParallelFor`.
+    //
+    template <typename TBody>
+    inline void GuidedParallelFor(TLocalExecutor& executor, int from, int to, TBody&& body) {
+        GuidedBlockedParallelFor(executor, from, to, /*minBlockSize*/ 1, [&](int blockFirstId, int blockLastId) {
+            for (int i = blockFirstId; i < blockLastId; ++i) {
+                body(i);
+            }
+        });
+    }
+
     template <typename TBody>
     inline void AsyncParallelFor(ui32 from, ui32 to, TBody&& body) {
         TLocalExecutor::TExecRangeParams params(from, to);
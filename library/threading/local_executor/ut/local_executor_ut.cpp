@@ -2,6 +2,7 @@
 #include <library/threading/future/future.h>
 
 #include <library/unittest/registar.h>
+#include <util/datetime/base.h>
 #include <util/system/mutex.h>
 #include <util/system/rwlock.h>
 #include <util/generic/algorithm.h>
@@ -324,3 +325,42 @@ Y_UNIT_TEST(NestedParallelExceptionsDoNotLeak) {
 }
 }
 ;
+
+Y_UNIT_TEST_SUITE(SpinDispatch) {
+    Y_UNIT_TEST(ExecRangeWithSpinDispatch) {
+        TLocalExecutor localExecutor;
+        localExecutor.SetWorkerSpinIterations(100000);
+        localExecutor.PinWorkerThreadsToCpus(true);
+        localExecutor.RunAdditionalThreads(3);
+        TVector<TAtomic> hitCounts(DefaultRangeSize);
+        for (auto& hitCount : hitCounts) {
+            hitCount = 0;
+        }
+        // many consecutive short regions is exactly the pattern spin dispatch targets;
+        // workers should stay spinning between them and every task must still run once
+        for (int region = 0; region < 100; ++region) {
+            localExecutor.ExecRange([&hitCounts](int i) {
+                AtomicAdd(hitCounts[i], 1);
+            },
+                                    0, DefaultRangeSize, TLocalExecutor::WAIT_COMPLETE);
+        }
+        for (const auto& hitCount : hitCounts) {
+            UNIT_ASSERT_EQUAL(AtomicGet(hitCount), 100);
+        }
+    }
+
+    Y_UNIT_TEST(ParkedWorkersStillWakeUp) {
+        TLocalExecutor localExecutor;
+        localExecutor.SetWorkerSpinIterations(1); // park almost immediately
+        localExecutor.RunAdditionalThreads(3);
+        TAtomic processed = 0;
+        for (int region = 0; region < 10; ++region) {
+            Sleep(TDuration::MilliSeconds(5)); // let the workers park between regions
+            localExecutor.ExecRange([&processed](int) {
+                AtomicAdd(processed, 1);
+            },
+                                    0, DefaultRangeSize, TLocalExecutor::WAIT_COMPLETE);
+        }
+        UNIT_ASSERT_EQUAL(AtomicGet(processed), 10 * DefaultRangeSize);
+    }
+}